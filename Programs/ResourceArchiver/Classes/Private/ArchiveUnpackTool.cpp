@@ -207,6 +207,7 @@ static int UnpackFile(const DAVA::FilePath& archivePath,
     }
 
     Vector<uint8> content;
+    size_t contentSize = fileInfo.originalSize;
 
     switch (fileInfo.type)
     {
@@ -214,22 +215,16 @@ static int UnpackFile(const DAVA::FilePath& archivePath,
         content = std::move(compressedContent);
         break;
     case Compressor::Type::Lz4:
-        content.resize(fileInfo.originalSize);
-        if (!LZ4Compressor().Decompress(compressedContent, content))
-        {
-            return ERROR_CANT_EXTRACT_FILE;
-        }
-        break;
     case Compressor::Type::Lz4HC:
-        content.resize(fileInfo.originalSize);
-        if (!LZ4HCCompressor().Decompress(compressedContent, content))
+        content.resize(contentSize);
+        if (!LZ4Compressor().Decompress(compressedContent.data(), compressedContent.size(), content.data(), contentSize) || contentSize != content.size())
         {
             return ERROR_CANT_EXTRACT_FILE;
         }
         break;
     case Compressor::Type::RFC1951:
-        content.resize(fileInfo.originalSize);
-        if (!ZipCompressor().Decompress(compressedContent, content))
+        content.resize(contentSize);
+        if (!ZipCompressor().Decompress(compressedContent.data(), compressedContent.size(), content.data(), contentSize) || contentSize != content.size())
         {
             return ERROR_CANT_EXTRACT_FILE;
         }
@@ -0,0 +1,88 @@
+#include "YamlCompileTool.h"
+
+#include <FileSystem/FileSystem.h>
+#include <FileSystem/YamlBinary.h>
+#include <FileSystem/YamlNode.h>
+#include <FileSystem/YamlParser.h>
+#include <Logger/Logger.h>
+
+#include "ResultCodes.h"
+
+YamlCompileTool::YamlCompileTool()
+    : CommandLineTool("compileyaml")
+{
+    options.AddArgument("srcdir");
+}
+
+bool YamlCompileTool::ConvertOptionsToParamsInternal()
+{
+    srcDir = options.GetArgument("srcdir");
+    if (srcDir.IsEmpty())
+    {
+        DAVA::Logger::Error("srcdir param is not specified");
+        return false;
+    }
+    srcDir.MakeDirectoryPathname();
+
+    return true;
+}
+
+int YamlCompileTool::ProcessInternal()
+{
+    using namespace DAVA;
+
+    if (!FileSystem::Instance()->Exists(srcDir))
+    {
+        Logger::Error("Directory %s doesn't exist", srcDir.GetAbsolutePathname().c_str());
+        return ERROR_CANT_OPEN_FILE;
+    }
+
+    // Binary yaml is written next to source yaml, so loaders pick it up by the same path with changed extension
+    uint32 compiledCount = 0;
+    uint32 upToDateCount = 0;
+    for (const FilePath& path : FileSystem::Instance()->EnumerateFilesInDirectory(srcDir))
+    {
+        if (!path.IsEqualToExtension(".yaml"))
+            continue;
+
+        YamlBinary::SourceInfo sourceInfo;
+        if (!YamlBinary::GetSourceInfo(path, sourceInfo))
+        {
+            Logger::Error("Can't read %s", path.GetAbsolutePathname().c_str());
+            return ERROR_CANT_OPEN_FILE;
+        }
+
+        // Loaders compare only size of source, so changes are detected by hash here
+        const FilePath binaryPath = YamlBinary::GetBinaryPath(path);
+        Vector<uint8> binary;
+        YamlBinary::SourceInfo compiledInfo;
+        if (FileSystem::Instance()->ReadFileContents(binaryPath, binary) &&
+            YamlBinary::ReadSourceInfo(binary.data(), static_cast<uint32>(binary.size()), compiledInfo) &&
+            compiledInfo.size == sourceInfo.size && compiledInfo.hash == sourceInfo.hash)
+        {
+            upToDateCount += 1;
+            continue;
+        }
+
+        RefPtr<YamlParser> parser(YamlParser::Create(path));
+        if (!parser.Valid())
+        {
+            Logger::Error("Can't parse %s", path.GetAbsolutePathname().c_str());
+            return ERROR_CANT_OPEN_FILE;
+        }
+
+        // Empty yaml is left as is, loaders treat it specially
+        const YamlNode* rootNode = parser->GetRootNode();
+        if (rootNode == nullptr)
+            continue;
+
+        if (!YamlBinary::SaveToFile(binaryPath, rootNode, sourceInfo))
+        {
+            return ERROR_CANT_WRITE_FILE;
+        }
+        compiledCount += 1;
+    }
+
+    Logger::Info("Compiled %u yaml files in %s, %u are up to date", compiledCount, srcDir.GetAbsolutePathname().c_str(), upToDateCount);
+    return OK;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "CommandLineTool.h"
+#include <FileSystem/FilePath.h>
+
+class YamlCompileTool final : public CommandLineTool
+{
+public:
+    YamlCompileTool();
+
+private:
+    bool ConvertOptionsToParamsInternal() final;
+    int ProcessInternal() final;
+
+    DAVA::FilePath srcDir;
+};
@@ -9,6 +9,7 @@
 #include "ArchivePackTool.h"
 #include "ArchiveUnpackTool.h"
 #include "ArchiveListTool.h"
+#include "YamlCompileTool.h"
 
 int DAVAMain(DAVA::Vector<DAVA::String>)
 {
@@ -39,6 +40,7 @@ int DAVAMain(DAVA::Vector<DAVA::String>)
                          app.AddTool(std::make_unique<ArchivePackTool>());
                          app.AddTool(std::make_unique<ArchiveUnpackTool>());
                          app.AddTool(std::make_unique<ArchiveListTool>());
+                         app.AddTool(std::make_unique<YamlCompileTool>());
                          int retCode = app.Process(e.GetCommandLine());
                          e.QuitAsync(retCode);
                      });
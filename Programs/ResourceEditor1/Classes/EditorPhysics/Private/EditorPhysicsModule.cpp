@@ -203,7 +203,7 @@ DAVA::RenderObject* CreateVehicleWheelRenderObject(DAVA::float32 radius, DAVA::f
     group->SetPrimitiveType(rhi::PRIMITIVE_TRIANGLELIST);
     group->AllocateData(eVertexFormat::EVF_VERTEX, static_cast<int32>(vertices.size()), static_cast<int32>(indices.size()), segments * 2);
     memcpy(group->vertexArray, vertices.data(), vertices.size() * sizeof(Vector3));
-    memcpy(group->indexArray, indices.data(), indices.size() * sizeof(uint16));
+    memcpy(group->GetIndexData(), indices.data(), indices.size() * sizeof(uint16));
     group->BuildBuffers();
     group->RecalcAABBox();
 
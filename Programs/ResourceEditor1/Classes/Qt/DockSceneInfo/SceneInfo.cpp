@@ -150,6 +150,9 @@ void SceneInfo::Initialize3DDrawSection()
     AddChild("LineList", header);
     AddChild("TriangleList", header);
     AddChild("TriangleStrip", header);
+    AddChild("Render Batches", header);
+    AddChild("Render Packets", header);
+    AddChild("Instanced Packets", header);
 
     QtPropertyData* header2 = CreateInfoHeader("Bind Info");
     AddChild("Dynamic Param Bind Count", header2);
@@ -173,6 +176,9 @@ void SceneInfo::Refresh3DDrawInfo()
     SetChild("LineList", renderStats.primitiveLineListCount, header);
     SetChild("TriangleList", renderStats.primitiveTriangleListCount, header);
     SetChild("TriangleStrip", renderStats.primitiveTriangleStripCount, header);
+    SetChild("Render Batches", renderStats.batches3d, header);
+    SetChild("Render Packets", renderStats.packets3d, header);
+    SetChild("Instanced Packets", renderStats.instancedPackets3d, header);
 
     QtPropertyData* header2 = GetInfoHeader("Bind Info");
 
@@ -19,6 +19,7 @@
 #include <Platform/Process.h>
 #include <Render/GPUFamilyDescriptor.h>
 #include <Render/TextureDescriptor.h>
+#include <Render/3D/MeshUtils.h>
 #include <Render/Highlevel/Heightmap.h>
 #include <Render/Highlevel/Landscape.h>
 #include <Render/Image/ImageSystem.h>
@@ -975,6 +976,12 @@ bool SceneExporter::ExportScene(DAVA::Scene* scene, const DAVA::FilePath& sceneP
 
     CollectObjects(scene, exportedObjects);
 
+    if (exportingParams.optimizeOnExport)
+    {
+        MeshUtils::OptimizeGeometryRecursive(scene);
+        MeshUtils::QuantizeGeometryRecursive(scene);
+    }
+
     // save scene to new place
     FilePath tempSceneName = FilePath::CreateWithNewExtension(scenePathname, ".exported.sc2");
     scene->SaveScene(tempSceneName, exportingParams.optimizeOnExport);
@@ -0,0 +1,109 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Utils/CRC32.h"
+
+#include <random>
+
+using namespace DAVA;
+
+namespace CRC32TestDetails
+{
+const CRC32::Implementation IMPLEMENTATIONS[] = {
+    CRC32::Implementation::TABLE,
+    CRC32::Implementation::SLICE_BY_16,
+    CRC32::Implementation::PCLMUL,
+    CRC32::Implementation::ARMV8
+};
+
+Vector<uint8> GenerateData(size_t size)
+{
+    std::mt19937 generator(42);
+    Vector<uint8> data(size);
+    for (uint8& byte : data)
+    {
+        byte = static_cast<uint8>(generator());
+    }
+    return data;
+}
+}
+
+DAVA_TESTCLASS (CRC32Test)
+{
+    DAVA_TEST (KnownValuesTest)
+    {
+        const char* check = "123456789";
+        TEST_VERIFY(CRC32::ForBuffer(check, 9) == 0xcbf43926);
+        TEST_VERIFY(CRC32::ForBuffer(check, 0) == 0);
+
+        for (CRC32::Implementation implementation : CRC32TestDetails::IMPLEMENTATIONS)
+        {
+            if (CRC32::IsSupported(implementation))
+            {
+                TEST_VERIFY(CRC32::ForBuffer(check, 9, implementation) == 0xcbf43926);
+            }
+        }
+        TEST_VERIFY(CRC32::IsSupported(CRC32::GetBestImplementation()));
+    }
+
+    DAVA_TEST (ImplementationsTest)
+    {
+        using namespace CRC32TestDetails;
+
+        // All sizes and alignments around block sizes of fast implementations
+        Vector<uint8> data = GenerateData(1024);
+        for (size_t size = 0; size < 300; ++size)
+        {
+            for (size_t offset = 0; offset < 4; ++offset)
+            {
+                const uint32 expected = CRC32::ForBuffer(data.data() + offset, size, CRC32::Implementation::TABLE);
+                for (CRC32::Implementation implementation : IMPLEMENTATIONS)
+                {
+                    if (CRC32::IsSupported(implementation))
+                    {
+                        TEST_VERIFY(CRC32::ForBuffer(data.data() + offset, size, implementation) == expected);
+                    }
+                }
+            }
+        }
+
+        // Data added in pieces gives the same result
+        CRC32 crc;
+        crc.AddData(data.data(), 100);
+        crc.AddData(data.data() + 100, 1);
+        crc.AddData(data.data() + 101, data.size() - 101);
+        TEST_VERIFY(crc.Done() == CRC32::ForBuffer(data.data(), data.size(), CRC32::Implementation::TABLE));
+    }
+
+    DAVA_TEST (CombineTest)
+    {
+        Vector<uint8> data = CRC32TestDetails::GenerateData(100000);
+        const uint32 expected = CRC32::ForBuffer(data);
+
+        for (size_t split : { size_t(0), size_t(1), size_t(777), size_t(65536), data.size() })
+        {
+            const uint32 crc1 = CRC32::ForBuffer(data.data(), split);
+            const uint32 crc2 = CRC32::ForBuffer(data.data() + split, data.size() - split);
+            TEST_VERIFY(CRC32::Combine(crc1, crc2, data.size() - split) == expected);
+        }
+    }
+
+    DAVA_TEST (ParallelTest)
+    {
+        using namespace CRC32TestDetails;
+
+        Vector<uint8> data = GenerateData(64 * 1024 * 1024 + 123);
+        const uint32 expected = CRC32::ForBuffer(data);
+        TEST_VERIFY(CRC32::ForBufferParallel(data.data(), data.size()) == expected);
+        TEST_VERIFY(CRC32::ForBufferParallel(data.data(), 1000) == CRC32::ForBuffer(data.data(), 1000));
+
+        // Every supported path gives the same result on large buffer
+        for (size_t i = 0; i < COUNT_OF(IMPLEMENTATIONS); ++i)
+        {
+            if (CRC32::IsSupported(IMPLEMENTATIONS[i]))
+            {
+                TEST_VERIFY(CRC32::ForBuffer(data.data(), data.size(), IMPLEMENTATIONS[i]) == expected);
+            }
+        }
+    }
+};
@@ -1,10 +1,62 @@
 #include <Compression/ZipCompressor.h>
 #include <Compression/LZ4Compressor.h>
+#include <Compression/StreamCompressor.h>
+#include <FileSystem/DynamicMemoryFile.h>
 
 #include "UnitTests/UnitTests.h"
 
+#include <random>
+
 using namespace DAVA;
 
+namespace CompressorTestDetails
+{
+// Text-like data with repetitions, bigger than several LZ4 frame blocks
+Vector<uint8> GenerateData(size_t size)
+{
+    const char* words[] = { "entity", "component", "transform", "material", "texture", "landscape", " ", "\n", "{", "}" };
+    std::mt19937 generator(7);
+    Vector<uint8> data;
+    data.reserve(size);
+    while (data.size() < size)
+    {
+        const char* word = words[generator() % COUNT_OF(words)];
+        data.insert(data.end(), word, word + strlen(word));
+        data.push_back(static_cast<uint8>(generator()));
+    }
+    data.resize(size);
+    return data;
+}
+
+bool StreamRoundtrip(const Compressor& compressor, const Vector<uint8>& in, Vector<uint8>& compressed)
+{
+    ScopedPtr<DynamicMemoryFile> output(DynamicMemoryFile::Create(File::CREATE | File::WRITE));
+    std::unique_ptr<StreamCompressor> streamCompressor = compressor.CreateStreamCompressor(output);
+
+    // write in odd chunks
+    bool result = true;
+    for (size_t offset = 0, chunk = 1; offset < in.size(); offset += chunk, chunk = chunk * 3 + 1)
+    {
+        chunk = std::min(chunk, in.size() - offset);
+        result &= streamCompressor->Write(in.data() + offset, chunk);
+    }
+    result &= streamCompressor->Finish();
+    compressed = output->GetDataVector();
+
+    ScopedPtr<DynamicMemoryFile> input(DynamicMemoryFile::Create(compressed.data(), static_cast<int32>(compressed.size()), File::OPEN | File::READ));
+    std::unique_ptr<StreamDecompressor> streamDecompressor = compressor.CreateStreamDecompressor(input);
+
+    Vector<uint8> out;
+    Vector<uint8> buffer(10007);
+    while (!streamDecompressor->IsEof() && !streamDecompressor->IsFailed())
+    {
+        size_t read = streamDecompressor->Read(buffer.data(), buffer.size());
+        out.insert(out.end(), buffer.begin(), buffer.begin() + read);
+    }
+    return result && !streamDecompressor->IsFailed() && out == in;
+}
+}
+
 DAVA_TESTCLASS (CompressorTest)
 {
     DAVA_TEST (TestLZ4_LZ4HC_ZIP)
@@ -60,4 +112,119 @@ DAVA_TESTCLASS (CompressorTest)
             TEST_VERIFY(uncompressedZip == in);
         }
     }
+
+    DAVA_TEST (SpanTest)
+    {
+        const Vector<uint8> in = CompressorTestDetails::GenerateData(100000);
+        LZ4Compressor lz4;
+        LZ4HCCompressor lz4hc;
+        ZipCompressor zip;
+        const Compressor* compressors[] = { &lz4, &lz4hc, &zip };
+
+        for (const Compressor* compressor : compressors)
+        {
+            Vector<uint8> compressed;
+            TEST_VERIFY(compressor->Compress(in.data() + 100, 50000, compressed));
+
+            // output buffer may be bigger than data
+            Vector<uint8> out(60000);
+            size_t outSize = out.size();
+            TEST_VERIFY(compressor->Decompress(compressed.data(), compressed.size(), out.data(), outSize));
+            TEST_VERIFY(outSize == 50000);
+            TEST_VERIFY(std::equal(out.begin(), out.begin() + outSize, in.begin() + 100));
+
+            // too small output buffer is error, not overrun
+            outSize = 1000;
+            TEST_VERIFY(!compressor->Decompress(compressed.data(), compressed.size(), out.data(), outSize));
+        }
+    }
+
+    DAVA_TEST (StreamTest)
+    {
+        using namespace CompressorTestDetails;
+
+        const Vector<uint8> in = GenerateData(300000);
+        Vector<uint8> compressed;
+
+        TEST_VERIFY(StreamRoundtrip(LZ4Compressor(), in, compressed));
+        TEST_VERIFY(compressed.size() < in.size());
+        // LZ4 frame magic number
+        TEST_VERIFY(compressed[0] == 0x04 && compressed[1] == 0x22 && compressed[2] == 0x4D && compressed[3] == 0x18);
+
+        TEST_VERIFY(StreamRoundtrip(LZ4HCCompressor(), in, compressed));
+        TEST_VERIFY(compressed.size() < in.size());
+
+        // zlib stream is readable by block decompression
+        TEST_VERIFY(StreamRoundtrip(ZipCompressor(), in, compressed));
+        Vector<uint8> out(in.size());
+        TEST_VERIFY(ZipCompressor().Decompress(compressed, out));
+        TEST_VERIFY(out == in);
+
+        // empty stream
+        TEST_VERIFY(StreamRoundtrip(LZ4Compressor(), Vector<uint8>(), compressed));
+        TEST_VERIFY(StreamRoundtrip(ZipCompressor(), Vector<uint8>(), compressed));
+
+        // corrupted frame is detected
+        StreamRoundtrip(LZ4Compressor(), in, compressed);
+        compressed[compressed.size() / 2] ^= 0xFF;
+        ScopedPtr<DynamicMemoryFile> input(DynamicMemoryFile::Create(compressed.data(), static_cast<int32>(compressed.size()), File::OPEN | File::READ));
+        std::unique_ptr<StreamDecompressor> decompressor = LZ4Compressor().CreateStreamDecompressor(input);
+        Vector<uint8> buffer(in.size());
+        decompressor->Read(buffer.data(), buffer.size());
+        TEST_VERIFY(decompressor->IsFailed());
+    }
+
+    DAVA_TEST (DictionaryTest)
+    {
+        using namespace CompressorTestDetails;
+
+        // Many small files with common structure
+        std::mt19937 generator(13);
+        Vector<Vector<uint8>> files;
+        for (uint32 i = 0; i < 200; ++i)
+        {
+            String text = Format("{ \"entity\": %u, \"components\": [ \"transform\", \"render\" ], \"material\": \"~res:/Materials/Default.material\", \"lod\": %u }", generator(), generator() % 4);
+            files.emplace_back(text.begin(), text.end());
+        }
+
+        std::shared_ptr<LZ4Dictionary> dictionary = LZ4Dictionary::Train(files, 4096);
+        TEST_VERIFY(!dictionary->GetContent().empty());
+        TEST_VERIFY(dictionary->GetContent().size() <= 4096);
+
+        LZ4Compressor plain;
+        LZ4Compressor withDictionary(dictionary);
+        LZ4HCCompressor hcWithDictionary(dictionary);
+        const LZ4Compressor* dictionaryCompressors[] = { &withDictionary, &hcWithDictionary };
+
+        size_t plainSize = 0;
+        size_t dictionarySize = 0;
+        bool roundtrip = true;
+        for (const Vector<uint8>& file : files)
+        {
+            Vector<uint8> compressed;
+            plain.Compress(file, compressed);
+            plainSize += compressed.size();
+
+            for (const LZ4Compressor* compressor : dictionaryCompressors)
+            {
+                TEST_VERIFY(compressor->Compress(file, compressed));
+                Vector<uint8> out(file.size());
+                roundtrip &= compressor->Decompress(compressed, out) && out == file;
+            }
+            withDictionary.Compress(file, compressed);
+            dictionarySize += compressed.size();
+        }
+        TEST_VERIFY(roundtrip);
+        TEST_VERIFY(dictionarySize < plainSize / 2);
+
+        // Frame keeps dictionary id and can't be read without dictionary
+        Vector<uint8> compressed;
+        const Vector<uint8> in = GenerateData(100000);
+        TEST_VERIFY(StreamRoundtrip(withDictionary, in, compressed));
+        ScopedPtr<DynamicMemoryFile> input(DynamicMemoryFile::Create(compressed.data(), static_cast<int32>(compressed.size()), File::OPEN | File::READ));
+        std::unique_ptr<StreamDecompressor> decompressor = plain.CreateStreamDecompressor(input);
+        uint8 byte = 0;
+        TEST_VERIFY(decompressor->Read(&byte, 1) == 0);
+        TEST_VERIFY(decompressor->IsFailed());
+    }
 };
@@ -0,0 +1,204 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Render/Highlevel/GeometryBVH.h"
+#include "Render/Highlevel/GeometryGenerator.h"
+#include "Render/Highlevel/GeometryOctTree.h"
+#include "Render/Highlevel/RenderHierarchy.h"
+#include "Render/Highlevel/RenderObject.h"
+
+#include <random>
+
+using namespace DAVA;
+
+namespace GeometryBVHTestDetails
+{
+const uint32 RAY_COUNT = 20000;
+
+Vector<Ray3Optimized> GenerateRays(const AABBox3& box, uint32 count)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float32> unit(0.0f, 1.0f);
+
+    const Vector3 center = box.GetCenter();
+    const Vector3 size = box.GetSize();
+    Vector<Ray3Optimized> rays;
+    rays.reserve(count);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        // Rays go from points around the box to points inside it, so most of them hit geometry
+        Vector3 from(unit(generator) - 0.5f, unit(generator) - 0.5f, unit(generator) - 0.5f);
+        Vector3 to(unit(generator), unit(generator), unit(generator));
+        from = center + from * size * 3.0f;
+        to = box.min + to * size;
+        rays.emplace_back(from, to - from);
+    }
+    return rays;
+}
+}
+
+DAVA_TESTCLASS (GeometryBVHTest)
+{
+    // GeometryBVH::IntersectionWithRay, GeometryBVH::IntersectionWithRays
+    DAVA_TEST (CompareWithOctTree)
+    {
+        using namespace GeometryBVHTestDetails;
+
+        const AABBox3 box(Vector3(-10.0f, -10.0f, -10.0f), Vector3(10.0f, 10.0f, 10.0f));
+        Map<FastName, float32> options = { { FastName("subdivisionCount"), 5.0f } };
+        ScopedPtr<PolygonGroup> geometry(GeometryGenerator::GenerateIcoSphere(box, options));
+
+        GeometryOctTree* octTree = geometry->GetGeometryOctTree();
+        GeometryBVH* bvh = geometry->GetGeometryBVH();
+
+        Vector<Ray3Optimized> rays = GenerateRays(box, RAY_COUNT);
+
+        Vector<float32> octTreeT(RAY_COUNT, FLOAT_MAX);
+        Vector<uint32> octTreeHits(RAY_COUNT, 0);
+        for (uint32 i = 0; i < RAY_COUNT; ++i)
+        {
+            uint32 triangleIndex = 0;
+            octTreeHits[i] = octTree->IntersectionWithRay(rays[i], octTreeT[i], triangleIndex) ? 1 : 0;
+        }
+
+        Vector<float32> bvhT(RAY_COUNT, FLOAT_MAX);
+        Vector<uint32> bvhTriangles(RAY_COUNT, 0);
+        Vector<uint32> bvhHits(RAY_COUNT, 0);
+        for (uint32 i = 0; i < RAY_COUNT; ++i)
+        {
+            bvhHits[i] = bvh->IntersectionWithRay(rays[i], bvhT[i], bvhTriangles[i]) ? 1 : 0;
+        }
+
+        Vector<float32> packetT(RAY_COUNT, FLOAT_MAX);
+        Vector<uint32> packetTriangles(RAY_COUNT, uint32(-1));
+        uint32 packetHitsCount = bvh->IntersectionWithRays(rays.data(), RAY_COUNT, packetT.data(), packetTriangles.data());
+
+        uint32 hitsCount = 0;
+        for (uint32 i = 0; i < RAY_COUNT; ++i)
+        {
+            TEST_VERIFY(octTreeHits[i] == bvhHits[i]);
+            if (octTreeHits[i] != 0 && bvhHits[i] != 0)
+            {
+                TEST_VERIFY(FLOAT_EQUAL_EPS(octTreeT[i], bvhT[i], 1e-5f));
+            }
+
+            TEST_VERIFY(packetT[i] == bvhT[i]);
+            if (bvhHits[i] != 0)
+            {
+                TEST_VERIFY(packetTriangles[i] == bvhTriangles[i]);
+            }
+            hitsCount += bvhHits[i];
+        }
+        TEST_VERIFY(packetHitsCount == hitsCount);
+        TEST_VERIFY(hitsCount > 0 && hitsCount < RAY_COUNT);
+
+        // Axis-aligned rays through edges of box faces
+        Map<FastName, float32> boxOptions = {
+            { FastName("segments.x"), 3.0f },
+            { FastName("segments.y"), 3.0f },
+            { FastName("segments.z"), 3.0f }
+        };
+        ScopedPtr<PolygonGroup> unitBox(GeometryGenerator::GenerateBox(AABBox3(Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 1.0f, 1.0f)), boxOptions));
+        const Ray3Optimized axisRays[] = {
+            Ray3Optimized(Vector3(0.0f, 0.0f, -1.0f), Vector3(0.0f, 0.0f, 2.0f)),
+            Ray3Optimized(Vector3(0.5f, 0.5f, -1.0f), Vector3(0.0f, 0.0f, 2.0f)),
+            Ray3Optimized(Vector3(1.0f, 1.0f, 2.0f), Vector3(0.0f, 0.0f, -2.0f)),
+            Ray3Optimized(Vector3(0.49999f, -1.0f, 0.50001f), Vector3(0.0f, 2.0f, 0.0f)),
+        };
+        for (const Ray3Optimized& ray : axisRays)
+        {
+            float32 resultT = 0.0f;
+            uint32 triangleIndex = 0;
+            TEST_VERIFY(unitBox->GetGeometryBVH()->IntersectionWithRay(ray, resultT, triangleIndex));
+            TEST_VERIFY(FLOAT_EQUAL(resultT, 0.5f));
+        }
+    }
+
+    // RenderHierarchy::RayTraceBatch
+    DAVA_TEST (RayTraceBatch)
+    {
+        const uint32 gridSize = 8;
+        Map<FastName, float32> options = { { FastName("subdivisionCount"), 3.0f } };
+        ScopedPtr<PolygonGroup> geometry(GeometryGenerator::GenerateIcoSphere(AABBox3(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f)), options));
+
+        LinearRenderHierarchy linearRenderHierarchy;
+        RenderHierarchy& hierarchy = linearRenderHierarchy;
+        Vector<Matrix4> worldTransforms(gridSize * gridSize);
+        Vector<RenderObject*> objects;
+        for (uint32 i = 0; i < gridSize * gridSize; ++i)
+        {
+            worldTransforms[i] = Matrix4::MakeTranslation(Vector3(float32(i % gridSize) * 3.0f, float32(i / gridSize) * 3.0f, 0.0f));
+            Matrix4 inverseTransform;
+            worldTransforms[i].GetInverse(inverseTransform);
+
+            ScopedPtr<RenderBatch> batch(new RenderBatch());
+            batch->SetPolygonGroup(geometry);
+
+            RenderObject* object = new RenderObject();
+            object->AddRenderBatch(batch);
+            object->SetWorldMatrixPtr(&worldTransforms[i]);
+            object->SetInverseTransform(inverseTransform);
+            object->RecalculateWorldBoundingBox();
+            hierarchy.AddRenderObject(object);
+            objects.push_back(object);
+        }
+
+        // Rays go down from regular grid, some of them pass between spheres
+        Vector<Ray3> rays;
+        for (float32 x = -1.0f; x < float32(gridSize) * 3.0f; x += 0.25f)
+        {
+            for (float32 y = -1.0f; y < float32(gridSize) * 3.0f; y += 0.25f)
+            {
+                rays.emplace_back(Vector3(x, y, 10.0f), Vector3(0.0f, 0.0f, -20.0f));
+            }
+        }
+
+        Vector<RayTraceCollision> singleCollisions(rays.size());
+        Vector<bool> singleHits(rays.size());
+        for (size_t i = 0; i < rays.size(); ++i)
+        {
+            singleHits[i] = hierarchy.RayTrace(rays[i], singleCollisions[i], Vector<RenderObject*>());
+        }
+
+        Vector<RayTraceCollision> collisions;
+        uint32 hitsCount = hierarchy.RayTraceBatch(rays, collisions, Vector<RenderObject*>());
+
+        TEST_VERIFY(collisions.size() == rays.size());
+        uint32 singleHitsCount = 0;
+        for (size_t i = 0; i < rays.size(); ++i)
+        {
+            TEST_VERIFY(singleHits[i] == (collisions[i].renderObject != nullptr));
+            if (singleHits[i])
+            {
+                singleHitsCount++;
+                TEST_VERIFY(collisions[i].renderObject == singleCollisions[i].renderObject);
+                TEST_VERIFY(collisions[i].triangleIndex == singleCollisions[i].triangleIndex);
+                TEST_VERIFY(FLOAT_EQUAL(collisions[i].t, singleCollisions[i].t));
+            }
+        }
+        TEST_VERIFY(hitsCount == singleHitsCount);
+        TEST_VERIFY(hitsCount > 0 && hitsCount < rays.size());
+
+        // Ignored objects are skipped
+        Vector<RayTraceCollision> ignoredCollisions;
+        TEST_VERIFY(hierarchy.RayTraceBatch(rays, ignoredCollisions, objects) == 0);
+
+        // Rays of linear hierarchy are segments, sphere top at z = 1 is beyond the end of the short one
+        const Vector<Ray3> segments = {
+            Ray3(Vector3(0.1f, 0.1f, 10.0f), Vector3(0.0f, 0.0f, -5.0f)),
+            Ray3(Vector3(0.1f, 0.1f, 10.0f), Vector3(0.0f, 0.0f, -10.0f))
+        };
+        Vector<RayTraceCollision> segmentCollisions;
+        TEST_VERIFY(hierarchy.RayTraceBatch(segments, segmentCollisions, Vector<RenderObject*>()) == 1);
+        TEST_VERIFY(segmentCollisions[0].renderObject == nullptr);
+        TEST_VERIFY(segmentCollisions[1].renderObject == objects[0]);
+        RayTraceCollision segmentCollision;
+        TEST_VERIFY(!hierarchy.RayTrace(segments[0], segmentCollision, Vector<RenderObject*>()));
+
+        for (RenderObject* object : objects)
+        {
+            hierarchy.RemoveRenderObject(object);
+            SafeRelease(object);
+        }
+    }
+};
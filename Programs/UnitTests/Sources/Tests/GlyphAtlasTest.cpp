@@ -0,0 +1,111 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Render/2D/Private/FTGlyphAtlas.h"
+#include "Render/2D/TextBlockGlyphRender.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (GlyphAtlasTest)
+{
+    Font* font = nullptr;
+
+    GlyphAtlasTest()
+    {
+        font = FTFont::Create("~res:/Fonts/DejaVuSans.ttf");
+        DVASSERT(font);
+    }
+
+    ~GlyphAtlasTest()
+    {
+        SafeRelease(font);
+    }
+
+    // FTGlyphAtlas::AddGlyph, FTGlyphAtlas::FindGlyph, FTGlyphAtlas::EndFrame
+    DAVA_TEST (PackGlyphs)
+    {
+        FTGlyphAtlas atlas(64, 1);
+        Vector<uint8> image(20 * 20, 255);
+        const void* owner = this;
+
+        FTGlyphAtlas::Glyph glyph;
+        TEST_VERIFY(!atlas.FindGlyph(owner, 1, glyph));
+        TEST_VERIFY(atlas.AddGlyph(owner, 1, image.data(), 20, 20, 20, 1, 18, glyph));
+        TEST_VERIFY(glyph.rect.dx == 20 && glyph.rect.dy == 20);
+
+        FTGlyphAtlas::Glyph found;
+        TEST_VERIFY(atlas.FindGlyph(owner, 1, found));
+        TEST_VERIFY(found.rect == glyph.rect && found.left == 1 && found.top == 18);
+
+        // glyph without image
+        TEST_VERIFY(atlas.AddGlyph(owner, 2, nullptr, 0, 0, 0, 0, 0, glyph));
+        TEST_VERIFY(glyph.rect.dx == 0);
+
+        // too big glyph
+        Vector<uint8> bigImage(100 * 100, 255);
+        TEST_VERIFY(!atlas.AddGlyph(owner, 3, bigImage.data(), 100, 100, 100, 0, 0, glyph));
+
+        // pages used in current frame are not cleared, atlas grows over the limit instead
+        uint32 generation = atlas.GetGeneration();
+        for (uint64 key = 10; key < 20; ++key)
+        {
+            TEST_VERIFY(atlas.AddGlyph(owner, key, image.data(), 20, 20, 20, 0, 0, glyph));
+        }
+        TEST_VERIFY(atlas.GetGeneration() == generation);
+        TEST_VERIFY(atlas.GetPagesCount() > 1);
+        TEST_VERIFY(atlas.FindGlyph(owner, 1, glyph));
+
+        // extra pages are released after a frame without their use
+        atlas.EndFrame();
+        TEST_VERIFY(atlas.GetPagesCount() > 1);
+        atlas.EndFrame();
+        TEST_VERIFY(atlas.GetPagesCount() == 1);
+        TEST_VERIFY(atlas.GetGeneration() != generation);
+        TEST_VERIFY(!atlas.FindGlyph(owner, 19, glyph));
+
+        // least recently used page is cleared when all pages are full
+        atlas.EndFrame();
+        generation = atlas.GetGeneration();
+        for (uint64 key = 20; key < 24; ++key)
+        {
+            TEST_VERIFY(atlas.AddGlyph(owner, key, image.data(), 20, 20, 20, 0, 0, glyph));
+        }
+        TEST_VERIFY(atlas.GetGeneration() != generation);
+        TEST_VERIFY(atlas.GetPagesCount() == 1);
+        TEST_VERIFY(!atlas.FindGlyph(owner, 1, glyph));
+        TEST_VERIFY(atlas.FindGlyph(owner, 23, glyph));
+
+        atlas.RemoveFont(owner);
+        TEST_VERIFY(atlas.GetGlyphsCount() == 0);
+    }
+
+    // TextBlockGlyphRender::Prepare
+    DAVA_TEST (ShareGlyphs)
+    {
+        const bool wasEnabled = TextBlock::IsGlyphAtlasEnabled();
+        TextBlock::SetGlyphAtlasEnabled(true);
+        FTGlyphAtlas* atlas = GetEngineContext()->fontManager->GetGlyphAtlas();
+
+        const uint32 glyphsCount = atlas->GetGlyphsCount();
+        RefPtr<TextBlock> first(TextBlock::Create(Vector2(200.f, 50.f)));
+        first->SetFont(font);
+        first->SetText(L"Glyph atlas");
+        first->PreDraw();
+        TEST_VERIFY(dynamic_cast<TextBlockGlyphRender*>(first->GetRenderer()) != nullptr);
+        TEST_VERIFY(first->GetSprite() == nullptr);
+
+        const uint32 firstGlyphsCount = atlas->GetGlyphsCount();
+        TEST_VERIFY(firstGlyphsCount > glyphsCount);
+
+        // the same glyphs are reused by another text block
+        RefPtr<TextBlock> second(TextBlock::Create(Vector2(200.f, 50.f)));
+        second->SetFont(font);
+        second->SetText(L"Glyph atlas");
+        second->PreDraw();
+        TEST_VERIFY(atlas->GetGlyphsCount() == firstGlyphsCount);
+
+        TextBlock::SetGlyphAtlasEnabled(false);
+        TEST_VERIFY(dynamic_cast<TextBlockGlyphRender*>(first->GetRenderer()) == nullptr);
+        TextBlock::SetGlyphAtlasEnabled(wasEnabled);
+    }
+};
@@ -1,5 +1,6 @@
 #include "DAVAEngine.h"
 #include "UnitTests/UnitTests.h"
+#include "Job/ParallelFor.h"
 
 using namespace DAVA;
 
@@ -87,6 +88,34 @@ DAVA_TESTCLASS (JobManagerTest)
         // ...
     }
 
+    DAVA_TEST (TestParallelFor)
+    {
+        const uint32 count = 1000;
+        Vector<Atomic<uint32>> calls(count);
+
+        ParallelFor(count, [&calls](uint32 i) { calls[i]++; });
+        bool calledOnce = true;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            calledOnce &= (calls[i] == 1);
+        }
+        TEST_VERIFY(calledOnce);
+
+        // Jobs object is reused, like in per-frame processing
+        ParallelJobs jobs;
+        for (uint32 pass = 0; pass < 10; ++pass)
+        {
+            jobs.Start(count, [&calls](uint32 i) { calls[i]++; });
+            jobs.Finish();
+        }
+        bool calledEveryPass = true;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            calledEveryPass &= (calls[i] == 11);
+        }
+        TEST_VERIFY(calledEveryPass);
+    }
+
     void ThreadFunc(JobManagerTestData * data)
     {
         for (uint32 i = 0; i < JOBS_COUNT; i++)
@@ -0,0 +1,104 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "FileSystem/KeyedArchiveView.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (KeyedArchiveViewTest)
+{
+    DAVA_TEST (ReadValuesTest)
+    {
+        ScopedPtr<KeyedArchive> nested(new KeyedArchive());
+        nested->SetString("nestedString", "nested");
+        nested->SetUInt32("nestedUInt32", 42);
+
+        const uint8 bytes[] = { 1, 2, 3, 4, 5 };
+        const Matrix4 matrix = Matrix4::MakeTranslation(Vector3(1.f, 2.f, 3.f));
+
+        ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+        archive->SetBool("bool", true);
+        archive->SetInt32("int32", -12345);
+        archive->SetUInt32("uint32", 12345);
+        archive->SetInt64("int64", -1234567890123ll);
+        archive->SetFloat("float", 3.5f);
+        archive->SetFloat64("float64", 2.25);
+        archive->SetString("string", "hello");
+        archive->SetFastName("fastname", FastName("fast"));
+        archive->SetVector3("vector3", Vector3(1.f, 2.f, 3.f));
+        archive->SetMatrix4("matrix4", matrix);
+        archive->SetColor("color", Color(0.1f, 0.2f, 0.3f, 0.4f));
+        archive->SetByteArray("bytes", bytes, static_cast<int32>(sizeof(bytes)));
+        archive->SetArchive("archive", nested);
+        archive->SetByteArrayFromArchive("archiveBytes", nested);
+
+        Vector<uint8> data(archive->Save(nullptr, 0));
+        archive->Save(data.data(), static_cast<uint32>(data.size()));
+
+        KeyedArchiveView view(data.data(), static_cast<uint32>(data.size()));
+        TEST_VERIFY(view.IsValid());
+        TEST_VERIFY(view.Count() == archive->Count());
+
+        TEST_VERIFY(view.GetBool("bool") == true);
+        TEST_VERIFY(view.GetInt32("int32") == -12345);
+        TEST_VERIFY(view.GetUInt32("uint32") == 12345);
+        TEST_VERIFY(view.GetInt64("int64") == -1234567890123ll);
+        TEST_VERIFY(view.GetFloat("float") == 3.5f);
+        TEST_VERIFY(view.GetFloat64("float64") == 2.25);
+        TEST_VERIFY(view.GetString("string") == "hello");
+        TEST_VERIFY(view.GetFastName("fastname") == FastName("fast"));
+        TEST_VERIFY(view.GetVector3("vector3") == Vector3(1.f, 2.f, 3.f));
+        TEST_VERIFY(view.GetMatrix4("matrix4") == matrix);
+        TEST_VERIFY(view.GetColor("color") == Color(0.1f, 0.2f, 0.3f, 0.4f));
+
+        // Values of other type and absent keys give default value
+        TEST_VERIFY(view.GetInt32("uint32", 7) == 7);
+        TEST_VERIFY(view.GetString("absent", "default") == "default");
+        TEST_VERIFY(!view.IsKeyExists("absent"));
+        TEST_VERIFY(view.GetType("float") == VariantType::TYPE_FLOAT);
+
+        // Strings and byte arrays point into source data
+        uint32 length = 0;
+        const char8* str = view.GetStringData("string", &length);
+        TEST_VERIFY(length == 5 && strncmp(str, "hello", length) == 0);
+        TEST_VERIFY(reinterpret_cast<const uint8*>(str) > data.data() && reinterpret_cast<const uint8*>(str) < data.data() + data.size());
+
+        const uint8* viewBytes = view.GetByteArray("bytes");
+        TEST_VERIFY(view.GetByteArraySize("bytes") == sizeof(bytes));
+        TEST_VERIFY(viewBytes != nullptr && memcmp(viewBytes, bytes, sizeof(bytes)) == 0);
+        TEST_VERIFY(viewBytes > data.data() && viewBytes < data.data() + data.size());
+
+        for (const char* key : { "archive", "archiveBytes" })
+        {
+            KeyedArchiveView nestedView = view.GetArchive(key);
+            TEST_VERIFY(nestedView.IsValid());
+            TEST_VERIFY(nestedView.GetString("nestedString") == "nested");
+            TEST_VERIFY(nestedView.GetUInt32("nestedUInt32") == 42);
+        }
+
+        VariantType variant = view.GetVariant("vector3");
+        TEST_VERIFY(variant.GetType() == VariantType::TYPE_VECTOR3);
+        TEST_VERIFY(variant.AsVector3() == Vector3(1.f, 2.f, 3.f));
+
+        RefPtr<KeyedArchive> materialized = view.CreateKeyedArchive();
+        TEST_VERIFY(materialized->Count() == archive->Count());
+        TEST_VERIFY(materialized->GetString("string") == "hello");
+    }
+
+    DAVA_TEST (MalformedDataTest)
+    {
+        ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+        archive->SetString("string", "hello");
+
+        Vector<uint8> data(archive->Save(nullptr, 0));
+        archive->Save(data.data(), static_cast<uint32>(data.size()));
+
+        KeyedArchiveView truncated(data.data(), static_cast<uint32>(data.size() - 1));
+        TEST_VERIFY(!truncated.IsValid());
+        TEST_VERIFY(!truncated.IsKeyExists("string"));
+
+        KeyedArchiveView empty;
+        TEST_VERIFY(!empty.IsValid());
+        TEST_VERIFY(empty.Count() == 0);
+    }
+};
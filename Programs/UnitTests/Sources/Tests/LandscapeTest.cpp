@@ -0,0 +1,150 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Render/Highlevel/Camera.h"
+#include "Render/Highlevel/Heightmap.h"
+#include "Render/Highlevel/Landscape.h"
+#include "Render/Highlevel/LandscapeSubdivision.h"
+
+#include <random>
+
+using namespace DAVA;
+
+namespace LandscapeTestDetails
+{
+const int32 HEIGHTMAP_SIZE = 256;
+const float32 LANDSCAPE_SIZE = 1000.0f;
+const float32 LANDSCAPE_HEIGHT = 100.0f;
+
+Heightmap* CreateHeightmap()
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<uint32> noise(0, 4096);
+
+    Heightmap* heightmap = new Heightmap(HEIGHTMAP_SIZE);
+    uint16* data = heightmap->Data();
+    for (int32 y = 0; y < HEIGHTMAP_SIZE; ++y)
+    {
+        for (int32 x = 0; x < HEIGHTMAP_SIZE; ++x)
+        {
+            // Hills with some noise, so subdivision is not uniform
+            float32 hills = 0.5f + 0.25f * (std::sin(float32(x) * 0.05f) + std::cos(float32(y) * 0.07f));
+            data[x + y * HEIGHTMAP_SIZE] = uint16(hills * 60000.0f) + uint16(noise(generator));
+        }
+    }
+    return heightmap;
+}
+}
+
+DAVA_TESTCLASS (LandscapeTest)
+{
+    // Landscape::GetHeightsAtPoints, Landscape::PlacePoints
+    DAVA_TEST (BatchHeightQueries)
+    {
+        using namespace LandscapeTestDetails;
+
+        ScopedPtr<Heightmap> heightmap(CreateHeightmap());
+        ScopedPtr<Landscape> landscape(new Landscape());
+        landscape->SetLandscapeSize(LANDSCAPE_SIZE);
+        landscape->SetLandscapeHeight(LANDSCAPE_HEIGHT);
+        landscape->SetHeightmap(heightmap);
+
+        // Some of points are outside of landscape, some are exactly on its border
+        const uint32 pointsCount = 10003;
+        std::mt19937 generator(7);
+        std::uniform_real_distribution<float32> coordinate(-0.55f * LANDSCAPE_SIZE, 0.55f * LANDSCAPE_SIZE);
+        Vector<Vector3> points(pointsCount);
+        for (Vector3& point : points)
+        {
+            point = Vector3(coordinate(generator), coordinate(generator), 0.0f);
+        }
+        points[0] = Vector3(LANDSCAPE_SIZE * 0.5f, LANDSCAPE_SIZE * 0.5f, 0.0f);
+        points[1] = Vector3(-LANDSCAPE_SIZE * 0.5f, -LANDSCAPE_SIZE * 0.5f, 0.0f);
+
+        Vector<Vector3> singleResults(pointsCount);
+        Vector<Vector3> singleNormals(pointsCount);
+        Vector<uint8> singlePlaced(pointsCount);
+        for (uint32 i = 0; i < pointsCount; ++i)
+        {
+            singlePlaced[i] = landscape->PlacePoint(points[i], singleResults[i], &singleNormals[i]) ? 1 : 0;
+        }
+
+        Vector<Vector3> results(pointsCount);
+        Vector<Vector3> normals(pointsCount);
+        std::unique_ptr<bool[]> placed(new bool[pointsCount]);
+        uint32 placedCount = landscape->PlacePoints(points.data(), pointsCount, results.data(), normals.data(), placed.get());
+
+        uint32 singlePlacedCount = 0;
+        for (uint32 i = 0; i < pointsCount; ++i)
+        {
+            TEST_VERIFY(placed[i] == (singlePlaced[i] != 0));
+            if (placed[i])
+            {
+                singlePlacedCount++;
+                TEST_VERIFY(FLOAT_EQUAL_EPS(results[i].z, singleResults[i].z, 1e-4f));
+                TEST_VERIFY(FLOAT_EQUAL_EPS(normals[i].x, singleNormals[i].x, 1e-3f));
+                TEST_VERIFY(FLOAT_EQUAL_EPS(normals[i].y, singleNormals[i].y, 1e-3f));
+                TEST_VERIFY(FLOAT_EQUAL_EPS(normals[i].z, singleNormals[i].z, 1e-3f));
+            }
+        }
+        TEST_VERIFY(placedCount == singlePlacedCount);
+        TEST_VERIFY(placedCount > 0 && placedCount < pointsCount);
+        TEST_VERIFY(placed[0] && placed[1]);
+
+        Vector<float32> heights(pointsCount);
+        TEST_VERIFY(landscape->GetHeightsAtPoints(points.data(), pointsCount, heights.data()) == placedCount);
+        for (uint32 i = 0; i < pointsCount; ++i)
+        {
+            float32 height = 0.0f;
+            if (landscape->GetHeightAtPoint(points[i], height))
+            {
+                TEST_VERIFY(FLOAT_EQUAL_EPS(heights[i], height, 1e-4f));
+            }
+        }
+    }
+
+    // LandscapeSubdivision::SetParallelSubdivision
+    DAVA_TEST (ParallelSubdivision)
+    {
+        using namespace LandscapeTestDetails;
+
+        ScopedPtr<Heightmap> heightmap(CreateHeightmap());
+        const AABBox3 bbox(Vector3(-LANDSCAPE_SIZE * 0.5f, -LANDSCAPE_SIZE * 0.5f, 0.0f), Vector3(LANDSCAPE_SIZE * 0.5f, LANDSCAPE_SIZE * 0.5f, LANDSCAPE_HEIGHT));
+
+        ScopedPtr<Camera> camera(new Camera());
+        camera->SetupPerspective(70.0f, 1.0f, 1.0f, 5000.0f);
+        camera->SetUp(Vector3(0.0f, 0.0f, 1.0f));
+        camera->SetPosition(Vector3(-300.0f, -200.0f, 150.0f));
+        camera->SetTarget(Vector3(100.0f, 150.0f, 0.0f));
+        const Matrix4 worldTransform = Matrix4::IDENTITY;
+
+        LandscapeSubdivision serial;
+        serial.SetParallelSubdivision(false);
+        serial.BuildSubdivision(heightmap, bbox, 8, 0, true);
+        serial.PrepareSubdivision(camera, &worldTransform);
+
+        LandscapeSubdivision parallel;
+        parallel.BuildSubdivision(heightmap, bbox, 8, 0, true);
+        parallel.PrepareSubdivision(camera, &worldTransform);
+
+        TEST_VERIFY(serial.GetTerminatedPatchesCount() > 0);
+        TEST_VERIFY(serial.GetTerminatedPatchesCount() == parallel.GetTerminatedPatchesCount());
+        TEST_VERIFY(serial.GetLevelCount() == parallel.GetLevelCount());
+        for (uint32 level = 0; level < serial.GetLevelCount(); ++level)
+        {
+            const uint32 levelSize = serial.GetLevelInfo(level).size;
+            for (uint32 y = 0; y < levelSize; ++y)
+            {
+                for (uint32 x = 0; x < levelSize; ++x)
+                {
+                    const LandscapeSubdivision::SubdivisionPatchInfo& serialInfo = serial.GetPatchInfo(level, x, y);
+                    const LandscapeSubdivision::SubdivisionPatchInfo& parallelInfo = parallel.GetPatchInfo(level, x, y);
+                    TEST_VERIFY(serialInfo.lastUpdateID == parallelInfo.lastUpdateID);
+                    TEST_VERIFY(serialInfo.subdivisionState == parallelInfo.subdivisionState);
+                    TEST_VERIFY(serialInfo.startClipPlane == parallelInfo.startClipPlane);
+                    TEST_VERIFY(serialInfo.subdivMorph == parallelInfo.subdivMorph);
+                }
+            }
+        }
+    }
+};
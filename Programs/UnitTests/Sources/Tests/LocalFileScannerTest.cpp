@@ -0,0 +1,132 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "DLCManager/Private/LocalFileScanner.h"
+#include "FileSystem/Private/PackFormatSpec.h"
+#include "Utils/CRC32.h"
+
+using namespace DAVA;
+
+namespace LocalFileScannerTestDetails
+{
+const FilePath rootDir("~doc:/UnitTests/LocalFileScannerTest/");
+const FilePath packsDir("~doc:/UnitTests/LocalFileScannerTest/packs/");
+const FilePath indexPath("~doc:/UnitTests/LocalFileScannerTest/scan.index");
+const uint32 FILE_COUNT = 100;
+
+// write .dvpl file with footer, returns crc32 written to footer
+uint32 WriteDvpl(const FilePath& path, uint32 size, uint8 fill)
+{
+    Vector<uint8> content(size, fill);
+    PackFormat::LitePack::Footer footer;
+    footer.sizeUncompressed = size;
+    footer.sizeCompressed = size;
+    footer.crc32Compressed = CRC32::ForBuffer(content);
+    footer.type = Compressor::Type::None;
+    footer.packMarkerLite = PackFormat::FILE_MARKER_LITE;
+
+    ScopedPtr<File> file(File::Create(path, File::CREATE | File::WRITE));
+    file->Write(content.data(), size);
+    file->Write(&footer, sizeof(footer));
+    return footer.crc32Compressed;
+}
+
+String GetRelativeName(uint32 index)
+{
+    return Format("%sfile%03u.dvpl", (index % 2) ? "sub/" : "", index);
+}
+
+bool CheckFiles(const Vector<LocalFileScanner::FileInfo>& files, const UnorderedMap<String, uint32>& crcs)
+{
+    for (const LocalFileScanner::FileInfo& info : files)
+    {
+        auto it = crcs.find(info.relativeName);
+        if (it == crcs.end() || it->second != info.crc32Hash || info.compressedSize + sizeof(PackFormat::LitePack::Footer) != info.sizeOnDevice)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+DAVA_TESTCLASS (LocalFileScannerTest)
+{
+    DAVA_TEST (IncrementalScanTest)
+    {
+        using namespace LocalFileScannerTestDetails;
+
+        FileSystem* fs = GetEngineContext()->fileSystem;
+        fs->DeleteDirectory(rootDir, true);
+        fs->CreateDirectory(packsDir + "sub/", true);
+
+        UnorderedMap<String, uint32> crcs;
+        for (uint32 i = 0; i < FILE_COUNT; ++i)
+        {
+            crcs[GetRelativeName(i)] = WriteDvpl(packsDir + GetRelativeName(i), 100 + i, static_cast<uint8>(i));
+        }
+
+        // incomplete download without footer and not a pack file
+        {
+            ScopedPtr<File> broken(File::Create(packsDir + "broken.dvpl", File::CREATE | File::WRITE));
+            broken->WriteString("abc", false);
+            ScopedPtr<File> other(File::Create(packsDir + "other.txt", File::CREATE | File::WRITE));
+            other->WriteString("not a pack", false);
+        }
+
+        // first scan reads all footers
+        {
+            LocalFileScanner scanner(packsDir, indexPath);
+            scanner.Start(FILE_COUNT);
+            TEST_VERIFY(scanner.GetIndexedFiles().empty());
+
+            const Vector<LocalFileScanner::FileInfo>& files = scanner.Finish();
+            TEST_VERIFY(files.size() == FILE_COUNT);
+            TEST_VERIFY(CheckFiles(files, crcs));
+            TEST_VERIFY(!fs->IsFile(packsDir + "broken.dvpl"));
+            TEST_VERIFY(fs->IsFile(packsDir + "other.txt"));
+            TEST_VERIFY(scanner.SaveIndex(files));
+        }
+
+        // unchanged files are taken from index
+        {
+            LocalFileScanner scanner(packsDir, indexPath);
+            scanner.Start(FILE_COUNT);
+            TEST_VERIFY(scanner.GetIndexedFiles().size() == FILE_COUNT);
+            TEST_VERIFY(CheckFiles(scanner.GetIndexedFiles(), crcs));
+            TEST_VERIFY(scanner.Finish().empty());
+        }
+
+        // changed file is read again, deleted file is forgotten
+        {
+            crcs[GetRelativeName(7)] = WriteDvpl(packsDir + GetRelativeName(7), 1000, 0xAB);
+            fs->DeleteFile(packsDir + GetRelativeName(8));
+
+            LocalFileScanner scanner(packsDir, indexPath);
+            scanner.Start(FILE_COUNT);
+            TEST_VERIFY(scanner.GetIndexedFiles().size() == FILE_COUNT - 2);
+
+            Vector<LocalFileScanner::FileInfo> files = scanner.GetIndexedFiles();
+            const Vector<LocalFileScanner::FileInfo>& readFiles = scanner.Finish();
+            TEST_VERIFY(readFiles.size() == 1 && readFiles[0].relativeName == GetRelativeName(7));
+            TEST_VERIFY(CheckFiles(readFiles, crcs));
+
+            files.insert(files.end(), readFiles.begin(), readFiles.end());
+            TEST_VERIFY(scanner.SaveIndex(files));
+        }
+
+        // broken index means full scan
+        {
+            ScopedPtr<File> index(File::Create(indexPath, File::CREATE | File::WRITE));
+            index->WriteString("garbage", false);
+        }
+        {
+            LocalFileScanner scanner(packsDir, indexPath);
+            scanner.Start(FILE_COUNT);
+            TEST_VERIFY(scanner.GetIndexedFiles().empty());
+            TEST_VERIFY(scanner.Finish().size() == FILE_COUNT - 1);
+        }
+
+        fs->DeleteDirectory(rootDir, true);
+    }
+};
@@ -4,6 +4,39 @@
 
 using namespace DAVA;
 
+namespace LoggerFileTestDetails
+{
+const uint32 THREAD_COUNT = 4;
+const uint32 LINE_COUNT = 500;
+
+// Logs lines from several threads
+void LogFromThreads(const FilePath& logFilePath, bool flushEveryLine)
+{
+    Vector<Thread*> threads(THREAD_COUNT);
+    for (uint32 t = 0; t < THREAD_COUNT; ++t)
+    {
+        threads[t] = Thread::Create([&logFilePath, flushEveryLine, t]() {
+            Logger* logger = GetEngineContext()->logger;
+            for (uint32 i = 0; i < LINE_COUNT; ++i)
+            {
+                Logger::InfoToFile(logFilePath, "thread %u line %u", t, i);
+                if (flushEveryLine)
+                {
+                    logger->Flush();
+                }
+            }
+        });
+        threads[t]->Start();
+    }
+
+    for (Thread* thread : threads)
+    {
+        thread->Join();
+        SafeRelease(thread);
+    }
+}
+}
+
 DAVA_TESTCLASS (LoggerFileTest)
 {
     DAVA_TEST (TestFunction)
@@ -23,6 +56,8 @@ DAVA_TESTCLASS (LoggerFileTest)
         {
             if (i > 0)
             {
+                // log is written on background thread
+                logger->Flush();
                 ScopedPtr<File> log(File::Create(logFilePath, File::OPEN | File::READ));
                 TEST_VERIFY(log);
                 uint64 size = log->GetSize();
@@ -49,5 +84,33 @@ DAVA_TESTCLASS (LoggerFileTest)
             }
         }
     }
+
+    DAVA_TEST (MultithreadedTest)
+    {
+        using namespace LoggerFileTestDetails;
+
+        const FilePath logFilePath(Logger::GetLogPathForFilename("TestMultithreadedLogFile.txt"));
+        FileSystem::Instance()->DeleteFile(logFilePath);
+
+        Logger* logger = GetEngineContext()->logger;
+        logger->SetMaxFileSize(512 * 1024);
+
+        // Lines are neither lost nor duplicated whether writer is flushed after every line or not
+        LogFromThreads(logFilePath, true);
+        LogFromThreads(logFilePath, false);
+        logger->Flush();
+
+        ScopedPtr<File> log(File::Create(logFilePath, File::OPEN | File::READ));
+        TEST_VERIFY(log);
+        if (log)
+        {
+            String content;
+            content.resize(static_cast<size_t>(log->GetSize()));
+            log->Read(&content[0], static_cast<uint32>(content.size()));
+            TEST_VERIFY(std::count(content.begin(), content.end(), '\n') == 2 * THREAD_COUNT * LINE_COUNT);
+            TEST_VERIFY(content.find("thread 0 line 0\n") != String::npos);
+            TEST_VERIFY(content.find(Format("thread %u line %u\n", THREAD_COUNT - 1, LINE_COUNT - 1)) != String::npos);
+        }
+    }
 }
 ;
@@ -0,0 +1,195 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Math/MathBatch.h"
+
+#include <random>
+
+using namespace DAVA;
+
+namespace MathBatchTestDetails
+{
+const uint32 COUNT = 100000;
+
+// Plain scalar implementations, SSE code should give exactly the same results
+Vector3 TransformPoint(const Vector3& v, const Matrix4& m)
+{
+    return Vector3(v.x * m._00 + v.y * m._10 + v.z * m._20 + m._30,
+                   v.x * m._01 + v.y * m._11 + v.z * m._21 + m._31,
+                   v.x * m._02 + v.y * m._12 + v.z * m._22 + m._32);
+}
+
+Matrix4 Multiply(const Matrix4& a, const Matrix4& b)
+{
+    Matrix4 res;
+    for (uint32 i = 0; i < 4; ++i)
+    {
+        for (uint32 j = 0; j < 4; ++j)
+        {
+            res._data[i][j] = a._data[i][0] * b._data[0][j] + a._data[i][1] * b._data[1][j] + a._data[i][2] * b._data[2][j] + a._data[i][3] * b._data[3][j];
+        }
+    }
+    return res;
+}
+
+AABBox3 TransformBox(const AABBox3& box, const Matrix4& m)
+{
+    AABBox3 res;
+    res.AddPoint(TransformPoint(box.min, m));
+    res.AddPoint(TransformPoint(box.max, m));
+    for (uint32 i = 1; i < 7; ++i)
+    {
+        res.AddPoint(TransformPoint(Vector3((i & 1) ? box.max.x : box.min.x, (i & 2) ? box.max.y : box.min.y, (i & 4) ? box.max.z : box.min.z), m));
+    }
+    return res;
+}
+
+Matrix4 RandomTransform(std::mt19937& generator)
+{
+    std::uniform_real_distribution<float32> value(-10.0f, 10.0f);
+    Vector3 axis(value(generator), value(generator), value(generator) + 20.0f);
+    Matrix4 m = Matrix4::MakeScale(Vector3(1.0f, 2.0f, 0.5f)) * Matrix4::MakeRotation(Normalize(axis), value(generator));
+    m.SetTranslationVector(Vector3(value(generator), value(generator), value(generator)));
+    return m;
+}
+
+bool IsClose(const Vector3& l, const Vector3& r)
+{
+    const float32 eps = 1e-3f;
+    return std::abs(l.x - r.x) < eps && std::abs(l.y - r.y) < eps && std::abs(l.z - r.z) < eps;
+}
+
+bool IsClose(const Matrix4& l, const Matrix4& r)
+{
+    for (uint32 i = 0; i < 16; ++i)
+    {
+        if (std::abs(l.data[i] - r.data[i]) > 1e-3f)
+            return false;
+    }
+    return true;
+}
+}
+
+DAVA_TESTCLASS (MathBatchTest)
+{
+    DAVA_TEST (TransformPointsTest)
+    {
+        using namespace MathBatchTestDetails;
+
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<float32> value(-100.0f, 100.0f);
+        const Matrix4 transform = RandomTransform(generator);
+
+        Vector<Vector3> points(COUNT);
+        for (Vector3& p : points)
+        {
+            p = Vector3(value(generator), value(generator), value(generator));
+        }
+
+        Vector<Vector3> expected(COUNT);
+        for (uint32 i = 0; i < COUNT; ++i)
+        {
+            expected[i] = TransformPoint(points[i], transform);
+        }
+
+        Vector<Vector3> result(COUNT);
+        MathBatch::TransformPoints(points.data(), COUNT, transform, result.data());
+        TEST_VERIFY(result == expected);
+
+        for (uint32 i = 0; i < COUNT; ++i)
+        {
+            TEST_VERIFY(points[i] * transform == expected[i]);
+        }
+
+        // In-place transform
+        MathBatch::TransformPoints(points.data(), COUNT, transform, points.data());
+        TEST_VERIFY(points == expected);
+    }
+
+    DAVA_TEST (TransformPoints2DTest)
+    {
+        std::mt19937 generator(46);
+        std::uniform_real_distribution<float32> value(-100.0f, 100.0f);
+        const Matrix3 transform = Matrix3(0.5f, 0.8f, 0.0f,
+                                          -0.8f, 0.5f, 0.0f,
+                                          value(generator), value(generator), 1.0f);
+
+        // Odd count to check the tail which is not processed in pairs
+        const uint32 count = 1001;
+        Vector<Vector2> points(count);
+        for (Vector2& p : points)
+        {
+            p = Vector2(value(generator), value(generator));
+        }
+
+        Vector<Vector2> result(count);
+        MathBatch::TransformPoints(points.data(), count, transform, result.data());
+        for (uint32 i = 0; i < count; ++i)
+        {
+            TEST_VERIFY(result[i] == points[i] * transform);
+        }
+
+        MathBatch::TransformPoints(points.data(), count, transform, points.data());
+        TEST_VERIFY(points == result);
+    }
+
+    DAVA_TEST (MatrixMultiplyTest)
+    {
+        using namespace MathBatchTestDetails;
+
+        std::mt19937 generator(43);
+        Vector<Matrix4> a(COUNT / 10);
+        Vector<Matrix4> b(COUNT / 10);
+        for (uint32 i = 0; i < a.size(); ++i)
+        {
+            a[i] = RandomTransform(generator);
+            b[i] = RandomTransform(generator);
+        }
+
+        Vector<Matrix4> result(a.size());
+        for (uint32 i = 0; i < a.size(); ++i)
+        {
+            result[i] = a[i] * b[i];
+            // NEON backend can round differently, so compare with tolerance
+            TEST_VERIFY(IsClose(result[i], Multiply(a[i], b[i])));
+        }
+
+        // Vector4 * Matrix4 is consistent with Matrix4 * Matrix4
+        const Vector4 v(1.0f, 2.0f, 3.0f, 1.0f);
+        const Vector4 r = v * result[0];
+        const Vector3 p = TransformPoint(Vector3(1.0f, 2.0f, 3.0f), result[0]);
+        TEST_VERIFY(r.x == p.x && r.y == p.y && r.z == p.z);
+    }
+
+    DAVA_TEST (TransformedBoxTest)
+    {
+        using namespace MathBatchTestDetails;
+
+        std::mt19937 generator(44);
+        std::uniform_real_distribution<float32> position(-100.0f, 100.0f);
+        std::uniform_real_distribution<float32> size(0.1f, 10.0f);
+
+        Vector<AABBox3> boxes(COUNT / 10);
+        Vector<Matrix4> transforms(boxes.size());
+        for (uint32 i = 0; i < boxes.size(); ++i)
+        {
+            Vector3 min(position(generator), position(generator), position(generator));
+            boxes[i] = AABBox3(min, min + Vector3(size(generator), size(generator), size(generator)));
+            transforms[i] = RandomTransform(generator);
+        }
+
+        Vector<AABBox3> result(boxes.size());
+        for (uint32 i = 0; i < boxes.size(); ++i)
+        {
+            boxes[i].GetTransformedBox(transforms[i], result[i]);
+            // Box of transformed corners is the tightest box, so results can differ only in rounding
+            const AABBox3 expected = TransformBox(boxes[i], transforms[i]);
+            TEST_VERIFY(IsClose(result[i].min, expected.min));
+            TEST_VERIFY(IsClose(result[i].max, expected.max));
+        }
+
+        AABBox3 emptyResult(Vector3(0.0f, 0.0f, 0.0f), 1.0f);
+        AABBox3().GetTransformedBox(transforms[0], emptyResult);
+        TEST_VERIFY(emptyResult.IsEmpty());
+    }
+};
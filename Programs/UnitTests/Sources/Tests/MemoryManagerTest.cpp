@@ -114,6 +114,72 @@ DAVA_TESTCLASS (MemoryManagerTest)
         ::operator delete(buffer);
     }
 
+    DAVA_TEST (TestMultithreadedStat)
+    {
+        const size_t statSize = MemoryManager::Instance()->CalcCurStatSize();
+        void* buffer = ::operator new(statSize);
+        AllocPoolStat* poolStat = OffsetPointer<AllocPoolStat>(buffer, sizeof(MMCurStat));
+
+        MemoryManager::Instance()->GetCurStat(0, buffer, static_cast<uint32>(statSize));
+        uint32 oldAllocByApp = poolStat[ALLOC_POOL_PHYSICS].allocByApp;
+        uint32 oldBlockCount = poolStat[ALLOC_POOL_PHYSICS].blockCount;
+        uint32 oldUsage = MemoryManager::Instance()->GetTrackedMemoryUsage(ALLOC_POOL_PHYSICS);
+
+        // Every other allocation collects backtrace, big allocations always collect backtrace
+        MemoryManager::Instance()->SetBacktraceSampling(2, 1024);
+
+        const uint32 THREAD_COUNT = 4;
+        const uint32 ALLOC_COUNT = 1000;
+        const uint32 ALLOC_SIZE = 24;
+        Vector<void*> pointers[THREAD_COUNT];
+        Vector<Thread*> threads;
+        for (uint32 i = 0; i < THREAD_COUNT; ++i)
+        {
+            Vector<void*>* threadPointers = &pointers[i];
+            threads.push_back(Thread::Create([threadPointers, ALLOC_COUNT, ALLOC_SIZE]() {
+                threadPointers->reserve(ALLOC_COUNT);
+                for (uint32 k = 0; k < ALLOC_COUNT; ++k)
+                {
+                    threadPointers->push_back(MemoryManager::Instance()->Allocate(k % 100 == 0 ? 2048 : ALLOC_SIZE, ALLOC_POOL_PHYSICS));
+                }
+            }));
+        }
+        for (Thread* thread : threads)
+        {
+            thread->Start();
+        }
+        for (Thread* thread : threads)
+        {
+            thread->Join();
+            SafeRelease(thread);
+        }
+
+        // Statistics gathered in thread caches should be visible without waiting for Update()
+        const uint32 bigAllocCount = THREAD_COUNT * ALLOC_COUNT / 100;
+        const uint32 expectedSize = (THREAD_COUNT * ALLOC_COUNT - bigAllocCount) * ALLOC_SIZE + bigAllocCount * 2048;
+        MemoryManager::Instance()->GetCurStat(0, buffer, static_cast<uint32>(statSize));
+        TEST_VERIFY(oldAllocByApp + expectedSize == poolStat[ALLOC_POOL_PHYSICS].allocByApp);
+        TEST_VERIFY(oldBlockCount + THREAD_COUNT * ALLOC_COUNT == poolStat[ALLOC_POOL_PHYSICS].blockCount);
+        TEST_VERIFY(oldUsage + expectedSize == MemoryManager::Instance()->GetTrackedMemoryUsage(ALLOC_POOL_PHYSICS));
+
+        // Deallocate on thread other than allocating one
+        for (Vector<void*>& v : pointers)
+        {
+            for (void* ptr : v)
+            {
+                MemoryManager::Instance()->Deallocate(ptr);
+            }
+        }
+        MemoryManager::Instance()->SetBacktraceSampling(1, 0);
+
+        MemoryManager::Instance()->GetCurStat(0, buffer, static_cast<uint32>(statSize));
+        TEST_VERIFY(oldAllocByApp == poolStat[ALLOC_POOL_PHYSICS].allocByApp);
+        TEST_VERIFY(oldBlockCount == poolStat[ALLOC_POOL_PHYSICS].blockCount);
+        TEST_VERIFY(oldUsage == MemoryManager::Instance()->GetTrackedMemoryUsage(ALLOC_POOL_PHYSICS));
+
+        ::operator delete(buffer);
+    }
+
     DAVA_TEST (TestCallback)
     {
         const uint32 TAG = 1;
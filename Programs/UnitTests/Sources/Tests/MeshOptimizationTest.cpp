@@ -0,0 +1,224 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Render/3D/MeshUtils.h"
+#include "Render/Highlevel/GeometryGenerator.h"
+
+#include <random>
+
+using namespace DAVA;
+
+namespace MeshOptimizationTestDetails
+{
+const uint32 GRID_SIZE = 64;
+
+// Triangle list of regular grid with shuffled triangles, it is the worst case for vertex cache
+Vector<uint16> BuildShuffledGrid()
+{
+    Vector<Array<uint16, 3>> triangles;
+    for (uint32 y = 0; y + 1 < GRID_SIZE; ++y)
+    {
+        for (uint32 x = 0; x + 1 < GRID_SIZE; ++x)
+        {
+            uint16 v0 = static_cast<uint16>(y * GRID_SIZE + x);
+            uint16 v1 = static_cast<uint16>(v0 + 1);
+            uint16 v2 = static_cast<uint16>(v0 + GRID_SIZE);
+            uint16 v3 = static_cast<uint16>(v2 + 1);
+            triangles.push_back({ { v0, v1, v2 } });
+            triangles.push_back({ { v1, v3, v2 } });
+        }
+    }
+
+    std::mt19937 generator(42);
+    std::shuffle(triangles.begin(), triangles.end(), generator);
+
+    Vector<uint16> indices;
+    for (const Array<uint16, 3>& triangle : triangles)
+    {
+        indices.insert(indices.end(), triangle.begin(), triangle.end());
+    }
+    return indices;
+}
+
+Vector<Array<uint16, 3>> SortedTriangles(const Vector<uint16>& indices)
+{
+    Vector<Array<uint16, 3>> triangles;
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        triangles.push_back({ { indices[i], indices[i + 1], indices[i + 2] } });
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+Vector<Array<float32, 9>> SortedTrianglePositions(PolygonGroup* pg)
+{
+    Vector<Array<float32, 9>> triangles;
+    for (int32 i = 0; i < pg->GetIndexCount(); i += 3)
+    {
+        Array<float32, 9> triangle;
+        for (int32 k = 0; k < 3; ++k)
+        {
+            int32 index = 0;
+            Vector3 position;
+            pg->GetIndex(i + k, index);
+            pg->GetCoord(index, position);
+            triangle[k * 3] = position.x;
+            triangle[k * 3 + 1] = position.y;
+            triangle[k * 3 + 2] = position.z;
+        }
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+}
+
+DAVA_TESTCLASS (MeshOptimizationTest)
+{
+    DAVA_TEST (VertexCacheTest)
+    {
+        using namespace MeshOptimizationTestDetails;
+
+        Vector<uint16> indices = BuildShuffledGrid();
+        const uint32 indexCount = static_cast<uint32>(indices.size());
+        const uint32 vertexCount = GRID_SIZE * GRID_SIZE;
+        const Vector<Array<uint16, 3>> sourceTriangles = SortedTriangles(indices);
+
+        MeshUtils::VertexCacheStatistics before = MeshUtils::AnalyzeVertexCache(indices.data(), indexCount, vertexCount);
+        MeshUtils::OptimizeVertexCache(indices.data(), indexCount, vertexCount);
+        MeshUtils::VertexCacheStatistics after = MeshUtils::AnalyzeVertexCache(indices.data(), indexCount, vertexCount);
+
+        Logger::Info("Grid vertex cache optimization: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f", before.acmr, after.acmr, before.atvr, after.atvr);
+        TEST_VERIFY(before.acmr > 2.0f);
+        TEST_VERIFY(after.acmr < 0.8f);
+        TEST_VERIFY(after.atvr < before.atvr);
+        TEST_VERIFY(SortedTriangles(indices) == sourceTriangles);
+
+        // Overdraw optimization keeps triangles and doesn't break vertex cache much
+        Vector<Vector3> positions(vertexCount);
+        for (uint32 v = 0; v < vertexCount; ++v)
+        {
+            float32 x = static_cast<float32>(v % GRID_SIZE);
+            float32 y = static_cast<float32>(v / GRID_SIZE);
+            positions[v] = Vector3(x, y, std::sin(x * 0.2f) * std::cos(y * 0.2f) * 5.0f);
+        }
+
+        MeshUtils::OptimizeOverdraw(indices.data(), indexCount, positions.data(), sizeof(Vector3), vertexCount);
+        MeshUtils::VertexCacheStatistics overdraw = MeshUtils::AnalyzeVertexCache(indices.data(), indexCount, vertexCount);
+        TEST_VERIFY(overdraw.acmr <= after.acmr * 1.1f);
+        TEST_VERIFY(SortedTriangles(indices) == sourceTriangles);
+    }
+
+    DAVA_TEST (VertexFetchRemapTest)
+    {
+        const uint16 indices[] = { 4, 2, 0, 2, 4, 5 };
+        Vector<uint32> remap = MeshUtils::BuildVertexFetchRemap(indices, 6, 7);
+
+        // vertices go in order of first use, unused ones (1, 3, 6) go last keeping their order
+        const Vector<uint32> expected = { 2, 4, 1, 5, 0, 3, 6 };
+        TEST_VERIFY(remap == expected);
+    }
+
+    DAVA_TEST (PolygonGroupTest)
+    {
+        using namespace MeshOptimizationTestDetails;
+
+        Map<FastName, float32> options = {
+            { FastName("segments.x"), 16.0f },
+            { FastName("segments.y"), 16.0f },
+            { FastName("segments.z"), 16.0f }
+        };
+
+        ScopedPtr<PolygonGroup> geometry(GeometryGenerator::GenerateBox(AABBox3(Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 1.0f, 1.0f)), options));
+        const Vector<Array<float32, 9>> sourceTriangles = SortedTrianglePositions(geometry);
+
+        MeshUtils::VertexCacheStatistics before;
+        MeshUtils::VertexCacheStatistics after;
+        TEST_VERIFY(MeshUtils::OptimizePolygonGroup(geometry, true, &before, &after));
+        TEST_VERIFY(after.acmr <= before.acmr);
+        TEST_VERIFY(SortedTrianglePositions(geometry) == sourceTriangles);
+
+        // After vertex fetch optimization vertices are referenced first time in increasing order
+        int32 nextVertex = 0;
+        bool fetchOrdered = true;
+        for (int32 i = 0; i < geometry->GetIndexCount(); ++i)
+        {
+            int32 index = 0;
+            geometry->GetIndex(i, index);
+            fetchOrdered &= (index <= nextVertex);
+            nextVertex = Max(nextVertex, index + 1);
+        }
+        TEST_VERIFY(fetchOrdered);
+    }
+
+    DAVA_TEST (PolygonGroup32Test)
+    {
+        using namespace MeshOptimizationTestDetails;
+
+        // grid with more vertices than 16-bit indices can address
+        const uint32 gridSize = 260;
+        Vector<uint32> indices;
+        for (uint32 y = 0; y + 1 < gridSize; ++y)
+        {
+            for (uint32 x = 0; x + 1 < gridSize; ++x)
+            {
+                uint32 v0 = y * gridSize + x;
+                indices.insert(indices.end(), { v0, v0 + 1, v0 + gridSize, v0 + 1, v0 + gridSize + 1, v0 + gridSize });
+            }
+        }
+        std::mt19937 generator(42);
+        for (size_t t = indices.size() / 3 - 1; t > 0; --t)
+        {
+            size_t other = std::uniform_int_distribution<size_t>(0, t)(generator);
+            std::swap_ranges(indices.begin() + t * 3, indices.begin() + t * 3 + 3, indices.begin() + other * 3);
+        }
+
+        const int32 vertexCount = static_cast<int32>(gridSize * gridSize);
+        const int32 indexCount = static_cast<int32>(indices.size());
+        ScopedPtr<PolygonGroup> geometry(new PolygonGroup());
+        geometry->AllocateData(EVF_VERTEX, vertexCount, indexCount, indexCount / 3, EIF_32);
+        for (int32 i = 0; i < vertexCount; ++i)
+        {
+            geometry->SetCoord(i, Vector3(static_cast<float32>(i % gridSize), static_cast<float32>(i / gridSize), 0.0f));
+        }
+        for (int32 i = 0; i < indexCount; ++i)
+        {
+            geometry->SetIndex(i, static_cast<int32>(indices[i]));
+        }
+        const Vector<Array<float32, 9>> sourceTriangles = SortedTrianglePositions(geometry);
+
+        MeshUtils::VertexCacheStatistics before;
+        MeshUtils::VertexCacheStatistics after;
+        TEST_VERIFY(MeshUtils::OptimizePolygonGroup(geometry, true, &before, &after));
+        TEST_VERIFY(geometry->GetIndexFormat() == EIF_32);
+        TEST_VERIFY(before.acmr > 2.0f);
+        TEST_VERIFY(after.acmr < 1.0f);
+        TEST_VERIFY(SortedTrianglePositions(geometry) == sourceTriangles);
+    }
+
+    DAVA_TEST (SortedPolygonGroupTest)
+    {
+        // two triangle orders in one index buffer, drawn by offset, like SpeedTree sorted groups
+        const uint16 indices[] = { 0, 1, 2, 1, 3, 2, 1, 3, 2, 0, 1, 2 };
+
+        ScopedPtr<PolygonGroup> geometry(new PolygonGroup());
+        geometry->AllocateData(EVF_VERTEX, 4, 12, 2);
+        for (int32 i = 0; i < 4; ++i)
+        {
+            geometry->SetCoord(i, Vector3(static_cast<float32>(i % 2), static_cast<float32>(i / 2), 0.0f));
+        }
+        for (int32 i = 0; i < 12; ++i)
+        {
+            geometry->SetIndex(i, indices[i]);
+        }
+
+        TEST_VERIFY(!MeshUtils::OptimizePolygonGroup(geometry));
+        for (int32 i = 0; i < 12; ++i)
+        {
+            int32 index = 0;
+            geometry->GetIndex(i, index);
+            TEST_VERIFY(index == indices[i]);
+        }
+    }
+};
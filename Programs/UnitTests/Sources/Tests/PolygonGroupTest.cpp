@@ -0,0 +1,188 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Render/3D/MeshUtils.h"
+#include "Render/Highlevel/GeometryGenerator.h"
+#include "Render/Highlevel/GeometryOctTree.h"
+#include "Render/Material/NMaterialNames.h"
+
+using namespace DAVA;
+
+namespace PolygonGroupTestDetails
+{
+// Grid has more vertices than 16-bit indices can address
+const int32 GRID_SIZE = 300;
+
+PolygonGroup* CreateGrid(int32 vertexFormat = EVF_VERTEX)
+{
+    const int32 vertexCount = GRID_SIZE * GRID_SIZE;
+    const int32 indexCount = (GRID_SIZE - 1) * (GRID_SIZE - 1) * 6;
+
+    PolygonGroup* pg = new PolygonGroup();
+    pg->AllocateData(vertexFormat, vertexCount, indexCount, 0, EIF_32);
+    for (int32 v = 0; v < vertexCount; ++v)
+    {
+        pg->SetCoord(v, Vector3(static_cast<float32>(v % GRID_SIZE), static_cast<float32>(v / GRID_SIZE), 0.0f));
+        if (vertexFormat & EVF_NORMAL)
+            pg->SetNormal(v, Vector3(0.0f, 0.0f, 1.0f));
+        if (vertexFormat & EVF_TEXCOORD0)
+            pg->SetTexcoord(0, v, Vector2(static_cast<float32>(v % GRID_SIZE), static_cast<float32>(v / GRID_SIZE)) / float32(GRID_SIZE));
+    }
+    // Keep bounding box non-degenerate for ray casts
+    pg->SetCoord(0, Vector3(0.0f, 0.0f, -1.0f));
+
+    int32 index = 0;
+    for (int32 y = 0; y + 1 < GRID_SIZE; ++y)
+    {
+        for (int32 x = 0; x + 1 < GRID_SIZE; ++x)
+        {
+            int32 v0 = y * GRID_SIZE + x;
+            pg->SetIndex(index++, v0);
+            pg->SetIndex(index++, v0 + 1);
+            pg->SetIndex(index++, v0 + GRID_SIZE);
+            pg->SetIndex(index++, v0 + 1);
+            pg->SetIndex(index++, v0 + GRID_SIZE + 1);
+            pg->SetIndex(index++, v0 + GRID_SIZE);
+        }
+    }
+    pg->RecalcAABBox();
+    return pg;
+}
+}
+
+DAVA_TESTCLASS (PolygonGroupTest)
+{
+    DAVA_TEST (Index32Test)
+    {
+        using namespace PolygonGroupTestDetails;
+
+        ScopedPtr<PolygonGroup> grid(CreateGrid());
+        TEST_VERIFY(grid->indexFormat == EIF_32);
+        TEST_VERIFY(grid->indexArray == nullptr && grid->indexArray32 != nullptr);
+
+        int32 lastIndex = 0;
+        grid->GetIndex(grid->GetIndexCount() - 1, lastIndex);
+        TEST_VERIFY(lastIndex == GRID_SIZE * GRID_SIZE - 2);
+
+        ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+        grid->Save(archive, nullptr);
+
+        ScopedPtr<PolygonGroup> loaded(new PolygonGroup());
+        loaded->LoadPolygonData(archive, nullptr, EVF_VERTEX, false);
+        TEST_VERIFY(loaded->indexFormat == EIF_32);
+        TEST_VERIFY(loaded->GetIndexCount() == grid->GetIndexCount());
+
+        bool indicesEqual = true;
+        for (int32 i = 0; i < grid->GetIndexCount(); ++i)
+        {
+            int32 expected = 0;
+            int32 index = 0;
+            grid->GetIndex(i, expected);
+            loaded->GetIndex(i, index);
+            indicesEqual &= (index == expected);
+        }
+        TEST_VERIFY(indicesEqual);
+
+        // Ray hits triangle which uses vertices above 16-bit range
+        Ray3Optimized ray(Vector3(GRID_SIZE - 1.75f, GRID_SIZE - 1.75f, 1.0f), Vector3(0.0f, 0.0f, -2.0f));
+        float32 resultT = 0.0f;
+        uint32 triangleIndex = 0;
+        TEST_VERIFY(loaded->GetGeometryOctTree()->IntersectionWithRay(ray, resultT, triangleIndex));
+        TEST_VERIFY(FLOAT_EQUAL(resultT, 0.5f));
+
+        uint32 triangle[3];
+        loaded->GetTriangleIndices(3 * triangleIndex, triangle);
+        TEST_VERIFY(triangle[0] > 0xFFFF && triangle[1] > 0xFFFF && triangle[2] > 0xFFFF);
+    }
+
+    DAVA_TEST (TangentSpace32Test)
+    {
+        using namespace PolygonGroupTestDetails;
+
+        ScopedPtr<PolygonGroup> source(CreateGrid(EVF_VERTEX | EVF_NORMAL | EVF_TEXCOORD0));
+        ScopedPtr<PolygonGroup> grid(CreateGrid(EVF_VERTEX | EVF_NORMAL | EVF_TEXCOORD0));
+        MeshUtils::RebuildMeshTangentSpace(grid);
+
+        TEST_VERIFY(grid->indexFormat == EIF_32);
+        TEST_VERIFY((grid->GetFormat() & EVF_TANGENT) != 0);
+        TEST_VERIFY(grid->GetIndexCount() == source->GetIndexCount());
+
+        // Triangles keep their positions after vertices are split for tangent space
+        bool trianglesEqual = true;
+        for (int32 i = 0; i < grid->GetIndexCount(); ++i)
+        {
+            int32 expectedIndex = 0;
+            int32 index = 0;
+            source->GetIndex(i, expectedIndex);
+            grid->GetIndex(i, index);
+
+            Vector3 expected;
+            Vector3 coord;
+            source->GetCoord(expectedIndex, expected);
+            grid->GetCoord(index, coord);
+            trianglesEqual &= (expected == coord);
+        }
+        TEST_VERIFY(trianglesEqual);
+    }
+
+    DAVA_TEST (QuantizationTest)
+    {
+        Map<FastName, float32> options = {
+            { FastName("segments.x"), 4.0f },
+            { FastName("segments.y"), 4.0f },
+            { FastName("segments.z"), 4.0f }
+        };
+
+        ScopedPtr<PolygonGroup> box(GeometryGenerator::GenerateBox(AABBox3(Vector3(-1.0f, -2.0f, -3.0f), Vector3(1.0f, 2.0f, 3.0f)), options));
+        const int32 format = EVF_VERTEX | EVF_NORMAL | EVF_TEXCOORD0;
+        TEST_VERIFY((box->GetFormat() & format) == format);
+
+        TEST_VERIFY(PolygonGroup::GetQuantizedVertexSize(format, PolygonGroup::QUANTIZE_NONE) == static_cast<uint32>(GetVertexSize(format)));
+        TEST_VERIFY(PolygonGroup::GetQuantizedVertexSize(format, PolygonGroup::QUANTIZE_ALL) == 16);
+        TEST_VERIFY(PolygonGroup::GetQuantizedVertexSize(format, PolygonGroup::QUANTIZE_POSITION) == static_cast<uint32>(GetVertexSize(format)) - 4);
+
+        ScopedPtr<NMaterial> material(new NMaterial());
+        material->SetFXName(NMaterialName::TEXTURED_OPAQUE);
+
+        ScopedPtr<Mesh> mesh(new Mesh());
+        mesh->AddPolygonGroup(box, material);
+
+        ScopedPtr<Entity> entity(new Entity());
+        entity->SetName("QuantizationTest");
+        entity->AddComponent(new RenderComponent(mesh));
+
+        MeshUtils::GeometryQuantizationStatistics statistics = MeshUtils::QuantizeGeometryRecursive(entity);
+        TEST_VERIFY(statistics.polygonGroupCount == 1);
+        TEST_VERIFY(statistics.quantizedVertexBytes < statistics.vertexBytes);
+        TEST_VERIFY(statistics.quantizedIndexBytes == statistics.indexBytes);
+        TEST_VERIFY(box->GetVertexQuantization() == PolygonGroup::QUANTIZE_ALL);
+        TEST_VERIFY(material->HasLocalFlag(NMaterialFlagName::FLAG_VERTEX_QUANTIZED_POSITION));
+        TEST_VERIFY(material->HasLocalFlag(NMaterialFlagName::FLAG_VERTEX_OCTAHEDRAL_NORMAL));
+
+        // CPU copy of geometry stays exact
+        Vector3 position;
+        box->GetCoord(0, position);
+        TEST_VERIFY(box->GetBoundingBox().IsInside(position));
+
+        // Quantization is kept in archive
+        ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+        box->Save(archive, nullptr);
+        ScopedPtr<PolygonGroup> loaded(new PolygonGroup());
+        loaded->LoadPolygonData(archive, nullptr, box->GetFormat(), false);
+        TEST_VERIFY(loaded->GetVertexQuantization() == PolygonGroup::QUANTIZE_ALL);
+
+        // Geometry drawn with shaders without decode is left as is
+        ScopedPtr<PolygonGroup> shadowBox(GeometryGenerator::GenerateBox(AABBox3(Vector3(0.0f, 0.0f, 0.0f), 1.0f), options));
+        ScopedPtr<NMaterial> shadowMaterial(new NMaterial());
+        shadowMaterial->SetFXName(NMaterialName::SHADOW_VOLUME);
+        ScopedPtr<Mesh> shadowMesh(new Mesh());
+        shadowMesh->AddPolygonGroup(shadowBox, shadowMaterial);
+        ScopedPtr<Entity> shadowEntity(new Entity());
+        shadowEntity->AddComponent(new RenderComponent(shadowMesh));
+
+        statistics = MeshUtils::QuantizeGeometryRecursive(shadowEntity);
+        TEST_VERIFY(statistics.polygonGroupCount == 0);
+        TEST_VERIFY(shadowBox->GetVertexQuantization() == PolygonGroup::QUANTIZE_NONE);
+        TEST_VERIFY(!shadowMaterial->HasLocalFlag(NMaterialFlagName::FLAG_VERTEX_QUANTIZED_POSITION));
+    }
+};
@@ -71,6 +71,13 @@ static bool ReadTextData(const char* fileName, std::vector<char>* data)
     return success;
 }
 
+static DAVA::String RemoveCarriageReturns(const std::vector<char>& text)
+{
+    DAVA::String result(text.begin(), text.end());
+    result.erase(std::remove(result.begin(), result.end(), '\r'), result.end());
+    return result;
+}
+
 DAVA_TESTCLASS (PreprocessorTest)
 {
     static bool CompareStringBuffers();
@@ -285,4 +292,170 @@ DAVA_TESTCLASS (PreprocessorTest)
 
         DAVA::Logger::Info("pre-proc tests PASSED");
     }
+
+    DAVA_TEST (TestIncludeCache)
+    {
+        // material-like shader: include with defaults for flags and conditions repeated in several places
+        static const char* CommonText =
+        "#define MAX_JOINTS 32\n"
+        "#define _PI 3.141592654\n"
+        "#ensuredefined VERTEX_LIT 0\n"
+        "#ensuredefined PIXEL_LIT 0\n"
+        "#ensuredefined VERTEX_FOG 0\n"
+        "#ensuredefined SKINNING 0\n"
+        "#ensuredefined FLOWMAP 0\n"
+        "#ensuredefined ALPHATEST 0\n"
+        "#if VERTEX_LIT || PIXEL_LIT\n"
+        "    #define LIGHTING 1\n"
+        "#else\n"
+        "    #define LIGHTING 0\n"
+        "#endif\n";
+
+        static const char* FogText =
+        "/* fog parameters */\n"
+        "#if VERTEX_FOG\n"
+        "[auto][a] property float fogDensity;\n"
+        "    #if LIGHTING\n"
+        "[auto][a] property float3 fogColor; // lit fog\n"
+        "    #endif\n"
+        "#endif\n";
+
+        static const char* ShaderText =
+        "#include \"common.slh\"\n"
+        "vertex_in\n"
+        "{\n"
+        "    float3 pos : POSITION;\n"
+        "#if SKINNING\n"
+        "    float4 index : BLENDINDICES;\n"
+        "    float4 weight : BLENDWEIGHT;\n"
+        "#endif\n"
+        "};\n"
+        "#include \"fog.slh\"\n"
+        "[auto][a] property float4x4 worldViewProjMatrix;\n"
+        "#if SKINNING\n"
+        "[auto][jpos] property float4 jointPositions[MAX_JOINTS] : \"bigarray\";\n"
+        "#endif\n"
+        "vertex_out vp_main( vertex_in input )\n"
+        "{\n"
+        "    vertex_out output; // comment\n"
+        "#if LIGHTING\n"
+        "    float angle = _PI * 0.5;\n"
+        "    #if PIXEL_LIT && !VERTEX_LIT\n"
+        "    output.angle = angle;\n"
+        "    #endif\n"
+        "#endif\n"
+        "#if VERTEX_FOG && LIGHTING\n"
+        "    output.fog = fogDensity * fogColor.x;\n"
+        "#elif VERTEX_FOG\n"
+        "    output.fog = fogDensity;\n"
+        "#endif\n"
+        "#if FLOWMAP\n"
+        "    output.flow = MAX_JOINTS;\n"
+        "#endif\n"
+        "#if ALPHATEST\n"
+        "    output.alpha = 1.0;\n"
+        "#endif\n"
+        "    return output;\n"
+        "}\n";
+
+        class MemoryFileCallback : public DAVA::PreProc::FileCallback
+        {
+        public:
+            bool Open(const char* file_name) override
+            {
+                current = nullptr;
+                if (strcmp(file_name, "common.slh") == 0)
+                    current = CommonText;
+                else if (strcmp(file_name, "fog.slh") == 0)
+                    current = FogText;
+                return current != nullptr;
+            }
+
+            void Close() override
+            {
+                current = nullptr;
+            }
+
+            DAVA::uint32 Size() const override
+            {
+                return (current) ? DAVA::uint32(strlen(current)) : 0;
+            }
+
+            DAVA::uint32 Read(DAVA::uint32 max_sz, void* dst) override
+            {
+                memcpy(dst, current, max_sz);
+                return max_sz;
+            }
+
+        private:
+            const char* current = nullptr;
+        };
+
+        const char* flags[] = { "VERTEX_LIT", "PIXEL_LIT", "VERTEX_FOG", "SKINNING", "FLOWMAP", "ALPHATEST" };
+        const DAVA::uint32 variantCount = 1 << countof(flags);
+        const DAVA::uint32 passCount = 2; // second pass reuses cached texts and results
+
+        MemoryFileCallback fc;
+        DAVA::PreProc::IncludeCache cache;
+
+        // outputs of all variants produced by preprocessor before include cache was introduced,
+        // each one follows "// variant <index>" line
+        std::vector<char> expectedText;
+        TEST_VERIFY(ReadTextData("~res:/TestData/PreProcessor/IncludeCache-output.preproc", &expectedText));
+        DAVA::Vector<DAVA::String> expected(variantCount);
+        {
+            const DAVA::String text = RemoveCarriageReturns(expectedText);
+            size_t variantBegin = text.find("// variant ");
+            while (variantBegin != DAVA::String::npos)
+            {
+                size_t outputBegin = text.find('\n', variantBegin) + 1;
+                size_t outputEnd = text.find("// variant ", outputBegin);
+                DAVA::uint32 v = static_cast<DAVA::uint32>(atoi(text.c_str() + variantBegin + strlen("// variant ")));
+                TEST_VERIFY(v < variantCount);
+                if (v < variantCount)
+                {
+                    expected[v] = text.substr(outputBegin, (outputEnd == DAVA::String::npos) ? DAVA::String::npos : outputEnd - outputBegin);
+                }
+                variantBegin = outputEnd;
+            }
+        }
+
+        for (DAVA::uint32 pass = 0; pass != passCount; ++pass)
+        {
+            for (DAVA::uint32 v = 0; v != variantCount; ++v)
+            {
+                DAVA::PreProc pp(&fc);
+                for (DAVA::uint32 f = 0; f != countof(flags); ++f)
+                {
+                    pp.AddDefine(flags[f], (v & (1 << f)) ? "1" : "0");
+                }
+                std::vector<char> output;
+                TEST_VERIFY(pp.Process(ShaderText, &output));
+                TEST_VERIFY(RemoveCarriageReturns(output) == expected[v]);
+            }
+        }
+
+        for (DAVA::uint32 pass = 0; pass != passCount; ++pass)
+        {
+            for (DAVA::uint32 v = 0; v != variantCount; ++v)
+            {
+                DAVA::PreProc pp(&fc, &cache);
+                for (DAVA::uint32 f = 0; f != countof(flags); ++f)
+                {
+                    pp.AddDefine(flags[f], (v & (1 << f)) ? "1" : "0");
+                }
+                std::vector<char> output;
+                TEST_VERIFY(pp.Process(ShaderText, &output));
+                TEST_VERIFY(RemoveCarriageReturns(output) == expected[v]);
+            }
+        }
+
+        // cleared cache gives same result, flags which are not defined are set to 0 by #ensuredefined
+        cache.Clear();
+        DAVA::PreProc pp(&fc, &cache);
+        pp.AddDefine("SKINNING", "1");
+        std::vector<char> output;
+        TEST_VERIFY(pp.Process(ShaderText, &output));
+        TEST_VERIFY(RemoveCarriageReturns(output) == expected[1 << 3]);
+    }
 };
@@ -0,0 +1,180 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "FileSystem/FileAPIHelper.h"
+#include "FileSystem/Private/ResourcesIndex.h"
+
+using namespace DAVA;
+
+namespace ResourcesIndexTestDetails
+{
+const FilePath resDir("~doc:/UnitTests/ResourcesIndexTest/");
+
+void WriteFile(const FilePath& path, const String& content)
+{
+    ScopedPtr<File> file(File::Create(path, File::CREATE | File::WRITE));
+    file->WriteString(content, false);
+}
+
+#if defined(__DAVAENGINE_DEBUG__)
+// number of file system calls made to check and open resources
+uint64 MeasureCalls(FileSystem* fs)
+{
+    const uint64 startCount = FileAPI::GetCallCount();
+    for (uint32 i = 0; i < 10; ++i)
+    {
+        fs->IsFile("~res:/index_test_a.txt");
+        fs->IsFile("~res:/index_test_missing.txt");
+        ScopedPtr<File> file(File::Create("~res:/index_test_sub/c.txt", File::OPEN | File::READ));
+        ScopedPtr<File> missing(File::Create("~res:/index_test_missing.txt", File::OPEN | File::READ));
+    }
+    return FileAPI::GetCallCount() - startCount;
+}
+#endif
+}
+
+DAVA_TESTCLASS (ResourcesIndexTest)
+{
+    DAVA_TEST (LookupTest)
+    {
+        using namespace ResourcesIndexTestDetails;
+
+        FileSystem* fs = GetEngineContext()->fileSystem;
+        const bool wasEnabled = fs->IsResourcesIndexEnabled();
+        fs->SetResourcesIndexEnabled(false);
+        fs->DeleteDirectory(resDir, true);
+        fs->CreateDirectory(resDir + "index_test_sub/", true);
+        WriteFile(resDir + "index_test_a.txt", "a");
+        WriteFile(resDir + "index_test_b.txt.dvpl", "b");
+        WriteFile(resDir + "index_test_sub/c.txt", "c");
+
+        FilePath::AddResourcesFolder(resDir);
+
+#if defined(__DAVAENGINE_DEBUG__)
+        const uint64 callsWithoutIndex = MeasureCalls(fs);
+#endif
+
+        fs->SetResourcesIndexEnabled(true);
+        TEST_VERIFY(fs->IsResourcesIndexEnabled());
+        fs->WaitResourcesIndex();
+
+        TEST_VERIFY(fs->IsFile("~res:/index_test_a.txt"));
+        TEST_VERIFY(fs->IsFile("~res:/index_test_b.txt"));
+        TEST_VERIFY(!fs->IsFile("~res:/index_test_missing.txt"));
+        TEST_VERIFY(fs->IsDirectory("~res:/index_test_sub/"));
+        TEST_VERIFY(!fs->IsDirectory("~res:/index_test_a.txt"));
+        TEST_VERIFY(FilePath("~res:/index_test_a.txt").GetAbsolutePathname() == (resDir + "index_test_a.txt").GetAbsolutePathname());
+
+        {
+            ScopedPtr<File> file(File::Create("~res:/index_test_sub/c.txt", File::OPEN | File::READ));
+            TEST_VERIFY(file && file->GetSize() == 1);
+        }
+
+#if defined(__DAVAENGINE_DEBUG__)
+        const uint64 callsWithIndex = MeasureCalls(fs);
+        TEST_VERIFY(callsWithIndex <= callsWithoutIndex);
+#endif
+
+        // changes made through FileSystem and File are visible right away and after index is rebuilt
+        WriteFile(resDir + "index_test_d.txt", "d");
+        fs->CreateDirectory(resDir + "index_test_new/");
+        fs->MoveFile(resDir + "index_test_a.txt", resDir + "index_test_moved.txt");
+        fs->DeleteFile(resDir + "index_test_sub/c.txt");
+        for (uint32 pass = 0; pass < 2; ++pass)
+        {
+            TEST_VERIFY(fs->IsFile("~res:/index_test_d.txt"));
+            TEST_VERIFY(fs->IsDirectory("~res:/index_test_new/"));
+            TEST_VERIFY(fs->IsFile("~res:/index_test_moved.txt"));
+            TEST_VERIFY(!fs->IsFile("~res:/index_test_a.txt"));
+            TEST_VERIFY(!fs->IsFile("~res:/index_test_sub/c.txt"));
+            fs->WaitResourcesIndex();
+        }
+
+        // files written bypassing FileSystem are visible after index is invalidated
+        FILE* external = FileAPI::OpenFile((resDir + "index_test_e.txt").GetAbsolutePathname(), "wb");
+        TEST_VERIFY(external != nullptr);
+        if (external != nullptr)
+        {
+            FileAPI::Close(external);
+        }
+        fs->InvalidateResourcesIndex();
+        fs->WaitResourcesIndex();
+        TEST_VERIFY(fs->IsFile("~res:/index_test_e.txt"));
+
+        FilePath::RemoveResourcesFolder(resDir);
+        fs->DeleteDirectory(resDir, true);
+        fs->SetResourcesIndexEnabled(wasEnabled);
+    }
+
+    DAVA_TEST (ResolveTest)
+    {
+        using namespace ResourcesIndexTestDetails;
+
+        FileSystem* fs = GetEngineContext()->fileSystem;
+        const bool wasEnabled = fs->IsResourcesIndexEnabled();
+        fs->SetResourcesIndexEnabled(false);
+        const FilePath rootA = resDir + "a/";
+        const FilePath rootB = resDir + "b/";
+        fs->DeleteDirectory(resDir, true);
+        fs->CreateDirectory(rootA + "sub/", true);
+        fs->CreateDirectory(rootB + "sub/", true);
+        WriteFile(rootA + "a.txt", "a");
+        WriteFile(rootA + "sub/both.txt", "a");
+        WriteFile(rootB + "sub/both.txt", "b");
+        WriteFile(rootB + "packed.txt.dvpl", "b");
+
+        Vector<FilePath> folders = { rootA, rootB };
+        ResourcesIndex index(folders);
+        index.SetEnabled(true);
+        index.WaitBuilt();
+
+        const String absA = rootA.GetAbsolutePathname();
+        const String absB = rootB.GetAbsolutePathname();
+        String resolved;
+
+        TEST_VERIFY(index.Resolve("a.txt", resolved) == ResourcesIndex::FILE);
+        TEST_VERIFY(resolved == absA + "a.txt");
+
+        // later folder has priority
+        TEST_VERIFY(index.Resolve("sub/both.txt", resolved) == ResourcesIndex::FILE);
+        TEST_VERIFY(resolved == absB + "sub/both.txt");
+
+        // .dvpl variant counts as file
+        TEST_VERIFY(index.Resolve("packed.txt", resolved) == ResourcesIndex::FILE);
+        TEST_VERIFY(resolved == absB + "packed.txt");
+
+        // directory with and without trailing slash
+        TEST_VERIFY(index.Resolve("sub/", resolved) == ResourcesIndex::DIRECTORY);
+        TEST_VERIFY(resolved == absB + "sub/");
+        TEST_VERIFY(index.Resolve("sub", resolved) == ResourcesIndex::DIRECTORY);
+        TEST_VERIFY(resolved == absB + "sub");
+
+        TEST_VERIFY(index.Resolve("missing.txt", resolved) == ResourcesIndex::NOT_FOUND);
+        TEST_VERIFY(resolved == "missing.txt");
+        TEST_VERIFY(index.Resolve("a.txt/", resolved) == ResourcesIndex::NOT_FOUND);
+
+        TEST_VERIFY(index.Lookup(absB + "sub") == ResourcesIndex::DIRECTORY);
+        TEST_VERIFY(index.Lookup(absA + "a.txt") == ResourcesIndex::FILE);
+
+        // FilePath resolves the same way with and without index
+        FilePath::AddResourcesFolder(rootA);
+        FilePath::AddResourcesFolder(rootB);
+        const String fileWithoutIndex = FilePath("~res:/a.txt").GetAbsolutePathname();
+        const String dirWithoutIndex = FilePath("~res:/sub").GetAbsolutePathname();
+        const String dirWithSlashWithoutIndex = FilePath("~res:/sub/").GetAbsolutePathname();
+        fs->SetResourcesIndexEnabled(true);
+        fs->WaitResourcesIndex();
+        TEST_VERIFY(FilePath("~res:/a.txt").GetAbsolutePathname() == fileWithoutIndex);
+        TEST_VERIFY(FilePath("~res:/sub").GetAbsolutePathname() == dirWithoutIndex);
+        TEST_VERIFY(FilePath("~res:/sub/").GetAbsolutePathname() == dirWithSlashWithoutIndex);
+        TEST_VERIFY(fs->IsDirectory("~res:/sub"));
+        TEST_VERIFY(fs->IsDirectory("~res:/sub/"));
+        fs->SetResourcesIndexEnabled(false);
+        FilePath::RemoveResourcesFolder(rootB);
+        FilePath::RemoveResourcesFolder(rootA);
+
+        index.SetEnabled(false);
+        fs->DeleteDirectory(resDir, true);
+        fs->SetResourcesIndexEnabled(wasEnabled);
+    }
+};
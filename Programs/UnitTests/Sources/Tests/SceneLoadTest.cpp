@@ -0,0 +1,108 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+namespace SceneLoadTestDetails
+{
+// largest scenes in test data
+const Vector<FilePath> scenePaths = {
+    "~res:/3d/Maps/SlotItem/big01.sc2",
+    "~res:/3d/Maps/test/treetest/TEST_1HI.sc2",
+    "~res:/3d/LandscapeTest/landscapetest.sc2"
+};
+
+uint32 CountEntities(Entity* entity)
+{
+    uint32 count = 1;
+    for (Entity* child : entity->children)
+    {
+        count += CountEntities(child);
+    }
+    return count;
+}
+}
+
+DAVA_TESTCLASS (SceneLoadTest)
+{
+    struct AsyncLoad
+    {
+        ScopedPtr<Scene> scene{ new Scene() };
+        Vector<float32> progress;
+        SceneFileV2::eError error = SceneFileV2::ERROR_NO_ERROR;
+        bool finished = false;
+    };
+
+    Vector<std::shared_ptr<AsyncLoad>> asyncLoads;
+    Vector<uint32> syncEntityCounts;
+
+    bool TestComplete(const String& testName) const override
+    {
+        if (testName == "LoadAsyncTest")
+        {
+            for (const std::shared_ptr<AsyncLoad>& load : asyncLoads)
+            {
+                if (!load->finished)
+                {
+                    return false;
+                }
+            }
+            CheckAsyncLoads();
+        }
+        return true;
+    }
+
+    // Loads scenes synchronously, used as reference for async loading
+    DAVA_TEST (LoadSyncTest)
+    {
+        using namespace SceneLoadTestDetails;
+
+        syncEntityCounts.clear();
+        for (const FilePath& path : scenePaths)
+        {
+            ScopedPtr<Scene> scene(new Scene());
+            TEST_VERIFY(scene->LoadScene(path) == SceneFileV2::ERROR_NO_ERROR);
+
+            syncEntityCounts.push_back(CountEntities(scene));
+        }
+    }
+
+    DAVA_TEST (LoadAsyncTest)
+    {
+        using namespace SceneLoadTestDetails;
+
+        asyncLoads.clear();
+        for (const FilePath& path : scenePaths)
+        {
+            std::shared_ptr<AsyncLoad> load = std::make_shared<AsyncLoad>();
+            asyncLoads.push_back(load);
+
+            auto onProgress = [load](float32 progress) {
+                load->progress.push_back(progress);
+            };
+            auto onFinished = [load](SceneFileV2::eError error) {
+                load->error = error;
+                load->finished = true;
+            };
+
+            load->scene->LoadAsync(path, onProgress, onFinished);
+        }
+    }
+
+    void CheckAsyncLoads() const
+    {
+        using namespace SceneLoadTestDetails;
+
+        for (size_t i = 0; i < asyncLoads.size(); ++i)
+        {
+            const AsyncLoad& load = *asyncLoads[i];
+            TEST_VERIFY(load.error == SceneFileV2::ERROR_NO_ERROR);
+            TEST_VERIFY(!load.progress.empty() && load.progress.front() == 0.0f && load.progress.back() == 1.0f);
+            TEST_VERIFY(std::is_sorted(load.progress.begin(), load.progress.end()));
+            if (i < syncEntityCounts.size())
+            {
+                TEST_VERIFY(CountEntities(load.scene) == syncEntityCounts[i]);
+            }
+        }
+    }
+};
@@ -4,6 +4,7 @@
 #include "Math/MathDefines.h"
 #include "Reflection/ReflectionRegistrator.h"
 #include "Scripting/LuaScript.h"
+#include "Time/SystemTimer.h"
 
 struct ReflClass : public DAVA::ReflectionBase
 {
@@ -83,6 +84,21 @@ DAVA_VIRTUAL_REFLECTION_IMPL(ReflClass)
     .End();
 }
 
+// Has field with the same name as ReflClass but of other type
+struct ReflOtherClass
+{
+    DAVA_REFLECTION(ReflOtherClass);
+
+    DAVA::String intVal = "not int";
+};
+
+DAVA_REFLECTION_IMPL(ReflOtherClass)
+{
+    DAVA::ReflectionRegistrator<ReflOtherClass>::Begin()
+    .Field("intVal", &ReflOtherClass::intVal)
+    .End();
+}
+
 DAVA_TESTCLASS (ScriptTest)
 {
     BEGIN_FILES_COVERED_BY_TESTS()
@@ -259,6 +275,100 @@ end
         }
     }
 
+    DAVA_TEST (ReflectionSameKeyTest)
+    {
+        DAVA::LuaScript s;
+
+        ReflClass cl;
+        cl.intVal = 7;
+        ReflOtherClass other;
+
+        const DAVA::String script = R"script(
+function get_int(context)
+    return context.intVal
+end
+
+function set_int(context, value)
+    context.intVal = value
+end
+)script";
+
+        TEST_VERIFY(s.ExecStringSafe(script) >= 0);
+
+        // The same key is resolved separately for each reflected type
+        DAVA::Any r;
+        DAVA::int32 nresults = s.ExecFunctionSafe("get_int", DAVA::Reflection::Create(&cl));
+        TEST_VERIFY(nresults == 1 && s.GetResultSafe<DAVA::int32>(1, r) && r.Get<DAVA::int32>() == 7);
+        s.Pop(nresults);
+
+        nresults = s.ExecFunctionSafe("get_int", DAVA::Reflection::Create(&other));
+        TEST_VERIFY(nresults == 1 && s.GetResultSafe<DAVA::String>(1, r) && r.Get<DAVA::String>() == "not int");
+        s.Pop(nresults);
+
+        TEST_VERIFY(s.ExecFunctionSafe("set_int", DAVA::Reflection::Create(&cl), 9) >= 0);
+        TEST_VERIFY(s.ExecFunctionSafe("set_int", DAVA::Reflection::Create(&other), DAVA::String("text")) >= 0);
+        TEST_VERIFY(cl.intVal == 9);
+        TEST_VERIFY(other.intVal == "text");
+
+        // Wrong value type for cached field still fails
+        TEST_VERIFY(s.ExecFunctionSafe("set_int", DAVA::Reflection::Create(&cl), DAVA::String("text")) < 0);
+    }
+
+    // Measures throughput of fields access from Lua, results are written to log
+    DAVA_TEST (ReflectionFieldsBenchmarkTest)
+    {
+        DAVA::LuaScript s;
+
+        ReflClass cl;
+        const DAVA::int32 iterations = 100000;
+
+        const DAVA::String script = R"script(
+function get_fields(context, n)
+    local sum = 0
+    for i = 1, n do
+        sum = sum + context.intVal + context.floatVal
+        if context.boolVal then
+            sum = sum + #context.stringVal
+        end
+    end
+    return sum
+end
+
+function set_fields(context, n)
+    for i = 1, n do
+        context.intVal = i
+        context.floatVal = i * 0.5
+        context.boolVal = (i % 2) == 0
+        context.stringVal = "str"
+    end
+end
+)script";
+
+        TEST_VERIFY(s.ExecStringSafe(script) >= 0);
+        DAVA::Reflection clRef = DAVA::Reflection::Create(&cl);
+
+        DAVA::int64 startMs = DAVA::SystemTimer::GetMs();
+        TEST_VERIFY(s.ExecFunctionSafe("set_fields", clRef, iterations) >= 0);
+        DAVA::int64 setMs = DAVA::SystemTimer::GetMs() - startMs;
+
+        TEST_VERIFY(cl.intVal == iterations);
+        TEST_VERIFY(FLOAT_EQUAL(cl.floatVal, iterations * 0.5f));
+        TEST_VERIFY(cl.boolVal == true);
+        TEST_VERIFY(cl.stringVal == "str");
+
+        startMs = DAVA::SystemTimer::GetMs();
+        DAVA::int32 nresults = s.ExecFunctionSafe("get_fields", clRef, iterations);
+        DAVA::int64 getMs = DAVA::SystemTimer::GetMs() - startMs;
+
+        DAVA::Any r;
+        TEST_VERIFY(nresults == 1 && s.GetResultSafe<DAVA::float64>(1, r));
+        TEST_VERIFY(FLOAT_EQUAL_EPS(r.Get<DAVA::float64>(), iterations * (iterations + iterations * 0.5 + 3.0), 1.0));
+        s.Pop(nresults);
+
+        const DAVA::int32 accessCount = iterations * 4;
+        DAVA::Logger::Info("[ScriptTest] %d field gets in %lld ms, %d field sets in %lld ms", accessCount, getMs, accessCount, setMs);
+    }
+
     DAVA_TEST (BasicTest)
     {
         DAVA::LuaScript s;
@@ -0,0 +1,99 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Base/Hash.h"
+#include "Render/RHI/rhi_ShaderSource.h"
+
+using namespace DAVA;
+
+namespace ShaderSourceCacheTestDetails
+{
+const uint32 VARIANT_COUNT = 100;
+const char* CACHE_FILE = "~doc:/ShaderSourceCacheTest.bin";
+const char* BACKUP_FILE = "~doc:/ShaderSourceCacheTest.backup.bin";
+
+const char* SOURCE_TEXT =
+"fragment_in {};\n"
+"\n"
+"fragment_out\n"
+"{\n"
+"    float4  color : SV_TARGET0;\n"
+"};\n"
+"\n"
+"[material][a] property float4  testColor;\n"
+"\n"
+"fragment_out fp_main( fragment_in input )\n"
+"{\n"
+"    fragment_out    output;\n"
+"    output.color = testColor;\n"
+"    return output;\n"
+"}\n";
+
+FastName VariantUid(uint32 index)
+{
+    return FastName(Format("ShaderSourceCacheTest.%u", index));
+}
+
+const rhi::ShaderSource* AddVariant(uint32 index)
+{
+    std::vector<std::string> defines = { "VARIANT", Format("%u", index) };
+    return rhi::ShaderSourceCache::Add("ShaderSourceCacheTest", VariantUid(index), rhi::PROG_FRAGMENT, SOURCE_TEXT, defines);
+}
+}
+
+DAVA_TESTCLASS (ShaderSourceCacheTest)
+{
+    DAVA_TEST (SaveLoadTest)
+    {
+        using namespace ShaderSourceCacheTestDetails;
+
+        const uint32 srcHash = HashValue_N(SOURCE_TEXT, static_cast<uint32>(strlen(SOURCE_TEXT)));
+
+        // keep sources already cached by engine, cache is global
+        rhi::ShaderSourceCache::Save(BACKUP_FILE);
+        rhi::ShaderSourceCache::Clear();
+        FileSystem::Instance()->DeleteFile(CACHE_FILE);
+
+        Vector<String> expectedCode(VARIANT_COUNT);
+        for (uint32 i = 0; i < VARIANT_COUNT; ++i)
+        {
+            const rhi::ShaderSource* src = AddVariant(i);
+            TEST_VERIFY(src != nullptr);
+            if (src != nullptr)
+            {
+                expectedCode[i] = src->GetSourceCode(rhi::HostApi());
+            }
+        }
+
+        rhi::ShaderSourceCache::Save(CACHE_FILE);
+        rhi::ShaderSourceCache::Clear();
+        rhi::ShaderSourceCache::Load(CACHE_FILE);
+
+        for (uint32 i = 0; i < VARIANT_COUNT; ++i)
+        {
+            const rhi::ShaderSource* src = rhi::ShaderSourceCache::Get(VariantUid(i), srcHash);
+            TEST_VERIFY(src != nullptr);
+            if (src != nullptr)
+            {
+                TEST_VERIFY(src->GetSourceCode(rhi::HostApi()) == expectedCode[i]);
+            }
+        }
+
+        TEST_VERIFY(rhi::ShaderSourceCache::Get(VariantUid(0), srcHash + 1) == nullptr);
+        TEST_VERIFY(rhi::ShaderSourceCache::Get(VariantUid(VARIANT_COUNT), srcHash) == nullptr);
+
+        // new source is appended to existing file
+        TEST_VERIFY(AddVariant(VARIANT_COUNT) != nullptr);
+        rhi::ShaderSourceCache::Save(CACHE_FILE);
+        rhi::ShaderSourceCache::Clear();
+        rhi::ShaderSourceCache::Load(CACHE_FILE);
+        TEST_VERIFY(rhi::ShaderSourceCache::Get(VariantUid(0), srcHash) != nullptr);
+        TEST_VERIFY(rhi::ShaderSourceCache::Get(VariantUid(VARIANT_COUNT), srcHash) != nullptr);
+
+        rhi::ShaderSourceCache::Clear();
+        FileSystem::Instance()->DeleteFile(CACHE_FILE);
+
+        rhi::ShaderSourceCache::Load(BACKUP_FILE);
+        FileSystem::Instance()->DeleteFile(BACKUP_FILE);
+    }
+};
@@ -0,0 +1,169 @@
+#include "DAVAEngine.h"
+
+#include "UI/Formula/Private/FormulaCompiler.h"
+#include "UI/Formula/Private/FormulaParser.h"
+#include "UI/Formula/Private/FormulaExecutor.h"
+#include "UI/Formula/Private/FormulaException.h"
+
+#include "Reflection/ReflectionRegistrator.h"
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+class FormulaCompilerTestData : public ReflectionBase
+{
+    DAVA_VIRTUAL_REFLECTION(FormulaCompilerTestData);
+
+public:
+    int intVal = 42;
+    float flVal = 1.5f;
+    bool bVal = true;
+    Vector<int> array;
+
+    FormulaCompilerTestData()
+    {
+        array.push_back(10);
+        array.push_back(20);
+    }
+
+    int sum(const std::shared_ptr<FormulaContext>& context, int a, int b)
+    {
+        return a + b;
+    }
+};
+
+DAVA_VIRTUAL_REFLECTION_IMPL(FormulaCompilerTestData)
+{
+    ReflectionRegistrator<FormulaCompilerTestData>::Begin()
+    .Field("intVal", &FormulaCompilerTestData::intVal)
+    .Field("fl", &FormulaCompilerTestData::flVal)
+    .Field("b", &FormulaCompilerTestData::bVal)
+    .Field("array", &FormulaCompilerTestData::array)
+    .Method("sum", &FormulaCompilerTestData::sum)
+    .End();
+};
+
+DAVA_TESTCLASS (FormulaCompilerTest)
+{
+    // FormulaCompiler::Compile
+    DAVA_TEST (FoldConstants)
+    {
+        TEST_VERIFY(CompiledValue("5 + 5 * 2") == Any(15));
+        TEST_VERIFY(CompiledValue("--2") == Any(2));
+        TEST_VERIFY(CompiledValue("not (5 > 4)") == Any(false));
+        TEST_VERIFY(CompiledValue("\"a\" + \"b\"") == Any(String("ab")));
+        TEST_VERIFY(CompiledValue("when true -> 0, 1") == Any(0));
+        TEST_VERIFY(CompiledValue("when 5 == 2 -> 0, 1") == Any(1));
+        TEST_VERIFY(CompiledValue("when false -> 0, 2 > 1 -> 5, 1") == Any(5));
+
+        TEST_VERIFY(!Compile("intVal + 1")->IsValue());
+        TEST_VERIFY(!Compile("when b -> 0, 1")->IsValue());
+        TEST_VERIFY(!Compile("sum(1, 2)")->IsValue());
+    }
+
+    // FormulaCompiler::Compile
+    DAVA_TEST (CompiledResultsMatch)
+    {
+        const Vector<String> formulas = {
+            "intVal + 5 * 2",
+            "fl * (2.0 + 1.0)",
+            "when b -> intVal, 1 + 1",
+            "when false -> 0, intVal > 40 -> 1, 2",
+            "array[1] + array[0]",
+            "sum(intVal, 2 * 3)",
+            "-intVal",
+            "not b"
+        };
+
+        for (const String& formula : formulas)
+        {
+            TEST_VERIFY(Execute(formula, false) == Execute(formula, true));
+        }
+    }
+
+    // FormulaCompiler::Compile
+    DAVA_TEST (KeepErrors)
+    {
+        try
+        {
+            Execute("-true", true);
+            TEST_VERIFY(false);
+        }
+        catch (const FormulaException& error)
+        {
+            TEST_VERIFY(error.GetFormattedMessage() == "[1, 1] Invalid argument type 'bool' to unary '-' expression");
+        }
+
+        try
+        {
+            Execute("intVal + (5 + 5L)", true);
+            TEST_VERIFY(false);
+        }
+        catch (const FormulaException& error)
+        {
+            TEST_VERIFY(error.GetFormattedMessage() == "[1, 13] Operator '+' cannot be applied to 'int32', 'int64'");
+        }
+    }
+
+    // FormulaCompiler::Compile
+    DAVA_TEST (CachedFieldAccess)
+    {
+        FormulaCompilerTestData data;
+        std::shared_ptr<FormulaContext> parentContext = std::make_shared<FormulaReflectionContext>(Reflection::Create(&data), std::shared_ptr<FormulaContext>());
+        std::shared_ptr<FormulaContext> context = std::make_shared<FormulaFunctionContext>(parentContext);
+        std::shared_ptr<FormulaExpression> compiled = Compile("intVal + 1");
+
+        TEST_VERIFY(FormulaExecutor(context).Calculate(compiled.get()) == Any(43));
+
+        // cached field reads current value
+        data.intVal = 1;
+        TEST_VERIFY(FormulaExecutor(context).Calculate(compiled.get()) == Any(2));
+
+        // new context means new data
+        FormulaCompilerTestData otherData;
+        otherData.intVal = 7;
+        std::shared_ptr<FormulaContext> otherContext = std::make_shared<FormulaReflectionContext>(Reflection::Create(&otherData), std::shared_ptr<FormulaContext>());
+        TEST_VERIFY(FormulaExecutor(otherContext).Calculate(compiled.get()) == Any(8));
+        TEST_VERIFY(FormulaExecutor(context).Calculate(compiled.get()) == Any(2));
+
+        // context without field still reports error
+        std::shared_ptr<FormulaContext> emptyContext = std::make_shared<FormulaFunctionContext>(std::shared_ptr<FormulaContext>());
+        try
+        {
+            FormulaExecutor(emptyContext).Calculate(compiled.get());
+            TEST_VERIFY(false);
+        }
+        catch (const FormulaException& error)
+        {
+            TEST_VERIFY(error.GetFormattedMessage() == "[1, 1] Can't resolve symbol 'intVal'");
+        }
+    }
+
+    std::shared_ptr<FormulaExpression> Compile(const String& str)
+    {
+        FormulaParser parser(str);
+        return FormulaCompiler().Compile(parser.ParseExpression());
+    }
+
+    Any CompiledValue(const String& str)
+    {
+        std::shared_ptr<FormulaExpression> exp = Compile(str);
+        TEST_VERIFY(exp->IsValue());
+        return exp->IsValue() ? static_cast<FormulaValueExpression*>(exp.get())->GetValue() : Any();
+    }
+
+    Any Execute(const String& str, bool compile)
+    {
+        FormulaCompilerTestData data;
+        std::shared_ptr<FormulaContext> context = std::make_shared<FormulaReflectionContext>(Reflection::Create(&data), std::shared_ptr<FormulaContext>());
+        FormulaExecutor executor(context);
+        FormulaParser parser(str);
+        std::shared_ptr<FormulaExpression> exp = parser.ParseExpression();
+        if (compile)
+        {
+            exp = FormulaCompiler().Compile(exp);
+        }
+        return executor.Calculate(exp.get());
+    }
+};
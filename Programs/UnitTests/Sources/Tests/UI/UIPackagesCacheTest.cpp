@@ -0,0 +1,87 @@
+#include "DAVAEngine.h"
+
+#include "Job/JobManager.h"
+#include "UI/UIPackagesCache.h"
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (UIPackagesCacheTest)
+{
+    // UIPackagesCache::CreateControl
+    DAVA_TEST (CloneFromTemplate)
+    {
+        RefPtr<UIPackagesCache> cache = MakeRef<UIPackagesCache>();
+        const FilePath path("~res:/UI/Flow/View1.yaml");
+
+        RefPtr<UIControl> first = cache->CreateControl(path, "View1");
+        TEST_VERIFY(first.Valid());
+        TEST_VERIFY(cache->GetPackage(path.GetFrameworkPath()).Valid());
+
+        RefPtr<UIControl> second = cache->CreateControl(path, "View1");
+        TEST_VERIFY(second.Valid());
+        TEST_VERIFY(first != second);
+        TEST_VERIFY(second->GetName() == FastName("View1"));
+        TEST_VERIFY(second->GetSize() == first->GetSize());
+
+        RefPtr<UIControl> byDefault = cache->CreateControl(path, "");
+        TEST_VERIFY(byDefault.Valid() && byDefault->GetName() == FastName("View1"));
+
+        TEST_VERIFY(!cache->CreateControl(path, "Unknown").Valid());
+    }
+
+    // UIPackagesCache::CreateControl, UIPackagesCache::PutPackage
+    DAVA_TEST (CreateFromLoadingThread)
+    {
+        RefPtr<UIPackagesCache> cache = MakeRef<UIPackagesCache>();
+        const FilePath path("~res:/UI/Flow/View1.yaml");
+
+        // flow loading thread and main thread build the same package, first built one is kept
+        RefPtr<UIControl> fromThread;
+        RefPtr<Thread> thread(Thread::Create([&]() {
+            fromThread = cache->CreateControl(path, "View1");
+        }));
+        thread->Start();
+        RefPtr<UIControl> fromMain = cache->CreateControl(path, "View1");
+        thread->Join();
+
+        TEST_VERIFY(fromThread.Valid());
+        TEST_VERIFY(fromMain.Valid());
+        RefPtr<UIPackage> package = cache->GetPackage(path.GetFrameworkPath());
+        TEST_VERIFY(package.Valid());
+        TEST_VERIFY(cache->PutPackage(path.GetFrameworkPath(), MakeRef<UIPackage>()) == package);
+    }
+
+    // UIPackagesCache::RequestPackage
+    DAVA_TEST (RequestInBackground)
+    {
+        RefPtr<UIPackagesCache> cache = MakeRef<UIPackagesCache>();
+        const FilePath path("~res:/UI/UITextTest.yaml");
+
+        int32 callbacksCount = 0;
+        RefPtr<UIPackage> loadedPackage;
+        auto callback = [&](const RefPtr<UIPackage>& package) {
+            loadedPackage = package;
+            callbacksCount++;
+        };
+        cache->RequestPackage(path, callback);
+        cache->RequestPackage(path, callback);
+        TEST_VERIFY(cache->IsPackageRequested(path));
+
+        for (int32 i = 0; i < 500 && cache->IsPackageRequested(path); ++i)
+        {
+            GetEngineContext()->jobManager->Update();
+            Thread::Sleep(10);
+        }
+
+        TEST_VERIFY(!cache->IsPackageRequested(path));
+        TEST_VERIFY(callbacksCount == 2);
+        TEST_VERIFY(loadedPackage.Valid());
+        TEST_VERIFY(loadedPackage->GetControl("NewText") != nullptr);
+        TEST_VERIFY(cache->GetPackage(path.GetFrameworkPath()) == loadedPackage);
+
+        // cached package is returned immediately
+        cache->RequestPackage(path, callback);
+        TEST_VERIFY(callbacksCount == 3);
+    }
+};
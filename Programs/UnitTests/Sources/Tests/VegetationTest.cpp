@@ -0,0 +1,170 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Engine/Engine.h"
+#include "Render/Highlevel/Vegetation/VegetationGeometry.h"
+#include "Render/Highlevel/Vegetation/VegetationGeometryData.h"
+#include "Render/Highlevel/Vegetation/VegetationRenderData.h"
+#include "Render/Highlevel/Vegetation/VegetationRenderObject.h"
+#include "Utils/Random.h"
+
+using namespace DAVA;
+
+namespace VegetationTestDetails
+{
+const uint32 LAYER_COUNT = 2;
+const uint32 DENSITY_LEVELS = 16;
+const uint32 RANDOM_SEED = 42;
+
+const uint32 RESOLUTION_CELL_SQUARE[] = { 1, 4, 16 };
+const float32 RESOLUTION_SCALE[] = { 1.0f, 2.0f, 4.0f };
+const uint32 RESOLUTION_TILES_PER_ROW[] = { 4, 2, 1 };
+const uint32 RESOLUTION_CLUSTER_STRIDE[] = { 1, 2, 4 };
+const uint32 RESOLUTION_COUNT = 3;
+
+// One quad per lod, each resolution uses lod with the same index
+VegetationGeometryDataPtr CreateGeometryData()
+{
+    ScopedPtr<NMaterial> material(new NMaterial());
+
+    Vector<NMaterial*> materials;
+    Vector<Vector<Vector<Vector3>>> positions;
+    Vector<Vector<Vector<Vector2>>> texCoords;
+    Vector<Vector<Vector<Vector3>>> normals;
+    Vector<Vector<Vector<VegetationIndex>>> indices;
+    for (uint32 layerIndex = 0; layerIndex < LAYER_COUNT; ++layerIndex)
+    {
+        materials.push_back(material);
+        positions.emplace_back();
+        texCoords.emplace_back();
+        normals.emplace_back();
+        indices.emplace_back();
+        for (uint32 lodIndex = 0; lodIndex < RESOLUTION_COUNT; ++lodIndex)
+        {
+            float32 size = float32(lodIndex + 1);
+            positions.back().push_back({ Vector3(0.0f, 0.0f, 0.0f), Vector3(size, 0.0f, 0.0f), Vector3(size, 0.0f, size), Vector3(0.0f, 0.0f, size) });
+            texCoords.back().push_back({ Vector2(0.0f, 0.0f), Vector2(1.0f, 0.0f), Vector2(1.0f, 1.0f), Vector2(0.0f, 1.0f) });
+            normals.back().push_back(Vector<Vector3>(4, Vector3(0.0f, -1.0f, 0.0f)));
+            indices.back().push_back({ 0, 1, 2, 0, 2, 3 });
+        }
+    }
+
+    return VegetationGeometryDataPtr(new VegetationGeometryData(materials, positions, texCoords, normals, indices));
+}
+
+void BuildGeometry(const VegetationGeometryDataPtr& geometryData, bool parallel, VegetationRenderData& renderData)
+{
+    Vector<VegetationLayerParams> layerParams(LAYER_COUNT);
+    for (uint32 layerIndex = 0; layerIndex < LAYER_COUNT; ++layerIndex)
+    {
+        layerParams[layerIndex].maxClusterCount = layerIndex + 1;
+        layerParams[layerIndex].instanceRotationVariation = 30.0f;
+        layerParams[layerIndex].instanceScaleVariation = 0.5f;
+    }
+
+    VegetationGeometry geometry(layerParams, DENSITY_LEVELS, Vector2(2.0f, 2.0f), FilePath(),
+                                RESOLUTION_CELL_SQUARE, RESOLUTION_COUNT,
+                                RESOLUTION_SCALE, RESOLUTION_COUNT,
+                                RESOLUTION_TILES_PER_ROW, RESOLUTION_COUNT,
+                                RESOLUTION_CLUSTER_STRIDE, RESOLUTION_COUNT,
+                                Vector3(100.0f, 100.0f, 10.0f), geometryData);
+    geometry.SetParallelBuild(parallel);
+
+    // Cluster positions are random, both builds should start from the same seed
+    GetEngineContext()->random->Seed(RANDOM_SEED);
+    geometry.Build(&renderData);
+}
+
+AbstractQuadTreeNode<VegetationSpatialData>* CreateCell(Vector<std::unique_ptr<AbstractQuadTreeNode<VegetationSpatialData>>>& nodes, float32 cameraDistance)
+{
+    nodes.emplace_back(new AbstractQuadTreeNode<VegetationSpatialData>());
+    nodes.back()->data.cameraDistance = cameraDistance;
+    return nodes.back().get();
+}
+}
+
+DAVA_TESTCLASS (VegetationTest)
+{
+    // VegetationGeometry::SetParallelBuild
+    DAVA_TEST (ParallelBuild)
+    {
+        using namespace VegetationTestDetails;
+
+        VegetationGeometryDataPtr geometryData = CreateGeometryData();
+
+        VegetationRenderData serial;
+        BuildGeometry(geometryData, false, serial);
+
+        VegetationRenderData parallel;
+        BuildGeometry(geometryData, true, parallel);
+
+        const Vector<VegetationVertex>& serialVertices = serial.GetVertices();
+        const Vector<VegetationVertex>& parallelVertices = parallel.GetVertices();
+        TEST_VERIFY(!serialVertices.empty());
+        TEST_VERIFY(serialVertices.size() == parallelVertices.size());
+        if (serialVertices.size() == parallelVertices.size())
+        {
+            for (size_t i = 0; i < serialVertices.size(); ++i)
+            {
+                TEST_VERIFY(serialVertices[i].coord == parallelVertices[i].coord);
+                TEST_VERIFY(serialVertices[i].texCoord0 == parallelVertices[i].texCoord0);
+                TEST_VERIFY(serialVertices[i].texCoord1 == parallelVertices[i].texCoord1);
+                TEST_VERIFY(serialVertices[i].texCoord2 == parallelVertices[i].texCoord2);
+            }
+        }
+
+        TEST_VERIFY(!serial.GetIndices().empty());
+        TEST_VERIFY(serial.GetIndices() == parallel.GetIndices());
+
+        Vector<Vector<VegetationBufferItem>>& serialBuffers = serial.GetIndexBuffers();
+        Vector<Vector<VegetationBufferItem>>& parallelBuffers = parallel.GetIndexBuffers();
+        TEST_VERIFY(serialBuffers.size() == RESOLUTION_COUNT);
+        TEST_VERIFY(serialBuffers.size() == parallelBuffers.size());
+        if (serialBuffers.size() == parallelBuffers.size())
+        {
+            for (size_t resolutionIndex = 0; resolutionIndex < serialBuffers.size(); ++resolutionIndex)
+            {
+                const Vector<VegetationBufferItem>& serialCells = serialBuffers[resolutionIndex];
+                const Vector<VegetationBufferItem>& parallelCells = parallelBuffers[resolutionIndex];
+                TEST_VERIFY(serialCells.size() == parallelCells.size());
+                for (size_t cellIndex = 0; cellIndex < Min(serialCells.size(), parallelCells.size()); ++cellIndex)
+                {
+                    TEST_VERIFY(serialCells[cellIndex].startIndex == parallelCells[cellIndex].startIndex);
+                    TEST_VERIFY(serialCells[cellIndex].indexCount == parallelCells[cellIndex].indexCount);
+                }
+            }
+        }
+    }
+
+    // VegetationRenderObject::DropFarthestCells
+    DAVA_TEST (DropFarthestCells)
+    {
+        using namespace VegetationTestDetails;
+
+        Vector<std::unique_ptr<AbstractQuadTreeNode<VegetationSpatialData>>> nodes;
+        Vector<AbstractQuadTreeNode<VegetationSpatialData>*> cells;
+        const float32 distances[] = { 50.0f, 10.0f, 90.0f, 30.0f, 70.0f, 20.0f, 80.0f, 40.0f, 60.0f };
+        for (float32 distance : distances)
+        {
+            cells.push_back(CreateCell(nodes, distance));
+        }
+
+        // Nothing is dropped while limit is not exceeded
+        TEST_VERIFY(VegetationRenderObject::DropFarthestCells(cells, 9) == 0);
+        TEST_VERIFY(cells.size() == 9);
+
+        TEST_VERIFY(VegetationRenderObject::DropFarthestCells(cells, 4) == 5);
+        TEST_VERIFY(cells.size() == 4);
+
+        Vector<float32> keptDistances;
+        for (const AbstractQuadTreeNode<VegetationSpatialData>* cell : cells)
+        {
+            keptDistances.push_back(cell->data.cameraDistance);
+        }
+        std::sort(keptDistances.begin(), keptDistances.end());
+        TEST_VERIFY(keptDistances == Vector<float32>({ 10.0f, 20.0f, 30.0f, 40.0f }));
+
+        TEST_VERIFY(VegetationRenderObject::DropFarthestCells(cells, 0) == 4);
+        TEST_VERIFY(cells.empty());
+    }
+};
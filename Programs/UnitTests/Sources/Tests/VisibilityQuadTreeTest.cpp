@@ -0,0 +1,199 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Render/Highlevel/Camera.h"
+#include "Render/Highlevel/Frustum.h"
+#include "Render/Highlevel/RenderObject.h"
+#include "Render/Highlevel/VisibilityQuadTree.h"
+
+#include <random>
+
+using namespace DAVA;
+
+namespace VisibilityQuadTreeTestDetails
+{
+class BoxRenderObject : public RenderObject
+{
+public:
+    BoxRenderObject(const AABBox3& box)
+    {
+        SetBox(box);
+    }
+
+    void SetBox(const AABBox3& box)
+    {
+        bbox = box;
+        worldBBox = box;
+    }
+};
+
+const uint32 OBJECT_COUNT = 100000;
+const float32 WORLD_SIZE = 2000.0f;
+
+Vector<AABBox3> GenerateBoxes(uint32 count)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float32> position(-WORLD_SIZE * 0.5f, WORLD_SIZE * 0.5f);
+    std::uniform_real_distribution<float32> size(0.5f, 10.0f);
+
+    Vector<AABBox3> boxes;
+    boxes.reserve(count);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        Vector3 min(position(generator), position(generator), position(generator) * 0.05f);
+        boxes.emplace_back(min, min + Vector3(size(generator), size(generator), size(generator)));
+    }
+    return boxes;
+}
+
+void BuildFrustum(Frustum* frustum)
+{
+    Matrix4 view;
+    view.BuildLookAtMatrix(Vector3(0.0f, -500.0f, 100.0f), Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 0.0f, 1.0f));
+    Matrix4 projection;
+    projection.BuildPerspective(-1.0f, 1.0f, -0.75f, 0.75f, 1.0f, 1500.0f, false);
+    frustum->Build(view * projection, false);
+}
+}
+
+DAVA_TESTCLASS (VisibilityQuadTreeTest)
+{
+    DAVA_TEST (FrustumIsInside4Test)
+    {
+        using namespace VisibilityQuadTreeTestDetails;
+
+        ScopedPtr<Frustum> frustum(new Frustum());
+        BuildFrustum(frustum);
+
+        Vector<AABBox3> boxes = GenerateBoxes(OBJECT_COUNT);
+        Vector<float32> soaBoxes(OBJECT_COUNT / 4 * QuadTree::QuadTreeNode::OBJECT_BOX_GROUP_SIZE);
+        for (uint32 i = 0; i < OBJECT_COUNT; ++i)
+        {
+            float32* lane = soaBoxes.data() + (i / 4) * QuadTree::QuadTreeNode::OBJECT_BOX_GROUP_SIZE + (i % 4);
+            lane[0] = boxes[i].min.x;
+            lane[4] = boxes[i].min.y;
+            lane[8] = boxes[i].min.z;
+            lane[12] = boxes[i].max.x;
+            lane[16] = boxes[i].max.y;
+            lane[20] = boxes[i].max.z;
+        }
+
+        uint32 scalarVisible = 0;
+        for (uint32 i = 0; i < OBJECT_COUNT; ++i)
+        {
+            uint8 startClippingPlane = 0;
+            scalarVisible += frustum->IsInside(boxes[i], 0x3f, startClippingPlane) ? 1 : 0;
+        }
+
+        uint32 soaVisible = 0;
+        for (uint32 i = 0; i < OBJECT_COUNT; i += 4)
+        {
+            uint32 mask = frustum->IsInside4(soaBoxes.data() + (i / 4) * QuadTree::QuadTreeNode::OBJECT_BOX_GROUP_SIZE, 0x3f);
+            soaVisible += (mask & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1);
+        }
+
+        TEST_VERIFY(scalarVisible == soaVisible);
+        TEST_VERIFY(soaVisible > 0 && soaVisible < OBJECT_COUNT);
+
+        for (uint32 i = 0; i < OBJECT_COUNT; i += 4)
+        {
+            uint32 mask = frustum->IsInside4(soaBoxes.data() + (i / 4) * QuadTree::QuadTreeNode::OBJECT_BOX_GROUP_SIZE, 0x3f);
+            for (uint32 k = 0; k < 4; ++k)
+            {
+                uint8 startClippingPlane = 0;
+                TEST_VERIFY(((mask >> k) & 1) == (frustum->IsInside(boxes[i + k], 0x3f, startClippingPlane) ? 1u : 0u));
+            }
+        }
+    }
+
+    DAVA_TEST (QuadTreeClipTest)
+    {
+        using namespace VisibilityQuadTreeTestDetails;
+
+        Vector<AABBox3> boxes = GenerateBoxes(OBJECT_COUNT);
+        Vector<RenderObject*> objects;
+        objects.reserve(OBJECT_COUNT);
+
+        QuadTree quadTree(10);
+        LinearRenderHierarchy linearRenderHierarchy;
+        RenderHierarchy& linearHierarchy = linearRenderHierarchy;
+        for (const AABBox3& box : boxes)
+        {
+            RenderObject* object = new BoxRenderObject(box);
+            quadTree.AddRenderObject(object);
+            linearHierarchy.AddRenderObject(object);
+            objects.push_back(object);
+        }
+        quadTree.Initialize();
+
+        ScopedPtr<Camera> camera(new Camera());
+        BuildFrustum(camera->GetFrustum());
+
+        Vector<RenderObject*> linearVisible;
+        linearHierarchy.Clip(camera, linearVisible, RenderObject::VISIBLE);
+
+        Vector<RenderObject*> treeVisible;
+        quadTree.Clip(camera, treeVisible, RenderObject::VISIBLE);
+
+        std::sort(linearVisible.begin(), linearVisible.end());
+        std::sort(treeVisible.begin(), treeVisible.end());
+        TEST_VERIFY(linearVisible == treeVisible);
+
+        // Multi-view clip gives the same result as separate clips
+        Vector<RenderObject*> multiVisible[2];
+        ClipView views[2];
+        for (uint32 v = 0; v < 2; ++v)
+        {
+            views[v].camera = camera;
+            views[v].visibilityArray = &multiVisible[v];
+            views[v].visibilityCriteria = RenderObject::VISIBLE;
+        }
+        quadTree.Clip(views, 2);
+        for (Vector<RenderObject*>& visible : multiVisible)
+        {
+            std::sort(visible.begin(), visible.end());
+            TEST_VERIFY(visible == treeVisible);
+        }
+
+        // Move and remove objects, the last moved object becomes always visible after it was added
+        std::mt19937 generator(7);
+        std::uniform_int_distribution<uint32> objectIndex(0, OBJECT_COUNT - 1);
+        Vector<AABBox3> newBoxes = GenerateBoxes(1000);
+        for (const AABBox3& box : newBoxes)
+        {
+            BoxRenderObject* object = static_cast<BoxRenderObject*>(objects[objectIndex(generator)]);
+            object->SetBox(box);
+            quadTree.ObjectUpdated(object);
+        }
+        RenderObject* alwaysVisible = objects[objectIndex(generator)];
+        static_cast<BoxRenderObject*>(alwaysVisible)->SetBox(AABBox3(Vector3(0.0f, -900.0f, 0.0f), 1.0f));
+        alwaysVisible->AddFlag(RenderObject::ALWAYS_CLIPPING_VISIBLE);
+        quadTree.ObjectUpdated(alwaysVisible);
+        for (uint32 i = 0; i < 1000; ++i)
+        {
+            RenderObject*& object = objects[objectIndex(generator)];
+            if (object != nullptr && object != alwaysVisible)
+            {
+                quadTree.RemoveRenderObject(object);
+                linearHierarchy.RemoveRenderObject(object);
+                SafeRelease(object);
+            }
+        }
+        quadTree.Update();
+
+        linearVisible.clear();
+        linearHierarchy.Clip(camera, linearVisible, RenderObject::VISIBLE);
+        treeVisible.clear();
+        quadTree.Clip(camera, treeVisible, RenderObject::VISIBLE);
+        std::sort(linearVisible.begin(), linearVisible.end());
+        std::sort(treeVisible.begin(), treeVisible.end());
+        TEST_VERIFY(linearVisible == treeVisible);
+        TEST_VERIFY(std::find(treeVisible.begin(), treeVisible.end(), alwaysVisible) != treeVisible.end());
+
+        quadTree.PrepareForShutdown();
+        for (RenderObject* object : objects)
+        {
+            SafeRelease(object);
+        }
+    }
+};
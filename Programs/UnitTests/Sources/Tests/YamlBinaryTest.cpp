@@ -0,0 +1,118 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "FileSystem/DynamicMemoryFile.h"
+#include "FileSystem/YamlBinary.h"
+#include "Utils/CRC32.h"
+
+using namespace DAVA;
+
+namespace YamlBinaryTestDetails
+{
+void WriteText(const FilePath& path, const String& text)
+{
+    ScopedPtr<File> file(File::Create(path, File::CREATE | File::WRITE));
+    file->Write(text.data(), static_cast<uint32>(text.size()));
+}
+
+bool IsEqual(const YamlNode* l, const YamlNode* r)
+{
+    if (l->GetType() != r->GetType())
+        return false;
+
+    switch (l->GetType())
+    {
+    case YamlNode::TYPE_STRING:
+        return l->AsString() == r->AsString() && l->GetStringRepresentation() == r->GetStringRepresentation();
+    case YamlNode::TYPE_ARRAY:
+    case YamlNode::TYPE_MAP:
+        if (l->GetCount() != r->GetCount())
+            return false;
+        for (uint32 i = 0; i < l->GetCount(); ++i)
+        {
+            if (l->GetType() == YamlNode::TYPE_MAP && l->GetItemKeyName(i) != r->GetItemKeyName(i))
+                return false;
+            if (!IsEqual(l->Get(i), r->Get(i)))
+                return false;
+        }
+        return true;
+    }
+    return false;
+}
+}
+
+DAVA_TESTCLASS (YamlBinaryTest)
+{
+    DAVA_TEST (SaveLoadTest)
+    {
+        const String yaml =
+        "Header:\n"
+        "    version: \"18\"\n"
+        "Controls:\n"
+        "-   class: \"UIControl\"\n"
+        "    name: \"Root\"\n"
+        "    position: [10.0, 20.0]\n"
+        "    children:\n"
+        "    -   class: \"UIControl\"\n"
+        "        name: \"Child\"\n"
+        "        position: [10.0, 20.0]\n";
+
+        RefPtr<YamlParser> parser = YamlParser::CreateAndParseString(yaml);
+        TEST_VERIFY(parser.Valid() && parser->GetRootNode() != nullptr);
+
+        ScopedPtr<DynamicMemoryFile> file(DynamicMemoryFile::Create(File::CREATE | File::WRITE));
+        YamlBinary::SourceInfo sourceInfo;
+        sourceInfo.size = static_cast<uint32>(yaml.size());
+        sourceInfo.hash = CRC32::ForBuffer(yaml.data(), yaml.size());
+        TEST_VERIFY(YamlBinary::Save(file, parser->GetRootNode(), sourceInfo));
+
+        const Vector<uint8>& data = file->GetDataVector();
+        TEST_VERIFY(YamlBinary::IsBinaryYaml(data.data(), static_cast<uint32>(data.size())));
+        YamlBinary::SourceInfo storedInfo;
+        TEST_VERIFY(YamlBinary::ReadSourceInfo(data.data(), static_cast<uint32>(data.size()), storedInfo));
+        TEST_VERIFY(storedInfo.size == sourceInfo.size && storedInfo.hash == sourceInfo.hash);
+
+        RefPtr<YamlNode> loaded = YamlBinary::Load(data.data(), static_cast<uint32>(data.size()));
+        TEST_VERIFY(loaded.Valid());
+        TEST_VERIFY(YamlBinaryTestDetails::IsEqual(parser->GetRootNode(), loaded.Get()));
+        TEST_VERIFY(loaded->Get("Controls")->Get(0)->Get("children")->Get(0)->Get("name")->AsString() == "Child");
+
+        // Truncated data should be rejected
+        for (uint32 size : { 4u, 20u, static_cast<uint32>(data.size() - 1) })
+        {
+            TEST_VERIFY(!YamlBinary::Load(data.data(), size).Valid());
+        }
+    }
+
+    DAVA_TEST (OutdatedTest)
+    {
+        const FilePath yamlPath("~doc:/YamlBinaryTest.yaml");
+        const FilePath binaryPath = YamlBinary::GetBinaryPath(yamlPath);
+        FileSystem* fileSystem = FileSystem::Instance();
+
+        const String yaml = "name: \"Root\"\n";
+        YamlBinaryTestDetails::WriteText(yamlPath, yaml);
+        {
+            RefPtr<YamlParser> parser(YamlParser::Create(yamlPath));
+            TEST_VERIFY(parser.Valid());
+            YamlBinary::SourceInfo sourceInfo;
+            TEST_VERIFY(YamlBinary::GetSourceInfo(yamlPath, sourceInfo));
+            TEST_VERIFY(sourceInfo.size == yaml.size() && sourceInfo.hash == CRC32::ForFile(yamlPath));
+            TEST_VERIFY(YamlBinary::SaveToFile(binaryPath, parser->GetRootNode(), sourceInfo));
+        }
+
+        RefPtr<YamlNode> loaded = YamlBinary::LoadFromFile(binaryPath, yamlPath);
+        TEST_VERIFY(loaded.Valid() && loaded->Get("name")->AsString() == "Root");
+
+        // Source changed after binary yaml was compiled
+        const String changedYaml = "name: \"Changed\"\n";
+        YamlBinaryTestDetails::WriteText(yamlPath, changedYaml);
+        TEST_VERIFY(!YamlBinary::LoadFromFile(binaryPath, yamlPath).Valid());
+
+        // Binary yaml is used as is when there is no source
+        fileSystem->DeleteFile(yamlPath);
+        TEST_VERIFY(YamlBinary::LoadFromFile(binaryPath, yamlPath).Valid());
+
+        fileSystem->DeleteFile(binaryPath);
+    }
+};
@@ -4,6 +4,10 @@
 
 namespace DAVA
 {
+class File;
+class StreamCompressor;
+class StreamDecompressor;
+
 class Compressor
 {
 public:
@@ -17,9 +21,35 @@ public:
 
     virtual ~Compressor();
 
-    virtual bool Compress(const Vector<uint8>& in, Vector<uint8>& out) const = 0;
+    // compress `inSize` bytes from `in`, `out` is resized to compressed size
+    virtual bool Compress(const uint8* in, size_t inSize, Vector<uint8>& out) const = 0;
+    // decompress into caller owned memory, `outSize` is capacity of `out` on input and decompressed size on output
+    virtual bool Decompress(const uint8* in, size_t inSize, uint8* out, size_t& outSize) const = 0;
+
+    // Create compressor which writes compressed data to `output` chunk by chunk
+    virtual std::unique_ptr<StreamCompressor> CreateStreamCompressor(File* output) const = 0;
+    // Create decompressor which reads compressed data from `input` chunk by chunk
+    virtual std::unique_ptr<StreamDecompressor> CreateStreamDecompressor(File* input) const = 0;
+
+    bool Compress(const Vector<uint8>& in, Vector<uint8>& out) const;
     // you should resize output to correct size before call this method
-    virtual bool Decompress(const Vector<uint8>& in, Vector<uint8>& out) const = 0;
+    bool Decompress(const Vector<uint8>& in, Vector<uint8>& out) const;
 };
 
+inline bool Compressor::Compress(const Vector<uint8>& in, Vector<uint8>& out) const
+{
+    return Compress(in.data(), in.size(), out);
+}
+
+inline bool Compressor::Decompress(const Vector<uint8>& in, Vector<uint8>& out) const
+{
+    size_t outSize = out.size();
+    if (!Decompress(in.data(), in.size(), out.data(), outSize))
+    {
+        return false;
+    }
+    out.resize(outSize);
+    return true;
+}
+
 } // end namespace DAVA
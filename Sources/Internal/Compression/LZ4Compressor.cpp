@@ -1,5 +1,10 @@
 #include "Compression/LZ4Compressor.h"
+#include "Compression/StreamCompressor.h"
+#include "Base/RefPtr.h"
+#include "Concurrency/Mutex.h"
+#include "FileSystem/File.h"
 #include "Logger/Logger.h"
+#include "Utils/CRC32.h"
 
 #include <lz4/lz4.h>
 #include <lz4/lz4hc.h>
@@ -7,63 +12,837 @@
 namespace DAVA
 {
 Compressor::~Compressor() = default; // only one virtual table(fix warning)
+StreamCompressor::~StreamCompressor() = default;
+StreamDecompressor::~StreamDecompressor() = default;
 
-bool LZ4Compressor::Compress(const Vector<uint8>& in, Vector<uint8>& out) const
+namespace LZ4CompressorDetails
 {
-    if (in.size() > LZ4_MAX_INPUT_SIZE)
+const uint32 HISTORY_SIZE = 64 * 1024;
+
+// LZ4 frame format, see lz4_Frame_format.md from LZ4 distribution
+const uint32 FRAME_MAGIC = 0x184D2204;
+const uint8 FRAME_VERSION = 0x40;
+const uint8 FLAG_BLOCK_INDEPENDENCE = 0x20;
+const uint8 FLAG_BLOCK_CHECKSUM = 0x10;
+const uint8 FLAG_CONTENT_SIZE = 0x08;
+const uint8 FLAG_CONTENT_CHECKSUM = 0x04;
+const uint8 FLAG_DICTIONARY_ID = 0x01;
+const uint32 BLOCK_UNCOMPRESSED = 0x80000000;
+const uint32 FRAME_BLOCK_SIZE = 64 * 1024;
+const uint8 FRAME_BLOCK_SIZE_ID = 4; // 64 Kb
+
+// xxHash32, used for frame header and content checksums
+class XXH32
+{
+public:
+    explicit XXH32(uint32 seed = 0)
+    {
+        v[0] = seed + PRIME1 + PRIME2;
+        v[1] = seed + PRIME2;
+        v[2] = seed;
+        v[3] = seed - PRIME1;
+    }
+
+    static uint32 ForBuffer(const uint8* data, size_t size)
+    {
+        XXH32 hash;
+        hash.Update(data, size);
+        return hash.Digest();
+    }
+
+    void Update(const uint8* data, size_t size)
+    {
+        totalSize += size;
+        if (bufferSize + size < 16)
+        {
+            std::memcpy(buffer + bufferSize, data, size);
+            bufferSize += static_cast<uint32>(size);
+            return;
+        }
+
+        if (bufferSize > 0)
+        {
+            const uint32 fill = 16 - bufferSize;
+            std::memcpy(buffer + bufferSize, data, fill);
+            Stripe(buffer);
+            data += fill;
+            size -= fill;
+            bufferSize = 0;
+        }
+
+        for (; size >= 16; size -= 16, data += 16)
+        {
+            Stripe(data);
+        }
+
+        std::memcpy(buffer, data, size);
+        bufferSize = static_cast<uint32>(size);
+    }
+
+    uint32 Digest() const
+    {
+        uint32 h = (totalSize >= 16) ? Rotl(v[0], 1) + Rotl(v[1], 7) + Rotl(v[2], 12) + Rotl(v[3], 18) : v[2] + PRIME5;
+        h += static_cast<uint32>(totalSize);
+
+        const uint8* p = buffer;
+        const uint8* end = buffer + bufferSize;
+        for (; p + 4 <= end; p += 4)
+        {
+            h = Rotl(h + Load32(p) * PRIME3, 17) * PRIME4;
+        }
+        for (; p < end; ++p)
+        {
+            h = Rotl(h + *p * PRIME5, 11) * PRIME1;
+        }
+
+        h ^= h >> 15;
+        h *= PRIME2;
+        h ^= h >> 13;
+        h *= PRIME3;
+        h ^= h >> 16;
+        return h;
+    }
+
+private:
+    static const uint32 PRIME1 = 2654435761U;
+    static const uint32 PRIME2 = 2246822519U;
+    static const uint32 PRIME3 = 3266489917U;
+    static const uint32 PRIME4 = 668265263U;
+    static const uint32 PRIME5 = 374761393U;
+
+    static uint32 Rotl(uint32 x, uint32 r)
+    {
+        return (x << r) | (x >> (32 - r));
+    }
+
+    static uint32 Load32(const uint8* p)
+    {
+        return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32>(p[3]) << 24);
+    }
+
+    void Stripe(const uint8* p)
+    {
+        for (uint32 i = 0; i < 4; ++i)
+        {
+            v[i] = Rotl(v[i] + Load32(p + i * 4) * PRIME2, 13) * PRIME1;
+        }
+    }
+
+    uint32 v[4];
+    uint8 buffer[16];
+    uint32 bufferSize = 0;
+    uint64 totalSize = 0;
+};
+
+void Store32(uint8* p, uint32 value)
+{
+    p[0] = static_cast<uint8>(value);
+    p[1] = static_cast<uint8>(value >> 8);
+    p[2] = static_cast<uint8>(value >> 16);
+    p[3] = static_cast<uint8>(value >> 24);
+}
+
+uint32 Load32(const uint8* p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32>(p[3]) << 24);
+}
+
+/**
+    Compresses independent blocks, with dictionary placed as history right before each block.
+    State of compressor after dictionary is kept and copied for every block, so dictionary is compressed only
+    once while window stays at the same address.
+*/
+class BlockEncoder
+{
+public:
+    BlockEncoder(const LZ4Dictionary* dictionary_, bool highCompression_)
+        : dictionary(dictionary_)
+        , highCompression(highCompression_)
+    {
+    }
+
+    // Returns compressed size or 0 if block doesn't fit into `outCapacity`
+    int32 Compress(const uint8* in, int32 inSize, uint8* out, int32 outCapacity)
+    {
+        const char* src = reinterpret_cast<const char*>(in);
+        char* dst = reinterpret_cast<char*>(out);
+        if (dictionary == nullptr || dictionary->GetContent().empty())
+        {
+            return highCompression ? LZ4_compressHC_limitedOutput(src, dst, inSize, outCapacity) : LZ4_compress_limitedOutput(src, dst, inSize, outCapacity);
+        }
+
+        const Vector<uint8>& dict = dictionary->GetContent();
+        const int32 dictSize = static_cast<int32>(dict.size());
+        if (window.size() < dict.size() + inSize)
+        {
+            window.resize(dict.size() + inSize);
+            std::memcpy(window.data(), dict.data(), dict.size());
+            dictState.clear(); // depends on window address
+        }
+        std::memcpy(window.data() + dictSize, in, inSize);
+
+        char* windowStart = reinterpret_cast<char*>(window.data());
+        if (dictState.empty())
+        {
+            // Output of dictionary compression is not used, only history it leaves in state
+            Vector<char> dictOutput(LZ4_compressBound(dictSize));
+            if (highCompression)
+            {
+                dictState.resize((LZ4_sizeofStreamStateHC() + sizeof(uint64) - 1) / sizeof(uint64));
+                LZ4_resetStreamStateHC(dictState.data(), windowStart);
+                LZ4_compressHC_continue(dictState.data(), windowStart, dictOutput.data(), dictSize);
+            }
+            else
+            {
+                dictState.resize((LZ4_sizeofStreamState() + sizeof(uint64) - 1) / sizeof(uint64));
+                LZ4_resetStreamState(dictState.data(), windowStart);
+                LZ4_compress_continue(dictState.data(), windowStart, dictOutput.data(), dictSize);
+            }
+        }
+
+        state = dictState;
+        if (highCompression)
+        {
+            return LZ4_compressHC_limitedOutput_continue(state.data(), windowStart + dictSize, dst, inSize, outCapacity);
+        }
+        return LZ4_compress_limitedOutput_continue(state.data(), windowStart + dictSize, dst, inSize, outCapacity);
+    }
+
+private:
+    const LZ4Dictionary* dictionary = nullptr;
+    bool highCompression = false;
+    Vector<uint8> window;
+    Vector<uint64> dictState;
+    Vector<uint64> state;
+};
+
+/**
+    Decompresses blocks which can refer to 64 Kb of history: dictionary or previous blocks.
+*/
+class BlockDecoder
+{
+public:
+    BlockDecoder(const LZ4Dictionary* dictionary, uint32 maxBlockSize)
+        : window(HISTORY_SIZE + maxBlockSize)
+    {
+        if (dictionary != nullptr)
+        {
+            const Vector<uint8>& dict = dictionary->GetContent();
+            std::memcpy(window.data() + HISTORY_SIZE - dict.size(), dict.data(), dict.size());
+            hasHistory = !dict.empty();
+        }
+    }
+
+    // Grow block capacity, history is kept
+    void Reserve(uint32 maxBlockSize)
+    {
+        if (window.size() < HISTORY_SIZE + maxBlockSize)
+        {
+            window.resize(HISTORY_SIZE + maxBlockSize);
+        }
+    }
+
+    // Decompressed data is placed at GetBlock(), returns decompressed size or -1 on error
+    int32 Decompress(const uint8* in, int32 inSize)
+    {
+        return Decompress(in, inSize, static_cast<int32>(window.size() - HISTORY_SIZE));
+    }
+
+    // Same as above, but block can't be bigger than `capacity`
+    int32 Decompress(const uint8* in, int32 inSize, int32 capacity)
+    {
+        DVASSERT(capacity <= static_cast<int32>(window.size() - HISTORY_SIZE));
+        const char* src = reinterpret_cast<const char*>(in);
+        char* dst = reinterpret_cast<char*>(GetBlock());
+        return hasHistory ? LZ4_decompress_safe_withPrefix64k(src, dst, inSize, capacity) : LZ4_decompress_safe(src, dst, inSize, capacity);
+    }
+
+    uint8* GetBlock()
+    {
+        return window.data() + HISTORY_SIZE;
+    }
+
+    // Make last 64 Kb of decompressed data history for next block
+    void KeepHistory(uint32 blockSize)
+    {
+        std::memmove(window.data(), window.data() + blockSize, HISTORY_SIZE);
+        hasHistory = true;
+    }
+
+private:
+    Vector<uint8> window;
+    bool hasHistory = false;
+};
+
+class FrameCompressor final : public StreamCompressor
+{
+public:
+    FrameCompressor(File* output_, std::shared_ptr<const LZ4Dictionary> dictionary_, bool highCompression)
+        : output(output_)
+        , dictionary(dictionary_)
+        , encoder(dictionary.get(), highCompression)
+    {
+        input.reserve(FRAME_BLOCK_SIZE);
+        compressed.resize(FRAME_BLOCK_SIZE);
+    }
+
+    ~FrameCompressor() override
+    {
+        DVASSERT(finished, "LZ4 frame is not finished");
+    }
+
+    bool Write(const uint8* data, size_t size) override
+    {
+        DVASSERT(!finished);
+        if (!WriteHeader())
+        {
+            return false;
+        }
+
+        contentHash.Update(data, size);
+        while (size > 0)
+        {
+            const size_t chunk = std::min(size, FRAME_BLOCK_SIZE - input.size());
+            input.insert(input.end(), data, data + chunk);
+            data += chunk;
+            size -= chunk;
+
+            if (input.size() == FRAME_BLOCK_SIZE && !WriteBlock())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Finish() override
+    {
+        DVASSERT(!finished);
+        finished = true;
+        if (!WriteHeader() || (!input.empty() && !WriteBlock()))
+        {
+            return false;
+        }
+
+        uint8 end[8];
+        Store32(end, 0);
+        Store32(end + 4, contentHash.Digest());
+        return WriteBytes(end, sizeof(end));
+    }
+
+private:
+    bool WriteBytes(const void* data, uint32 size)
+    {
+        if (output->Write(data, size) != size)
+        {
+            Logger::Error("LZ4 frame: can't write to %s", output->GetFilename().GetStringValue().c_str());
+            return false;
+        }
+        return true;
+    }
+
+    bool WriteHeader()
+    {
+        if (headerWritten)
+        {
+            return true;
+        }
+        headerWritten = true;
+
+        uint8 header[11];
+        uint32 size = 0;
+        Store32(header, FRAME_MAGIC);
+        header[4] = FRAME_VERSION | FLAG_BLOCK_INDEPENDENCE | FLAG_CONTENT_CHECKSUM;
+        header[5] = FRAME_BLOCK_SIZE_ID << 4;
+        size = 6;
+        if (dictionary)
+        {
+            header[4] |= FLAG_DICTIONARY_ID;
+            Store32(header + size, dictionary->GetId());
+            size += 4;
+        }
+        header[size] = static_cast<uint8>(XXH32::ForBuffer(header + 4, size - 4) >> 8);
+        return WriteBytes(header, size + 1);
+    }
+
+    bool WriteBlock()
+    {
+        const int32 inputSize = static_cast<int32>(input.size());
+        // Blocks which don't get smaller are stored as is
+        const int32 compressedSize = encoder.Compress(input.data(), inputSize, compressed.data(), inputSize - 1);
+
+        uint8 blockHeader[4];
+        bool result = false;
+        if (compressedSize > 0)
+        {
+            Store32(blockHeader, static_cast<uint32>(compressedSize));
+            result = WriteBytes(blockHeader, 4) && WriteBytes(compressed.data(), compressedSize);
+        }
+        else
+        {
+            Store32(blockHeader, static_cast<uint32>(inputSize) | BLOCK_UNCOMPRESSED);
+            result = WriteBytes(blockHeader, 4) && WriteBytes(input.data(), inputSize);
+        }
+        input.clear();
+        return result;
+    }
+
+    RefPtr<File> output;
+    std::shared_ptr<const LZ4Dictionary> dictionary;
+    BlockEncoder encoder;
+    XXH32 contentHash;
+    Vector<uint8> input;
+    Vector<uint8> compressed;
+    bool headerWritten = false;
+    bool finished = false;
+};
+
+class FrameDecompressor final : public StreamDecompressor
+{
+public:
+    FrameDecompressor(File* input_, std::shared_ptr<const LZ4Dictionary> dictionary_)
+        : input(input_)
+        , dictionary(dictionary_)
+    {
+    }
+
+    size_t Read(uint8* data, size_t size) override
+    {
+        size_t read = 0;
+        while (read < size && !eof && !failed)
+        {
+            if (blockOffset == blockSize && !ReadBlock())
+            {
+                break;
+            }
+
+            const size_t chunk = std::min(size - read, static_cast<size_t>(blockSize - blockOffset));
+            std::memcpy(data + read, decoder->GetBlock() + blockOffset, chunk);
+            blockOffset += static_cast<uint32>(chunk);
+            read += chunk;
+        }
+        return read;
+    }
+
+    bool IsEof() const override
+    {
+        return eof;
+    }
+
+    bool IsFailed() const override
+    {
+        return failed;
+    }
+
+private:
+    bool Fail(const char* reason)
+    {
+        Logger::Error("LZ4 frame: %s in %s", reason, input->GetFilename().GetStringValue().c_str());
+        failed = true;
+        return false;
+    }
+
+    bool ReadBytes(void* data, uint32 size)
+    {
+        return input->Read(data, size) == size || Fail("unexpected end of file");
+    }
+
+    bool ReadHeader()
+    {
+        uint8 header[19];
+        if (!ReadBytes(header, 7))
+        {
+            return false;
+        }
+        if (Load32(header) != FRAME_MAGIC)
+        {
+            return Fail("wrong magic");
+        }
+
+        flags = header[4];
+        if ((flags & 0xC0) != FRAME_VERSION)
+        {
+            return Fail("unsupported version");
+        }
+
+        const uint32 blockSizeId = (header[5] >> 4) & 0x7;
+        if (blockSizeId < 4)
+        {
+            return Fail("wrong block size");
+        }
+        const uint32 maxBlockSize = 1 << (2 * blockSizeId + 8);
+
+        // Header has 2 bytes of flags, optional content size and dictionary id, and checksum
+        const uint32 headerSize = 2 + ((flags & FLAG_CONTENT_SIZE) ? 8 : 0) + ((flags & FLAG_DICTIONARY_ID) ? 4 : 0) + 1;
+        if (!ReadBytes(header + 7, headerSize - 3))
+        {
+            return false;
+        }
+        if (header[4 + headerSize - 1] != static_cast<uint8>(XXH32::ForBuffer(header + 4, headerSize - 1) >> 8))
+        {
+            return Fail("wrong header checksum");
+        }
+
+        if (flags & FLAG_DICTIONARY_ID)
+        {
+            const uint32 dictionaryId = Load32(header + 4 + headerSize - 5);
+            if (!dictionary || dictionary->GetId() != dictionaryId)
+            {
+                return Fail("dictionary is missing or doesn't match");
+            }
+        }
+
+        decoder.reset(new BlockDecoder(dictionary.get(), maxBlockSize));
+        compressed.resize(maxBlockSize);
+        return true;
+    }
+
+    bool ReadBlock()
+    {
+        if (!decoder && !ReadHeader())
+        {
+            return false;
+        }
+
+        if ((flags & FLAG_BLOCK_INDEPENDENCE) == 0 && blockSize > 0)
+        {
+            decoder->KeepHistory(blockSize);
+        }
+        blockOffset = 0;
+        blockSize = 0;
+
+        uint8 blockHeader[4];
+        if (!ReadBytes(blockHeader, 4))
+        {
+            return false;
+        }
+
+        const uint32 header = Load32(blockHeader);
+        if (header == 0)
+        {
+            eof = true;
+            if (flags & FLAG_CONTENT_CHECKSUM)
+            {
+                uint8 checksum[4];
+                if (ReadBytes(checksum, 4) && Load32(checksum) != contentHash.Digest())
+                {
+                    return Fail("wrong content checksum");
+                }
+            }
+            return false;
+        }
+
+        const uint32 dataSize = header & ~BLOCK_UNCOMPRESSED;
+        if (dataSize > compressed.size())
+        {
+            return Fail("block is too big");
+        }
+        if (!ReadBytes(compressed.data(), dataSize))
+        {
+            return false;
+        }
+        if (flags & FLAG_BLOCK_CHECKSUM)
+        {
+            uint8 checksum[4];
+            if (!ReadBytes(checksum, 4))
+            {
+                return false;
+            }
+            if (Load32(checksum) != XXH32::ForBuffer(compressed.data(), dataSize))
+            {
+                return Fail("wrong block checksum");
+            }
+        }
+
+        if (header & BLOCK_UNCOMPRESSED)
+        {
+            std::memcpy(decoder->GetBlock(), compressed.data(), dataSize);
+            blockSize = dataSize;
+        }
+        else
+        {
+            const int32 result = decoder->Decompress(compressed.data(), static_cast<int32>(dataSize));
+            if (result < 0)
+            {
+                return Fail("corrupted block");
+            }
+            blockSize = static_cast<uint32>(result);
+        }
+
+        contentHash.Update(decoder->GetBlock(), blockSize);
+        return true;
+    }
+
+    RefPtr<File> input;
+    std::shared_ptr<const LZ4Dictionary> dictionary;
+    std::unique_ptr<BlockDecoder> decoder;
+    XXH32 contentHash;
+    Vector<uint8> compressed;
+    uint32 blockSize = 0;
+    uint32 blockOffset = 0;
+    uint8 flags = 0;
+    bool eof = false;
+    bool failed = false;
+};
+
+bool CompressBlock(const LZ4Dictionary* dictionary, bool highCompression, const uint8* in, size_t inSize, Vector<uint8>& out)
+{
+    if (inSize > LZ4_MAX_INPUT_SIZE)
     {
         Logger::Error("LZ4 compress failed too big input buffer");
         return false;
     }
-    uint32 maxSize = static_cast<uint32>(LZ4_compressBound(static_cast<uint32>(in.size())));
+    uint32 maxSize = static_cast<uint32>(LZ4_compressBound(static_cast<uint32>(inSize)));
     if (out.size() < maxSize)
     {
         out.resize(maxSize);
     }
-    int32 compressedSize = LZ4_compress(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data()), static_cast<uint32>(in.size()));
+    BlockEncoder encoder(dictionary, highCompression);
+    int32 compressedSize = encoder.Compress(in, static_cast<int32>(inSize), out.data(), static_cast<int32>(maxSize));
     if (compressedSize == 0)
     {
+        Logger::Error("LZ4 compress failed");
         return false;
     }
     out.resize(static_cast<uint32>(compressedSize));
     return true;
 }
+}
 
-bool LZ4Compressor::Decompress(const Vector<uint8>& in, Vector<uint8>& out) const
+LZ4Dictionary::LZ4Dictionary(Vector<uint8> content_)
+    : content(std::move(content_))
 {
-    int32 decompressResult = LZ4_decompress_fast(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data()), static_cast<uint32>(out.size()));
-    if (decompressResult < 0)
+    DVASSERT(content.size() <= MAX_SIZE);
+    id = CRC32::ForBuffer(content);
+}
+
+const Vector<uint8>& LZ4Dictionary::GetContent() const
+{
+    return content;
+}
+
+uint32 LZ4Dictionary::GetId() const
+{
+    return id;
+}
+
+std::shared_ptr<LZ4Dictionary> LZ4Dictionary::Train(const Vector<Vector<uint8>>& samples, uint32 maxSize)
+{
+    // Simplified "cover" algorithm: samples are split into epochs, from every epoch the segment which
+    // covers most 8-byte sequences common for several samples is taken. Taken sequences are not counted again.
+    const size_t kmerSize = 8;
+    const size_t segmentSize = 64;
+    maxSize = std::min(maxSize, MAX_SIZE);
+
+    Vector<uint8> all;
+    Vector<bool> validKmer;
+    UnorderedMap<uint64, uint32> frequency;
+    for (const Vector<uint8>& sample : samples)
     {
-        Logger::Error("LZ4 decompress failed");
-        return false;
+        UnorderedSet<uint64> sampleKmers;
+        for (size_t i = 0; i < sample.size(); ++i)
+        {
+            const bool valid = (i + kmerSize <= sample.size());
+            validKmer.push_back(valid);
+            if (valid)
+            {
+                uint64 kmer;
+                std::memcpy(&kmer, sample.data() + i, kmerSize);
+                if (sampleKmers.insert(kmer).second)
+                {
+                    ++frequency[kmer];
+                }
+            }
+        }
+        all.insert(all.end(), sample.begin(), sample.end());
     }
-    return true;
+
+    auto kmerScore = [&](size_t pos) -> uint32 {
+        if (!validKmer[pos])
+        {
+            return 0;
+        }
+        uint64 kmer;
+        std::memcpy(&kmer, all.data() + pos, kmerSize);
+        auto found = frequency.find(kmer);
+        // sequences from one sample only don't help other files
+        return (found != frequency.end() && found->second > 1) ? found->second : 0;
+    };
+
+    Vector<std::pair<uint64, size_t>> segments; // score, position
+    const size_t segmentCount = maxSize / segmentSize;
+    if (all.size() >= segmentSize && segmentCount > 0)
+    {
+        const size_t epochSize = std::max(all.size() / segmentCount, segmentSize);
+        for (size_t epoch = 0; epoch + segmentSize <= all.size() && segments.size() < segmentCount; epoch += epochSize)
+        {
+            const size_t epochEnd = std::min(epoch + epochSize, all.size());
+            if (epochEnd - epoch < segmentSize)
+            {
+                break;
+            }
+
+            // Sliding window sum of scores of sequences starting in segment
+            Vector<uint32> scores(epochEnd - epoch);
+            for (size_t i = epoch; i < epochEnd; ++i)
+            {
+                scores[i - epoch] = kmerScore(i);
+            }
+
+            const size_t windowKmers = segmentSize - kmerSize + 1;
+            uint64 score = 0;
+            for (size_t i = 0; i < windowKmers; ++i)
+            {
+                score += scores[i];
+            }
+            uint64 bestScore = score;
+            size_t bestStart = 0;
+            for (size_t start = 1; start + segmentSize <= scores.size(); ++start)
+            {
+                score += scores[start + windowKmers - 1];
+                score -= scores[start - 1];
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    bestStart = start;
+                }
+            }
+
+            if (bestScore == 0)
+            {
+                continue;
+            }
+
+            const size_t position = epoch + bestStart;
+            for (size_t i = position; i < position + windowKmers; ++i)
+            {
+                if (validKmer[i])
+                {
+                    uint64 kmer;
+                    std::memcpy(&kmer, all.data() + i, kmerSize);
+                    frequency[kmer] = 0;
+                }
+            }
+            segments.emplace_back(bestScore, position);
+        }
+    }
+
+    // Most useful segments go last, closer to compressed data
+    std::stable_sort(segments.begin(), segments.end(), [](const std::pair<uint64, size_t>& l, const std::pair<uint64, size_t>& r) {
+        return l.first < r.first;
+    });
+
+    Vector<uint8> content;
+    content.reserve(segments.size() * segmentSize);
+    for (const std::pair<uint64, size_t>& segment : segments)
+    {
+        content.insert(content.end(), all.begin() + segment.second, all.begin() + segment.second + segmentSize);
+    }
+    return std::make_shared<LZ4Dictionary>(std::move(content));
 }
 
-bool LZ4HCCompressor::Compress(const Vector<uint8>& in, Vector<uint8>& out) const
+struct LZ4Compressor::DictionaryDecoder
 {
-    if (in.size() > LZ4_MAX_INPUT_SIZE)
+    Mutex mutex;
+    std::unique_ptr<LZ4CompressorDetails::BlockDecoder> decoder;
+};
+
+LZ4Compressor::LZ4Compressor(std::shared_ptr<const LZ4Dictionary> dictionary_)
+    : dictionary(dictionary_)
+{
+    if (dictionary && !dictionary->GetContent().empty())
     {
-        Logger::Error("LZ4 compress failed too big input buffer");
-        return false;
+        dictionaryDecoder = std::make_shared<DictionaryDecoder>();
     }
-    if (in.empty())
+}
+
+bool LZ4Compressor::Compress(const uint8* in, size_t inSize, Vector<uint8>& out) const
+{
+    return LZ4CompressorDetails::CompressBlock(dictionary.get(), false, in, inSize, out);
+}
+
+bool LZ4Compressor::Decompress(const uint8* in, size_t inSize, uint8* out, size_t& outSize) const
+{
+    using namespace LZ4CompressorDetails;
+
+    int32 decompressResult = -1;
+    if (inSize <= LZ4_MAX_INPUT_SIZE && outSize <= LZ4_MAX_INPUT_SIZE)
     {
-        Logger::Error("LZ4 can't compress empty buffer");
-        return false;
+        if (dictionaryDecoder)
+        {
+            // Dictionary should be right before output, so decompress to window and copy.
+            // Window is allocated and filled with dictionary once, concurrent calls use temporary one.
+            std::unique_ptr<BlockDecoder> temporaryDecoder;
+            BlockDecoder* decoder = nullptr;
+            const bool locked = dictionaryDecoder->mutex.TryLock();
+            if (locked)
+            {
+                if (!dictionaryDecoder->decoder)
+                {
+                    dictionaryDecoder->decoder.reset(new BlockDecoder(dictionary.get(), static_cast<uint32>(outSize)));
+                }
+                decoder = dictionaryDecoder->decoder.get();
+                decoder->Reserve(static_cast<uint32>(outSize));
+            }
+            else
+            {
+                temporaryDecoder.reset(new BlockDecoder(dictionary.get(), static_cast<uint32>(outSize)));
+                decoder = temporaryDecoder.get();
+            }
+
+            decompressResult = decoder->Decompress(in, static_cast<int32>(inSize), static_cast<int32>(outSize));
+            if (decompressResult > 0)
+            {
+                std::memcpy(out, decoder->GetBlock(), decompressResult);
+            }
+            if (locked)
+            {
+                dictionaryDecoder->mutex.Unlock();
+            }
+        }
+        else
+        {
+            decompressResult = LZ4_decompress_safe(reinterpret_cast<const char*>(in), reinterpret_cast<char*>(out), static_cast<int32>(inSize), static_cast<int32>(outSize));
+        }
     }
-    uint32 maxSize = static_cast<uint32>(LZ4_compressBound(static_cast<uint32>(in.size())));
-    if (out.size() < maxSize)
+
+    if (decompressResult < 0)
     {
-        out.resize(maxSize);
+        Logger::Error("LZ4 decompress failed");
+        return false;
     }
-    int32 compressedSize = LZ4_compressHC(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data()), static_cast<uint32>(in.size()));
-    if (compressedSize == 0)
+    outSize = static_cast<size_t>(decompressResult);
+    return true;
+}
+
+std::unique_ptr<StreamCompressor> LZ4Compressor::CreateStreamCompressor(File* output) const
+{
+    return std::unique_ptr<StreamCompressor>(new LZ4CompressorDetails::FrameCompressor(output, dictionary, false));
+}
+
+std::unique_ptr<StreamDecompressor> LZ4Compressor::CreateStreamDecompressor(File* input) const
+{
+    return std::unique_ptr<StreamDecompressor>(new LZ4CompressorDetails::FrameDecompressor(input, dictionary));
+}
+
+LZ4HCCompressor::LZ4HCCompressor(std::shared_ptr<const LZ4Dictionary> dictionary)
+    : LZ4Compressor(dictionary)
+{
+}
+
+bool LZ4HCCompressor::Compress(const uint8* in, size_t inSize, Vector<uint8>& out) const
+{
+    if (inSize == 0)
     {
+        Logger::Error("LZ4 can't compress empty buffer");
         return false;
     }
-    out.resize(static_cast<uint32>(compressedSize));
-    return true;
+    return LZ4CompressorDetails::CompressBlock(dictionary.get(), true, in, inSize, out);
+}
+
+std::unique_ptr<StreamCompressor> LZ4HCCompressor::CreateStreamCompressor(File* output) const
+{
+    return std::unique_ptr<StreamCompressor>(new LZ4CompressorDetails::FrameCompressor(output, dictionary, true));
 }
 
 } // end namespace DAVA
@@ -4,18 +4,66 @@
 
 namespace DAVA
 {
+/**
+    Dictionary of byte sequences common for many small files. LZ4 compressors use it as history preceding every
+    compressed block, so matches can refer to dictionary. Data compressed with dictionary can be decompressed
+    only with the same dictionary.
+*/
+class LZ4Dictionary final
+{
+public:
+    // LZ4 can refer only to last 64 Kb of history
+    static const uint32 MAX_SIZE = 64 * 1024;
+
+    explicit LZ4Dictionary(Vector<uint8> content);
+
+    // Build dictionary from most frequent segments of sample files
+    static std::shared_ptr<LZ4Dictionary> Train(const Vector<Vector<uint8>>& samples, uint32 maxSize = MAX_SIZE);
+
+    const Vector<uint8>& GetContent() const;
+    // Identifier of dictionary content, written to LZ4 frame header
+    uint32 GetId() const;
+
+private:
+    Vector<uint8> content;
+    uint32 id = 0;
+};
+
 class LZ4Compressor : public Compressor
 {
 public:
-    bool Compress(const Vector<uint8>& in, Vector<uint8>& out) const override;
-    // you should resize output to correct size before call this method
-    bool Decompress(const Vector<uint8>& in, Vector<uint8>& out) const override;
+    LZ4Compressor() = default;
+    explicit LZ4Compressor(std::shared_ptr<const LZ4Dictionary> dictionary);
+
+    using Compressor::Compress;
+    using Compressor::Decompress;
+
+    bool Compress(const uint8* in, size_t inSize, Vector<uint8>& out) const override;
+    bool Decompress(const uint8* in, size_t inSize, uint8* out, size_t& outSize) const override;
+
+    std::unique_ptr<StreamCompressor> CreateStreamCompressor(File* output) const override;
+    std::unique_ptr<StreamDecompressor> CreateStreamDecompressor(File* input) const override;
+
+protected:
+    std::shared_ptr<const LZ4Dictionary> dictionary;
+
+private:
+    // Window with dictionary in front of decompressed block, reused by `Decompress` calls
+    struct DictionaryDecoder;
+    std::shared_ptr<DictionaryDecoder> dictionaryDecoder;
 };
 
 class LZ4HCCompressor final : public LZ4Compressor
 {
 public:
-    bool Compress(const Vector<uint8>& in, Vector<uint8>& out) const override;
+    LZ4HCCompressor() = default;
+    explicit LZ4HCCompressor(std::shared_ptr<const LZ4Dictionary> dictionary);
+
+    using LZ4Compressor::Compress;
+
+    bool Compress(const uint8* in, size_t inSize, Vector<uint8>& out) const override;
+
+    std::unique_ptr<StreamCompressor> CreateStreamCompressor(File* output) const override;
 };
 
 } // end namespace DAVA
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+namespace DAVA
+{
+/**
+    Compresses data chunk by chunk and writes it to file, created by Compressor::CreateStreamCompressor.
+    LZ4 compressors write LZ4 frame format, zip compressor writes zlib stream (RFC1950 wrapped deflate).
+*/
+class StreamCompressor
+{
+public:
+    virtual ~StreamCompressor();
+
+    // Compress next chunk of data, compressed blocks are written to file as soon as they are ready
+    virtual bool Write(const uint8* data, size_t size) = 0;
+    // Write rest of data and end of stream, no writes are allowed after
+    virtual bool Finish() = 0;
+};
+
+/**
+    Reads compressed data from file chunk by chunk and decompresses it, created by Compressor::CreateStreamDecompressor.
+*/
+class StreamDecompressor
+{
+public:
+    virtual ~StreamDecompressor();
+
+    // Decompress up to `size` bytes into `data`, returns number of decompressed bytes,
+    // which is less than `size` only at end of stream or on error
+    virtual size_t Read(uint8* data, size_t size) = 0;
+    // Whether end of stream was reached
+    virtual bool IsEof() const = 0;
+    // Whether stream is corrupted or can't be read
+    virtual bool IsFailed() const = 0;
+};
+
+} // end namespace DAVA
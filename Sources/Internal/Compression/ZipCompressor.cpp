@@ -1,4 +1,5 @@
 #include "Compression/ZipCompressor.h"
+#include "Compression/StreamCompressor.h"
 #include "FileSystem/File.h"
 #include "Logger/Logger.h"
 #include "Base/Exception.h"
@@ -39,15 +40,178 @@
 
 namespace DAVA
 {
-bool ZipCompressor::Compress(const Vector<uint8>& in, Vector<uint8>& out) const
+namespace ZipCompressorDetails
 {
-    uLong destMaxLength = compressBound(static_cast<uint32>(in.size()));
+const uint32 STREAM_BUFFER_SIZE = 64 * 1024;
+
+class DeflateStreamCompressor final : public StreamCompressor
+{
+public:
+    explicit DeflateStreamCompressor(File* output_)
+        : output(output_)
+        , buffer(STREAM_BUFFER_SIZE)
+    {
+        Memset(&stream, 0, sizeof(stream));
+        initialized = (mz_deflateInit(&stream, MZ_DEFAULT_COMPRESSION) == MZ_OK);
+    }
+
+    ~DeflateStreamCompressor() override
+    {
+        DVASSERT(finished, "deflate stream is not finished");
+        if (initialized)
+        {
+            mz_deflateEnd(&stream);
+        }
+    }
+
+    bool Write(const uint8* data, size_t size) override
+    {
+        DVASSERT(!finished);
+        // miniz takes 32-bit sizes
+        while (size > 0)
+        {
+            const uint32 chunk = static_cast<uint32>(std::min<size_t>(size, std::numeric_limits<uint32>::max()));
+            if (!Deflate(data, chunk, MZ_NO_FLUSH))
+            {
+                return false;
+            }
+            data += chunk;
+            size -= chunk;
+        }
+        return true;
+    }
+
+    bool Finish() override
+    {
+        DVASSERT(!finished);
+        finished = true;
+        return Deflate(nullptr, 0, MZ_FINISH);
+    }
+
+private:
+    bool Deflate(const uint8* data, uint32 size, int32 flush)
+    {
+        if (!initialized)
+        {
+            Logger::Error("can't init rfc1951 stream");
+            return false;
+        }
+
+        stream.next_in = data;
+        stream.avail_in = size;
+        while (true)
+        {
+            stream.next_out = buffer.data();
+            stream.avail_out = static_cast<uint32>(buffer.size());
+            const int32 result = mz_deflate(&stream, flush);
+            if (result != MZ_OK && result != MZ_STREAM_END && result != MZ_BUF_ERROR)
+            {
+                Logger::Error("can't compress rfc1951 stream");
+                return false;
+            }
+
+            const uint32 produced = static_cast<uint32>(buffer.size()) - stream.avail_out;
+            if (output->Write(buffer.data(), produced) != produced)
+            {
+                Logger::Error("can't write rfc1951 stream to %s", output->GetFilename().GetStringValue().c_str());
+                return false;
+            }
+
+            const bool done = (flush == MZ_FINISH) ? (result == MZ_STREAM_END) : (stream.avail_in == 0 && stream.avail_out != 0);
+            if (done)
+            {
+                return true;
+            }
+        }
+    }
+
+    RefPtr<File> output;
+    mz_stream stream;
+    Vector<uint8> buffer;
+    bool initialized = false;
+    bool finished = false;
+};
+
+class InflateStreamDecompressor final : public StreamDecompressor
+{
+public:
+    explicit InflateStreamDecompressor(File* input_)
+        : input(input_)
+        , buffer(STREAM_BUFFER_SIZE)
+    {
+        Memset(&stream, 0, sizeof(stream));
+        failed = (mz_inflateInit(&stream) != MZ_OK);
+    }
+
+    ~InflateStreamDecompressor() override
+    {
+        mz_inflateEnd(&stream);
+    }
+
+    size_t Read(uint8* data, size_t size) override
+    {
+        size_t read = 0;
+        while (read < size && !eof && !failed)
+        {
+            if (stream.avail_in == 0)
+            {
+                stream.next_in = buffer.data();
+                stream.avail_in = input->Read(buffer.data(), static_cast<uint32>(buffer.size()));
+            }
+
+            // decompress directly to caller memory
+            const uint32 capacity = static_cast<uint32>(std::min<size_t>(size - read, std::numeric_limits<uint32>::max()));
+            stream.next_out = data + read;
+            stream.avail_out = capacity;
+            const int32 result = mz_inflate(&stream, MZ_NO_FLUSH);
+            read += capacity - stream.avail_out;
+
+            if (result == MZ_STREAM_END)
+            {
+                eof = true;
+            }
+            else if (result != MZ_OK && !(result == MZ_BUF_ERROR && stream.avail_in == 0 && !input->IsEof()))
+            {
+                Logger::Error("can't uncompress rfc1951 stream from %s", input->GetFilename().GetStringValue().c_str());
+                failed = true;
+            }
+        }
+        return read;
+    }
+
+    bool IsEof() const override
+    {
+        return eof;
+    }
+
+    bool IsFailed() const override
+    {
+        return failed;
+    }
+
+private:
+    RefPtr<File> input;
+    mz_stream stream;
+    Vector<uint8> buffer;
+    bool eof = false;
+    bool failed = false;
+};
+}
+
+bool ZipCompressor::Compress(const uint8* in, size_t inSize, Vector<uint8>& out) const
+{
+    if (inSize > std::numeric_limits<uint32>::max())
+    {
+        Logger::Error("too big input buffer for compress rfc1951");
+        return false;
+    }
+    uLong destMaxLength = compressBound(static_cast<uLong>(inSize));
     if (out.size() < destMaxLength)
     {
         out.resize(destMaxLength);
     }
     uLong resultLength = destMaxLength;
-    int32 result = compress(out.data(), &resultLength, in.data(), static_cast<uLong>(in.size()));
+    int32 result = compress(out.data(), &resultLength, in, static_cast<uLong>(inSize));
     if (result != Z_OK)
     {
         Logger::Error("can't compress rfc1951 buffer");
@@ -57,24 +221,34 @@ bool ZipCompressor::Compress(const Vector<uint8>& in, Vector<uint8>& out) const
     return true;
 }
 
-bool ZipCompressor::Decompress(const Vector<uint8>& in, Vector<uint8>& out) const
+bool ZipCompressor::Decompress(const uint8* in, size_t inSize, uint8* out, size_t& outSize) const
 {
-    if (in.size() > static_cast<uint32>(std::numeric_limits<uLong>::max()))
+    if (inSize > std::numeric_limits<uint32>::max() || outSize > std::numeric_limits<uint32>::max())
     {
         Logger::Error("too big input buffer for uncompress rfc1951");
         return false;
     }
-    uLong uncompressedSize = static_cast<uLong>(out.size());
-    int32 decompressResult = uncompress(out.data(), &uncompressedSize, in.data(), static_cast<uLong>(in.size()));
+    uLong uncompressedSize = static_cast<uLong>(outSize);
+    int32 decompressResult = uncompress(out, &uncompressedSize, in, static_cast<uLong>(inSize));
     if (decompressResult != Z_OK)
     {
         Logger::Error("can't uncompress rfc1951 buffer");
         return false;
     }
-    out.resize(uncompressedSize);
+    outSize = static_cast<size_t>(uncompressedSize);
     return true;
 }
 
+std::unique_ptr<StreamCompressor> ZipCompressor::CreateStreamCompressor(File* output) const
+{
+    return std::unique_ptr<StreamCompressor>(new ZipCompressorDetails::DeflateStreamCompressor(output));
+}
+
+std::unique_ptr<StreamDecompressor> ZipCompressor::CreateStreamDecompressor(File* input) const
+{
+    return std::unique_ptr<StreamDecompressor>(new ZipCompressorDetails::InflateStreamDecompressor(input));
+}
+
 class ZipPrivateData
 {
 public:
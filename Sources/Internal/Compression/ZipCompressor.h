@@ -14,9 +14,15 @@ class File;
 class ZipCompressor : public Compressor
 {
 public:
-    bool Compress(const Vector<uint8>& in, Vector<uint8>& out) const override;
-    // you should resize output to correct size before call this method
-    bool Decompress(const Vector<uint8>& in, Vector<uint8>& out) const override;
+    using Compressor::Compress;
+    using Compressor::Decompress;
+
+    bool Compress(const uint8* in, size_t inSize, Vector<uint8>& out) const override;
+    bool Decompress(const uint8* in, size_t inSize, uint8* out, size_t& outSize) const override;
+
+    // streams are in zlib format, the same as produced by `Compress`
+    std::unique_ptr<StreamCompressor> CreateStreamCompressor(File* output) const override;
+    std::unique_ptr<StreamDecompressor> CreateStreamDecompressor(File* input) const override;
 };
 
 class ZipFile final
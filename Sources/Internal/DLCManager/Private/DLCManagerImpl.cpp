@@ -313,6 +313,8 @@ void DLCManagerImpl::ClearResouces()
     {
         scanState = ScanState::Wait;
     }
+    ++scanGeneration;
+    indexedFilesReady = false;
 
     for (auto request : requests)
     {
@@ -520,6 +522,7 @@ void DLCManagerImpl::Initialize(const FilePath& dirToDownloadPacks_,
         localCacheMeta = dirToDownloadPacks_ + "local_copy_server_meta.meta";
         localCacheFileTable = dirToDownloadPacks_ + "local_copy_server_file_table.block";
         localCacheFooter = dirToDownloadPacks_ + "local_copy_server_footer.footer";
+        localScanIndex = dirToDownloadPacks_ + "local_copy_scan_index.index";
         urlToSuperPack = urlToServerSuperpack_;
         hints = hints_;
 
@@ -731,8 +734,13 @@ PackRequest* DLCManagerImpl::AddDelayedRequest(const String& requestedPackName)
         }
     }
 
-    delayedRequests.push_back(new PackRequest(*this, requestedPackName));
-    return delayedRequests.back();
+    PackRequest* request = new PackRequest(*this, requestedPackName);
+    if (indexedFilesReady && metaRemote->HasPack(requestedPackName) && IsAllPackFilesReady(requestedPackName))
+    {
+        request->SetDownloaded();
+    }
+    delayedRequests.push_back(request);
+    return request;
 }
 
 void DLCManagerImpl::RemoveDownloadedFileIndexes(Vector<uint32>& packIndexes) const
@@ -1520,11 +1528,22 @@ bool DLCManagerImpl::IsPackDownloaded(const String& packName) const
 
     if (!IsInitialized())
     {
+        // files verified during previous scans are known before scan is finished
+        if (indexedFilesReady && metaRemote->HasPack(packName) && IsAllPackFilesReady(packName))
+        {
+            return true;
+        }
+
         DVASSERT(false && "Initialization not finished. Files are scanning now.");
         log << "Initialization not finished. Files is scanning now." << std::endl;
         return false;
     }
 
+    return IsAllPackFilesReady(packName);
+}
+
+bool DLCManagerImpl::IsAllPackFilesReady(const String& packName) const
+{
     // check every file in requested pack and all it's dependencies
     const uint32 packIndex = metaRemote->GetPackIndex(packName);
     const Vector<uint32>& deps = metaRemote->GetDependencies(packIndex);
@@ -2125,7 +2144,8 @@ void DLCManagerImpl::StartScanDownloadedFiles()
         if (ScanState::Wait == scanState)
         {
             scanState = ScanState::Starting;
-            scanThread = Thread::Create(MakeFunction(this, &DLCManagerImpl::ThreadScanFunc));
+            const uint32 generation = scanGeneration;
+            scanThread = Thread::Create([this, generation]() { ThreadScanFunc(generation); });
             String name = String("DLC(") + std::to_string(instanceIndex) + ")::ThreadScan";
             scanThread->SetName(name);
             scanThread->Start();
@@ -2133,93 +2153,56 @@ void DLCManagerImpl::StartScanDownloadedFiles()
     }
 }
 
-void DLCManagerImpl::RecursiveScan(const FilePath& baseDir, const FilePath& dir, Vector<LocalFileInfo>& files)
+Vector<uint32> DLCManagerImpl::MatchLocalFilesWithMeta(Vector<LocalFileInfo>& files)
 {
-    ScopedPtr<FileList> fl(new FileList(dir, false));
+    const PackFormat::PackFile& pack = GetPack();
+    FileSystem* fs = GetEngineContext()->fileSystem;
 
-    for (uint32 index = 0; index < fl->GetCount(); ++index)
-    {
-        const FilePath& path = fl->GetPathname(index);
-        if (fl->IsNavigationDirectory(index))
-        {
-            continue;
-        }
-        if (fl->IsDirectory(index))
-        {
-            RecursiveScan(baseDir, path, files);
-        }
-        else
+    Vector<uint32> readyFileIndexes;
+    String relativeNameWithoutDvpl;
+
+    auto removeIt = remove_if(begin(files), end(files), [&](const LocalFileInfo& info) {
+        relativeNameWithoutDvpl = info.relativeName.substr(0, info.relativeName.size() - 5);
+        const auto it = mapFileData.find(relativeNameWithoutDvpl);
+        if (it != end(mapFileData) && it->second != nullptr)
         {
-            if (path.GetExtension() == extDvpl)
+            const PackFormat::FileTableEntry* entry = it->second;
+            if (entry->compressedCrc32 == info.crc32Hash &&
+                entry->compressedSize == info.compressedSize &&
+                entry->compressedSize + sizeof(PackFormat::LitePack::Footer) == info.sizeOnDevice)
             {
-                String fileName = path.GetAbsolutePathname();
-
-                FILE* f = FileAPI::OpenFile(fileName, "rb");
-                if (f == nullptr)
-                {
-                    Logger::Info("can't open file %s during scan", fileName.c_str());
-                    continue;
-                }
-
-                bool needDeleteIncompleteFile = false;
-                int32 footerSize = sizeof(PackFormat::LitePack::Footer);
-                if (0 == fseek(f, -footerSize, SEEK_END))
-                {
-                    PackFormat::LitePack::Footer footer;
-                    if (footerSize == fread(&footer, 1, footerSize, f))
-                    {
-                        LocalFileInfo info;
-                        info.sizeOnDevice = FileAPI::GetFileSize(fileName);
-                        info.relativeName = path.GetRelativePathname(baseDir);
-                        info.compressedSize = footer.sizeCompressed;
-                        info.crc32Hash = footer.crc32Compressed;
-                        files.push_back(info);
-                    }
-                    else
-                    {
-                        needDeleteIncompleteFile = true;
-                        Logger::Info("can't read footer in file: %s", fileName.c_str());
-                    }
-                }
-                else
-                {
-                    needDeleteIncompleteFile = true;
-                    Logger::Info("can't seek to dvpl footer in file: %s", fileName.c_str());
-                }
-                FileAPI::Close(f);
-                if (needDeleteIncompleteFile)
-                {
-                    if (0 != FileAPI::RemoveFile(fileName))
-                    {
-                        Logger::Error("can't delete incomplete file: %s", fileName.c_str());
-                    }
-                }
+                readyFileIndexes.push_back(static_cast<uint32>(std::distance(&pack.filesTable.data.files[0], entry)));
+            }
+            else
+            {
+                // need to continue downloading file
+                // leave it as is
             }
+            return false;
         }
-    }
-}
 
-void DLCManagerImpl::ScanFiles(const FilePath& dir, Vector<LocalFileInfo>& files)
-{
-    if (FileSystem::Instance()->IsDirectory(dir))
-    {
-        files.clear();
-        files.reserve(hints.maxFilesToDownload);
-        RecursiveScan(dir, dir, files);
-    }
+        // no such file on server, delete it
+        fs->DeleteFile(dirToDownloadedPacks + info.relativeName);
+        return true;
+    });
+    files.erase(removeIt, end(files));
+
+    return readyFileIndexes;
 }
 
-void DLCManagerImpl::ThreadScanFunc()
+void DLCManagerImpl::ThreadScanFunc(uint32 generation)
 {
     Thread* thisThread = Thread::Current();
     // scan files in download dir
     const int64 startTime = SystemTimer::GetMs();
 
-    ScanFiles(dirToDownloadedPacks, localFiles);
+    // footers of files changed since last scan are read by workers while we wait for meta
+    LocalFileScanner scanner(dirToDownloadedPacks, localScanIndex);
+    scanner.Start(hints.maxFilesToDownload);
 
-    const int64 finishScan = SystemTimer::GetMs() - startTime;
+    Vector<LocalFileInfo> indexedFiles = scanner.GetIndexedFiles();
 
-    Logger::Info("finish scan files for: %fsec total files: %ld", finishScan / 1000.f, localFiles.size());
+    Logger::Info("start scan files for: %fsec files from index: %ld", (SystemTimer::GetMs() - startTime) / 1000.f, indexedFiles.size());
 
     if (thisThread->IsCancelling())
     {
@@ -2244,51 +2227,72 @@ void DLCManagerImpl::ThreadScanFunc()
     Vector<ResourceArchive::FileInfo> filesInfo;
     PackArchive::FillFilesInfo(pack, uncompressedFileNames, mapFileData, filesInfo);
 
-    String relativeNameWithoutDvpl;
+    // files verified during previous scans are ready right now
+    Vector<uint32> readyFileIndexes = MatchLocalFilesWithMeta(indexedFiles);
+    DAVA::RunOnMainThreadAsync([this, generation, readyFileIndexes]()
+                               {
+                                   OnLocalFilesScanned(generation, readyFileIndexes, false);
+                               });
+
+    Vector<LocalFileInfo> readFiles = scanner.Finish();
+
+    const int64 finishScan = SystemTimer::GetMs() - startTime;
+
+    Logger::Info("finish scan files for: %fsec total files: %ld", finishScan / 1000.f, indexedFiles.size() + readFiles.size());
 
     if (thisThread->IsCancelling())
     {
         return;
     }
 
-    FileSystem* fs = GetEngineContext()->fileSystem;
+    readyFileIndexes = MatchLocalFilesWithMeta(readFiles);
 
-    for (const LocalFileInfo& info : localFiles)
-    {
-        relativeNameWithoutDvpl = info.relativeName.substr(0, info.relativeName.size() - 5);
-        const PackFormat::FileTableEntry* entry = mapFileData[relativeNameWithoutDvpl];
-        if (entry != nullptr)
-        {
-            if (entry->compressedCrc32 == info.crc32Hash &&
-                entry->compressedSize == info.compressedSize &&
-                entry->compressedSize + sizeof(PackFormat::LitePack::Footer) == info.sizeOnDevice)
-            {
-                size_t fileIndex = std::distance(&pack.filesTable.data.files[0], entry);
-                SetFileIsReady(fileIndex, info.compressedSize);
-            }
-            else
-            {
-                // need to continue downloading file
-                // leave it as is
-            }
-        }
-        else
-        {
-            // no such file on server, delete it
-            fs->DeleteFile(dirToDownloadedPacks + info.relativeName);
-        }
-    }
+    indexedFiles.insert(end(indexedFiles), begin(readFiles), end(readFiles));
+    scanner.SaveIndex(indexedFiles);
 
     if (thisThread->IsCancelling())
     {
         return;
     }
 
-    DAVA::RunOnMainThreadAsync([this]()
+    DAVA::RunOnMainThreadAsync([this, generation, readyFileIndexes]()
                                {
                                    // finish thread
-                                   scanState = ScanState::Done;
+                                   OnLocalFilesScanned(generation, readyFileIndexes, true);
                                });
 }
 
+void DLCManagerImpl::OnLocalFilesScanned(uint32 generation, const Vector<uint32>& readyFileIndexes, bool scanFinished)
+{
+    DVASSERT(Thread::IsMainThread());
+
+    if (generation != scanGeneration)
+    {
+        return; // Deinitialize called during scan
+    }
+
+    const auto& allFiles = GetPack().filesTable.data.files;
+    for (uint32 fileIndex : readyFileIndexes)
+    {
+        SetFileIsReady(fileIndex, allFiles[fileIndex].compressedSize);
+    }
+
+    if (scanFinished)
+    {
+        scanState = ScanState::Done;
+        return;
+    }
+
+    // requests for packs with all files already verified don't wait for scan to finish
+    indexedFilesReady = true;
+    for (PackRequest* request : delayedRequests)
+    {
+        if (!request->IsDownloaded() && IsAllPackFilesReady(request->GetRequestedPackName()))
+        {
+            request->SetDownloaded();
+            requestUpdated.Emit(*request);
+        }
+    }
+}
+
 } // end namespace DAVA
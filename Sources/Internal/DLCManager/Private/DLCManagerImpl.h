@@ -7,6 +7,7 @@
 #include "DLCManager/Private/RequestManager.h"
 #include "DLCManager/Private/PackRequest.h"
 #include "DLCManager/Private/DebugGestureListener.h"
+#include "DLCManager/Private/LocalFileScanner.h"
 #include "FileSystem/FilePath.h"
 #include "FileSystem/Private/PackFormatSpec.h"
 #include "FileSystem/Private/PackMetaData.h"
@@ -253,26 +254,22 @@ private:
         Done
     };
 
-    // info to scan local pack files
-    struct LocalFileInfo
-    {
-        String relativeName;
-        uint64 sizeOnDevice = std::numeric_limits<uint64>::max();
-        uint32 compressedSize = std::numeric_limits<uint32>::max(); // file size can be 0 so use max value default
-        uint32 crc32Hash = std::numeric_limits<uint32>::max();
-    };
-    // fill during scan local pack files, empty after finish scan
-    Vector<LocalFileInfo> localFiles;
+    using LocalFileInfo = LocalFileScanner::FileInfo;
     // every bit mean file exist and size match with meta
     Vector<bool> scanFileReady;
     Thread* scanThread = nullptr;
     ScanState scanState{ ScanState::Wait };
+    // incremented on ClearResouces, results of previous scan thread are ignored
+    uint32 scanGeneration = 0;
+    // files from scan index are marked ready, requests for them can be served before scan finished
+    bool indexedFilesReady = false;
     Semaphore metaRemoteDataLoadedSem;
 
     void StartScanDownloadedFiles();
-    void ThreadScanFunc();
-    void ScanFiles(const FilePath& dir, Vector<LocalFileInfo>& files);
-    void RecursiveScan(const FilePath& baseDir, const FilePath& dir, Vector<LocalFileInfo>& files);
+    void ThreadScanFunc(uint32 generation);
+    Vector<uint32> MatchLocalFilesWithMeta(Vector<LocalFileInfo>& files);
+    void OnLocalFilesScanned(uint32 generation, const Vector<uint32>& readyFileIndexes, bool scanFinished);
+    bool IsAllPackFilesReady(const String& packName) const;
 
     mutable std::ofstream log;
 
@@ -280,6 +277,7 @@ private:
     FilePath localCacheMeta;
     FilePath localCacheFileTable;
     FilePath localCacheFooter;
+    FilePath localScanIndex;
     FilePath dirToDownloadedPacks;
     String urlToSuperPack;
     bool isProcessingEnabled = false;
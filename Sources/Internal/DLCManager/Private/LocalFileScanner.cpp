@@ -0,0 +1,259 @@
+#include "DLCManager/Private/LocalFileScanner.h"
+#include "Engine/Engine.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileAPIHelper.h"
+#include "FileSystem/FileList.h"
+#include "FileSystem/FileSystem.h"
+#include "FileSystem/Private/PackFormatSpec.h"
+#include "Logger/Logger.h"
+
+namespace DAVA
+{
+namespace LocalFileScannerDetails
+{
+const String extDvpl(".dvpl");
+const Array<char8, 4> INDEX_MARKER{ { 'D', 'V', 'S', 'I' } };
+const uint32 INDEX_VERSION = 1;
+}
+
+LocalFileScanner::LocalFileScanner(const FilePath& dir_, const FilePath& indexPath_)
+    : dir(dir_)
+    , indexPath(indexPath_)
+{
+}
+
+LocalFileScanner::~LocalFileScanner()
+{
+    // footer jobs reference scanner data, so they must be done before it is destroyed
+    if (isScanning)
+    {
+        footerJobs.Finish();
+    }
+}
+
+void LocalFileScanner::Start(size_t maxFilesHint)
+{
+    DVASSERT(!isScanning);
+
+    Vector<FileInfo> files;
+    if (GetEngineContext()->fileSystem->IsDirectory(dir))
+    {
+        files.reserve(maxFilesHint);
+        RecursiveScan(dir, files);
+    }
+
+    UnorderedMap<String, FileInfo> index;
+    LoadIndex(index);
+
+    baseDir = dir.GetAbsolutePathname();
+    unreadFiles.clear();
+
+    indexedFiles.clear();
+    for (const FileInfo& info : files)
+    {
+        auto it = index.find(info.relativeName);
+        if (it != index.end() && it->second.sizeOnDevice == info.sizeOnDevice && it->second.modificationTime == info.modificationTime)
+        {
+            indexedFiles.push_back(it->second);
+        }
+        else
+        {
+            unreadFiles.push_back(info);
+        }
+    }
+    isRead.assign(unreadFiles.size(), 0);
+
+    isScanning = true;
+    footerJobs.Start(static_cast<uint32>(unreadFiles.size()), [this](uint32 i) {
+        isRead[i] = ReadFooter(baseDir + unreadFiles[i].relativeName, unreadFiles[i]);
+    });
+}
+
+const Vector<LocalFileScanner::FileInfo>& LocalFileScanner::GetIndexedFiles() const
+{
+    return indexedFiles;
+}
+
+const Vector<LocalFileScanner::FileInfo>& LocalFileScanner::Finish()
+{
+    DVASSERT(isScanning);
+
+    footerJobs.Finish();
+    isScanning = false;
+
+    readFiles.clear();
+    for (size_t i = 0; i < unreadFiles.size(); ++i)
+    {
+        const FileInfo& info = unreadFiles[i];
+        if (isRead[i])
+        {
+            readFiles.push_back(info);
+        }
+        else if (info.sizeOnDevice < sizeof(PackFormat::LitePack::Footer))
+        {
+            const String fileName = baseDir + info.relativeName;
+            if (0 != FileAPI::RemoveFile(fileName))
+            {
+                Logger::Error("can't delete incomplete file: %s", fileName.c_str());
+            }
+        }
+    }
+    unreadFiles.clear();
+    isRead.clear();
+
+    return readFiles;
+}
+
+bool LocalFileScanner::SaveIndex(const Vector<FileInfo>& files) const
+{
+    using namespace LocalFileScannerDetails;
+
+    Vector<uint8> buffer;
+    auto append = [&buffer](const void* data, size_t size) {
+        const uint8* bytes = static_cast<const uint8*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    };
+
+    const uint32 count = static_cast<uint32>(files.size());
+    append(INDEX_MARKER.data(), INDEX_MARKER.size());
+    append(&INDEX_VERSION, sizeof(INDEX_VERSION));
+    append(&count, sizeof(count));
+    for (const FileInfo& info : files)
+    {
+        const uint32 nameSize = static_cast<uint32>(info.relativeName.size());
+        append(&nameSize, sizeof(nameSize));
+        append(info.relativeName.data(), nameSize);
+        append(&info.sizeOnDevice, sizeof(info.sizeOnDevice));
+        append(&info.modificationTime, sizeof(info.modificationTime));
+        append(&info.compressedSize, sizeof(info.compressedSize));
+        append(&info.crc32Hash, sizeof(info.crc32Hash));
+    }
+
+    ScopedPtr<File> file(File::Create(indexPath, File::CREATE | File::WRITE));
+    if (!file || file->Write(buffer.data(), static_cast<uint32>(buffer.size())) != buffer.size())
+    {
+        Logger::Error("can't write local files index: %s", indexPath.GetStringValue().c_str());
+        return false;
+    }
+    return true;
+}
+
+void LocalFileScanner::LoadIndex(UnorderedMap<String, FileInfo>& index) const
+{
+    using namespace LocalFileScannerDetails;
+
+    ScopedPtr<File> file(File::Create(indexPath, File::OPEN | File::READ));
+    if (!file)
+    {
+        return; // first scan
+    }
+
+    Vector<uint8> buffer(static_cast<size_t>(file->GetSize()));
+    if (file->Read(buffer.data(), static_cast<uint32>(buffer.size())) != buffer.size())
+    {
+        return;
+    }
+
+    size_t offset = 0;
+    auto read = [&buffer, &offset](void* data, size_t size) {
+        if (offset + size > buffer.size())
+        {
+            return false;
+        }
+        Memcpy(data, buffer.data() + offset, size);
+        offset += size;
+        return true;
+    };
+
+    Array<char8, 4> marker;
+    uint32 version = 0;
+    uint32 count = 0;
+    if (!read(marker.data(), marker.size()) || marker != INDEX_MARKER || !read(&version, sizeof(version)) || version != INDEX_VERSION || !read(&count, sizeof(count)))
+    {
+        Logger::Info("local files index has unknown format: %s", indexPath.GetStringValue().c_str());
+        return;
+    }
+
+    index.reserve(std::min<size_t>(count, buffer.size() / 32)); // count may be broken
+    for (uint32 i = 0; i < count; ++i)
+    {
+        FileInfo info;
+        uint32 nameSize = 0;
+        if (!read(&nameSize, sizeof(nameSize)) || offset + nameSize > buffer.size())
+        {
+            break;
+        }
+        info.relativeName.assign(reinterpret_cast<const char8*>(buffer.data() + offset), nameSize);
+        offset += nameSize;
+
+        if (!read(&info.sizeOnDevice, sizeof(info.sizeOnDevice)) ||
+            !read(&info.modificationTime, sizeof(info.modificationTime)) ||
+            !read(&info.compressedSize, sizeof(info.compressedSize)) ||
+            !read(&info.crc32Hash, sizeof(info.crc32Hash)))
+        {
+            break; // truncated index, use what is read
+        }
+        index.emplace(info.relativeName, info);
+    }
+}
+
+void LocalFileScanner::RecursiveScan(const FilePath& currentDir, Vector<FileInfo>& files) const
+{
+    ScopedPtr<FileList> fl(new FileList(currentDir, false));
+
+    for (uint32 index = 0; index < fl->GetCount(); ++index)
+    {
+        const FilePath& path = fl->GetPathname(index);
+        if (fl->IsNavigationDirectory(index))
+        {
+            continue;
+        }
+        if (fl->IsDirectory(index))
+        {
+            RecursiveScan(path, files);
+        }
+        else if (path.GetExtension() == LocalFileScannerDetails::extDvpl)
+        {
+            FileInfo info;
+            if (FileAPI::GetFileSizeAndModificationTime(path.GetAbsolutePathname(), info.sizeOnDevice, info.modificationTime))
+            {
+                info.relativeName = path.GetRelativePathname(dir);
+                files.push_back(info);
+            }
+        }
+    }
+}
+
+bool LocalFileScanner::ReadFooter(const String& fileName, FileInfo& info)
+{
+    FILE* f = FileAPI::OpenFile(fileName, "rb");
+    if (f == nullptr)
+    {
+        Logger::Info("can't open file %s during scan", fileName.c_str());
+        return false;
+    }
+
+    bool result = false;
+    const int32 footerSize = sizeof(PackFormat::LitePack::Footer);
+    if (0 == fseek(f, -footerSize, SEEK_END))
+    {
+        PackFormat::LitePack::Footer footer;
+        if (footerSize == fread(&footer, 1, footerSize, f))
+        {
+            info.compressedSize = footer.sizeCompressed;
+            info.crc32Hash = footer.crc32Compressed;
+            result = true;
+        }
+        else
+        {
+            Logger::Info("can't read footer in file: %s", fileName.c_str());
+        }
+    }
+    else
+    {
+        Logger::Info("can't seek to dvpl footer in file: %s", fileName.c_str());
+    }
+    FileAPI::Close(f);
+    return result;
+}
+} // end namespace DAVA
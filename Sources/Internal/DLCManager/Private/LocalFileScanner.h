@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "FileSystem/FilePath.h"
+#include "Job/ParallelFor.h"
+
+namespace DAVA
+{
+/**
+	Find downloaded .dvpl files and read their footers.
+
+	Scan is incremental: footers of files with the same size and modification time
+	as during previous scan are taken from index file, so they are available right after
+	`Start`. Footers of new and changed files are read by JobManager workers
+	and collected in `Finish`.
+*/
+class LocalFileScanner final
+{
+public:
+    struct FileInfo
+    {
+        String relativeName;
+        uint64 sizeOnDevice = std::numeric_limits<uint64>::max();
+        int64 modificationTime = 0;
+        uint32 compressedSize = std::numeric_limits<uint32>::max(); // file size can be 0 so use max value default
+        uint32 crc32Hash = std::numeric_limits<uint32>::max();
+    };
+
+    LocalFileScanner(const FilePath& dir, const FilePath& indexPath);
+    ~LocalFileScanner();
+
+    /** list files in directory, take unchanged files from index and start reading other footers */
+    void Start(size_t maxFilesHint);
+    /** files found in index, valid after `Start` */
+    const Vector<FileInfo>& GetIndexedFiles() const;
+    /** help workers and wait until all footers are read, incomplete files without footer are deleted */
+    const Vector<FileInfo>& Finish();
+
+    /** write index for next scan, files not in list are read again next time */
+    bool SaveIndex(const Vector<FileInfo>& files) const;
+
+    /** read compressed size and crc32 from footer of file */
+    static bool ReadFooter(const String& fileName, FileInfo& info);
+
+private:
+    void RecursiveScan(const FilePath& dir, Vector<FileInfo>& files) const;
+    void LoadIndex(UnorderedMap<String, FileInfo>& index) const;
+
+    FilePath dir;
+    FilePath indexPath;
+    Vector<FileInfo> indexedFiles;
+    Vector<FileInfo> readFiles;
+    String baseDir;
+    Vector<FileInfo> unreadFiles;
+    Vector<uint8> isRead;
+    ParallelJobs footerJobs;
+    bool isScanning = false;
+};
+} // end namespace DAVA
@@ -201,6 +201,12 @@ bool PackRequest::IsDownloaded() const
     return isDownloaded;
 }
 
+void PackRequest::SetDownloaded()
+{
+    DVASSERT(delayedRequest);
+    isDownloaded = true;
+}
+
 void PackRequest::Finalize()
 {
     DVASSERT(isDownloaded);
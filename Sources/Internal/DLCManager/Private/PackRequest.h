@@ -41,6 +41,8 @@ public:
 
     /** return true when all files loaded and ready */
     bool IsDownloaded() const final;
+    /** mark delayed request downloaded, when all its files are found before initialization finished */
+    void SetDownloaded();
 
     DLCManager& GetDLCManager() const final;
 
@@ -53,6 +53,13 @@ void DebugOverlayItemRenderStats::Draw()
             AddUIntStat("Packets", stats.packets2d);
         }
 
+        if (ImGui::CollapsingHeader("3D"))
+        {
+            AddUIntStat("Batches", stats.batches3d);
+            AddUIntStat("Packets", stats.packets3d);
+            AddUIntStat("Instanced Packets", stats.instancedPackets3d);
+        }
+
         if (ImGui::CollapsingHeader("Fragments Info"))
         {
             for (uint32 i = 0; i < uint32(VisibilityQueryResults::QUERY_INDEX_COUNT); ++i)
@@ -256,6 +256,14 @@ public:
         | shader_const_buffer_size        |                            | 0              |
 
         For more info on render options ask RHI guys.
+
+        | **FileSystem options**          | Description                                  | Default                        |
+        | ------------------------------- | -------------------------------------------- | ------------------------------ |
+        | resources_index                 | index resource folders, see FileSystem       | true, false in console mode    |
+
+        | **Text options**                | Description                                  | Default                        |
+        | ------------------------------- | -------------------------------------------- | ------------------------------ |
+        | glyph_atlas                     | draw FreeType fonts from shared glyph atlas  | true                           |
     
         Other options can be found in description for corresponding module.
     */
@@ -228,6 +228,9 @@ void EngineBackend::Init(eEngineRunMode engineRunMode, const Vector<String>& mod
         options.Set(options_);
     }
 
+    // Index resource folders on background thread while application starts
+    context->fileSystem->SetResourcesIndexEnabled(options->GetBool("resources_index", !IsConsoleMode()));
+
     // Do not initialize PlatformCore in console mode as console mode is fully
     // implemented in EngineBackend
     if (!IsConsoleMode())
@@ -883,6 +886,7 @@ void EngineBackend::CreateSubsystems(const Vector<String>& modules)
 
     context->animationManager = new AnimationManager();
     context->fontManager = new FontManager();
+    TextBlock::SetGlyphAtlasEnabled(options->GetBool("glyph_atlas", true));
 
     context->typeDB = TypeDB::GetLocalDB();
     context->fastNameDB = FastNameDB::GetLocalDB();
@@ -1071,6 +1075,8 @@ void EngineBackend::DestroySubsystems()
     SafeRelease(context->assetsManager);
 #endif
 
+    // Log files are written on background thread, finish writing while file system is alive
+    context->logger->Flush();
     SafeRelease(context->fileSystem);
     if (context->deviceManager != nullptr)
     {
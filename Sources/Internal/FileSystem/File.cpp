@@ -11,6 +11,7 @@
 #include "FileSystem/FileSystemDelegate.h"
 #include "FileSystem/Private/PackFormatSpec.h"
 #include "FileSystem/Private/CheckIOError.h"
+#include "FileSystem/Private/ResourcesIndex.h"
 #include "FileSystem/ResourceArchive.h"
 #include "Engine/Private/Android/AssetsManagerAndroid.h"
 
@@ -159,26 +160,40 @@ File* File::Create(const FilePath& filename, uint32 attributes)
             taggedFilename.ReplaceBasename(basename);
         }
 
-        File* result = PureCreate(taggedFilename, attributes);
-        if (result != nullptr)
+        // resources index lets skip opening files which are known to be absent
+        if (fs->resourcesIndex->Lookup(taggedFilename) != ResourcesIndex::NOT_FOUND)
         {
-            result->filename = filename;
-            return result;
+            File* result = PureCreate(taggedFilename, attributes);
+            if (result != nullptr)
+            {
+                result->filename = filename;
+                return result;
+            }
         }
     }
     //end of tags
 
-    File* result = PureCreate(filename, attributes);
-    if (result != nullptr)
+    const bool readOnly = !(attributes & (WRITE | CREATE | APPEND));
+    File* result = nullptr;
+    if (!readOnly || fs->resourcesIndex->Lookup(filename) != ResourcesIndex::NOT_FOUND)
     {
-        return result;
+        result = PureCreate(filename, attributes);
+        if (result != nullptr)
+        {
+            if (attributes & (CREATE | APPEND))
+            {
+                fs->resourcesIndex->Invalidate(filename);
+            }
+            return result;
+        }
     }
 
-    if (!(attributes & (WRITE | CREATE | APPEND)))
+    if (readOnly)
     {
         FilePath compressedFile = filename + extDvpl;
+        const ResourcesIndex::eLookup indexed = fs->resourcesIndex->Lookup(compressedFile);
         const String fileNameAbs = compressedFile.GetAbsolutePathname();
-        if (FileAPI::IsRegularFile(fileNameAbs))
+        if (indexed == ResourcesIndex::FILE || (indexed == ResourcesIndex::NOT_INDEXED && FileAPI::IsRegularFile(fileNameAbs)))
         {
             try
             {
@@ -295,8 +310,9 @@ File* File::CompressedCreate(const FilePath& filename, uint32 attributes)
     if (footer.type == Compressor::Type::Lz4HC || footer.type == Compressor::Type::Lz4)
     {
         Vector<uint8> uncompressed(footer.sizeUncompressed);
+        size_t uncompressedSize = uncompressed.size();
 
-        if (!LZ4HCCompressor().Decompress(compressed, uncompressed))
+        if (!LZ4HCCompressor().Decompress(compressed.data(), compressed.size(), uncompressed.data(), uncompressedSize) || uncompressedSize != uncompressed.size())
         {
             Logger::Error("decompress failed on file: %s", filename.GetAbsolutePathname().c_str());
             return nullptr;
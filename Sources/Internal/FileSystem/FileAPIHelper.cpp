@@ -3,6 +3,7 @@
 #include "Utils/UTF8Utils.h"
 #include "Logger/Logger.h"
 
+#include <atomic>
 #include <sys/stat.h>
 
 namespace DAVA
@@ -17,8 +18,16 @@ using Stat = struct ::stat;
 const auto FileStat = stat;
 #endif
 
+#if defined(__DAVAENGINE_DEBUG__)
+static std::atomic<uint64> callCount{ 0 };
+#define DAVA_FILE_API_COUNT_CALL() ++callCount
+#else
+#define DAVA_FILE_API_COUNT_CALL()
+#endif
+
 FILE* OpenFile(const String& fileName, const String& mode)
 {
+    DAVA_FILE_API_COUNT_CALL();
 #ifdef __DAVAENGINE_WINDOWS__
     WideString f = UTF8Utils::EncodeToWideString(fileName);
     WideString m = UTF8Utils::EncodeToWideString(mode);
@@ -95,6 +104,7 @@ static void LogError(int32 errnoCode, const String& fileName, const char* functi
 
 bool IsRegularFile(const String& fileName)
 {
+    DAVA_FILE_API_COUNT_CALL();
     Stat fileStat;
 
 #ifdef __DAVAENGINE_WINDOWS__
@@ -118,6 +128,7 @@ bool IsDirectory(const String& dirName)
 #define S_ISDIR(m) (((m)&S_IFMT) == S_IFDIR) /* directory */
 #define CLEAR_S_ISDIR_TMP_VAR 1
 #endif
+    DAVA_FILE_API_COUNT_CALL();
     Stat fileStat;
 
 #ifdef __DAVAENGINE_WINDOWS__
@@ -141,6 +152,7 @@ bool IsDirectory(const String& dirName)
 
 uint64 GetFileSize(const String& fileName)
 {
+    DAVA_FILE_API_COUNT_CALL();
     Stat fileStat;
 
 #ifdef __DAVAENGINE_WINDOWS__
@@ -159,5 +171,34 @@ uint64 GetFileSize(const String& fileName)
     return std::numeric_limits<uint64>::max();
 }
 
+bool GetFileSizeAndModificationTime(const String& fileName, uint64& size, int64& modificationTime)
+{
+    DAVA_FILE_API_COUNT_CALL();
+    Stat fileStat;
+
+#ifdef __DAVAENGINE_WINDOWS__
+    WideString p = UTF8Utils::EncodeToWideString(fileName);
+    int32 result = FileStat(p.c_str(), &fileStat);
+#else
+    int32 result = FileStat(fileName.c_str(), &fileStat);
+#endif
+    if (result == 0)
+    {
+        size = static_cast<uint64>(fileStat.st_size);
+        modificationTime = static_cast<int64>(fileStat.st_mtime);
+        return true;
+    }
+
+    LogError(errno, fileName, __FUNCTION__);
+    return false;
+}
+
+#if defined(__DAVAENGINE_DEBUG__)
+uint64 GetCallCount()
+{
+    return callCount;
+}
+#endif
+
 } // end namespace FileAPI
 } // end namespace DAVA
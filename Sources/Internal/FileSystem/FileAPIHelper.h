@@ -42,5 +42,21 @@ bool IsDirectory(const String& dirName);
 	return std::numeric_limits<uint64>::max() on error
 */
 uint64 GetFileSize(const String& fileName);
+
+/**
+	fileName - utf8 string
+	fill size and last modification time (seconds since epoch) with one call
+	return false on error
+*/
+bool GetFileSizeAndModificationTime(const String& fileName, uint64& size, int64& modificationTime);
+
+#if defined(__DAVAENGINE_DEBUG__)
+/**
+	number of file open and stat calls made through FileAPI since start,
+	compare values before and after operation to measure its file system load.
+	Calls are counted in debug builds only
+*/
+uint64 GetCallCount();
+#endif
 }
 }
@@ -1,5 +1,6 @@
 #include "FileSystem/FilePath.h"
 #include "FileSystem/FileSystem.h"
+#include "FileSystem/Private/ResourcesIndex.h"
 #include "Engine/Engine.h"
 #include "Engine/EngineContext.h"
 #include "Utils/UTF8Utils.h"
@@ -36,6 +37,7 @@ void FilePath::SetBundleName(const FilePath& newBundlePath)
     }
 
     ctx->fileSystem->resourceFolders.insert(begin(ctx->fileSystem->resourceFolders), virtualBundlePath);
+    ctx->fileSystem->resourcesIndex->Invalidate();
 }
 
 const FilePath& FilePath::GetBundleName()
@@ -56,6 +58,7 @@ void FilePath::AddResourcesFolder(const FilePath& folder)
 
     const EngineContext* ctx = GetEngineContext();
     ctx->fileSystem->resourceFolders.push_back(resPath);
+    ctx->fileSystem->resourcesIndex->Invalidate();
 }
 
 void FilePath::AddTopResourcesFolder(const FilePath& folder)
@@ -69,6 +72,7 @@ void FilePath::AddTopResourcesFolder(const FilePath& folder)
 
     const EngineContext* ctx = GetEngineContext();
     ctx->fileSystem->resourceFolders.insert(begin(ctx->fileSystem->resourceFolders), resPath);
+    ctx->fileSystem->resourcesIndex->Invalidate();
 }
 
 void FilePath::RemoveResourcesFolder(const FilePath& folder)
@@ -79,6 +83,7 @@ void FilePath::RemoveResourcesFolder(const FilePath& folder)
     {
         ctx->fileSystem->resourceFolders.erase(it);
     }
+    ctx->fileSystem->resourcesIndex->Invalidate();
 }
 
 const Vector<FilePath>& FilePath::GetResFolders()
@@ -440,6 +445,12 @@ String FilePath::ResolveResourcesPath() const
         FilePath path;
 
         const EngineContext* ctx = GetEngineContext();
+        String indexedPathname;
+        if (ctx->fileSystem->resourcesIndex->Resolve(relativePathname, indexedPathname) != ResourcesIndex::NOT_INDEXED)
+        {
+            return indexedPathname;
+        }
+
         for (auto reverseIt = ctx->fileSystem->resourceFolders.rbegin(); reverseIt != ctx->fileSystem->resourceFolders.rend(); ++reverseIt)
         {
             path = reverseIt->absolutePathname + relativePathname;
@@ -9,6 +9,7 @@
 #include "FileSystem/FileSystem.h"
 #include "FileSystem/FileSystemDelegate.h"
 #include "FileSystem/FileList.h"
+#include "FileSystem/Private/ResourcesIndex.h"
 #include "FileSystem/YamlNode.h"
 #include "Debug/DVAssert.h"
 #include "Utils/Utils.h"
@@ -53,6 +54,7 @@ namespace DAVA
 static Set<String> androidAssetsFiles;
 
 FileSystem::FileSystem()
+    : resourcesIndex(new ResourcesIndex(resourceFolders))
 {
 }
 
@@ -118,17 +120,33 @@ FileSystem::eCreateDirectoryResult FileSystem::CreateExactDirectory(const FilePa
 #ifdef __DAVAENGINE_WINDOWS__
     WideString path = UTF8Utils::EncodeToWideString(filePath.GetAbsolutePathname());
     BOOL res = ::CreateDirectoryW(path.c_str(), 0);
-    return (res == 0) ? DIRECTORY_CANT_CREATE : DIRECTORY_CREATED;
+    const bool created = (res != 0);
 #elif defined(__DAVAENGINE_POSIX__)
     int res = mkdir(filePath.GetAbsolutePathname().c_str(), 0777);
-    return (res == 0) ? (DIRECTORY_CREATED) : (DIRECTORY_CANT_CREATE);
+    const bool created = (res == 0);
 #endif //PLATFORMS
+
+    if (created)
+    {
+        resourcesIndex->Invalidate(filePath);
+    }
+    return created ? DIRECTORY_CREATED : DIRECTORY_CANT_CREATE;
 }
 
 bool FileSystem::CopyFile(const FilePath& existingFile, const FilePath& newFile, bool overwriteExisting /* = false */)
 {
     DVASSERT(newFile.GetType() != FilePath::PATH_IN_RESOURCES);
 
+    const bool copied = CopyExactFile(existingFile, newFile, overwriteExisting);
+    if (copied)
+    {
+        resourcesIndex->Invalidate(newFile);
+    }
+    return copied;
+}
+
+bool FileSystem::CopyExactFile(const FilePath& existingFile, const FilePath& newFile, bool overwriteExisting)
+{
 #ifdef __DAVAENGINE_WINDOWS__
     WideString existingFilePath = UTF8Utils::EncodeToWideString(existingFile.GetAbsolutePathname());
     WideString newFilePath = UTF8Utils::EncodeToWideString(newFile.GetAbsolutePathname());
@@ -234,7 +252,12 @@ bool FileSystem::MoveFile(const FilePath& existingFile, const FilePath& newFile,
         }
     }
     bool error = (0 != result);
-    if (error)
+    if (!error)
+    {
+        resourcesIndex->Invalidate(existingFile);
+        resourcesIndex->Invalidate(newFile);
+    }
+    else
     {
         const char* errorReason = strerror(errno);
         Logger::Error("rename failed (\"%s\" -> \"%s\") with error: %s",
@@ -280,6 +303,7 @@ bool FileSystem::DeleteFile(const FilePath& filePath)
     int res = FileAPI::RemoveFile(fileName);
     if (res == 0)
     {
+        resourcesIndex->Invalidate(filePath);
         return true;
     }
 
@@ -331,11 +355,15 @@ bool FileSystem::DeleteDirectory(const FilePath& path, bool isRecursive)
     WideString sysPath = UTF8Utils::EncodeToWideString(path.GetAbsolutePathname());
     int32 chmodres = _wchmod(sysPath.c_str(), _S_IWRITE); // change read-only file mode
     int32 res = _wrmdir(sysPath.c_str());
-    return (res == 0);
 #elif defined(__DAVAENGINE_POSIX__)
     int32 res = rmdir(path.GetAbsolutePathname().c_str());
-    return (res == 0);
 #endif //PLATFORMS
+
+    if (res == 0)
+    {
+        resourcesIndex->Invalidate(path);
+    }
+    return (res == 0);
 }
 
 uint32 FileSystem::DeleteDirectoryFiles(const FilePath& path, bool isRecursive)
@@ -556,6 +584,12 @@ bool FileSystem::IsFile(const FilePath& pathToCheck) const
         return false;
     }
 
+    const ResourcesIndex::eLookup indexed = resourcesIndex->Lookup(pathToCheck);
+    if (indexed != ResourcesIndex::NOT_INDEXED)
+    {
+        return indexed == ResourcesIndex::FILE || resourcesIndex->Lookup(pathToCheck + extDvpl) == ResourcesIndex::FILE;
+    }
+
     if (FileAPI::IsRegularFile(nativePath))
     {
         return true;
@@ -589,6 +623,12 @@ bool FileSystem::IsDirectory(const FilePath& pathToCheck) const
         return false;
     }
 
+    const ResourcesIndex::eLookup indexed = resourcesIndex->Lookup(pathToCheck);
+    if (indexed != ResourcesIndex::NOT_INDEXED)
+    {
+        return indexed == ResourcesIndex::DIRECTORY;
+    }
+
 #if defined(__DAVAENGINE_WIN32__)
     WideString path = UTF8Utils::EncodeToWideString(pathToCheckStr);
     DWORD stats = GetFileAttributesW(path.c_str());
@@ -1248,4 +1288,24 @@ FileSystemDelegate* FileSystem::GetDelegate() const
 {
     return fsDelegate;
 }
+
+void FileSystem::SetResourcesIndexEnabled(bool enabled)
+{
+    resourcesIndex->SetEnabled(enabled);
+}
+
+bool FileSystem::IsResourcesIndexEnabled() const
+{
+    return resourcesIndex->IsEnabled();
+}
+
+void FileSystem::InvalidateResourcesIndex()
+{
+    resourcesIndex->Invalidate();
+}
+
+void FileSystem::WaitResourcesIndex()
+{
+    resourcesIndex->WaitBuilt();
+}
 }
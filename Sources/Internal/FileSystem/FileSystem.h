@@ -26,6 +26,7 @@ namespace DAVA
 	\todo add support for pack files
 */
 class FileSystemDelegate;
+class ResourcesIndex;
 class FileSystem : public Singleton<FileSystem>
 {
 public:
@@ -303,10 +304,26 @@ public:
     void SetDelegate(FileSystemDelegate* delegate);
     FileSystemDelegate* GetDelegate() const;
 
+    /**
+        \brief Enable in-memory index of files in resource folders, Engine enables it on start
+        in GUI modes (see `resources_index` option).
+        With index `~res:/` paths are resolved and files in resource folders are checked without file system calls.
+        Index is built on background thread and rebuilt after resource folders or files in them are changed
+        through FileSystem and File, paths are compared case sensitive. Until index is built file system is asked.
+        Call InvalidateResourcesIndex after files in resource folders are changed bypassing FileSystem,
+        in desktop debug builds it is done automatically.
+    */
+    void SetResourcesIndexEnabled(bool enabled);
+    bool IsResourcesIndexEnabled() const;
+    void InvalidateResourcesIndex();
+    /** Block until resources index is built, e.g. behind loading screen */
+    void WaitResourcesIndex();
+
 private:
     bool HasLineEnding(File* f);
 
     virtual eCreateDirectoryResult CreateExactDirectory(const FilePath& filePath);
+    bool CopyExactFile(const FilePath& existingFile, const FilePath& newFile, bool overwriteExisting);
 
     FilePath currentDocDirectory; // TODO how it influence on multithreading with FS?
 
@@ -339,5 +356,6 @@ private:
     friend class File;
     friend class FilePath;
     Vector<FilePath> resourceFolders;
+    std::unique_ptr<ResourcesIndex> resourcesIndex;
 };
 }
@@ -216,12 +216,8 @@ bool KeyedArchive::Load(const uint8* data, uint32 size)
         return false;
     }
 
-    ScopedPtr<DynamicMemoryFile> buffer(DynamicMemoryFile::Create(File::CREATE | File::WRITE | File::READ));
-    auto written = buffer->Write(data, size);
-    DVASSERT(written == size);
-
-    buffer->Seek(0, File::SEEK_FROM_START);
-
+    // Read directly from provided memory without copying it into temporary file
+    ScopedPtr<UnmanagedMemoryFile> buffer(new UnmanagedMemoryFile(data, size));
     return Load(buffer);
 }
 
@@ -0,0 +1,440 @@
+#include "FileSystem/KeyedArchiveView.h"
+#include "FileSystem/KeyedArchive.h"
+#include "FileSystem/UnmanagedMemoryFile.h"
+#include "Base/ScopedPtr.h"
+#include "Logger/Logger.h"
+
+#include <algorithm>
+
+namespace DAVA
+{
+namespace KeyedArchiveViewDetails
+{
+// Size of value in serialized form for types with fixed size, 0 for types with variable size
+uint32 GetFixedValueSize(uint8 type)
+{
+    switch (type)
+    {
+    case VariantType::TYPE_BOOLEAN:
+    case VariantType::TYPE_INT8:
+    case VariantType::TYPE_UINT8:
+        return 1;
+    case VariantType::TYPE_INT16:
+    case VariantType::TYPE_UINT16:
+        return 2;
+    case VariantType::TYPE_INT32:
+    case VariantType::TYPE_UINT32:
+    case VariantType::TYPE_FLOAT:
+        return 4;
+    case VariantType::TYPE_INT64:
+    case VariantType::TYPE_UINT64:
+    case VariantType::TYPE_FLOAT64:
+        return 8;
+    case VariantType::TYPE_VECTOR2:
+        return sizeof(Vector2);
+    case VariantType::TYPE_VECTOR3:
+        return sizeof(Vector3);
+    case VariantType::TYPE_VECTOR4:
+        return sizeof(Vector4);
+    case VariantType::TYPE_MATRIX2:
+        return sizeof(Matrix2);
+    case VariantType::TYPE_MATRIX3:
+        return sizeof(Matrix3);
+    case VariantType::TYPE_MATRIX4:
+        return sizeof(Matrix4);
+    case VariantType::TYPE_COLOR:
+        return sizeof(Color);
+    case VariantType::TYPE_AABBOX3:
+        return sizeof(AABBox3);
+    default:
+        return 0;
+    }
+}
+
+// Strings can be serialized with trailing zeros ("aa\0\0"), VariantType::Read cuts them off
+uint32 GetStringLength(const char8* str, uint32 maxLength)
+{
+    const void* zero = memchr(str, 0, maxLength);
+    return zero != nullptr ? static_cast<uint32>(static_cast<const char8*>(zero) - str) : maxLength;
+}
+
+int CompareKeys(const char8* key1, uint32 length1, const char8* key2, uint32 length2)
+{
+    int result = memcmp(key1, key2, std::min(length1, length2));
+    if (0 == result)
+    {
+        result = length1 < length2 ? -1 : (length1 > length2 ? 1 : 0);
+    }
+    return result;
+}
+} // namespace KeyedArchiveViewDetails
+
+KeyedArchiveView::KeyedArchiveView(const uint8* data_, uint32 size_)
+    : data(data_)
+    , size(size_)
+{
+}
+
+bool KeyedArchiveView::IsValid() const
+{
+    BuildIndex();
+    return valid;
+}
+
+uint32 KeyedArchiveView::Count() const
+{
+    BuildIndex();
+    return static_cast<uint32>(entries.size());
+}
+
+void KeyedArchiveView::BuildIndex() const
+{
+    using namespace KeyedArchiveViewDetails;
+
+    if (indexBuilt)
+        return;
+
+    indexBuilt = true;
+    valid = false;
+    if (nullptr == data || size < 2)
+        return;
+
+    uint32 offset = 0;
+    uint32 itemCount = std::numeric_limits<uint32>::max();
+    if ('K' == data[0] && 'A' == data[1])
+    {
+        uint16 version = 0;
+        uint32 count = 0;
+        if (size < 8)
+            return;
+
+        Memcpy(&version, data + 2, sizeof(version));
+        Memcpy(&count, data + 4, sizeof(count));
+        if (version != 1)
+        {
+            Logger::Error("[KeyedArchiveView] error loading keyed archive, because version is incorrect");
+            return;
+        }
+        offset = 8;
+        itemCount = count;
+        entries.reserve(count);
+    }
+
+    // For legacy format without header items are read till the end of data
+    bool parsed = true;
+    for (uint32 item = 0; item < itemCount && offset < size; ++item)
+    {
+        Entry entry;
+        parsed = ParseItem(offset, entry);
+        if (!parsed)
+            break;
+        entries.push_back(entry);
+    }
+    valid = parsed;
+
+    // Later items overwrite earlier ones with the same key like in KeyedArchive::Load,
+    // so keep only the last occurrence of each key after stable sort
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& l, const Entry& r) {
+        return CompareKeys(l.key, l.keyLength, r.key, r.keyLength) < 0;
+    });
+    auto last = std::unique(entries.rbegin(), entries.rend(), [](const Entry& l, const Entry& r) {
+        return 0 == CompareKeys(l.key, l.keyLength, r.key, r.keyLength);
+    });
+    entries.erase(entries.begin(), last.base());
+}
+
+bool KeyedArchiveView::ParseItem(uint32& offset, Entry& entry) const
+{
+    using namespace KeyedArchiveViewDetails;
+
+    // Key is serialized as VariantType of string type
+    uint32 keyLength = 0;
+    if (size - offset < 5 || data[offset] != VariantType::TYPE_STRING)
+        return false;
+
+    Memcpy(&keyLength, data + offset + 1, sizeof(keyLength));
+    offset += 5;
+    if (size - offset < keyLength)
+        return false;
+
+    entry.key = reinterpret_cast<const char8*>(data + offset);
+    entry.keyLength = GetStringLength(entry.key, keyLength);
+    offset += keyLength;
+
+    entry.valueOffset = offset;
+    return SkipValue(offset);
+}
+
+bool KeyedArchiveView::SkipValue(uint32& offset) const
+{
+    using namespace KeyedArchiveViewDetails;
+
+    if (offset >= size)
+        return false;
+
+    const uint8 type = data[offset];
+    offset += 1;
+
+    uint32 valueSize = GetFixedValueSize(type);
+    if (0 == valueSize)
+    {
+        uint32 length = 0;
+        if (size - offset < sizeof(length))
+            return false;
+        Memcpy(&length, data + offset, sizeof(length));
+        offset += sizeof(length);
+
+        switch (type)
+        {
+        case VariantType::TYPE_STRING:
+        case VariantType::TYPE_FASTNAME:
+        case VariantType::TYPE_FILEPATH:
+        case VariantType::TYPE_BYTE_ARRAY:
+        case VariantType::TYPE_KEYED_ARCHIVE:
+            valueSize = length;
+            break;
+        case VariantType::TYPE_WIDE_STRING:
+            if (length > std::numeric_limits<uint32>::max() / sizeof(wchar_t))
+                return false;
+            valueSize = length * sizeof(wchar_t);
+            break;
+        default:
+            return false;
+        }
+    }
+
+    if (size - offset < valueSize)
+        return false;
+    offset += valueSize;
+    return true;
+}
+
+const KeyedArchiveView::Entry* KeyedArchiveView::FindEntry(const String& key) const
+{
+    using namespace KeyedArchiveViewDetails;
+
+    BuildIndex();
+
+    const char8* keyData = key.data();
+    const uint32 keyLength = static_cast<uint32>(key.size());
+    auto it = std::lower_bound(entries.begin(), entries.end(), key, [keyData, keyLength](const Entry& e, const String&) {
+        return CompareKeys(e.key, e.keyLength, keyData, keyLength) < 0;
+    });
+    if (it != entries.end() && 0 == CompareKeys(it->key, it->keyLength, keyData, keyLength))
+    {
+        return &*it;
+    }
+    return nullptr;
+}
+
+const uint8* KeyedArchiveView::FindValue(const String& key, VariantType::eVariantType type) const
+{
+    const Entry* entry = FindEntry(key);
+    if (entry != nullptr && data[entry->valueOffset] == type)
+    {
+        return data + entry->valueOffset + 1;
+    }
+    return nullptr;
+}
+
+bool KeyedArchiveView::IsKeyExists(const String& key) const
+{
+    return FindEntry(key) != nullptr;
+}
+
+VariantType::eVariantType KeyedArchiveView::GetType(const String& key) const
+{
+    const Entry* entry = FindEntry(key);
+    return entry != nullptr ? static_cast<VariantType::eVariantType>(data[entry->valueOffset]) : VariantType::TYPE_NONE;
+}
+
+bool KeyedArchiveView::GetBool(const String& key, bool defaultValue) const
+{
+    const uint8* value = FindValue(key, VariantType::TYPE_BOOLEAN);
+    return value != nullptr ? (*value != 0) : defaultValue;
+}
+
+int32 KeyedArchiveView::GetInt32(const String& key, int32 defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_INT32, defaultValue);
+}
+
+uint32 KeyedArchiveView::GetUInt32(const String& key, uint32 defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_UINT32, defaultValue);
+}
+
+int64 KeyedArchiveView::GetInt64(const String& key, int64 defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_INT64, defaultValue);
+}
+
+uint64 KeyedArchiveView::GetUInt64(const String& key, uint64 defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_UINT64, defaultValue);
+}
+
+float32 KeyedArchiveView::GetFloat(const String& key, float32 defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_FLOAT, defaultValue);
+}
+
+float64 KeyedArchiveView::GetFloat64(const String& key, float64 defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_FLOAT64, defaultValue);
+}
+
+Vector2 KeyedArchiveView::GetVector2(const String& key, const Vector2& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_VECTOR2, defaultValue);
+}
+
+Vector3 KeyedArchiveView::GetVector3(const String& key, const Vector3& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_VECTOR3, defaultValue);
+}
+
+Vector4 KeyedArchiveView::GetVector4(const String& key, const Vector4& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_VECTOR4, defaultValue);
+}
+
+Matrix2 KeyedArchiveView::GetMatrix2(const String& key, const Matrix2& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_MATRIX2, defaultValue);
+}
+
+Matrix3 KeyedArchiveView::GetMatrix3(const String& key, const Matrix3& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_MATRIX3, defaultValue);
+}
+
+Matrix4 KeyedArchiveView::GetMatrix4(const String& key, const Matrix4& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_MATRIX4, defaultValue);
+}
+
+Color KeyedArchiveView::GetColor(const String& key, const Color& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_COLOR, defaultValue);
+}
+
+AABBox3 KeyedArchiveView::GetAABBox3(const String& key, const AABBox3& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_AABBOX3, defaultValue);
+}
+
+const char8* KeyedArchiveView::GetStringData(const String& key, uint32* length) const
+{
+    DVASSERT(length != nullptr);
+
+    const Entry* entry = FindEntry(key);
+    if (entry != nullptr)
+    {
+        const uint8 type = data[entry->valueOffset];
+        if (VariantType::TYPE_STRING == type || VariantType::TYPE_FASTNAME == type || VariantType::TYPE_FILEPATH == type)
+        {
+            return GetStringData(entry, length);
+        }
+    }
+    *length = 0;
+    return nullptr;
+}
+
+const char8* KeyedArchiveView::GetStringData(const Entry* entry, uint32* length) const
+{
+    uint32 len = 0;
+    Memcpy(&len, data + entry->valueOffset + 1, sizeof(len));
+
+    const char8* str = reinterpret_cast<const char8*>(data + entry->valueOffset + 1 + sizeof(len));
+    *length = KeyedArchiveViewDetails::GetStringLength(str, len);
+    return str;
+}
+
+String KeyedArchiveView::GetString(const String& key, const String& defaultValue) const
+{
+    const Entry* entry = FindEntry(key);
+    if (entry != nullptr)
+    {
+        const uint8 type = data[entry->valueOffset];
+        if (VariantType::TYPE_STRING == type)
+        {
+            uint32 length = 0;
+            const char8* str = GetStringData(entry, &length);
+            return String(str, length);
+        }
+        else if (VariantType::TYPE_WIDE_STRING == type)
+        {
+            // Wide strings are converted into utf8 on reading
+            return GetVariant(key).AsString();
+        }
+    }
+    return defaultValue;
+}
+
+FastName KeyedArchiveView::GetFastName(const String& key, const FastName& defaultValue) const
+{
+    const Entry* entry = FindEntry(key);
+    if (entry != nullptr && VariantType::TYPE_FASTNAME == data[entry->valueOffset])
+    {
+        uint32 length = 0;
+        const char8* str = GetStringData(entry, &length);
+        return FastName(String(str, length));
+    }
+    return defaultValue;
+}
+
+const uint8* KeyedArchiveView::GetByteArray(const String& key, const uint8* defaultValue) const
+{
+    const uint8* value = FindValue(key, VariantType::TYPE_BYTE_ARRAY);
+    return value != nullptr ? value + sizeof(uint32) : defaultValue;
+}
+
+int32 KeyedArchiveView::GetByteArraySize(const String& key, int32 defaultValue) const
+{
+    return static_cast<int32>(GetValue(key, VariantType::TYPE_BYTE_ARRAY, static_cast<uint32>(defaultValue)));
+}
+
+KeyedArchiveView KeyedArchiveView::GetArchive(const String& key) const
+{
+    const Entry* entry = FindEntry(key);
+    if (entry != nullptr)
+    {
+        const uint8 type = data[entry->valueOffset];
+        if (VariantType::TYPE_KEYED_ARCHIVE == type || VariantType::TYPE_BYTE_ARRAY == type)
+        {
+            uint32 len = 0;
+            Memcpy(&len, data + entry->valueOffset + 1, sizeof(len));
+            return KeyedArchiveView(data + entry->valueOffset + 1 + sizeof(len), len);
+        }
+    }
+    return KeyedArchiveView();
+}
+
+VariantType KeyedArchiveView::GetVariant(const String& key) const
+{
+    VariantType result;
+
+    const Entry* entry = FindEntry(key);
+    if (entry != nullptr)
+    {
+        uint32 offset = entry->valueOffset;
+        SkipValue(offset);
+
+        ScopedPtr<UnmanagedMemoryFile> file(new UnmanagedMemoryFile(data + entry->valueOffset, offset - entry->valueOffset));
+        result.Read(file);
+    }
+    return result;
+}
+
+RefPtr<KeyedArchive> KeyedArchiveView::CreateKeyedArchive() const
+{
+    RefPtr<KeyedArchive> archive(new KeyedArchive());
+    if (data != nullptr && size > 0)
+    {
+        archive->Load(data, size);
+    }
+    return archive;
+}
+
+} // namespace DAVA
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/FastName.h"
+#include "Base/RefPtr.h"
+#include "FileSystem/VariantType.h"
+
+#include "Math/Matrix2.h"
+#include "Math/Matrix3.h"
+#include "Math/Matrix4.h"
+#include "Math/Vector.h"
+#include "Math/Color.h"
+#include "Math/AABBox3.h"
+
+namespace DAVA
+{
+class KeyedArchive;
+
+/**
+    \ingroup filesystem
+    \brief Read-only view over serialized KeyedArchive data ("KA" v1 format and legacy headerless format).
+
+    Unlike KeyedArchive::Load view does not copy data and does not create VariantType for each item:
+    keys are indexed lazily on first access and values are read in place from underlying memory.
+    Nested archives are returned as views over the same memory, so they are parsed only if accessed.
+
+    View does not own memory, caller should keep buffer alive while view and all views obtained from it are used.
+    Lazy index building is not thread safe, so one view should not be accessed from several threads simultaneously.
+ */
+class KeyedArchiveView final
+{
+public:
+    KeyedArchiveView() = default;
+    KeyedArchiveView(const uint8* data, uint32 size);
+
+    /**
+        \brief Check whether underlying data is well-formed archive.
+        Items successfully parsed before malformed item are still accessible.
+     */
+    bool IsValid() const;
+
+    /** Number of unique keys in archive */
+    uint32 Count() const;
+
+    bool IsKeyExists(const String& key) const;
+    VariantType::eVariantType GetType(const String& key) const;
+
+    bool GetBool(const String& key, bool defaultValue = false) const;
+    int32 GetInt32(const String& key, int32 defaultValue = 0) const;
+    uint32 GetUInt32(const String& key, uint32 defaultValue = 0) const;
+    int64 GetInt64(const String& key, int64 defaultValue = 0) const;
+    uint64 GetUInt64(const String& key, uint64 defaultValue = 0) const;
+    float32 GetFloat(const String& key, float32 defaultValue = 0.0f) const;
+    float64 GetFloat64(const String& key, float64 defaultValue = 0.0) const;
+
+    Vector2 GetVector2(const String& key, const Vector2& defaultValue = Vector2()) const;
+    Vector3 GetVector3(const String& key, const Vector3& defaultValue = Vector3()) const;
+    Vector4 GetVector4(const String& key, const Vector4& defaultValue = Vector4()) const;
+    Matrix2 GetMatrix2(const String& key, const Matrix2& defaultValue = Matrix2()) const;
+    Matrix3 GetMatrix3(const String& key, const Matrix3& defaultValue = Matrix3()) const;
+    Matrix4 GetMatrix4(const String& key, const Matrix4& defaultValue = Matrix4()) const;
+    Color GetColor(const String& key, const Color& defaultValue = Color()) const;
+    AABBox3 GetAABBox3(const String& key, const AABBox3& defaultValue = AABBox3()) const;
+
+    String GetString(const String& key, const String& defaultValue = "") const;
+    FastName GetFastName(const String& key, const FastName& defaultValue = FastName()) const;
+
+    /**
+        \brief Get pointer to string, fast name or file path characters inside underlying memory.
+        \param[out] length length of string without trailing zeros
+        \returns pointer to characters (not null-terminated) or nullptr if key isn't available or value has other type
+     */
+    const char8* GetStringData(const String& key, uint32* length) const;
+
+    /**
+        \brief Get pointer to byte array inside underlying memory.
+        \returns pointer to array data or defaultValue if key isn't available or value is not byte array
+     */
+    const uint8* GetByteArray(const String& key, const uint8* defaultValue = nullptr) const;
+    int32 GetByteArraySize(const String& key, int32 defaultValue = 0) const;
+
+    /**
+        \brief Get nested archive as view over the same memory.
+        Also can be used for byte arrays that contain serialized archive (see KeyedArchive::SetByteArrayFromArchive).
+        \returns view over nested archive or empty view if key isn't available
+     */
+    KeyedArchiveView GetArchive(const String& key) const;
+
+    /** Read value into VariantType, value of any type can be read in such a way */
+    VariantType GetVariant(const String& key) const;
+
+    /** Create KeyedArchive with all items from view */
+    RefPtr<KeyedArchive> CreateKeyedArchive() const;
+
+private:
+    struct Entry
+    {
+        const char8* key;
+        uint32 keyLength;
+        uint32 valueOffset; // Offset of value's type byte from data start
+    };
+
+    void BuildIndex() const;
+    bool ParseItem(uint32& offset, Entry& entry) const;
+    bool SkipValue(uint32& offset) const;
+    const Entry* FindEntry(const String& key) const;
+    const char8* GetStringData(const Entry* entry, uint32* length) const;
+    const uint8* FindValue(const String& key, VariantType::eVariantType type) const;
+
+    template <typename T>
+    T GetValue(const String& key, VariantType::eVariantType type, const T& defaultValue) const;
+
+    const uint8* data = nullptr;
+    uint32 size = 0;
+
+    mutable Vector<Entry> entries; // Sorted by key
+    mutable bool indexBuilt = false;
+    mutable bool valid = false;
+};
+
+template <typename T>
+T KeyedArchiveView::GetValue(const String& key, VariantType::eVariantType type, const T& defaultValue) const
+{
+    const uint8* value = FindValue(key, type);
+    if (value != nullptr)
+    {
+        // Values are packed without alignment so copy them
+        T result;
+        Memcpy(&result, value, sizeof(T));
+        return result;
+    }
+    return defaultValue;
+}
+
+} // namespace DAVA
@@ -25,15 +25,14 @@ void PackArchive::ExtractFileTableData(const PackFormat::PackFile::FooterBlock&
 
     std::copy_n(startOfCompressedNames, footerBlock.info.namesSizeCompressed, fileTableBlock.names.compressedNames.data());
 
-    Vector<uint8> originalNamesBuffer;
-    originalNamesBuffer.resize(footerBlock.info.namesSizeOriginal);
-    if (!LZ4HCCompressor().Decompress(compressedNamesBuffer, originalNamesBuffer))
+    // names are decompressed right into result string
+    fileNames.resize(footerBlock.info.namesSizeOriginal);
+    size_t namesSize = fileNames.size();
+    if (!LZ4HCCompressor().Decompress(startOfCompressedNames, footerBlock.info.namesSizeCompressed, reinterpret_cast<uint8*>(&fileNames[0]), namesSize) || namesSize != fileNames.size())
     {
         DAVA_THROW(DAVA::Exception, "can't uncompress file names");
     }
 
-    fileNames = String(begin(originalNamesBuffer), end(originalNamesBuffer));
-
     Vector<PackFormat::FileTableEntry>& fileTable = fileTableBlock.data.files;
     fileTable.resize(footerBlock.info.numFiles);
 
@@ -240,6 +239,7 @@ bool PackArchive::LoadFile(const String& relativeFilePath, Vector<uint8>& output
     break;
     case Compressor::Type::Lz4:
     case Compressor::Type::Lz4HC:
+    case Compressor::Type::RFC1951:
     {
         Vector<uint8> packedBuf(fileEntry.compressedSize);
 
@@ -250,25 +250,18 @@ bool PackArchive::LoadFile(const String& relativeFilePath, Vector<uint8>& output
             return false;
         }
 
-        if (!LZ4Compressor().Decompress(packedBuf, output))
+        bool decompressOk = false;
+        size_t outputSize = output.size();
+        if (fileEntry.type == Compressor::Type::RFC1951)
         {
-            Logger::Error("can't load file: %s  course: decompress error", relativeFilePath.c_str());
-            return false;
+            decompressOk = ZipCompressor().Decompress(packedBuf.data(), packedBuf.size(), output.data(), outputSize);
         }
-    }
-    break;
-    case Compressor::Type::RFC1951:
-    {
-        Vector<uint8> packedBuf(fileEntry.compressedSize);
-
-        uint32 readOk = file->Read(packedBuf.data(), fileEntry.compressedSize);
-        if (readOk != fileEntry.compressedSize)
+        else
         {
-            Logger::Error("can't load file: %s course: can't read compressed content", relativeFilePath.c_str());
-            return false;
+            decompressOk = LZ4Compressor().Decompress(packedBuf.data(), packedBuf.size(), output.data(), outputSize);
         }
 
-        if (!ZipCompressor().Decompress(packedBuf, output))
+        if (!decompressOk || outputSize != output.size())
         {
             Logger::Error("can't load file: %s  course: decompress error", relativeFilePath.c_str());
             return false;
@@ -278,7 +271,7 @@ bool PackArchive::LoadFile(const String& relativeFilePath, Vector<uint8>& output
     } // end switch
 
     // check crc32 for file content
-    if (fileEntry.originalCrc32 != 0 && fileEntry.originalCrc32 != CRC32::ForBuffer(output.data(), output.size()))
+    if (fileEntry.originalCrc32 != 0 && fileEntry.originalCrc32 != CRC32::ForBufferParallel(output.data(), output.size()))
     {
         String msg = "original crc32 not match for: " + relativeFilePath + " during decompress from pack: " + archiveName.GetStringValue();
         throw FileCrc32FromPackNotMatch(msg, __FILE__, __LINE__);
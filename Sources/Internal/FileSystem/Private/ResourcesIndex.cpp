@@ -0,0 +1,311 @@
+#include "FileSystem/Private/ResourcesIndex.h"
+#include "Concurrency/LockGuard.h"
+#include "Concurrency/Thread.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileAPIHelper.h"
+#include "FileSystem/FileList.h"
+#include "Logger/Logger.h"
+
+#if defined(__DAVAENGINE_DEBUG__) && (defined(__DAVAENGINE_WIN32__) || defined(__DAVAENGINE_MACOS__))
+#define DAVA_RESOURCES_INDEX_WATCH 1
+#include "Base/Exception.h"
+#include "FileSystem/FileWatcher.h"
+#else
+#define DAVA_RESOURCES_INDEX_WATCH 0
+#endif
+
+namespace DAVA
+{
+ResourcesIndex::ResourcesIndex(const Vector<FilePath>& resourceFolders_)
+    : resourceFolders(resourceFolders_)
+{
+}
+
+ResourcesIndex::~ResourcesIndex()
+{
+    {
+        LockGuard<Mutex> lock(mutex);
+        stopBuilding = true;
+        changed.NotifyAll();
+    }
+
+    if (buildThread != nullptr)
+    {
+        buildThread->Join();
+        SafeRelease(buildThread);
+    }
+}
+
+void ResourcesIndex::SetEnabled(bool enabled_)
+{
+    enabled = enabled_;
+    Invalidate();
+}
+
+bool ResourcesIndex::IsEnabled() const
+{
+    return enabled;
+}
+
+void ResourcesIndex::Invalidate()
+{
+    LockGuard<Mutex> lock(mutex);
+    data.reset();
+    ++generation;
+
+    roots.clear();
+    roots.reserve(resourceFolders.size());
+    for (const FilePath& folder : resourceFolders)
+    {
+        String root = folder.GetAbsolutePathname();
+        if (!root.empty() && root.back() != '/')
+        {
+            root += '/';
+        }
+        roots.push_back(root);
+    }
+
+    if (enabled && buildThread == nullptr)
+    {
+        buildThread = Thread::Create([this]() { BuildThread(); });
+        buildThread->SetName("DAVA.ResourcesIndex");
+        buildThread->Start();
+    }
+    changed.NotifyAll();
+}
+
+void ResourcesIndex::Invalidate(const FilePath& changedPath)
+{
+    if (!enabled)
+    {
+        return;
+    }
+
+    String path = changedPath.GetAbsolutePathname();
+    if (path.empty() || path.back() != '/')
+    {
+        path += '/'; // so that resource folder itself matches too
+    }
+
+    LockGuard<Mutex> lock(mutex);
+    for (const String& root : roots)
+    {
+        if (path.compare(0, root.size(), root) == 0)
+        {
+            data.reset();
+            ++generation;
+            changed.NotifyAll();
+            return;
+        }
+    }
+}
+
+void ResourcesIndex::WaitBuilt()
+{
+    UniqueLock<Mutex> lock(mutex);
+    changed.Wait(lock, [this]() { return !enabled || stopBuilding || data != nullptr; });
+}
+
+ResourcesIndex::eLookup ResourcesIndex::Lookup(const String& absolutePath)
+{
+    std::shared_ptr<const Data> d = GetData();
+    if (!d)
+    {
+        return NOT_INDEXED;
+    }
+
+    auto found = d->paths.find(absolutePath);
+    if (found == d->paths.end() && !absolutePath.empty() && absolutePath.back() != '/')
+    {
+        found = d->paths.find(absolutePath + '/'); // directory checked by file-like path
+    }
+    if (found != d->paths.end())
+    {
+        return found->second;
+    }
+
+    for (const String& root : d->roots)
+    {
+        if (absolutePath.compare(0, root.size(), root) == 0)
+        {
+            return NOT_FOUND;
+        }
+    }
+    return NOT_INDEXED;
+}
+
+ResourcesIndex::eLookup ResourcesIndex::Lookup(const FilePath& path)
+{
+    if (!enabled)
+    {
+        return NOT_INDEXED;
+    }
+
+    const String& pathValue = path.GetStringValue();
+    if (path.GetType() == FilePath::PATH_IN_RESOURCES && pathValue.compare(0, 6, "~res:/") == 0)
+    {
+        String absolutePath;
+        const eLookup resolved = Resolve(pathValue.substr(6), absolutePath);
+        if (resolved == NOT_INDEXED || resolved == NOT_FOUND)
+        {
+            return resolved;
+        }
+        return Lookup(absolutePath);
+    }
+    return Lookup(path.GetAbsolutePathname());
+}
+
+ResourcesIndex::eLookup ResourcesIndex::Resolve(const String& relativePath, String& absolutePath)
+{
+    std::shared_ptr<const Data> d = GetData();
+    if (!d || !d->allRootsIndexed)
+    {
+        return NOT_INDEXED;
+    }
+
+    auto found = d->resolved.find(relativePath);
+    if (found != d->resolved.end())
+    {
+        absolutePath = d->roots[found->second] + relativePath;
+        return (!relativePath.empty() && relativePath.back() == '/') ? DIRECTORY : FILE;
+    }
+
+    if (!relativePath.empty() && relativePath.back() != '/')
+    {
+        found = d->resolved.find(relativePath + '/'); // directory referred by file-like path
+        if (found != d->resolved.end())
+        {
+            absolutePath = d->roots[found->second] + relativePath;
+            return DIRECTORY;
+        }
+    }
+
+    absolutePath = relativePath;
+    return NOT_FOUND;
+}
+
+std::shared_ptr<const ResourcesIndex::Data> ResourcesIndex::GetData()
+{
+    if (!enabled)
+    {
+        return nullptr;
+    }
+
+    LockGuard<Mutex> lock(mutex);
+    return data;
+}
+
+void ResourcesIndex::BuildThread()
+{
+    UniqueLock<Mutex> lock(mutex);
+    while (!stopBuilding)
+    {
+        if (!enabled || data)
+        {
+            changed.Wait(lock);
+            continue;
+        }
+
+        // Folders are walked without lock: walking goes through FileSystem, so lookups made
+        // meanwhile just fall back to file system calls. Index built for outdated state is dropped
+        const uint32 buildGeneration = generation;
+        const Vector<String> buildRoots = roots;
+        lock.Unlock();
+
+        std::shared_ptr<const Data> built = Build(buildRoots);
+        WatchRoots(built->roots);
+
+        lock.Lock();
+        if (buildGeneration == generation)
+        {
+            data = built;
+            changed.NotifyAll();
+        }
+    }
+}
+
+std::shared_ptr<const ResourcesIndex::Data> ResourcesIndex::Build(const Vector<String>& roots) const
+{
+    std::shared_ptr<Data> result = std::make_shared<Data>();
+    for (const String& root : roots)
+    {
+        if (root.empty() || !FileAPI::IsDirectory(root))
+        {
+            // e.g. resources inside android APK, which can't be listed cheaply
+            result->allRootsIndexed = false;
+            continue;
+        }
+
+        const uint32 rootIndex = static_cast<uint32>(result->roots.size());
+        result->roots.push_back(root);
+        result->paths[root] = DIRECTORY;
+        AddDirectory(root, rootIndex, FilePath(root), *result);
+    }
+    return result;
+}
+
+void ResourcesIndex::AddDirectory(const String& root, uint32 rootIndex, const FilePath& dir, Data& d) const
+{
+    ScopedPtr<FileList> fileList(new FileList(dir));
+    for (uint32 i = 0; i < fileList->GetCount(); ++i)
+    {
+        if (fileList->IsNavigationDirectory(i))
+        {
+            continue;
+        }
+
+        const FilePath& path = fileList->GetPathname(i);
+        const String& absolutePath = path.GetStringValue();
+        const String relativePath = absolutePath.substr(root.size());
+
+        // later resource folders have priority, same as in FilePath::ResolveResourcesPath
+        d.resolved[relativePath] = rootIndex;
+        if (fileList->IsDirectory(i))
+        {
+            d.paths[absolutePath] = DIRECTORY;
+            AddDirectory(root, rootIndex, path, d);
+        }
+        else
+        {
+            d.paths[absolutePath] = FILE;
+            if (relativePath.size() > extDvpl.size() && relativePath.compare(relativePath.size() - extDvpl.size(), extDvpl.size(), extDvpl) == 0)
+            {
+                d.resolved[relativePath.substr(0, relativePath.size() - extDvpl.size())] = rootIndex;
+            }
+        }
+    }
+}
+
+void ResourcesIndex::WatchRoots(const Vector<String>& roots)
+{
+#if DAVA_RESOURCES_INDEX_WATCH
+    LockGuard<Mutex> lock(watcherMutex);
+    if (!watcher)
+    {
+        watcher.reset(new FileWatcher());
+        watcher->onWatchersChanged.Connect([this](const String&, FileWatcher::eWatchEvent) {
+            // only resource folders are watched, so any change drops index
+            LockGuard<Mutex> lock(mutex);
+            data.reset();
+            ++generation;
+            changed.NotifyAll();
+        });
+    }
+
+    for (const String& root : roots)
+    {
+        if (watchedRoots.insert(root).second)
+        {
+            try
+            {
+                watcher->Add(root, true);
+            }
+            catch (const Exception& e)
+            {
+                Logger::Warning("can't watch resources folder %s: %s", root.c_str(), e.what());
+            }
+        }
+    }
+#endif
+}
+} // end namespace DAVA
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Concurrency/ConditionVariable.h"
+#include "Concurrency/Mutex.h"
+#include "FileSystem/FilePath.h"
+
+#include <atomic>
+
+namespace DAVA
+{
+class FileWatcher;
+class Thread;
+
+/**
+	In-memory index of files and directories in resource folders.
+
+	Index is built on background thread by walking all resource folders once, after that `~res:/` paths
+	are resolved and checked for existence without file system calls. Until index is ready lookups
+	return NOT_INDEXED and callers ask file system. Index is dropped and rebuilt when resource folders
+	change or FileSystem creates, moves or deletes something inside them. In desktop debug builds
+	resource folders are also watched for changes made by other processes.
+*/
+class ResourcesIndex final
+{
+public:
+    enum eLookup
+    {
+        NOT_INDEXED, // index is disabled or path is outside of indexed folders, ask file system
+        NOT_FOUND,
+        FILE,
+        DIRECTORY
+    };
+
+    ResourcesIndex(const Vector<FilePath>& resourceFolders);
+    ~ResourcesIndex();
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const;
+    /** drop index and rebuild it for current resource folders */
+    void Invalidate();
+    /** drop index if `changedPath` is inside of indexed resource folders */
+    void Invalidate(const FilePath& changedPath);
+    /** block until index is built, returns immediately if index is disabled */
+    void WaitBuilt();
+
+    /** check absolute path of file or directory */
+    eLookup Lookup(const String& absolutePath);
+    /** check exact file or directory (not its `.dvpl` variant) which `path` refers to */
+    eLookup Lookup(const FilePath& path);
+    /**
+		find top resource folder containing `relativePath` the same way as FilePath does:
+		`.dvpl` variant of file counts as file. `absolutePath` is `relativePath` if nothing is found
+	*/
+    eLookup Resolve(const String& relativePath, String& absolutePath);
+
+private:
+    struct Data
+    {
+        Vector<String> roots;
+        UnorderedMap<String, eLookup> paths; // absolute path -> FILE or DIRECTORY
+        UnorderedMap<String, uint32> resolved; // relative path -> index of top root
+        bool allRootsIndexed = true;
+    };
+
+    std::shared_ptr<const Data> GetData();
+    void BuildThread();
+    std::shared_ptr<const Data> Build(const Vector<String>& roots) const;
+    void AddDirectory(const String& root, uint32 rootIndex, const FilePath& dir, Data& data) const;
+    void WatchRoots(const Vector<String>& roots);
+
+    const Vector<FilePath>& resourceFolders;
+
+    Mutex mutex;
+    ConditionVariable changed;
+    std::shared_ptr<const Data> data;
+    Vector<String> roots; // absolute paths of resource folders index is built for
+    uint32 generation = 0;
+    std::atomic<bool> enabled{ false };
+    bool stopBuilding = false;
+    Thread* buildThread = nullptr;
+
+#if defined(__DAVAENGINE_DEBUG__) && (defined(__DAVAENGINE_WIN32__) || defined(__DAVAENGINE_MACOS__))
+    Mutex watcherMutex;
+    std::unique_ptr<FileWatcher> watcher;
+    Set<String> watchedRoots;
+#endif
+};
+} // end namespace DAVA
@@ -0,0 +1,372 @@
+#include "FileSystem/YamlBinary.h"
+#include "FileSystem/YamlNode.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FilePath.h"
+#include "FileSystem/FileSystem.h"
+#include "Base/ScopedPtr.h"
+#include "Logger/Logger.h"
+#include "Utils/CRC32.h"
+
+namespace DAVA
+{
+namespace YamlBinaryDetails
+{
+const char8 MAGIC[4] = { 'D', 'V', 'Y', 'B' };
+const uint32 VERSION = 3;
+const uint32 HEADER_SIZE = sizeof(MAGIC) + 5 * sizeof(uint32);
+const uint32 MAX_DEPTH = 256;
+
+class Writer
+{
+public:
+    void CollectStrings(const YamlNode* node)
+    {
+        nodeCount += 1;
+        switch (node->GetType())
+        {
+        case YamlNode::TYPE_STRING:
+            AddString(node->AsString());
+            break;
+        case YamlNode::TYPE_ARRAY:
+            for (uint32 i = 0, n = node->GetCount(); i < n; ++i)
+            {
+                CollectStrings(node->Get(i));
+            }
+            break;
+        case YamlNode::TYPE_MAP:
+            for (uint32 i = 0, n = node->GetCount(); i < n; ++i)
+            {
+                AddString(node->GetItemKeyName(i));
+                CollectStrings(node->Get(i));
+            }
+            break;
+        }
+    }
+
+    void WriteHeaderAndStrings(const YamlBinary::SourceInfo& sourceInfo)
+    {
+        WriteBytes(MAGIC, sizeof(MAGIC));
+        WriteUInt32(VERSION);
+        WriteUInt32(sourceInfo.size);
+        WriteUInt32(sourceInfo.hash);
+        WriteUInt32(static_cast<uint32>(strings.size()));
+        WriteUInt32(nodeCount);
+        for (const String* str : strings)
+        {
+            WriteUInt32(static_cast<uint32>(str->size()));
+            WriteBytes(str->data(), str->size());
+        }
+    }
+
+    void WriteNode(const YamlNode* node)
+    {
+        uint8 style = 0;
+        uint8 keyStyle = 0;
+        uint8 orderedSave = 0;
+        switch (node->GetType())
+        {
+        case YamlNode::TYPE_STRING:
+            style = static_cast<uint8>(node->GetStringRepresentation());
+            break;
+        case YamlNode::TYPE_ARRAY:
+            style = static_cast<uint8>(node->GetArrayRepresentation());
+            break;
+        case YamlNode::TYPE_MAP:
+            style = static_cast<uint8>(node->GetMapRepresentation());
+            keyStyle = static_cast<uint8>(node->GetMapKeyRepresentation());
+            orderedSave = node->GetMapOrderRepresentation() ? 1 : 0;
+            break;
+        }
+
+        const uint8 nodeHeader[4] = { static_cast<uint8>(node->GetType()), style, keyStyle, orderedSave };
+        WriteBytes(nodeHeader, sizeof(nodeHeader));
+
+        switch (node->GetType())
+        {
+        case YamlNode::TYPE_STRING:
+            WriteUInt32(stringIndices[node->AsString()]);
+            break;
+        case YamlNode::TYPE_ARRAY:
+            WriteUInt32(node->GetCount());
+            for (uint32 i = 0, n = node->GetCount(); i < n; ++i)
+            {
+                WriteNode(node->Get(i));
+            }
+            break;
+        case YamlNode::TYPE_MAP:
+            WriteUInt32(node->GetCount());
+            for (uint32 i = 0, n = node->GetCount(); i < n; ++i)
+            {
+                WriteUInt32(stringIndices[node->GetItemKeyName(i)]);
+                WriteNode(node->Get(i));
+            }
+            break;
+        }
+    }
+
+    const Vector<uint8>& GetBuffer() const
+    {
+        return buffer;
+    }
+
+private:
+    void AddString(const String& str)
+    {
+        auto result = stringIndices.emplace(str, static_cast<uint32>(strings.size()));
+        if (result.second)
+        {
+            strings.push_back(&result.first->first);
+        }
+    }
+
+    void WriteUInt32(uint32 value)
+    {
+        WriteBytes(&value, sizeof(value));
+    }
+
+    void WriteBytes(const void* data, size_t size)
+    {
+        const uint8* bytes = static_cast<const uint8*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+    }
+
+    UnorderedMap<String, uint32> stringIndices;
+    Vector<const String*> strings;
+    uint32 nodeCount = 0;
+    Vector<uint8> buffer;
+};
+
+class Reader
+{
+public:
+    Reader(const uint8* data_, uint32 size_)
+        : data(data_)
+        , size(size_)
+    {
+    }
+
+    bool ReadHeaderAndStrings()
+    {
+        uint32 version = 0;
+        uint32 sourceSize = 0;
+        uint32 sourceHash = 0;
+        uint32 stringCount = 0;
+        uint32 nodeCount = 0;
+        offset = sizeof(MAGIC);
+        if (!ReadUInt32(version) || !ReadUInt32(sourceSize) || !ReadUInt32(sourceHash) || !ReadUInt32(stringCount) || !ReadUInt32(nodeCount))
+            return false;
+
+        if (version != VERSION)
+        {
+            Logger::Error("[YamlBinary] unsupported version %u", version);
+            return false;
+        }
+
+        // Each string takes at least 4 bytes, check count before reserving memory
+        if (stringCount > (size - offset) / sizeof(uint32))
+            return false;
+
+        strings.reserve(stringCount);
+        for (uint32 i = 0; i < stringCount; ++i)
+        {
+            uint32 length = 0;
+            if (!ReadUInt32(length) || size - offset < length)
+                return false;
+
+            strings.emplace_back(reinterpret_cast<const char8*>(data + offset), length);
+            offset += length;
+        }
+        return true;
+    }
+
+    RefPtr<YamlNode> ReadNode(uint32 depth)
+    {
+        if (depth > MAX_DEPTH || size - offset < 4)
+            return RefPtr<YamlNode>();
+
+        const uint8 type = data[offset];
+        const uint8 style = data[offset + 1];
+        const uint8 keyStyle = data[offset + 2];
+        const uint8 orderedSave = data[offset + 3];
+        offset += 4;
+
+        RefPtr<YamlNode> node;
+        switch (type)
+        {
+        case YamlNode::TYPE_STRING:
+        {
+            uint32 index = 0;
+            if (!ReadUInt32(index) || index >= strings.size())
+                return RefPtr<YamlNode>();
+
+            node = YamlNode::CreateStringNode();
+            node->Set(strings[index]);
+            node->SetStringRepresentation(static_cast<YamlNode::eStringRepresentation>(style));
+        }
+        break;
+        case YamlNode::TYPE_ARRAY:
+        {
+            uint32 count = 0;
+            if (!ReadUInt32(count))
+                return RefPtr<YamlNode>();
+
+            node = YamlNode::CreateArrayNode(static_cast<YamlNode::eArrayRepresentation>(style));
+            for (uint32 i = 0; i < count; ++i)
+            {
+                RefPtr<YamlNode> child = ReadNode(depth + 1);
+                if (!child)
+                    return RefPtr<YamlNode>();
+                node->AddNodeToArray(child);
+            }
+        }
+        break;
+        case YamlNode::TYPE_MAP:
+        {
+            uint32 count = 0;
+            if (!ReadUInt32(count))
+                return RefPtr<YamlNode>();
+
+            node = YamlNode::CreateMapNode(orderedSave != 0, static_cast<YamlNode::eMapRepresentation>(style), static_cast<YamlNode::eStringRepresentation>(keyStyle));
+            for (uint32 i = 0; i < count; ++i)
+            {
+                uint32 keyIndex = 0;
+                if (!ReadUInt32(keyIndex) || keyIndex >= strings.size())
+                    return RefPtr<YamlNode>();
+
+                RefPtr<YamlNode> child = ReadNode(depth + 1);
+                if (!child)
+                    return RefPtr<YamlNode>();
+                node->AddNodeToMap(strings[keyIndex], child);
+            }
+        }
+        break;
+        default:
+            break;
+        }
+        return node;
+    }
+
+private:
+    bool ReadUInt32(uint32& value)
+    {
+        if (size - offset < sizeof(value))
+            return false;
+
+        Memcpy(&value, data + offset, sizeof(value));
+        offset += sizeof(value);
+        return true;
+    }
+
+    const uint8* data = nullptr;
+    uint32 size = 0;
+    uint32 offset = 0;
+    Vector<String> strings;
+};
+} // namespace YamlBinaryDetails
+
+const char8* YamlBinary::FILE_EXTENSION = ".yamlb";
+
+FilePath YamlBinary::GetBinaryPath(const FilePath& yamlPath)
+{
+    return FilePath::CreateWithNewExtension(yamlPath, FILE_EXTENSION);
+}
+
+bool YamlBinary::GetSourceInfo(const FilePath& yamlPath, SourceInfo& sourceInfo)
+{
+    Vector<uint8> buffer;
+    if (!FileSystem::Instance()->ReadFileContents(yamlPath, buffer))
+        return false;
+
+    sourceInfo.size = static_cast<uint32>(buffer.size());
+    sourceInfo.hash = CRC32::ForBuffer(buffer.data(), buffer.size());
+    return true;
+}
+
+bool YamlBinary::Save(File* file, const YamlNode* rootNode, const SourceInfo& sourceInfo)
+{
+    DVASSERT(file != nullptr);
+    DVASSERT(rootNode != nullptr);
+
+    YamlBinaryDetails::Writer writer;
+    writer.CollectStrings(rootNode);
+    writer.WriteHeaderAndStrings(sourceInfo);
+    writer.WriteNode(rootNode);
+
+    const Vector<uint8>& buffer = writer.GetBuffer();
+    const uint32 size = static_cast<uint32>(buffer.size());
+    return file->Write(buffer.data(), size) == size;
+}
+
+bool YamlBinary::SaveToFile(const FilePath& path, const YamlNode* rootNode, const SourceInfo& sourceInfo)
+{
+    ScopedPtr<File> file(File::Create(path, File::CREATE | File::WRITE));
+    if (!file)
+    {
+        Logger::Error("[YamlBinary] can't create file %s", path.GetStringValue().c_str());
+        return false;
+    }
+    return Save(file, rootNode, sourceInfo);
+}
+
+bool YamlBinary::IsBinaryYaml(const uint8* data, uint32 size)
+{
+    using namespace YamlBinaryDetails;
+    return data != nullptr && size >= HEADER_SIZE && memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+bool YamlBinary::ReadSourceInfo(const uint8* data, uint32 size, SourceInfo& sourceInfo)
+{
+    using namespace YamlBinaryDetails;
+    if (!IsBinaryYaml(data, size))
+        return false;
+
+    uint32 version = 0;
+    Memcpy(&version, data + sizeof(MAGIC), sizeof(version));
+    if (version != VERSION)
+        return false;
+
+    Memcpy(&sourceInfo.size, data + sizeof(MAGIC) + sizeof(version), sizeof(sourceInfo.size));
+    Memcpy(&sourceInfo.hash, data + sizeof(MAGIC) + sizeof(version) + sizeof(sourceInfo.size), sizeof(sourceInfo.hash));
+    return true;
+}
+
+RefPtr<YamlNode> YamlBinary::Load(const uint8* data, uint32 size)
+{
+    if (!IsBinaryYaml(data, size))
+        return RefPtr<YamlNode>();
+
+    YamlBinaryDetails::Reader reader(data, size);
+    if (!reader.ReadHeaderAndStrings())
+        return RefPtr<YamlNode>();
+
+    return reader.ReadNode(0);
+}
+
+RefPtr<YamlNode> YamlBinary::LoadFromFile(const FilePath& path, const FilePath& sourcePath)
+{
+    Vector<uint8> buffer;
+    if (!FileSystem::Instance()->ReadFileContents(path, buffer))
+        return RefPtr<YamlNode>();
+
+    // Binary yaml may be left from previous resources build. Source is compared by size only, hashing it
+    // would read whole yaml on every load; edits keeping size are caught by hash when resources are built
+    uint64 sourceSize = 0;
+    if (!sourcePath.IsEmpty() && FileSystem::Instance()->Exists(sourcePath) && FileSystem::Instance()->GetFileSize(sourcePath, sourceSize))
+    {
+        SourceInfo sourceInfo;
+        if (!ReadSourceInfo(buffer.data(), static_cast<uint32>(buffer.size()), sourceInfo) || sourceInfo.size != sourceSize)
+        {
+            Logger::Warning("[YamlBinary] file %s is outdated by %s", path.GetStringValue().c_str(), sourcePath.GetStringValue().c_str());
+            return RefPtr<YamlNode>();
+        }
+    }
+
+    RefPtr<YamlNode> rootNode = Load(buffer.data(), static_cast<uint32>(buffer.size()));
+    if (!rootNode)
+    {
+        Logger::Error("[YamlBinary] file %s is malformed", path.GetStringValue().c_str());
+    }
+    return rootNode;
+}
+
+} // namespace DAVA
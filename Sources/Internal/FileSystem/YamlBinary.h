@@ -0,0 +1,64 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/RefPtr.h"
+
+namespace DAVA
+{
+class File;
+class FilePath;
+class YamlNode;
+
+/**
+    \ingroup yaml
+    \brief Compact binary representation of yaml node tree.
+
+    Binary yaml is produced at resource build time (see `ResourceArchiver compileyaml`) and is loaded
+    without text parsing: all strings (keys and values) are stored once in string table and nodes are
+    stored in pre-order with references to that table. Node representation styles are preserved.
+    Size and CRC32 of source yaml are stored too. Resource build compares hashes to recompile changed yaml,
+    loading compares only size of source file, so binary yaml outdated by source changes is not used
+    without reading whole source on every load.
+
+    Format (little endian):
+        header:  char8 magic[4] = "DVYB", uint32 version, uint32 sourceSize, uint32 sourceHash, uint32 stringCount, uint32 nodeCount
+        strings: stringCount * { uint32 length, char8 data[length] }
+        nodes:   root node, each node is
+                 { uint8 type, uint8 style, uint8 keyStyle, uint8 orderedSave,
+                   string: uint32 stringIndex
+                   array:  uint32 count, count * { node }
+                   map:    uint32 count, count * { uint32 keyStringIndex, node } }
+*/
+class YamlBinary final
+{
+public:
+    static const char8* FILE_EXTENSION;
+
+    /** Size and CRC32 of yaml file contents the tree was parsed from */
+    struct SourceInfo
+    {
+        uint32 size = 0;
+        uint32 hash = 0;
+    };
+
+    /** Get path of binary yaml which corresponds to text yaml file */
+    static FilePath GetBinaryPath(const FilePath& yamlPath);
+    /** Read and hash yaml file, returns false if file can't be read */
+    static bool GetSourceInfo(const FilePath& yamlPath, SourceInfo& sourceInfo);
+
+    static bool Save(File* file, const YamlNode* rootNode, const SourceInfo& sourceInfo);
+    static bool SaveToFile(const FilePath& path, const YamlNode* rootNode, const SourceInfo& sourceInfo);
+
+    static bool IsBinaryYaml(const uint8* data, uint32 size);
+    static bool ReadSourceInfo(const uint8* data, uint32 size, SourceInfo& sourceInfo);
+
+    /** Load node tree from memory, returns empty pointer if data is malformed */
+    static RefPtr<YamlNode> Load(const uint8* data, uint32 size);
+    /**
+        Load node tree from file, returns empty pointer if file is malformed.
+        If `sourcePath` exists, tree is loaded only when binary yaml was compiled from file of the same size.
+    */
+    static RefPtr<YamlNode> LoadFromFile(const FilePath& path, const FilePath& sourcePath);
+};
+
+} // namespace DAVA
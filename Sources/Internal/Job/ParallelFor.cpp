@@ -0,0 +1,65 @@
+#include "Job/ParallelFor.h"
+#include "Job/JobManager.h"
+#include "Debug/DVAssert.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+
+namespace DAVA
+{
+void ParallelJobs::State::Process()
+{
+    for (uint32 item = nextItem++; item < count; item = nextItem++)
+    {
+        fn(item);
+        if (++doneItems == count)
+        {
+            allDone.Post();
+        }
+    }
+}
+
+void ParallelJobs::Start(uint32 count, const Function<void(uint32)>& fn)
+{
+    DVASSERT(state == nullptr || state->doneItems == state->count);
+
+    if (state == nullptr || state.use_count() > 1)
+    {
+        state = std::make_shared<State>();
+    }
+    state->fn = fn;
+    state->count = count;
+    state->nextItem = 0;
+    state->doneItems = 0;
+
+    // calling thread processes items too, so one item doesn't need workers
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (jobManager != nullptr && count > 1)
+    {
+        const uint32 jobCount = std::min(jobManager->GetWorkersCount(), count - 1);
+        std::shared_ptr<State> sharedState = state;
+        for (uint32 i = 0; i < jobCount; ++i)
+        {
+            jobManager->CreateWorkerJob([sharedState]() { sharedState->Process(); });
+        }
+    }
+}
+
+void ParallelJobs::Finish()
+{
+    DVASSERT(state != nullptr);
+
+    state->Process();
+    if (state->count > 0)
+    {
+        state->allDone.Wait();
+    }
+}
+
+void ParallelFor(uint32 count, const Function<void(uint32)>& fn)
+{
+    ParallelJobs jobs;
+    jobs.Start(count, fn);
+    jobs.Finish();
+}
+
+} // namespace DAVA
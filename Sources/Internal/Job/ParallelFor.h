@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Functional/Function.h"
+#include "Concurrency/SemaphoreLite.h"
+
+#include <atomic>
+#include <memory>
+
+namespace DAVA
+{
+/**
+    \brief Processes items with indices [0, count) on JobManager workers and calling thread.
+
+    Items are taken by workers and calling thread from shared counter, so `Finish` never waits for
+    jobs which haven't started yet: it processes remaining items itself and sleeps on semaphore
+    until items already taken by workers are done. Jobs started after all items were taken only touch shared state,
+    which outlives ParallelJobs object.
+
+    Processing function is called concurrently for different items.
+    State is reused by next `Start` if no late jobs hold it, so running every frame doesn't allocate.
+*/
+class ParallelJobs final
+{
+public:
+    /** Start processing `count` items with `fn` on workers. Previous processing should be finished. */
+    void Start(uint32 count, const Function<void(uint32)>& fn);
+    /** Process remaining items on calling thread and wait until all items are done. */
+    void Finish();
+
+private:
+    struct State
+    {
+        Function<void(uint32)> fn;
+        uint32 count = 0;
+        std::atomic<uint32> nextItem{ 0 };
+        std::atomic<uint32> doneItems{ 0 };
+        SemaphoreLite allDone{ 0 }; // posted once by thread which has done the last item
+
+        void Process();
+    };
+
+    std::shared_ptr<State> state;
+};
+
+/** Call `fn(i)` for every i in [0, count) on JobManager workers and calling thread, return when all calls are done. */
+void ParallelFor(uint32 count, const Function<void(uint32)>& fn);
+
+} // namespace DAVA
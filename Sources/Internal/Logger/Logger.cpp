@@ -1,4 +1,5 @@
 #include "Logger/Logger.h"
+#include "Logger/Private/LoggerFileWriter.h"
 #include "Engine/Engine.h"
 #include "FileSystem/FileSystem.h"
 #include "Debug/DVAssert.h"
@@ -99,7 +100,9 @@ static const Array<const char8*, 5> logLevelString
 Logger::Logger()
     : logLevel{ LEVEL_FRAMEWORK }
     , consoleModeEnabled{ false }
+    , fileWriter(new LoggerFileWriter())
 {
+    fileWriter->SetMaxFileSize(cutLogSize);
     SetLogFilename(String());
 }
 
@@ -336,6 +339,12 @@ FilePath Logger::GetLogPathForFilename(const String& filename)
 void Logger::SetMaxFileSize(uint32 size)
 {
     cutLogSize = size;
+    fileWriter->SetMaxFileSize(size);
+}
+
+void Logger::Flush()
+{
+    fileWriter->Flush();
 }
 
 DAVA::Logger* Logger::GetLoggerInstance()
@@ -346,85 +355,15 @@ DAVA::Logger* Logger::GetLoggerInstance()
 
 bool Logger::CutOldLogFileIfExist(const FilePath& logFile) const
 {
-    if (!logFile.Exists())
-    {
-        return true; // ok. No file - no questions;
-    }
-
-    // take the tail of the log file and put it to the start of the file. Cut file to size of taken tail.
-
-    File* log = File::Create(logFile, File::OPEN | File::READ | File::WRITE);
-    if (nullptr == log)
-    {
-        return false; // cannot open file;
-    }
-
-    SCOPE_EXIT
-    {
-        SafeRelease(log);
-    };
-
-    const uint32 sizeToCut = cutLogSize;
-
-    const uint32 fileSize = static_cast<uint32>(log->GetSize());
-    if (sizeToCut >= fileSize)
-    {
-        return true; // ok! Have less data than we should to cut.
-    }
-
-    Vector<uint8> buff(sizeToCut);
-    const bool seekSuccess = log->Seek(-static_cast<int32>(sizeToCut), File::SEEK_FROM_END);
-    if (!seekSuccess)
-    {
-        return false; // have enought data but seek error
-    }
-
-    uint32 dataReaden = log->Read(buff.data(), sizeToCut);
-    if (dataReaden != sizeToCut)
-    {
-        return false; // have enought data but can't read
-    }
-
-    SafeRelease(log);
-
-    File* truncatedLog = File::Create(logFile, File::CREATE | File::WRITE);
-    if (nullptr == truncatedLog)
-    {
-        return false;
-    }
-
-    SCOPE_EXIT
-    {
-        SafeRelease(truncatedLog);
-    };
-
-    const uint32 dataWritten = truncatedLog->Write(buff.data(), sizeToCut);
-    if (dataWritten != sizeToCut)
-    {
-        return false; // have correct file and data size but can't write to file.
-    }
-
-    return true; // correct;
+    return fileWriter->CutFile(logFile, cutLogSize);
 }
 
 void Logger::FileLog(const FilePath& customLogFileName, eLogLevel ll, const char8* text) const
 {
     if (nullptr != FileSystem::Instance())
     {
-        ScopedPtr<File> file(File::Create(customLogFileName, File::APPEND | File::WRITE));
-        if (file)
-        {
-            Array<char8, 128> prefix;
-
-            time_t timestamp = time(nullptr); //Time in UTC format
-            int32 seconds = timestamp % 60;
-            int32 minutes = (timestamp / 60) % 60;
-            int32 hours = (timestamp / (60 * 60)) % 24;
-
-            Snprintf(&prefix[0], prefix.size(), "%02d:%02d:%02d [%s] ", hours, minutes, seconds, GetLogLevelString(ll));
-            file->Write(prefix.data(), static_cast<uint32>(strlen(prefix.data())));
-            file->Write(text, static_cast<uint32>(strlen(text)));
-        }
+        // Errors often precede crash or abort, so they are on disk before Log returns
+        fileWriter->Push(customLogFileName, ll, text, ll >= LEVEL_ERROR);
     }
 }
 
@@ -473,10 +412,6 @@ void Logger::Output(const FilePath& customLogFilename, eLogLevel ll, const char8
 
         if (!customLogFilename.IsEmpty())
         {
-            if (customLogFilename != logFilename)
-            {
-                CutOldLogFileIfExist(customLogFilename);
-            }
             FileLog(customLogFilename, ll, formatedMsg);
         }
     }
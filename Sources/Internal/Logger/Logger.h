@@ -14,10 +14,12 @@
 #include "FileSystem/FilePath.h"
 
 #include <cstdarg>
+#include <memory>
 
 namespace DAVA
 {
 class LoggerOutput;
+class LoggerFileWriter;
 
 class Logger
 {
@@ -108,7 +110,15 @@ public:
 #endif
 
     static FilePath GetLogPathForFilename(const String& filename);
+
+    //! Sets size of log file tail which is kept when file is cut. Log files are cut
+    //! when they are opened and when they grow twice as big during the session.
     void SetMaxFileSize(uint32 size);
+
+    //! Waits until messages logged from this thread are written to log files.
+    //! Messages are written on background thread, errors are written before Log returns.
+    void Flush();
+
     void EnableConsoleMode();
 
     static const char8* GetLogLevelString(eLogLevel ll);
@@ -130,6 +140,7 @@ private:
     Vector<LoggerOutput*> customOutputs;
     bool consoleModeEnabled;
     uint32 cutLogSize = 512 * 1024; //0.5 MB;
+    std::unique_ptr<LoggerFileWriter> fileWriter;
 };
 
 class LoggerOutput
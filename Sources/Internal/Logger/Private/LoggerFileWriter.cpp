@@ -0,0 +1,381 @@
+#include "Logger/Private/LoggerFileWriter.h"
+#include "Concurrency/LockGuard.h"
+#include "Concurrency/Thread.h"
+#include "Concurrency/UniqueLock.h"
+#include "Debug/DVAssert.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
+
+namespace DAVA
+{
+LoggerFileWriter::LoggerFileWriter()
+    : head(&stub)
+    , tail(&stub)
+    , wakeUpPosted(false)
+    , wakeUp(0)
+    , stopping(false)
+    , writerThreadId(0)
+    , maxFileSize(0)
+{
+    stub.next = nullptr;
+}
+
+LoggerFileWriter::~LoggerFileWriter()
+{
+    if (thread != nullptr)
+    {
+        stopping = true;
+        wakeUp.Post();
+        thread->Join();
+        SafeRelease(thread);
+    }
+
+    for (auto& entry : files)
+    {
+        SafeRelease(entry.second.file);
+    }
+}
+
+void LoggerFileWriter::Push(const FilePath& filepath, Logger::eLogLevel ll, const char8* text, bool waitWritten)
+{
+    std::call_once(threadStarted, [this]() { StartThread(); });
+
+    Record* record = new Record();
+    record->filepath = filepath;
+    record->text = text;
+    record->timestamp = time(nullptr);
+    record->level = ll;
+
+    if (waitWritten && !IsWriterThread())
+    {
+        WaitWritten(record);
+    }
+    else
+    {
+        PushRecord(record);
+    }
+}
+
+void LoggerFileWriter::Flush()
+{
+    std::call_once(threadStarted, [this]() { StartThread(); });
+
+    if (IsWriterThread())
+    {
+        return; // records of writer thread are written after current batch
+    }
+
+    // Empty record only marks position in queue
+    WaitWritten(new Record());
+}
+
+bool LoggerFileWriter::CutFile(const FilePath& filepath, uint32 size)
+{
+    DVASSERT(!IsWriterThread());
+
+    Flush();
+
+    LockGuard<Mutex> lock(fileMutex);
+    CloseFile(filepath);
+    return CutFileTail(filepath, size);
+}
+
+void LoggerFileWriter::SetMaxFileSize(uint32 size)
+{
+    maxFileSize = size;
+}
+
+bool LoggerFileWriter::CutFileTail(const FilePath& filepath, uint32 size)
+{
+    if (!filepath.Exists())
+    {
+        return true; // ok. No file - no questions;
+    }
+
+    // take the tail of the log file and put it to the start of the file. Cut file to size of taken tail.
+
+    File* log = File::Create(filepath, File::OPEN | File::READ | File::WRITE);
+    if (nullptr == log)
+    {
+        return false; // cannot open file;
+    }
+
+    SCOPE_EXIT
+    {
+        SafeRelease(log);
+    };
+
+    const uint32 fileSize = static_cast<uint32>(log->GetSize());
+    if (size >= fileSize)
+    {
+        return true; // ok! Have less data than we should to cut.
+    }
+
+    Vector<uint8> buff(size);
+    const bool seekSuccess = log->Seek(-static_cast<int32>(size), File::SEEK_FROM_END);
+    if (!seekSuccess)
+    {
+        return false; // have enought data but seek error
+    }
+
+    uint32 dataReaden = log->Read(buff.data(), size);
+    if (dataReaden != size)
+    {
+        return false; // have enought data but can't read
+    }
+
+    SafeRelease(log);
+
+    File* truncatedLog = File::Create(filepath, File::CREATE | File::WRITE);
+    if (nullptr == truncatedLog)
+    {
+        return false;
+    }
+
+    SCOPE_EXIT
+    {
+        SafeRelease(truncatedLog);
+    };
+
+    const uint32 dataWritten = truncatedLog->Write(buff.data(), size);
+    if (dataWritten != size)
+    {
+        return false; // have correct file and data size but can't write to file.
+    }
+
+    return true; // correct;
+}
+
+void LoggerFileWriter::StartThread()
+{
+    thread = Thread::Create([this]() { Run(); });
+    thread->SetName("DAVA.LoggerFileWriter");
+    thread->Start();
+}
+
+void LoggerFileWriter::Enqueue(Record* record)
+{
+    record->next.store(nullptr, std::memory_order_relaxed);
+    Record* prev = head.exchange(record, std::memory_order_acq_rel);
+    prev->next.store(record, std::memory_order_release);
+}
+
+void LoggerFileWriter::PushRecord(Record* record)
+{
+    Enqueue(record);
+
+    // Only first record after writer woke up posts semaphore, writer resets flag before taking records
+    if (!wakeUpPosted.exchange(true))
+    {
+        wakeUp.Post();
+    }
+}
+
+LoggerFileWriter::Record* LoggerFileWriter::PopRecord()
+{
+    Record* first = tail;
+    Record* next = first->next.load(std::memory_order_acquire);
+    if (first == &stub)
+    {
+        if (next == nullptr)
+        {
+            return nullptr;
+        }
+        tail = next;
+        first = next;
+        next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next != nullptr)
+    {
+        tail = next;
+        return first;
+    }
+
+    if (first != head.load(std::memory_order_acquire))
+    {
+        return nullptr; // producer is in the middle of push, it will wake writer up again
+    }
+
+    Enqueue(&stub);
+    next = first->next.load(std::memory_order_acquire);
+    if (next != nullptr)
+    {
+        tail = next;
+        return first;
+    }
+    return nullptr;
+}
+
+void LoggerFileWriter::WaitWritten(Record* record)
+{
+    bool written = false;
+    record->written = &written;
+    PushRecord(record);
+
+    UniqueLock<Mutex> lock(writtenMutex);
+    writtenCondition.Wait(lock, [&written]() { return written; });
+}
+
+bool LoggerFileWriter::IsWriterThread() const
+{
+    return writerThreadId == Thread::GetCurrentIdAsUInt64();
+}
+
+void LoggerFileWriter::Run()
+{
+    writerThreadId = Thread::GetCurrentIdAsUInt64();
+
+    while (true)
+    {
+        wakeUp.Wait();
+        wakeUpPosted = false;
+        WriteQueuedRecords();
+
+        if (stopping)
+        {
+            WriteQueuedRecords();
+            break;
+        }
+    }
+}
+
+void LoggerFileWriter::WriteQueuedRecords()
+{
+    Vector<Record*> records;
+    for (Record* record = PopRecord(); record != nullptr; record = PopRecord())
+    {
+        if (record != &stub)
+        {
+            records.push_back(record);
+        }
+    }
+
+    if (records.empty())
+    {
+        return;
+    }
+
+    // Group records by file keeping their order
+    Vector<std::pair<const FilePath*, String>> batches;
+    for (Record* record : records)
+    {
+        if (record->filepath.IsEmpty())
+        {
+            continue;
+        }
+
+        auto found = std::find_if(batches.begin(), batches.end(), [record](const std::pair<const FilePath*, String>& batch) {
+            return *batch.first == record->filepath;
+        });
+        if (found == batches.end())
+        {
+            batches.emplace_back(&record->filepath, String());
+            found = batches.end() - 1;
+        }
+
+        Array<char8, 128> prefix;
+        int32 seconds = record->timestamp % 60;
+        int32 minutes = (record->timestamp / 60) % 60;
+        int32 hours = (record->timestamp / (60 * 60)) % 24;
+        Snprintf(&prefix[0], prefix.size(), "%02d:%02d:%02d [%s] ", hours, minutes, seconds, Logger::GetLogLevelString(record->level));
+
+        found->second += prefix.data();
+        found->second += record->text;
+    }
+
+    {
+        LockGuard<Mutex> lock(fileMutex);
+        for (const std::pair<const FilePath*, String>& batch : batches)
+        {
+            const uint32 batchSize = static_cast<uint32>(batch.second.size());
+            OpenedFile* opened = GetFile(*batch.first);
+            if (opened == nullptr)
+            {
+                continue;
+            }
+
+            // Rotate before write, so file always keeps at least last `maxFileSize` bytes
+            const uint32 rotationSize = maxFileSize;
+            if (rotationSize > 0 && opened->size + batchSize > 2ull * rotationSize)
+            {
+                CloseFile(*batch.first); // file is cut when it's opened again
+                opened = GetFile(*batch.first);
+                if (opened == nullptr)
+                {
+                    continue;
+                }
+            }
+
+            opened->size += opened->file->Write(batch.second.data(), batchSize);
+            opened->file->Flush();
+        }
+    }
+
+    bool hasWaiters = false;
+    for (Record* record : records)
+    {
+        hasWaiters |= (record->written != nullptr);
+    }
+    if (hasWaiters)
+    {
+        LockGuard<Mutex> lock(writtenMutex);
+        for (Record* record : records)
+        {
+            if (record->written != nullptr)
+            {
+                *record->written = true;
+            }
+        }
+        writtenCondition.NotifyAll();
+    }
+
+    for (Record* record : records)
+    {
+        delete record;
+    }
+}
+
+LoggerFileWriter::OpenedFile* LoggerFileWriter::GetFile(const FilePath& filepath)
+{
+    const String& path = filepath.GetAbsolutePathname();
+    auto found = files.find(path);
+    if (found != files.end())
+    {
+        return &found->second;
+    }
+
+    if (nullptr == FileSystem::Instance())
+    {
+        return nullptr;
+    }
+
+    // Files are cut on open, so custom log files don't grow from session to session
+    const uint32 rotationSize = maxFileSize;
+    if (rotationSize > 0)
+    {
+        CutFileTail(filepath, rotationSize);
+    }
+
+    File* file = File::Create(filepath, File::APPEND | File::WRITE);
+    if (nullptr == file)
+    {
+        return nullptr;
+    }
+
+    OpenedFile& opened = files[path];
+    opened.file = file;
+    opened.size = file->GetSize();
+    return &opened;
+}
+
+void LoggerFileWriter::CloseFile(const FilePath& filepath)
+{
+    auto found = files.find(filepath.GetAbsolutePathname());
+    if (found != files.end())
+    {
+        SafeRelease(found->second.file);
+        files.erase(found);
+    }
+}
+}
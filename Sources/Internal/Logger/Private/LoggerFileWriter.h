@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Concurrency/ConditionVariable.h"
+#include "Concurrency/Mutex.h"
+#include "Concurrency/Semaphore.h"
+#include "FileSystem/FilePath.h"
+#include "Logger/Logger.h"
+
+#include <atomic>
+#include <ctime>
+#include <mutex>
+
+namespace DAVA
+{
+class File;
+class Thread;
+
+/**
+    Writes log records to files on a dedicated background thread.
+
+    Callers push formatted records into lock-free multi-producer single-consumer queue and return immediately.
+    Writer thread takes all queued records at once, groups them by file and writes each group with one call,
+    keeping files open between batches. Files are cut to last `maxFileSize` bytes when writer opens them
+    and when they grow twice as big.
+
+    Records pushed by writer thread itself (e.g. errors reported by File while writing) are only queued,
+    writer never waits for its own records.
+*/
+class LoggerFileWriter final
+{
+public:
+    LoggerFileWriter();
+    ~LoggerFileWriter();
+
+    /** Queue text for writing to file. If `waitWritten` is true, returns after text is written to disk. */
+    void Push(const FilePath& filepath, Logger::eLogLevel ll, const char8* text, bool waitWritten);
+
+    /** Wait until all records pushed from this thread before the call are written to disk. */
+    void Flush();
+
+    /** Write queued records and cut file to last `size` bytes. */
+    bool CutFile(const FilePath& filepath, uint32 size);
+
+    void SetMaxFileSize(uint32 size);
+
+    /** Cut file to last `size` bytes, file should not be opened by writer. */
+    static bool CutFileTail(const FilePath& filepath, uint32 size);
+
+private:
+    struct Record
+    {
+        std::atomic<Record*> next;
+        FilePath filepath;
+        String text;
+        time_t timestamp = 0;
+        Logger::eLogLevel level = Logger::LEVEL_INFO;
+        bool* written = nullptr; // set by writer for records somebody waits for
+    };
+
+    struct OpenedFile
+    {
+        File* file = nullptr;
+        uint64 size = 0;
+    };
+
+    void StartThread();
+    void Enqueue(Record* record);
+    void PushRecord(Record* record);
+    Record* PopRecord();
+    void WaitWritten(Record* record);
+    bool IsWriterThread() const;
+
+    void Run();
+    void WriteQueuedRecords();
+    OpenedFile* GetFile(const FilePath& filepath);
+    void CloseFile(const FilePath& filepath);
+
+    // Queue: producers exchange `head`, writer thread reads from `tail`
+    std::atomic<Record*> head;
+    Record* tail = nullptr;
+    Record stub;
+
+    std::atomic<bool> wakeUpPosted;
+    Semaphore wakeUp;
+    std::atomic<bool> stopping;
+    std::once_flag threadStarted;
+    Thread* thread = nullptr;
+    std::atomic<uint64> writerThreadId;
+
+    Mutex fileMutex; // guards files
+    UnorderedMap<String, OpenedFile> files;
+    std::atomic<uint32> maxFileSize;
+
+    Mutex writtenMutex;
+    ConditionVariable writtenCondition;
+};
+}
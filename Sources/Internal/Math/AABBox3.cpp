@@ -10,6 +10,22 @@ void AABBox3::GetTransformedBox(const Matrix4& transform, AABBox3& result) const
         return;
     }
 
+#if defined(__DAVAENGINE_SSE__)
+    // Same algorithm as scalar code below, all three axes at once:
+    // min(a, b) and max(b, a) select the same operand as `a < b` comparison does.
+    __m128 resMin = _mm_loadu_ps(transform.data + 12);
+    __m128 resMax = resMin;
+    for (int32 j = 0; j < 3; ++j)
+    {
+        const __m128 row = _mm_loadu_ps(transform.data + j * 4);
+        const __m128 a = _mm_mul_ps(row, _mm_set1_ps(min.data[j]));
+        const __m128 b = _mm_mul_ps(row, _mm_set1_ps(max.data[j]));
+        resMin = _mm_add_ps(resMin, _mm_min_ps(a, b));
+        resMax = _mm_add_ps(resMax, _mm_max_ps(b, a));
+    }
+    SSE_StoreVector3(result.min.data, resMin);
+    SSE_StoreVector3(result.max.data, resMax);
+#else
     result.min.x = transform.data[12];
     result.min.y = transform.data[13];
     result.min.z = transform.data[14];
@@ -37,6 +53,7 @@ void AABBox3::GetTransformedBox(const Matrix4& transform, AABBox3& result) const
             }
         };
     }
+#endif
 }
 
 void AABBox3::GetCorners(Vector3* cornersArray) const
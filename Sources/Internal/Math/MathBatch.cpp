@@ -0,0 +1,55 @@
+#include "Math/MathBatch.h"
+
+namespace DAVA
+{
+void MathBatch::TransformPoints(const Vector3* points, uint32 count, const Matrix4& transform, Vector3* result)
+{
+#if defined(__DAVAENGINE_SSE__)
+    const __m128 row0 = _mm_loadu_ps(transform.data);
+    const __m128 row1 = _mm_loadu_ps(transform.data + 4);
+    const __m128 row2 = _mm_loadu_ps(transform.data + 8);
+    const __m128 row3 = _mm_loadu_ps(transform.data + 12);
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        const Vector3& p = points[i];
+        __m128 res = _mm_mul_ps(_mm_set1_ps(p.x), row0);
+        res = _mm_add_ps(res, _mm_mul_ps(_mm_set1_ps(p.y), row1));
+        res = _mm_add_ps(res, _mm_mul_ps(_mm_set1_ps(p.z), row2));
+        res = _mm_add_ps(res, row3);
+        SSE_StoreVector3(result[i].data, res);
+    }
+#else
+    for (uint32 i = 0; i < count; ++i)
+    {
+        result[i] = points[i] * transform;
+    }
+#endif
+}
+
+void MathBatch::TransformPoints(const Vector2* points, uint32 count, const Matrix3& transform, Vector2* result)
+{
+    uint32 i = 0;
+#if defined(__DAVAENGINE_SSE__)
+    // Two points per register: (x0, y0, x1, y1)
+    const __m128 row0 = _mm_setr_ps(transform._00, transform._01, transform._00, transform._01);
+    const __m128 row1 = _mm_setr_ps(transform._10, transform._11, transform._10, transform._11);
+    const __m128 row2 = _mm_setr_ps(transform._20, transform._21, transform._20, transform._21);
+
+    for (; i + 1 < count; i += 2)
+    {
+        const __m128 p = _mm_loadu_ps(points[i].data);
+        const __m128 x = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 0, 0));
+        const __m128 y = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 1));
+        __m128 res = _mm_add_ps(_mm_mul_ps(x, row0), _mm_mul_ps(y, row1));
+        res = _mm_add_ps(res, row2);
+        _mm_storeu_ps(result[i].data, res);
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        result[i] = points[i] * transform;
+    }
+}
+
+} // namespace DAVA
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Math/Vector.h"
+#include "Math/Matrix3.h"
+#include "Math/Matrix4.h"
+
+namespace DAVA
+{
+/**
+    \brief Functions which process arrays of math objects in one call.
+
+    Results are equal to results of per-element operations (`point * transform`), but loops are
+    vectorized with SSE where it is available and transform data is loaded once per call.
+    Result arrays can be the same as source arrays.
+*/
+class MathBatch final
+{
+public:
+    /** Transform `count` points by one matrix: result[i] = points[i] * transform */
+    static void TransformPoints(const Vector3* points, uint32 count, const Matrix4& transform, Vector3* result);
+
+    /** Transform `count` 2D points by one matrix: result[i] = points[i] * transform */
+    static void TransformPoints(const Vector2* points, uint32 count, const Matrix3& transform, Vector2* result);
+};
+
+} // namespace DAVA
@@ -91,6 +91,16 @@ bool RectPacker::AddRect(const Size2i& imageSize, void* searchPtr)
     return (node != 0);
 }
 
+bool RectPacker::AddRect(const Size2i& imageSize, Rect2i& resultRect)
+{
+    PackNode* node = root->Insert(imageSize);
+    if (node)
+    {
+        resultRect = node->rect;
+    }
+    return (node != 0);
+}
+
 Rect2i* RectPacker::SearchRectForPtr(void* searchPtr)
 {
     return root->SearchRectForPtr(searchPtr);
@@ -23,6 +23,12 @@ public:
     //! \param[in] rectSize image size of rect we want to pack
     //! \return true if rect was successfully added, false if not
     bool AddRect(const Size2i& rectSize, void* searchPtr);
+
+    //! \brief Add rect to packer and get allocated position without search
+    //! \param[in] rectSize image size of rect we want to pack
+    //! \param[out] resultRect allocated rect
+    //! \return true if rect was successfully added, false if not
+    bool AddRect(const Size2i& rectSize, Rect2i& resultRect);
     Rect2i* SearchRectForPtr(void* searchPtr);
 
     Rect2i& GetRect()
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+// SSE backend is enabled for every x86 target which compiler generates SSE code for.
+// Define __DAVAENGINE_DISABLE_SSE_MATH__ to build math with scalar code only (e.g. to compare results).
+#if !defined(__DAVAENGINE_DISABLE_SSE_MATH__) && (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1)))
+#define __DAVAENGINE_SSE__
+#endif
+
+#if defined(__DAVAENGINE_SSE__)
+
+#include <xmmintrin.h>
+
+// Matrices are row-major and vectors are rows (see Matrix4).
+// Operations are done in the same order as scalar code, so results are bitwise equal to it.
+
+namespace DAVA
+{
+// Multiplies two 4x4 matrices (a, b) outputing a 4x4 matrix (output), output can point to a or b
+inline void SSE_Matrix4Mul(const float32* a, const float32* b, float32* output)
+{
+    const __m128 b0 = _mm_loadu_ps(b);
+    const __m128 b1 = _mm_loadu_ps(b + 4);
+    const __m128 b2 = _mm_loadu_ps(b + 8);
+    const __m128 b3 = _mm_loadu_ps(b + 12);
+
+    for (int32 i = 0; i < 16; i += 4)
+    {
+        __m128 row = _mm_mul_ps(_mm_set1_ps(a[i]), b0);
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i + 1]), b1));
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i + 2]), b2));
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a[i + 3]), b3));
+        _mm_storeu_ps(output + i, row);
+    }
+}
+
+// Multiplies a vector 4 (v) with a 4x4 matrix (m), outputing a vector 4
+inline void SSE_Vector4Matrix4Mul(const float32* v, const float32* m, float32* output)
+{
+    __m128 res = _mm_mul_ps(_mm_set1_ps(v[0]), _mm_loadu_ps(m));
+    res = _mm_add_ps(res, _mm_mul_ps(_mm_set1_ps(v[1]), _mm_loadu_ps(m + 4)));
+    res = _mm_add_ps(res, _mm_mul_ps(_mm_set1_ps(v[2]), _mm_loadu_ps(m + 8)));
+    res = _mm_add_ps(res, _mm_mul_ps(_mm_set1_ps(v[3]), _mm_loadu_ps(m + 12)));
+    _mm_storeu_ps(output, res);
+}
+
+// Stores x, y, z components of vector to 3 floats
+inline void SSE_StoreVector3(float32* output, __m128 v)
+{
+    _mm_store_ss(output, v);
+    _mm_store_ss(output + 1, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+    _mm_store_ss(output + 2, _mm_movehl_ps(v, v));
+}
+}
+
+#endif // __DAVAENGINE_SSE__
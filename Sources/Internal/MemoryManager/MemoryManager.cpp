@@ -162,6 +162,14 @@ void MemoryManager::EnableLightWeightMode()
     lightWeightMode = true;
 }
 
+void MemoryManager::SetBacktraceSampling(uint32 interval, uint32 sizeThreshold)
+{
+    DVASSERT(interval > 0);
+
+    bktraceSampleInterval = interval;
+    bktraceSizeThreshold = sizeThreshold;
+}
+
 void MemoryManager::SetCallbacks(Function<void()> updateCallback_, Function<void(uint32, bool)> tagCallback_)
 {
     updateCallback = updateCallback_;
@@ -170,6 +178,8 @@ void MemoryManager::SetCallbacks(Function<void()> updateCallback_, Function<void
 
 void MemoryManager::Update()
 {
+    MergeThreadStatCaches();
+
     if (nullptr == symbolCollectorThread)
     {
         symbolCollectorThread = Thread::Create(MakeFunction(this, &MemoryManager::SymbolCollectorThread));
@@ -227,18 +237,8 @@ DAVA_NOINLINE void* MemoryManager::Allocate(size_t size, uint32 poolIndex)
             }
         }
 
-        {
-            LockType lock(allocMutex);
-            block->tags = statGeneral.activeTags;
-            block->orderNo = statGeneral.nextBlockNo++;
-            InsertBlock(block);
-        }
-        {
-            uint32 systemMemoryUsage = GetSystemMemoryUsage();
-            LockType lock(statMutex);
-            UpdateStatAfterAlloc(block, systemMemoryUsage);
-        }
-        if (!lightWeightMode)
+        TrackBlock(block);
+        if (!lightWeightMode && ShouldCollectBacktrace(GetThreadStatCache(), size))
         {
             Backtrace backtrace;
             CollectBacktrace(&backtrace, 1);
@@ -296,18 +296,8 @@ DAVA_NOINLINE void* MemoryManager::AlignedAllocate(size_t size, size_t align, ui
             }
         }
 
-        {
-            LockType lock(allocMutex);
-            block->tags = statGeneral.activeTags;
-            block->orderNo = statGeneral.nextBlockNo++;
-            InsertBlock(block);
-        }
-        {
-            uint32 systemMemoryUsage = GetSystemMemoryUsage();
-            LockType lock(statMutex);
-            UpdateStatAfterAlloc(block, systemMemoryUsage);
-        }
-        if (!lightWeightMode)
+        TrackBlock(block);
+        if (!lightWeightMode && ShouldCollectBacktrace(GetThreadStatCache(), size))
         {
             Backtrace backtrace;
             CollectBacktrace(&backtrace, 1);
@@ -425,17 +415,9 @@ void MemoryManager::Deallocate(void* ptr)
         bool isAccessible = IsMemoryAddressAccessible(block);
         if (isAccessible && BLOCK_MARK == block->mark)
         {
-            {
-                LockType lock(allocMutex);
-                RemoveBlock(block);
-            }
-            {
-                uint32 systemMemoryUsage = GetSystemMemoryUsage();
-                LockType lock(statMutex);
-                UpdateStatAfterDealloc(block, systemMemoryUsage);
-            }
-            if (!lightWeightMode)
-            {
+            UntrackBlock(block);
+            if (block->bktraceHash != 0)
+            { // Block can have no backtrace due to backtrace sampling or lightweight mode
                 LockType lock(bktraceMutex);
                 RemoveBacktrace(block->bktraceHash);
             }
@@ -547,8 +529,7 @@ uint32 MemoryManager::GetTrackedMemoryUsage(uint32 poolIndex) const
 {
     assert(ALLOC_POOL_TOTAL <= poolIndex && poolIndex < MAX_ALLOC_POOL_COUNT);
 
-    LockType lock(statMutex);
-    return statAllocPool[poolIndex].allocByApp;
+    return poolUsage[poolIndex].load(std::memory_order_relaxed);
 }
 
 uint32 MemoryManager::GetTaggedMemoryUsage(uint32 tagIndex) const
@@ -559,8 +540,7 @@ uint32 MemoryManager::GetTaggedMemoryUsage(uint32 tagIndex) const
 
     DVASSERT(index < MAX_TAG_COUNT);
 
-    LockType lock(statMutex);
-    return statTag[index].allocByApp;
+    return tagUsage[index].load(std::memory_order_relaxed);
 }
 
 void MemoryManager::EnterTagScope(uint32 tag)
@@ -569,9 +549,10 @@ void MemoryManager::EnterTagScope(uint32 tag)
     DVASSERT((statGeneral.activeTags & tag) == 0); // Tag shouldn't be set earlier
 
     {
-        LockType lock(allocMutex);
+        LockType lock(statMutex);
         statGeneral.activeTags |= tag;
         statGeneral.activeTagCount += 1;
+        activeTags = statGeneral.activeTags;
     }
     if (tagCallback != nullptr)
     {
@@ -585,9 +566,10 @@ void MemoryManager::LeaveTagScope(uint32 tag)
     DVASSERT((statGeneral.activeTags & tag) == tag); // Tag should be set earlier
 
     {
-        LockType lock(allocMutex);
+        LockType lock(statMutex);
         statGeneral.activeTags &= ~tag;
         statGeneral.activeTagCount -= 1;
+        activeTags = statGeneral.activeTags;
     }
     if (tagCallback != nullptr)
     {
@@ -661,118 +643,282 @@ void MemoryManager::TrackGpuDealloc(uint32 id, uint32 gpuPoolIndex)
     gpuBlockMap->erase(iter);
 }
 
-void MemoryManager::InsertBlock(MemoryBlock* block)
+void MemoryManager::TrackBlock(MemoryBlock* block)
+{
+    block->tags = activeTags;
+    block->orderNo = nextBlockNo++;
+
+    BlockShard& shard = GetBlockShard(block);
+    {
+        LockType lock(shard.mutex);
+        InsertBlock(shard, block);
+    }
+
+    UpdateUsage(block, block->allocByApp);
+
+    ThreadStatCache* cache = GetThreadStatCache();
+    if (cache != nullptr)
+    {
+        LockType lock(cache->mutex);
+        UpdateStatAfterAlloc(block, cache->statAllocPool, cache->statTag);
+    }
+    else
+    {
+        LockType lock(statMutex);
+        UpdateStatAfterAlloc(block, statAllocPool, statTag);
+    }
+}
+
+void MemoryManager::UntrackBlock(MemoryBlock* block)
+{
+    BlockShard& shard = GetBlockShard(block);
+    {
+        LockType lock(shard.mutex);
+        RemoveBlock(shard, block);
+    }
+
+    UpdateUsage(block, 0 - block->allocByApp);
+
+    // Block can be freed by thread other than allocating one, so deltas in cache can go 'negative'
+    ThreadStatCache* cache = GetThreadStatCache();
+    if (cache != nullptr)
+    {
+        LockType lock(cache->mutex);
+        UpdateStatAfterDealloc(block, cache->statAllocPool, cache->statTag);
+    }
+    else
+    {
+        LockType lock(statMutex);
+        UpdateStatAfterDealloc(block, statAllocPool, statTag);
+    }
+}
+
+MemoryManager::BlockShard& MemoryManager::GetBlockShard(MemoryBlock* block)
 {
-    if (head != nullptr)
+    // Blocks are at least BLOCK_ALIGN aligned so skip low bits, mix in higher bits as
+    // allocators tend to place consecutive blocks within the same page
+    uintptr_t addr = reinterpret_cast<uintptr_t>(block) >> 4;
+    addr ^= addr >> 8;
+    return blockShards[addr & (BLOCK_SHARD_COUNT - 1)];
+}
+
+void MemoryManager::InsertBlock(BlockShard& shard, MemoryBlock* block)
+{
+    if (shard.head != nullptr)
     {
-        block->next = head;
+        block->next = shard.head;
         block->prev = nullptr;
-        head->prev = block;
-        head = block;
+        shard.head->prev = block;
+        shard.head = block;
     }
     else
     {
         block->next = nullptr;
         block->prev = nullptr;
-        head = block;
+        shard.head = block;
     }
 }
 
-void MemoryManager::RemoveBlock(MemoryBlock* block)
+void MemoryManager::RemoveBlock(BlockShard& shard, MemoryBlock* block)
 {
     if (block->prev != nullptr)
         block->prev->next = block->next;
     if (block->next != nullptr)
         block->next->prev = block->prev;
-    if (block == head)
-        head = head->next;
+    if (block == shard.head)
+        shard.head = shard.head->next;
+}
+
+MemoryManager::ThreadStatCache* MemoryManager::GetThreadStatCache()
+{
+    if (!tlsStatCache.IsCreated())
+        return nullptr;
+
+    ThreadStatCache* cache = tlsStatCache.Get();
+    if (nullptr == cache)
+    {
+        // Caches are never returned as there is no notification on thread exit, so when all caches
+        // are handed out new threads fall back to updating global statistics under statMutex
+        uint32 index = threadStatCacheCount++;
+        if (index < MAX_THREAD_CACHE_COUNT)
+        {
+            cache = &threadStatCaches[index];
+            tlsStatCache.Reset(cache);
+        }
+    }
+    return cache;
+}
+
+bool MemoryManager::ShouldCollectBacktrace(ThreadStatCache* cache, size_t size)
+{
+    const uint32 threshold = bktraceSizeThreshold;
+    if (threshold != 0 && size >= threshold)
+        return true;
+
+    const uint32 interval = bktraceSampleInterval;
+    if (1 == interval)
+        return true;
+
+    // Counter is accessed only by owning thread so there is no need to lock
+    uint32 counter = cache != nullptr ? cache->bktraceCounter++ : sharedBktraceCounter++;
+    return 0 == counter % interval;
+}
+
+void MemoryManager::MergeThreadStatCaches()
+{
+    const uint32 systemMemoryUsage = GetSystemMemoryUsage();
+    const uint32 cacheCount = std::min(threadStatCacheCount.load(), MAX_THREAD_CACHE_COUNT);
+
+    LockType lock(statMutex);
+    for (uint32 i = 0; i < cacheCount; ++i)
+    {
+        ThreadStatCache& cache = threadStatCaches[i];
+
+        LockType cacheLock(cache.mutex);
+        AddStat(statAllocPool, statTag, cache.statAllocPool, cache.statTag);
+        Memset(cache.statAllocPool, 0, sizeof(cache.statAllocPool));
+        Memset(cache.statTag, 0, sizeof(cache.statTag));
+    }
+
+    // Memory usage reported by system is queried here instead of on each allocation as it can be expensive
+    statAllocPool[ALLOC_POOL_SYSTEM].allocByApp = systemMemoryUsage;
+    statAllocPool[ALLOC_POOL_SYSTEM].allocTotal = systemMemoryUsage;
+    poolUsage[ALLOC_POOL_SYSTEM].store(systemMemoryUsage, std::memory_order_relaxed);
 }
 
-void MemoryManager::UpdateStatAfterAlloc(MemoryBlock* block, uint32 systemMemoryUsage)
+void MemoryManager::CollectStat(AllocPoolStat* pools, TagAllocStat* tags) const
 {
-    { // Update memory usage reported by system
-        statAllocPool[ALLOC_POOL_SYSTEM].allocByApp = systemMemoryUsage;
-        statAllocPool[ALLOC_POOL_SYSTEM].allocTotal = systemMemoryUsage;
+    const uint32 cacheCount = std::min(threadStatCacheCount.load(), MAX_THREAD_CACHE_COUNT);
+
+    LockType lock(statMutex);
+    Memcpy(pools, statAllocPool, sizeof(statAllocPool));
+    Memcpy(tags, statTag, sizeof(statTag));
+    for (uint32 i = 0; i < cacheCount; ++i)
+    {
+        const ThreadStatCache& cache = threadStatCaches[i];
+
+        LockType cacheLock(cache.mutex);
+        AddStat(pools, tags, cache.statAllocPool, cache.statTag);
     }
+}
+
+void MemoryManager::UpdateStatAfterAlloc(MemoryBlock* block, AllocPoolStat* pools, TagAllocStat* tags)
+{
     { // Update total statistics
-        statAllocPool[ALLOC_POOL_TOTAL].allocByApp += block->allocByApp;
-        statAllocPool[ALLOC_POOL_TOTAL].allocTotal += block->allocTotal;
-        statAllocPool[ALLOC_POOL_TOTAL].blockCount += 1;
+        pools[ALLOC_POOL_TOTAL].allocByApp += block->allocByApp;
+        pools[ALLOC_POOL_TOTAL].allocTotal += block->allocTotal;
+        pools[ALLOC_POOL_TOTAL].blockCount += 1;
 
-        if (block->allocByApp > statAllocPool[ALLOC_POOL_TOTAL].maxBlockSize)
-            statAllocPool[ALLOC_POOL_TOTAL].maxBlockSize = block->allocByApp;
+        if (block->allocByApp > pools[ALLOC_POOL_TOTAL].maxBlockSize)
+            pools[ALLOC_POOL_TOTAL].maxBlockSize = block->allocByApp;
     }
     { // Update pool statistics
         const uint32 poolIndex = block->pool;
-        statAllocPool[poolIndex].allocByApp += block->allocByApp;
-        statAllocPool[poolIndex].allocTotal += block->allocTotal;
-        statAllocPool[poolIndex].blockCount += 1;
+        pools[poolIndex].allocByApp += block->allocByApp;
+        pools[poolIndex].allocTotal += block->allocTotal;
+        pools[poolIndex].blockCount += 1;
 
-        if (block->allocByApp > statAllocPool[poolIndex].maxBlockSize)
-            statAllocPool[poolIndex].maxBlockSize = block->allocByApp;
+        if (block->allocByApp > pools[poolIndex].maxBlockSize)
+            pools[poolIndex].maxBlockSize = block->allocByApp;
     }
 
     { // Update tag statistics
-        uint32 tags = statGeneral.activeTags;
-        if (tags != 0)
+        uint32 blockTags = block->tags;
+        if (blockTags != 0)
         {
-            for (size_t index = 0; tags != 0; ++index, tags >>= 1)
+            for (size_t index = 0; blockTags != 0; ++index, blockTags >>= 1)
             {
-                if (tags & 0x01)
+                if (blockTags & 0x01)
                 {
-                    statTag[index].allocByApp += block->allocByApp;
-                    statTag[index].blockCount += 1;
+                    tags[index].allocByApp += block->allocByApp;
+                    tags[index].blockCount += 1;
                 }
             }
         }
         else
         {
-            statTag[UNTAGGED].allocByApp += block->allocByApp;
-            statTag[UNTAGGED].blockCount += 1;
+            tags[UNTAGGED].allocByApp += block->allocByApp;
+            tags[UNTAGGED].blockCount += 1;
         }
     }
 }
 
-void MemoryManager::UpdateStatAfterDealloc(MemoryBlock* block, uint32 systemMemoryUsage)
+void MemoryManager::UpdateStatAfterDealloc(MemoryBlock* block, AllocPoolStat* pools, TagAllocStat* tags)
 {
-    { // Update memory usage reported by system
-        statAllocPool[ALLOC_POOL_SYSTEM].allocByApp = systemMemoryUsage;
-        statAllocPool[ALLOC_POOL_SYSTEM].allocTotal = systemMemoryUsage;
-    }
     { // Update total statistics
-        statAllocPool[ALLOC_POOL_TOTAL].allocByApp -= block->allocByApp;
-        statAllocPool[ALLOC_POOL_TOTAL].allocTotal -= block->allocTotal;
-        statAllocPool[ALLOC_POOL_TOTAL].blockCount -= 1;
+        pools[ALLOC_POOL_TOTAL].allocByApp -= block->allocByApp;
+        pools[ALLOC_POOL_TOTAL].allocTotal -= block->allocTotal;
+        pools[ALLOC_POOL_TOTAL].blockCount -= 1;
     }
     { // Update pool statistics
         const uint32 poolIndex = block->pool;
-        statAllocPool[poolIndex].allocByApp -= block->allocByApp;
-        statAllocPool[poolIndex].allocTotal -= block->allocTotal;
-        statAllocPool[poolIndex].blockCount -= 1;
+        pools[poolIndex].allocByApp -= block->allocByApp;
+        pools[poolIndex].allocTotal -= block->allocTotal;
+        pools[poolIndex].blockCount -= 1;
     }
     { // Update tag statistics
-        uint32 tags = block->tags;
-        if (tags != 0)
+        uint32 blockTags = block->tags;
+        if (blockTags != 0)
         {
-            for (size_t index = 0; tags != 0; ++index, tags >>= 1)
+            for (size_t index = 0; blockTags != 0; ++index, blockTags >>= 1)
             {
-                if (tags & 0x01)
+                if (blockTags & 0x01)
                 {
-                    statTag[index].allocByApp -= block->allocByApp;
-                    statTag[index].blockCount -= 1;
+                    tags[index].allocByApp -= block->allocByApp;
+                    tags[index].blockCount -= 1;
                 }
             }
         }
         else
         {
-            statTag[UNTAGGED].allocByApp -= block->allocByApp;
-            statTag[UNTAGGED].blockCount -= 1;
+            tags[UNTAGGED].allocByApp -= block->allocByApp;
+            tags[UNTAGGED].blockCount -= 1;
+        }
+    }
+}
+
+void MemoryManager::AddStat(AllocPoolStat* dstPools, TagAllocStat* dstTags, const AllocPoolStat* srcPools, const TagAllocStat* srcTags)
+{
+    for (uint32 i = 0; i < MAX_ALLOC_POOL_COUNT; ++i)
+    {
+        dstPools[i].allocByApp += srcPools[i].allocByApp;
+        dstPools[i].allocTotal += srcPools[i].allocTotal;
+        dstPools[i].blockCount += srcPools[i].blockCount;
+        dstPools[i].maxBlockSize = std::max(dstPools[i].maxBlockSize, srcPools[i].maxBlockSize);
+    }
+    for (uint32 i = 0; i < MAX_TAG_COUNT; ++i)
+    {
+        dstTags[i].allocByApp += srcTags[i].allocByApp;
+        dstTags[i].blockCount += srcTags[i].blockCount;
+    }
+}
+
+void MemoryManager::UpdateUsage(MemoryBlock* block, uint32 delta)
+{
+    // Deallocation passes negated size, counters rely on modular arithmetic
+    poolUsage[ALLOC_POOL_TOTAL].fetch_add(delta, std::memory_order_relaxed);
+    poolUsage[block->pool].fetch_add(delta, std::memory_order_relaxed);
+
+    uint32 blockTags = block->tags;
+    if (blockTags != 0)
+    {
+        for (size_t index = 0; blockTags != 0; ++index, blockTags >>= 1)
+        {
+            if (blockTags & 0x01)
+                tagUsage[index].fetch_add(delta, std::memory_order_relaxed);
         }
     }
+    else
+    {
+        tagUsage[UNTAGGED].fetch_add(delta, std::memory_order_relaxed);
+    }
 }
 
 void MemoryManager::UpdateStatAfterGPUAlloc(MemoryBlock* block, size_t sizeIncr)
 {
+    poolUsage[ALLOC_POOL_TOTAL].fetch_add(static_cast<uint32>(sizeIncr), std::memory_order_relaxed);
+    poolUsage[block->pool].fetch_add(static_cast<uint32>(sizeIncr), std::memory_order_relaxed);
+
     { // Update total statistics
         statAllocPool[ALLOC_POOL_TOTAL].allocByApp += static_cast<uint32>(sizeIncr);
         statAllocPool[ALLOC_POOL_TOTAL].allocTotal += static_cast<uint32>(sizeIncr);
@@ -789,6 +935,9 @@ void MemoryManager::UpdateStatAfterGPUAlloc(MemoryBlock* block, size_t sizeIncr)
 
 void MemoryManager::UpdateStatAfterGPUDealloc(MemoryBlock* block)
 {
+    poolUsage[ALLOC_POOL_TOTAL].fetch_sub(block->allocByApp, std::memory_order_relaxed);
+    poolUsage[block->pool].fetch_sub(block->allocByApp, std::memory_order_relaxed);
+
     { // Update total statistics
         statAllocPool[ALLOC_POOL_TOTAL].allocByApp -= block->allocByApp;
         statAllocPool[ALLOC_POOL_TOTAL].allocTotal -= block->allocTotal;
@@ -942,26 +1091,31 @@ void MemoryManager::GetCurStat(uint64 timestamp, void* buffer, uint32 bufSize) c
     const uint32 requiredSize = CalcCurStatSize();
     DVASSERT(requiredSize <= bufSize);
 
-    LockType lockAlloc(allocMutex);
-    LockType lockStat(statMutex);
+    AllocPoolStat curPools[MAX_ALLOC_POOL_COUNT];
+    TagAllocStat curTags[MAX_TAG_COUNT];
+    CollectStat(curPools, curTags);
 
     MMCurStat* curStat = static_cast<MMCurStat*>(buffer);
     curStat->timestamp = timestamp;
     curStat->size = static_cast<uint32>(requiredSize);
-    curStat->statGeneral = statGeneral;
+    {
+        LockType lock(statMutex);
+        curStat->statGeneral = statGeneral;
+    }
+    curStat->statGeneral.nextBlockNo = nextBlockNo;
 
     AllocPoolStat* pools = OffsetPointer<AllocPoolStat>(curStat, sizeof(MMCurStat));
     for (uint32 i = 0; i < registeredAllocPoolCount; ++i)
     {
-        pools[i] = statAllocPool[i];
+        pools[i] = curPools[i];
     }
 
     TagAllocStat* tags = OffsetPointer<TagAllocStat>(pools, sizeof(AllocPoolStat) * registeredAllocPoolCount);
     for (uint32 i = 0; i < registeredTagCount; ++i)
     {
-        tags[i] = statTag[i];
+        tags[i] = curTags[i];
     }
-    tags[registeredTagCount] = statTag[UNTAGGED];
+    tags[registeredTagCount] = curTags[UNTAGGED];
 }
 
 bool MemoryManager::GetMemorySnapshot(uint64 timestamp, File* file, uint32* snapshotSize)
@@ -989,17 +1143,19 @@ bool MemoryManager::GetMemorySnapshot(uint64 timestamp, File* file, uint32* snap
     snapshot.bktraceDepth = BACKTRACE_DEPTH;
 
     // Write empty header to force file internal buffer allocation to exclude
-    // memory allocations under allocMutex (primarily for Win32 release builds)
+    // memory allocations under block shard locks (primarily for Win32 release builds)
     if (file->Write(&snapshot) != sizeof(MMSnapshot))
         return false;
 
-    { // Store memory blocks into file
-        LockType lock(allocMutex);
+    // Store memory blocks into file
+    for (BlockShard& shard : blockShards)
+    {
+        LockType lock(shard.mutex);
 
         const uint32 BLOCKS_IN_BUF = BUF_SIZE / sizeof(MMBlock);
         MMBlock* destBegin = static_cast<MMBlock*>(buffer);
 
-        MemoryBlock* curBlock = head;
+        MemoryBlock* curBlock = shard.head;
         while (curBlock != nullptr)
         {
             uint32 k = 0;
@@ -6,6 +6,7 @@
 #if defined(DAVA_MEMORY_PROFILING_ENABLE)
 
 #include <type_traits>
+#include <atomic>
 
 #include "Functional/Function.h"
 #include "Concurrency/Spinlock.h"
@@ -34,6 +35,8 @@ class MemoryManager final
     static const uint32 DEAD_BLOCK_MARK = 0xECECECEC;
     static const size_t BLOCK_ALIGN = 16;
     static const uint32 BACKTRACE_DEPTH = 32;
+    static const uint32 BLOCK_SHARD_COUNT = 64; // Must be power of 2
+    static const uint32 MAX_THREAD_CACHE_COUNT = 64;
 
 public:
     static const uint32 MAX_ALLOC_POOL_COUNT = 32;
@@ -70,6 +73,7 @@ public:
     static void RegisterTagName(uint32 tagMask, const char8* name);
 
     void EnableLightWeightMode();
+    void SetBacktraceSampling(uint32 interval, uint32 sizeThreshold);
     void SetCallbacks(Function<void()> updateCallback, Function<void(uint32, bool)> tagCallback);
     void Update();
     void Finish();
@@ -121,12 +125,26 @@ private:
     friend void InternalDealloc(void* ptr);
 
 private:
-    void InsertBlock(MemoryBlock* block);
-    void RemoveBlock(MemoryBlock* block);
+    struct BlockShard;
+    struct ThreadStatCache;
 
-    void UpdateStatAfterAlloc(MemoryBlock* block, uint32 systemMemoryUsage);
-    void UpdateStatAfterDealloc(MemoryBlock* block, uint32 systemMemoryUsage);
+    void TrackBlock(MemoryBlock* block);
+    void UntrackBlock(MemoryBlock* block);
 
+    BlockShard& GetBlockShard(MemoryBlock* block);
+    void InsertBlock(BlockShard& shard, MemoryBlock* block);
+    void RemoveBlock(BlockShard& shard, MemoryBlock* block);
+
+    ThreadStatCache* GetThreadStatCache();
+    bool ShouldCollectBacktrace(ThreadStatCache* cache, size_t size);
+    void MergeThreadStatCaches();
+    void CollectStat(AllocPoolStat* pools, TagAllocStat* tags) const;
+
+    static void UpdateStatAfterAlloc(MemoryBlock* block, AllocPoolStat* pools, TagAllocStat* tags);
+    static void UpdateStatAfterDealloc(MemoryBlock* block, AllocPoolStat* pools, TagAllocStat* tags);
+    static void AddStat(AllocPoolStat* dstPools, TagAllocStat* dstTags, const AllocPoolStat* srcPools, const TagAllocStat* srcTags);
+
+    void UpdateUsage(MemoryBlock* block, uint32 delta);
     void UpdateStatAfterGPUAlloc(MemoryBlock* block, size_t sizeIncr);
     void UpdateStatAfterGPUDealloc(MemoryBlock* block);
 
@@ -141,16 +159,49 @@ private:
     void SymbolCollectorThread();
 
 private:
-    MemoryBlock* head = nullptr; // Linked list of tracked memory blocks
+    using MutexType = Spinlock;
+    using LockType = LockGuard<MutexType>;
+
+    // Tracked memory blocks are distributed among shards by block address, each shard has its own
+    // linked list and lock, so threads allocating concurrently rarely contend for the same lock
+    struct BlockShard
+    {
+        MutexType mutex;
+        MemoryBlock* head = nullptr;
+    };
+
+    // Per-thread statistics deltas: allocating thread updates its own cache under uncontended lock,
+    // deltas are folded into global statistics in Update() and taken into account when statistics are queried.
+    // Deltas are stored as unsigned values and rely on modular arithmetic, so temporary 'negative' values are ok
+    struct ThreadStatCache
+    {
+        mutable MutexType mutex;
+        uint32 bktraceCounter = 0; // Counter for backtrace sampling
+        AllocPoolStat statAllocPool[MAX_ALLOC_POOL_COUNT];
+        TagAllocStat statTag[MAX_TAG_COUNT];
+    };
+
+    BlockShard blockShards[BLOCK_SHARD_COUNT];
 
     GeneralAllocStat statGeneral; // General statistics
     AllocPoolStat statAllocPool[MAX_ALLOC_POOL_COUNT]; // Statistics by allocation pools
     TagAllocStat statTag[MAX_TAG_COUNT]; // Statistics by tags
 
-    using MutexType = Spinlock;
-    using LockType = LockGuard<MutexType>;
+    std::atomic<uint32> nextBlockNo{ 0 }; // Order number which will be assigned to next allocated memory block
+    std::atomic<uint32> activeTags{ 0 }; // Copy of statGeneral.activeTags for lock-free reading on allocation
+
+    // Memory allocated by application in every pool and tag, updated on each allocation so that
+    // GetTrackedMemoryUsage and GetTaggedMemoryUsage don't collect statistics from thread caches
+    std::atomic<uint32> poolUsage[MAX_ALLOC_POOL_COUNT] = {};
+    std::atomic<uint32> tagUsage[MAX_TAG_COUNT] = {};
+
+    ThreadStatCache threadStatCaches[MAX_THREAD_CACHE_COUNT];
+    std::atomic<uint32> threadStatCacheCount{ 0 }; // Number of caches handed out to threads
+    std::atomic<uint32> sharedBktraceCounter{ 0 }; // Backtrace sampling counter for threads without own cache
+
+    std::atomic<uint32> bktraceSampleInterval{ 1 }; // Collect backtrace for every Nth allocation
+    std::atomic<uint32> bktraceSizeThreshold{ 0 }; // Always collect backtrace for allocations not less than threshold, 0 - disabled
 
-    mutable MutexType allocMutex; // Mutex for managing list of allocated memory blocks
     mutable MutexType statMutex; // Mutex for updating memory statistics
     mutable MutexType gpuMutex; // Mutex for managing GPU allocations
 
@@ -185,6 +236,7 @@ private:
     static MMItemName allocPoolNames[MAX_ALLOC_POOL_COUNT]; // Names of allocation pools
 
     ThreadLocalPtr<AllocScopeItem> tlsAllocScopeStack;
+    ThreadLocalPtr<ThreadStatCache> tlsStatCache;
 };
 
 //////////////////////////////////////////////////////////////////////////
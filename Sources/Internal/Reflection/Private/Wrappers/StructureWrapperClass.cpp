@@ -175,4 +175,24 @@ Vector<Reflection::Method> StructureWrapperClass::GetMethods(const ReflectedObje
     return ret;
 }
 
+const ReflectedStructure::Field* StructureWrapperClass::FindField(const ReflectedStructure::Key& name) const
+{
+    auto it = fieldsNameIndexes.find(name);
+    if (it != fieldsNameIndexes.end())
+    {
+        return fieldsCache[it->second].field;
+    }
+    return nullptr;
+}
+
+const ReflectedStructure::Method* StructureWrapperClass::FindMethod(const ReflectedStructure::Key& name) const
+{
+    auto it = methodsNameIndexes.find(name);
+    if (it != methodsNameIndexes.end())
+    {
+        return methodsCache[it->second].method;
+    }
+    return nullptr;
+}
+
 } //namespace DAVA
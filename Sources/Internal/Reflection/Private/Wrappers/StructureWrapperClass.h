@@ -29,6 +29,10 @@ public:
     AnyFn GetMethod(const ReflectedObject& object, const ValueWrapper* vw, const Any& key) const override;
     Vector<Reflection::Method> GetMethods(const ReflectedObject& object, const ValueWrapper* vw) const override;
 
+    /** Find field or method by name the same way as GetField/GetMethod do. Return nullptr if nothing found. */
+    const ReflectedStructure::Field* FindField(const ReflectedStructure::Key& name) const;
+    const ReflectedStructure::Method* FindMethod(const ReflectedStructure::Key& name) const;
+
 private:
     struct CachedFieldEntry
     {
@@ -8,6 +8,7 @@
 #include "FileSystem/YamlParser.h"
 #include "Logger/Logger.h"
 #include "Render/2D/FontManager.h"
+#include "Render/2D/Private/FTGlyphAtlas.h"
 #include "Render/2D/Private/FTManager.h"
 #include "Render/2D/Systems/VirtualCoordinatesSystem.h"
 #include "Render/Renderer.h"
@@ -39,7 +40,8 @@ public:
                                    int32 justifyWidth, int32 spaceAddon,
                                    float32 ascendScale, float32 descendScale,
                                    Vector<float32>* charSizes = NULL,
-                                   bool contentScaleIncluded = false);
+                                   bool contentScaleIncluded = false,
+                                   Vector<FTFont::GlyphQuad>* quads = nullptr);
     uint32 GetFontHeight(float32 size, float32 ascendScale, float32 descendScale);
     bool IsCharAvaliable(char16 ch);
 
@@ -48,6 +50,7 @@ public:
 
 private:
     FTManager* ftm = nullptr;
+    FTGlyphAtlas* glyphAtlas = nullptr;
     FilePath fontPath;
     FT_StreamRec stream;
 
@@ -69,6 +72,7 @@ private:
     void ClearString();
     int32 LoadString(float32 size, const WideString& str);
     void Prepare(FT_Face face, FT_Vector* advances);
+    void AddGlyphQuad(const Glyph& glyph, const FT_Vector& pen, int32 multilineOffsetY, float32 size, Vector<FTFont::GlyphQuad>& quads);
 
     inline int32 FtRound(int32 val);
     inline int32 FtCeil(int32 val);
@@ -186,6 +190,11 @@ Font::StringMetrics FTFont::DrawStringToBuffer(float32 size, void* buffer, int32
     return internalFont->DrawString(str, buffer, bufWidth, bufHeight, 255, 255, 255, 255, size, true, offsetX, offsetY, justifyWidth, spaceAddon, ascendScale, descendScale, NULL, contentScaleIncluded);
 }
 
+Font::StringMetrics FTFont::DrawStringToGlyphs(float32 size, int32 offsetX, int32 offsetY, int32 justifyWidth, int32 spaceAddon, const WideString& str, Vector<GlyphQuad>& quads)
+{
+    return internalFont->DrawString(str, nullptr, 0, 0, 255, 255, 255, 255, size, true, offsetX, offsetY, justifyWidth, spaceAddon, ascendScale, descendScale, NULL, true, &quads);
+}
+
 Font::StringMetrics FTFont::GetStringMetrics(float32 size, const WideString& str, Vector<float32>* charSizes) const
 {
     if (charSizes != nullptr)
@@ -267,6 +276,7 @@ FTInternalFont::FTInternalFont(const FilePath& path)
 {
     ftm = GetEngineContext()->fontManager->GetFT();
     DVASSERT(ftm);
+    glyphAtlas = GetEngineContext()->fontManager->GetGlyphAtlas();
 
     FT_Face face = nullptr;
     FT_Error error = ftm->LookupFace(this, &face);
@@ -277,6 +287,10 @@ FTInternalFont::~FTInternalFont()
 {
     ClearString();
     ftm->RemoveFace(this);
+    if (glyphAtlas != nullptr)
+    {
+        glyphAtlas->RemoveFont(this);
+    }
 }
 
 FT_Error FTInternalFont::OpenFace(FT_Library library, FT_Face* ftface)
@@ -335,7 +349,8 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
                                                int32 justifyWidth, int32 spaceAddon,
                                                float32 ascendScale, float32 descendScale,
                                                Vector<float32>* charSizes,
-                                               bool contentScaleIncluded)
+                                               bool contentScaleIncluded,
+                                               Vector<FTFont::GlyphQuad>* quads)
 {
     if (!initialized)
     {
@@ -349,6 +364,7 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
     drawStringMutex.Lock();
 
     bool drawNondefGlyph = Renderer::GetOptions()->IsOptionEnabled(RenderOptions::DRAW_NONDEF_GLYPH);
+    bool drawToBuffer = realDraw && quads == nullptr;
 
     size = GetEngineContext()->uiControlSystem->vcs->ConvertVirtualToPhysicalY(size); // increase size for high dpi screens
     if (!contentScaleIncluded)
@@ -430,7 +446,7 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
                 if (error == 0)
                 {
                     FT_Glyph_Get_CBox(image, FT_GLYPH_BBOX_PIXELS, &bbox);
-                    if (realDraw)
+                    if (drawToBuffer)
                     {
                         error = FT_Glyph_To_Bitmap(&image, FT_RENDER_MODE_NORMAL, 0, 1);
                     }
@@ -482,7 +498,11 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
                 metrics.drawRect.dy = Max(metrics.drawRect.dy, top + height);
             }
 
-            if (realDraw && bbox.xMin < bufWidth && bbox.yMin < bufHeight)
+            if (quads != nullptr && glyph.index > 0)
+            {
+                AddGlyphQuad(glyph, pen, multilineOffsetY, size, *quads);
+            }
+            else if (drawToBuffer && bbox.xMin < bufWidth && bbox.yMin < bufHeight)
             {
                 FT_BitmapGlyph bit = FT_BitmapGlyph(image);
                 FT_Bitmap* bitmap = &bit->bitmap;
@@ -653,6 +673,52 @@ void FTInternalFont::Prepare(FT_Face face, FT_Vector* advances)
     }
 }
 
+void FTInternalFont::AddGlyphQuad(const Glyph& glyph, const FT_Vector& pen, int32 multilineOffsetY, float32 size, Vector<FTFont::GlyphQuad>& quads)
+{
+    // Glyph images are cached for 4 subpixel positions on each axis,
+    // integer part of pen position just moves cached image
+    FT_Vector phase;
+    phase.x = pen.x & 0x30;
+    phase.y = pen.y & 0x30;
+    const uint64 key = (uint64(size * 64.f) << 32) | (uint64(phase.x | (phase.y >> 2)) << 24) | uint64(glyph.index & 0xFFFFFF);
+
+    FTGlyphAtlas::Glyph atlasGlyph;
+    if (!glyphAtlas->FindGlyph(this, key, atlasGlyph))
+    {
+        FT_Glyph image = nullptr;
+        if (FT_Glyph_Copy(glyph.image, &image) != 0)
+        {
+            return;
+        }
+
+        bool added = false;
+        if (FT_Glyph_Transform(image, nullptr, &phase) == 0 && FT_Glyph_To_Bitmap(&image, FT_RENDER_MODE_NORMAL, 0, 1) == 0)
+        {
+            FT_BitmapGlyph bit = FT_BitmapGlyph(image);
+            const FT_Bitmap& bitmap = bit->bitmap;
+            added = glyphAtlas->AddGlyph(this, key, bitmap.buffer, int32(bitmap.width), int32(bitmap.rows), int32(bitmap.pitch), bit->left, bit->top, atlasGlyph);
+        }
+        FT_Done_Glyph(image);
+
+        if (!added)
+        {
+            return;
+        }
+    }
+
+    if (atlasGlyph.rect.dx > 0 && atlasGlyph.rect.dy > 0)
+    {
+        FTFont::GlyphQuad quad;
+        quad.page = atlasGlyph.page;
+        quad.atlasRect = atlasGlyph.rect;
+        quad.rect.x = int32(pen.x >> ftToPixelShift) + atlasGlyph.left;
+        quad.rect.y = multilineOffsetY - (int32(pen.y >> ftToPixelShift) + atlasGlyph.top);
+        quad.rect.dx = atlasGlyph.rect.dx;
+        quad.rect.dy = atlasGlyph.rect.dy;
+        quads.push_back(quad);
+    }
+}
+
 void FTInternalFont::ClearString()
 {
     glyphs.clear();
@@ -22,6 +22,16 @@ class FTInternalFont;
 class FTFont : public Font
 {
 public:
+    /**
+		\brief Glyph image placed in shared glyph atlas.
+	*/
+    struct GlyphQuad
+    {
+        uint32 page = 0; //!< glyph atlas page
+        Rect2i rect; //!< glyph position in pixels, like in buffer of DrawStringToBuffer
+        Rect2i atlasRect; //!< glyph image in atlas page in pixels
+    };
+
     /**
 		\brief Factory method.
 		\param[in] path - path to freetype-supported file (.ttf, .otf)
@@ -82,6 +92,18 @@ public:
 	*/
     virtual StringMetrics DrawStringToBuffer(float32 size, void* buffer, int32 bufWidth, int32 bufHeight, int32 offsetX, int32 offsetY, int32 justifyWidth, int32 spaceAddon, const WideString& str, bool contentScaleIncluded = false);
 
+    /**
+		\brief Draw string as glyph quads, glyph images are rasterized once to shared glyph atlas
+		\param[in] offsetX - starting X offset
+		\param[in] offsetY - starting Y offset
+		\param[in] justifyWidth - TODO
+		\param[in] spaceAddon - TODO
+		\param[in] str - string to draw
+		\param[out] quads - glyph quads, all values are in physical pixels
+		\returns bounding rect for string in pixels
+	*/
+    StringMetrics DrawStringToGlyphs(float32 size, int32 offsetX, int32 offsetY, int32 justifyWidth, int32 spaceAddon, const WideString& str, Vector<GlyphQuad>& quads);
+
     bool IsTextSupportsSoftwareRendering() const override;
 
     //We need to return font path
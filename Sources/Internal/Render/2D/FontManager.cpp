@@ -3,6 +3,7 @@
 #include "Render/2D/FontManager.h"
 #include "Render/2D/FTFont.h"
 #include "Render/2D/GraphicFont.h"
+#include "Render/2D/Private/FTGlyphAtlas.h"
 #include "Render/2D/Private/FTManager.h"
 #include "Logger/Logger.h"
 #include "Render/2D/Sprite.h"
@@ -125,11 +126,22 @@ struct GraphicFontConfigDescriptor : public FontConfigDescriptor
 
 FontManager::FontManager()
     : ftmanager(std::make_unique<FTManager>())
+    , glyphAtlas(std::make_unique<FTGlyphAtlas>())
 {
+    Engine* engine = Engine::Instance();
+    if (engine != nullptr)
+    {
+        engine->endFrame.Connect(glyphAtlas.get(), &FTGlyphAtlas::EndFrame);
+    }
 }
 
 FontManager::~FontManager()
 {
+    Engine* engine = Engine::Instance();
+    if (engine != nullptr)
+    {
+        engine->endFrame.Disconnect(glyphAtlas.get());
+    }
     FTFont::ClearCache();
     UnregisterFontsPresets();
 }
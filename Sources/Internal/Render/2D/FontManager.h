@@ -9,6 +9,7 @@ namespace DAVA
 {
 class Font;
 class FTManager;
+class FTGlyphAtlas;
 class FilePath;
 
 namespace FontManagerDetails
@@ -30,6 +31,14 @@ public:
         return ftmanager.get();
     }
 
+    /**
+     \brief Get atlas of FreeType glyphs shared by text blocks.
+     */
+    FTGlyphAtlas* GetGlyphAtlas()
+    {
+        return glyphAtlas.get();
+    }
+
     RefPtr<Font> LoadFont(const FilePath& fontPath);
 
     /**
@@ -83,5 +92,6 @@ private:
     UnorderedMap<String, FontPreset> fontPresetMap;
     UnorderedMap<String, std::unique_ptr<FontManagerDetails::FontConfigDescriptor>> fontConfigs;
     std::unique_ptr<FTManager> ftmanager;
+    std::unique_ptr<FTGlyphAtlas> glyphAtlas;
 };
 };
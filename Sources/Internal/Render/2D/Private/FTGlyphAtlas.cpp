@@ -0,0 +1,295 @@
+#include "Render/2D/Private/FTGlyphAtlas.h"
+
+#include "Concurrency/LockGuard.h"
+#include "Debug/DVAssert.h"
+#include "Logger/Logger.h"
+#include "Math/RectPacker.h"
+#include "Render/RHI/rhi_Public.h"
+#include "Render/Renderer.h"
+#include "Render/Texture.h"
+
+namespace DAVA
+{
+namespace FTGlyphAtlasDetails
+{
+// Empty border around each glyph to avoid bleeding of neighbours with linear filtering
+const int32 GLYPH_PADDING = 1;
+}
+
+FTGlyphAtlas::FTGlyphAtlas(uint32 pageSize_, uint32 maxPages_)
+    : pageSize(pageSize_)
+    , maxPages(maxPages_)
+{
+    DVASSERT(maxPages > 0);
+    pages.reserve(maxPages);
+    Renderer::GetSignals().needRestoreResources.Connect(this, &FTGlyphAtlas::Restore);
+}
+
+FTGlyphAtlas::~FTGlyphAtlas()
+{
+    Renderer::GetSignals().needRestoreResources.Disconnect(this);
+    for (Page& page : pages)
+    {
+        SafeRelease(page.texture);
+    }
+}
+
+bool FTGlyphAtlas::FindGlyph(const void* font, uint64 key, Glyph& glyph) const
+{
+    LockGuard<Mutex> lock(mutex);
+
+    auto fontIt = glyphs.find(font);
+    if (fontIt != glyphs.end())
+    {
+        auto glyphIt = fontIt->second.find(key);
+        if (glyphIt != fontIt->second.end())
+        {
+            glyph = glyphIt->second;
+            if (glyph.page < pages.size())
+            {
+                pages[glyph.page].lastUsedFrame = frame;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FTGlyphAtlas::AddGlyph(const void* font, uint64 key, const uint8* image, int32 width, int32 height, int32 pitch, int32 left, int32 top, Glyph& glyph)
+{
+    using namespace FTGlyphAtlasDetails;
+
+    LockGuard<Mutex> lock(mutex);
+
+    glyph = Glyph();
+    glyph.left = left;
+    glyph.top = top;
+
+    if (width > 0 && height > 0)
+    {
+        const Size2i paddedSize(width + 2 * GLYPH_PADDING, height + 2 * GLYPH_PADDING);
+        if (paddedSize.dx > int32(pageSize) || paddedSize.dy > int32(pageSize))
+        {
+            return false;
+        }
+
+        Rect2i packedRect;
+        bool packed = !pages.empty() && pages[currentPage].packer->AddRect(paddedSize, packedRect);
+        for (uint32 i = 0; !packed && i < uint32(pages.size()); ++i)
+        {
+            if (i != currentPage && pages[i].packer->AddRect(paddedSize, packedRect))
+            {
+                currentPage = i;
+                packed = true;
+            }
+        }
+
+        if (!packed)
+        {
+            // Find least recently used page, pages used in this frame are referenced by prepared text
+            uint32 lruPage = uint32(pages.size());
+            for (uint32 i = 0; i < uint32(pages.size()); ++i)
+            {
+                if (pages[i].lastUsedFrame != frame && (lruPage == pages.size() || pages[i].lastUsedFrame < pages[lruPage].lastUsedFrame))
+                {
+                    lruPage = i;
+                }
+            }
+
+            if (pages.size() < maxPages || lruPage == pages.size())
+            {
+                if (pages.size() >= maxPages)
+                {
+                    Logger::FrameworkDebug("[FTGlyphAtlas] all %u pages are used in frame, page is added over limit of %u", uint32(pages.size()), maxPages);
+                }
+                AddPage();
+                currentPage = uint32(pages.size() - 1);
+            }
+            else
+            {
+                Logger::FrameworkDebug("[FTGlyphAtlas] all %u pages are full, page %u is cleared", uint32(pages.size()), lruPage);
+                ResetPage(lruPage);
+                currentPage = lruPage;
+            }
+            packed = pages[currentPage].packer->AddRect(paddedSize, packedRect);
+            DVASSERT(packed);
+        }
+
+        glyph.page = currentPage;
+        glyph.rect = Rect2i(packedRect.x + GLYPH_PADDING, packedRect.y + GLYPH_PADDING, width, height);
+
+        Page& page = pages[currentPage];
+        for (int32 y = 0; y < height; ++y)
+        {
+            const uint8* src = image + y * pitch;
+            uint8* dst = page.image.data() + (glyph.rect.y + y) * pageSize + glyph.rect.x;
+            Memcpy(dst, src, width);
+        }
+        page.dirtyBegin = std::min(page.dirtyBegin, uint32(packedRect.y));
+        page.dirtyEnd = std::max(page.dirtyEnd, uint32(packedRect.y + packedRect.dy));
+        page.lastUsedFrame = frame;
+    }
+
+    glyphs[font][key] = glyph;
+    glyphsCount++;
+    return true;
+}
+
+void FTGlyphAtlas::RemoveFont(const void* font)
+{
+    LockGuard<Mutex> lock(mutex);
+
+    auto fontIt = glyphs.find(font);
+    if (fontIt != glyphs.end())
+    {
+        glyphsCount -= uint32(fontIt->second.size());
+        glyphs.erase(fontIt);
+    }
+}
+
+void FTGlyphAtlas::Clear()
+{
+    LockGuard<Mutex> lock(mutex);
+
+    for (Page& page : pages)
+    {
+        SafeRelease(page.texture);
+    }
+    pages.clear();
+    currentPage = 0;
+    glyphs.clear();
+    glyphsCount = 0;
+    generation++;
+}
+
+void FTGlyphAtlas::EndFrame()
+{
+    LockGuard<Mutex> lock(mutex);
+
+    // Release pages added over the limit when they are not used for the whole frame
+    bool released = false;
+    while (pages.size() > maxPages && pages.back().lastUsedFrame != frame)
+    {
+        RemovePageGlyphs(uint32(pages.size() - 1));
+        SafeRelease(pages.back().texture);
+        pages.pop_back();
+        released = true;
+    }
+    if (released)
+    {
+        currentPage = std::min(currentPage, uint32(pages.size() - 1));
+        generation++;
+    }
+    frame++;
+}
+
+Texture* FTGlyphAtlas::GetPageTexture(uint32 pageIndex)
+{
+    LockGuard<Mutex> lock(mutex);
+
+    if (pageIndex >= pages.size())
+    {
+        return nullptr;
+    }
+
+    Page& page = pages[pageIndex];
+    if (page.texture == nullptr)
+    {
+        page.texture = Texture::CreateFromData(FORMAT_A8, page.image.data(), pageSize, pageSize, false);
+        page.texture->SetWrapMode(rhi::TEXADDR_CLAMP, rhi::TEXADDR_CLAMP);
+        page.texture->SetMinMagFilter(rhi::TEXFILTER_LINEAR, rhi::TEXFILTER_LINEAR, rhi::TEXMIPFILTER_NONE);
+    }
+    else if (page.dirtyBegin == 0 && page.dirtyEnd == pageSize)
+    {
+        page.texture->TexImage(0, pageSize, pageSize, page.image.data(), uint32(page.image.size()), Texture::INVALID_CUBEMAP_FACE);
+    }
+    else if (page.dirtyBegin < page.dirtyEnd)
+    {
+        rhi::UpdateTextureRows(page.texture->handle, page.image.data() + page.dirtyBegin * pageSize, 0, page.dirtyBegin, page.dirtyEnd - page.dirtyBegin);
+    }
+    page.dirtyBegin = pageSize;
+    page.dirtyEnd = 0;
+    page.lastUsedFrame = frame;
+    return page.texture;
+}
+
+uint32 FTGlyphAtlas::GetPageSize() const
+{
+    return pageSize;
+}
+
+uint32 FTGlyphAtlas::GetPagesCount() const
+{
+    LockGuard<Mutex> lock(mutex);
+    return uint32(pages.size());
+}
+
+uint32 FTGlyphAtlas::GetGlyphsCount() const
+{
+    LockGuard<Mutex> lock(mutex);
+    return glyphsCount;
+}
+
+uint32 FTGlyphAtlas::GetGeneration() const
+{
+    LockGuard<Mutex> lock(mutex);
+    return generation;
+}
+
+void FTGlyphAtlas::AddPage()
+{
+    pages.emplace_back();
+    Page& page = pages.back();
+    page.image.resize(pageSize * pageSize, 0);
+    page.packer.reset(new RectPacker(Rect2i(0, 0, pageSize, pageSize)));
+    page.dirtyEnd = pageSize;
+    page.lastUsedFrame = frame;
+}
+
+void FTGlyphAtlas::ResetPage(uint32 pageIndex)
+{
+    RemovePageGlyphs(pageIndex);
+
+    Page& page = pages[pageIndex];
+    std::fill(page.image.begin(), page.image.end(), uint8(0));
+    page.packer.reset(new RectPacker(Rect2i(0, 0, pageSize, pageSize)));
+    page.dirtyBegin = 0;
+    page.dirtyEnd = pageSize;
+    page.lastUsedFrame = frame;
+    generation++;
+}
+
+void FTGlyphAtlas::RemovePageGlyphs(uint32 pageIndex)
+{
+    for (auto& fontGlyphs : glyphs)
+    {
+        for (auto it = fontGlyphs.second.begin(); it != fontGlyphs.second.end();)
+        {
+            // glyphs without image don't occupy any page
+            if (it->second.page == pageIndex && it->second.rect.dx > 0)
+            {
+                it = fontGlyphs.second.erase(it);
+                glyphsCount--;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+}
+
+void FTGlyphAtlas::Restore()
+{
+    LockGuard<Mutex> lock(mutex);
+
+    for (Page& page : pages)
+    {
+        if (page.texture != nullptr && rhi::NeedRestoreTexture(page.texture->handle))
+        {
+            page.dirtyBegin = 0;
+            page.dirtyEnd = pageSize;
+        }
+    }
+}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/BaseMath.h"
+#include "Concurrency/Mutex.h"
+
+namespace DAVA
+{
+class RectPacker;
+class Texture;
+
+/**
+    Shared atlas of rasterized FreeType glyphs.
+
+    Glyph images are packed into A8 texture pages on first use and shared by all text blocks,
+    so each glyph of each font size is rasterized and stored once. Pages are kept in memory and
+    rows touched by new glyphs are uploaded to textures before drawing. When all pages are full,
+    the least recently used page is cleared and atlas generation is changed, so users have to
+    request their glyphs again. Pages used in the current frame are never cleared, if all of them
+    are used atlas temporarily grows over `maxPages` and extra pages are released by `EndFrame`.
+*/
+class FTGlyphAtlas final
+{
+public:
+    static const uint32 DEFAULT_PAGE_SIZE = 1024;
+    static const uint32 DEFAULT_MAX_PAGES = 4;
+
+    struct Glyph
+    {
+        uint32 page = 0;
+        Rect2i rect; // glyph image in page, empty for glyphs without image (e.g. space)
+        int32 left = 0; // offset of image from pen position, y axis is directed up
+        int32 top = 0;
+    };
+
+    FTGlyphAtlas(uint32 pageSize = DEFAULT_PAGE_SIZE, uint32 maxPages = DEFAULT_MAX_PAGES);
+    ~FTGlyphAtlas();
+
+    /** Find glyph image by `font` and `key`, which identifies glyph, size and subpixel position in font */
+    bool FindGlyph(const void* font, uint64 key, Glyph& glyph) const;
+    /** Place 8-bit glyph image to atlas, returns false if image is bigger than page */
+    bool AddGlyph(const void* font, uint64 key, const uint8* image, int32 width, int32 height, int32 pitch, int32 left, int32 top, Glyph& glyph);
+    /** Forget glyphs of deleted font, their space is reused after their page is cleared */
+    void RemoveFont(const void* font);
+    void Clear();
+    /** Finish frame of page usage, should be called once per frame */
+    void EndFrame();
+
+    /** Get page texture updated with all added glyphs, should be called from render thread */
+    Texture* GetPageTexture(uint32 page);
+
+    uint32 GetPageSize() const;
+    uint32 GetPagesCount() const;
+    uint32 GetGlyphsCount() const;
+    uint32 GetGeneration() const;
+
+private:
+    struct Page
+    {
+        Vector<uint8> image;
+        std::unique_ptr<RectPacker> packer;
+        Texture* texture = nullptr;
+        uint32 dirtyBegin = 0; // rows [dirtyBegin, dirtyEnd) are changed since last upload
+        uint32 dirtyEnd = 0;
+        mutable uint32 lastUsedFrame = 0;
+    };
+
+    void AddPage();
+    void ResetPage(uint32 pageIndex);
+    void RemovePageGlyphs(uint32 pageIndex);
+    void Restore();
+
+    const uint32 pageSize;
+    const uint32 maxPages;
+
+    mutable Mutex mutex;
+    Vector<Page> pages;
+    uint32 currentPage = 0;
+    UnorderedMap<const void*, UnorderedMap<uint64, Glyph>> glyphs;
+    uint32 glyphsCount = 0;
+    uint32 generation = 0;
+    uint32 frame = 0;
+};
+}
@@ -18,6 +18,7 @@
 #include "Debug/ProfilerMarkerNames.h"
 
 #include "Logger/Logger.h"
+#include "Math/MathBatch.h"
 
 namespace DAVA
 {
@@ -1953,10 +1954,7 @@ void TiledDrawData::GenerateTransformData()
     {
         Unit& unit = units[uIndex];
         const uint32 vCount = static_cast<uint32>(unit.vertices.size());
-        for (uint32 vIndex = 0; vIndex < vCount; ++vIndex)
-        {
-            unit.transformedVertices[vIndex] = unit.vertices[vIndex] * transformMatr;
-        }
+        MathBatch::TransformPoints(unit.vertices.data(), vCount, transformMatr, unit.transformedVertices.data());
     }
 }
 
@@ -2002,15 +2000,11 @@ uint32 StretchDrawData::GetVertexInTrianglesCount() const
 
 void StretchDrawData::GenerateTransformData()
 {
+    MathBatch::TransformPoints(vertices.data(), static_cast<uint32>(vertices.size()), transformMatr, transformedVertices.data());
     if (usePerPixelAccuracy)
     {
         for (size_t i = 0, sz = vertices.size(); i < sz; ++i)
-            transformedVertices[i] = RenderSystem2D::Instance()->GetAlignedVertex(vertices[i] * transformMatr);
-    }
-    else
-    {
-        for (size_t i = 0, sz = vertices.size(); i < sz; ++i)
-            transformedVertices[i] = vertices[i] * transformMatr;
+            transformedVertices[i] = RenderSystem2D::Instance()->GetAlignedVertex(transformedVertices[i]);
     }
 }
 
@@ -2345,15 +2339,11 @@ void TiledMultilayerData::GenerateTileData()
 
 void TiledMultilayerData::GenerateTransformData(bool usePerPixelAccuracy)
 {
+    MathBatch::TransformPoints(vertices.data(), static_cast<uint32>(vertices.size()), transformMatr, transformedVertices.data());
     if (usePerPixelAccuracy)
     {
         for (size_t i = 0, sz = vertices.size(); i < sz; ++i)
-            transformedVertices[i] = RenderSystem2D::Instance()->GetAlignedVertex(vertices[i] * transformMatr);
-    }
-    else
-    {
-        for (size_t i = 0, sz = vertices.size(); i < sz; ++i)
-            transformedVertices[i] = vertices[i] * transformMatr;
+            transformedVertices[i] = RenderSystem2D::Instance()->GetAlignedVertex(transformedVertices[i]);
     }
 }
 };
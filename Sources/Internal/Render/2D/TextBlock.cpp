@@ -4,6 +4,7 @@
 #include "Render/2D/Systems/VirtualCoordinatesSystem.h"
 #include "Render/2D/TextBlockSoftwareRender.h"
 #include "Render/2D/TextBlockGraphicRender.h"
+#include "Render/2D/TextBlockGlyphRender.h"
 #include "Render/2D/TextLayout.h"
 #include "Concurrency/LockGuard.h"
 #include "Utils/TextBox.h"
@@ -26,6 +27,7 @@ static const Vector2 INVALID_VECTOR = Vector2(-1.0f, -1.0f);
 }
 
 bool TextBlock::isBiDiSupportEnabled = false;
+bool TextBlock::isGlyphAtlasEnabled = false;
 Set<TextBlock*> TextBlock::registredTextBlocks;
 Mutex TextBlock::textblockListMutex;
 
@@ -51,6 +53,19 @@ void TextBlock::InvalidateAllTextBlocks()
     }
 }
 
+void TextBlock::RecreateAllTextBlockRenders()
+{
+    LockGuard<Mutex> lock(textblockListMutex);
+    for (auto textBlock : registredTextBlocks)
+    {
+        if (textBlock->font != nullptr && textBlock->font->GetFontType() == Font::TYPE_FT)
+        {
+            textBlock->CreateRender();
+            textBlock->NeedPrepare();
+        }
+    }
+}
+
 void TextBlock::ScreenResolutionChanged()
 {
     InvalidateAllTextBlocks();
@@ -65,6 +80,15 @@ void TextBlock::SetBiDiSupportEnabled(bool value)
     }
 }
 
+void TextBlock::SetGlyphAtlasEnabled(bool value)
+{
+    if (isGlyphAtlasEnabled != value)
+    {
+        isGlyphAtlasEnabled = value;
+        RecreateAllTextBlockRenders();
+    }
+}
+
 TextBlock* TextBlock::Create(const Vector2& size)
 {
     TextBlock* textSprite = new TextBlock();
@@ -168,12 +192,23 @@ void TextBlock::SetFontInternal(Font* _font)
 {
     SafeRelease(font);
     font = SafeRetain(_font);
+    CreateRender();
+}
 
+void TextBlock::CreateRender()
+{
     SafeRelease(textBlockRender);
     switch (font->GetFontType())
     {
     case Font::TYPE_FT:
-        textBlockRender = new TextBlockSoftwareRender(this);
+        if (isGlyphAtlasEnabled)
+        {
+            textBlockRender = new TextBlockGlyphRender(this);
+        }
+        else
+        {
+            textBlockRender = new TextBlockSoftwareRender(this);
+        }
         break;
     case Font::TYPE_GRAPHIC:
     case Font::TYPE_DISTANCE:
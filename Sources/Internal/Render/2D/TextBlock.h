@@ -13,6 +13,7 @@ namespace DAVA
 class TextBlockRender;
 class TextBlockSoftwareRender;
 class TextBlockGraphicRender;
+class TextBlockGlyphRender;
 class TextBox;
 
 /**
@@ -51,6 +52,18 @@ public:
     */
     static bool IsBiDiSupportEnabled();
 
+    /**
+    * \brief Sets drawing of FreeType fonts by quads from shared glyph atlas instead of rendering each text to its own texture.
+    * \param value true to enable glyph atlas.
+    */
+    static void SetGlyphAtlasEnabled(bool value);
+
+    /**
+    * \brief Is FreeType fonts drawn from shared glyph atlas.
+    * \return true if glyph atlas is enabled.
+    */
+    static bool IsGlyphAtlasEnabled();
+
     static TextBlock* Create(const Vector2& size);
 
     virtual void SetFont(Font* font);
@@ -137,6 +150,7 @@ private:
     static void RegisterTextBlock(TextBlock* textBlock);
     static void UnregisterTextBlock(TextBlock* textBlock);
     static void InvalidateAllTextBlocks();
+    static void RecreateAllTextBlockRenders();
 
     TextBlock();
     TextBlock(const TextBlock& src);
@@ -149,6 +163,7 @@ private:
     void CalculateCacheParamsIfNeed();
 
     void SetFontInternal(Font* _font);
+    void CreateRender();
 
     Vector2 scale;
     Vector2 rectSize;
@@ -198,12 +213,14 @@ private:
     bool needMeasureLines : 1;
 
     static bool isBiDiSupportEnabled; //!< true if BiDi transformation support enabled
+    static bool isGlyphAtlasEnabled; //!< true if FreeType fonts are drawn from shared glyph atlas
     static Set<TextBlock*> registredTextBlocks;
     static Mutex textblockListMutex;
 
     friend class TextBlockRender;
     friend class TextBlockSoftwareRender;
     friend class TextBlockGraphicRender;
+    friend class TextBlockGlyphRender;
 
     TextBlockRender* textBlockRender = nullptr;
     TextBox* textBox = nullptr;
@@ -274,4 +291,9 @@ inline bool TextBlock::IsBiDiSupportEnabled()
     return isBiDiSupportEnabled;
 }
 
+inline bool TextBlock::IsGlyphAtlasEnabled()
+{
+    return isGlyphAtlasEnabled;
+}
+
 }; //end of namespace
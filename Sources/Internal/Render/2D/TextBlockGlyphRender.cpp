@@ -0,0 +1,248 @@
+#include "Render/2D/TextBlockGlyphRender.h"
+#include "Engine/Engine.h"
+#include "Render/2D/FontManager.h"
+#include "Render/2D/Private/FTGlyphAtlas.h"
+#include "Render/2D/Systems/RenderSystem2D.h"
+#include "Render/2D/Systems/VirtualCoordinatesSystem.h"
+#include "Render/2D/TextBlockGraphicRender.h"
+#include "UI/UIControlSystem.h"
+
+namespace DAVA
+{
+TextBlockGlyphRender::TextBlockGlyphRender(TextBlock* textBlock)
+    : TextBlockRender(textBlock)
+    , ftFont(static_cast<FTFont*>(textBlock->font))
+    , atlas(GetEngineContext()->fontManager->GetGlyphAtlas())
+{
+    DVASSERT(atlas != nullptr);
+}
+
+TextBlockGlyphRender::~TextBlockGlyphRender() = default;
+
+TextBlockRender* TextBlockGlyphRender::Clone()
+{
+    TextBlockGlyphRender* result = new TextBlockGlyphRender(textBlock);
+    result->pagesVertices = pagesVertices;
+    result->clipRect = clipRect;
+    result->quadsCount = quadsCount;
+    result->atlasGeneration = atlasGeneration;
+    return result;
+}
+
+void TextBlockGlyphRender::Prepare()
+{
+    TextBlockRender::Prepare();
+
+    for (Vector<GraphicFont::GraphicFontVertex>& vertices : pagesVertices)
+    {
+        vertices.clear();
+    }
+    quadsCount = 0;
+    atlasGeneration = atlas->GetGeneration();
+
+    if (textBlock->visualText.empty())
+    {
+        // Skip draw empty string
+        return;
+    }
+
+    // Text is cropped the same way as by texture of software render
+    VirtualCoordinatesSystem* vcs = GetEngineContext()->uiControlSystem->vcs;
+    clipRect = Rect2i(0, 0,
+                      int32(std::ceil(vcs->ConvertVirtualToPhysicalX(textBlock->cacheFinalSize.dx))),
+                      int32(std::ceil(vcs->ConvertVirtualToPhysicalY(textBlock->cacheFinalSize.dy))));
+
+    DrawText();
+
+    if (atlasGeneration != atlas->GetGeneration())
+    {
+        // Atlas was cleared while text was drawn, so first glyphs are lost
+        for (Vector<GraphicFont::GraphicFontVertex>& vertices : pagesVertices)
+        {
+            vertices.clear();
+        }
+        quadsCount = 0;
+        atlasGeneration = atlas->GetGeneration();
+        DrawText();
+    }
+}
+
+void TextBlockGlyphRender::PreDraw()
+{
+    if (atlasGeneration != atlas->GetGeneration())
+    {
+        Prepare();
+    }
+}
+
+void TextBlockGlyphRender::Draw(const Color& textColor, const Vector2* offset)
+{
+    if (quadsCount == 0)
+        return;
+
+    // Place text like UIControlBackground places sprite of software render
+    Vector2 drawOffset = textBlock->cacheSpriteOffset;
+    if (offset)
+    {
+        drawOffset += *offset;
+    }
+
+    int32 align = textBlock->GetVisualAlign();
+    if (align & ALIGN_RIGHT)
+    {
+        drawOffset.x += textBlock->rectSize.dx - textBlock->cacheFinalSize.dx;
+    }
+    else if ((align & ALIGN_LEFT) == 0)
+    {
+        drawOffset.x += (textBlock->rectSize.dx - textBlock->cacheFinalSize.dx) * 0.5f;
+    }
+
+    if (align & ALIGN_BOTTOM)
+    {
+        drawOffset.y += textBlock->rectSize.dy - textBlock->cacheFinalSize.dy;
+    }
+    else if ((align & ALIGN_TOP) == 0)
+    {
+        drawOffset.y += (textBlock->rectSize.dy - textBlock->cacheFinalSize.dy) * 0.5f;
+    }
+
+    if (textBlock->angle == 0.f && FLOAT_EQUAL(textBlock->scale.dx, textBlock->scale.dy))
+    {
+        // Snap text origin to physical pixels, glyph images are already placed on pixel grid
+        VirtualCoordinatesSystem* vcs = GetEngineContext()->uiControlSystem->vcs;
+        Vector2 origin = textBlock->position + drawOffset - textBlock->pivot;
+        Vector2 physicalOrigin = vcs->ConvertVirtualToPhysical(origin);
+        physicalOrigin.x = std::round(physicalOrigin.x);
+        physicalOrigin.y = std::round(physicalOrigin.y);
+        drawOffset += vcs->ConvertPhysicalToVirtual(physicalOrigin) - origin;
+    }
+
+    //NOTE: same affine transformations as in TextBlockGraphicRender
+    Matrix4 offsetMatrix;
+    offsetMatrix.BuildTranslation(Vector3(drawOffset.x - textBlock->pivot.x, drawOffset.y - textBlock->pivot.y, 0.f));
+
+    Matrix4 rotateMatrix;
+    rotateMatrix.BuildRotation(Vector3(0.f, 0.f, 1.f), -textBlock->angle);
+
+    Matrix4 scaleMatrix;
+    //recalculate x scale - for non-uniform scale
+    const float difX = 1.0f - (textBlock->scale.dy - textBlock->scale.dx);
+    scaleMatrix.BuildScale(Vector3(difX, 1.f, 1.0f));
+
+    Matrix4 worldMatrix;
+    worldMatrix.BuildTranslation(Vector3(textBlock->position.x, textBlock->position.y, 0.f));
+
+    offsetMatrix = (scaleMatrix * offsetMatrix * rotateMatrix) * worldMatrix;
+
+    const uint32 maxQuadsInBatch = TextBlockGraphicRender::GetSharedIndexBufferCapacity() / 6;
+    for (uint32 page = 0; page < uint32(pagesVertices.size()); ++page)
+    {
+        const Vector<GraphicFont::GraphicFontVertex>& vertices = pagesVertices[page];
+        if (vertices.empty())
+            continue;
+
+        Texture* texture = atlas->GetPageTexture(page);
+        if (texture == nullptr)
+            continue;
+
+        const uint32 pageQuadsCount = uint32(vertices.size() / 4);
+        for (uint32 firstQuad = 0; firstQuad < pageQuadsCount; firstQuad += maxQuadsInBatch)
+        {
+            const uint32 batchQuadsCount = Min(maxQuadsInBatch, pageQuadsCount - firstQuad);
+
+            BatchDescriptor2D batch;
+            batch.material = RenderSystem2D::DEFAULT_2D_TEXTURE_ALPHA8_MATERIAL;
+            batch.singleColor = textColor;
+            batch.vertexStride = TextBlockGraphicRender::TextVerticesDefaultStride;
+            batch.texCoordStride = TextBlockGraphicRender::TextVerticesDefaultStride;
+            batch.vertexPointer = vertices[firstQuad * 4].position.data;
+            batch.texCoordPointer[0] = vertices[firstQuad * 4].texCoord.data;
+            batch.textureSetHandle = texture->singleTextureSet;
+            batch.samplerStateHandle = texture->samplerStateHandle;
+            batch.vertexCount = batchQuadsCount * 4;
+            batch.indexPointer = TextBlockGraphicRender::GetSharedIndexBuffer();
+            batch.indexCount = batchQuadsCount * 6;
+            batch.worldMatrix = &offsetMatrix;
+            RenderSystem2D::Instance()->PushBatch(batch);
+        }
+    }
+}
+
+Font::StringMetrics TextBlockGlyphRender::DrawTextSL(const WideString& drawText, int32 x, int32 y, int32 w)
+{
+    quadsCache.clear();
+    Font::StringMetrics metrics = ftFont->DrawStringToGlyphs(textBlock->renderSize,
+                                                             -textBlock->cacheOx,
+                                                             -textBlock->cacheOy,
+                                                             0,
+                                                             0,
+                                                             drawText,
+                                                             quadsCache);
+    AddQuads(quadsCache);
+    return metrics;
+}
+
+Font::StringMetrics TextBlockGlyphRender::DrawTextML(const WideString& drawText, int32 x, int32 y, int32 w, int32 xOffset, uint32 yOffset, int32 lineSize)
+{
+    VirtualCoordinatesSystem* vcs = GetEngineContext()->uiControlSystem->vcs;
+    int32 justifyWidth = 0;
+    int32 spaceAddon = 0;
+    if (textBlock->cacheUseJustify)
+    {
+        justifyWidth = int32(std::ceil(vcs->ConvertVirtualToPhysicalX(float32(w))));
+        spaceAddon = int32(std::ceil(vcs->ConvertVirtualToPhysicalY(float32(lineSize))));
+    }
+
+    quadsCache.clear();
+    Font::StringMetrics metrics = ftFont->DrawStringToGlyphs(textBlock->renderSize,
+                                                             -textBlock->cacheOx + int32(vcs->ConvertVirtualToPhysicalX(float32(xOffset))),
+                                                             -textBlock->cacheOy + int32(vcs->ConvertVirtualToPhysicalY(float32(yOffset))),
+                                                             justifyWidth,
+                                                             spaceAddon,
+                                                             drawText,
+                                                             quadsCache);
+    AddQuads(quadsCache);
+    return metrics;
+}
+
+void TextBlockGlyphRender::AddQuads(const Vector<FTFont::GlyphQuad>& quads)
+{
+    VirtualCoordinatesSystem* vcs = GetEngineContext()->uiControlSystem->vcs;
+    const float32 texelSize = 1.f / float32(atlas->GetPageSize());
+
+    for (const FTFont::GlyphQuad& quad : quads)
+    {
+        // Crop glyph by visible rect
+        const int32 x0 = Max(quad.rect.x, clipRect.x);
+        const int32 y0 = Max(quad.rect.y, clipRect.y);
+        const int32 x1 = Min(quad.rect.x + quad.rect.dx, clipRect.x + clipRect.dx);
+        const int32 y1 = Min(quad.rect.y + quad.rect.dy, clipRect.y + clipRect.dy);
+        if (x0 >= x1 || y0 >= y1)
+            continue;
+
+        const Rect rect = vcs->ConvertPhysicalToVirtual(Rect(float32(x0), float32(y0), float32(x1 - x0), float32(y1 - y0)));
+        const float32 u0 = float32(quad.atlasRect.x + x0 - quad.rect.x) * texelSize;
+        const float32 v0 = float32(quad.atlasRect.y + y0 - quad.rect.y) * texelSize;
+        const float32 u1 = u0 + float32(x1 - x0) * texelSize;
+        const float32 v1 = v0 + float32(y1 - y0) * texelSize;
+
+        if (quad.page >= pagesVertices.size())
+        {
+            pagesVertices.resize(quad.page + 1);
+        }
+
+        Vector<GraphicFont::GraphicFontVertex>& vertices = pagesVertices[quad.page];
+        size_t first = vertices.size();
+        vertices.resize(first + 4);
+        vertices[first + 0].position = Vector3(rect.x, rect.y, 0.f);
+        vertices[first + 0].texCoord = Vector2(u0, v0);
+        vertices[first + 1].position = Vector3(rect.x + rect.dx, rect.y, 0.f);
+        vertices[first + 1].texCoord = Vector2(u1, v0);
+        vertices[first + 2].position = Vector3(rect.x + rect.dx, rect.y + rect.dy, 0.f);
+        vertices[first + 2].texCoord = Vector2(u1, v1);
+        vertices[first + 3].position = Vector3(rect.x, rect.y + rect.dy, 0.f);
+        vertices[first + 3].texCoord = Vector2(u0, v1);
+        quadsCount++;
+    }
+}
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Render/2D/TextBlockRender.h"
+#include "Render/2D/FTFont.h"
+#include "Render/2D/GraphicFont.h"
+
+namespace DAVA
+{
+class FTGlyphAtlas;
+
+/**
+    Render of FreeType text by quads of glyph images from shared glyph atlas.
+
+    Unlike TextBlockSoftwareRender it doesn't rasterize whole text to its own texture on each
+    change: glyphs are rasterized once to FTGlyphAtlas and text is drawn by batches of textured quads.
+    Used for TYPE_FT fonts when `TextBlock::SetGlyphAtlasEnabled(true)`.
+*/
+class TextBlockGlyphRender : public TextBlockRender
+{
+public:
+    TextBlockGlyphRender(TextBlock*);
+    ~TextBlockGlyphRender();
+
+    TextBlockRender* Clone() override;
+
+    void Prepare() override;
+    void PreDraw() override;
+    void Draw(const Color& textColor, const Vector2* offset) override;
+
+protected:
+    Font::StringMetrics DrawTextSL(const WideString& drawText, int32 x, int32 y, int32 w) override;
+    Font::StringMetrics DrawTextML(const WideString& drawText,
+                                   int32 x, int32 y, int32 w,
+                                   int32 xOffset, uint32 yOffset,
+                                   int32 lineSize) override;
+
+private:
+    void AddQuads(const Vector<FTFont::GlyphQuad>& quads);
+
+    FTFont* ftFont = nullptr;
+    FTGlyphAtlas* atlas = nullptr;
+    Vector<Vector<GraphicFont::GraphicFontVertex>> pagesVertices; // quad vertices for each atlas page
+    Vector<FTFont::GlyphQuad> quadsCache;
+    Rect2i clipRect; // visible part of text in pixels
+    uint32 quadsCount = 0;
+    uint32 atlasGeneration = 0;
+};
+}
@@ -2,8 +2,10 @@
 #include "EdgeAdjacency.h"
 
 #include "Scene3D/Components/ComponentHelpers.h"
+#include "Render/Highlevel/GeometryBVH.h"
 #include "Render/Highlevel/RenderBatch.h"
 #include "Render/Material/NMaterial.h"
+#include "Render/Material/NMaterialNames.h"
 #include "Render/Highlevel/ShadowVolume.h"
 #include "Render/Highlevel/SkinnedMesh.h"
 #include "Scene3D/Components/RenderComponent.h"
@@ -177,6 +179,111 @@ void ReplaceSignificantJoints(PolygonGroup* pg, int32 vertex, const Map<int32, i
         }
     }
 }
+
+// Forsyth's vertex cache optimization constants (see "Linear-Speed Vertex Cache Optimisation")
+const uint32 FORSYTH_CACHE_SIZE = 32;
+const float32 FORSYTH_CACHE_DECAY_POWER = 1.5f;
+const float32 FORSYTH_LAST_TRIANGLE_SCORE = 0.75f;
+const float32 FORSYTH_VALENCE_BOOST_SCALE = 2.0f;
+const float32 FORSYTH_VALENCE_BOOST_POWER = 0.5f;
+
+float32 ForsythVertexScore(int32 cachePosition, uint32 remainingTriangles)
+{
+    if (remainingTriangles == 0)
+        return -1.0f;
+
+    float32 score = 0.0f;
+    if (cachePosition >= 0)
+    {
+        if (cachePosition < 3)
+        {
+            // vertices of the last triangle are scored lower to prevent emitting strips
+            score = FORSYTH_LAST_TRIANGLE_SCORE;
+        }
+        else
+        {
+            const float32 scaler = 1.0f / static_cast<float32>(FORSYTH_CACHE_SIZE - 3);
+            score = std::pow(1.0f - static_cast<float32>(cachePosition - 3) * scaler, FORSYTH_CACHE_DECAY_POWER);
+        }
+    }
+
+    // boost vertices with few remaining triangles to avoid leaving lonely triangles behind
+    score += FORSYTH_VALENCE_BOOST_SCALE * std::pow(static_cast<float32>(remainingTriangles), -FORSYTH_VALENCE_BOOST_POWER);
+    return score;
+}
+
+struct TriangleAdjacency
+{
+    Vector<uint32> offsets; // first triangle of vertex in `triangles`
+    Vector<uint32> counts; // count of triangles which are not emitted yet
+    Vector<uint32> triangles;
+
+    template <typename IndexType>
+    void Build(const IndexType* indices, uint32 indexCount, uint32 vertexCount)
+    {
+        offsets.assign(vertexCount, 0);
+        counts.assign(vertexCount, 0);
+        triangles.resize(indexCount);
+
+        for (uint32 i = 0; i < indexCount; ++i)
+        {
+            DVASSERT(indices[i] < vertexCount);
+            ++counts[indices[i]];
+        }
+
+        uint32 offset = 0;
+        for (uint32 v = 0; v < vertexCount; ++v)
+        {
+            offsets[v] = offset;
+            offset += counts[v];
+        }
+
+        Vector<uint32> filled(vertexCount, 0);
+        for (uint32 i = 0; i < indexCount; ++i)
+        {
+            uint32 v = indices[i];
+            triangles[offsets[v] + filled[v]] = i / 3;
+            ++filled[v];
+        }
+    }
+
+    void Remove(uint32 vertex, uint32 triangle)
+    {
+        uint32* begin = triangles.data() + offsets[vertex];
+        uint32* end = begin + counts[vertex];
+        uint32* found = std::find(begin, end, triangle);
+        if (found != end)
+        {
+            *found = *(end - 1);
+            --counts[vertex];
+        }
+    }
+};
+
+struct TriangleCluster
+{
+    uint32 firstIndex;
+    uint32 indexCount;
+    float32 sortKey;
+};
+
+template <typename IndexType>
+uint32 CountCacheMisses(const IndexType* indices, uint32 indexCount, Vector<uint32>& timestamps, uint32& time, uint32 cacheSize)
+{
+    uint32 misses = 0;
+    for (uint32 i = 0; i < indexCount; ++i)
+    {
+        uint32 v = indices[i];
+        // vertex is in FIFO cache if it was transformed less than `cacheSize` transforms ago
+        if (time - timestamps[v] >= cacheSize)
+        {
+            timestamps[v] = time;
+            ++time;
+            ++misses;
+        }
+    }
+    return misses;
+}
 }
 
 void CopyVertex(PolygonGroup* srcGroup, uint32 srcPos, PolygonGroup* dstGroup, uint32 dstPos)
@@ -210,10 +317,11 @@ void CopyVertex(PolygonGroup* srcGroup, uint32 srcPos, PolygonGroup* dstGroup, u
 void CopyGroupData(PolygonGroup* srcGroup, PolygonGroup* dstGroup)
 {
     dstGroup->ReleaseData();
-    dstGroup->AllocateData(srcGroup->GetFormat(), srcGroup->GetVertexCount(), srcGroup->GetIndexCount());
+    dstGroup->AllocateData(srcGroup->GetFormat(), srcGroup->GetVertexCount(), srcGroup->GetIndexCount(), 0, srcGroup->indexFormat);
 
     Memcpy(dstGroup->meshData, srcGroup->meshData, srcGroup->GetVertexCount() * srcGroup->vertexStride);
-    Memcpy(dstGroup->indexArray, srcGroup->indexArray, srcGroup->GetIndexCount() * sizeof(int16));
+    Memcpy(dstGroup->GetIndexData(), srcGroup->GetIndexData(), srcGroup->GetIndexCount() * INDEX_FORMAT_SIZE[srcGroup->indexFormat]);
+    dstGroup->SetVertexQuantization(srcGroup->GetVertexQuantization());
 
     dstGroup->BuildBuffers();
 }
@@ -388,16 +496,19 @@ void RebuildMeshTangentSpace(PolygonGroup* group, bool precomputeBinormal /*=tru
 
     //copy original polygon group data and fill new tangent/binormal values
     ScopedPtr<PolygonGroup> tmpGroup(new PolygonGroup());
-    tmpGroup->AllocateData(group->GetFormat(), group->GetVertexCount(), group->GetIndexCount());
+    tmpGroup->AllocateData(group->GetFormat(), group->GetVertexCount(), group->GetIndexCount(), 0, group->GetIndexFormat());
 
     Memcpy(tmpGroup->meshData, group->meshData, group->GetVertexCount() * group->vertexStride);
-    Memcpy(tmpGroup->indexArray, group->indexArray, group->GetIndexCount() * sizeof(int16));
+    Memcpy(tmpGroup->GetIndexData(), group->GetIndexData(), group->GetIndexCount() * INDEX_FORMAT_SIZE[group->GetIndexFormat()]);
 
     int32 vertexFormat = group->GetFormat() | EVF_TANGENT;
     if (precomputeBinormal)
         vertexFormat |= EVF_BINORMAL;
+    // unlocked vertices are appended, so 16-bit indices may not be enough anymore
+    const int32 resultVertexCount = static_cast<int32>(verticesOrigin.size());
+    const int32 indexFormat = (resultVertexCount > 0x10000) ? EIF_32 : group->GetIndexFormat();
     group->ReleaseData();
-    group->AllocateData(vertexFormat, static_cast<int32>(verticesOrigin.size()), static_cast<int32>(verticesFull.size()));
+    group->AllocateData(vertexFormat, resultVertexCount, static_cast<int32>(verticesFull.size()), 0, indexFormat);
 
     //copy vertices
     for (uint32 i = 0, sz = static_cast<uint32>(verticesOrigin.size()); i < sz; ++i)
@@ -724,8 +835,10 @@ PolygonGroup* CreateShadowPolygonGroup(PolygonGroup* oldPolygonGroup)
         }
     }
 
+    // every face corner and every patched edge gets own vertex
+    const int32 shadowIndexFormat = (oldIndexCount + numEdges * 3 > 0x10000) ? EIF_32 : EIF_16;
     PolygonGroup* newPolygonGroup = new PolygonGroup();
-    newPolygonGroup->AllocateData(EVF_VERTEX | EVF_NORMAL, oldIndexCount, oldIndexCount + numEdges * 3);
+    newPolygonGroup->AllocateData(EVF_VERTEX | EVF_NORMAL, oldIndexCount, oldIndexCount + numEdges * 3, 0, shadowIndexFormat);
     int32 nextIndex = 0;
 
     bool indefiniteNormals = false;
@@ -882,10 +995,10 @@ PolygonGroup* CreateShadowPolygonGroup(PolygonGroup* oldPolygonGroup)
     {
         PolygonGroup* patchPolygonGroup = new PolygonGroup();
         // Make enough room in IB for the face and up to 3 quads for each patching face
-        patchPolygonGroup->AllocateData(EVF_VERTEX | EVF_NORMAL, oldIndexCount + numMaps * 3, nextIndex + numMaps * 7 * 3);
+        patchPolygonGroup->AllocateData(EVF_VERTEX | EVF_NORMAL, oldIndexCount + numMaps * 3, nextIndex + numMaps * 7 * 3, 0, shadowIndexFormat);
 
         Memcpy(patchPolygonGroup->meshData, newPolygonGroup->meshData, newPolygonGroup->GetVertexCount() * newPolygonGroup->vertexStride);
-        Memcpy(patchPolygonGroup->indexArray, newPolygonGroup->indexArray, newPolygonGroup->GetIndexCount() * sizeof(int16));
+        Memcpy(patchPolygonGroup->GetIndexData(), newPolygonGroup->GetIndexData(), newPolygonGroup->GetIndexCount() * INDEX_FORMAT_SIZE[shadowIndexFormat]);
 
         SafeRelease(newPolygonGroup);
         newPolygonGroup = patchPolygonGroup;
@@ -1035,9 +1148,9 @@ PolygonGroup* CreateShadowPolygonGroup(PolygonGroup* oldPolygonGroup)
     }
 
     PolygonGroup* shadowDataSource = new PolygonGroup();
-    shadowDataSource->AllocateData(EVF_VERTEX | EVF_NORMAL, nextVertex, nextIndex);
+    shadowDataSource->AllocateData(EVF_VERTEX | EVF_NORMAL, nextVertex, nextIndex, 0, shadowIndexFormat);
     Memcpy(shadowDataSource->meshData, newPolygonGroup->meshData, nextVertex * newPolygonGroup->vertexStride);
-    Memcpy(shadowDataSource->indexArray, newPolygonGroup->indexArray, nextIndex * sizeof(int16));
+    Memcpy(shadowDataSource->GetIndexData(), newPolygonGroup->GetIndexData(), nextIndex * INDEX_FORMAT_SIZE[shadowIndexFormat]);
 
     shadowDataSource->RecalcAABBox();
 
@@ -1053,7 +1166,7 @@ PolygonGroup* CreateShadowPolygonGroup(PolygonGroup* oldPolygonGroup)
     return shadowDataSource;
 }
 
-Vector<uint16> BuildSortedIndexBufferData(PolygonGroup* pg, Vector3 direction)
+Vector<uint32> BuildSortedIndexBufferData(PolygonGroup* pg, Vector3 direction)
 {
     DVASSERT(pg);
     DVASSERT(pg->GetPrimitiveType() == rhi::PRIMITIVE_TRIANGLELIST);
@@ -1061,12 +1174,12 @@ Vector<uint16> BuildSortedIndexBufferData(PolygonGroup* pg, Vector3 direction)
     struct Triangle
     {
         Vector3 sortPosition;
-        Array<uint16, 3> indices;
+        Array<uint32, 3> indices;
     };
 
     int32 trianglesCount = pg->GetPrimitiveCount();
 
-    Vector<uint16> indexBufferData;
+    Vector<uint32> indexBufferData;
     indexBufferData.reserve(pg->GetIndexCount());
 
     Vector<Triangle> triangles;
@@ -1103,9 +1216,9 @@ Vector<uint16> BuildSortedIndexBufferData(PolygonGroup* pg, Vector3 direction)
             triangle.sortPosition /= 3.f;
         }
 
-        triangle.indices[0] = uint16(tempInd[0]);
-        triangle.indices[1] = uint16(tempInd[1]);
-        triangle.indices[2] = uint16(tempInd[2]);
+        triangle.indices[0] = uint32(tempInd[0]);
+        triangle.indices[1] = uint32(tempInd[1]);
+        triangle.indices[2] = uint32(tempInd[2]);
     }
 
     std::stable_sort(triangles.begin(), triangles.end(), [&direction](const Triangle& l, const Triangle& r) {
@@ -1118,6 +1231,599 @@ Vector<uint16> BuildSortedIndexBufferData(PolygonGroup* pg, Vector3 direction)
     return indexBufferData;
 }
 
+namespace MeshUtilsDetails
+{
+template <typename IndexType>
+VertexCacheStatistics AnalyzeVertexCacheImpl(const IndexType* indices, uint32 indexCount, uint32 vertexCount, uint32 cacheSize)
+{
+    VertexCacheStatistics statistics;
+    if (indexCount < 3 || vertexCount == 0)
+        return statistics;
+
+    // timestamps start far enough in the past to count first use of every vertex as a miss
+    uint32 time = cacheSize + 1;
+    Vector<uint32> timestamps(vertexCount, 0);
+    uint32 misses = CountCacheMisses(indices, indexCount, timestamps, time, cacheSize);
+
+    uint32 usedVertexCount = 0;
+    for (uint32 stamp : timestamps)
+    {
+        usedVertexCount += (stamp != 0) ? 1 : 0;
+    }
+
+    statistics.acmr = static_cast<float32>(misses) / static_cast<float32>(indexCount / 3);
+    statistics.atvr = static_cast<float32>(misses) / static_cast<float32>(usedVertexCount);
+    return statistics;
+}
+
+template <typename IndexType>
+void OptimizeVertexCacheImpl(IndexType* indices, uint32 indexCount, uint32 vertexCount)
+{
+    DVASSERT(indexCount % 3 == 0);
+    const uint32 triangleCount = indexCount / 3;
+    if (triangleCount < 2)
+        return;
+
+    TriangleAdjacency adjacency;
+    adjacency.Build(indices, indexCount, vertexCount);
+
+    Vector<int32> cachePositions(vertexCount, -1);
+    Vector<float32> vertexScores(vertexCount);
+    for (uint32 v = 0; v < vertexCount; ++v)
+    {
+        vertexScores[v] = ForsythVertexScore(-1, adjacency.counts[v]);
+    }
+
+    Vector<float32> triangleScores(triangleCount);
+    for (uint32 t = 0; t < triangleCount; ++t)
+    {
+        triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+    }
+
+    Vector<IndexType> result;
+    result.reserve(indexCount);
+    Vector<uint8> emitted(triangleCount, 0);
+
+    uint32 cache[FORSYTH_CACHE_SIZE + 3];
+    uint32 cacheCount = 0;
+    uint32 scanPosition = 0;
+
+    uint32 bestTriangle = static_cast<uint32>(std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+    for (uint32 emittedCount = 0; emittedCount < triangleCount; ++emittedCount)
+    {
+        if (bestTriangle == InvalidIndex)
+        {
+            // cache has no vertices with pending triangles, continue from the next not emitted triangle
+            while (emitted[scanPosition] != 0)
+            {
+                ++scanPosition;
+            }
+            bestTriangle = scanPosition;
+        }
+
+        const IndexType* triangle = indices + bestTriangle * 3;
+        result.insert(result.end(), triangle, triangle + 3);
+        emitted[bestTriangle] = 1;
+
+        // triangle vertices go to the front of LRU cache
+        uint32 newCache[FORSYTH_CACHE_SIZE + 3];
+        uint32 newCacheCount = 0;
+        for (uint32 k = 0; k < 3; ++k)
+        {
+            newCache[newCacheCount++] = triangle[k];
+            adjacency.Remove(triangle[k], bestTriangle);
+        }
+        for (uint32 i = 0; i < cacheCount; ++i)
+        {
+            uint32 v = cache[i];
+            if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+            {
+                newCache[newCacheCount++] = v;
+            }
+        }
+
+        // update scores of vertices which have been in cache, including just evicted ones
+        for (uint32 i = 0; i < newCacheCount; ++i)
+        {
+            uint32 v = newCache[i];
+            cachePositions[v] = (i < FORSYTH_CACHE_SIZE) ? static_cast<int32>(i) : -1;
+
+            float32 score = ForsythVertexScore(cachePositions[v], adjacency.counts[v]);
+            float32 delta = score - vertexScores[v];
+            vertexScores[v] = score;
+
+            const uint32* adjacent = adjacency.triangles.data() + adjacency.offsets[v];
+            for (uint32 t = 0; t < adjacency.counts[v]; ++t)
+            {
+                triangleScores[adjacent[t]] += delta;
+            }
+        }
+
+        cacheCount = std::min(newCacheCount, FORSYTH_CACHE_SIZE);
+        std::copy(newCache, newCache + cacheCount, cache);
+
+        // next triangle is the best one among triangles adjacent to cached vertices
+        bestTriangle = InvalidIndex;
+        float32 bestScore = -1.0f;
+        for (uint32 i = 0; i < cacheCount; ++i)
+        {
+            uint32 v = cache[i];
+            const uint32* adjacent = adjacency.triangles.data() + adjacency.offsets[v];
+            for (uint32 t = 0; t < adjacency.counts[v]; ++t)
+            {
+                if (triangleScores[adjacent[t]] > bestScore)
+                {
+                    bestScore = triangleScores[adjacent[t]];
+                    bestTriangle = adjacent[t];
+                }
+            }
+        }
+    }
+
+    std::copy(result.begin(), result.end(), indices);
+}
+
+template <typename IndexType>
+void OptimizeOverdrawImpl(IndexType* indices, uint32 indexCount, const Vector3* positions, uint32 positionStride, uint32 vertexCount, float32 threshold)
+{
+    DVASSERT(indexCount % 3 == 0);
+    if (indexCount < 6)
+        return;
+
+    auto GetPosition = [positions, positionStride](uint32 v) -> const Vector3& {
+        return *reinterpret_cast<const Vector3*>(reinterpret_cast<const uint8*>(positions) + v * positionStride);
+    };
+
+    // hard cluster boundaries are triangles with all vertices missed in cache, cache is "flushed" there anyway
+    Vector<uint32> hardBoundaries;
+    Vector<uint32> timestamps(vertexCount, 0);
+    uint32 time = VERTEX_CACHE_SIZE + 1;
+    for (uint32 i = 0; i < indexCount; i += 3)
+    {
+        if (CountCacheMisses(indices + i, 3, timestamps, time, VERTEX_CACHE_SIZE) == 3)
+        {
+            hardBoundaries.push_back(i);
+        }
+    }
+    hardBoundaries.push_back(indexCount);
+    if (hardBoundaries.front() != 0)
+    {
+        hardBoundaries.insert(hardBoundaries.begin(), 0);
+    }
+
+    // hard clusters are split further while ACMR of the part (with cold cache) stays close to ACMR of the whole cluster
+    Vector<TriangleCluster> clusters;
+    for (uint32 h = 0; h + 1 < hardBoundaries.size(); ++h)
+    {
+        uint32 begin = hardBoundaries[h];
+        uint32 end = hardBoundaries[h + 1];
+
+        time += VERTEX_CACHE_SIZE + 1;
+        float32 clusterMisses = static_cast<float32>(CountCacheMisses(indices + begin, end - begin, timestamps, time, VERTEX_CACHE_SIZE));
+        float32 clusterAcmr = clusterMisses / static_cast<float32>((end - begin) / 3);
+
+        uint32 partBegin = begin;
+        uint32 partMisses = 0;
+        time += VERTEX_CACHE_SIZE + 1;
+        for (uint32 i = begin; i < end; i += 3)
+        {
+            partMisses += CountCacheMisses(indices + i, 3, timestamps, time, VERTEX_CACHE_SIZE);
+            float32 partAcmr = static_cast<float32>(partMisses) / static_cast<float32>((i + 3 - partBegin) / 3);
+            if (i + 3 < end && partAcmr <= clusterAcmr * threshold)
+            {
+                clusters.push_back({ partBegin, i + 3 - partBegin, 0.0f });
+                partBegin = i + 3;
+                partMisses = 0;
+                time += VERTEX_CACHE_SIZE + 1;
+            }
+        }
+        clusters.push_back({ partBegin, end - partBegin, 0.0f });
+    }
+
+    if (clusters.size() < 2)
+        return;
+
+    // clusters facing outwards of mesh center are drawn first, as they likely occlude the rest
+    Vector3 meshCenter;
+    float32 meshArea = 0.0f;
+    Vector<Vector3> clusterCenters(clusters.size());
+    Vector<Vector3> clusterNormals(clusters.size());
+    for (size_t c = 0; c < clusters.size(); ++c)
+    {
+        Vector3 center;
+        Vector3 normal;
+        float32 area = 0.0f;
+        for (uint32 i = clusters[c].firstIndex, end = clusters[c].firstIndex + clusters[c].indexCount; i < end; i += 3)
+        {
+            const Vector3& p0 = GetPosition(indices[i]);
+            const Vector3& p1 = GetPosition(indices[i + 1]);
+            const Vector3& p2 = GetPosition(indices[i + 2]);
+            Vector3 triangleNormal = CrossProduct(p1 - p0, p2 - p0);
+            float32 triangleArea = triangleNormal.Length();
+
+            center += (p0 + p1 + p2) * (triangleArea / 3.0f);
+            normal += triangleNormal;
+            area += triangleArea;
+        }
+
+        meshCenter += center;
+        meshArea += area;
+        clusterCenters[c] = (area > 0.0f) ? center / area : GetPosition(indices[clusters[c].firstIndex]);
+        clusterNormals[c] = normal;
+        clusterNormals[c].Normalize();
+    }
+    if (meshArea > 0.0f)
+    {
+        meshCenter /= meshArea;
+    }
+
+    for (size_t c = 0; c < clusters.size(); ++c)
+    {
+        clusters[c].sortKey = DotProduct(clusterCenters[c] - meshCenter, clusterNormals[c]);
+    }
+
+    std::stable_sort(clusters.begin(), clusters.end(), [](const TriangleCluster& l, const TriangleCluster& r) {
+        return l.sortKey > r.sortKey;
+    });
+
+    Vector<IndexType> result;
+    result.reserve(indexCount);
+    for (const TriangleCluster& cluster : clusters)
+    {
+        result.insert(result.end(), indices + cluster.firstIndex, indices + cluster.firstIndex + cluster.indexCount);
+    }
+    std::copy(result.begin(), result.end(), indices);
+}
+
+template <typename IndexType>
+Vector<uint32> BuildVertexFetchRemapImpl(const IndexType* indices, uint32 indexCount, uint32 vertexCount)
+{
+    Vector<uint32> remap(vertexCount, InvalidIndex);
+    uint32 nextVertex = 0;
+    for (uint32 i = 0; i < indexCount; ++i)
+    {
+        DVASSERT(indices[i] < vertexCount);
+        if (remap[indices[i]] == InvalidIndex)
+        {
+            remap[indices[i]] = nextVertex++;
+        }
+    }
+
+    for (uint32& newIndex : remap)
+    {
+        if (newIndex == InvalidIndex)
+        {
+            newIndex = nextVertex++;
+        }
+    }
+    return remap;
+}
+}
+
+VertexCacheStatistics AnalyzeVertexCache(const uint16* indices, uint32 indexCount, uint32 vertexCount, uint32 cacheSize)
+{
+    return MeshUtilsDetails::AnalyzeVertexCacheImpl(indices, indexCount, vertexCount, cacheSize);
+}
+
+VertexCacheStatistics AnalyzeVertexCache(const uint32* indices, uint32 indexCount, uint32 vertexCount, uint32 cacheSize)
+{
+    return MeshUtilsDetails::AnalyzeVertexCacheImpl(indices, indexCount, vertexCount, cacheSize);
+}
+
+void OptimizeVertexCache(uint16* indices, uint32 indexCount, uint32 vertexCount)
+{
+    MeshUtilsDetails::OptimizeVertexCacheImpl(indices, indexCount, vertexCount);
+}
+
+void OptimizeVertexCache(uint32* indices, uint32 indexCount, uint32 vertexCount)
+{
+    MeshUtilsDetails::OptimizeVertexCacheImpl(indices, indexCount, vertexCount);
+}
+
+void OptimizeOverdraw(uint16* indices, uint32 indexCount, const Vector3* positions, uint32 positionStride, uint32 vertexCount, float32 threshold)
+{
+    MeshUtilsDetails::OptimizeOverdrawImpl(indices, indexCount, positions, positionStride, vertexCount, threshold);
+}
+
+void OptimizeOverdraw(uint32* indices, uint32 indexCount, const Vector3* positions, uint32 positionStride, uint32 vertexCount, float32 threshold)
+{
+    MeshUtilsDetails::OptimizeOverdrawImpl(indices, indexCount, positions, positionStride, vertexCount, threshold);
+}
+
+Vector<uint32> BuildVertexFetchRemap(const uint16* indices, uint32 indexCount, uint32 vertexCount)
+{
+    return MeshUtilsDetails::BuildVertexFetchRemapImpl(indices, indexCount, vertexCount);
+}
+
+Vector<uint32> BuildVertexFetchRemap(const uint32* indices, uint32 indexCount, uint32 vertexCount)
+{
+    return MeshUtilsDetails::BuildVertexFetchRemapImpl(indices, indexCount, vertexCount);
+}
+
+namespace MeshUtilsDetails
+{
+template <typename IndexType>
+void OptimizePolygonGroupIndices(PolygonGroup* group, IndexType* indices, bool reorderTriangles, VertexCacheStatistics* statisticsBefore, VertexCacheStatistics* statisticsAfter)
+{
+    const uint32 indexCount = static_cast<uint32>(group->GetIndexCount());
+    const uint32 vertexCount = static_cast<uint32>(group->GetVertexCount());
+    const uint32 vertexStride = static_cast<uint32>(group->vertexStride);
+
+    if (statisticsBefore != nullptr)
+    {
+        *statisticsBefore = AnalyzeVertexCache(indices, indexCount, vertexCount);
+    }
+
+    if (reorderTriangles)
+    {
+        OptimizeVertexCache(indices, indexCount, vertexCount);
+        OptimizeOverdraw(indices, indexCount, group->vertexArray, vertexStride, vertexCount);
+    }
+
+    Vector<uint32> remap = BuildVertexFetchRemap(indices, indexCount, vertexCount);
+    Vector<uint8> vertexData(group->meshData, group->meshData + vertexCount * vertexStride);
+    for (uint32 v = 0; v < vertexCount; ++v)
+    {
+        Memcpy(group->meshData + remap[v] * vertexStride, vertexData.data() + v * vertexStride, vertexStride);
+    }
+    for (uint32 i = 0; i < indexCount; ++i)
+    {
+        indices[i] = static_cast<IndexType>(remap[indices[i]]);
+    }
+
+    if (statisticsAfter != nullptr)
+    {
+        *statisticsAfter = AnalyzeVertexCache(indices, indexCount, vertexCount);
+    }
+}
+}
+
+bool OptimizePolygonGroup(PolygonGroup* group, bool reorderTriangles, VertexCacheStatistics* statisticsBefore, VertexCacheStatistics* statisticsAfter)
+{
+    DVASSERT(group);
+
+    if (group->GetPrimitiveType() != rhi::PRIMITIVE_TRIANGLELIST || group->GetIndexData() == nullptr || group->meshData == nullptr)
+        return false;
+
+    // several index sets sharing one buffer (e.g. SpeedTree sorted groups), drawn by offset
+    if (group->GetIndexCount() != group->GetPrimitiveCount() * 3)
+        return false;
+
+    if (group->indexFormat == EIF_32)
+    {
+        MeshUtilsDetails::OptimizePolygonGroupIndices(group, group->indexArray32, reorderTriangles, statisticsBefore, statisticsAfter);
+    }
+    else
+    {
+        MeshUtilsDetails::OptimizePolygonGroupIndices(group, reinterpret_cast<uint16*>(group->indexArray), reorderTriangles, statisticsBefore, statisticsAfter);
+    }
+
+    if (group->octTree != nullptr)
+    {
+        SafeDelete(group->octTree);
+        group->GenerateGeometryOctTree();
+    }
+    group->ReleaseGeometryBVH();
+    if (group->vertexBuffer.IsValid() || group->indexBuffer.IsValid())
+    {
+        group->BuildBuffers();
+    }
+
+    return true;
+}
+
+uint32 OptimizeGeometryRecursive(Entity* forEntity)
+{
+    Vector<std::pair<PolygonGroup*, FastName>> groups;
+    Set<PolygonGroup*> collectedGroups;
+    Set<PolygonGroup*> orderDependentGroups;
+
+    // triangles of alpha-blended geometry are drawn in authored order, so only vertices are reordered for them
+    Function<void(Entity*)> collectGroups = [&](Entity* entity) {
+        for (int32 i = 0, count = entity->GetChildrenCount(); i < count; ++i)
+        {
+            collectGroups(entity->GetChild(i));
+        }
+
+        RenderObject* ro = GetRenderObject(entity);
+        if (ro == nullptr)
+            return;
+
+        for (uint32 i = 0, count = ro->GetRenderBatchCount(); i < count; ++i)
+        {
+            RenderBatch* batch = ro->GetRenderBatch(i);
+            PolygonGroup* pg = batch->GetPolygonGroup();
+            if (pg == nullptr)
+                continue;
+
+            if (collectedGroups.insert(pg).second)
+            {
+                groups.emplace_back(pg, entity->GetName());
+            }
+
+            NMaterial* material = batch->GetMaterial();
+            if (material != nullptr)
+            {
+                bool blending = (material->GetEffectiveFlagValue(NMaterialFlagName::FLAG_BLENDING) != 0) || (strstr(material->GetEffectiveFXName().c_str(), "Alphablend") != nullptr);
+                if (blending)
+                {
+                    orderDependentGroups.insert(pg);
+                }
+            }
+        }
+    };
+
+    if (forEntity == nullptr)
+        return 0;
+    collectGroups(forEntity);
+
+    uint32 ret = 0;
+    for (const std::pair<PolygonGroup*, FastName>& group : groups)
+    {
+        PolygonGroup* pg = group.first;
+        VertexCacheStatistics before;
+        VertexCacheStatistics after;
+        if (OptimizePolygonGroup(pg, orderDependentGroups.count(pg) == 0, &before, &after))
+        {
+            Logger::Info("[MeshUtils] %s: %d triangles, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f", group.second.c_str(), pg->GetPrimitiveCount(), before.acmr, after.acmr, before.atvr, after.atvr);
+            ++ret;
+        }
+    }
+
+    return ret;
+}
+
+GeometryQuantizationStatistics QuantizeGeometryRecursive(Entity* forEntity, uint32 quantization)
+{
+    GeometryQuantizationStatistics statistics;
+    if (forEntity == nullptr)
+        return statistics;
+
+    // decode is done in default materials shader only, geometry drawn with other shaders is left as is
+    auto isQuantizableMaterial = [](NMaterial* material) {
+        if (material == nullptr)
+            return true;
+
+        const FastName& fxName = material->GetEffectiveFXName();
+        if (fxName == NMaterialName::SILHOUETTE || fxName == NMaterialName::SHADOW_VOLUME || fxName == NMaterialName::GRASS)
+            return false;
+        return fxName.IsValid() == false || strstr(fxName.c_str(), "Water") == nullptr;
+    };
+
+    Vector<PolygonGroup*> groups;
+    Map<PolygonGroup*, Set<NMaterial*>> groupMaterials;
+    Map<NMaterial*, Set<PolygonGroup*>> materialGroups;
+    Set<PolygonGroup*> skippedGroups;
+
+    Function<void(Entity*)> collectGroups = [&](Entity* entity) {
+        for (int32 i = 0, count = entity->GetChildrenCount(); i < count; ++i)
+        {
+            collectGroups(entity->GetChild(i));
+        }
+
+        RenderObject* ro = GetRenderObject(entity);
+        if (ro == nullptr)
+            return;
+
+        bool supportedObject = (ro->GetType() == RenderObject::TYPE_MESH) || (ro->GetType() == RenderObject::TYPE_SKINNED_MESH) || (ro->GetType() == RenderObject::TYPE_SPEED_TREE);
+        for (uint32 i = 0, count = ro->GetRenderBatchCount(); i < count; ++i)
+        {
+            RenderBatch* batch = ro->GetRenderBatch(i);
+            PolygonGroup* pg = batch->GetPolygonGroup();
+            if (pg == nullptr)
+                continue;
+
+            if (groupMaterials.count(pg) == 0)
+            {
+                groups.push_back(pg);
+            }
+
+            NMaterial* material = batch->GetMaterial();
+            groupMaterials[pg].insert(material);
+            materialGroups[material].insert(pg);
+
+            if (!supportedObject || !isQuantizableMaterial(material) || pg->meshData == nullptr)
+            {
+                skippedGroups.insert(pg);
+            }
+        }
+    };
+    collectGroups(forEntity);
+
+    // geometry sharing material with skipped geometry is skipped too, as material gets decode flags
+    for (bool changed = true; changed;)
+    {
+        changed = false;
+        for (const auto& entry : materialGroups)
+        {
+            bool skipMaterial = std::any_of(entry.second.begin(), entry.second.end(), [&skippedGroups](PolygonGroup* pg) { return skippedGroups.count(pg) != 0; });
+            if (skipMaterial)
+            {
+                for (PolygonGroup* pg : entry.second)
+                {
+                    changed |= skippedGroups.insert(pg).second;
+                }
+            }
+        }
+    }
+
+    Set<NMaterial*> quantizedMaterials;
+    for (PolygonGroup* pg : groups)
+    {
+        const uint32 vertexBytes = pg->vertexStride * pg->GetVertexCount();
+        const uint32 indexBytes = pg->GetIndexCount() * INDEX_FORMAT_SIZE[pg->indexFormat];
+        statistics.vertexBytes += vertexBytes;
+        statistics.indexBytes += indexBytes;
+
+        if (skippedGroups.count(pg) != 0)
+        {
+            statistics.quantizedVertexBytes += vertexBytes;
+            statistics.quantizedIndexBytes += indexBytes;
+            continue;
+        }
+
+        // 32-bit indices are kept only when vertices can't be addressed with 16 bits
+        if (pg->indexFormat == EIF_32 && pg->GetVertexCount() <= 0x10000)
+        {
+            Vector<int32> indices(pg->GetIndexCount());
+            for (int32 i = 0; i < pg->GetIndexCount(); ++i)
+            {
+                pg->GetIndex(i, indices[i]);
+            }
+
+            pg->indexFormat = EIF_16;
+            SafeDeleteArray(pg->indexArray32);
+            pg->indexArray = new int16[pg->GetIndexCount()];
+            for (int32 i = 0; i < pg->GetIndexCount(); ++i)
+            {
+                pg->SetIndex(i, indices[i]);
+            }
+        }
+
+        pg->SetVertexQuantization(quantization);
+        if (pg->vertexBuffer.IsValid())
+        {
+            pg->BuildBuffers();
+        }
+
+        statistics.quantizedVertexBytes += PolygonGroup::GetQuantizedVertexSize(pg->GetFormat(), quantization) * pg->GetVertexCount();
+        statistics.quantizedIndexBytes += pg->GetIndexCount() * INDEX_FORMAT_SIZE[pg->indexFormat];
+        ++statistics.polygonGroupCount;
+
+        for (NMaterial* material : groupMaterials[pg])
+        {
+            if (material != nullptr)
+            {
+                quantizedMaterials.insert(material);
+            }
+        }
+    }
+
+    for (NMaterial* material : quantizedMaterials)
+    {
+        const std::pair<FastName, uint32> flags[] = {
+            { NMaterialFlagName::FLAG_VERTEX_QUANTIZED_POSITION, quantization & PolygonGroup::QUANTIZE_POSITION },
+            { NMaterialFlagName::FLAG_VERTEX_OCTAHEDRAL_NORMAL, quantization & PolygonGroup::QUANTIZE_NORMAL }
+        };
+        for (const std::pair<FastName, uint32>& flag : flags)
+        {
+            int32 value = (flag.second != 0) ? 1 : 0;
+            if (material->HasLocalFlag(flag.first))
+                material->SetFlag(flag.first, value);
+            else if (value != 0)
+                material->AddFlag(flag.first, value);
+        }
+    }
+
+    auto toKb = [](uint64 bytes) { return static_cast<uint32>(bytes / 1024); };
+    float32 vertexRatio = (statistics.vertexBytes > 0) ? 100.0f * statistics.quantizedVertexBytes / statistics.vertexBytes : 100.0f;
+    Logger::Info("[MeshUtils] %s: quantized %u polygon groups (%u skipped), vertex data %u -> %u KB (%.1f%% of vertex fetch bandwidth), index data %u -> %u KB",
+                 forEntity->GetName().c_str(), statistics.polygonGroupCount, static_cast<uint32>(groups.size()) - statistics.polygonGroupCount,
+                 toKb(statistics.vertexBytes), toKb(statistics.quantizedVertexBytes), vertexRatio, toKb(statistics.indexBytes), toKb(statistics.quantizedIndexBytes));
+
+    return statistics;
+}
+
 uint32 ReleaseGeometryDataRecursive(Entity* forEntity)
 {
     if (!forEntity)
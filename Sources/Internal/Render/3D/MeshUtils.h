@@ -29,7 +29,79 @@ SkinnedMesh* CreateHardSkinnedMesh(Entity* fromEntity, Vector<SkeletonComponent:
 
 PolygonGroup* CreateShadowPolygonGroup(PolygonGroup* source);
 
-Vector<uint16> BuildSortedIndexBufferData(PolygonGroup* pg, Vector3 direction);
+Vector<uint32> BuildSortedIndexBufferData(PolygonGroup* pg, Vector3 direction);
+
+/**
+    Post-transform vertex cache efficiency of triangle list, measured with FIFO cache of `cacheSize` entries.
+    ACMR - transformed vertices per triangle (0.5 is ideal for regular grid, 3.0 is the worst),
+    ATVR - transformed vertices per referenced vertex (1.0 is ideal).
+*/
+struct VertexCacheStatistics
+{
+    float32 acmr = 0.0f;
+    float32 atvr = 0.0f;
+};
+
+static const uint32 VERTEX_CACHE_SIZE = 16;
+
+VertexCacheStatistics AnalyzeVertexCache(const uint16* indices, uint32 indexCount, uint32 vertexCount, uint32 cacheSize = VERTEX_CACHE_SIZE);
+VertexCacheStatistics AnalyzeVertexCache(const uint32* indices, uint32 indexCount, uint32 vertexCount, uint32 cacheSize = VERTEX_CACHE_SIZE);
+
+/**
+    Reorder triangles of triangle list for post-transform vertex cache (Forsyth's linear-speed algorithm).
+*/
+void OptimizeVertexCache(uint16* indices, uint32 indexCount, uint32 vertexCount);
+void OptimizeVertexCache(uint32* indices, uint32 indexCount, uint32 vertexCount);
+
+/**
+    Split cache-optimized triangle list to clusters and draw outward-facing clusters first to reduce overdraw.
+    Splitting is allowed while ACMR stays within `threshold` of the source one.
+    `positions` is the first vertex position, `positionStride` is a distance between positions in bytes.
+*/
+void OptimizeOverdraw(uint16* indices, uint32 indexCount, const Vector3* positions, uint32 positionStride, uint32 vertexCount, float32 threshold = 1.05f);
+void OptimizeOverdraw(uint32* indices, uint32 indexCount, const Vector3* positions, uint32 positionStride, uint32 vertexCount, float32 threshold = 1.05f);
+
+/**
+    Returns table of new vertex positions (remap[oldIndex] = newIndex) ordering vertices by first use in index buffer.
+    Vertices which are not referenced by indices go to the end.
+*/
+Vector<uint32> BuildVertexFetchRemap(const uint16* indices, uint32 indexCount, uint32 vertexCount);
+Vector<uint32> BuildVertexFetchRemap(const uint32* indices, uint32 indexCount, uint32 vertexCount);
+
+/**
+    Run vertex cache, overdraw and vertex fetch optimization for triangle list polygon group.
+    If `reorderTriangles` is false, only vertex order is changed (for meshes which rely on triangle order, e.g. alpha-blended).
+    Returns false if polygon group can't be optimized (not indexed triangle list, or index buffer holds several
+    triangle orders like SpeedTree sorted groups).
+*/
+bool OptimizePolygonGroup(PolygonGroup* group, bool reorderTriangles = true, VertexCacheStatistics* statisticsBefore = nullptr, VertexCacheStatistics* statisticsAfter = nullptr);
+
+/**
+    Optimize every polygon group in entity hierarchy, log ACMR/ATVR before and after for each one.
+    Returns count of optimized polygon groups.
+*/
+uint32 OptimizeGeometryRecursive(Entity* forEntity);
+
+/**
+    Vertex and index buffer sizes of hierarchy geometry before and after quantization.
+    Vertex data size is also the vertex fetch bandwidth of drawing all geometry once.
+*/
+struct GeometryQuantizationStatistics
+{
+    uint32 polygonGroupCount = 0;
+    uint64 vertexBytes = 0;
+    uint64 quantizedVertexBytes = 0;
+    uint64 indexBytes = 0;
+    uint64 quantizedIndexBytes = 0;
+};
+
+/**
+    Quantize vertex streams (see PolygonGroup::QUANTIZE_POSITION etc.) of every polygon group in entity hierarchy
+    and set decode flags to materials drawing them. Geometry drawn with materials without decode support is skipped.
+    32-bit index buffers of polygon groups addressable with 16 bits are converted to 16-bit ones.
+    Memory and bandwidth savings are logged for the hierarchy.
+*/
+GeometryQuantizationStatistics QuantizeGeometryRecursive(Entity* forEntity, uint32 quantization = PolygonGroup::QUANTIZE_ALL);
 
 uint32 ReleaseGeometryDataRecursive(Entity* forEntity);
 };
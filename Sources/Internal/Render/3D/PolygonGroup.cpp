@@ -3,11 +3,65 @@
 #include "Render/Renderer.h"
 #include "Scene3D/SceneFileV2.h"
 #include "Render/Highlevel/GeometryOctTree.h"
+#include "Render/Highlevel/GeometryBVH.h"
 #include "Reflection/ReflectionRegistrator.h"
 #include "Logger/Logger.h"
+#include "Math/HalfFloat.h"
+#include "Concurrency/LockGuard.h"
+#include "Concurrency/Mutex.h"
 
 namespace DAVA
 {
+namespace PolygonGroupDetails
+{
+const uint32 QUANTIZED_POSITION_SIZE = 4 * sizeof(int16);
+const uint32 QUANTIZED_NORMAL_SIZE = 2 * sizeof(int16);
+const uint32 QUANTIZED_TEXCOORD_SIZE = 2 * sizeof(uint16);
+
+const uint32 TEXCOORD_STREAMS = EVF_TEXCOORD0 | EVF_TEXCOORD1 | EVF_TEXCOORD2 | EVF_TEXCOORD3;
+const uint32 NORMAL_STREAMS = EVF_NORMAL | EVF_TANGENT | EVF_BINORMAL;
+
+uint32 GetBufferStreamSize(uint32 stream, uint32 quantization)
+{
+    if (stream == EVF_VERTEX && (quantization & PolygonGroup::QUANTIZE_POSITION))
+        return QUANTIZED_POSITION_SIZE;
+    if ((stream & NORMAL_STREAMS) && (quantization & PolygonGroup::QUANTIZE_NORMAL))
+        return QUANTIZED_NORMAL_SIZE;
+    if ((stream & TEXCOORD_STREAMS) && (quantization & PolygonGroup::QUANTIZE_TEXCOORD))
+        return QUANTIZED_TEXCOORD_SIZE;
+    return GetVertexSize(stream);
+}
+
+int16 ToNormalizedInt16(float32 value)
+{
+    return static_cast<int16>(std::round(Clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+// Octahedral mapping of unit vector to [-1, 1]^2, see "A Survey of Efficient Representations for Independent Unit Vectors"
+void EncodeOctahedral(const Vector3& v, int16* result)
+{
+    float32 l1 = std::abs(v.x) + std::abs(v.y) + std::abs(v.z);
+    if (l1 < EPSILON)
+    {
+        result[0] = result[1] = 0;
+        return;
+    }
+
+    float32 x = v.x / l1;
+    float32 y = v.y / l1;
+    if (v.z < 0.0f)
+    {
+        float32 ox = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        float32 oy = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = ox;
+        y = oy;
+    }
+
+    result[0] = ToNormalizedInt16(x);
+    result[1] = ToNormalizedInt16(y);
+}
+}
+
 DAVA_VIRTUAL_REFLECTION_IMPL(PolygonGroup)
 {
     ReflectionRegistrator<PolygonGroup>::Begin()
@@ -44,19 +98,26 @@ void PolygonGroup::UpdateDataPointersAndStreams()
 
     //later merge old render and new rhi formats
     rhi::VertexLayout vLayout;
+    const uint32 quantization = GetBufferVertexQuantization();
 
     int32 baseShift = 0;
     if (vertexFormat & EVF_VERTEX)
     {
         vertexArray = reinterpret_cast<Vector3*>(meshData + baseShift);
         baseShift += GetVertexSize(EVF_VERTEX);
-        vLayout.AddElement(rhi::VS_POSITION, 0, rhi::VDT_FLOAT, 3);
+        if (quantization & QUANTIZE_POSITION)
+            vLayout.AddElement(rhi::VS_POSITION, 0, rhi::VDT_INT16N, 4);
+        else
+            vLayout.AddElement(rhi::VS_POSITION, 0, rhi::VDT_FLOAT, 3);
     }
     if (vertexFormat & EVF_NORMAL)
     {
         normalArray = reinterpret_cast<Vector3*>(meshData + baseShift);
         baseShift += GetVertexSize(EVF_NORMAL);
-        vLayout.AddElement(rhi::VS_NORMAL, 0, rhi::VDT_FLOAT, 3);
+        if (quantization & QUANTIZE_NORMAL)
+            vLayout.AddElement(rhi::VS_NORMAL, 0, rhi::VDT_INT16N, 2);
+        else
+            vLayout.AddElement(rhi::VS_NORMAL, 0, rhi::VDT_FLOAT, 3);
     }
     if (vertexFormat & EVF_COLOR)
     {
@@ -68,37 +129,55 @@ void PolygonGroup::UpdateDataPointersAndStreams()
     {
         textureCoordArray[0] = reinterpret_cast<Vector2*>(meshData + baseShift);
         baseShift += GetVertexSize(EVF_TEXCOORD0);
-        vLayout.AddElement(rhi::VS_TEXCOORD, 0, rhi::VDT_FLOAT, 2);
+        if (quantization & QUANTIZE_TEXCOORD)
+            vLayout.AddElement(rhi::VS_TEXCOORD, 0, rhi::VDT_HALF, 2);
+        else
+            vLayout.AddElement(rhi::VS_TEXCOORD, 0, rhi::VDT_FLOAT, 2);
     }
     if (vertexFormat & EVF_TEXCOORD1)
     {
         textureCoordArray[1] = reinterpret_cast<Vector2*>(meshData + baseShift);
         baseShift += GetVertexSize(EVF_TEXCOORD1);
-        vLayout.AddElement(rhi::VS_TEXCOORD, 1, rhi::VDT_FLOAT, 2);
+        if (quantization & QUANTIZE_TEXCOORD)
+            vLayout.AddElement(rhi::VS_TEXCOORD, 1, rhi::VDT_HALF, 2);
+        else
+            vLayout.AddElement(rhi::VS_TEXCOORD, 1, rhi::VDT_FLOAT, 2);
     }
     if (vertexFormat & EVF_TEXCOORD2)
     {
         textureCoordArray[2] = reinterpret_cast<Vector2*>(meshData + baseShift);
         baseShift += GetVertexSize(EVF_TEXCOORD2);
-        vLayout.AddElement(rhi::VS_TEXCOORD, 2, rhi::VDT_FLOAT, 2);
+        if (quantization & QUANTIZE_TEXCOORD)
+            vLayout.AddElement(rhi::VS_TEXCOORD, 2, rhi::VDT_HALF, 2);
+        else
+            vLayout.AddElement(rhi::VS_TEXCOORD, 2, rhi::VDT_FLOAT, 2);
     }
     if (vertexFormat & EVF_TEXCOORD3)
     {
         textureCoordArray[3] = reinterpret_cast<Vector2*>(meshData + baseShift);
         baseShift += GetVertexSize(EVF_TEXCOORD3);
-        vLayout.AddElement(rhi::VS_TEXCOORD, 3, rhi::VDT_FLOAT, 2);
+        if (quantization & QUANTIZE_TEXCOORD)
+            vLayout.AddElement(rhi::VS_TEXCOORD, 3, rhi::VDT_HALF, 2);
+        else
+            vLayout.AddElement(rhi::VS_TEXCOORD, 3, rhi::VDT_FLOAT, 2);
     }
     if (vertexFormat & EVF_TANGENT)
     {
         tangentArray = reinterpret_cast<Vector3*>(meshData + baseShift);
         baseShift += GetVertexSize(EVF_TANGENT);
-        vLayout.AddElement(rhi::VS_TANGENT, 0, rhi::VDT_FLOAT, 3);
+        if (quantization & QUANTIZE_NORMAL)
+            vLayout.AddElement(rhi::VS_TANGENT, 0, rhi::VDT_INT16N, 2);
+        else
+            vLayout.AddElement(rhi::VS_TANGENT, 0, rhi::VDT_FLOAT, 3);
     }
     if (vertexFormat & EVF_BINORMAL)
     {
         binormalArray = reinterpret_cast<Vector3*>(meshData + baseShift);
         baseShift += GetVertexSize(EVF_BINORMAL);
-        vLayout.AddElement(rhi::VS_BINORMAL, 0, rhi::VDT_FLOAT, 3);
+        if (quantization & QUANTIZE_NORMAL)
+            vLayout.AddElement(rhi::VS_BINORMAL, 0, rhi::VDT_INT16N, 2);
+        else
+            vLayout.AddElement(rhi::VS_BINORMAL, 0, rhi::VDT_FLOAT, 3);
     }
     if (vertexFormat & EVF_HARD_JOINTINDEX)
     {
@@ -170,12 +249,13 @@ void PolygonGroup::UpdateDataPointersAndStreams()
     vertexLayoutId = rhi::VertexLayout::UniqueId(vLayout);
 }
 
-void PolygonGroup::AllocateData(int32 _meshFormat, int32 _vertexCount, int32 _indexCount, int32 _primitiveCount)
+void PolygonGroup::AllocateData(int32 _meshFormat, int32 _vertexCount, int32 _indexCount, int32 _primitiveCount, int32 _indexFormat)
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
 
     vertexCount = _vertexCount;
     indexCount = _indexCount;
+    indexFormat = _indexFormat;
     vertexFormat = _meshFormat;
     vertexStride = GetVertexSize(_meshFormat);
     textureCoordCount = GetTexCoordCount(vertexFormat);
@@ -189,7 +269,7 @@ void PolygonGroup::AllocateData(int32 _meshFormat, int32 _vertexCount, int32 _in
     meshData = new uint8[vertexStride * vertexCount];
 
     DVASSERT(indexCount > 0);
-    indexArray = new int16[indexCount];
+    AllocateIndexData();
 
     if (cubeTextureCoordCount > 0)
         cubeTextureCoordArray = new Vector3*[cubeTextureCoordCount];
@@ -199,6 +279,20 @@ void PolygonGroup::AllocateData(int32 _meshFormat, int32 _vertexCount, int32 _in
     UpdateDataPointersAndStreams();
 }
 
+void PolygonGroup::AllocateIndexData()
+{
+    DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
+
+    SafeDeleteArray(indexArray);
+    SafeDeleteArray(indexArray32);
+
+    DVASSERT(indexFormat == EIF_16 || indexFormat == EIF_32);
+    if (indexFormat == EIF_32)
+        indexArray32 = new uint32[indexCount];
+    else
+        indexArray = new int16[indexCount];
+}
+
 void PolygonGroup::CreateBaseVertexArray()
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
@@ -245,8 +339,10 @@ void PolygonGroup::ApplyMatrix(const Matrix4& matrix)
 void PolygonGroup::ReleaseData()
 {
     SafeDelete(octTree);
+    ReleaseGeometryBVH();
     SafeDeleteArray(meshData);
     SafeDeleteArray(indexArray);
+    SafeDeleteArray(indexArray32);
     SafeDeleteArray(cubeTextureCoordArray);
     std::fill(std::begin(textureCoordArray), std::end(textureCoordArray), nullptr);
 }
@@ -257,6 +353,7 @@ uint32 PolygonGroup::ReleaseGeometryData()
     {
         SafeDeleteArray(meshData);
         SafeDeleteArray(indexArray);
+        SafeDeleteArray(indexArray32);
         SafeDeleteArray(cubeTextureCoordArray);
         std::fill(std::begin(textureCoordArray), std::end(textureCoordArray), nullptr);
 
@@ -275,6 +372,7 @@ uint32 PolygonGroup::ReleaseGeometryData()
 
         colorArray = nullptr;
         indexArray = nullptr;
+        indexArray32 = nullptr;
         meshData = nullptr;
 
         uint32 ret = vertexStride * vertexCount; //released vertex bytes
@@ -299,13 +397,34 @@ void PolygonGroup::BuildBuffers()
     rhi::VertexBuffer::Descriptor vbDesc;
     rhi::IndexBuffer::Descriptor ibDesc;
 
-    vbDesc.size = vertexStride * vertexCount;
-    vbDesc.initialData = meshData;
+    Vector<uint8> quantizedData;
+    if (GetBufferVertexQuantization() != QUANTIZE_NONE)
+    {
+        BuildQuantizedVertexData(quantizedData);
+        vbDesc.size = static_cast<uint32>(quantizedData.size());
+        vbDesc.initialData = quantizedData.data();
+    }
+    else
+    {
+        vbDesc.size = vertexStride * vertexCount;
+        vbDesc.initialData = meshData;
+    }
     vbDesc.usage = rhi::USAGE_STATICDRAW;
 
-    ibDesc.size = indexCount * INDEX_FORMAT_SIZE[indexFormat];
-    ibDesc.initialData = indexArray;
+    const int32 bufferIndexFormat = GetBufferIndexFormat();
+    Vector<uint16> convertedIndices;
+    if (bufferIndexFormat != indexFormat)
+    {
+        BuildConvertedIndexData(convertedIndices);
+        ibDesc.initialData = convertedIndices.data();
+    }
+    else
+    {
+        ibDesc.initialData = GetIndexData();
+    }
+    ibDesc.size = indexCount * INDEX_FORMAT_SIZE[bufferIndexFormat];
     ibDesc.usage = rhi::USAGE_STATICDRAW;
+    ibDesc.indexSize = (bufferIndexFormat == EIF_32) ? rhi::INDEX_SIZE_32BIT : rhi::INDEX_SIZE_16BIT;
 
     vertexBuffer = rhi::CreateVertexBuffer(vbDesc);
     DVASSERT(vertexBuffer);
@@ -319,17 +438,177 @@ void PolygonGroup::GenerateGeometryOctTree()
     octTree->BuildTree(this);
 }
 
+GeometryBVH* PolygonGroup::GetGeometryBVH()
+{
+    // Ray casts may come from several threads, hierarchy is built once by the first of them
+    GeometryBVH* tree = bvh.load(std::memory_order_acquire);
+    if (tree == nullptr)
+    {
+        LockGuard<Mutex> lock(bvhMutex);
+        tree = bvh.load(std::memory_order_relaxed);
+        if (tree == nullptr && meshData != nullptr)
+        {
+            tree = new GeometryBVH();
+            tree->BuildTree(this);
+            bvh.store(tree, std::memory_order_release);
+        }
+    }
+    return tree;
+}
+
+void PolygonGroup::ReleaseGeometryBVH()
+{
+    LockGuard<Mutex> lock(bvhMutex);
+    delete bvh.exchange(nullptr);
+}
+
 void PolygonGroup::RestoreBuffers()
 {
     if (vertexBuffer.IsValid() && rhi::NeedRestoreVertexBuffer(vertexBuffer))
     {
-        uint32 vertexDataSize = vertexStride * vertexCount;
-        rhi::UpdateVertexBuffer(vertexBuffer, meshData, 0, vertexDataSize);
+        if (GetBufferVertexQuantization() != QUANTIZE_NONE)
+        {
+            Vector<uint8> quantizedData;
+            BuildQuantizedVertexData(quantizedData);
+            rhi::UpdateVertexBuffer(vertexBuffer, quantizedData.data(), 0, static_cast<uint32>(quantizedData.size()));
+        }
+        else
+        {
+            uint32 vertexDataSize = vertexStride * vertexCount;
+            rhi::UpdateVertexBuffer(vertexBuffer, meshData, 0, vertexDataSize);
+        }
     }
     if (indexBuffer.IsValid() && rhi::NeedRestoreIndexBuffer(indexBuffer))
     {
-        uint32 indexDataSize = indexCount * INDEX_FORMAT_SIZE[indexFormat];
-        rhi::UpdateIndexBuffer(indexBuffer, indexArray, 0, indexDataSize);
+        const int32 bufferIndexFormat = GetBufferIndexFormat();
+        uint32 indexDataSize = indexCount * INDEX_FORMAT_SIZE[bufferIndexFormat];
+        if (bufferIndexFormat != indexFormat)
+        {
+            Vector<uint16> convertedIndices;
+            BuildConvertedIndexData(convertedIndices);
+            rhi::UpdateIndexBuffer(indexBuffer, convertedIndices.data(), 0, indexDataSize);
+        }
+        else
+        {
+            rhi::UpdateIndexBuffer(indexBuffer, GetIndexData(), 0, indexDataSize);
+        }
+    }
+}
+
+int32 PolygonGroup::GetBufferIndexFormat() const
+{
+    if (indexFormat == EIF_32 && !rhi::DeviceCaps().is32BitIndicesSupported)
+        return EIF_16;
+
+    return indexFormat;
+}
+
+void PolygonGroup::BuildConvertedIndexData(Vector<uint16>& data)
+{
+    DVASSERT(indexFormat == EIF_32 && indexArray32 != nullptr);
+
+    if (vertexCount > 0x10000)
+    {
+        Logger::Error("PolygonGroup with %d vertices needs 32-bit indices, which are not supported by device", vertexCount);
+    }
+
+    data.resize(indexCount);
+    for (int32 i = 0; i < indexCount; ++i)
+    {
+        data[i] = static_cast<uint16>(indexArray32[i]);
+    }
+}
+
+void PolygonGroup::SetVertexQuantization(uint32 quantization)
+{
+    vertexQuantization = quantization;
+    if (meshData != nullptr)
+    {
+        UpdateDataPointersAndStreams();
+    }
+}
+
+uint32 PolygonGroup::GetBufferVertexQuantization() const
+{
+    uint32 quantization = vertexQuantization;
+    if (!rhi::DeviceCaps().isHalfFloatVertexSupported)
+    {
+        quantization &= ~QUANTIZE_TEXCOORD;
+    }
+    return quantization;
+}
+
+uint32 PolygonGroup::GetQuantizedVertexSize(int32 vertexFormat, uint32 quantization)
+{
+    uint32 stride = 0;
+    for (uint32 mask = EVF_LOWER_BIT; mask <= EVF_HIGHER_BIT; mask = mask << 1)
+    {
+        if (vertexFormat & mask)
+            stride += PolygonGroupDetails::GetBufferStreamSize(mask, quantization);
+    }
+    return stride;
+}
+
+void PolygonGroup::BuildQuantizedVertexData(Vector<uint8>& data)
+{
+    using namespace PolygonGroupDetails;
+
+    DVASSERT(meshData != nullptr);
+
+    const uint32 quantization = GetBufferVertexQuantization();
+
+    // positions are mapped from bounding box to [-1, 1], shader gets them back with offset + value * scale
+    quantizedPositionOffset = aabbox.IsEmpty() ? Vector3() : aabbox.GetCenter();
+    quantizedPositionScale = aabbox.IsEmpty() ? Vector3() : aabbox.GetSize() * 0.5f;
+    Vector3 invScale;
+    for (int32 k = 0; k < 3; ++k)
+    {
+        invScale.data[k] = (quantizedPositionScale.data[k] > EPSILON) ? 1.0f / quantizedPositionScale.data[k] : 0.0f;
+    }
+
+    data.resize(GetQuantizedVertexSize(vertexFormat, quantization) * vertexCount);
+
+    const uint8* src = meshData;
+    uint8* dst = data.data();
+    for (int32 v = 0; v < vertexCount; ++v)
+    {
+        for (uint32 mask = EVF_LOWER_BIT; mask <= EVF_HIGHER_BIT; mask = mask << 1)
+        {
+            if ((vertexFormat & mask) == 0)
+                continue;
+
+            uint32 srcSize = GetVertexSize(mask);
+            uint32 dstSize = GetBufferStreamSize(mask, quantization);
+            if (srcSize == dstSize)
+            {
+                Memcpy(dst, src, srcSize);
+            }
+            else if (mask == EVF_VERTEX)
+            {
+                const Vector3& position = *reinterpret_cast<const Vector3*>(src);
+                int16* packed = reinterpret_cast<int16*>(dst);
+                for (int32 k = 0; k < 3; ++k)
+                {
+                    packed[k] = ToNormalizedInt16((position.data[k] - quantizedPositionOffset.data[k]) * invScale.data[k]);
+                }
+                packed[3] = 32767;
+            }
+            else if (mask & NORMAL_STREAMS)
+            {
+                EncodeOctahedral(*reinterpret_cast<const Vector3*>(src), reinterpret_cast<int16*>(dst));
+            }
+            else
+            {
+                DVASSERT(mask & TEXCOORD_STREAMS);
+                const Vector2& texcoord = *reinterpret_cast<const Vector2*>(src);
+                uint16* packed = reinterpret_cast<uint16*>(dst);
+                packed[0] = Float16Compressor::Compress(texcoord.x);
+                packed[1] = Float16Compressor::Compress(texcoord.y);
+            }
+
+            src += srcSize;
+            dst += dstSize;
+        }
     }
 }
 
@@ -349,11 +628,23 @@ void PolygonGroup::Save(KeyedArchive* keyedArchive, SerializationContext* serial
     keyedArchive->SetInt32("packing", PACKING_NONE);
     keyedArchive->SetByteArray("vertices", meshData, vertexCount * vertexStride);
     keyedArchive->SetInt32("indexFormat", indexFormat);
-    keyedArchive->SetByteArray("indices", reinterpret_cast<uint8*>(indexArray), indexCount * INDEX_FORMAT_SIZE[indexFormat]);
+    keyedArchive->SetByteArray("indices", GetIndexData(), indexCount * INDEX_FORMAT_SIZE[indexFormat]);
     keyedArchive->SetInt32("cubeTextureCoordCount", cubeTextureCoordCount);
+    if (vertexQuantization != QUANTIZE_NONE)
+    {
+        keyedArchive->SetUInt32("vertexQuantization", vertexQuantization);
+    }
 }
 
 void PolygonGroup::LoadPolygonData(KeyedArchive* keyedArchive, SerializationContext* serializationContext, int32 requiredFlags, bool cutUnusedStreams)
+{
+    if (DecodePolygonData(keyedArchive, serializationContext, requiredFlags, cutUnusedStreams))
+    {
+        BuildBuffers();
+    }
+}
+
+bool PolygonGroup::DecodePolygonData(KeyedArchive* keyedArchive, SerializationContext* serializationContext, int32 requiredFlags, bool cutUnusedStreams)
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
 
@@ -365,6 +656,7 @@ void PolygonGroup::LoadPolygonData(KeyedArchive* keyedArchive, SerializationCont
     primitiveType = rhi::PrimitiveType(keyedArchive->GetInt32("rhi_primitiveType", rhi::PRIMITIVE_TRIANGLELIST));
     primitiveCount = keyedArchive->GetInt32("primitiveCount", CalculatePrimitiveCount(indexCount, primitiveType));
     cubeTextureCoordCount = keyedArchive->GetInt32("cubeTextureCoordCount");
+    vertexQuantization = keyedArchive->GetUInt32("vertexQuantization", QUANTIZE_NONE);
 
     int32 formatPacking = keyedArchive->GetInt32("packing");
     if (formatPacking == PACKING_NONE)
@@ -373,7 +665,7 @@ void PolygonGroup::LoadPolygonData(KeyedArchive* keyedArchive, SerializationCont
         if (size != vertexCount * vertexStride)
         {
             Logger::Error("PolygonGroup::Load - Something is going wrong, size of vertex array is incorrect");
-            return;
+            return false;
         }
 
         const uint8* archiveData = keyedArchive->GetByteArray("vertices");
@@ -423,25 +715,24 @@ void PolygonGroup::LoadPolygonData(KeyedArchive* keyedArchive, SerializationCont
     }
 
     indexFormat = keyedArchive->GetInt32("indexFormat");
-    if (indexFormat == EIF_16)
+    if (indexFormat == EIF_16 || indexFormat == EIF_32)
     {
         int size = keyedArchive->GetByteArraySize("indices");
         if (size != indexCount * INDEX_FORMAT_SIZE[indexFormat])
         {
             Logger::Error("PolygonGroup::Load - Something is going wrong, size of index array is incorrect");
-            return;
+            return false;
         }
-        SafeDeleteArray(indexArray);
-        indexArray = new int16[indexCount];
+        AllocateIndexData();
         const uint8* archiveData = keyedArchive->GetByteArray("indices");
-        memcpy(indexArray, archiveData, indexCount * INDEX_FORMAT_SIZE[indexFormat]);
+        memcpy(GetIndexData(), archiveData, indexCount * INDEX_FORMAT_SIZE[indexFormat]);
     }
 
     std::fill(std::begin(textureCoordArray), std::end(textureCoordArray), nullptr);
     UpdateDataPointersAndStreams();
 
     RecalcAABBox();
-    BuildBuffers();
+    return true;
 }
 
 void PolygonGroup::RecalcAABBox()
@@ -5,6 +5,9 @@
 #include "Scene3D/DataNode.h"
 #include "Scene3D/SceneFile/SerializationContext.h"
 #include "Render/RHI/rhi_Public.h"
+#include "Concurrency/Mutex.h"
+
+#include <atomic>
 
 #include "MemoryManager/MemoryProfiler.h"
 
@@ -17,6 +20,7 @@ namespace DAVA
 
 class SceneFileV2;
 class GeometryOctTree;
+class GeometryBVH;
 class PolygonGroup : public DataNode
 {
     DAVA_ENABLE_CLASS_ALLOCATION_TRACKING(ALLOC_POOL_POLYGONGROUP)
@@ -38,6 +42,20 @@ public:
         TEXTURE_COORDS_COUNT = 4
     };
 
+    /**
+        Vertex streams which are packed in vertex buffer, CPU copy of geometry always stays in float32.
+        Materials drawing quantized geometry need matching decode flags (see MeshUtils::QuantizeGeometryRecursive).
+    */
+    enum : uint32
+    {
+        QUANTIZE_NONE = 0,
+        QUANTIZE_POSITION = 1 << 0, //!< normalized int16 relative to bounding box, decoded with VERTEX_QUANTIZED_POSITION flag
+        QUANTIZE_NORMAL = 1 << 1, //!< octahedral int16 normal, tangent and binormal, decoded with VERTEX_OCTAHEDRAL_NORMAL flag
+        QUANTIZE_TEXCOORD = 1 << 2, //!< half-float texture coords, decoded by hardware
+
+        QUANTIZE_ALL = QUANTIZE_POSITION | QUANTIZE_NORMAL | QUANTIZE_TEXCOORD
+    };
+
     static const uint32 MAX_VERTEX_JOINTS_COUNT = 4;
 
 protected:
@@ -84,7 +102,7 @@ public:
     inline void SetJointIndex(int32 i, int32 j, int32 v);
     inline void SetJointWeight(int32 i, int32 j, float32 v);
 
-    inline void SetIndex(int32 i, int16 index);
+    inline void SetIndex(int32 i, int32 index);
 
     inline void SetPivot(int32 i, const Vector4& v);
     inline void SetPivotDeprecated(int32 i, const Vector3& v);
@@ -100,6 +118,24 @@ public:
     inline void SetPrimitiveType(rhi::PrimitiveType type);
 
     inline void GetTriangleIndices(int32 firstIndex, uint16 indices[3]);
+    inline void GetTriangleIndices(int32 firstIndex, uint32 indices[3]);
+
+    //! Index data in `indexFormat`: indexArray for EIF_16, indexArray32 for EIF_32
+    inline uint8* GetIndexData();
+    inline int32 GetIndexFormat() const;
+    //! Index format of index buffer, EIF_32 indices are converted to EIF_16 on devices without 32-bit indices support
+    int32 GetBufferIndexFormat() const;
+
+    void SetVertexQuantization(uint32 quantization);
+    inline uint32 GetVertexQuantization() const;
+    //! Quantization of vertex buffer, streams not supported by device are left in float32
+    uint32 GetBufferVertexQuantization() const;
+    //! Size of vertex in vertex buffer with given quantization
+    static uint32 GetQuantizedVertexSize(int32 vertexFormat, uint32 quantization);
+
+    //! Decode of quantized position: position = offset + value * scale
+    inline const Vector3& GetQuantizedPositionOffset() const;
+    inline const Vector3& GetQuantizedPositionScale() const;
 
     int32 vertexCount = 0;
     int32 indexCount = 0;
@@ -128,6 +164,7 @@ public:
 
     uint32* colorArray = nullptr;
     int16* indexArray = nullptr; // Boroda: why int16? should be uint16?
+    uint32* indexArray32 = nullptr;
     uint8* meshData = nullptr;
 
     AABBox3 aabbox;
@@ -137,6 +174,18 @@ public:
     GeometryOctTree* GetGeometryOctTree() const;
     GeometryOctTree* octTree = nullptr;
 
+    /**
+        Return ray casting hierarchy, it is built on first call. Return nullptr if geometry data is released.
+        Can be called from several threads. Hierarchy is kept until ReleaseData or ReleaseGeometryBVH and takes
+        about 40 bytes per triangle plus 32 bytes per node (see GeometryBVH::GetAllocatedMemorySize), in addition
+        to GeometryOctTree if the latter is requested for triangles in box queries.
+    */
+    GeometryBVH* GetGeometryBVH();
+    /** Free ray casting hierarchy, it is built again by next GetGeometryBVH call. */
+    void ReleaseGeometryBVH();
+    std::atomic<GeometryBVH*> bvh = { nullptr };
+    Mutex bvhMutex;
+
     /*
         Used for animated meshes to hold original vertexes in array that suitable for fast access
      */
@@ -144,7 +193,7 @@ public:
     Vector3* baseVertexArray;
 
     //meshFormat is EVF_VERTEX etc.
-    void AllocateData(int32 meshFormat, int32 vertexCount, int32 indexCount, int32 primitiveCount = 0);
+    void AllocateData(int32 meshFormat, int32 vertexCount, int32 indexCount, int32 primitiveCount = 0, int32 indexFormat = EIF_16);
     void ReleaseData();
     void RecalcAABBox();
 
@@ -162,6 +211,11 @@ public:
 
     void Save(KeyedArchive* keyedArchive, SerializationContext* serializationContext) override;
     void LoadPolygonData(KeyedArchive* keyedArchive, SerializationContext* serializationContext, int32 requiredFlags, bool cutUnusedStreams);
+    /*
+        Fill vertex and index data from archive without creating render buffers,
+        so it can be called from worker thread. Call BuildBuffers after it returns true.
+     */
+    bool DecodePolygonData(KeyedArchive* keyedArchive, SerializationContext* serializationContext, int32 requiredFlags, bool cutUnusedStreams);
 
     static void CopyData(const uint8** meshData, uint8** newMeshData, uint32 vertexFormat, uint32 newVertexFormat, uint32 format);
 
@@ -171,6 +225,13 @@ public:
 
 private:
     void UpdateDataPointersAndStreams();
+    void AllocateIndexData();
+    void BuildQuantizedVertexData(Vector<uint8>& data);
+    void BuildConvertedIndexData(Vector<uint16>& data);
+
+    uint32 vertexQuantization = QUANTIZE_NONE;
+    Vector3 quantizedPositionOffset;
+    Vector3 quantizedPositionScale;
 
     template <class T>
     void SetVertexData(int32 i, T* basePtr, const T& value);
@@ -291,9 +352,12 @@ inline void PolygonGroup::SetJointWeight(int32 i, int32 j, float32 _v)
     reinterpret_cast<Vector4*>(reinterpret_cast<uint8*>(jointWeightArray) + i * vertexStride)->data[j] = _v;
 }
 
-inline void PolygonGroup::SetIndex(int32 i, int16 index)
+inline void PolygonGroup::SetIndex(int32 i, int32 index)
 {
-    indexArray[i] = index;
+    if (indexFormat == EIF_32)
+        indexArray32[i] = uint32(index);
+    else
+        indexArray[i] = int16(index);
 }
 
 inline void PolygonGroup::SetPrimitiveType(rhi::PrimitiveType type)
@@ -383,7 +447,10 @@ inline void PolygonGroup::GetJointWeight(int32 vIndex, int32 jointIndex, float32
 
 inline void PolygonGroup::GetIndex(int32 i, int32& index)
 {
-    index = uint16(indexArray[i]);
+    if (indexFormat == EIF_32)
+        index = int32(indexArray32[i]);
+    else
+        index = uint16(indexArray[i]);
 }
 
 inline int32 PolygonGroup::GetVertexCount()
@@ -422,8 +489,50 @@ inline GeometryOctTree* PolygonGroup::GetGeometryOctTree() const
 
 inline void PolygonGroup::GetTriangleIndices(int32 firstIndex, uint16 indices[3])
 {
+    DVASSERT(indexFormat == EIF_16);
     indices[0] = static_cast<uint16>(indexArray[firstIndex]);
     indices[1] = static_cast<uint16>(indexArray[firstIndex + 1]);
     indices[2] = static_cast<uint16>(indexArray[firstIndex + 2]);
 }
+
+inline void PolygonGroup::GetTriangleIndices(int32 firstIndex, uint32 indices[3])
+{
+    if (indexFormat == EIF_32)
+    {
+        indices[0] = indexArray32[firstIndex];
+        indices[1] = indexArray32[firstIndex + 1];
+        indices[2] = indexArray32[firstIndex + 2];
+    }
+    else
+    {
+        indices[0] = static_cast<uint16>(indexArray[firstIndex]);
+        indices[1] = static_cast<uint16>(indexArray[firstIndex + 1]);
+        indices[2] = static_cast<uint16>(indexArray[firstIndex + 2]);
+    }
+}
+
+inline uint8* PolygonGroup::GetIndexData()
+{
+    return (indexFormat == EIF_32) ? reinterpret_cast<uint8*>(indexArray32) : reinterpret_cast<uint8*>(indexArray);
+}
+
+inline int32 PolygonGroup::GetIndexFormat() const
+{
+    return indexFormat;
+}
+
+inline uint32 PolygonGroup::GetVertexQuantization() const
+{
+    return vertexQuantization;
+}
+
+inline const Vector3& PolygonGroup::GetQuantizedPositionOffset() const
+{
+    return quantizedPositionOffset;
+}
+
+inline const Vector3& PolygonGroup::GetQuantizedPositionScale() const
+{
+    return quantizedPositionScale;
+}
 }
@@ -71,7 +71,10 @@ void InitDynamicParamNames()
             FastName("shadowColor"),
             FastName("waterClearColor"),
 
-            FastName("projectionFlip")
+            FastName("projectionFlip"),
+
+            FastName("quantizedPositionOffset"),
+            FastName("quantizedPositionScale")
         };
     }
 }
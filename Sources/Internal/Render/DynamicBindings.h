@@ -70,6 +70,9 @@ public:
 
         PARAM_PROJECTION_FLIP, //1.0 regular, -1.0 if projection matrix is y-inverted (rendering to RT with lower left origin API)
 
+        PARAM_QUANTIZED_POSITION_OFFSET, //decode of quantized vertex positions: offset + value * scale (see PolygonGroup::QUANTIZE_POSITION)
+        PARAM_QUANTIZED_POSITION_SCALE,
+
         AUTOBIND_UNIFORMS_END,
 
         DYNAMIC_PARAMETERS_COUNT = AUTOBIND_UNIFORMS_END,
@@ -0,0 +1,261 @@
+#include "Render/Highlevel/BoundingVolumeHierarchy.h"
+#include "Debug/DVAssert.h"
+#include "Math/SSE/SSEMath.h"
+
+namespace DAVA
+{
+namespace BoundingVolumeHierarchyDetails
+{
+const uint32 BINS_COUNT = 12;
+// Cost of node traversal relative to cost of primitive intersection test
+const float32 TRAVERSAL_COST = 1.0f;
+
+float32 GetSurfaceArea(const AABBox3& box)
+{
+    if (box.IsEmpty())
+        return 0.0f;
+
+    const Vector3 size = box.GetSize();
+    return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+}
+
+BoundingVolumeHierarchy::RayPacket::RayPacket()
+{
+    for (uint32 lane = 0; lane < SIZE; ++lane)
+    {
+        for (uint32 axis = 0; axis < 3; ++axis)
+        {
+            origin[axis][lane] = 0.0f;
+            invDirection[axis][lane] = 0.0f;
+        }
+        maxT[lane] = -1.0f;
+    }
+}
+
+void BoundingVolumeHierarchy::RayPacket::SetRay(uint32 lane, const Ray3Optimized& ray, float32 rayMaxT)
+{
+    DVASSERT(lane < SIZE);
+    for (uint32 axis = 0; axis < 3; ++axis)
+    {
+        origin[axis][lane] = ray.origin.data[axis];
+        invDirection[axis][lane] = ray.invDirection.data[axis];
+    }
+    maxT[lane] = rayMaxT;
+}
+
+uint32 BoundingVolumeHierarchy::RayPacket::IntersectBox(const AABBox3& box) const
+{
+#if defined(__DAVAENGINE_SSE__)
+    __m128 tMin = _mm_setzero_ps();
+    __m128 tMax = _mm_load_ps(maxT);
+    for (uint32 axis = 0; axis < 3; ++axis)
+    {
+        const __m128 inv = _mm_load_ps(invDirection[axis]);
+        const __m128 o = _mm_load_ps(origin[axis]);
+        const __m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.min.data[axis]), o), inv);
+        const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.max.data[axis]), o), inv);
+
+        // Near plane is chosen by sign of direction, not by min/max of distances, to keep NaN in place
+        const __m128 negative = _mm_cmplt_ps(inv, _mm_setzero_ps());
+        const __m128 tNear = _mm_or_ps(_mm_and_ps(negative, t1), _mm_andnot_ps(negative, t0));
+        const __m128 tFar = _mm_or_ps(_mm_and_ps(negative, t0), _mm_andnot_ps(negative, t1));
+
+        // _mm_max_ps/_mm_min_ps return second operand if first one is NaN
+        tMin = _mm_max_ps(tNear, tMin);
+        tMax = _mm_min_ps(tFar, tMax);
+    }
+    return uint32(_mm_movemask_ps(_mm_cmple_ps(tMin, tMax)));
+#else
+    uint32 mask = 0;
+    for (uint32 lane = 0; lane < SIZE; ++lane)
+    {
+        float32 tMin = 0.0f;
+        float32 tMax = maxT[lane];
+        for (uint32 axis = 0; axis < 3; ++axis)
+        {
+            const float32 inv = invDirection[axis][lane];
+            const float32 nearPlane = (inv >= 0.0f) ? box.min.data[axis] : box.max.data[axis];
+            const float32 farPlane = (inv >= 0.0f) ? box.max.data[axis] : box.min.data[axis];
+            const float32 tNear = (nearPlane - origin[axis][lane]) * inv;
+            const float32 tFar = (farPlane - origin[axis][lane]) * inv;
+            if (tNear > tMin)
+                tMin = tNear;
+            if (tFar < tMax)
+                tMax = tFar;
+        }
+        if (tMin <= tMax)
+        {
+            mask |= 1 << lane;
+        }
+    }
+    return mask;
+#endif
+}
+
+bool BoundingVolumeHierarchy::IntersectBox(const Ray3Optimized& ray, const AABBox3& box, float32 maxT, float32& resultT)
+{
+    float32 tMin = 0.0f;
+    float32 tMax = maxT;
+    for (uint32 axis = 0; axis < 3; ++axis)
+    {
+        const float32 inv = ray.invDirection.data[axis];
+        const float32 nearPlane = (inv >= 0.0f) ? box.min.data[axis] : box.max.data[axis];
+        const float32 farPlane = (inv >= 0.0f) ? box.max.data[axis] : box.min.data[axis];
+        const float32 tNear = (nearPlane - ray.origin.data[axis]) * inv;
+        const float32 tFar = (farPlane - ray.origin.data[axis]) * inv;
+        // comparisons with NaN are false, so such slab doesn't limit interval
+        if (tNear > tMin)
+            tMin = tNear;
+        if (tFar < tMax)
+            tMax = tFar;
+    }
+    resultT = tMin;
+    return tMin <= tMax;
+}
+
+void BoundingVolumeHierarchy::Build(const Vector<AABBox3>& primitiveBoxes, uint32 maxPrimitivesInLeaf)
+{
+    DVASSERT(maxPrimitivesInLeaf > 0 && maxPrimitivesInLeaf <= std::numeric_limits<uint16>::max());
+
+    Clear();
+
+    const uint32 primitivesCount = uint32(primitiveBoxes.size());
+    if (primitivesCount == 0)
+        return;
+
+    primitives.resize(primitivesCount);
+    Vector<Vector3> centroids(primitivesCount);
+    for (uint32 i = 0; i < primitivesCount; ++i)
+    {
+        primitives[i] = i;
+        centroids[i] = primitiveBoxes[i].GetCenter();
+    }
+
+    nodes.reserve(2 * primitivesCount / maxPrimitivesInLeaf + 1);
+    BuildRecursive(0, primitivesCount, 0, primitiveBoxes, centroids, maxPrimitivesInLeaf);
+    nodes.shrink_to_fit();
+}
+
+void BoundingVolumeHierarchy::Clear()
+{
+    nodes.clear();
+    primitives.clear();
+    depth = 0;
+}
+
+uint32 BoundingVolumeHierarchy::BuildRecursive(uint32 begin, uint32 end, uint32 level, const Vector<AABBox3>& primitiveBoxes, const Vector<Vector3>& centroids, uint32 maxPrimitivesInLeaf)
+{
+    using namespace BoundingVolumeHierarchyDetails;
+
+    const uint32 nodeIndex = uint32(nodes.size());
+    nodes.emplace_back();
+    depth = Max(depth, level + 1);
+
+    AABBox3 bbox;
+    AABBox3 centroidsBox;
+    for (uint32 i = begin; i < end; ++i)
+    {
+        bbox.AddAABBox(primitiveBoxes[primitives[i]]);
+        centroidsBox.AddPoint(centroids[primitives[i]]);
+    }
+    nodes[nodeIndex].bbox = bbox;
+
+    const uint32 count = end - begin;
+    const Vector3 extent = centroidsBox.GetSize();
+    uint32 axis = (extent.y > extent.x) ? 1 : 0;
+    if (extent.z > extent.data[axis])
+    {
+        axis = 2;
+    }
+
+    bool makeLeaf = (count <= maxPrimitivesInLeaf);
+    uint32 middle = begin;
+    if (count > 1 && extent.data[axis] > 0.0f)
+    {
+        const float32 axisMin = centroidsBox.min.data[axis];
+        const float32 binScale = float32(BINS_COUNT) / extent.data[axis];
+        auto getBin = [&](uint32 primitive) {
+            const uint32 bin = uint32((centroids[primitive].data[axis] - axisMin) * binScale);
+            return Min(bin, BINS_COUNT - 1);
+        };
+
+        AABBox3 binBoxes[BINS_COUNT];
+        uint32 binCounts[BINS_COUNT] = {};
+        for (uint32 i = begin; i < end; ++i)
+        {
+            const uint32 bin = getBin(primitives[i]);
+            binCounts[bin]++;
+            binBoxes[bin].AddAABBox(primitiveBoxes[primitives[i]]);
+        }
+
+        // Split `b` puts bins [0, b) to the left child and bins [b, BINS_COUNT) to the right one
+        float32 rightAreas[BINS_COUNT] = {};
+        uint32 rightCounts[BINS_COUNT] = {};
+        AABBox3 rightBox;
+        uint32 rightCount = 0;
+        for (uint32 b = BINS_COUNT - 1; b > 0; --b)
+        {
+            rightBox.AddAABBox(binBoxes[b]);
+            rightCount += binCounts[b];
+            rightAreas[b] = GetSurfaceArea(rightBox);
+            rightCounts[b] = rightCount;
+        }
+
+        AABBox3 leftBox;
+        uint32 leftCount = 0;
+        uint32 bestSplit = 0;
+        float32 bestCost = FLOAT_MAX;
+        for (uint32 b = 1; b < BINS_COUNT; ++b)
+        {
+            leftBox.AddAABBox(binBoxes[b - 1]);
+            leftCount += binCounts[b - 1];
+            if (leftCount == 0 || rightCounts[b] == 0)
+                continue;
+
+            const float32 cost = GetSurfaceArea(leftBox) * float32(leftCount) + rightAreas[b] * float32(rightCounts[b]);
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestSplit = b;
+            }
+        }
+
+        if (bestSplit != 0)
+        {
+            const float32 nodeArea = GetSurfaceArea(bbox);
+            const float32 splitCost = TRAVERSAL_COST + ((nodeArea > 0.0f) ? (bestCost / nodeArea) : 0.0f);
+            if (!makeLeaf || splitCost < float32(count))
+            {
+                makeLeaf = false;
+                auto it = std::partition(primitives.begin() + begin, primitives.begin() + end, [&](uint32 primitive) {
+                    return getBin(primitive) < bestSplit;
+                });
+                middle = uint32(it - primitives.begin());
+            }
+        }
+    }
+
+    if (makeLeaf)
+    {
+        Node& node = nodes[nodeIndex];
+        node.offset = begin;
+        node.count = uint16(count);
+        return nodeIndex;
+    }
+
+    if (middle == begin || middle == end)
+    {
+        // All centroids are in one point, primitives are split in half
+        middle = begin + count / 2;
+    }
+
+    BuildRecursive(begin, middle, level + 1, primitiveBoxes, centroids, maxPrimitivesInLeaf);
+    const uint32 rightIndex = BuildRecursive(middle, end, level + 1, primitiveBoxes, centroids, maxPrimitivesInLeaf);
+
+    Node& node = nodes[nodeIndex];
+    node.offset = rightIndex;
+    node.axis = uint16(axis);
+    return nodeIndex;
+}
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/BaseMath.h"
+
+namespace DAVA
+{
+/**
+    \brief Bounding volume hierarchy over abstract primitives given by their bounding boxes.
+    Tree is built with binned surface area heuristic (SAH). Nodes are stored in depth-first order:
+    left child of inner node follows it, `offset` of inner node is index of its right child.
+    Leaf node refers to range [offset, offset + count) of primitive indices returned by GetPrimitives().
+ */
+class BoundingVolumeHierarchy
+{
+public:
+    struct Node
+    {
+        AABBox3 bbox;
+        uint32 offset = 0;
+        uint16 count = 0; // 0 for inner nodes
+        uint16 axis = 0; // split axis of inner node
+
+        bool IsLeaf() const
+        {
+            return count != 0;
+        }
+    };
+
+    /**
+        Up to SIZE rays, which are traversed through hierarchy together.
+        Rays are stored as structure of arrays, so box test is done for all of them at once.
+        Lane with negative `maxT` is inactive.
+     */
+    struct RayPacket
+    {
+        static const uint32 SIZE = 4;
+
+        alignas(16) float32 origin[3][SIZE];
+        alignas(16) float32 invDirection[3][SIZE];
+        alignas(16) float32 maxT[SIZE];
+
+        RayPacket();
+        void SetRay(uint32 lane, const Ray3Optimized& ray, float32 rayMaxT);
+        /** Return bit mask of active lanes whose rays intersect `box` closer than their `maxT`. */
+        uint32 IntersectBox(const AABBox3& box) const;
+    };
+
+    /**
+        Stack of node indices for traversal. It is placed on stack of caller
+        unless hierarchy is too deep, in that case it is allocated in heap.
+     */
+    class TraversalStack
+    {
+    public:
+        TraversalStack(const BoundingVolumeHierarchy& hierarchy);
+
+        void Push(uint32 nodeIndex);
+        uint32 Pop();
+        bool IsEmpty() const;
+
+    private:
+        static const uint32 FIXED_SIZE = 64;
+
+        uint32 fixedStack[FIXED_SIZE];
+        Vector<uint32> heapStack;
+        uint32* stack = fixedStack;
+        uint32 size = 0;
+    };
+
+    void Build(const Vector<AABBox3>& primitiveBoxes, uint32 maxPrimitivesInLeaf);
+    void Clear();
+    /** Free primitive indices of leaves, when caller has copied them to its own leaf data. */
+    void ReleasePrimitives();
+
+    const Vector<Node>& GetNodes() const;
+    Vector<Node>& GetNodes();
+    const Vector<uint32>& GetPrimitives() const;
+    uint32 GetDepth() const;
+
+    /** Slab test of `ray` against `box` limited by [0, maxT]. NaN produced by rays lying in slab planes is treated as hit. */
+    static bool IntersectBox(const Ray3Optimized& ray, const AABBox3& box, float32 maxT, float32& resultT);
+
+private:
+    uint32 BuildRecursive(uint32 begin, uint32 end, uint32 level, const Vector<AABBox3>& primitiveBoxes, const Vector<Vector3>& centroids, uint32 maxPrimitivesInLeaf);
+
+    Vector<Node> nodes;
+    Vector<uint32> primitives;
+    uint32 depth = 0;
+};
+
+inline const Vector<BoundingVolumeHierarchy::Node>& BoundingVolumeHierarchy::GetNodes() const
+{
+    return nodes;
+}
+
+inline Vector<BoundingVolumeHierarchy::Node>& BoundingVolumeHierarchy::GetNodes()
+{
+    return nodes;
+}
+
+inline const Vector<uint32>& BoundingVolumeHierarchy::GetPrimitives() const
+{
+    return primitives;
+}
+
+inline void BoundingVolumeHierarchy::ReleasePrimitives()
+{
+    Vector<uint32>().swap(primitives);
+}
+
+inline uint32 BoundingVolumeHierarchy::GetDepth() const
+{
+    return depth;
+}
+
+inline BoundingVolumeHierarchy::TraversalStack::TraversalStack(const BoundingVolumeHierarchy& hierarchy)
+{
+    // Depth-first traversal keeps at most one pending sibling per level
+    if (hierarchy.GetDepth() + 1 > FIXED_SIZE)
+    {
+        heapStack.resize(hierarchy.GetDepth() + 1);
+        stack = heapStack.data();
+    }
+}
+
+inline void BoundingVolumeHierarchy::TraversalStack::Push(uint32 nodeIndex)
+{
+    stack[size++] = nodeIndex;
+}
+
+inline uint32 BoundingVolumeHierarchy::TraversalStack::Pop()
+{
+    return stack[--size];
+}
+
+inline bool BoundingVolumeHierarchy::TraversalStack::IsEmpty() const
+{
+    return size == 0;
+}
+}
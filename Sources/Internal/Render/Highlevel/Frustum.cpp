@@ -1,6 +1,12 @@
 #include "Render/RenderHelper.h"
 #include "Render/Highlevel/Frustum.h"
 #include <Render/2D/Systems/RenderSystem2D.h>
+#include "Math/SSE/SSEMath.h"
+
+#if !defined(__DAVAENGINE_SSE__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define FRUSTUM_USE_NEON 1
+#include <arm_neon.h>
+#endif
 
 namespace DAVA
 {
@@ -332,6 +338,76 @@ bool Frustum::IsInside(const AABBox3& box, uint8 planeMask, uint8& startClipping
     return true;
 }
 
+uint32 Frustum::IsInside4(const float32* boxes, uint8 planeMask) const
+{
+    // For each plane test vertex nearest to inner side of plane (selected by planeAccesBits as in IsInside),
+    // if it is outside then the whole box is outside
+    const float32* verts[2][3] = { { boxes, boxes + 4, boxes + 8 }, { boxes + 12, boxes + 16, boxes + 20 } };
+    uint32 currPlaneAccess = planeAccesBits;
+
+#if defined(__DAVAENGINE_SSE__)
+    const __m128 zero = _mm_setzero_ps();
+    __m128 outside = zero;
+    for (int32 i = 0; i < planeCount; ++i, currPlaneAccess >>= 3)
+    {
+        if ((planeMask & (1 << i)) == 0)
+            continue;
+
+        const Plane& plane = planeArray[i];
+        __m128 x = _mm_loadu_ps(verts[currPlaneAccess & 1][0]);
+        __m128 y = _mm_loadu_ps(verts[(currPlaneAccess >> 1) & 1][1]);
+        __m128 z = _mm_loadu_ps(verts[(currPlaneAccess >> 2) & 1][2]);
+        __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.n.x)), _mm_mul_ps(y, _mm_set1_ps(plane.n.y))),
+                                     _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(plane.n.z)), _mm_set1_ps(plane.d)));
+        outside = _mm_or_ps(outside, _mm_cmpgt_ps(distance, zero));
+        if (_mm_movemask_ps(outside) == 0xf)
+            return 0;
+    }
+    return ~static_cast<uint32>(_mm_movemask_ps(outside)) & 0xf;
+#elif defined(FRUSTUM_USE_NEON)
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    uint32x4_t outside = vdupq_n_u32(0);
+    for (int32 i = 0; i < planeCount; ++i, currPlaneAccess >>= 3)
+    {
+        if ((planeMask & (1 << i)) == 0)
+            continue;
+
+        const Plane& plane = planeArray[i];
+        float32x4_t distance = vdupq_n_f32(plane.d);
+        distance = vmlaq_n_f32(distance, vld1q_f32(verts[currPlaneAccess & 1][0]), plane.n.x);
+        distance = vmlaq_n_f32(distance, vld1q_f32(verts[(currPlaneAccess >> 1) & 1][1]), plane.n.y);
+        distance = vmlaq_n_f32(distance, vld1q_f32(verts[(currPlaneAccess >> 2) & 1][2]), plane.n.z);
+        outside = vorrq_u32(outside, vcgtq_f32(distance, zero));
+    }
+    uint32 result = 0;
+    result |= (vgetq_lane_u32(outside, 0) == 0) ? 0x1 : 0;
+    result |= (vgetq_lane_u32(outside, 1) == 0) ? 0x2 : 0;
+    result |= (vgetq_lane_u32(outside, 2) == 0) ? 0x4 : 0;
+    result |= (vgetq_lane_u32(outside, 3) == 0) ? 0x8 : 0;
+    return result;
+#else
+    uint32 result = 0xf;
+    for (int32 i = 0; i < planeCount; ++i, currPlaneAccess >>= 3)
+    {
+        if ((planeMask & (1 << i)) == 0)
+            continue;
+
+        const Plane& plane = planeArray[i];
+        const float32* x = verts[currPlaneAccess & 1][0];
+        const float32* y = verts[(currPlaneAccess >> 1) & 1][1];
+        const float32* z = verts[(currPlaneAccess >> 2) & 1][2];
+        for (uint32 k = 0; k < 4; ++k)
+        {
+            if (plane.DistanceToPoint(x[k], y[k], z[k]) > 0.0f)
+                result &= ~(1 << k);
+        }
+        if (result == 0)
+            return 0;
+    }
+    return result;
+#endif
+}
+
 //! \brief check bounding sphere visibility against frustum
 //! \param point sphere center point
 //! \param radius sphere radius
@@ -66,6 +66,12 @@ public:
     //! \param box bounding box
     bool IsFullyInside(const AABBox3& box) const;
 
+    //! \brief Check visibility of 4 axial aligned bounding boxes at once, uses SIMD if available
+    //! \param boxes 4 boxes in SoA layout: minX[4], minY[4], minZ[4], maxX[4], maxY[4], maxZ[4]
+    //! \param planeMask mask of planes to check, as in IsInside
+    //! \return bit mask of boxes which are inside, bit i corresponds to i-th box
+    uint32 IsInside4(const float32* boxes, uint8 planeMask) const;
+
     // *********************************************
     // All above require detailed testing !!! Never tested in real project!!!
     // *********************************************
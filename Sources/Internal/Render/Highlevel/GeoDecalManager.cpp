@@ -5,6 +5,7 @@
 #include "Render/Highlevel/RenderPassNames.h"
 #include "Reflection/Reflection.h"
 #include "FileSystem/FileSystem.h"
+#include "Math/MathBatch.h"
 
 namespace DAVA
 {
@@ -160,10 +161,10 @@ GeoDecalManager::Decal GeoDecalManager::BuildDecal(const DecalConfig& config, co
     view._data[2][1] = up.z;
     view._data[2][2] = dir.z;
 
+    MathBatch::TransformPoints(boxCorners, 8, worldToObject, boxCorners);
     for (uint32 i = 0; i < 8; ++i)
     {
-        Vector3 objectPos = boxCorners[i] * worldToObject;
-        Vector3 t = MultiplyVectorMat3x3(objectPos, view);
+        Vector3 t = MultiplyVectorMat3x3(boxCorners[i], view);
         boxMin.x = std::min(boxMin.x, t.x);
         boxMin.y = std::min(boxMin.y, t.y);
         boxMin.z = std::min(boxMin.z, t.z);
@@ -322,15 +323,15 @@ void GeoDecalManager::GetStaticMeshGeometry(const DecalBuildInfo& info, const De
     uint8 decalVertexData_tmp[MAX_CLIPPED_POLYGON_CAPACITY * sizeof(DecalVertex)] = {};
     DecalVertex* points_tmp = reinterpret_cast<DecalVertex*>(decalVertexData_tmp);
 
-    Vector<uint16> triangles;
+    Vector<uint32> triangles;
     triangles.reserve(512);
     info.polygonGroup->GetGeometryOctTree()->GetTrianglesInBox(info.boundingBox, triangles);
 
     int32 geometryFormat = info.polygonGroup->GetFormat();
 
-    for (uint16 triangleIndex : triangles)
+    for (uint32 triangleIndex : triangles)
     {
-        uint16 idx[3];
+        uint32 idx[3];
         info.polygonGroup->GetTriangleIndices(3 * triangleIndex, idx);
         info.polygonGroup->GetCoord(idx[0], points[0].originalPoint);
         info.polygonGroup->GetCoord(idx[1], points[1].originalPoint);
@@ -400,7 +401,7 @@ void GeoDecalManager::GetSkinnedMeshGeometry(const DecalBuildInfo& info, const D
     uint32 triangleCount = static_cast<uint32>(info.polygonGroup->GetIndexCount() / 3);
     for (uint32 triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex)
     {
-        uint16 idx[3];
+        uint32 idx[3];
         info.polygonGroup->GetTriangleIndices(3 * triangleIndex, idx);
         for (int32 j = 0; j < 3; ++j)
         {
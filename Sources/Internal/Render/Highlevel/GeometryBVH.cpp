@@ -0,0 +1,300 @@
+#include "Render/Highlevel/GeometryBVH.h"
+#include "Render/3D/PolygonGroup.h"
+#include "Math/SSE/SSEMath.h"
+
+namespace DAVA
+{
+void GeometryBVH::BuildTree(PolygonGroup* geometry)
+{
+    const uint32 trianglesCount = uint32(geometry->GetIndexCount() / 3);
+
+    Vector<Vector3> coords(trianglesCount * 3);
+    Vector<AABBox3> triangleBoxes(trianglesCount);
+    for (uint32 triangle = 0; triangle < trianglesCount; ++triangle)
+    {
+        for (uint32 k = 0; k < 3; ++k)
+        {
+            int32 index = 0;
+            geometry->GetIndex(int32(triangle * 3 + k), index);
+            geometry->GetCoord(index, coords[triangle * 3 + k]);
+            triangleBoxes[triangle].AddPoint(coords[triangle * 3 + k]);
+        }
+    }
+
+    hierarchy.Build(triangleBoxes, MAX_TRIANGLES_IN_LEAF);
+
+    // Replace triangles range of each leaf with range of packs
+    packs.clear();
+    const Vector<uint32>& triangles = hierarchy.GetPrimitives();
+    for (BoundingVolumeHierarchy::Node& node : hierarchy.GetNodes())
+    {
+        if (!node.IsLeaf())
+            continue;
+
+        const uint32 firstPack = uint32(packs.size());
+        for (uint32 first = 0; first < node.count; first += TrianglePack::SIZE)
+        {
+            // Unused lanes stay zero: triangle with zero edges is never hit
+            TrianglePack pack = {};
+            for (uint32 lane = 0; lane < TrianglePack::SIZE; ++lane)
+            {
+                pack.triangleIndex[lane] = uint32(-1);
+                if (first + lane >= node.count)
+                    continue;
+
+                const uint32 triangle = triangles[node.offset + first + lane];
+                const Vector3& p0 = coords[triangle * 3 + 0];
+                const Vector3 edge1 = coords[triangle * 3 + 1] - p0;
+                const Vector3 edge2 = coords[triangle * 3 + 2] - p0;
+                for (uint32 axis = 0; axis < 3; ++axis)
+                {
+                    pack.v0[axis][lane] = p0.data[axis];
+                    pack.edge1[axis][lane] = edge1.data[axis];
+                    pack.edge2[axis][lane] = edge2.data[axis];
+                }
+                pack.triangleIndex[lane] = triangle;
+            }
+            packs.push_back(pack);
+        }
+
+        node.offset = firstPack;
+        node.count = uint16(uint32(packs.size()) - firstPack);
+    }
+    packs.shrink_to_fit();
+    hierarchy.ReleasePrimitives();
+}
+
+bool GeometryBVH::IntersectionWithRay(const Ray3Optimized& ray, float32& result, uint32& resultTriIndex, float32 maxT) const
+{
+    const Vector<BoundingVolumeHierarchy::Node>& nodes = hierarchy.GetNodes();
+    if (nodes.empty())
+        return false;
+
+    result = maxT;
+    resultTriIndex = -1;
+    bool isIntersection = false;
+
+    BoundingVolumeHierarchy::TraversalStack stack(hierarchy);
+    stack.Push(0);
+    while (!stack.IsEmpty())
+    {
+        const uint32 nodeIndex = stack.Pop();
+        const BoundingVolumeHierarchy::Node& node = nodes[nodeIndex];
+
+        // Box is tested on pop, so it is clipped by the nearest hit found so far
+        float32 boxT = 0.0f;
+        if (!BoundingVolumeHierarchy::IntersectBox(ray, node.bbox, result, boxT))
+            continue;
+
+        if (node.IsLeaf())
+        {
+            isIntersection |= IntersectLeaf(ray, node, result, resultTriIndex);
+        }
+        else if (ray.direction.data[node.axis] < 0.0f)
+        {
+            stack.Push(nodeIndex + 1);
+            stack.Push(node.offset);
+        }
+        else
+        {
+            stack.Push(node.offset);
+            stack.Push(nodeIndex + 1);
+        }
+    }
+    return isIntersection;
+}
+
+uint32 GeometryBVH::IntersectionWithRays(const Ray3Optimized* rays, uint32 raysCount, float32* results, uint32* resultTriIndices) const
+{
+    const Vector<BoundingVolumeHierarchy::Node>& nodes = hierarchy.GetNodes();
+    if (nodes.empty())
+        return 0;
+
+    const uint32 packetSize = BoundingVolumeHierarchy::RayPacket::SIZE;
+    uint32 hitsCount = 0;
+
+    BoundingVolumeHierarchy::TraversalStack stack(hierarchy);
+    for (uint32 first = 0; first < raysCount; first += packetSize)
+    {
+        const uint32 count = Min(packetSize, raysCount - first);
+        BoundingVolumeHierarchy::RayPacket packet;
+        for (uint32 lane = 0; lane < count; ++lane)
+        {
+            packet.SetRay(lane, rays[first + lane], results[first + lane]);
+        }
+
+        uint32 hitsMask = 0;
+        stack.Push(0);
+        while (!stack.IsEmpty())
+        {
+            const uint32 nodeIndex = stack.Pop();
+            const BoundingVolumeHierarchy::Node& node = nodes[nodeIndex];
+
+            const uint32 lanesMask = packet.IntersectBox(node.bbox);
+            if (lanesMask == 0)
+                continue;
+
+            if (node.IsLeaf())
+            {
+                for (uint32 lane = 0; lane < count; ++lane)
+                {
+                    const uint32 laneBit = 1 << lane;
+                    if ((lanesMask & laneBit) == 0)
+                        continue;
+
+                    const uint32 rayIndex = first + lane;
+                    if (IntersectLeaf(rays[rayIndex], node, results[rayIndex], resultTriIndices[rayIndex]))
+                    {
+                        packet.maxT[lane] = results[rayIndex];
+                        hitsMask |= laneBit;
+                    }
+                }
+            }
+            else
+            {
+                // Children order is chosen by first ray of packet that hits the node
+                uint32 lane = 0;
+                while ((lanesMask & (1 << lane)) == 0)
+                {
+                    ++lane;
+                }
+
+                if (packet.invDirection[node.axis][lane] < 0.0f)
+                {
+                    stack.Push(nodeIndex + 1);
+                    stack.Push(node.offset);
+                }
+                else
+                {
+                    stack.Push(node.offset);
+                    stack.Push(nodeIndex + 1);
+                }
+            }
+        }
+
+        for (uint32 lane = 0; lane < count; ++lane)
+        {
+            hitsCount += (hitsMask >> lane) & 1;
+        }
+    }
+    return hitsCount;
+}
+
+bool GeometryBVH::IntersectLeaf(const Ray3Optimized& ray, const BoundingVolumeHierarchy::Node& leaf, float32& result, uint32& resultTriIndex) const
+{
+    // Moller-Trumbore test, the same as in Intersection::RayTriangle, for four triangles at once
+    bool isIntersection = false;
+
+#if defined(__DAVAENGINE_SSE__)
+    const __m128 dx = _mm_set1_ps(ray.direction.x);
+    const __m128 dy = _mm_set1_ps(ray.direction.y);
+    const __m128 dz = _mm_set1_ps(ray.direction.z);
+    const __m128 ox = _mm_set1_ps(ray.origin.x);
+    const __m128 oy = _mm_set1_ps(ray.origin.y);
+    const __m128 oz = _mm_set1_ps(ray.origin.z);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 epsilon = _mm_set1_ps(EPSILON);
+    const __m128 negativeEpsilon = _mm_set1_ps(-EPSILON);
+
+    for (uint32 p = leaf.offset; p < leaf.offset + leaf.count; ++p)
+    {
+        const TrianglePack& pack = packs[p];
+        const __m128 e1x = _mm_loadu_ps(pack.edge1[0]);
+        const __m128 e1y = _mm_loadu_ps(pack.edge1[1]);
+        const __m128 e1z = _mm_loadu_ps(pack.edge1[2]);
+        const __m128 e2x = _mm_loadu_ps(pack.edge2[0]);
+        const __m128 e2y = _mm_loadu_ps(pack.edge2[1]);
+        const __m128 e2z = _mm_loadu_ps(pack.edge2[2]);
+
+        // pvector = CrossProduct(direction, edge2)
+        const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+        const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+        const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+
+        const __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(px, e1x), _mm_mul_ps(py, e1y)), _mm_mul_ps(pz, e1z));
+        __m128 mask = _mm_or_ps(_mm_cmple_ps(det, negativeEpsilon), _mm_cmpge_ps(det, epsilon));
+        if (_mm_movemask_ps(mask) == 0)
+            continue;
+
+        const __m128 invDet = _mm_div_ps(one, det);
+
+        const __m128 tx = _mm_sub_ps(ox, _mm_loadu_ps(pack.v0[0]));
+        const __m128 ty = _mm_sub_ps(oy, _mm_loadu_ps(pack.v0[1]));
+        const __m128 tz = _mm_sub_ps(oz, _mm_loadu_ps(pack.v0[2]));
+
+        const __m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz)), invDet);
+        mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+
+        // qvector = CrossProduct(tvector, edge1)
+        const __m128 qx = _mm_sub_ps(_mm_mul_ps(ty, e1z), _mm_mul_ps(tz, e1y));
+        const __m128 qy = _mm_sub_ps(_mm_mul_ps(tz, e1x), _mm_mul_ps(tx, e1z));
+        const __m128 qz = _mm_sub_ps(_mm_mul_ps(tx, e1y), _mm_mul_ps(ty, e1x));
+
+        const __m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), invDet);
+        mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+
+        const __m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+        mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(t, zero), _mm_cmplt_ps(t, _mm_set1_ps(result))));
+
+        const int32 hitMask = _mm_movemask_ps(mask);
+        if (hitMask == 0)
+            continue;
+
+        float32 hitT[TrianglePack::SIZE];
+        _mm_storeu_ps(hitT, t);
+        for (uint32 lane = 0; lane < TrianglePack::SIZE; ++lane)
+        {
+            if ((hitMask & (1 << lane)) && hitT[lane] < result)
+            {
+                isIntersection = true;
+                result = hitT[lane];
+                resultTriIndex = pack.triangleIndex[lane];
+            }
+        }
+    }
+#else
+    for (uint32 p = leaf.offset; p < leaf.offset + leaf.count; ++p)
+    {
+        const TrianglePack& pack = packs[p];
+        for (uint32 lane = 0; lane < TrianglePack::SIZE; ++lane)
+        {
+            const Vector3 edge1(pack.edge1[0][lane], pack.edge1[1][lane], pack.edge1[2][lane]);
+            const Vector3 edge2(pack.edge2[0][lane], pack.edge2[1][lane], pack.edge2[2][lane]);
+            const Vector3 pvector = CrossProduct(ray.direction, edge2);
+
+            const float32 det = DotProduct(pvector, edge1);
+            if (det > -EPSILON && det < EPSILON)
+                continue;
+
+            const float32 invDet = 1.0f / det;
+            const Vector3 tvector = ray.origin - Vector3(pack.v0[0][lane], pack.v0[1][lane], pack.v0[2][lane]);
+            const float32 u = DotProduct(tvector, pvector) * invDet;
+            if (u < 0.0f || u > 1.0f)
+                continue;
+
+            const Vector3 qvector = CrossProduct(tvector, edge1);
+            const float32 v = DotProduct(ray.direction, qvector) * invDet;
+            if (v < 0.0f || (u + v) > 1.0f)
+                continue;
+
+            const float32 t = DotProduct(edge2, qvector) * invDet;
+            if (t >= 0.0f && t < result)
+            {
+                isIntersection = true;
+                result = t;
+                resultTriIndex = pack.triangleIndex[lane];
+            }
+        }
+    }
+#endif
+
+    return isIntersection;
+}
+
+uint32 GeometryBVH::GetAllocatedMemorySize() const
+{
+    return uint32(hierarchy.GetNodes().capacity() * sizeof(BoundingVolumeHierarchy::Node) +
+                  packs.capacity() * sizeof(TrianglePack));
+}
+}
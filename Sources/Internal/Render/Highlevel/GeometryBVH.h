@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/BaseMath.h"
+#include "Render/Highlevel/BoundingVolumeHierarchy.h"
+
+namespace DAVA
+{
+class PolygonGroup;
+
+/**
+    \brief Bounding volume hierarchy over triangles of PolygonGroup for ray casting.
+    Triangles of each leaf are stored in groups of four (with precomputed edges) and are tested against ray at once.
+    Unlike GeometryOctTree each triangle is referenced by one leaf only, and traversal visits nearest child first
+    and stops as soon as closer hit is impossible.
+ */
+class GeometryBVH
+{
+public:
+    static const uint32 MAX_TRIANGLES_IN_LEAF = 8;
+
+    void BuildTree(PolygonGroup* geometry);
+
+    /**
+        Find nearest intersection of `ray` with geometry. Result is the same as GeometryOctTree::IntersectionWithRay.
+        Intersections that are not closer than `maxT` are skipped, so caller can pass its nearest hit to cut traversal.
+     */
+    bool IntersectionWithRay(const Ray3Optimized& ray, float32& result, uint32& resultTriIndex, float32 maxT = FLOAT_MAX) const;
+
+    /**
+        Find nearest intersections of `raysCount` rays with geometry. Rays are traversed in packets, so coherent rays
+        (e.g. from one origin) share node tests. Intersection is searched in [0, results[i]), so `results` should be
+        initialized by caller (e.g. with FLOAT_MAX). `results` and `resultTriIndices` are updated for rays that hit geometry.
+        Return number of such rays.
+     */
+    uint32 IntersectionWithRays(const Ray3Optimized* rays, uint32 raysCount, float32* results, uint32* resultTriIndices) const;
+
+    uint32 GetAllocatedMemorySize() const;
+
+private:
+    struct TrianglePack
+    {
+        static const uint32 SIZE = 4;
+
+        float32 v0[3][SIZE];
+        float32 edge1[3][SIZE];
+        float32 edge2[3][SIZE];
+        uint32 triangleIndex[SIZE];
+    };
+
+    bool IntersectLeaf(const Ray3Optimized& ray, const BoundingVolumeHierarchy::Node& leaf, float32& result, uint32& resultTriIndex) const;
+
+    BoundingVolumeHierarchy hierarchy;
+    Vector<TrianglePack> packs;
+};
+}
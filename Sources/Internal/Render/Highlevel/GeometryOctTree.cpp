@@ -49,9 +49,9 @@ void GeometryOctTree::BuildTree(PolygonGroup* _geometry)
     geometry = _geometry;
 
     uint32 trianglesCount = static_cast<uint32>(geometry->GetIndexCount() / 3);
-    Vector<uint16> triangles(trianglesCount);
+    Vector<uint32> triangles(trianglesCount);
     for (uint32 triangle = 0; triangle < trianglesCount; ++triangle)
-        triangles[triangle] = static_cast<uint16>(triangle);
+        triangles[triangle] = triangle;
 
     nodes.resize(16);
     nextFreeIndex = 1; // count 0 index already busy for root Node
@@ -76,21 +76,21 @@ void GeometryOctTree::BuildTree(PolygonGroup* _geometry)
 
     avgTriangleCount /= (float32)leafs.size();
 
-    Map<uint16, uint32> overlapCount;
-    for (uint16 triangle = 0; triangle < static_cast<uint16>(geometry->GetIndexCount()) / 3; ++triangle)
+    Map<uint32, uint32> overlapCount;
+    for (uint32 triangle = 0; triangle < static_cast<uint32>(geometry->GetIndexCount()) / 3; ++triangle)
     {
         overlapCount[triangle] = 0;
     }
 
     for (auto& leaf : leafs)
     {
-        for (uint16& index : leaf)
+        for (uint32& index : leaf)
         {
             overlapCount[index]++;
         }
     }
 
-    for (uint16 triangle = 0; triangle < static_cast<uint16>(geometry->GetIndexCount()) / 3; ++triangle)
+    for (uint32 triangle = 0; triangle < static_cast<uint32>(geometry->GetIndexCount()) / 3; ++triangle)
     {
         // DVASSERT(overlapCount[triangle] != 0); // triangle should be at least in one leaf.
         if (overlapCount[triangle] == 0)
@@ -104,7 +104,7 @@ void GeometryOctTree::BuildTree(PolygonGroup* _geometry)
     Map<uint32, uint32> gistogram;
     for (auto& pair : overlapCount)
     {
-        uint16 index = pair.first;
+        uint32 index = pair.first;
         uint32 count = pair.second;
 
         allCount++;
@@ -127,11 +127,11 @@ uint32 GeometryOctTree::GetAllocatedMemorySize()
     uint32 size = 0;
     size += static_cast<uint32>(nodes.size() * sizeof(GeometryOctTreeNode));
     for (auto& vector : leafs)
-        size += static_cast<uint32>(vector.size() * sizeof(uint16));
+        size += static_cast<uint32>(vector.size() * sizeof(uint32));
     return size;
 }
 
-uint32 GeometryOctTree::BuildTreeRecursive(PolygonGroup* geometry, uint32 nodeIndex, const AABBox3& boundingBox, const Vector<uint16>& triangles, uint32 level, uint32 topLevelTriangles)
+uint32 GeometryOctTree::BuildTreeRecursive(PolygonGroup* geometry, uint32 nodeIndex, const AABBox3& boundingBox, const Vector<uint32>& triangles, uint32 level, uint32 topLevelTriangles)
 {
     uint32 maxLevel = level;
 
@@ -156,7 +156,7 @@ uint32 GeometryOctTree::BuildTreeRecursive(PolygonGroup* geometry, uint32 nodeIn
         return level;
     }
 
-    Vector<uint16> childrenTriangles[8];
+    Vector<uint32> childrenTriangles[8];
     for (uint32_t i = 0; i < 8; ++i)
         childrenTriangles[i].reserve(triangles.size());
 
@@ -198,9 +198,9 @@ uint32 GeometryOctTree::BuildTreeRecursive(PolygonGroup* geometry, uint32 nodeIn
                 childrenBoxes[k].min = childBoxMin;
                 childrenBoxes[k].max = childBoxMax;
 
-                for (uint16 triangleIndex : triangles)
+                for (uint32 triangleIndex : triangles)
                 {
-                    uint16 ptIndex[3];
+                    uint32 ptIndex[3];
                     geometry->GetTriangleIndices(3 * triangleIndex, ptIndex);
 
                     Vector3 ptCoord[3];
@@ -326,7 +326,7 @@ uint32 GeometryOctTree::BuildTreeRecursive(PolygonGroup* geometry, uint32 nodeIn
         {
             for (uint32 zdiv = 0; zdiv < 2; ++zdiv)
             {
-                const Vector<uint16>& childTriangles = childrenTriangles[k];
+                const Vector<uint32>& childTriangles = childrenTriangles[k];
                 if (!childTriangles.empty())
                 {
                     uint32 childNodeAbsIndex = saveFreeIndex + childIndex;
@@ -354,7 +354,7 @@ uint32 GeometryOctTree::BuildTreeRecursive(PolygonGroup* geometry, uint32 nodeIn
     return maxLevel;
 }
 
-void GeometryOctTree::GetTrianglesInBox(const AABBox3& searchBBox, Vector<uint16>& resultTriangles)
+void GeometryOctTree::GetTrianglesInBox(const AABBox3& searchBBox, Vector<uint32>& resultTriangles)
 {
     const AABBox3& boundingBox = geometry->GetBoundingBox();
     if (Intersection::BoxBox(searchBBox, boundingBox))
@@ -367,21 +367,21 @@ void GeometryOctTree::GetTrianglesInBox(const AABBox3& searchBBox, Vector<uint16
     }
 }
 
-void GeometryOctTree::RecGetTrianglesInBox(const AABBox3& searchBBox, uint32 nodeIndex, const AABBox3& boundingBox, Vector<uint16>& resultTriangles, bool isFullyInside)
+void GeometryOctTree::RecGetTrianglesInBox(const AABBox3& searchBBox, uint32 nodeIndex, const AABBox3& boundingBox, Vector<uint32>& resultTriangles, bool isFullyInside)
 {
     DVASSERT(nodeIndex >= 0 && nodeIndex < nodes.size());
     GeometryOctTreeNode& currentNode = nodes[nodeIndex];
 
     if (currentNode.isLeaf)
     {
-        Vector<uint16>& triangles = leafs[currentNode.leafDataLocation];
+        Vector<uint32>& triangles = leafs[currentNode.leafDataLocation];
         if (isFullyInside)
         {
             resultTriangles.insert(resultTriangles.end(), triangles.begin(), triangles.end());
         }
         else
         {
-            for (uint16 triangleIndex : triangles)
+            for (uint32 triangleIndex : triangles)
             {
                 int32 ptIndex[3];
                 Vector3 ptCoord[3];
@@ -633,7 +633,7 @@ bool GeometryOctTree::RayCastRecursive2(const Ray3Optimized& ray, uint32 nodeInd
 
     if (currentNode.isLeaf)
     {
-        Vector<uint16>& triangles = leafs[currentNode.leafDataLocation];
+        Vector<uint32>& triangles = leafs[currentNode.leafDataLocation];
         uint32 triangleCount = static_cast<uint32>(triangles.size());
         for (uint32 k = 0; k < triangleCount; ++k)
         {
@@ -826,7 +826,7 @@ bool GeometryOctTree::RayCastRecursive(const Ray3Optimized& ray, uint32 nodeInde
 
     if (currentNode.isLeaf)
     {
-        Vector<uint16>& triangles = leafs[currentNode.leafDataLocation];
+        Vector<uint32>& triangles = leafs[currentNode.leafDataLocation];
         uint32 triangleCount = static_cast<uint32>(triangles.size());
         for (uint32 k = 0; k < triangleCount; ++k)
         {
@@ -82,12 +82,12 @@ public:
     bool IntersectionWithRay(const Ray3Optimized& ray, float32& result, uint32& resultTriIndex);
     bool IntersectionWithRay2(const Ray3Optimized& ray, float32& result, uint32& resultTriIndex);
 
-    void GetTrianglesInBox(const AABBox3& searchBox, Vector<uint16>& resultTriangles);
+    void GetTrianglesInBox(const AABBox3& searchBox, Vector<uint32>& resultTriangles);
 
     uint32 GetAllocatedMemorySize();
 
 private:
-    uint32 BuildTreeRecursive(PolygonGroup* geometry, uint32 nodeIndex, const AABBox3& boundingBox, const Vector<uint16>& triangles, uint32 level, uint32 topLevelTriangles);
+    uint32 BuildTreeRecursive(PolygonGroup* geometry, uint32 nodeIndex, const AABBox3& boundingBox, const Vector<uint32>& triangles, uint32 level, uint32 topLevelTriangles);
 
     void DebugDrawRecursive(const Matrix4& worldMatrix, uint32 nodeIndex, const AABBox3& boundingBox, RenderHelper* renderHelper);
     bool RayCastRecursive(const Ray3Optimized& ray, uint32 nodeIndex, const AABBox3& boundingBox, float32 currentBoxT, float32& result, uint32& resultTriIndex);
@@ -102,13 +102,13 @@ private:
     inline uint32 GetIndex(uint32 xdiv, uint32 ydiv, uint32 zdiv) const;
     inline AABBox3 GetChildBox(const AABBox3& parentBox, uint32 childNodeIndex) const;
 
-    void RecGetTrianglesInBox(const AABBox3& searchBBox, uint32 nodeIndex, const AABBox3& boundingBox, Vector<uint16>& resultTriangles, bool isFullyInside);
+    void RecGetTrianglesInBox(const AABBox3& searchBBox, uint32 nodeIndex, const AABBox3& boundingBox, Vector<uint32>& resultTriangles, bool isFullyInside);
 
 private:
     Vector<Triangle> debugTriangles;
     Vector<AABBox3> debugBoxes;
     Vector<GeometryOctTreeNode> nodes;
-    Vector<Vector<uint16>> leafs;
+    Vector<Vector<uint32>> leafs;
     uint32 nextFreeIndex = 0;
     PolygonGroup* geometry = nullptr;
 };
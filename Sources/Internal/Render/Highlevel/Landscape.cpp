@@ -34,6 +34,7 @@
 #include "Concurrency/Mutex.h"
 #include "Concurrency/LockGuard.h"
 #include "Logger/Logger.h"
+#include "Math/SSE/SSEMath.h"
 
 #if defined(__DAVAENGINE_ANDROID__)
 #include "Platform/DeviceInfo.h"
@@ -41,6 +42,13 @@
 
 namespace DAVA
 {
+namespace LandscapeDetails
+{
+const uint32 HEIGHT_QUERY_LANES = 4;
+// Points of PlacePoints are processed by chunks of this size, so temporary arrays are kept on stack
+const uint32 PLACE_POINTS_CHUNK_SIZE = 64;
+}
+
 DAVA_VIRTUAL_REFLECTION_IMPL(Landscape)
 {
     ReflectionRegistrator<Landscape>::Begin()
@@ -673,6 +681,179 @@ bool Landscape::PlacePoint(const Vector3& worldPoint, Vector3& result, Vector3*
     return true;
 };
 
+uint32 Landscape::GetHeightsAtPoints(const Vector3* points, uint32 count, float32* heights, bool* valid) const
+{
+    using namespace LandscapeDetails;
+
+    int32 hmSize = GetHeightmapSize();
+    if (hmSize == 0)
+    {
+        if (count != 0)
+        {
+            Logger::Error("[Landscape::GetHeightsAtPoints] Trying to get height at point using empty heightmap data!");
+        }
+        if (valid != nullptr)
+        {
+            std::fill(valid, valid + count, false);
+        }
+        return 0;
+    }
+
+    const float32 size = static_cast<float32>(hmSize);
+    const float32 heightScale = bbox.max.z - bbox.min.z;
+
+    uint32 validCount = 0;
+    for (uint32 first = 0; first < count; first += HEIGHT_QUERY_LANES)
+    {
+        const uint32 lanes = Min(HEIGHT_QUERY_LANES, count - first);
+
+        // Heights of cell corners are fetched one by one, only interpolation is done for all lanes at once
+        alignas(16) float32 h00[HEIGHT_QUERY_LANES] = {};
+        alignas(16) float32 h01[HEIGHT_QUERY_LANES] = {};
+        alignas(16) float32 h10[HEIGHT_QUERY_LANES] = {};
+        alignas(16) float32 h11[HEIGHT_QUERY_LANES] = {};
+        alignas(16) float32 dx[HEIGHT_QUERY_LANES] = {};
+        alignas(16) float32 dy[HEIGHT_QUERY_LANES] = {};
+        alignas(16) float32 value[HEIGHT_QUERY_LANES];
+        bool inside[HEIGHT_QUERY_LANES] = {};
+
+        for (uint32 lane = 0; lane < lanes; ++lane)
+        {
+            const Vector3& point = points[first + lane];
+            if ((point.x > bbox.max.x) || (point.x < bbox.min.x) || (point.y > bbox.max.y) || (point.y < bbox.min.y))
+                continue;
+
+            float32 fx = size * (point.x - bbox.min.x) / (bbox.max.x - bbox.min.x);
+            float32 fy = size * (point.y - bbox.min.y) / (bbox.max.y - bbox.min.y);
+            uint16 x = static_cast<uint16>(fx);
+            uint16 y = static_cast<uint16>(fy);
+
+            h00[lane] = static_cast<float32>(heightmap->GetHeightClamp(x, y));
+            h01[lane] = static_cast<float32>(heightmap->GetHeightClamp(x + 1, y));
+            h10[lane] = static_cast<float32>(heightmap->GetHeightClamp(x, y + 1));
+            h11[lane] = static_cast<float32>(heightmap->GetHeightClamp(x + 1, y + 1));
+            dx[lane] = fx - static_cast<float32>(x);
+            dy[lane] = fy - static_cast<float32>(y);
+            inside[lane] = true;
+        }
+
+        // Same operations in the same order as in GetHeightAtPoint and Heightmap::GetPoint
+#if defined(__DAVAENGINE_SSE__)
+        const __m128 minZ = _mm_set1_ps(bbox.min.z);
+        const __m128 maxValue = _mm_set1_ps(float32(Heightmap::MAX_VALUE));
+        const __m128 scale = _mm_set1_ps(heightScale);
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        const __m128 z00 = _mm_add_ps(minZ, _mm_mul_ps(_mm_div_ps(_mm_load_ps(h00), maxValue), scale));
+        const __m128 z01 = _mm_add_ps(minZ, _mm_mul_ps(_mm_div_ps(_mm_load_ps(h01), maxValue), scale));
+        const __m128 z10 = _mm_add_ps(minZ, _mm_mul_ps(_mm_div_ps(_mm_load_ps(h10), maxValue), scale));
+        const __m128 z11 = _mm_add_ps(minZ, _mm_mul_ps(_mm_div_ps(_mm_load_ps(h11), maxValue), scale));
+
+        const __m128 fracX = _mm_load_ps(dx);
+        const __m128 fracY = _mm_load_ps(dy);
+        const __m128 invFracX = _mm_sub_ps(one, fracX);
+        const __m128 h0 = _mm_add_ps(_mm_mul_ps(z00, invFracX), _mm_mul_ps(z01, fracX));
+        const __m128 h1 = _mm_add_ps(_mm_mul_ps(z10, invFracX), _mm_mul_ps(z11, fracX));
+        _mm_store_ps(value, _mm_add_ps(_mm_mul_ps(h0, _mm_sub_ps(one, fracY)), _mm_mul_ps(h1, fracY)));
+#else
+        for (uint32 lane = 0; lane < HEIGHT_QUERY_LANES; ++lane)
+        {
+            const float32 z00 = bbox.min.z + h00[lane] / float32(Heightmap::MAX_VALUE) * heightScale;
+            const float32 z01 = bbox.min.z + h01[lane] / float32(Heightmap::MAX_VALUE) * heightScale;
+            const float32 z10 = bbox.min.z + h10[lane] / float32(Heightmap::MAX_VALUE) * heightScale;
+            const float32 z11 = bbox.min.z + h11[lane] / float32(Heightmap::MAX_VALUE) * heightScale;
+            const float32 h0 = z00 * (1.0f - dx[lane]) + z01 * dx[lane];
+            const float32 h1 = z10 * (1.0f - dx[lane]) + z11 * dx[lane];
+            value[lane] = h0 * (1.0f - dy[lane]) + h1 * dy[lane];
+        }
+#endif
+
+        for (uint32 lane = 0; lane < lanes; ++lane)
+        {
+            if (inside[lane])
+            {
+                heights[first + lane] = value[lane];
+                validCount++;
+            }
+            if (valid != nullptr)
+            {
+                valid[first + lane] = inside[lane];
+            }
+        }
+    }
+
+    return validCount;
+}
+
+uint32 Landscape::PlacePoints(const Vector3* points, uint32 count, Vector3* results, Vector3* normals, bool* placed) const
+{
+    using namespace LandscapeDetails;
+
+    const float32 normalDelta = 0.01f;
+
+    uint32 placedCount = 0;
+    for (uint32 first = 0; first < count; first += PLACE_POINTS_CHUNK_SIZE)
+    {
+        const uint32 chunkSize = Min(PLACE_POINTS_CHUNK_SIZE, count - first);
+
+        float32 heights[PLACE_POINTS_CHUNK_SIZE];
+        bool inside[PLACE_POINTS_CHUNK_SIZE];
+        placedCount += GetHeightsAtPoints(points + first, chunkSize, heights, inside);
+
+        for (uint32 i = 0; i < chunkSize; ++i)
+        {
+            results[first + i] = points[first + i];
+            if (inside[i])
+            {
+                results[first + i].z = heights[i];
+            }
+            if (placed != nullptr)
+            {
+                placed[first + i] = inside[i];
+            }
+        }
+
+        if (normals != nullptr)
+        {
+            // Shifted points keep height of placed point if they are outside of landscape, as in PlacePoint
+            Vector3 dx[PLACE_POINTS_CHUNK_SIZE];
+            Vector3 dy[PLACE_POINTS_CHUNK_SIZE];
+            float32 dxHeights[PLACE_POINTS_CHUNK_SIZE];
+            float32 dyHeights[PLACE_POINTS_CHUNK_SIZE];
+            bool dxInside[PLACE_POINTS_CHUNK_SIZE];
+            bool dyInside[PLACE_POINTS_CHUNK_SIZE];
+            for (uint32 i = 0; i < chunkSize; ++i)
+            {
+                dx[i] = results[first + i] + Vector3(normalDelta, 0.0f, 0.0f);
+                dy[i] = results[first + i] + Vector3(0.0f, normalDelta, 0.0f);
+            }
+            GetHeightsAtPoints(dx, chunkSize, dxHeights, dxInside);
+            GetHeightsAtPoints(dy, chunkSize, dyHeights, dyInside);
+
+            for (uint32 i = 0; i < chunkSize; ++i)
+            {
+                if (!inside[i])
+                    continue;
+
+                if (dxInside[i])
+                {
+                    dx[i].z = dxHeights[i];
+                }
+                if (dyInside[i])
+                {
+                    dy[i].z = dyHeights[i];
+                }
+                const Vector3& result = results[first + i];
+                Vector3& normal = normals[first + i];
+                normal = (dx[i] - result).CrossProduct(dy[i] - result);
+                normal.Normalize();
+            }
+        }
+    }
+
+    return placedCount;
+}
+
 void Landscape::AddPatchToRender(uint32 level, uint32 x, uint32 y)
 {
     DVASSERT(level < subdivision->GetLevelCount());
@@ -99,6 +99,15 @@ public:
     bool PlacePoint(const Vector3& point, Vector3& result, Vector3* normal = 0) const;
     bool GetHeightAtPoint(const Vector3& point, float&) const;
 
+    /**
+        Batch versions of GetHeightAtPoint and PlacePoint, results are the same as of single queries.
+        Heights of four points are interpolated at once. `heights[i]`, `results[i]` and `normals[i]` are written
+        only for points inside landscape, `valid[i]` and `placed[i]` (if not nullptr) are set for every point.
+        Return number of points inside landscape.
+     */
+    uint32 GetHeightsAtPoints(const Vector3* points, uint32 count, float32* heights, bool* valid = nullptr) const;
+    uint32 PlacePoints(const Vector3* points, uint32 count, Vector3* results, Vector3* normals = nullptr, bool* placed = nullptr) const;
+
     Heightmap* GetHeightmap();
     virtual void SetHeightmap(Heightmap* height);
 
@@ -5,9 +5,17 @@
 #include "Render/RHI/rhi_Public.h"
 #include "Reflection/ReflectionRegistrator.h"
 #include "Reflection/ReflectedMeta.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
 
 namespace DAVA
 {
+namespace LandscapeSubdivisionDetails
+{
+// Subtrees of this level (up to 16 patches) are subdivided in parallel
+const uint32 PARALLEL_LEVEL = 2;
+}
+
 DAVA_VIRTUAL_REFLECTION_IMPL(LandscapeSubdivision::SubdivisionMetrics)
 {
     ReflectionRegistrator<SubdivisionMetrics>::Begin()
@@ -86,7 +94,39 @@ void LandscapeSubdivision::PrepareSubdivision(Camera* camera, const Matrix4* wor
     //used for calculate metrics projection on screen. Projection calculate as '1.0 / (distance * tan(fov / 2))'. See errors calculation in SubdividePatch()
 
     terminatedPatchesCount = 0;
-    SubdividePatch(0, 0, 0, 0x3f, maxHeightError, maxPatchRadiusError);
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (parallelSubdiv && jobManager != nullptr && jobManager->GetWorkersCount() > 0)
+    {
+        subdivisionTasks.clear();
+        SubdividePatch(0, 0, 0, 0x3f, maxHeightError, maxPatchRadiusError, terminatedPatchesCount, &subdivisionTasks);
+        ProcessSubdivisionTasks(subdivisionTasks);
+    }
+    else
+    {
+        SubdividePatch(0, 0, 0, 0x3f, maxHeightError, maxPatchRadiusError, terminatedPatchesCount, nullptr);
+    }
+}
+
+void LandscapeSubdivision::ProcessSubdivisionTasks(const Vector<SubdivisionTask>& tasks)
+{
+    // Each task writes only patches of its own subtree, so tasks don't depend on each other
+    // and result doesn't depend on order they are processed in.
+    if (tasks.empty())
+        return;
+
+    subdivisionTerminatedCounts.assign(tasks.size(), 0);
+
+    subdivisionJobs.Start(static_cast<uint32>(tasks.size()), [this, &tasks](uint32 task) {
+        const SubdivisionTask& t = tasks[task];
+        SubdividePatch(t.level, t.x, t.y, t.clippingFlags, t.heightError0, t.radiusError0, subdivisionTerminatedCounts[task], nullptr);
+    });
+    subdivisionJobs.Finish();
+
+    for (uint32 count : subdivisionTerminatedCounts)
+    {
+        terminatedPatchesCount += count;
+    }
 }
 
 void LandscapeSubdivision::UpdatePatchInfo(const Rect2i& heighmapRect)
@@ -207,8 +247,14 @@ void LandscapeSubdivision::UpdatePatchInfo(uint32 level, uint32 x, uint32 y, Pat
     }
 }
 
-void LandscapeSubdivision::SubdividePatch(uint32 level, uint32 x, uint32 y, uint8 clippingFlags, float32 heightError0, float32 radiusError0)
+void LandscapeSubdivision::SubdividePatch(uint32 level, uint32 x, uint32 y, uint8 clippingFlags, float32 heightError0, float32 radiusError0, uint32& terminatedCount, Vector<SubdivisionTask>* deferredTasks)
 {
+    if (deferredTasks != nullptr && level == LandscapeSubdivisionDetails::PARALLEL_LEVEL)
+    {
+        deferredTasks->push_back({ level, x, y, clippingFlags, heightError0, radiusError0 });
+        return;
+    }
+
     SubdivisionLevelInfo& levelInfo = subdivLevelInfoArray[level];
     uint32 offset = levelInfo.offset + (y << level) + x;
     PatchQuadInfo* patch = &patchQuadArray[offset];
@@ -262,10 +308,10 @@ void LandscapeSubdivision::SubdividePatch(uint32 level, uint32 x, uint32 y, uint
         uint32 x2 = x << 1;
         uint32 y2 = y << 1;
 
-        SubdividePatch(level + 1, x2 + 0, y2 + 0, clippingFlags, heightError, radiusError);
-        SubdividePatch(level + 1, x2 + 1, y2 + 0, clippingFlags, heightError, radiusError);
-        SubdividePatch(level + 1, x2 + 0, y2 + 1, clippingFlags, heightError, radiusError);
-        SubdividePatch(level + 1, x2 + 1, y2 + 1, clippingFlags, heightError, radiusError);
+        SubdividePatch(level + 1, x2 + 0, y2 + 0, clippingFlags, heightError, radiusError, terminatedCount, deferredTasks);
+        SubdividePatch(level + 1, x2 + 1, y2 + 0, clippingFlags, heightError, radiusError, terminatedCount, deferredTasks);
+        SubdividePatch(level + 1, x2 + 0, y2 + 1, clippingFlags, heightError, radiusError, terminatedCount, deferredTasks);
+        SubdividePatch(level + 1, x2 + 1, y2 + 1, clippingFlags, heightError, radiusError, terminatedCount, deferredTasks);
     }
     else
     {
@@ -285,7 +331,7 @@ void LandscapeSubdivision::SubdividePatch(uint32 level, uint32 x, uint32 y, uint
 
         subdivPatchInfo->subdivisionState = SubdivisionPatchInfo::TERMINATED;
 
-        terminatedPatchesCount++;
+        terminatedCount++;
     }
 }
 
@@ -4,6 +4,7 @@
 #include "Base/BaseTypes.h"
 #include "Reflection/Reflection.h"
 #include "Base/IntrospectionBase.h"
+#include "Job/ParallelFor.h"
 #include "MemoryManager/MemoryProfiler.h"
 
 namespace DAVA
@@ -75,6 +76,12 @@ public:
     void UpdatePatchInfo(const Rect2i& heighmapRect);
     void SetForceMaxSubdivision(bool forceSubdivide);
 
+    /**
+        Enable subdivision of quadtree subtrees on worker threads (enabled by default).
+        Result is the same as of serial subdivision.
+     */
+    void SetParallelSubdivision(bool parallel);
+
 private:
     struct PatchQuadInfo
     {
@@ -84,8 +91,20 @@ private:
         float32 radius;
     };
 
+    struct SubdivisionTask
+    {
+        uint32 level;
+        uint32 x;
+        uint32 y;
+        uint8 clippingFlags;
+        float32 heightError0;
+        float32 radiusError0;
+    };
+
     void UpdatePatchInfo(uint32 level, uint32 x, uint32 y, PatchQuadInfo* parentPatch, const Rect2i& updateRect);
-    void SubdividePatch(uint32 level, uint32 x, uint32 y, uint8 clippingFlags, float32 heightError0, float32 radiusError0);
+    // Patches of PARALLEL_LEVEL aren't processed if `deferredTasks` is not nullptr, they are appended to it instead
+    void SubdividePatch(uint32 level, uint32 x, uint32 y, uint8 clippingFlags, float32 heightError0, float32 radiusError0, uint32& terminatedCount, Vector<SubdivisionTask>* deferredTasks);
+    void ProcessSubdivisionTasks(const Vector<SubdivisionTask>& tasks);
 
     const PatchQuadInfo& GetPatchQuadInfo(uint32 level, uint32 x, uint32 y) const;
 
@@ -116,6 +135,11 @@ private:
 
     bool calculateMorph = true;
     bool forceMaxSubdiv = false;
+    bool parallelSubdiv = true;
+
+    Vector<SubdivisionTask> subdivisionTasks;
+    Vector<uint32> subdivisionTerminatedCounts;
+    ParallelJobs subdivisionJobs;
 
     friend class LandscapeSystem;
 
@@ -147,6 +171,11 @@ inline void LandscapeSubdivision::SetForceMaxSubdivision(bool forceSubdivide)
     forceMaxSubdiv = forceSubdivide;
 }
 
+inline void LandscapeSubdivision::SetParallelSubdivision(bool parallel)
+{
+    parallelSubdiv = parallel;
+}
+
 inline uint32 LandscapeSubdivision::GetLevelCount() const
 {
     return subdivLevelCount;
@@ -29,7 +29,7 @@ public:
     RenderBatch();
 
     void SetPolygonGroup(PolygonGroup* _polygonGroup);
-    inline PolygonGroup* GetPolygonGroup();
+    inline PolygonGroup* GetPolygonGroup() const;
 
     void SetMaterial(NMaterial* _material);
     inline NMaterial* GetMaterial();
@@ -98,7 +98,7 @@ private:
     DAVA_VIRTUAL_REFLECTION(RenderBatch, BaseObject);
 };
 
-inline PolygonGroup* RenderBatch::GetPolygonGroup()
+inline PolygonGroup* RenderBatch::GetPolygonGroup() const
 {
     return dataSource;
 }
@@ -16,6 +16,17 @@ bool RenderBatchArray::MaterialCompareFunction(const RenderBatch* a, const Rende
     return a->layerSortingKey > b->layerSortingKey;
 }
 
+bool RenderBatchArray::MaterialGeometryCompareFunction(const RenderBatch* a, const RenderBatch* b)
+{
+    if (a->layerSortingKey != b->layerSortingKey)
+        return a->layerSortingKey > b->layerSortingKey;
+
+    // batches with the same material go grouped by geometry, so RenderLayer can draw them instanced
+    if (a->GetPolygonGroup() != b->GetPolygonGroup())
+        return a->GetPolygonGroup() < b->GetPolygonGroup();
+    return a->startIndex < b->startIndex;
+}
+
 void RenderBatchArray::Sort(Camera* camera)
 {
     // Need sort
@@ -41,7 +52,7 @@ void RenderBatchArray::Sort(Camera* camera)
                 //batch->layerSortingKey = (pointer_size)((batch->GetMaterial()->GetSortingKey() << 20) | (batch->GetSortingKey() << 28) | (renderObjectId & 0x000FFFFF));
             }
 
-            std::sort(renderBatchArray.begin(), renderBatchArray.end(), MaterialCompareFunction);
+            std::sort(renderBatchArray.begin(), renderBatchArray.end(), MaterialGeometryCompareFunction);
 
             sortFlags &= ~SORT_REQUIRED;
         }
@@ -36,6 +36,7 @@ private:
     Vector<RenderBatch*> renderBatchArray;
     uint32 sortFlags;
     static bool MaterialCompareFunction(const RenderBatch* a, const RenderBatch* b);
+    static bool MaterialGeometryCompareFunction(const RenderBatch* a, const RenderBatch* b);
 };
 
 inline void RenderBatchArray::Clear()
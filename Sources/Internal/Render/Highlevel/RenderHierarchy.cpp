@@ -3,10 +3,24 @@
 #include "Render/Highlevel/Camera.h"
 #include "Render/Highlevel/Frustum.h"
 #include "Render/Highlevel/Landscape.h"
-#include "Render/Highlevel/GeometryOctTree.h"
+#include "Render/Highlevel/GeometryBVH.h"
 
 namespace DAVA
 {
+namespace RenderHierarchyDetails
+{
+const uint32 MAX_OBJECTS_IN_LEAF = 4;
+}
+
+void RenderHierarchy::Clip(const ClipView* views, uint32 viewCount)
+{
+    DVASSERT(viewCount <= MAX_CLIP_VIEWS);
+    for (uint32 v = 0; v < viewCount; ++v)
+    {
+        Clip(views[v].camera, *views[v].visibilityArray, views[v].visibilityCriteria);
+    }
+}
+
 void LinearRenderHierarchy::AddRenderObject(RenderObject* object)
 {
     renderObjectArray.push_back(object);
@@ -47,6 +61,31 @@ void LinearRenderHierarchy::Clip(Camera* camera, Vector<RenderObject*>& visibili
     }
 }
 
+void LinearRenderHierarchy::Clip(const ClipView* views, uint32 viewCount)
+{
+    DVASSERT(viewCount <= MAX_CLIP_VIEWS);
+
+    Frustum* frustums[MAX_CLIP_VIEWS];
+    for (uint32 v = 0; v < viewCount; ++v)
+    {
+        frustums[v] = views[v].camera->GetFrustum();
+    }
+
+    uint32 size = static_cast<uint32>(renderObjectArray.size());
+    for (uint32 pos = 0; pos < size; ++pos)
+    {
+        RenderObject* node = renderObjectArray[pos];
+        uint32 flags = node->GetFlags();
+        for (uint32 v = 0; v < viewCount; ++v)
+        {
+            if ((flags & views[v].visibilityCriteria) != views[v].visibilityCriteria)
+                continue;
+            if ((RenderObject::ALWAYS_CLIPPING_VISIBLE & flags) || frustums[v]->IsInside(node->GetWorldBoundingBox()))
+                views[v].visibilityArray->push_back(node);
+        }
+    }
+}
+
 void LinearRenderHierarchy::GetAllObjectsInBBox(const AABBox3& bbox, Vector<RenderObject*>& visibilityArray)
 {
     uint32 size = static_cast<uint32>(renderObjectArray.size());
@@ -79,68 +118,197 @@ bool LinearRenderHierarchy::RayTrace(const Ray3& ray, RayTraceCollision& collisi
         }
     }
 
-    bool intersectionFound = false;
-    float32 closestT = 1.0f;
+    return RayTraceObjects(ray, broadPhaseCollisions, ignoreObjects, 1.0f, collision);
+}
+
+uint32 LinearRenderHierarchy::RayTraceBatch(const Vector<Ray3>& rays, Vector<RayTraceCollision>& collisions, const Vector<RenderObject*>& ignoreObjects)
+{
+    return RenderHierarchy::RayTraceBatch(rays, collisions, ignoreObjects, 1.0f);
+}
+
+uint32 RenderHierarchy::RayTraceBatch(const Vector<Ray3>& rays, Vector<RayTraceCollision>& collisions, const Vector<RenderObject*>& ignoreObjects)
+{
+    return RayTraceBatch(rays, collisions, ignoreObjects, FLOAT_MAX);
+}
+
+uint32 RenderHierarchy::RayTraceBatch(const Vector<Ray3>& rays, Vector<RayTraceCollision>& collisions, const Vector<RenderObject*>& ignoreObjects, float32 maxT)
+{
+    using namespace RenderHierarchyDetails;
 
-    for (auto& pair : broadPhaseCollisions)
+    const uint32 raysCount = static_cast<uint32>(rays.size());
+    collisions.assign(raysCount, RayTraceCollision());
+
+    Vector<RenderObject*> objects;
+    GetAllObjectsInBBox(GetWorldBoundingBox(), objects);
+    auto isIgnored = [&ignoreObjects](RenderObject* ro) {
+        return std::find(ignoreObjects.begin(), ignoreObjects.end(), ro) != ignoreObjects.end();
+    };
+    objects.erase(std::remove_if(objects.begin(), objects.end(), isIgnored), objects.end());
+    if (raysCount == 0 || objects.empty())
+        return 0;
+
+    // Top level of hierarchy is built for each batch, since objects are moved between batches
+    Vector<AABBox3> objectBoxes;
+    objectBoxes.reserve(objects.size());
+    for (RenderObject* ro : objects)
     {
-        RenderObject* ro = pair.second;
+        objectBoxes.push_back(ro->GetWorldBoundingBox());
+    }
 
-        if (pair.first > closestT)
-            break;
+    BoundingVolumeHierarchy objectsHierarchy;
+    objectsHierarchy.Build(objectBoxes, MAX_OBJECTS_IN_LEAF);
+    const Vector<BoundingVolumeHierarchy::Node>& nodes = objectsHierarchy.GetNodes();
+    const Vector<uint32>& objectIndices = objectsHierarchy.GetPrimitives();
+
+    Vector<Ray3Optimized> optimizedRays;
+    optimizedRays.reserve(raysCount);
+    for (const Ray3& ray : rays)
+    {
+        optimizedRays.emplace_back(ray.origin, ray.direction);
+    }
 
-        Vector3 rayOrigin = ray.origin * ro->GetInverseWorldTransform();
-        Vector3 rayDirection = MultiplyVectorMat3x3(ray.direction, ro->GetInverseWorldTransform());
-        Ray3Optimized rayInObjectSpace(rayOrigin, rayDirection);
+    const uint32 packetSize = BoundingVolumeHierarchy::RayPacket::SIZE;
+    Vector<float32> closestT(raysCount, maxT);
+    uint32 hitsCount = 0;
 
-        uint32 activeBatchesCount = ro->GetActiveRenderBatchCount();
-        for (uint32 bi = 0; bi < activeBatchesCount; ++bi)
+    BoundingVolumeHierarchy::TraversalStack stack(objectsHierarchy);
+    for (uint32 first = 0; first < raysCount; first += packetSize)
+    {
+        const uint32 count = Min(packetSize, raysCount - first);
+        BoundingVolumeHierarchy::RayPacket packet;
+        for (uint32 lane = 0; lane < count; ++lane)
         {
-            RenderBatch* rb = ro->GetActiveRenderBatch(bi);
-            DVASSERT(rb != nullptr);
-            PolygonGroup* geo = rb->GetPolygonGroup();
+            packet.SetRay(lane, optimizedRays[first + lane], closestT[first + lane]);
+        }
+
+        uint32 hitsMask = 0;
+        stack.Push(0);
+        while (!stack.IsEmpty())
+        {
+            const uint32 nodeIndex = stack.Pop();
+            const BoundingVolumeHierarchy::Node& node = nodes[nodeIndex];
+
+            const uint32 lanesMask = packet.IntersectBox(node.bbox);
+            if (lanesMask == 0)
+                continue;
 
-            if (geo)
+            if (!node.IsLeaf())
             {
-                GeometryOctTree* geometryOctTree = geo->octTree;
-                if (geometryOctTree)
+                uint32 lane = 0;
+                while ((lanesMask & (1 << lane)) == 0)
                 {
-                    float32 currentT;
-                    uint32 currentTriangleIndex;
+                    ++lane;
+                }
+
+                if (packet.invDirection[node.axis][lane] < 0.0f)
+                {
+                    stack.Push(nodeIndex + 1);
+                    stack.Push(node.offset);
+                }
+                else
+                {
+                    stack.Push(node.offset);
+                    stack.Push(nodeIndex + 1);
+                }
+                continue;
+            }
+
+            for (uint32 i = node.offset; i < node.offset + node.count; ++i)
+            {
+                const uint32 objectIndex = objectIndices[i];
+                for (uint32 lane = 0; lane < count; ++lane)
+                {
+                    const uint32 laneBit = 1 << lane;
+                    const uint32 rayIndex = first + lane;
+                    float32 boxT = 0.0f;
+                    if ((lanesMask & laneBit) == 0 || !BoundingVolumeHierarchy::IntersectBox(optimizedRays[rayIndex], objectBoxes[objectIndex], closestT[rayIndex], boxT))
+                        continue;
 
-                    if (geometryOctTree->IntersectionWithRay(rayInObjectSpace, currentT, currentTriangleIndex))
+                    if (RayTraceObject(rays[rayIndex], objects[objectIndex], closestT[rayIndex], collisions[rayIndex]))
                     {
-                        if (currentT < closestT)
-                        {
-                            intersectionFound = true;
-                            closestT = currentT;
-
-                            collision.renderObject = ro;
-                            collision.geometry = geo;
-                            collision.t = currentT;
-                            collision.triangleIndex = currentTriangleIndex;
-                        }
+                        packet.maxT[lane] = closestT[rayIndex];
+                        hitsMask |= laneBit;
                     }
                 }
             }
         }
 
-        if (ro->GetType() == RenderObject::TYPE_LANDSCAPE)
+        for (uint32 lane = 0; lane < count; ++lane)
+        {
+            hitsCount += (hitsMask >> lane) & 1;
+        }
+    }
+
+    return hitsCount;
+}
+
+bool RenderHierarchy::RayTraceObjects(const Ray3& ray, const Vector<BroadPhaseCollision>& broadPhaseCollisions, const Vector<RenderObject*>& ignoreObjects, float32 closestT, RayTraceCollision& collision)
+{
+    bool intersectionFound = false;
+    for (const BroadPhaseCollision& pair : broadPhaseCollisions)
+    {
+        if (pair.first > closestT)
+            break;
+
+        RenderObject* ro = pair.second;
+        if (std::find(ignoreObjects.begin(), ignoreObjects.end(), ro) != ignoreObjects.end())
+            continue;
+
+        intersectionFound |= RayTraceObject(ray, ro, closestT, collision);
+    }
+    return intersectionFound;
+}
+
+bool RenderHierarchy::RayTraceObject(const Ray3& ray, RenderObject* ro, float32& closestT, RayTraceCollision& collision)
+{
+    bool intersectionFound = false;
+
+    Vector3 rayOrigin = ray.origin * ro->GetInverseWorldTransform();
+    Vector3 rayDirection = MultiplyVectorMat3x3(ray.direction, ro->GetInverseWorldTransform());
+    Ray3Optimized rayInObjectSpace(rayOrigin, rayDirection);
+
+    uint32 activeBatchesCount = ro->GetActiveRenderBatchCount();
+    for (uint32 bi = 0; bi < activeBatchesCount; ++bi)
+    {
+        RenderBatch* rb = ro->GetActiveRenderBatch(bi);
+        DVASSERT(rb != nullptr);
+        PolygonGroup* geo = rb->GetPolygonGroup();
+
+        GeometryBVH* geometryBVH = (geo != nullptr) ? geo->GetGeometryBVH() : nullptr;
+        if (geometryBVH != nullptr)
         {
-            Landscape* landscape = static_cast<Landscape*>(ro);
             float32 currentT;
-            if (landscape->RayTrace(rayInObjectSpace, currentT))
+            uint32 currentTriangleIndex;
+
+            // Only hits closer than already found one are searched
+            if (geometryBVH->IntersectionWithRay(rayInObjectSpace, currentT, currentTriangleIndex, closestT))
             {
-                if (currentT < closestT)
-                {
-                    intersectionFound = true;
-                    closestT = currentT;
+                intersectionFound = true;
+                closestT = currentT;
 
-                    collision.renderObject = ro;
-                    collision.geometry = 0;
-                    collision.t = currentT;
-                    collision.triangleIndex = 0;
-                }
+                collision.renderObject = ro;
+                collision.geometry = geo;
+                collision.t = currentT;
+                collision.triangleIndex = currentTriangleIndex;
+            }
+        }
+    }
+
+    if (ro->GetType() == RenderObject::TYPE_LANDSCAPE)
+    {
+        Landscape* landscape = static_cast<Landscape*>(ro);
+        float32 currentT;
+        if (landscape->RayTrace(rayInObjectSpace, currentT))
+        {
+            if (currentT < closestT)
+            {
+                intersectionFound = true;
+                closestT = currentT;
+
+                collision.renderObject = ro;
+                collision.geometry = 0;
+                collision.t = currentT;
+                collision.triangleIndex = 0;
             }
         }
     }
@@ -22,9 +22,22 @@ public:
     uint32 triangleIndex = -1;
 };
 
+/**
+    \brief Description of one view for multi-view clipping.
+    Objects which flags contain all bits of `visibilityCriteria` and which are inside `camera` frustum are appended to `visibilityArray`.
+ */
+struct ClipView
+{
+    Camera* camera = nullptr;
+    Vector<RenderObject*>* visibilityArray = nullptr;
+    uint32 visibilityCriteria = 0;
+};
+
 class RenderHierarchy
 {
 public:
+    static const uint32 MAX_CLIP_VIEWS = 8;
+
     virtual ~RenderHierarchy()
     {
     }
@@ -34,10 +47,26 @@ public:
     virtual void ObjectUpdated(RenderObject* renderObject) = 0;
     virtual void Clip(Camera* camera, Vector<RenderObject*>& visibilityArray, uint32 visibilityCriteria) = 0;
 
+    /**
+        \brief Clip several views (main camera, reflection, refraction, shadow views etc.) at once.
+        Hierarchy is traversed only once, each node is tested only against frustums of views it is still visible in.
+        Default implementation clips views one by one. `viewCount` should not exceed MAX_CLIP_VIEWS.
+     */
+    virtual void Clip(const ClipView* views, uint32 viewCount);
+
     virtual void GetAllObjectsInBBox(const AABBox3& bbox, Vector<RenderObject*>& visibilityArray) = 0;
     virtual bool RayTrace(const Ray3& ray, RayTraceCollision& collision,
                           const Vector<RenderObject*>& ignoreObjects) = 0;
 
+    /**
+        \brief Trace several rays at once (picking of many points, line-of-sight checks etc.).
+        `collisions` gets one element per ray, `renderObject` of collision is nullptr if ray hits nothing.
+        Default implementation collects objects once, organizes them into bounding volume hierarchy
+        and traverses it by packets of rays. Returns number of rays that hit something.
+     */
+    virtual uint32 RayTraceBatch(const Vector<Ray3>& rays, Vector<RayTraceCollision>& collisions,
+                                 const Vector<RenderObject*>& ignoreObjects);
+
     virtual void Initialize()
     {
     }
@@ -51,6 +80,16 @@ public:
     {
     }
     virtual const AABBox3& GetWorldBoundingBox() const = 0;
+
+protected:
+    /** Implementation of RayTraceBatch, only hits with `t` less than `maxT` are found (e.g. 1 for segments). */
+    uint32 RayTraceBatch(const Vector<Ray3>& rays, Vector<RayTraceCollision>& collisions,
+                         const Vector<RenderObject*>& ignoreObjects, float32 maxT);
+    /** Narrow phase for `broadPhaseCollisions` sorted by distance. Only hits closer than `closestT` are found. */
+    static bool RayTraceObjects(const Ray3& ray, const Vector<BroadPhaseCollision>& broadPhaseCollisions,
+                                const Vector<RenderObject*>& ignoreObjects, float32 closestT, RayTraceCollision& collision);
+    /** Trace `ray` against geometry of `renderObject`, update `closestT` and `collision` if closer hit is found. */
+    static bool RayTraceObject(const Ray3& ray, RenderObject* renderObject, float32& closestT, RayTraceCollision& collision);
 };
 
 class LinearRenderHierarchy : public RenderHierarchy
@@ -59,9 +98,13 @@ class LinearRenderHierarchy : public RenderHierarchy
     void RemoveRenderObject(RenderObject* renderObject) override;
     void ObjectUpdated(RenderObject* renderObject) override;
     void Clip(Camera* camera, Vector<RenderObject*>& visibilityArray, uint32 visibilityCriteria) override;
+    void Clip(const ClipView* views, uint32 viewCount) override;
     void GetAllObjectsInBBox(const AABBox3& bbox, Vector<RenderObject*>& visibilityArray) override;
     bool RayTrace(const Ray3& ray, RayTraceCollision& collision,
                   const Vector<RenderObject*>& ignoreObjects) override;
+    /** Rays are segments from `origin` to `origin + direction` as in RayTrace. */
+    uint32 RayTraceBatch(const Vector<Ray3>& rays, Vector<RayTraceCollision>& collisions,
+                         const Vector<RenderObject*>& ignoreObjects) override;
     const AABBox3& GetWorldBoundingBox() const override;
 
 private:
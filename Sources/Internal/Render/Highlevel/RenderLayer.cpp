@@ -2,13 +2,50 @@
 #include "Render/Highlevel/RenderBatch.h"
 #include "Render/Highlevel/RenderBatchArray.h"
 #include "Render/Highlevel/Camera.h"
+#include "Render/Highlevel/RenderObject.h"
+#include "Render/3D/PolygonGroup.h"
+#include "Render/Material/NMaterial.h"
+#include "Render/Renderer.h"
+#include "Render/RenderOptions.h"
 #include "Render/VisibilityQueryResults.h"
+#include "Utils/Utils.h"
 #include "Base/Radix/Radix.h"
 #include "Debug/ProfilerGPU.h"
 #include "Debug/ProfilerMarkerNames.h"
 
 namespace DAVA
 {
+namespace RenderLayerDetails
+{
+// instance data is three columns of affine world matrix, bound to TEXCOORD5..7 of instanced shader variant
+const uint32 INSTANCE_FIRST_TEXCOORD = 5;
+const uint32 INSTANCE_ELEMENT_COUNT = 3;
+const uint32 INSTANCE_DATA_SIZE = INSTANCE_ELEMENT_COUNT * 4 * sizeof(float32);
+const uint32 MIN_INSTANCE_BUFFER_CAPACITY = 64;
+
+// Only world matrix is passed per instance. Objects with other per-object parameters
+// (SpeedTree wind, skinning joints, colors in local material properties) are rejected
+// here by render object type and by NMaterial::IsInstancingCompatible.
+bool IsInstancingCandidate(RenderBatch* batch)
+{
+    RenderObject* renderObject = batch->GetRenderObject();
+    if (batch->GetPolygonGroup() == nullptr || batch->GetMaterial() == nullptr)
+        return false;
+    if (renderObject->GetType() != RenderObject::TYPE_MESH && renderObject->GetType() != RenderObject::TYPE_RENDEROBJECT)
+        return false;
+    if (batch->perfQueryStart.IsValid() || batch->perfQueryEnd.IsValid())
+        return false;
+
+    // instanced shader uses world-view matrix instead of its inverse transpose, that is correct for uniform scale only
+    const Matrix4& world = *renderObject->GetWorldMatrixPtr();
+    const float32 scaleX = Vector3(world._00, world._01, world._02).SquareLength();
+    const float32 scaleY = Vector3(world._10, world._11, world._12).SquareLength();
+    const float32 scaleZ = Vector3(world._20, world._21, world._22).SquareLength();
+    const float32 epsilon = 0.001f * scaleX;
+    return Abs(scaleX - scaleY) <= epsilon && Abs(scaleX - scaleZ) <= epsilon;
+}
+}
+
 const FastName LAYER_NAME_OPAQUE("OpaqueRenderLayer");
 const FastName LAYER_NAME_AFTER_OPAQUE("AfterOpaqueRenderLayer");
 const FastName LAYER_NAME_ALPHA_TEST_LAYER("AlphaTestLayer");
@@ -50,6 +87,16 @@ RenderLayer::RenderLayer(eRenderLayerID _id, uint32 sortingFlags)
 
 RenderLayer::~RenderLayer()
 {
+    for (InstanceDataBuffer* buffer : freeInstanceDataBuffers)
+    {
+        rhi::DeleteVertexBuffer(buffer->buffer);
+        SafeDelete(buffer);
+    }
+    for (InstanceDataBuffer* buffer : usedInstanceDataBuffers)
+    {
+        rhi::DeleteVertexBuffer(buffer->buffer);
+        SafeDelete(buffer);
+    }
 }
 
 const FastName& RenderLayer::GetLayerNameByID(eRenderLayerID layer)
@@ -73,10 +120,19 @@ RenderLayer::eRenderLayerID RenderLayer::GetLayerIDByName(const FastName& name)
 void RenderLayer::Draw(Camera* camera, const RenderBatchArray& batchArray, rhi::HPacketList packetList)
 {
     uint32 size = static_cast<uint32>(batchArray.GetRenderBatchCount());
+    RenderStats& renderStats = Renderer::GetRenderStats();
+
+    bool instancingEnabled = rhi::DeviceCaps().isInstancingSupported && Renderer::GetOptions()->IsOptionEnabled(RenderOptions::AUTO_INSTANCING);
+    if (instancingEnabled)
+    {
+        ReclaimInstanceDataBuffers();
+    }
 
     rhi::Packet packet;
-    for (uint32 k = 0; k < size; ++k)
+    for (uint32 k = 0; k < size;)
     {
+        uint32 batchCount = instancingEnabled ? GetInstancedBatchCount(batchArray, k) : 1;
+
         RenderBatch* batch = batchArray.Get(k);
         RenderObject* renderObject = batch->GetRenderObject();
         renderObject->BindDynamicParameters(camera, batch);
@@ -85,7 +141,16 @@ void RenderLayer::Draw(Camera* camera, const RenderBatchArray& batchArray, rhi::
         {
             batch->BindGeometryData(packet);
             DVASSERT(packet.primitiveCount);
-            mat->BindParams(packet);
+            if (batchCount > 1)
+            {
+                mat->BindInstancedParams(packet);
+                BindInstanceData(batchArray, k, batchCount, packet);
+                ++renderStats.instancedPackets3d;
+            }
+            else
+            {
+                mat->BindParams(packet);
+            }
             packet.debugMarker = mat->GetEffectiveFXName().c_str();
             packet.perfQueryStart = batch->perfQueryStart;
             packet.perfQueryEnd = batch->perfQueryEnd;
@@ -103,6 +168,145 @@ void RenderLayer::Draw(Camera* camera, const RenderBatchArray& batchArray, rhi::
 #endif
 #endif
             rhi::AddPacket(packetList, packet);
+
+            renderStats.batches3d += batchCount;
+            ++renderStats.packets3d;
+        }
+
+        k += batchCount;
+    }
+}
+
+uint32 RenderLayer::GetInstancedBatchCount(const RenderBatchArray& batchArray, uint32 firstBatchIndex)
+{
+    using namespace RenderLayerDetails;
+
+    RenderBatch* first = batchArray.Get(firstBatchIndex);
+    if (!IsInstancingCandidate(first))
+        return 1;
+
+    PolygonGroup* polygonGroup = first->GetPolygonGroup();
+    NMaterial* material = first->GetMaterial();
+    Light* light = first->GetRenderObject()->GetLight(0);
+
+    uint32 size = batchArray.GetRenderBatchCount();
+    uint32 last = firstBatchIndex + 1;
+    for (; last < size; ++last)
+    {
+        RenderBatch* batch = batchArray.Get(last);
+        if (batch->GetPolygonGroup() != polygonGroup || batch->startIndex != first->startIndex)
+            break;
+        if (!IsInstancingCandidate(batch) || !material->IsInstancingCompatible(batch->GetMaterial()))
+            break;
+        if (batch->GetRenderObject()->GetLight(0) != light)
+            break;
+    }
+
+    uint32 batchCount = last - firstBatchIndex;
+    if (batchCount == 1 || !material->PreBuildInstancedMaterial())
+        return 1;
+    if (GetInstancedLayoutUID(polygonGroup->vertexLayoutId) == rhi::VertexLayout::InvalidUID)
+        return 1;
+
+    return batchCount;
+}
+
+uint32 RenderLayer::GetInstancedLayoutUID(uint32 layoutUID)
+{
+    using namespace RenderLayerDetails;
+
+    auto found = instancedLayouts.find(layoutUID);
+    if (found != instancedLayouts.end())
+        return found->second;
+
+    uint32 instancedLayoutUID = rhi::VertexLayout::InvalidUID;
+    const rhi::VertexLayout* layout = rhi::VertexLayout::Get(layoutUID);
+    if (layout != nullptr && layout->StreamCount() == 1)
+    {
+        bool texcoordsUsed = false;
+        for (uint32 i = 0; i < layout->ElementCount(); ++i)
+        {
+            texcoordsUsed |= (layout->ElementSemantics(i) == rhi::VS_TEXCOORD && layout->ElementSemanticsIndex(i) >= INSTANCE_FIRST_TEXCOORD);
+        }
+
+        if (!texcoordsUsed)
+        {
+            rhi::VertexLayout instancedLayout;
+            instancedLayout = *layout;
+            instancedLayout.AddStream(rhi::VDF_PER_INSTANCE);
+            for (uint32 i = 0; i < INSTANCE_ELEMENT_COUNT; ++i)
+            {
+                instancedLayout.AddElement(rhi::VS_TEXCOORD, INSTANCE_FIRST_TEXCOORD + i, rhi::VDT_FLOAT, 4);
+            }
+            instancedLayoutUID = rhi::VertexLayout::UniqueId(instancedLayout);
+        }
+    }
+
+    instancedLayouts[layoutUID] = instancedLayoutUID;
+    return instancedLayoutUID;
+}
+
+void RenderLayer::BindInstanceData(const RenderBatchArray& batchArray, uint32 firstBatchIndex, uint32 batchCount, rhi::Packet& packet)
+{
+    using namespace RenderLayerDetails;
+
+    // not every backend supports base instance, so each instanced packet gets its own buffer
+    uint32 dataSize = batchCount * INSTANCE_DATA_SIZE;
+    InstanceDataBuffer* instanceDataBuffer = nullptr;
+    for (int32 i = static_cast<int32>(freeInstanceDataBuffers.size()) - 1; i >= 0; --i)
+    {
+        if (freeInstanceDataBuffers[i]->bufferSize >= dataSize)
+        {
+            instanceDataBuffer = freeInstanceDataBuffers[i];
+            RemoveExchangingWithLast(freeInstanceDataBuffers, i);
+            break;
+        }
+    }
+
+    if (!instanceDataBuffer)
+    {
+        rhi::VertexBuffer::Descriptor instanceBufferDesc;
+        instanceBufferDesc.size = Max(static_cast<uint32>(NextPowerOf2(static_cast<int32>(batchCount))), MIN_INSTANCE_BUFFER_CAPACITY) * INSTANCE_DATA_SIZE;
+        instanceBufferDesc.usage = rhi::USAGE_DYNAMICDRAW;
+        instanceBufferDesc.needRestore = false;
+
+        instanceDataBuffer = new InstanceDataBuffer();
+        instanceDataBuffer->bufferSize = instanceBufferDesc.size;
+        instanceDataBuffer->buffer = rhi::CreateVertexBuffer(instanceBufferDesc);
+    }
+    usedInstanceDataBuffers.push_back(instanceDataBuffer);
+    instanceDataBuffer->syncObject = rhi::GetCurrentFrameSyncObject();
+
+    float32* instanceData = static_cast<float32*>(rhi::MapVertexBuffer(instanceDataBuffer->buffer, 0, dataSize));
+    for (uint32 i = 0; i < batchCount; ++i)
+    {
+        const Matrix4& world = *batchArray.Get(firstBatchIndex + i)->GetRenderObject()->GetWorldMatrixPtr();
+        for (uint32 column = 0; column < INSTANCE_ELEMENT_COUNT; ++column)
+        {
+            instanceData[0] = world._data[0][column];
+            instanceData[1] = world._data[1][column];
+            instanceData[2] = world._data[2][column];
+            instanceData[3] = world._data[3][column];
+            instanceData += 4;
+        }
+    }
+    rhi::UnmapVertexBuffer(instanceDataBuffer->buffer);
+
+    packet.vertexStreamCount = 2;
+    packet.vertexStream[1] = instanceDataBuffer->buffer;
+    packet.vertexLayoutUID = GetInstancedLayoutUID(packet.vertexLayoutUID);
+    packet.instanceCount = batchCount;
+    packet.baseInstance = 0;
+}
+
+void RenderLayer::ReclaimInstanceDataBuffers()
+{
+    for (int32 i = static_cast<int32>(usedInstanceDataBuffers.size()) - 1; i >= 0; --i)
+    {
+        if (rhi::SyncObjectSignaled(usedInstanceDataBuffers[i]->syncObject))
+        {
+            freeInstanceDataBuffers.push_back(usedInstanceDataBuffers[i]);
+            RemoveExchangingWithLast(usedInstanceDataBuffers, i);
         }
     }
 }
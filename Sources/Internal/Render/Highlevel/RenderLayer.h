@@ -49,8 +49,24 @@ public:
     virtual void Draw(Camera* camera, const RenderBatchArray& batchArray, rhi::HPacketList packetList);
 
 protected:
+    struct InstanceDataBuffer
+    {
+        rhi::HVertexBuffer buffer;
+        rhi::HSyncObject syncObject;
+        uint32 bufferSize;
+    };
+
+    uint32 GetInstancedBatchCount(const RenderBatchArray& batchArray, uint32 firstBatchIndex);
+    uint32 GetInstancedLayoutUID(uint32 layoutUID);
+    void BindInstanceData(const RenderBatchArray& batchArray, uint32 firstBatchIndex, uint32 batchCount, rhi::Packet& packet);
+    void ReclaimInstanceDataBuffers();
+
     eRenderLayerID layerID;
     uint32 sortFlags;
+
+    Vector<InstanceDataBuffer*> freeInstanceDataBuffers;
+    Vector<InstanceDataBuffer*> usedInstanceDataBuffers;
+    UnorderedMap<uint32, uint32> instancedLayouts;
 };
 
 inline RenderLayer::eRenderLayerID RenderLayer::GetRenderLayerID() const
@@ -388,6 +388,15 @@ void RenderObject::BindDynamicParameters(Camera* camera, RenderBatch* batch)
     }
 
     Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_LOCAL_BOUNDING_BOX, &bbox, reinterpret_cast<pointer_size>(&bbox));
+
+    PolygonGroup* geometry = (batch != nullptr) ? batch->GetPolygonGroup() : nullptr;
+    if (geometry != nullptr && (geometry->GetBufferVertexQuantization() & PolygonGroup::QUANTIZE_POSITION))
+    {
+        const Vector3& offset = geometry->GetQuantizedPositionOffset();
+        const Vector3& scale = geometry->GetQuantizedPositionScale();
+        Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_QUANTIZED_POSITION_OFFSET, &offset, reinterpret_cast<pointer_size>(&offset));
+        Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_QUANTIZED_POSITION_SCALE, &scale, reinterpret_cast<pointer_size>(&scale));
+    }
 }
 
 void RenderObject::SetRenderSystem(RenderSystem* _renderSystem)
@@ -98,8 +98,10 @@ public:
     inline void SetRemoveIndex(uint32 removeIndex);
     inline uint32 GetRemoveIndex();
 
-    inline void SetTreeNodeIndex(uint16 index);
-    inline uint16 GetTreeNodeIndex();
+    inline void SetTreeNodeIndex(uint32 index);
+    inline uint32 GetTreeNodeIndex();
+    inline void SetTreeNodeObjectIndex(uint32 index);
+    inline uint32 GetTreeNodeObjectIndex() const;
 
     void AddRenderBatch(RenderBatch* batch);
     void AddRenderBatch(RenderBatch* batch, int32 lodIndex, int32 switchIndex);
@@ -301,7 +303,8 @@ protected:
     uint32 flags = DEFAULT_RENDEROBJECT_FLAGS;
     uint32 debugFlags = 0;
     uint32 removeIndex = static_cast<uint32>(-1);
-    uint16 treeNodeIndex = QuadTree::INVALID_TREE_NODE_INDEX;
+    uint32 treeNodeIndex = QuadTree::INVALID_TREE_NODE_INDEX;
+    uint32 treeNodeObjectIndex = 0; // index in objects of tree node
     uint16 staticOcclusionIndex = INVALID_STATIC_OCCLUSION_INDEX;
 
     DAVA_VIRTUAL_REFLECTION(RenderObject, BaseObject);
@@ -329,15 +332,25 @@ inline void RenderObject::SetRemoveIndex(uint32 _removeIndex)
     removeIndex = _removeIndex;
 }
 
-inline void RenderObject::SetTreeNodeIndex(uint16 index)
+inline void RenderObject::SetTreeNodeIndex(uint32 index)
 {
     treeNodeIndex = index;
 }
-inline uint16 RenderObject::GetTreeNodeIndex()
+inline uint32 RenderObject::GetTreeNodeIndex()
 {
     return treeNodeIndex;
 }
 
+inline void RenderObject::SetTreeNodeObjectIndex(uint32 index)
+{
+    treeNodeObjectIndex = index;
+}
+
+inline uint32 RenderObject::GetTreeNodeObjectIndex() const
+{
+    return treeNodeObjectIndex;
+}
+
 inline void RenderObject::SetAABBox(const AABBox3& _bbox)
 {
     bbox = _bbox;
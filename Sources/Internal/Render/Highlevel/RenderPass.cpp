@@ -112,16 +112,20 @@ void RenderPass::Draw(RenderSystem* renderSystem)
     }
 }
 
+uint32 RenderPass::GetClippingVisibilityCriteria()
+{
+    uint32 visibilityCriteria = RenderObject::CLIPPING_VISIBILITY_CRITERIA;
+    if (!Renderer::GetOptions()->IsOptionEnabled(RenderOptions::ENABLE_STATIC_OCCLUSION))
+        visibilityCriteria &= ~RenderObject::VISIBLE_STATIC_OCCLUSION;
+    return visibilityCriteria;
+}
+
 void RenderPass::PrepareVisibilityArrays(Camera* camera, RenderSystem* renderSystem)
 {
     DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::RENDER_PASS_PREPARE_ARRAYS)
 
-    uint32 currVisibilityCriteria = RenderObject::CLIPPING_VISIBILITY_CRITERIA;
-    if (!Renderer::GetOptions()->IsOptionEnabled(RenderOptions::ENABLE_STATIC_OCCLUSION))
-        currVisibilityCriteria &= ~RenderObject::VISIBLE_STATIC_OCCLUSION;
-
     visibilityArray.clear();
-    renderSystem->GetRenderHierarchy()->Clip(camera, visibilityArray, currVisibilityCriteria);
+    renderSystem->GetRenderHierarchy()->Clip(camera, visibilityArray, GetClippingVisibilityCriteria());
 
     ClearLayersArrays();
     PrepareLayersArrays(visibilityArray, camera);
@@ -344,6 +348,32 @@ void MainForwardRenderPass::PrepareReflectionRefractionTextures(RenderSystem* re
     refractionPass->Draw(renderSystem);
 }
 
+void MainForwardRenderPass::PrepareVisibilityArraysWithWater(Camera* camera, RenderSystem* renderSystem)
+{
+    DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::RENDER_PASS_PREPARE_ARRAYS)
+
+    if (!reflectionPass)
+        InitReflectionRefraction();
+
+    // Water passes are clipped together with main camera using water level from previous frame.
+    // If water level is changed after main pass visibility is known, water passes clip again on their own.
+    reflectionPass->SetWaterLevel(waterBox.max.z);
+    refractionPass->SetWaterLevel(waterBox.min.z);
+
+    visibilityArray.clear();
+
+    ClipView views[3];
+    views[0].camera = camera;
+    views[0].visibilityArray = &visibilityArray;
+    views[0].visibilityCriteria = GetClippingVisibilityCriteria();
+    views[1] = reflectionPass->PrepareClipView(renderSystem);
+    views[2] = refractionPass->PrepareClipView(renderSystem);
+    renderSystem->GetRenderHierarchy()->Clip(views, 3);
+
+    ClearLayersArrays();
+    PrepareLayersArrays(visibilityArray, camera);
+}
+
 void MainForwardRenderPass::Draw(RenderSystem* renderSystem)
 {
     Camera* mainCamera = renderSystem->GetMainCamera();
@@ -354,20 +384,32 @@ void MainForwardRenderPass::Draw(RenderSystem* renderSystem)
     Vector4 clip(0, 0, 1, -1);*/
     SetupCameraParams(mainCamera, drawCamera);
 
-    PrepareVisibilityArrays(mainCamera, renderSystem);
+    bool drawReflectionRefraction = Renderer::GetOptions()->IsOptionEnabled(RenderOptions::WATER_REFLECTION_REFRACTION_DRAW);
+    if (drawReflectionRefraction && waterVisible && !waterBox.IsEmpty())
+        PrepareVisibilityArraysWithWater(mainCamera, renderSystem);
+    else
+        PrepareVisibilityArrays(mainCamera, renderSystem);
+
+    waterVisible = (layersBatchArrays[RenderLayer::RENDER_LAYER_WATER_ID].GetRenderBatchCount() != 0);
 
     DAVA_PROFILER_GPU_RENDER_PASS(passConfig, ProfilerGPUMarkerName::RENDER_PASS_MAIN_3D);
     if (BeginRenderPass())
     {
         DrawLayers(mainCamera);
 
-        if (layersBatchArrays[RenderLayer::RENDER_LAYER_WATER_ID].GetRenderBatchCount() != 0)
+        if (waterVisible)
             PrepareReflectionRefractionTextures(renderSystem);
 
         DrawDebug(drawCamera, renderSystem);
 
         EndRenderPass();
     }
+
+    if (reflectionPass)
+    {
+        reflectionPass->ResetClipView();
+        refractionPass->ResetClipView();
+    }
 }
 
 MainForwardRenderPass::~MainForwardRenderPass()
@@ -376,10 +418,12 @@ MainForwardRenderPass::~MainForwardRenderPass()
     SafeDelete(refractionPass);
 }
 
-WaterPrePass::WaterPrePass(const FastName& name)
+WaterPrePass::WaterPrePass(const FastName& name, uint32 visibilityCriteria_, const char* gpuMarkerName_)
     : RenderPass(name)
     , passMainCamera(NULL)
     , passDrawCamera(NULL)
+    , visibilityCriteria(visibilityCriteria_)
+    , gpuMarkerName(gpuMarkerName_)
 {
     AddRenderLayer(new RenderLayer(RenderLayer::RENDER_LAYER_OPAQUE_ID, RenderLayer::LAYER_SORTING_FLAGS_OPAQUE));
     AddRenderLayer(new RenderLayer(RenderLayer::RENDER_LAYER_AFTER_OPAQUE_ID, RenderLayer::LAYER_SORTING_FLAGS_AFTER_OPAQUE));
@@ -395,23 +439,11 @@ WaterPrePass::~WaterPrePass()
     SafeRelease(passDrawCamera);
 }
 
-WaterReflectionRenderPass::WaterReflectionRenderPass(const FastName& name)
-    : WaterPrePass(name)
+void WaterPrePass::UpdateCamera(Camera* camera)
 {
 }
 
-void WaterReflectionRenderPass::UpdateCamera(Camera* camera)
-{
-    Vector3 v;
-    v = camera->GetPosition();
-    v.z = waterLevel - (v.z - waterLevel);
-    camera->SetPosition(v);
-    v = camera->GetTarget();
-    v.z = waterLevel - (v.z - waterLevel);
-    camera->SetTarget(v);
-}
-
-void WaterReflectionRenderPass::Draw(RenderSystem* renderSystem)
+void WaterPrePass::PrepareCameras(RenderSystem* renderSystem)
 {
     Camera* mainCamera = renderSystem->GetMainCamera();
     Camera* drawCamera = renderSystem->GetDrawCamera();
@@ -424,10 +456,7 @@ void WaterReflectionRenderPass::Draw(RenderSystem* renderSystem)
 
     passMainCamera->CopyMathOnly(*mainCamera);
     UpdateCamera(passMainCamera);
-
-    Vector4 clipPlane(0, 0, 1, -(waterLevel - 0.1f));
-    Camera* currMainCamera = passMainCamera;
-    Camera* currDrawCamera;
+    currMainCamera = passMainCamera;
 
     if (drawCamera == mainCamera)
     {
@@ -439,71 +468,89 @@ void WaterReflectionRenderPass::Draw(RenderSystem* renderSystem)
         UpdateCamera(passDrawCamera);
         currDrawCamera = passDrawCamera;
     }
+}
 
-    SetupCameraParams(currMainCamera, currDrawCamera, &clipPlane);
+ClipView WaterPrePass::PrepareClipView(RenderSystem* renderSystem)
+{
+    PrepareCameras(renderSystem);
 
-    visibilityArray.clear();
-    renderSystem->GetRenderHierarchy()->Clip(currMainCamera, visibilityArray, RenderObject::CLIPPING_VISIBILITY_CRITERIA | RenderObject::VISIBLE_REFLECTION);
-    ClearLayersArrays();
-    PrepareLayersArrays(visibilityArray, currMainCamera);
+    // Only build frustum here, dynamic bindings are set up in Draw
+    Vector4 clipPlane = GetClipPlane();
+    currMainCamera->PrepareDynamicParameters(rhi::NeedInvertProjection(passConfig), &clipPlane);
 
-    DAVA_PROFILER_GPU_RENDER_PASS(passConfig, ProfilerGPUMarkerName::RENDER_PASS_WATER_REFLECTION);
-    if (BeginRenderPass())
-    {
-        DrawLayers(currMainCamera);
-        EndRenderPass();
-    }
+    visibilityArray.clear();
+    visibilityPrepared = true;
+    preparedWaterLevel = waterLevel;
+
+    ClipView view;
+    view.camera = currMainCamera;
+    view.visibilityArray = &visibilityArray;
+    view.visibilityCriteria = visibilityCriteria;
+    return view;
 }
 
-WaterRefractionRenderPass::WaterRefractionRenderPass(const FastName& name)
-    : WaterPrePass(name)
+void WaterPrePass::ResetClipView()
 {
-    /*const RenderLayerManager * renderLayerManager = RenderLayerManager::Instance();
-    AddRenderLayer(renderLayerManager->GetRenderLayer(LAYER_SHADOW_VOLUME), LAST_LAYER);*/
+    visibilityPrepared = false;
 }
 
-void WaterRefractionRenderPass::Draw(RenderSystem* renderSystem)
+void WaterPrePass::Draw(RenderSystem* renderSystem)
 {
-    Camera* mainCamera = renderSystem->GetMainCamera();
-    Camera* drawCamera = renderSystem->GetDrawCamera();
-
-    if (!passDrawCamera)
-    {
-        passMainCamera = new Camera();
-        passDrawCamera = new Camera();
-    }
-
-    passMainCamera->CopyMathOnly(*mainCamera);
-
-    //-0.1f ?
-    //Vector4 clipPlane(0,0, -1, waterLevel*3);
-    Vector4 clipPlane(0, 0, -1, waterLevel + 0.1f);
+    PrepareCameras(renderSystem);
 
-    Camera* currMainCamera = passMainCamera;
-    Camera* currDrawCamera;
+    Vector4 clipPlane = GetClipPlane();
+    SetupCameraParams(currMainCamera, currDrawCamera, &clipPlane);
 
-    if (drawCamera == mainCamera)
+    if (!visibilityPrepared || (preparedWaterLevel != waterLevel))
     {
-        currDrawCamera = currMainCamera;
+        visibilityArray.clear();
+        renderSystem->GetRenderHierarchy()->Clip(currMainCamera, visibilityArray, visibilityCriteria);
     }
-    else
-    {
-        passDrawCamera->CopyMathOnly(*drawCamera);
-        currDrawCamera = passDrawCamera;
-    }
-
-    SetupCameraParams(currMainCamera, currDrawCamera, &clipPlane);
+    visibilityPrepared = false;
 
-    visibilityArray.clear();
-    renderSystem->GetRenderHierarchy()->Clip(currMainCamera, visibilityArray, RenderObject::CLIPPING_VISIBILITY_CRITERIA | RenderObject::VISIBLE_REFRACTION);
     ClearLayersArrays();
     PrepareLayersArrays(visibilityArray, currMainCamera);
 
-    DAVA_PROFILER_GPU_RENDER_PASS(passConfig, ProfilerGPUMarkerName::RENDER_PASS_WATER_REFRACTION);
+    DAVA_PROFILER_GPU_RENDER_PASS(passConfig, gpuMarkerName);
     if (BeginRenderPass())
     {
         DrawLayers(currMainCamera);
         EndRenderPass();
     }
 }
+
+WaterReflectionRenderPass::WaterReflectionRenderPass(const FastName& name)
+    : WaterPrePass(name, RenderObject::CLIPPING_VISIBILITY_CRITERIA | RenderObject::VISIBLE_REFLECTION, ProfilerGPUMarkerName::RENDER_PASS_WATER_REFLECTION)
+{
+}
+
+void WaterReflectionRenderPass::UpdateCamera(Camera* camera)
+{
+    Vector3 v;
+    v = camera->GetPosition();
+    v.z = waterLevel - (v.z - waterLevel);
+    camera->SetPosition(v);
+    v = camera->GetTarget();
+    v.z = waterLevel - (v.z - waterLevel);
+    camera->SetTarget(v);
+}
+
+Vector4 WaterReflectionRenderPass::GetClipPlane() const
+{
+    return Vector4(0, 0, 1, -(waterLevel - 0.1f));
+}
+
+WaterRefractionRenderPass::WaterRefractionRenderPass(const FastName& name)
+    : WaterPrePass(name, RenderObject::CLIPPING_VISIBILITY_CRITERIA | RenderObject::VISIBLE_REFRACTION, ProfilerGPUMarkerName::RENDER_PASS_WATER_REFRACTION)
+{
+    /*const RenderLayerManager * renderLayerManager = RenderLayerManager::Instance();
+    AddRenderLayer(renderLayerManager->GetRenderLayer(LAYER_SHADOW_VOLUME), LAST_LAYER);*/
+}
+
+Vector4 WaterRefractionRenderPass::GetClipPlane() const
+{
+    //-0.1f ?
+    //Vector4 clipPlane(0,0, -1, waterLevel*3);
+    return Vector4(0, 0, -1, waterLevel + 0.1f);
+}
 };
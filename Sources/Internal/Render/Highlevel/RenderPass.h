@@ -3,6 +3,7 @@
 #include "Base/BaseTypes.h"
 #include "Base/FastName.h"
 #include "Render/Highlevel/RenderLayer.h"
+#include "Render/Highlevel/RenderHierarchy.h"
 #include "Render/Highlevel/RenderPassNames.h"
 
 namespace DAVA
@@ -37,6 +38,7 @@ protected:
     Vector2 viewportSize, rcpViewportSize, viewportOffset; //storage fro dynamic bindings
 
     /*convinience*/
+    static uint32 GetClippingVisibilityCriteria();
     void PrepareVisibilityArrays(Camera* camera, RenderSystem* renderSystem);
     void PrepareLayersArrays(const Vector<RenderObject*> objectsArray, Camera* camera);
     void ClearLayersArrays();
@@ -106,29 +108,52 @@ public:
     {
         waterLevel = level;
     }
-    WaterPrePass(const FastName& name);
+    WaterPrePass(const FastName& name, uint32 visibilityCriteria, const char* gpuMarkerName);
     ~WaterPrePass();
 
+    /**
+        Build pass camera for current water level and describe it as view for RenderHierarchy::Clip,
+        so owner pass can clip it together with its own camera. Visibility array filled by such clip
+        is used in next Draw if water level is not changed till then.
+     */
+    ClipView PrepareClipView(RenderSystem* renderSystem);
+    void ResetClipView();
+
+    void Draw(RenderSystem* renderSystem) override;
+
 protected:
+    virtual void UpdateCamera(Camera* camera);
+    virtual Vector4 GetClipPlane() const = 0;
+
+    void PrepareCameras(RenderSystem* renderSystem);
+
     Camera *passMainCamera, *passDrawCamera;
+    Camera* currMainCamera = nullptr;
+    Camera* currDrawCamera = nullptr;
+    uint32 visibilityCriteria = 0;
+    const char* gpuMarkerName = nullptr;
     float32 waterLevel = 0;
+    float32 preparedWaterLevel = 0;
+    bool visibilityPrepared = false;
 };
 
 class WaterReflectionRenderPass : public WaterPrePass
 {
 public:
     WaterReflectionRenderPass(const FastName& name);
-    virtual void Draw(RenderSystem* renderSystem);
 
 private:
-    void UpdateCamera(Camera* camera);
+    void UpdateCamera(Camera* camera) override;
+    Vector4 GetClipPlane() const override;
 };
 
 class WaterRefractionRenderPass : public WaterPrePass
 {
 public:
     WaterRefractionRenderPass(const FastName& name);
-    virtual void Draw(RenderSystem* renderSystem);
+
+private:
+    Vector4 GetClipPlane() const override;
 };
 
 class MainForwardRenderPass : public RenderPass
@@ -143,8 +168,10 @@ private:
     WaterRefractionRenderPass* refractionPass;
 
     AABBox3 waterBox;
+    bool waterVisible = false;
 
     void InitReflectionRefraction();
+    void PrepareVisibilityArraysWithWater(Camera* camera, RenderSystem* renderSystem);
     void PrepareReflectionRefractionTextures(RenderSystem* renderSystem);
 };
 }
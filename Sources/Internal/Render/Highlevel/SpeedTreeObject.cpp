@@ -253,13 +253,17 @@ PolygonGroup* SpeedTreeObject::CreateSortedPolygonGroup(PolygonGroup* pg)
     uint32 meshIndexCount = pg->GetPrimitiveCount() * 3;
 
     PolygonGroup* spg = new PolygonGroup();
-    spg->AllocateData(pg->GetFormat(), pg->GetVertexCount(), meshIndexCount * SORTING_DIRECTION_COUNT, pg->GetPrimitiveCount());
+    spg->AllocateData(pg->GetFormat(), pg->GetVertexCount(), meshIndexCount * SORTING_DIRECTION_COUNT, pg->GetPrimitiveCount(), pg->GetIndexFormat());
     Memcpy(spg->meshData, pg->meshData, pg->GetVertexCount() * pg->vertexStride);
 
     for (uint32 dir = 0; dir < SpeedTreeObject::SORTING_DIRECTION_COUNT; ++dir)
     {
-        Vector<uint16> bufferData = MeshUtils::BuildSortedIndexBufferData(pg, SpeedTreeObject::GetSortingDirection(dir));
-        Memcpy(spg->indexArray + meshIndexCount * dir, bufferData.data(), bufferData.size() * sizeof(uint16));
+        Vector<uint32> bufferData = MeshUtils::BuildSortedIndexBufferData(pg, SpeedTreeObject::GetSortingDirection(dir));
+        const int32 firstIndex = int32(meshIndexCount * dir);
+        for (size_t i = 0; i < bufferData.size(); ++i)
+        {
+            spg->SetIndex(firstIndex + int32(i), int32(bufferData[i]));
+        }
     }
 
     spg->RecalcAABBox();
@@ -175,6 +175,11 @@ void StaticOcclusion::BuildRenderPassConfigsForCurrentBlock()
 
     DVASSERT(occlusionFrameResults.size() == 0); // previous results are processed - at least for now
 
+    const uint32 positionsCount = (stepCount + 1) * (stepCount + 1);
+    Vector<Vector3> renderPositions(positionsCount);
+    Vector<Vector3> pointsOnLandscape(positionsCount);
+    std::unique_ptr<bool[]> placed(new bool[positionsCount]);
+
     for (uint32 side = 0; side < 6; ++side)
     {
         Vector3 startPosition, directionX, directionY;
@@ -215,41 +220,44 @@ void StaticOcclusion::BuildRenderPassConfigsForCurrentBlock()
             directionY = Vector3(0.0f, 1.0f, 0.0f);
         }
 
+        for (uint32 stepX = 0; stepX <= stepCount; ++stepX)
+        {
+            for (uint32 stepY = 0; stepY <= stepCount; ++stepY)
+            {
+                renderPositions[stepX * (stepCount + 1) + stepY] = startPosition + directionX * float32(stepX) * stepSize + directionY * float32(stepY) * stepSize;
+            }
+        }
+
+        // Positions of side are the same for all its view directions, so they are placed on landscape once by batch query
+        if (landscape)
+        {
+            landscape->PlacePoints(renderPositions.data(), positionsCount, pointsOnLandscape.data(), nullptr, placed.get());
+        }
+
         for (uint32 realSideIndex = 0; realSideIndex < effectiveSideCount[side]; ++realSideIndex)
         {
-            for (uint32 stepX = 0; stepX <= stepCount; ++stepX)
+            for (uint32 positionIndex = 0; positionIndex < positionsCount; ++positionIndex)
             {
-                for (uint32 stepY = 0; stepY <= stepCount; ++stepY)
+                const Vector3& renderPosition = renderPositions[positionIndex];
+                if (landscape && placed[positionIndex] && renderPosition.z < pointsOnLandscape[positionIndex].z)
+                    continue;
+
+                RenderPassCameraConfig config;
+                config.blockIndex = blockIndex;
+                config.side = side;
+                config.position = renderPosition;
+                config.direction = viewDirections[effectiveSides[side][realSideIndex]];
+                if (effectiveSides[side][realSideIndex] == 4 || effectiveSides[side][realSideIndex] == 5)
+                {
+                    config.up = Vector3(0.0f, 1.0f, 0.0f);
+                    config.left = Vector3(1.0f, 0.0f, 0.0f);
+                }
+                else
                 {
-                    Vector3 renderPosition = startPosition + directionX * float32(stepX) * stepSize + directionY * float32(stepY) * stepSize;
-
-                    if (landscape)
-                    {
-                        Vector3 pointOnLandscape;
-                        if (landscape->PlacePoint(renderPosition, pointOnLandscape))
-                        {
-                            if (renderPosition.z < pointOnLandscape.z)
-                                continue;
-                        }
-                    }
-
-                    RenderPassCameraConfig config;
-                    config.blockIndex = blockIndex;
-                    config.side = side;
-                    config.position = renderPosition;
-                    config.direction = viewDirections[effectiveSides[side][realSideIndex]];
-                    if (effectiveSides[side][realSideIndex] == 4 || effectiveSides[side][realSideIndex] == 5)
-                    {
-                        config.up = Vector3(0.0f, 1.0f, 0.0f);
-                        config.left = Vector3(1.0f, 0.0f, 0.0f);
-                    }
-                    else
-                    {
-                        config.up = Vector3(0.0f, 0.0f, 1.0f);
-                        config.left = Vector3(1.0f, 0.0f, 0.0f);
-                    }
-                    renderPassConfigs.push_back(config);
+                    config.up = Vector3(0.0f, 0.0f, 1.0f);
+                    config.left = Vector3(1.0f, 0.0f, 0.0f);
                 }
+                renderPassConfigs.push_back(config);
             }
         }
     }
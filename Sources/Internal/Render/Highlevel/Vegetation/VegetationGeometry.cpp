@@ -11,6 +11,7 @@
 #include "Render/Texture.h"
 #include "Engine/Engine.h"
 #include "Engine/EngineContext.h"
+#include "Job/ParallelFor.h"
 
 namespace DAVA
 {
@@ -128,47 +129,33 @@ void VegetationGeometry::Build(VegetationRenderData* renderData)
     Vector<VertexRangeData> layerClusterRanges;
     GenerateClusterPositionData(maxClusters, clusterPositions, layerClusterRanges);
 
-    Vector<Vector<BufferData>> resolutionDataArray;
-    for (uint32 resolutionIndex = 0; resolutionIndex < resolutionCount; ++resolutionIndex)
-    {
-        resolutionDataArray.emplace_back();
-        Vector<BufferData>& cellDataArray = resolutionDataArray.back();
-
-        Vector<ClusterResolutionData> clusterResolution;
-        Vector<BufferCellData> cellOffsets;
-        GenerateClusterResolutionData(resolutionIndex, maxClusters, clusterPositions, layerClusterRanges, clusterResolution);
+    // Resolutions are generated independently, then merged in order of resolution index,
+    // so buffers are the same as if they were generated one by one
+    Vector<ResolutionGeometry> resolutions;
+    BuildResolutions(clusterPositions, layerClusterRanges, resolutions);
 
-        std::stable_sort(clusterResolution.begin(), clusterResolution.end(), ClusterByMatrixCompareFunction);
-
-        GenerateVertexData(customGeometryData, clusterResolution, vertexData, cellOffsets);
+    Vector<Vector<VegetationBufferItem>>& indexBuffers = renderData->GetIndexBuffers();
+    for (ResolutionGeometry& resolution : resolutions)
+    {
+        uint32 vertexBase = static_cast<uint32>(vertexData.size());
+        uint32 indexBase = static_cast<uint32>(indexData.size());
 
-        size_t cellCount = cellOffsets.size();
-        for (size_t cellIndex = 0; cellIndex < cellCount; ++cellIndex)
+        vertexData.insert(vertexData.end(), resolution.vertexData.begin(), resolution.vertexData.end());
+        indexData.reserve(indexData.size() + resolution.indexData.size());
+        for (VegetationIndex index : resolution.indexData)
         {
-            cellDataArray.emplace_back();
-            BufferData& bufferOffsets = cellDataArray.back();
-            GenerateIndexData(customGeometryData, clusterResolution, cellOffsets[cellIndex], vertexData, indexData, bufferOffsets);
+            indexData.push_back(vertexBase + index);
         }
-    }
-
-    Vector<Vector<VegetationBufferItem>>& indexBuffers = renderData->GetIndexBuffers();
-    for (size_t resolutionIndex = 0; resolutionIndex < resolutionCount; ++resolutionIndex)
-    {
-        Vector<BufferData>& indexBuffersOffsets = resolutionDataArray[resolutionIndex];
 
         indexBuffers.emplace_back();
         Vector<VegetationBufferItem>& currentResolutionIndexBuffers = indexBuffers.back();
-
-        size_t cellCount = indexBuffersOffsets.size();
-        for (size_t cellIndex = 0; cellIndex < cellCount; ++cellIndex)
+        for (const BufferData& indexBufferOffset : resolution.cellData)
         {
             currentResolutionIndexBuffers.emplace_back();
             VegetationBufferItem& indexBufferItem = currentResolutionIndexBuffers.back();
 
-            BufferData& indexBufferOffset = indexBuffersOffsets[cellIndex];
-
             indexBufferItem.indexCount = indexBufferOffset.size;
-            indexBufferItem.startIndex = indexBufferOffset.indexOffset;
+            indexBufferItem.startIndex = indexBase + indexBufferOffset.indexOffset;
         }
     }
 
@@ -209,6 +196,44 @@ void VegetationGeometry::Build(VegetationRenderData* renderData)
     }
 }
 
+void VegetationGeometry::BuildResolutions(const Vector<ClusterPositionData>& clusterPositions, const Vector<VertexRangeData>& layerClusterRanges, Vector<ResolutionGeometry>& resolutions)
+{
+    resolutions.clear();
+    resolutions.resize(resolutionCount);
+
+    if (parallelBuild)
+    {
+        ParallelFor(resolutionCount, [&](uint32 resolutionIndex) {
+            BuildResolution(resolutionIndex, clusterPositions, layerClusterRanges, resolutions[resolutionIndex]);
+        });
+    }
+    else
+    {
+        for (uint32 resolutionIndex = 0; resolutionIndex < resolutionCount; ++resolutionIndex)
+        {
+            BuildResolution(resolutionIndex, clusterPositions, layerClusterRanges, resolutions[resolutionIndex]);
+        }
+    }
+}
+
+void VegetationGeometry::BuildResolution(uint32 resolutionIndex, const Vector<ClusterPositionData>& clusterPositions, const Vector<VertexRangeData>& layerClusterRanges, ResolutionGeometry& resolution)
+{
+    Vector<ClusterResolutionData> clusterResolution;
+    Vector<BufferCellData> cellOffsets;
+    GenerateClusterResolutionData(resolutionIndex, maxClusters, clusterPositions, layerClusterRanges, clusterResolution);
+
+    std::stable_sort(clusterResolution.begin(), clusterResolution.end(), ClusterByMatrixCompareFunction);
+
+    GenerateVertexData(customGeometryData, clusterResolution, resolution.vertexData, cellOffsets);
+
+    size_t cellCount = cellOffsets.size();
+    resolution.cellData.resize(cellCount);
+    for (size_t cellIndex = 0; cellIndex < cellCount; ++cellIndex)
+    {
+        GenerateIndexData(customGeometryData, clusterResolution, cellOffsets[cellIndex], resolution.vertexData, resolution.indexData, resolution.cellData[cellIndex]);
+    }
+}
+
 void VegetationGeometry::OnVegetationPropertiesChanged(NMaterial* mat, KeyedArchive* props)
 {
     if (mat)
@@ -48,6 +48,12 @@ public:
 
     void SetupCameraPositions(const AABBox3& bbox, Vector<Vector3>& positions);
 
+    /**
+        Enable building of resolutions on worker threads (enabled by default).
+        Result is the same as of serial build.
+     */
+    void SetParallelBuild(bool parallel);
+
 private:
     struct ClusterPositionData
     {
@@ -113,9 +119,20 @@ private:
         uint32 clusterCount;
     };
 
+    // Geometry of one resolution. Vertex indices and index offsets are relative to its own arrays.
+    struct ResolutionGeometry
+    {
+        Vector<VegetationVertex> vertexData;
+        Vector<VegetationIndex> indexData;
+        Vector<BufferData> cellData;
+    };
+
 private:
     void GenerateClusterPositionData(const Vector<VegetationLayerParams>& layerClusterCount, Vector<ClusterPositionData>& clusters, Vector<VertexRangeData>& layerRanges);
 
+    void BuildResolutions(const Vector<ClusterPositionData>& clusterPositions, const Vector<VertexRangeData>& layerClusterRanges, Vector<ResolutionGeometry>& resolutions);
+    void BuildResolution(uint32 resolutionIndex, const Vector<ClusterPositionData>& clusterPositions, const Vector<VertexRangeData>& layerClusterRanges, ResolutionGeometry& resolution);
+
     void GenerateClusterResolutionData(uint32 resolutionId, const Vector<VegetationLayerParams>& layerClusterCount, const Vector<ClusterPositionData>& clusterPosition,
                                        const Vector<VertexRangeData>& layerRanges, Vector<ClusterResolutionData>& clusterResolution);
 
@@ -148,7 +165,13 @@ private:
     uint32 resolutionCount;
 
     Vector<CustomGeometryEntityData> customGeometryData;
+    bool parallelBuild = true;
 };
+
+inline void VegetationGeometry::SetParallelBuild(bool parallel)
+{
+    parallelBuild = parallel;
+}
 };
 
 #endif /* defined(__DAVAENGINE_VEGETATIONCUSTOMSLGEOMETRYGENERATOR_H__) */
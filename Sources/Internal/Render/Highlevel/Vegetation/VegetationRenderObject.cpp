@@ -598,9 +598,28 @@ Vector<AbstractQuadTreeNode<VegetationSpatialData>*>& VegetationRenderObject::Bu
 
     BuildVisibleCellList(cameraPosXY, forCamera->GetFrustum(), planeMask, quadTree.GetRoot(), visibleCells, true);
 
+    // Render batch count is limited, cells nearest to camera are kept
+    droppedCellCount = DropFarthestCells(visibleCells, maxVisibleQuads);
+
     return visibleCells;
 }
 
+uint32 VegetationRenderObject::DropFarthestCells(Vector<AbstractQuadTreeNode<VegetationSpatialData>*>& cells, uint32 maxCount)
+{
+    if (cells.size() <= maxCount)
+    {
+        return 0;
+    }
+
+    uint32 droppedCount = uint32(cells.size()) - maxCount;
+    std::nth_element(cells.begin(), cells.begin() + maxCount, cells.end(),
+                     [](const AbstractQuadTreeNode<VegetationSpatialData>* a, const AbstractQuadTreeNode<VegetationSpatialData>* b) {
+                         return a->data.cameraDistance < b->data.cameraDistance;
+                     });
+    cells.resize(maxCount);
+    return droppedCount;
+}
+
 void VegetationRenderObject::BuildVisibleCellList(const Vector3& cameraPoint, Frustum* frustum, uint8 planeMask,
                                                   AbstractQuadTreeNode<VegetationSpatialData>* node, Vector<AbstractQuadTreeNode<VegetationSpatialData>*>& cellList, bool evaluateVisibility)
 {
@@ -847,7 +866,9 @@ void VegetationRenderObject::CreateRenderData()
     }
 
     renderData = new VegetationRenderData();
+    geometryBuildTime = SystemTimer::GetUs();
     vegetationGeometry->Build(renderData);
+    geometryBuildTime = SystemTimer::GetUs() - geometryBuildTime;
 
     const Vector<VegetationVertex>& vertexData = renderData->GetVertices();
     const Vector<VegetationIndex>& indexData = renderData->GetIndices();
@@ -1133,6 +1154,8 @@ void VegetationRenderObject::CollectMetrics(VegetationMetrics& metrics)
 {
     metrics.renderBatchCount = 0;
     metrics.totalQuadTreeLeafCount = 0;
+    metrics.droppedCellCount = droppedCellCount;
+    metrics.geometryBuildTime = geometryBuildTime;
 
     metrics.quadTreeLeafCountPerLOD.clear();
 
@@ -52,6 +52,9 @@ struct VegetationMetrics
 
     uint32 renderBatchCount;
 
+    uint32 droppedCellCount = 0; // visible cells over `maxVisibleQuads` limit, farthest ones are dropped
+    int64 geometryBuildTime = 0; // microseconds spent on last geometry rebuild
+
     bool isValid = false;
 };
 
@@ -143,6 +146,12 @@ public:
 
     static bool IsHardwareCapableToRenderVegetation();
 
+    /**
+        Keep at most `maxCount` cells nearest to camera (by `cameraDistance`) in `cells`.
+        Order of kept cells is not preserved. Returns number of dropped cells.
+     */
+    static uint32 DropFarthestCells(Vector<AbstractQuadTreeNode<VegetationSpatialData>*>& cells, uint32 maxCount);
+
     void Rebuild();
 
 private:
@@ -212,6 +221,8 @@ private:
 
     AbstractQuadTree<VegetationSpatialData> quadTree;
     Vector<AbstractQuadTreeNode<VegetationSpatialData>*> visibleCells;
+    uint32 droppedCellCount = 0;
+    int64 geometryBuildTime = 0;
 
     FilePath heightmapPath;
     FilePath lightmapTexturePath;
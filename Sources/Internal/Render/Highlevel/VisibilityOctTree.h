@@ -14,6 +14,8 @@ public:
     VisibilityOctTree();
     ~VisibilityOctTree();
 
+    using RenderHierarchy::Clip;
+
     void AddRenderObject(RenderObject* renderObject) override;
     void RemoveRenderObject(RenderObject* renderObject) override;
     void ObjectUpdated(RenderObject* renderObject) override;
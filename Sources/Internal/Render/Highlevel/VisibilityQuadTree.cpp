@@ -1,7 +1,6 @@
 #include "Render/Highlevel/VisibilityQuadTree.h"
 #include "Render/Highlevel/RenderObject.h"
 #include "Render/Highlevel/RenderBatchArray.h"
-#include "Render/Highlevel/GeometryOctTree.h"
 #include "Render/Highlevel/Landscape.h"
 #include "Render/RenderHelper.h"
 
@@ -20,6 +19,74 @@ void QuadTree::QuadTreeNode::Reset()
     nodeInfo = 0;
 }
 
+namespace QuadTreeDetails
+{
+// Objects that are always visible are stored with huge box, so they pass frustum test without checking flags
+const AABBox3 ALWAYS_VISIBLE_BOX(Vector3(-AABBOX_INFINITY, -AABBOX_INFINITY, -AABBOX_INFINITY), Vector3(AABBOX_INFINITY, AABBOX_INFINITY, AABBOX_INFINITY));
+
+const AABBox3& GetClippingBox(RenderObject* object)
+{
+    return (object->GetFlags() & RenderObject::ALWAYS_CLIPPING_VISIBLE) ? ALWAYS_VISIBLE_BOX : object->GetWorldBoundingBox();
+}
+}
+
+void QuadTree::QuadTreeNode::AddObject(RenderObject* object)
+{
+    uint32 index = static_cast<uint32>(objects.size());
+    objects.push_back(object);
+    object->SetTreeNodeObjectIndex(index);
+    SetObjectBox(index, QuadTreeDetails::GetClippingBox(object));
+}
+
+void QuadTree::QuadTreeNode::RemoveObject(RenderObject* object)
+{
+    uint32 index = object->GetTreeNodeObjectIndex();
+    DVASSERT(index < objects.size() && objects[index] == object);
+
+    uint32 lastIndex = static_cast<uint32>(objects.size() - 1);
+    if (index != lastIndex)
+    {
+        objects[index] = objects[lastIndex];
+        objects[index]->SetTreeNodeObjectIndex(index);
+
+        float32* dst = objectBoxes.data() + (index / 4) * OBJECT_BOX_GROUP_SIZE + (index % 4);
+        const float32* src = objectBoxes.data() + (lastIndex / 4) * OBJECT_BOX_GROUP_SIZE + (lastIndex % 4);
+        for (uint32 c = 0; c < 6; ++c)
+        {
+            dst[c * 4] = src[c * 4];
+        }
+    }
+    objects.pop_back();
+    objectBoxes.resize(((objects.size() + 3) / 4) * OBJECT_BOX_GROUP_SIZE);
+}
+
+void QuadTree::QuadTreeNode::UpdateObjectBox(RenderObject* object)
+{
+    uint32 index = object->GetTreeNodeObjectIndex();
+    DVASSERT(index < objects.size() && objects[index] == object);
+    SetObjectBox(index, QuadTreeDetails::GetClippingBox(object));
+}
+
+void QuadTree::QuadTreeNode::SetObjectBox(uint32 index, const AABBox3& box)
+{
+    size_t groupOffset = (index / 4) * OBJECT_BOX_GROUP_SIZE;
+    if (objectBoxes.size() < groupOffset + OBJECT_BOX_GROUP_SIZE)
+        objectBoxes.resize(groupOffset + OBJECT_BOX_GROUP_SIZE, 0.0f);
+
+    float32* lane = objectBoxes.data() + groupOffset + (index % 4);
+    lane[0] = box.min.x;
+    lane[4] = box.min.y;
+    lane[8] = box.min.z;
+    lane[12] = box.max.x;
+    lane[16] = box.max.y;
+    lane[20] = box.max.z;
+}
+
+const float32* QuadTree::QuadTreeNode::GetObjectBoxGroup(uint32 index) const
+{
+    return objectBoxes.data() + (index / 4) * OBJECT_BOX_GROUP_SIZE;
+}
+
 QuadTree::QuadTree(int32 _maxTreeDepth)
     : maxTreeDepth(_maxTreeDepth)
 {
@@ -106,9 +173,9 @@ void QuadTree::UpdateParentBox(AABBox3& childtBox, QuadTreeNode::eNodeType child
     }
 }
 
-uint16 QuadTree::FindObjectAddNode(uint16 startNodeId, const AABBox3& objBox)
+uint32 QuadTree::FindObjectAddNode(uint32 startNodeId, const AABBox3& objBox)
 {
-    uint16 currIndex = startNodeId;
+    uint32 currIndex = startNodeId;
 
     bool placeHere = false;
 
@@ -154,16 +221,16 @@ uint16 QuadTree::FindObjectAddNode(uint16 startNodeId, const AABBox3& objBox)
             if (currNode.children[fitNode] == INVALID_TREE_NODE_INDEX) //set child node if not exist
             {
                 DVASSERT((nodes[currIndex].nodeInfo & QuadTreeNode::NUM_CHILD_NODES_MASK) != 4);
-                uint16 newNodeIndex;
+                uint32 newNodeIndex;
                 if (emptyNodes.size()) //take from empty
                 {
-                    newNodeIndex = static_cast<uint16>(emptyNodes.back());
+                    newNodeIndex = static_cast<uint32>(emptyNodes.back());
                     emptyNodes.pop_back();
                     nodes[newNodeIndex].Reset();
                 }
                 else //or create new node
                 {
-                    newNodeIndex = uint16(nodes.size());
+                    newNodeIndex = uint32(nodes.size());
                     nodes.resize(newNodeIndex + 1); //starting from here currNode may be invalid
                 }
                 nodes[newNodeIndex].nodeInfo = (nodes[currIndex].nodeInfo & QuadTreeNode::NODE_DEPTH_MASK) + (1 << QuadTreeNode::NODE_DEPTH_OFFSET); //depth
@@ -183,7 +250,7 @@ uint16 QuadTree::FindObjectAddNode(uint16 startNodeId, const AABBox3& objBox)
     return currIndex;
 }
 
-void QuadTree::MarkNodeDirty(uint16 nodeId)
+void QuadTree::MarkNodeDirty(uint32 nodeId)
 {
     if ((nodes[nodeId].nodeInfo & QuadTreeNode::DIRTY_Z_MASK) != QuadTreeNode::DIRTY_Z_MASK)
     {
@@ -201,14 +268,14 @@ void QuadTree::MarkObjectDirty(RenderObject* object)
     }
 }
 
-void QuadTree::RecalculateNodeZLimits(uint16 nodeId)
+void QuadTree::RecalculateNodeZLimits(uint32 nodeId)
 {
     QuadTreeNode& currNode = nodes[nodeId];
     currNode.bbox.min.z = AABBOX_INFINITY;
     currNode.bbox.max.z = -AABBOX_INFINITY;
     for (int32 i = 0; i < QuadTreeNode::NODE_NONE; i++)
     {
-        uint16 childId = currNode.children[i];
+        uint32 childId = currNode.children[i];
         if (childId != INVALID_TREE_NODE_INDEX)
         {
             currNode.bbox.min.z = Min(currNode.bbox.min.z, nodes[childId].bbox.min.z);
@@ -245,13 +312,13 @@ void QuadTree::AddRenderObject(RenderObject* renderObject)
     if ((renderObject->GetFlags() & RenderObject::ALWAYS_CLIPPING_VISIBLE) || (!worldBox.IsInside(objBox)))
     {
         //object is somehow outside the world - just add to root
-        nodes[0].objects.push_back(renderObject);
+        nodes[0].AddObject(renderObject);
         renderObject->SetTreeNodeIndex(0);
         renderObject->RemoveFlag(RenderObject::TREE_NODE_NEED_UPDATE);
         return;
     }
-    uint16 nodeToAdd = FindObjectAddNode(0, renderObject->GetWorldBoundingBox());
-    nodes[nodeToAdd].objects.push_back(renderObject);
+    uint32 nodeToAdd = FindObjectAddNode(0, renderObject->GetWorldBoundingBox());
+    nodes[nodeToAdd].AddObject(renderObject);
     renderObject->SetTreeNodeIndex(nodeToAdd);
     renderObject->RemoveFlag(RenderObject::TREE_NODE_NEED_UPDATE);
 }
@@ -271,12 +338,10 @@ void QuadTree::RemoveRenderObject(RenderObject* renderObject)
         worldInitObjects.erase(it);
         return;
     }
-    uint16 currIndex = renderObject->GetTreeNodeIndex();
+    uint32 currIndex = renderObject->GetTreeNodeIndex();
     DVASSERT(currIndex != INVALID_TREE_NODE_INDEX);
     renderObject->SetTreeNodeIndex(INVALID_TREE_NODE_INDEX);
-    Vector<RenderObject*>::iterator it = std::find(nodes[currIndex].objects.begin(), nodes[currIndex].objects.end(), renderObject);
-    DVASSERT(it != nodes[currIndex].objects.end());
-    nodes[currIndex].objects.erase(it);
+    nodes[currIndex].RemoveObject(renderObject);
 
     if (renderObject->GetFlags() & RenderObject::TREE_NODE_NEED_UPDATE)
     {
@@ -354,44 +419,39 @@ const AABBox3& QuadTree::GetWorldBoundingBox() const
 
 void QuadTree::ObjectUpdated(RenderObject* renderObject)
 {
-    if (renderObject->GetFlags() & RenderObject::ALWAYS_CLIPPING_VISIBLE)
-        return;
-
     DVASSERT(worldInitialized);
     //remove object from its current tree node
-    uint16 baseIndex = renderObject->GetTreeNodeIndex();
+    uint32 baseIndex = renderObject->GetTreeNodeIndex();
     DVASSERT(baseIndex != INVALID_TREE_NODE_INDEX);
 
-    //climb up
+    //ALWAYS_CLIPPING_VISIBLE objects are kept in root with box passing any frustum, even if flag was set after adding
+    const bool alwaysVisible = (renderObject->GetFlags() & RenderObject::ALWAYS_CLIPPING_VISIBLE) != 0;
     const AABBox3& objBox = renderObject->GetWorldBoundingBox();
-    uint16 reverseIndex = baseIndex;
-    while (reverseIndex && (!CheckObjectFitNode(objBox, nodes[reverseIndex].bbox)))
+    uint32 reverseIndex = baseIndex;
+    if (alwaysVisible)
     {
-        reverseIndex = nodes[reverseIndex].parent;
+        reverseIndex = 0;
     }
+    else
+    {
+        //climb up
+        while (reverseIndex && (!CheckObjectFitNode(objBox, nodes[reverseIndex].bbox)))
+        {
+            reverseIndex = nodes[reverseIndex].parent;
+        }
 
-    MarkObjectDirty(renderObject);
+        MarkObjectDirty(renderObject);
+    }
 
     if (reverseIndex != baseIndex)
     {
-        //remove from base
-        int32 objectsSize = static_cast<int32>(nodes[baseIndex].objects.size());
-        int32 objIndex = 0;
-        for (; objIndex < objectsSize; ++objIndex)
-        {
-            if (nodes[baseIndex].objects[objIndex] == renderObject)
-                break;
-        }
-        DVASSERT(objIndex < objectsSize);
-        if (objectsSize > 1)
-            nodes[baseIndex].objects[objIndex] = nodes[baseIndex].objects[objectsSize - 1];
-        nodes[baseIndex].objects.resize(objectsSize - 1);
-        //and add to target
-        nodes[reverseIndex].objects.push_back(renderObject);
+        //remove from base and add to target
+        nodes[baseIndex].RemoveObject(renderObject);
+        nodes[reverseIndex].AddObject(renderObject);
         renderObject->SetTreeNodeIndex(reverseIndex);
 
         /*only now we can climb back and remove/mark nodes*/
-        uint16 currIndex = baseIndex;
+        uint32 currIndex = baseIndex;
         while (currIndex != reverseIndex)
         {
             QuadTreeNode& currNode = nodes[currIndex];
@@ -417,10 +477,15 @@ void QuadTree::ObjectUpdated(RenderObject* renderObject)
     }
     else
     {
+        nodes[baseIndex].UpdateObjectBox(renderObject);
         MarkNodeDirty(baseIndex);
     }
+
+    if (alwaysVisible)
+        return;
+
     //as object change can wrap any of parent boxes
-    uint16 currIndex = reverseIndex;
+    uint32 currIndex = reverseIndex;
     bool sizeUpdeted;
     do
     {
@@ -439,7 +504,7 @@ void QuadTree::ObjectUpdated(RenderObject* renderObject)
     } while (sizeUpdeted && (currIndex != INVALID_TREE_NODE_INDEX));
 }
 
-void QuadTree::ProcessNodeClipping(uint16 nodeId, uint8 clippingFlags, Vector<RenderObject*>& visibilityArray)
+void QuadTree::ProcessNodeClipping(uint32 nodeId, uint8 clippingFlags, Vector<RenderObject*>& visibilityArray)
 {
     QuadTreeNode& currNode = nodes[nodeId];
     int32 objectsSize = static_cast<int32>(currNode.objects.size());
@@ -471,19 +536,22 @@ void QuadTree::ProcessNodeClipping(uint16 nodeId, uint8 clippingFlags, Vector<Re
     }
     else
     {
-        for (int32 i = 0; i < objectsSize; ++i)
+        //test boxes by 4 and touch only objects inside frustum
+        for (int32 groupStart = 0; groupStart < objectsSize; groupStart += 4)
         {
-            RenderObject* obj = currNode.objects[i];
-            uint32 flags = obj->GetFlags();
-            if ((flags & currVisibilityCriteria) == currVisibilityCriteria)
+            uint32 insideMask = currFrustum->IsInside4(currNode.GetObjectBoxGroup(groupStart), clippingFlags);
+            for (int32 i = groupStart, groupEnd = Min(groupStart + 4, objectsSize); (insideMask != 0) && (i < groupEnd); ++i, insideMask >>= 1)
             {
-                if ((flags & RenderObject::ALWAYS_CLIPPING_VISIBLE)
-                    || currFrustum->IsInside(obj->GetWorldBoundingBox(), clippingFlags, obj->startClippingPlane))
+                if (insideMask & 1)
                 {
-                    visibilityArray.push_back(obj);
+                    RenderObject* obj = currNode.objects[i];
+                    if ((obj->GetFlags() & currVisibilityCriteria) == currVisibilityCriteria)
+                    {
+                        visibilityArray.push_back(obj);
 #if defined(__DAVAENGINE_RENDERSTATS__)
-                    ++Renderer::GetRenderStats().visibleRenderObjects;
+                        ++Renderer::GetRenderStats().visibleRenderObjects;
 #endif
+                    }
                 }
             }
         }
@@ -492,7 +560,7 @@ void QuadTree::ProcessNodeClipping(uint16 nodeId, uint8 clippingFlags, Vector<Re
     //process children
     for (int32 i = 0; i < QuadTreeNode::NODE_NONE; ++i)
     {
-        uint16 childNodeId = currNode.children[i];
+        uint32 childNodeId = currNode.children[i];
         if (childNodeId != INVALID_TREE_NODE_INDEX)
         {
             ProcessNodeClipping(childNodeId, clippingFlags, visibilityArray);
@@ -509,7 +577,119 @@ void QuadTree::Clip(Camera* camera, Vector<RenderObject*>& visibilityArray, uint
     ProcessNodeClipping(0, 0x3f, visibilityArray);
 }
 
-void QuadTree::GetObjects(uint16 nodeId, const AABBox3& bbox, Vector<RenderObject*>& visibilityArray)
+/*
+    Multi-view version of clipping: node is classified only against frustums of views it is still visible in,
+    subtree is skipped when node is outside of all views. Cached start clipping planes of nodes are updated
+    only by first view, other views use them as a hint.
+*/
+void QuadTree::ProcessNodeClipping(uint32 nodeId, const uint8* parentClippingFlags, uint32 viewMask)
+{
+    QuadTreeNode& currNode = nodes[nodeId];
+    int32 objectsSize = static_cast<int32>(currNode.objects.size());
+    int32 clipBoxCount = (currNode.nodeInfo & QuadTreeNode::NUM_CHILD_NODES_MASK) + objectsSize;
+    uint8 nodeStartClipPlane = (currNode.nodeInfo & QuadTreeNode::START_CLIP_PLANE_MASK) >> QuadTreeNode::START_CLIP_PLANE_OFFSET;
+
+    uint8 clippingFlags[MAX_CLIP_VIEWS];
+    for (uint32 v = 0; v < clipViewCount; ++v)
+    {
+        if ((viewMask & (1 << v)) == 0)
+            continue;
+
+        clippingFlags[v] = parentClippingFlags[v];
+        if (clippingFlags[v] && (clipBoxCount > 1) && nodeId) //root node is considered as always pass  - as objects out of worldBox are added here
+        {
+            uint8 startClipPlane = nodeStartClipPlane;
+            if (clipFrustums[v]->Classify(currNode.bbox, clippingFlags[v], startClipPlane) == Frustum::EFR_OUTSIDE)
+            {
+                viewMask &= ~(1 << v);
+            }
+            else if (v == 0)
+            {
+                currNode.nodeInfo &= ~QuadTreeNode::START_CLIP_PLANE_MASK;
+                currNode.nodeInfo |= (uint16(startClipPlane)) << QuadTreeNode::START_CLIP_PLANE_OFFSET;
+            }
+        }
+    }
+
+    if (viewMask == 0)
+        return; //node box is outside of all views
+
+    for (int32 groupStart = 0; groupStart < objectsSize; groupStart += 4)
+    {
+        uint32 insideMasks[MAX_CLIP_VIEWS];
+        uint32 anyInsideMask = 0;
+        for (uint32 v = 0; v < clipViewCount; ++v)
+        {
+            insideMasks[v] = 0;
+            if (viewMask & (1 << v))
+            {
+                insideMasks[v] = clippingFlags[v] ? clipFrustums[v]->IsInside4(currNode.GetObjectBoxGroup(groupStart), clippingFlags[v]) : 0xf;
+                anyInsideMask |= insideMasks[v];
+            }
+        }
+
+        for (int32 i = groupStart, groupEnd = Min(groupStart + 4, objectsSize); i < groupEnd; ++i)
+        {
+            uint32 lane = 1 << (i - groupStart);
+            if ((anyInsideMask & lane) == 0)
+                continue;
+
+            RenderObject* obj = currNode.objects[i];
+            uint32 flags = obj->GetFlags();
+            for (uint32 v = 0; v < clipViewCount; ++v)
+            {
+                const ClipView& view = clipViews[v];
+                if ((insideMasks[v] & lane) && ((flags & view.visibilityCriteria) == view.visibilityCriteria))
+                {
+                    view.visibilityArray->push_back(obj);
+#if defined(__DAVAENGINE_RENDERSTATS__)
+                    ++Renderer::GetRenderStats().visibleRenderObjects;
+#endif
+                }
+            }
+        }
+    }
+
+    //process children
+    for (int32 i = 0; i < QuadTreeNode::NODE_NONE; ++i)
+    {
+        uint32 childNodeId = currNode.children[i];
+        if (childNodeId != INVALID_TREE_NODE_INDEX)
+        {
+            ProcessNodeClipping(childNodeId, clippingFlags, viewMask);
+        }
+    }
+}
+
+void QuadTree::Clip(const ClipView* views, uint32 viewCount)
+{
+    DVASSERT(worldInitialized);
+    DVASSERT(viewCount <= MAX_CLIP_VIEWS);
+
+    if (viewCount == 0)
+        return;
+
+    if (viewCount == 1)
+    {
+        Clip(views[0].camera, *views[0].visibilityArray, views[0].visibilityCriteria);
+        return;
+    }
+
+    uint8 clippingFlags[MAX_CLIP_VIEWS];
+    for (uint32 v = 0; v < viewCount; ++v)
+    {
+        clipFrustums[v] = views[v].camera->GetFrustum();
+        clippingFlags[v] = 0x3f;
+    }
+
+    clipViews = views;
+    clipViewCount = viewCount;
+    ProcessNodeClipping(0, clippingFlags, (1 << viewCount) - 1);
+    clipViews = nullptr;
+    clipViewCount = 0;
+}
+
+void QuadTree::GetObjects(uint32 nodeId, const AABBox3& bbox, Vector<RenderObject*>& visibilityArray)
 {
     QuadTreeNode& currNode = nodes[nodeId];
     int32 objectsSize = static_cast<int32>(currNode.objects.size());
@@ -528,7 +708,7 @@ void QuadTree::GetObjects(uint16 nodeId, const AABBox3& bbox, Vector<RenderObjec
         //process children
         for (int32 i = 0; i < QuadTreeNode::NODE_NONE; ++i)
         {
-            uint16 childNodeId = currNode.children[i];
+            uint32 childNodeId = currNode.children[i];
             if (childNodeId != INVALID_TREE_NODE_INDEX)
             {
                 GetObjects(childNodeId, bbox, visibilityArray);
@@ -548,7 +728,7 @@ void QuadTree::BroadPhaseCollisions(const Ray3& rayInWorldSpace, Vector<BroadPha
 
     while (broadPhaseQueue.size() > 0)
     {
-        uint16 nodeId = broadPhaseQueue.front();
+        uint32 nodeId = broadPhaseQueue.front();
         broadPhaseQueue.pop();
 
         QuadTreeNode& currNode = nodes[nodeId];
@@ -575,7 +755,7 @@ void QuadTree::BroadPhaseCollisions(const Ray3& rayInWorldSpace, Vector<BroadPha
             //process children
             for (int32 i = 0; i < QuadTreeNode::NODE_NONE; ++i)
             {
-                uint16 childNodeId = currNode.children[i];
+                uint32 childNodeId = currNode.children[i];
                 if (childNodeId != INVALID_TREE_NODE_INDEX)
                 {
                     broadPhaseQueue.push(childNodeId);
@@ -595,85 +775,14 @@ bool QuadTree::RayTrace(const Ray3& ray, RayTraceCollision& collision, const Vec
     localRayBoxTraceCount = 0;
     BroadPhaseCollisions(ray, broadPhaseCollisions);
 
-    // TODO: Remove duplication of this code in SpatialTree and RenderHierarchy
-    bool intersectionFound = false;
-    float32 closestT = FLOAT_MAX;
-
-    for (auto& pair : broadPhaseCollisions)
-    {
-        RenderObject* ro = pair.second;
-        if (std::find(std::begin(ignoreObjects), std::end(ignoreObjects), ro)
-            != std::end(ignoreObjects))
-        {
-            continue;
-        }
-
-        if (pair.first > closestT)
-            break;
-
-        Vector3 rayOrigin = ray.origin * ro->GetInverseWorldTransform();
-        Vector3 rayDirection = MultiplyVectorMat3x3(ray.direction, ro->GetInverseWorldTransform());
-        Ray3Optimized rayInObjectSpace(rayOrigin, rayDirection);
-
-        uint32 activeBatchesCount = ro->GetActiveRenderBatchCount();
-        for (uint32 bi = 0; bi < activeBatchesCount; ++bi)
-        {
-            RenderBatch* rb = ro->GetActiveRenderBatch(bi);
-            DVASSERT(rb != nullptr);
-            PolygonGroup* geo = rb->GetPolygonGroup();
-
-            if (geo)
-            {
-                GeometryOctTree* geometryOctTree = geo->GetGeometryOctTree();
-                if (geometryOctTree)
-                {
-                    float32 currentT;
-                    uint32 currentTriangleIndex;
-
-                    if (geometryOctTree->IntersectionWithRay(rayInObjectSpace, currentT, currentTriangleIndex))
-                    {
-                        if (currentT < closestT)
-                        {
-                            intersectionFound = true;
-                            closestT = currentT;
-
-                            collision.renderObject = ro;
-                            collision.geometry = geo;
-                            collision.t = currentT;
-                            collision.triangleIndex = currentTriangleIndex;
-                        }
-                    }
-                }
-            }
-        }
-
-        if (ro->GetType() == RenderObject::TYPE_LANDSCAPE)
-        {
-            Landscape* landscape = static_cast<Landscape*>(ro);
-            float32 currentT;
-            if (landscape->RayTrace(rayInObjectSpace, currentT))
-            {
-                if (currentT < closestT)
-                {
-                    intersectionFound = true;
-                    closestT = currentT;
-
-                    collision.renderObject = ro;
-                    collision.geometry = 0;
-                    collision.t = currentT;
-                    collision.triangleIndex = 0;
-                }
-            }
-        }
-    }
-    return intersectionFound;
+    return RayTraceObjects(ray, broadPhaseCollisions, ignoreObjects, FLOAT_MAX, collision);
 }
 
 void QuadTree::Update()
 {
     DVASSERT(worldInitialized);
     int32 count = 0;
-    for (List<int32>::iterator it = dirtyZNodes.begin(), e = dirtyZNodes.end(); (it != e) && (count < RECALCULATE_Z_PER_FRAME); ++count)
+    for (List<uint32>::iterator it = dirtyZNodes.begin(), e = dirtyZNodes.end(); (it != e) && (count < RECALCULATE_Z_PER_FRAME); ++count)
     {
         RecalculateNodeZLimits(*it);
         it = dirtyZNodes.erase(it);
@@ -685,29 +794,19 @@ void QuadTree::Update()
         it = dirtyObjects.erase(it);
         //as now invisible render objects are updeted after becoming visible no no need to store them in this list for all that time
         object->RemoveFlag(RenderObject::TREE_NODE_NEED_UPDATE);
-        if ((object->GetFlags() & RenderObject::CLIPPING_VISIBILITY_CRITERIA) == RenderObject::CLIPPING_VISIBILITY_CRITERIA)
+        if (((object->GetFlags() & RenderObject::CLIPPING_VISIBILITY_CRITERIA) == RenderObject::CLIPPING_VISIBILITY_CRITERIA) &&
+            ((object->GetFlags() & RenderObject::ALWAYS_CLIPPING_VISIBLE) == 0))
         {
-            uint16 startNode = object->GetTreeNodeIndex();
+            uint32 startNode = object->GetTreeNodeIndex();
             if ((!startNode) && (!worldBox.IsInside(object->GetWorldBoundingBox())))
                 continue; //object is out of world - leave it in root node
 
-            uint16 targetNode = FindObjectAddNode(startNode, object->GetWorldBoundingBox());
+            uint32 targetNode = FindObjectAddNode(startNode, object->GetWorldBoundingBox());
             if (startNode != targetNode)
             {
-                //remove from base
-                int32 objectsSize = static_cast<int32>(nodes[startNode].objects.size());
-                int32 objIndex = 0;
-                for (; objIndex < objectsSize; ++objIndex)
-                {
-                    if (nodes[startNode].objects[objIndex] == object)
-                        break;
-                }
-                DVASSERT(objIndex < objectsSize);
-                if (objectsSize > 1)
-                    nodes[startNode].objects[objIndex] = nodes[startNode].objects[objectsSize - 1];
-                nodes[startNode].objects.resize(objectsSize - 1);
-                //and add to target
-                nodes[targetNode].objects.push_back(object);
+                //remove from base and add to target
+                nodes[startNode].RemoveObject(object);
+                nodes[targetNode].AddObject(object);
                 object->SetTreeNodeIndex(targetNode);
             }
         }
@@ -739,7 +838,7 @@ void QuadTree::DebugDraw(const Matrix4& cameraMatrix, RenderHelper* renderHelper
 #endif
 }
 
-void QuadTree::DebugDrawNode(uint16 nodeId)
+void QuadTree::DebugDrawNode(uint32 nodeId)
 {
 #if (DAVA_DEBUG_DRAW_OCTREE)
     RenderSystem2D::Instance()->SetColor(0.2f, 0.2f, 1.0f, 1.0f);
@@ -14,9 +14,9 @@ class RenderObject;
 class QuadTree : public RenderHierarchy
 {
 public:
-    enum : uint16
+    enum : uint32
     {
-        INVALID_TREE_NODE_INDEX = static_cast<uint16>(-1)
+        INVALID_TREE_NODE_INDEX = static_cast<uint32>(-1)
     };
 
 public:
@@ -26,6 +26,7 @@ public:
     void RemoveRenderObject(RenderObject* renderObject) override;
     void ObjectUpdated(RenderObject* renderObject) override;
     void Clip(Camera* camera, Vector<RenderObject*>& visibilityArray, uint32 visibilityCriteria) override;
+    void Clip(const ClipView* views, uint32 viewCount) override;
     void GetAllObjectsInBBox(const AABBox3& bbox, Vector<RenderObject*>& visibilityArray) override;
     bool RayTrace(const Ray3& ray, RayTraceCollision& collision,
                   const Vector<RenderObject*>& ignoreObjects) override;
@@ -47,8 +48,8 @@ public:
             NODE_RT = 3,
             NODE_NONE = 4
         };
-        uint16 parent;
-        uint16 children[4]; // think about allocating and freeing at groups of for
+        uint32 parent;
+        uint32 children[4]; // think about allocating and freeing at groups of for
         AABBox3 bbox;
 
         const static uint16 NUM_CHILD_NODES_MASK = 0x07;
@@ -59,8 +60,20 @@ public:
         const static uint16 START_CLIP_PLANE_OFFSET = 4;
         uint16 nodeInfo; // format : ddddddddddzccñ where c - numChildNodes, z - dirtyZ, d - depth
         Vector<RenderObject*> objects;
+
+        // World boxes of objects in SoA layout for Frustum::IsInside4, grouped by 4 objects:
+        // minX[4], minY[4], minZ[4], maxX[4], maxY[4], maxZ[4]. Box of i-th object is in (i / 4)-th group at (i % 4) lane.
+        const static uint32 OBJECT_BOX_GROUP_SIZE = 24;
+        Vector<float32> objectBoxes;
+
         QuadTreeNode();
         void Reset();
+
+        void AddObject(RenderObject* object);
+        void RemoveObject(RenderObject* object);
+        void UpdateObjectBox(RenderObject* object);
+        void SetObjectBox(uint32 index, const AABBox3& box);
+        const float32* GetObjectBoxGroup(uint32 index) const;
     };
 
 private:
@@ -70,15 +83,16 @@ private:
     void UpdateChildBox(AABBox3& parentBox, QuadTreeNode::eNodeType childType);
     void UpdateParentBox(AABBox3& childBox, QuadTreeNode::eNodeType childType);
 
-    void ProcessNodeClipping(uint16 nodeId, uint8 clippingFlags, Vector<RenderObject*>& visibilityArray);
-    void GetObjects(uint16 nodeId, const AABBox3& bbox, Vector<RenderObject*>& visibilityArray);
-    void RecalculateNodeZLimits(uint16 nodeId);
-    void MarkNodeDirty(uint16 nodeId);
+    void ProcessNodeClipping(uint32 nodeId, uint8 clippingFlags, Vector<RenderObject*>& visibilityArray);
+    void ProcessNodeClipping(uint32 nodeId, const uint8* parentClippingFlags, uint32 viewMask);
+    void GetObjects(uint32 nodeId, const AABBox3& bbox, Vector<RenderObject*>& visibilityArray);
+    void RecalculateNodeZLimits(uint32 nodeId);
+    void MarkNodeDirty(uint32 nodeId);
     void MarkObjectDirty(RenderObject* object);
-    void DebugDrawNode(uint16 nodeId);
+    void DebugDrawNode(uint32 nodeId);
     void BroadPhaseCollisions(const Ray3& rayInWorldSpace, Vector<BroadPhaseCollision>& broadPhaseCollisions);
 
-    uint16 FindObjectAddNode(uint16 startNodeId, const AABBox3& objBox);
+    uint32 FindObjectAddNode(uint32 startNodeId, const AABBox3& objBox);
 
 private:
     static const int32 RECALCULATE_Z_PER_FRAME = 10;
@@ -87,10 +101,10 @@ private:
     Vector<BroadPhaseCollision> broadPhaseCollisions;
     Vector<QuadTreeNode> nodes;
     Vector<uint32> emptyNodes;
-    List<int32> dirtyZNodes;
+    List<uint32> dirtyZNodes;
     List<RenderObject*> dirtyObjects;
     List<RenderObject*> worldInitObjects;
-    std::queue<uint16> broadPhaseQueue;
+    std::queue<uint32> broadPhaseQueue;
 
 #if (DAVA_DEBUG_DRAW_OCTREE)
     UniqueHandle debugDrawStateHandle = InvalidUniqueHandle;
@@ -101,6 +115,9 @@ private:
     Frustum* currFrustum = nullptr;
     Camera* currCamera = nullptr;
     uint32 currVisibilityCriteria = 0;
+    const ClipView* clipViews = nullptr;
+    uint32 clipViewCount = 0;
+    Frustum* clipFrustums[MAX_CLIP_VIEWS];
     uint32 localRayBoxTraceCount = 0;
     bool worldInitialized = false;
     bool preparedForShutdown = false;
@@ -14,6 +14,7 @@
 namespace DAVA
 {
 struct MaterialBufferBinding;
+struct RenderPassDescriptor;
 
 struct NMaterialProperty
 {
@@ -183,6 +184,14 @@ public:
     // later add engine flags here
     bool PreBuildMaterial(const FastName& passName);
 
+    // instanced drawing - world matrices are taken from per-instance vertex stream (see RenderLayer)
+    // variants with FLAG_INSTANCED_WORLD are built on first request, so PreBuildInstancedMaterial
+    // returns false until next PreBuildMaterial and for materials/passes whose shader doesn't support it
+    bool PreBuildInstancedMaterial();
+    void BindInstancedParams(rhi::Packet& target);
+    // materials are drawn with the same render state and params (same material or unmodified instances of one parent)
+    bool IsInstancingCompatible(const NMaterial* material) const;
+
     // RHI_COMPLETE - it's temporary solution to avoid FX loading and shaders compilation after loading
     void PreCacheFX();
     void PreCacheFXWithFlags(const UnorderedMap<FastName, int32>& extraFlags, const FastName& extraFxName = FastName());
@@ -205,6 +214,12 @@ private:
     void RebuildTextureBindings();
     void RebuildRenderVariants();
 
+    RenderVariantInstance* CreateRenderVariant(const RenderPassDescriptor& variantDescr);
+    void RebuildVariantBindings(RenderVariantInstance* variant);
+    void RebuildVariantTextureBindings(RenderVariantInstance* variant, uint32 anisotropyLevel);
+    void BindVariantParams(RenderVariantInstance* variant, rhi::Packet& target);
+    bool HasLocalOverrides() const;
+
     bool NeedLocalOverride(UniquePropertyLayout propertyLayout);
     void ClearLocalBuffers();
     void InjectChildBuffer(UniquePropertyLayout propLayoutId, MaterialBufferBinding* buffer);
@@ -242,11 +257,13 @@ private:
 
     // this is for render passes - not used right now - only active variant instance
     UnorderedMap<FastName, RenderVariantInstance*> renderVariants;
+    UnorderedMap<FastName, RenderVariantInstance*> instancedRenderVariants;
 
     uint32 sortingKey = 0;
     bool needRebuildBindings = true;
     bool needRebuildTextures = true;
     bool needRebuildVariants = true;
+    bool instancingRequested = false;
 
 public:
     INTROSPECTION(NMaterial,
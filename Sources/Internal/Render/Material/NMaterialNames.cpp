@@ -209,6 +209,12 @@ const FastName NMaterialFlagName::FLAG_LANDSCAPE_MORPHING_COLOR("LANDSCAPE_MORPH
 
 const FastName NMaterialFlagName::FLAG_HEIGHTMAP_FLOAT_TEXTURE("HEIGHTMAP_FLOAT_TEXTURE");
 
+const FastName NMaterialFlagName::FLAG_INSTANCED_WORLD("INSTANCED_WORLD");
+const FastName NMaterialFlagName::FLAG_INSTANCING_DISABLED("INSTANCING_DISABLED");
+
+const FastName NMaterialFlagName::FLAG_VERTEX_QUANTIZED_POSITION("VERTEX_QUANTIZED_POSITION");
+const FastName NMaterialFlagName::FLAG_VERTEX_OCTAHEDRAL_NORMAL("VERTEX_OCTAHEDRAL_NORMAL");
+
 const FastName NMaterialFlagName::FLAG_ILLUMINATION_USED = FastName("ILLUMINATION_USED");
 const FastName NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_CASTER = FastName("ILLUMINATION_SHADOW_CASTER");
 const FastName NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_RECEIVER = FastName("ILLUMINATION_SHADOW_RECEIVER");
@@ -246,6 +252,8 @@ Vector<FastName> RUNTIME_ONLY_FLAGS =
   NMaterialFlagName::FLAG_LANDSCAPE_MORPHING_COLOR,
 
   NMaterialFlagName::FLAG_HEIGHTMAP_FLOAT_TEXTURE,
+
+  NMaterialFlagName::FLAG_INSTANCED_WORLD,
 };
 
 bool NMaterialFlagName::IsRuntimeFlag(const FastName& flag)
@@ -224,6 +224,12 @@ public:
 
     static const FastName FLAG_HEIGHTMAP_FLOAT_TEXTURE;
 
+    static const FastName FLAG_INSTANCED_WORLD; //set by engine for instanced variant of material
+    static const FastName FLAG_INSTANCING_DISABLED; //exclude material from automatic instancing
+
+    static const FastName FLAG_VERTEX_QUANTIZED_POSITION; //geometry has quantized positions, see PolygonGroup::QUANTIZE_POSITION
+    static const FastName FLAG_VERTEX_OCTAHEDRAL_NORMAL; //geometry has octahedral normals, see PolygonGroup::QUANTIZE_NORMAL
+
     //Illumination params
     static const FastName FLAG_ILLUMINATION_USED;
     static const FastName FLAG_ILLUMINATION_SHADOW_CASTER;
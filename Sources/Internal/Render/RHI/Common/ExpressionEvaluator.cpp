@@ -132,6 +132,7 @@ void ExpressionEvaluator::Reset()
     operatorStack.clear();
     nodeStack.clear();
     nodeArray.clear();
+    usedVariables.clear();
     lastErrorCode = EXPRERR_NONE;
     lastErrorIndex = 0;
 }
@@ -296,7 +297,7 @@ static inline uint32 _GetOperand(const char* expression, float32* operand)
     }
 
     if (operand)
-        *operand = std::stof(expression);
+        *operand = strtof(expression, nullptr); // avoid copying rest of expression to std::string
 
     return ret;
 }
@@ -327,7 +328,14 @@ bool ExpressionEvaluator::Evaluate(const char* expression, float32* result)
     DVASSERT(len > 0);
     DVASSERT(len < EXPRESSION_BUFFER_SIZE);
 
-    memset(expressionText, 0, sizeof(expressionText));
+    // plain numbers are most common #define values, no need to build expr.tree for them
+    uint32 numberLength = _GetOperand(expression, nullptr);
+    if (IsValidDigitChar(expression[0]) && (expression[numberLength] == '\0' || expression[numberLength] == '\n' || expression[numberLength] == '\r'))
+    {
+        Reset();
+        _GetOperand(expression, result);
+        return true;
+    }
 
     const char* s = expression;
     char* d = expressionText;
@@ -370,7 +378,7 @@ bool ExpressionEvaluator::Evaluate(const char* expression, float32* result)
             *d++ = OpLogicalOr;
             s += 2;
         }
-        else if (strnicmp(s, "!defined", 8) == 0)
+        else if ((*s == '!') && strnicmp(s, "!defined", 8) == 0)
         {
             *d++ = OpNotDefined;
 
@@ -385,7 +393,7 @@ bool ExpressionEvaluator::Evaluate(const char* expression, float32* result)
 
             s += 8 + 1;
         }
-        else if (strnicmp(s, "defined", 7) == 0)
+        else if ((*s == 'd' || *s == 'D') && strnicmp(s, "defined", 7) == 0)
         {
             *d++ = OpDefined;
 
@@ -430,7 +438,7 @@ bool ExpressionEvaluator::Evaluate(const char* expression, float32* result)
     // build expr.tree
 
     const char* expr = expressionText; // expression;
-    char var[EXPRESSION_BUFFER_SIZE] = {};
+    char var[EXPRESSION_BUFFER_SIZE];
     bool last_token_operand = false;
     bool negate_operand_value = false;
     bool invert_operand_value = false;
@@ -482,9 +490,11 @@ bool ExpressionEvaluator::Evaluate(const char* expression, float32* result)
             }
             else
             {
-                if (varMap.find(vhash) != varMap.end())
+                usedVariables.push_back(vhash);
+                auto var_i = varMap.find(vhash);
+                if (var_i != varMap.end())
                 {
-                    float32 value = varMap[vhash];
+                    float32 value = var_i->second;
                     if (negate_operand_value)
                         value = -value;
                     if (invert_operand_value)
@@ -691,6 +701,23 @@ bool ExpressionEvaluator::HasVariable(const char* name) const
     return varMap.find(var_id) != varMap.end();
 }
 
+bool ExpressionEvaluator::GetVariable(uint32 nameHash, float32* value) const
+{
+    auto var_i = varMap.find(nameHash);
+    if (var_i == varMap.end())
+        return false;
+
+    if (value != nullptr)
+        *value = var_i->second;
+
+    return true;
+}
+
+const Vector<uint32>& ExpressionEvaluator::GetUsedVariables() const
+{
+    return usedVariables;
+}
+
 void ExpressionEvaluator::ClearVariables()
 {
     varMap.clear();
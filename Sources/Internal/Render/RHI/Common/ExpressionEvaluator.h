@@ -17,6 +17,12 @@ public:
     void ClearVariables();
 
     bool HasVariable(const char* name) const;
+    // variables are stored by hash of their name (see HashValue_N), returns false for undefined variable
+    bool GetVariable(uint32 nameHash, float32* value) const;
+
+    // hashes of variables looked up by last Evaluate, in order of lookup;
+    // result of successful evaluation depends only on values of these variables
+    const Vector<uint32>& GetUsedVariables() const;
 
     // returns
     // true, if there was error and fills provided buffer with error message
@@ -51,6 +57,7 @@ private:
     Vector<uint32> nodeStack;
     Vector<SyntaxTreeNode> nodeArray;
     UnorderedMap<uint32, float32> varMap;
+    Vector<uint32> usedVariables;
     uint32 lastErrorCode = 0;
     uint32 lastErrorIndex = EXPRERR_NONE;
 
@@ -1,7 +1,9 @@
 ﻿#include "Render/RHI/Common/PreProcessor.h"
 #include "Render/RHI/Common/Preprocessor/PreprocessorHelpers.h"
+#include "Concurrency/LockGuard.h"
 #include "FileSystem/File.h"
 #include "Logger/Logger.h"
+#include "Utils/StringFormat.h"
 #include "rhi_Utils.h"
 
 namespace DAVA
@@ -33,77 +35,135 @@ struct DefaultFileCallback : public PreProc::FileCallback
 };
 static DefaultFileCallback defaultFileCallback;
 
-template <class T>
-T GetNextToken(T txt, ptrdiff_t txtSize, ptrdiff_t& tokenSize)
+inline void AppendLine(PreProc::TextBuffer& output, const char* begin, const char* end)
 {
-    bool inRange = true;
+    static const char* endl = "\r\n";
+    static const int32 endl_sz = 2;
 
-    T firstValidSymbol = txt;
-    while (inRange && !IsValidAlphaChar(*firstValidSymbol))
-    {
-        ++firstValidSymbol;
-        inRange = (firstValidSymbol - txt) < txtSize;
-    }
+    output.insert(output.end(), begin, end);
+    output.insert(output.end(), endl, endl + endl_sz);
+}
+}
 
-    if (inRange)
+// Text is split to lines once and processed line by line for every set of defines.
+// Lines are processed exactly as former char by char processing did, including its corner cases:
+// - #if/#elif/#ifdef/#ifndef in skipped lines are evaluated too;
+// - empty line right after skipped line is output;
+// - last line without line ending is output as is, when it is skipped or when it is unfinished #define.
+struct PreProc::Line
+{
+    enum Type : uint8
     {
-        T token = firstValidSymbol;
-        while (IsValidAlphaNumericChar(*token))
-            ++token;
-        tokenSize = token - firstValidSymbol;
-    }
+        EmptyLine,
+        SpaceLine, // only spaces and tabs
+        TextLine,
+        DirectiveLine
+    };
 
-    return firstValidSymbol;
-}
+    uint32 begin = 0;
+    uint32 end = 0; // position of line ending or end of text
+    uint32 firstToken = 0;
+    uint32 tokenCount = 0;
+    uint32 directive = InvalidValue;
+    Type type = EmptyLine;
+    bool hasNewLine = false;
+};
 
-bool PerformMacroSubstitution(const char* source, char* targetBuffer, ptrdiff_t targetBufferSize, const PreProc::MacroMap& macro)
+struct PreProc::Directive
 {
-    bool marcoFound = false;
+    enum Type : uint8
+    {
+        Include,
+        DefineMacro,
+        EnsureDefined,
+        Undef,
+        Unknown,
+        // conditional directives are processed in skipped lines too
+        IfDef,
+        IfNDef,
+        If,
+        ElIf,
+        Else,
+        EndIf
+    };
 
-    ptrdiff_t bufferPos = 0;
+    // how other directives are passed in skipped lines
+    enum SkipAction : uint8
+    {
+        SkipLine,
+        SkipChained, // line continues with another directive, like "##if"
+        SkipLastLine, // line is output as is
+        SkipFail
+    };
 
-    const char* ptr = source;
-    const char* ptrEnd = SeekToLineEnding(source);
-    while (ptr < ptrEnd)
+    bool IsConditional() const
     {
-        ptrdiff_t tokenSize = 0;
-        const char* token = GetNextToken(ptr, ptrEnd - ptr, tokenSize);
+        return type >= IfDef;
+    }
 
-        if (token > ptr)
-        {
-            ptrdiff_t charactersSkipped = token - ptr;
-            DVASSERT(bufferPos + charactersSkipped < targetBufferSize);
-            memcpy(targetBuffer + bufferPos, ptr, charactersSkipped);
-            bufferPos += charactersSkipped;
-        }
+    Type type = Unknown;
+    SkipAction skipAction = SkipLine;
+    bool failed = false; // error is reported when directive is processed
+    bool unfinished = false; // #define at the end of text without line ending, text until `textEnd` is output instead
+    uint32 line = 0;
+    uint32 nextLine = 0; // processing continues from this line, InvalidValue when it fails after #include
+    uint32 chained = InvalidValue;
+    uint32 textEnd = 0;
+    String name; // #include file name or identifier
+    uint32 nameHash = 0;
+    String error;
+    Define define;
+    Expression condition;
+};
 
-        if (tokenSize > 0)
-        {
-            auto i = macro.find(PreProc::MacroStringBuffer(token, static_cast<uint32>(tokenSize)));
-            if (i != macro.end())
-            {
-                marcoFound = true;
-                DVASSERT(bufferPos + static_cast<ptrdiff_t>(i->second.length) < targetBufferSize);
-                memcpy(targetBuffer + bufferPos, i->second.value, i->second.length);
-                bufferPos += i->second.length;
-            }
-            else
-            {
-                DVASSERT(bufferPos + tokenSize < targetBufferSize);
-                memcpy(targetBuffer + bufferPos, token, tokenSize);
-                bufferPos += tokenSize;
-            }
-        }
+struct PreProc::CompiledText
+{
+    String text;
+    Vector<Line> lines;
+    Vector<Token> tokens;
+    Vector<Directive> directives;
+    Mutex resultsMutex; // text with results of its expressions may be used by several PreProc instances
+};
 
-        ptr = token + tokenSize;
-    }
+size_t PreProc::VariableValuesHash::operator()(const Vector<uint64>& values) const
+{
+    size_t hash = values.size();
+    for (uint64 value : values)
+        hash = hash * 31 + static_cast<size_t>(value ^ (value >> 32));
+    return hash;
+}
 
-    return marcoFound;
+PreProc::Define::Define(const char* nm, uint32 nameLength, const char* val, uint32 valueLength)
+    : name(nm, nameLength)
+    , nameHash(HashValue_N(nm, nameLength))
+    , valueHash(HashValue_N(val, valueLength))
+{
+    value.text.assign(val, valueLength);
+
+    nameValid = IsValidAlphaChar(name[0]);
+    for (char c : name)
+        nameValid = nameValid && IsValidAlphaNumericChar(c);
+
+    isNumber = IsValidDigitChar(val[0]);
+    for (uint32 i = 0; i != valueLength; ++i)
+        isNumber = isNumber && (IsValidDigitChar(val[i]) || val[i] == '.');
+    if (isNumber)
+        number = strtof(value.text.c_str(), nullptr);
+
+    Tokenize(value.text.c_str(), valueLength, valueTokens);
 }
+
+void PreProc::IncludeCache::Clear()
+{
+    LockGuard<Mutex> lock(mutex);
+    file.clear();
+    source.clear();
+    sourceOrder.clear();
 }
 
-PreProc::PreProc(FileCallback* fc)
+PreProc::PreProc(FileCallback* fc, IncludeCache* ic)
     : fileCB((fc) ? fc : &PreprocessorHelpers::defaultFileCallback)
+    , includeCache(ic)
 {
 }
 
@@ -114,140 +174,195 @@ PreProc::~PreProc()
 
 bool PreProc::ProcessFile(const char* file_name, TextBuffer* output)
 {
-    bool success = false;
-
-    if (fileCB->Open(file_name))
-    {
-        Reset();
-        curFileName = file_name;
-
-        uint32 text_sz = fileCB->Size();
-        char* text = AllocBuffer(text_sz + 1);
-        fileCB->Read(text_sz, text);
-        fileCB->Close();
+    std::shared_ptr<CompiledText> text;
+    if (!LoadFile(file_name, text))
+        return false;
 
-        success = ProcessInplaceInternal(text, output);
-    }
-    else
-    {
-        Logger::Error("Failed to open \"%s\"\n", file_name);
-    }
+    curFileName = file_name;
 
-    return success;
+    return (text != nullptr) && ProcessInternal(text, output);
 }
 
 bool PreProc::Process(const char* src_text, TextBuffer* output)
 {
-    Reset();
+    std::shared_ptr<CompiledText> text = (includeCache != nullptr) ? FindCompiledText(includeCache->source, src_text) : nullptr;
 
-    char* text = AllocBuffer(uint32(strlen(src_text)) + 1);
-    strcpy(text, src_text);
+    if (text == nullptr)
+    {
+        TextBuffer source(src_text, src_text + strlen(src_text) + 1);
 
-    return ProcessInplaceInternal(text, output);
+        uint32 text_sz = 0;
+        if (!StripComments(source.data(), text_sz))
+            return false;
+
+        text = Compile(source.data(), text_sz);
+        if (includeCache != nullptr)
+            CacheSourceText(src_text, text);
+    }
+
+    return ProcessInternal(text, output);
 }
 
 void PreProc::Clear()
 {
-    Reset();
     macro.clear();
+    defines.clear();
+    texts.clear();
+
+    for (uint32 b = 0; b != buffer.size(); ++b)
+        ::free(buffer[b]);
+    buffer.clear();
+    block = nullptr;
+    blockUsed = 0;
 }
 
 bool PreProc::AddDefine(const char* name, const char* value)
 {
-    return ProcessDefine(name, value);
+    defines.emplace_back(name, static_cast<uint32>(strlen(name)), value, static_cast<uint32>(strlen(value)));
+    return ProcessDefine(defines.back(), nullptr);
 }
 
-void PreProc::Reset()
+char* PreProc::AllocBuffer(uint32 sz)
 {
-    for (uint32 b = 0; b != buffer.size(); ++b)
-        ::free(buffer[b]);
-    buffer.clear();
+    if (sz > BufferBlockSize / 4)
+    {
+        void* ptr = ::calloc(1, sz);
+        buffer.emplace_back(reinterpret_cast<char*>(ptr));
+        return buffer.back();
+    }
+
+    // small buffers (expanded macro values) are placed one after another in shared block
+    if (block == nullptr || blockUsed + sz > BufferBlockSize)
+    {
+        block = reinterpret_cast<char*>(::calloc(1, BufferBlockSize));
+        blockUsed = 0;
+        buffer.emplace_back(block);
+    }
+
+    char* ptr = block + blockUsed;
+    blockUsed += sz;
+    return ptr;
 }
 
-char* PreProc::AllocBuffer(uint32 sz)
+bool PreProc::LoadFile(const char* file_name, std::shared_ptr<CompiledText>& text)
+{
+    text = (includeCache != nullptr) ? FindCompiledText(includeCache->file, file_name) : nullptr;
+    if (text != nullptr)
+        return true;
+
+    if (!fileCB->Open(file_name))
+    {
+        Logger::Error("Failed to open \"%s\"\n", file_name);
+        return false;
+    }
+
+    uint32 file_sz = fileCB->Size();
+    TextBuffer file_text(file_sz + 1);
+    fileCB->Read(file_sz, file_text.data());
+    fileCB->Close();
+
+    uint32 text_sz = 0;
+    if (StripComments(file_text.data(), text_sz))
+    {
+        text = Compile(file_text.data(), text_sz);
+        if (includeCache != nullptr)
+            CacheCompiledText(includeCache->file, file_name, text);
+    }
+
+    return true;
+}
+
+std::shared_ptr<PreProc::CompiledText> PreProc::FindCompiledText(const UnorderedMap<String, std::shared_ptr<CompiledText>>& cache, const char* key)
 {
-    void* ptr = ::calloc(1, sz);
-    buffer.emplace_back(reinterpret_cast<char*>(ptr));
-    return buffer.back();
+    LockGuard<Mutex> lock(includeCache->mutex);
+
+    // sources are several kilobytes long, so key string is reused instead of allocating new one for each lookup
+    includeCache->lookupKey.assign(key);
+    auto cached = cache.find(includeCache->lookupKey);
+    return (cached != cache.end()) ? cached->second : nullptr;
 }
 
-inline char* PreProc::GetExpression(char* txt, char** end) const
+void PreProc::CacheCompiledText(UnorderedMap<String, std::shared_ptr<CompiledText>>& cache, const char* key, const std::shared_ptr<CompiledText>& text)
 {
-    *end = SeekToLineEnding(txt);
-    **end = 0;
-    return txt;
+    LockGuard<Mutex> lock(includeCache->mutex);
+    cache.emplace(String(key), text);
 }
 
-char* PreProc::GetIdentifier(char* txt, char** end) const
+void PreProc::CacheSourceText(const char* key, const std::shared_ptr<CompiledText>& text)
 {
-    char* t = txt;
-    char* n = nullptr;
+    LockGuard<Mutex> lock(includeCache->mutex);
+
+    auto inserted = includeCache->source.emplace(String(key), text);
+    if (!inserted.second)
+        return;
 
+    // texts still used by PreProc instances are kept alive by them, cache only drops its reference
+    includeCache->sourceOrder.push_back(&inserted.first->first);
+    if (includeCache->sourceOrder.size() > MaxCachedSources)
+    {
+        auto oldest = includeCache->source.find(*includeCache->sourceOrder.front());
+        includeCache->sourceOrder.pop_front();
+        includeCache->source.erase(oldest);
+    }
+}
+
+bool PreProc::GetIdentifier(const char* txt, String* name, const char** end) const
+{
+    // identifier may be on next lines
+    const char* t = txt;
     while (!IsValidAlphaNumericChar(*t))
     {
         if (*t == Zero)
-            return nullptr;
+            return false;
         ++t;
     }
 
-    if (*t == Zero)
-        return nullptr;
-
-    n = t;
-
+    const char* n = t;
     while (IsValidAlphaNumericChar(*t))
         ++t;
 
     if (*t == Zero)
-        return nullptr;
-
-    if (*t != NewLine)
-    {
-        *t = Zero;
-        ++t;
-    }
+        return false;
 
-    while (*t != NewLine)
-    {
-        if (*t == Zero)
-            return nullptr;
+    name->assign(n, t);
 
-        ++t;
-    }
+    t = SeekToLineEnding(t);
+    if (*t == Zero)
+        return false;
 
-    *t = Zero;
     *end = t;
-    return n;
+    return true;
 }
 
-int32 PreProc::GetNameAndValue(char* txt, char** name, char** value, char** end) const
+bool PreProc::GetNameAndValue(const char* txt, String* name, String* value, const char** end) const
 {
-    // returns:
-    // non-zero when name/value successfully retrieved
-    // zero, if name/value not retieved;
-    // -1, if end-of-file was encountered (name/value successfully retrieved)
+    // returns false if text ends before name/value line does,
+    // `end` is set to the end of line text then (text after value is cut off)
 
-    char* t = SkipWhitespace(txt);
+    const char* t = SkipWhitespace(txt);
+    *end = t;
 
     if (*t == Zero)
-        return 0;
+        return false;
 
-    char* n0 = t;
+    const char* n0 = t;
 
     while ((*t != Zero) && (*t != Space) && (*t != Tab) && (*t != NewLine))
         ++t;
 
+    *end = t;
     if (*t == Zero)
-        return 0;
+        return false;
 
-    char* n1 = t - 1;
+    const char* n1 = t;
 
     t = SkipWhitespace(t);
 
+    *end = t;
     if (*t == Zero)
-        return 0;
+        return false;
 
-    char* v0 = t;
+    const char* v0 = t;
     int32 brace_lev = 0;
     while ((*t != Zero) && (*t != Space || brace_lev > 0) && (*t != Tab) && (*t != NewLine))
     {
@@ -259,61 +374,46 @@ int32 PreProc::GetNameAndValue(char* txt, char** name, char** value, char** end)
         ++t;
     }
 
+    *end = t;
     if (*t == Zero)
-        return 0;
-
-    char* v1 = t - 1;
-
-    *name = n0;
-    *value = v0;
-
-    if (*t != Zero)
-    {
-        if (*t != NewLine)
-        {
-            *t = Zero;
-            ++t;
-        }
+        return false;
 
-        t = SeekToLineEnding(t);
-        if (*t == Zero)
-            return 0;
+    const char* v1 = t;
 
-        *t = Zero;
-        *end = t;
+    if (*t != NewLine)
+        ++t;
 
-        *(n1 + 1) = Zero;
-        *(v1 + 1) = Zero;
+    t = SeekToLineEnding(t);
+    if (*t == Zero)
+        return false;
 
-        return 1;
-    }
-    else
-    {
-        *end = t;
-        *(n1 + 1) = Zero;
-        *(v1 + 1) = Zero;
-        return -1;
-    }
+    name->assign(n0, n1);
+    value->assign(v0, v1);
+    *end = t;
+    return true;
 }
 
-bool PreProc::ProcessBuffer(char* inputText, LineVector& lines)
+bool PreProc::StripComments(char* inputText, uint32& textLength)
 {
-    uint32 textLength = 0;
+    textLength = 0;
     char* dest = inputText;
     char* source = inputText;
 
     for (; *source != Zero; ++source)
     {
-        char* begin = source;
-        bool unterminatedComment = false;
-        source = SkipCommentBlock(source, unterminatedComment);
-        if (unterminatedComment)
+        if (*source == '/')
         {
-            Logger::Error("Unterminated comment, starting at:\n%s", begin);
-            return false;
-        }
+            char* begin = source;
+            bool unterminatedComment = false;
+            source = SkipCommentBlock(source, unterminatedComment);
+            if (unterminatedComment)
+            {
+                Logger::Error("Unterminated comment, starting at:\n%s", begin);
+                return false;
+            }
 
-        source = SkipCommentLine(source);
+            source = SkipCommentLine(source);
+        }
 
         char currentChar = *source;
         if (currentChar != CarriageReturn)
@@ -327,477 +427,570 @@ bool PreProc::ProcessBuffer(char* inputText, LineVector& lines)
     }
     *dest = Zero;
 
-    char* currentLine = inputText;
-    uint32 line_n = 1;
-    uint32 src_line_n = 1;
+    return true;
+}
 
-    struct condition_t
+void PreProc::Tokenize(const char* txt, uint32 length, Vector<Token>& tokens)
+{
+    // same tokens as GetNextToken found: identifier starts with letter, which is not part of previous identifier
+    for (uint32 i = 0; i < length;)
     {
-        bool original_condition;
-        bool effective_condition;
-        bool do_skip_lines;
-    };
+        if (IsValidAlphaChar(txt[i]))
+        {
+            uint32 begin = i;
+            while (i < length && IsValidAlphaNumericChar(txt[i]))
+                ++i;
+
+            Token token;
+            token.offset = begin;
+            token.length = i - begin;
+            token.hash = HashValue_N(txt + begin, token.length);
+            tokens.push_back(token);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
 
-    std::vector<condition_t> pending_elif;
-    pending_elif.reserve(16);
-    bool dcheck_pending = true;
+std::shared_ptr<PreProc::CompiledText> PreProc::Compile(const char* src_text, uint32 textLength) const
+{
+    std::shared_ptr<CompiledText> result = std::make_shared<CompiledText>();
+    CompiledText& compiled = *result;
+    compiled.text.assign(src_text, textLength);
 
-    pending_elif.emplace_back();
-    pending_elif.back().do_skip_lines = false;
+    const char* text = compiled.text.c_str();
+    for (uint32 begin = 0; begin < textLength;)
+    {
+        Line line;
+        line.begin = begin;
+        line.end = static_cast<uint32>(SeekToLineEnding(text + begin) - text);
+        line.hasNewLine = (line.end < textLength);
+        compiled.lines.push_back(line);
+
+        begin = line.end + 1;
+    }
 
-    for (char* currentChar = inputText; (static_cast<uint32>(currentChar - inputText) < textLength) && (*currentChar != Zero); ++currentChar)
+    for (uint32 line_i = 0; line_i != compiled.lines.size(); ++line_i)
     {
-        int32 skipping_line = false;
+        Line& line = compiled.lines[line_i];
+        uint32 position = static_cast<uint32>(SkipWhitespace(text + line.begin) - text);
 
-        /* searching from last to first entries in pending_elif (notice rbegin, rend)*/
-        for (auto i = pending_elif.rbegin(), e = pending_elif.rend(); i != e; ++i)
+        if (line.begin == line.end)
         {
-            if (i->do_skip_lines)
-            {
-                skipping_line = true;
-                break;
-            }
+            line.type = Line::EmptyLine;
         }
-
-        if (skipping_line)
+        else if (position == line.end)
         {
-            bool do_skip = true;
-
-            if (dcheck_pending)
-            {
-                char* ns1 = SkipWhitespace(currentChar);
+            line.type = Line::SpaceLine;
+        }
+        else if (text[position] == '#')
+        {
+            line.type = Line::DirectiveLine;
+            line.directive = CompileDirective(compiled, line_i, position);
+        }
+        else
+        {
+            line.type = Line::TextLine;
+            line.firstToken = static_cast<uint32>(compiled.tokens.size());
+            Tokenize(text + line.begin, line.end - line.begin, compiled.tokens);
+            line.tokenCount = static_cast<uint32>(compiled.tokens.size()) - line.firstToken;
+        }
+    }
 
-                if (*ns1 == Zero)
-                    return false;
+    return result;
+}
 
-                if (*ns1 == '#')
-                    do_skip = false;
-            }
+uint32 PreProc::CompileDirective(CompiledText& compiled, uint32 line_i, uint32 position) const
+{
+    const char* text = compiled.text.c_str();
+    const uint32 textLength = static_cast<uint32>(compiled.text.size());
+    const Line& line = compiled.lines[line_i];
+    const char* directiveText = text + position + 1;
+
+    // directive may take several lines, when its arguments are on next lines
+    auto nextLineAfter = [&compiled, text](const char* lineEnding) {
+        uint32 end = static_cast<uint32>(lineEnding - text);
+        auto found = std::lower_bound(compiled.lines.begin(), compiled.lines.end(), end, [](const Line& l, uint32 e) { return l.end < e; });
+        return static_cast<uint32>(found - compiled.lines.begin()) + 1;
+    };
 
-            if (do_skip)
-            {
-                currentChar = SeekToLineEnding(currentChar);
+    Directive directive;
+    directive.line = line_i;
+    directive.nextLine = line_i + 1;
+    directive.textEnd = textLength;
 
-                if (*currentChar == Zero)
-                    break;
+    if (strncmp(directiveText, "include", 7) == 0)
+    {
+        directive.type = Directive::Include;
 
-                ++currentChar;
-                currentLine = currentChar;
+        const char* t = SeekToCharacter(directiveText - 1, DoubleQuotes);
+        const char* includeFileName = t + 1;
+        if (*t == Zero)
+        {
+            directive.failed = true;
+            directive.error = "#include does not contain filename in double quotes";
+        }
+        else if (*(t = SeekToCharacter(includeFileName, DoubleQuotes)) == Zero)
+        {
+            directive.failed = true;
+            directive.error = "#include contains unterminated double quotes";
+        }
+        else
+        {
+            directive.name.assign(includeFileName, t);
 
-                ++src_line_n;
-                dcheck_pending = true;
-            }
+            t = SeekToLineEnding(t + 1);
+            directive.nextLine = (*t == Zero) ? InvalidValue : nextLineAfter(t);
         }
+    }
+    else if ((strncmp(directiveText, "define", 6) == 0) || (strncmp(directiveText, "ensuredefined", 13) == 0))
+    {
+        bool ensure = (directiveText[0] == 'e');
+        directive.type = ensure ? Directive::EnsureDefined : Directive::DefineMacro;
 
-        bool expand_macros = false;
+        String name;
+        String value;
+        const char* end = nullptr;
+        if (!GetNameAndValue(directiveText + (ensure ? 13 : 6), &name, &value, &end))
+        {
+            directive.unfinished = true;
+            directive.textEnd = static_cast<uint32>(end - text);
+        }
+        else if (value.empty())
+        {
+            directive.failed = true;
+            directive.error = Format("%s without value not allowed (%s)", ensure ? "#ensuredefined" : "#define", name.c_str());
+        }
+        else
+        {
+            directive.define = Define(name.c_str(), static_cast<uint32>(name.size()), value.c_str(), static_cast<uint32>(value.size()));
+        }
+    }
+    else if ((strncmp(directiveText, "undef", 5) == 0) || (strncmp(directiveText, "ifdef", 5) == 0) || (strncmp(directiveText, "ifndef", 6) == 0))
+    {
+        if (directiveText[0] == 'u')
+            directive.type = Directive::Undef;
+        else
+            directive.type = (directiveText[2] == 'd') ? Directive::IfDef : Directive::IfNDef;
 
-        if (*currentChar == NewLine)
+        const char* end = nullptr;
+        if (GetIdentifier(directiveText + ((directive.type == Directive::IfNDef) ? 6 : 5), &directive.name, &end))
+        {
+            directive.nameHash = HashValue_N(directive.name.c_str(), static_cast<uint32>(directive.name.size()));
+            directive.nextLine = nextLineAfter(end);
+        }
+        else
         {
-            *currentChar = Zero;
-            lines.emplace_back(currentLine, line_n);
+            static const char* errors[] = { "#under without identified not allowed", "#ifdef without identified not allowed", "#ifndef without identified not allowed" };
+            directive.failed = true;
+            directive.error = errors[(directive.type == Directive::Undef) ? 0 : ((directive.type == Directive::IfDef) ? 1 : 2)];
+        }
+    }
+    else if (strncmp(directiveText, "if", 2) == 0)
+    {
+        directive.type = Directive::If;
+        directive.condition.text.assign(directiveText + 2, text + line.end);
+    }
+    else if (strncmp(directiveText, "elif", 4) == 0)
+    {
+        directive.type = Directive::ElIf;
+        directive.condition.text.assign(directiveText + 4, text + line.end);
+    }
+    else if (strncmp(directiveText, "else", 4) == 0)
+    {
+        directive.type = Directive::Else;
+    }
+    else if (strncmp(directiveText, "endif", 5) == 0)
+    {
+        directive.type = Directive::EndIf;
+    }
 
-            currentLine = currentChar + 1;
-            ++line_n;
-            ++src_line_n;
-            dcheck_pending = true;
+    uint32 chainedPosition = InvalidValue;
+    if (!directive.IsConditional())
+    {
+        // in skipped lines text after '#' is checked as start of new line
+        const char* t = SkipWhitespace(directiveText);
+        if (position + 1 == textLength)
+        {
+            directive.skipAction = Directive::SkipLastLine;
+        }
+        else if (*t == Zero)
+        {
+            directive.skipAction = Directive::SkipFail;
+        }
+        else if (*t == '#')
+        {
+            directive.skipAction = Directive::SkipChained;
+            chainedPosition = static_cast<uint32>(t - text);
         }
-        else if (dcheck_pending)
+        else if (*SeekToLineEnding(directiveText) == Zero)
         {
-            char* ns1 = SkipWhitespace(currentChar);
+            directive.skipAction = Directive::SkipLastLine;
+        }
+    }
 
-            if (*ns1 == Zero)
-                break;
+    uint32 directive_i = static_cast<uint32>(compiled.directives.size());
+    compiled.directives.push_back(std::move(directive));
 
-            if (*ns1 == '#')
-            {
-                currentChar = ns1;
-                if (!skipping_line && strncmp(currentChar + 1, "include", 7) == 0)
-                {
-                    char* t = SeekToCharacter(currentChar, DoubleQuotes);
-                    if (*t == 0)
-                    {
-                        Logger::Error("#include does not contain filename in double quotes");
-                        return false;
-                    }
+    if (chainedPosition != InvalidValue)
+    {
+        uint32 chained = CompileDirective(compiled, line_i, chainedPosition);
+        compiled.directives[directive_i].chained = chained;
+    }
 
-                    char* includeFileName = t + 1;
+    return directive_i;
+}
 
-                    t = SeekToCharacter(t + 1, DoubleQuotes);
+bool PreProc::ProcessInternal(const std::shared_ptr<CompiledText>& text, TextBuffer* output)
+{
+    texts.push_back(text);
 
-                    if (*t == 0)
-                    {
-                        Logger::Error("#include contains unterminated double quotes");
-                        return false;
-                    }
+    TextBuffer result;
+    result.reserve(text->text.size());
+    if (!ProcessText(*text, result))
+        return false;
 
-                    *t = Zero; // make includeFileName zero terminated
+    output->swap(result);
+    return true;
+}
 
-                    if (!ProcessInclude(includeFileName, lines))
-                        return false;
+bool PreProc::ProcessText(CompiledText& compiled, TextBuffer& output)
+{
+    using PreprocessorHelpers::AppendLine;
 
-                    t = SeekToLineEnding(t + 1);
+    const char* text = compiled.text.c_str();
+    const uint32 lineCount = static_cast<uint32>(compiled.lines.size());
 
-                    if (*t == Zero)
-                        return false;
+    Vector<Condition> conditions;
+    conditions.reserve(16);
+    conditions.push_back(Condition{ false, false, false });
+    uint32 skippedConditions = 0;
 
-                    currentChar = t;
-                    currentLine = t + 1;
-                }
-                else if (!skipping_line && strncmp(currentChar + 1, "define", 6) == 0)
-                {
-                    char* name = nullptr;
-                    char* value = nullptr;
-                    int32 nv = GetNameAndValue(currentChar + 1 + 6, &name, &value, &currentChar);
-
-                    if (nv)
-                    {
-                        if (value[0] == Zero)
-                        {
-                            Logger::Error("#define without value not allowed (%s)", name);
-                            return false;
-                        }
-
-                        if (!ProcessDefine(name, value))
-                            return false;
-
-                        if (nv != -1)
-                        {
-                            *currentChar = NewLine; // since it was null'ed in GetNameAndValue
-                            currentLine = currentChar + 1;
-                        }
-                        else
-                        {
-                            currentLine = currentChar;
-                            break;
-                        }
-                    }
-                    else
-                    {
-                        break;
-                    }
-                }
-                else if (!skipping_line && strncmp(currentChar + 1, "ensuredefined", 13) == 0)
-                {
-                    char* name = nullptr;
-                    char* value = nullptr;
-                    int32 nv = GetNameAndValue(currentChar + 1 + 13, &name, &value, &currentChar);
-
-                    if (nv)
-                    {
-                        if (value[0] == Zero)
-                        {
-                            Logger::Error("#ensuredefined without value not allowed (%s)", name);
-                            return false;
-                        }
-
-                        if (!evaluator.HasVariable(name))
-                        {
-                            if (!ProcessDefine(name, value))
-                                return false;
-                        }
-
-                        if (nv != -1)
-                        {
-                            *currentChar = NewLine; // since it was null'ed in GetNameAndValue
-                            currentLine = currentChar + 1;
-                        }
-                        else
-                        {
-                            currentLine = currentChar;
-                            break;
-                        }
-                    }
-                    else
-                    {
-                        break;
-                    }
-                }
-                else if (!skipping_line && strncmp(currentChar + 1, "undef", 5) == 0)
-                {
-                    char* name = GetIdentifier(currentChar + 1 + 5, &currentChar);
-                    if (name == nullptr)
-                    {
-                        Logger::Error("#under without identified not allowed");
-                        return false;
-                    }
-
-                    Undefine(name);
-                    *currentChar = NewLine; // since it was null'ed in GetIdentifier
-                    currentLine = currentChar + 1;
-                }
-                else if (strncmp(currentChar + 1, "ifdef", 5) == 0)
+    // after skipped line next one is processed without usual checks, notably empty line is output
+    bool afterSkippedLine = false;
+
+    for (uint32 line_i = 0; line_i < lineCount;)
+    {
+        const Line& line = compiled.lines[line_i];
+        const bool skipping = (skippedConditions != 0);
+
+        if (line.type != Line::DirectiveLine)
+        {
+            if (!skipping)
+            {
+                if (line.type == Line::TextLine)
                 {
-                    char* name = GetIdentifier(currentChar + 1 + 5, &currentChar);
-                    if (name == nullptr)
-                    {
-                        Logger::Error("#ifdef without identified not allowed");
-                        return false;
-                    }
-
-                    bool condition = evaluator.HasVariable(name);
-
-                    condition_t p;
-                    p.original_condition = condition;
-                    p.effective_condition = condition;
-                    p.do_skip_lines = !condition;
-                    pending_elif.push_back(p);
-
-                    *currentChar = NewLine; // since it was null'ed in GetIdentifier
-                    currentLine = currentChar + 1;
+                    size_t outputSize = output.size();
+                    ExpandMacros(text + line.begin, text + line.end, compiled.tokens.data() + line.firstToken, line.tokenCount, output);
+                    if (line.hasNewLine || output.size() != outputSize)
+                        AppendLine(output, nullptr, nullptr);
                 }
-                else if (strncmp(currentChar + 1, "ifndef", 6) == 0)
+                else
                 {
-                    char* name = GetIdentifier(currentChar + 1 + 6, &currentChar);
-                    if (name == nullptr)
-                    {
-                        Logger::Error("#ifndef without identified not allowed");
-                        return false;
-                    }
-
-                    bool condition = !evaluator.HasVariable(name);
-
-                    condition_t p;
-                    p.original_condition = condition;
-                    p.effective_condition = condition;
-                    p.do_skip_lines = !condition;
-                    pending_elif.push_back(p);
-
-                    *currentChar = NewLine; // since it was null'ed in GetIdentifier
-                    currentLine = currentChar + 1;
+                    AppendLine(output, text + line.begin, text + line.end);
                 }
-                else if (strncmp(currentChar + 1, "if", 2) == 0)
-                {
-                    char* e = GetExpression(currentChar + 1 + 2, &currentChar);
-
-                    float v = 0;
-                    if (!evaluator.Evaluate(e, &v))
-                    {
-                        ReportExprEvalError(src_line_n);
-                        return false;
-                    }
+            }
+            else if (afterSkippedLine && line.type == Line::EmptyLine)
+            {
+                AppendLine(output, nullptr, nullptr);
+                afterSkippedLine = false;
+            }
+            else if (!afterSkippedLine && line.type == Line::SpaceLine && !line.hasNewLine)
+            {
+                return false;
+            }
+            else if (!line.hasNewLine)
+            {
+                AppendLine(output, text + line.begin, text + line.end);
+            }
+            else
+            {
+                afterSkippedLine = true;
+            }
 
-                    *currentChar = NewLine; // since it was null'ed in GetExpression
-                    currentLine = currentChar + 1;
+            ++line_i;
+            continue;
+        }
 
-                    bool condition = (v != 0.0f);
+        Directive* directive = &compiled.directives[line.directive];
+        if (skipping)
+        {
+            while (!directive->IsConditional() && directive->skipAction == Directive::SkipChained)
+                directive = &compiled.directives[directive->chained];
 
-                    condition_t p;
-                    p.original_condition = condition;
-                    p.effective_condition = condition;
-                    p.do_skip_lines = !condition;
-                    pending_elif.push_back(p);
-                }
-                else if (strncmp(currentChar + 1, "elif", 4) == 0)
-                {
-                    char* e = GetExpression(currentChar + 1 + 4, &currentChar);
+            if (!directive->IsConditional())
+            {
+                if (directive->skipAction == Directive::SkipFail)
+                    return false;
 
-                    float v = 0.0f;
-                    if (!evaluator.Evaluate(e, &v))
-                    {
-                        ReportExprEvalError(src_line_n);
-                        return false;
-                    }
+                if (directive->skipAction == Directive::SkipLastLine)
+                    AppendLine(output, text + line.begin, text + line.end);
 
-                    *currentChar = NewLine; // since it was null'ed in GetExpression
-                    currentLine = currentChar + 1;
+                afterSkippedLine = true;
+                ++line_i;
+                continue;
+            }
+        }
 
-                    bool condition = (v != 0.0f);
+        afterSkippedLine = false;
 
-                    if (pending_elif.back().original_condition)
-                        pending_elif.back().do_skip_lines = true;
-                    else
-                        pending_elif.back().do_skip_lines = !condition;
+        if (directive->failed)
+        {
+            Logger::Error("%s", directive->error.c_str());
+            return false;
+        }
 
-                    pending_elif.back().effective_condition = pending_elif.back().effective_condition || condition;
+        switch (directive->type)
+        {
+        case Directive::Include:
+        {
+            if (!ProcessInclude(directive->name.c_str(), output))
+                return false;
 
-                    if (*currentChar == Zero)
-                    {
-                        currentLine[0] = Zero;
-                        break;
-                    }
-                }
-                else if (strncmp(currentChar + 1, "else", 4) == 0)
-                {
-                    pending_elif.back().do_skip_lines = pending_elif.back().effective_condition;
+            if (directive->nextLine == InvalidValue)
+                return false;
+        }
+        break;
 
-                    while (*currentChar && *currentChar != NewLine)
-                        ++currentChar;
+        case Directive::DefineMacro:
+        case Directive::EnsureDefined:
+        {
+            if (directive->unfinished)
+            {
+                AppendLine(output, text + line.begin, text + directive->textEnd);
+                return true;
+            }
 
-                    if (*currentChar == Zero)
-                    {
-                        currentLine[0] = Zero;
-                        break;
-                    }
+            Define& define = directive->define;
+            if (directive->type == Directive::DefineMacro || !evaluator.GetVariable(define.nameHash, nullptr))
+            {
+                if (!ProcessDefine(define, &compiled.resultsMutex))
+                    return false;
+            }
+        }
+        break;
 
-                    currentLine = currentChar + 1;
-                }
-                else if (strncmp(currentChar + 1, "endif", 5) == 0)
-                {
-                    DVASSERT(pending_elif.size());
-                    pending_elif.pop_back();
+        case Directive::Undef:
+        {
+            Undefine(directive->name, directive->nameHash);
+        }
+        break;
 
-                    while (*currentChar && *currentChar != NewLine)
-                        ++currentChar;
+        case Directive::IfDef:
+        case Directive::IfNDef:
+        {
+            bool condition = evaluator.GetVariable(directive->nameHash, nullptr);
+            if (directive->type == Directive::IfNDef)
+                condition = !condition;
 
-                    if (*currentChar == Zero)
-                    {
-                        currentLine[0] = Zero;
-                        break;
-                    }
+            conditions.push_back(Condition{ condition, condition, false });
+            SetSkipLines(conditions.back(), !condition, skippedConditions);
+        }
+        break;
 
-                    currentLine = currentChar + 1;
-                }
-                else if (!skipping_line)
-                {
-                    Logger::Error("Unknown preprocessor directive \"%s\"", currentChar + 1);
-                    break;
-                }
+        case Directive::If:
+        case Directive::ElIf:
+        {
+            float32 v = 0.0f;
+            if (!Evaluate(directive->condition, &compiled.resultsMutex, &v))
+            {
+                ReportExprEvalError(directive->line + 1);
+                return false;
+            }
 
-                dcheck_pending = true;
+            bool condition = (v != 0.0f);
+            if (directive->type == Directive::If)
+            {
+                conditions.push_back(Condition{ condition, condition, false });
+                SetSkipLines(conditions.back(), !condition, skippedConditions);
             }
             else
             {
-                if (*ns1 == NewLine)
-                    currentChar = ns1 - 1;
-
-                dcheck_pending = false;
-                expand_macros = (*ns1 != NewLine) && (!skipping_line);
+                DVASSERT(!conditions.empty());
+                Condition& c = conditions.back();
+                SetSkipLines(c, c.originalCondition || !condition, skippedConditions);
+                c.effectiveCondition = c.effectiveCondition || condition;
             }
         }
-        else
+        break;
+
+        case Directive::Else:
         {
-            expand_macros = true;
+            DVASSERT(!conditions.empty());
+            SetSkipLines(conditions.back(), conditions.back().effectiveCondition, skippedConditions);
         }
+        break;
 
-        if (expand_macros)
+        case Directive::EndIf:
         {
-            currentLine = ExpandMacroInLine(currentChar);
-            currentChar = SeekToLineEnding(currentChar) - 1; /* -1 added to compensate increment in loop ¯\_(ツ)_/¯ */
+            DVASSERT(!conditions.empty());
+            SetSkipLines(conditions.back(), false, skippedConditions);
+            conditions.pop_back();
+        }
+        break;
+
+        case Directive::Unknown:
+        {
+            Logger::Error("Unknown preprocessor directive \"%.*s\"", static_cast<int32>(line.end - line.begin), text + line.begin);
+            // the rest of text is output as is
+            AppendLine(output, text + line.begin, text + directive->textEnd);
+            return true;
+        }
         }
-    }
 
-    if (currentLine[0] != Zero)
-        lines.emplace_back(currentLine, line_n);
+        line_i = directive->nextLine;
+    }
 
     return true;
 }
 
-bool PreProc::ProcessInplaceInternal(char* src_text, TextBuffer* output)
+void PreProc::SetSkipLines(Condition& condition, bool skipLines, uint32& skippedConditions) const
 {
-    bool success = false;
-
-    LineVector lines;
-    if (ProcessBuffer(src_text, lines))
+    if (condition.skipLines != skipLines)
     {
-        GenerateOutput(output, lines);
-        success = true;
+        condition.skipLines = skipLines;
+        skippedConditions = skipLines ? skippedConditions + 1 : skippedConditions - 1;
     }
-
-    return success;
 }
 
-bool PreProc::ProcessInclude(const char* file_name, LineVector& line_)
+bool PreProc::ProcessInclude(const char* file_name, TextBuffer& output)
 {
-    bool success = false;
+    std::shared_ptr<CompiledText> text;
+    if (!LoadFile(file_name, text))
+        return false;
 
-    if (fileCB->Open(file_name))
+    // errors in included file are reported, but don't fail including one
+    if (text != nullptr)
     {
-        uint32 text_sz = fileCB->Size();
-        char* text = AllocBuffer(text_sz + 1);
-        fileCB->Read(text_sz, text);
-        fileCB->Close();
+        texts.push_back(text);
 
         const char* prev_file_name = curFileName;
 
         curFileName = file_name;
-        ProcessBuffer(text, line_);
+        ProcessText(*text, output);
         curFileName = prev_file_name;
-        success = true;
-    }
-    else
-    {
-        Logger::Error("Failed to open \"%s\"\n", file_name);
     }
 
-    return success;
+    return true;
 }
 
-bool PreProc::ProcessDefine(const char* name, const char* value)
+bool PreProc::ProcessDefine(Define& define, Mutex* resultsMutex)
 {
-    bool name_valid = IsValidAlphaChar(name[0]);
-
-    for (const char* n = name; *n; ++n)
-    {
-        if (!IsValidAlphaNumericChar(*n))
-        {
-            name_valid = false;
-            break;
-        }
-    }
-
-    if (!name_valid)
+    if (!define.nameValid)
     {
-        Logger::Error("Invalid identifier \"%s\"", name);
+        Logger::Error("Invalid identifier \"%s\"", define.name.c_str());
         return false;
     }
 
-    float val = 0.0f;
-    if (evaluator.Evaluate(value, &val))
-        evaluator.SetVariable(name, val);
+    float32 val = define.number;
+    if (define.isNumber || Evaluate(define.value, resultsMutex, &val))
+        evaluator.SetVariable(define.name.c_str(), val);
 
-    const char* macroValue = nullptr;
-    uint32 macroValueLength = 0;
+    const String& value = define.value.text;
+    MacroStringBuffer macroValue(value.c_str(), static_cast<uint32>(value.size()), define.valueHash);
 
-    char localBuffer[MaxMacroValueLength] = {};
-    if (PreprocessorHelpers::PerformMacroSubstitution(value, localBuffer, MaxMacroValueLength, macro))
+    expandedValue.clear();
+    if (!define.valueTokens.empty() && ExpandMacros(value.c_str(), value.c_str() + value.size(), define.valueTokens.data(), static_cast<uint32>(define.valueTokens.size()), expandedValue))
     {
-        macroValueLength = static_cast<uint32>(strlen(localBuffer));
-        char* macroValueBuffer = AllocBuffer(macroValueLength + 1);
-        memcpy(macroValueBuffer, localBuffer, macroValueLength);
-        macroValue = macroValueBuffer;
-    }
-    else
-    {
-        macroValue = value;
-        macroValueLength = static_cast<uint32>(strlen(value));
+        uint32 length = static_cast<uint32>(expandedValue.size());
+        DVASSERT(length < MaxMacroValueLength);
+
+        char* macroValueBuffer = AllocBuffer(length + 1);
+        memcpy(macroValueBuffer, expandedValue.data(), length);
+        macroValue = MacroStringBuffer(macroValueBuffer, length);
     }
-    macro.emplace(MacroStringBuffer(name, static_cast<uint32>(strlen(name))), MacroStringBuffer(macroValue, macroValueLength));
+    macro.emplace(MacroStringBuffer(define.name.c_str(), static_cast<uint32>(define.name.size()), define.nameHash), macroValue);
 
     return true;
 }
 
-char* PreProc::ExpandMacroInLine(char* txt)
+bool PreProc::ExpandMacros(const char* txt, const char* txtEnd, const Token* tokens, uint32 tokenCount, TextBuffer& output) const
 {
-    char* result = txt;
-    char localBuffer[MaxLocalStringLength]{};
-    if (PreprocessorHelpers::PerformMacroSubstitution(txt, localBuffer, MaxLocalStringLength, macro))
+    bool macroFound = false;
+    const char* copiedEnd = txt;
+
+    if (!macro.empty())
     {
-        uint32 resultStringLength = static_cast<uint32>(strlen(localBuffer));
-        result = AllocBuffer(resultStringLength + 1);
-        memcpy(result, localBuffer, resultStringLength);
+        for (const Token *t = tokens, *tokensEnd = tokens + tokenCount; t != tokensEnd; ++t)
+        {
+            const char* token = txt + t->offset;
+            auto i = macro.find(MacroStringBuffer(token, t->length, t->hash));
+            if (i != macro.end())
+            {
+                // text between macros is copied only when next macro is found
+                output.insert(output.end(), copiedEnd, token);
+                output.insert(output.end(), i->second.value, i->second.value + i->second.length);
+                copiedEnd = token + t->length;
+                macroFound = true;
+            }
+        }
     }
-    return result;
+
+    output.insert(output.end(), copiedEnd, txtEnd);
+    return macroFound;
 }
 
-void PreProc::Undefine(const char* name)
+void PreProc::Undefine(const String& name, uint32 nameHash)
 {
-    evaluator.RemoveVariable(name);
-    macro.erase(MacroStringBuffer(name, static_cast<uint32>(strlen(name))));
+    evaluator.RemoveVariable(name.c_str());
+    macro.erase(MacroStringBuffer(name.c_str(), static_cast<uint32>(name.size()), nameHash));
 }
 
-void PreProc::GenerateOutput(TextBuffer* output, LineVector& lines)
+bool PreProc::Evaluate(Expression& expression, Mutex* resultsMutex, float32* result)
 {
-    static const char* endl = "\r\n";
-    static const int32 endl_sz = 2;
+    if (resultsMutex == nullptr)
+        return evaluator.Evaluate(expression.text.c_str(), result);
+
+    // expression result depends only on values of variables evaluator looks up,
+    // so it is reused for variants with same values of these variables
+    auto getVariableValues = [this, &expression]() {
+        variableValues.clear();
+        for (uint32 nameHash : expression.variables)
+        {
+            float32 value = 0.0f;
+            uint64 state = 0;
+            if (evaluator.GetVariable(nameHash, &value))
+            {
+                uint32 valueBits = 0;
+                memcpy(&valueBits, &value, sizeof(valueBits));
+                state = (uint64(1) << 32) | valueBits;
+            }
+            variableValues.push_back(state);
+        }
+    };
 
-    output->clear();
-    for (auto l = lines.begin(), l_end = lines.end(); l != l_end; ++l)
     {
-        uint32 sz = uint32(strlen(l->text));
+        LockGuard<Mutex> lock(*resultsMutex);
+        if (expression.evaluated)
+        {
+            getVariableValues();
+            auto found = expression.results.find(variableValues);
+            if (found != expression.results.end())
+            {
+                *result = found->second;
+                return true;
+            }
+        }
+    }
+
+    if (!evaluator.Evaluate(expression.text.c_str(), result))
+        return false;
 
-        output->insert(output->end(), l->text, l->text + sz);
-        output->insert(output->end(), endl, endl + endl_sz);
+    LockGuard<Mutex> lock(*resultsMutex);
+    if (!expression.evaluated)
+    {
+        expression.variables = evaluator.GetUsedVariables();
+        expression.evaluated = true;
+    }
+    if (expression.results.size() < MaxExpressionResults)
+    {
+        getVariableValues();
+        expression.results.emplace(variableValues, *result);
     }
+
+    return true;
 }
 
 void PreProc::ReportExprEvalError(uint32 line_n)
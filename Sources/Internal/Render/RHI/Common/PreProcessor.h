@@ -1,6 +1,9 @@
 #pragma once
 
 #include "ExpressionEvaluator.h"
+#include "Concurrency/Mutex.h"
+
+#include <memory>
 
 namespace DAVA
 {
@@ -17,8 +20,32 @@ public:
     };
     using TextBuffer = std::vector<char>;
 
+private:
+    struct CompiledText;
+
 public:
-    PreProc(FileCallback* fc = nullptr);
+    // Included files and sources split to lines and tokens, may be shared by several PreProc instances.
+    // Compiled texts also keep results of #if/#elif conditions, so conditions which don't depend
+    // on defines of variant are evaluated once for all variants.
+    // Should be cleared when included files are changed.
+    // Sources passed to Process are keyed by whole text, so only MaxCachedSources most recently added ones are kept.
+    class IncludeCache
+    {
+    public:
+        void Clear();
+
+    private:
+        friend class PreProc;
+
+        Mutex mutex;
+        UnorderedMap<String, std::shared_ptr<CompiledText>> file; // by file name
+        UnorderedMap<String, std::shared_ptr<CompiledText>> source; // by original text passed to Process
+        Deque<const String*> sourceOrder; // keys of `source` in order of adding, oldest first
+        String lookupKey;
+    };
+
+public:
+    PreProc(FileCallback* fc = nullptr, IncludeCache* ic = nullptr);
     ~PreProc();
 
     bool ProcessFile(const char* file_name, TextBuffer* output);
@@ -28,64 +55,110 @@ public:
     bool AddDefine(const char* name, const char* value);
 
 private:
-    struct Line
+    struct Directive;
+    struct Line;
+
+    // identifier in text, found same way as GetNextToken finds macro names
+    struct Token
     {
-        uint32 line_n;
-        const char* text;
-        Line(const char* t, uint32 n)
-            : text(t)
-            , line_n(n)
-        {
-        }
+        uint32 offset;
+        uint32 length;
+        uint32 hash;
+    };
+
+    struct VariableValuesHash
+    {
+        size_t operator()(const Vector<uint64>& values) const;
+    };
+
+    // #if/#elif condition or #define value, results are reused for same values of variables it depends on,
+    // at most MaxExpressionResults of them are kept
+    struct Expression
+    {
+        String text;
+        Vector<uint32> variables; // hashes of variables looked up by evaluator, valid when evaluated
+        bool evaluated = false;
+        UnorderedMap<Vector<uint64>, float32, VariableValuesHash> results;
+    };
+
+    struct Define
+    {
+        Define() = default;
+        Define(const char* nm, uint32 nameLength, const char* val, uint32 valueLength);
+
+        String name;
+        Expression value;
+        Vector<Token> valueTokens;
+        uint32 nameHash = 0;
+        uint32 valueHash = 0;
+        float32 number = 0.0f;
+        bool nameValid = false;
+        bool isNumber = false; // plain numbers are set to evaluator without evaluation
+    };
+
+    struct Condition
+    {
+        bool originalCondition;
+        bool effectiveCondition;
+        bool skipLines;
     };
-    using LineVector = std::vector<Line>;
 
-    void Reset();
     char* AllocBuffer(uint32 sz);
-    bool ProcessInplaceInternal(char* src_text, TextBuffer* output);
-    bool ProcessBuffer(char* text, LineVector& line);
-    bool ProcessInclude(const char* file_name, LineVector& line);
-    bool ProcessDefine(const char* name, const char* val);
-    void Undefine(const char* name);
-    void GenerateOutput(TextBuffer* output, LineVector& line);
-
-    char* GetExpression(char* txt, char** end) const;
-    char* GetIdentifier(char* txt, char** end) const;
-    int32 GetNameAndValue(char* txt, char** name, char** value, char** end) const;
+    bool LoadFile(const char* file_name, std::shared_ptr<CompiledText>& text);
+    std::shared_ptr<CompiledText> FindCompiledText(const UnorderedMap<String, std::shared_ptr<CompiledText>>& cache, const char* key);
+    void CacheCompiledText(UnorderedMap<String, std::shared_ptr<CompiledText>>& cache, const char* key, const std::shared_ptr<CompiledText>& text);
+    void CacheSourceText(const char* key, const std::shared_ptr<CompiledText>& text);
+    bool StripComments(char* text, uint32& textLength);
+    std::shared_ptr<CompiledText> Compile(const char* text, uint32 textLength) const;
+    uint32 CompileDirective(CompiledText& text, uint32 line_i, uint32 position) const;
+    bool ProcessInternal(const std::shared_ptr<CompiledText>& text, TextBuffer* output);
+    bool ProcessText(CompiledText& text, TextBuffer& output);
+    bool ProcessInclude(const char* file_name, TextBuffer& output);
+    bool ProcessDefine(Define& define, Mutex* resultsMutex);
+    void Undefine(const String& name, uint32 nameHash);
+    bool Evaluate(Expression& expression, Mutex* resultsMutex, float32* result);
+    void SetSkipLines(Condition& condition, bool skipLines, uint32& skippedConditions) const;
+
+    bool GetIdentifier(const char* txt, String* name, const char** end) const;
+    bool GetNameAndValue(const char* txt, String* name, String* value, const char** end) const;
     void ReportExprEvalError(uint32 line_n);
-    char* ExpandMacroInLine(char* txt);
+    bool ExpandMacros(const char* txt, const char* txtEnd, const Token* tokens, uint32 tokenCount, TextBuffer& output) const;
 
-    char* GetNextToken(char* txt, ptrdiff_t txtSize, ptrdiff_t& tokenSize);
-    const char* GetNextToken(const char* txt, ptrdiff_t txtSize, ptrdiff_t& tokenSize);
+    static void Tokenize(const char* txt, uint32 length, Vector<Token>& tokens);
 
 public:
     enum : uint32
     {
         MaxMacroValueLength = 128,
-        MaxLocalStringLength = 2048,
+        MaxCachedSources = 256,
+        MaxExpressionResults = 64,
     };
 
     struct MacroStringBuffer
     {
         const char* value = nullptr;
         uint32 length = 0;
+        uint32 hash = 0;
 
         MacroStringBuffer() = default;
 
         MacroStringBuffer(const char* nm, uint32 sz)
             : value(nm)
             , length(sz)
+            , hash(DAVA::HashValue_N(nm, sz))
+        {
+        }
+
+        MacroStringBuffer(const char* nm, uint32 sz, uint32 h)
+            : value(nm)
+            , length(sz)
+            , hash(h)
         {
         }
 
         bool operator==(const MacroStringBuffer& r) const
         {
-            bool equals = false;
-            if (length == r.length)
-            {
-                equals = (strncmp(value, r.value, length) == 0);
-            }
-            return equals;
+            return (hash == r.hash) && (length == r.length) && (memcmp(value, r.value, length) == 0);
         }
     };
 
@@ -93,7 +166,7 @@ public:
     {
         uint64 operator()(const MacroStringBuffer& m) const
         {
-            return DAVA::HashValue_N(m.value, m.length);
+            return m.hash;
         }
     };
 
@@ -102,7 +175,8 @@ public:
 private:
     enum : uint32
     {
-        InvalidValue = static_cast<uint32>(-1)
+        InvalidValue = static_cast<uint32>(-1),
+        BufferBlockSize = 16 * 1024
     };
 
     enum : char
@@ -116,9 +190,16 @@ private:
     };
 
     MacroMap macro;
+    List<Define> defines; // added by AddDefine
+    Vector<std::shared_ptr<CompiledText>> texts; // processed texts, macros refer to their names and values
+    Vector<uint64> variableValues;
+    TextBuffer expandedValue;
     Vector<char*> buffer;
+    char* block = nullptr; // last block for small buffers
+    uint32 blockUsed = 0;
     ExpressionEvaluator evaluator;
     FileCallback* fileCB = nullptr;
+    IncludeCache* includeCache = nullptr;
     const char* curFileName = "<buffer>";
 };
-}
\ No newline at end of file
+}
@@ -36,6 +36,16 @@ inline char* SkipWhitespace(char* s)
     return s;
 }
 
+inline const char* SkipWhitespace(const char* s)
+{
+    DVASSERT(s != nullptr);
+
+    while ((*s != 0) && IsSpaceChar(*s))
+        ++s;
+
+    return s;
+}
+
 inline char* SkipCommentBlock(char* s, bool& unterminatedComment)
 {
     DVASSERT(s != nullptr);
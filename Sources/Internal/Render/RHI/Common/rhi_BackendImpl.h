@@ -61,6 +61,7 @@ struct Dispatch
     void* (*impl_Texture_Map)(Handle, unsigned, TextureFace);
     void (*impl_Texture_Unmap)(Handle);
     void (*impl_Texture_Update)(Handle, const void*, uint32, TextureFace);
+    void (*impl_Texture_UpdateRows)(Handle, const void*, uint32, uint32, uint32);
     bool (*impl_Texture_NeedRestore)(Handle);
 
     Handle (*impl_PipelineState_Create)(const PipelineState::Descriptor&);
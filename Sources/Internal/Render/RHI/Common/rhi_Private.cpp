@@ -453,6 +453,11 @@ void Update(Handle tex, const void* data, uint32 level, TextureFace face)
     return (*_Impl.impl_Texture_Update)(tex, data, level, face);
 }
 
+void UpdateRows(Handle tex, const void* data, uint32 level, uint32 firstRow, uint32 rowCount)
+{
+    return (*_Impl.impl_Texture_UpdateRows)(tex, data, level, firstRow, rowCount);
+}
+
 bool NeedRestore(Handle tex)
 {
     return (*_Impl.impl_Texture_NeedRestore)(tex);
@@ -582,6 +582,13 @@ void UpdateTexture(HTexture tex, const void* data, uint32 level, TextureFace fac
 
 //------------------------------------------------------------------------------
 
+void UpdateTextureRows(HTexture tex, const void* data, uint32 level, uint32 firstRow, uint32 rowCount)
+{
+    Texture::UpdateRows(tex, data, level, firstRow, rowCount);
+}
+
+//------------------------------------------------------------------------------
+
 bool NeedRestoreTexture(HTexture tex)
 {
     return Texture::NeedRestore(tex);
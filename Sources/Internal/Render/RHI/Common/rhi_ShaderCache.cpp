@@ -1,17 +1,13 @@
     #include "../rhi_ShaderCache.h"
     #include "../rhi_ShaderSource.h"
 
+#include <unordered_map>
+
 namespace rhi
 {
 static ShaderBuilder _ShaderBuilder = nullptr;
 
-struct ProgInfo
-{
-    DAVA::FastName uid;
-    std::vector<uint8> bin;
-};
-
-static std::vector<ProgInfo> _ProgInfo;
+static std::unordered_map<DAVA::FastName, std::vector<uint8>> _ProgInfo;
 
 namespace ShaderCache
 {
@@ -47,15 +43,8 @@ const std::vector<uint8>& GetProg(const DAVA::FastName& uid)
 {
     static const std::vector<uint8> empty(0);
 
-    for (unsigned i = 0; i != _ProgInfo.size(); ++i)
-    {
-        if (_ProgInfo[i].uid == uid)
-        {
-            return _ProgInfo[i].bin;
-        }
-    }
-
-    return empty;
+    auto prog = _ProgInfo.find(uid);
+    return (prog != _ProgInfo.end()) ? prog->second : empty;
 }
 
 //------------------------------------------------------------------------------
@@ -878,24 +867,8 @@ void UpdateProg(Api targetApi, ProgType progType, const DAVA::FastName& uid, con
 
 void UpdateProgBinary(Api targetApi, ProgType progType, const DAVA::FastName& uid, const void* bin, unsigned binSize)
 {
-    std::vector<uint8>* pbin = nullptr;
-
-    for (unsigned i = 0; i != _ProgInfo.size(); ++i)
-    {
-        if (_ProgInfo[i].uid == uid)
-        {
-            pbin = &(_ProgInfo[i].bin);
-            break;
-        }
-    }
-
-    if (!pbin)
-    {
-        _ProgInfo.push_back(ProgInfo());
-
-        _ProgInfo.back().uid = uid;
-        pbin = &(_ProgInfo.back().bin);
-    }
+    // references to elements of unordered_map stay valid on insertion
+    std::vector<uint8>* pbin = &(_ProgInfo[uid]);
 
     //- DAVA::Logger::Info("\n\n--shader  \"%s\"", uid.c_str());
     //- DAVA::Logger::Info((const char*)bin);
@@ -139,6 +139,7 @@ private:
 };
 
 static ShaderFileCallback ShaderSourceFileCallback("~res:/Materials/Shaders");
+static DAVA::PreProc::IncludeCache ShaderSourceIncludeCache;
 
 //==============================================================================
 
@@ -171,7 +172,7 @@ bool ShaderSource::Construct(ProgType progType, const char* srcText)
 bool ShaderSource::Construct(ProgType progType, const char* srcText, const std::vector<std::string>& defines)
 {
     bool success = false;
-    DAVA::PreProc pre_proc(&ShaderSourceFileCallback);
+    DAVA::PreProc pre_proc(&ShaderSourceFileCallback, &ShaderSourceIncludeCache);
     std::vector<char> src;
 
     DVASSERT(defines.size() % 2 == 0);
@@ -1522,11 +1523,11 @@ ReadS0(DAVA::File* f, std::string* str)
 {
     char s0[128 * 1024];
     uint32 sz = 0;
-    if (ReadUI4(f, &sz))
+    if (ReadUI4(f, &sz) && sz <= sizeof(s0))
     {
         if (f->Read(s0, sz) == sz)
         {
-            *str = s0;
+            str->assign(s0, strnlen(s0, sz));
             return true;
         }
     }
@@ -1904,6 +1905,7 @@ void ShaderSource::AddIncludeDirectory(const char* dir)
 void ShaderSource::PurgeIncludesCache()
 {
     ShaderSourceFileCallback.ClearCache();
+    ShaderSourceIncludeCache.Clear();
 }
 
 //------------------------------------------------------------------------------
@@ -2018,10 +2020,16 @@ void ShaderSource::Dump() const
 //6 is after fixing Add/Update problem
 //7 is after MCPP replaced with in-house pre-processor
 //8 blend-state
-const uint32 ShaderSourceCache::FormatVersion = 8;
+//9 append-only records with size of serialized source
+const uint32 ShaderSourceCache::FormatVersion = 9;
 
 Mutex shaderSourceEntryMutex;
-std::vector<ShaderSourceCache::entry_t> ShaderSourceCache::Entry;
+std::unordered_map<ShaderSourceCache::key_t, ShaderSourceCache::entry_t, ShaderSourceCache::key_hash_t> ShaderSourceCache::Entry;
+DAVA::DynamicMemoryFile* ShaderSourceCache::CacheFile = nullptr;
+std::string ShaderSourceCache::CacheFileName;
+uint32 ShaderSourceCache::RecordCount = 0;
+uint32 ShaderSourceCache::ReplacedRecordCount = 0;
+bool ShaderSourceCache::RewriteRequired = false;
 
 const ShaderSource* ShaderSourceCache::Get(FastName uid, uint32 srcHash)
 {
@@ -2029,20 +2037,32 @@ const ShaderSource* ShaderSourceCache::Get(FastName uid, uint32 srcHash)
 
     //    Logger::Info("get-shader-src (host-api = %i)",HostApi());
     //    Logger::Info("  uid= \"%s\"",uid.c_str());
-    const ShaderSource* src = nullptr;
-    Api api = HostApi();
+    key_t key = { uid, uint32(HostApi()) };
+    std::unordered_map<key_t, entry_t, key_hash_t>::iterator e = Entry.find(key);
+    if (e == Entry.end() || e->second.srcHash != srcHash)
+        return nullptr;
 
-    for (std::vector<entry_t>::const_iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
+    entry_t& entry = e->second;
+    if (entry.src == nullptr)
     {
-        if (e->uid == uid && e->api == api && e->srcHash == srcHash)
+        // source is requested first time since cache file was loaded
+        ShaderSource* src = new ShaderSource();
+        if (CacheFile != nullptr && CacheFile->Seek(entry.dataOffset, DAVA::File::SEEK_FROM_START) && src->Load(Api(key.api), CacheFile))
         {
-            src = e->src;
-            break;
+            entry.src = src;
+        }
+        else
+        {
+            Logger::Warning("ShaderSource-Cache failed to load \"%s\", ignoring cached shader", uid.c_str());
+            delete src;
+            Entry.erase(e);
+            RewriteRequired = true;
+            return nullptr;
         }
     }
     //    Logger::Info("  %s",(src)?"found":"not found");
 
-    return src;
+    return entry.src;
 }
 
 //------------------------------------------------------------------------------
@@ -2054,32 +2074,21 @@ const ShaderSource* ShaderSourceCache::Add(const char* filename, FastName uid, P
     {
         LockGuard<Mutex> guard(shaderSourceEntryMutex);
 
-        uint32 api = HostApi();
+        key_t key = { uid, uint32(HostApi()) };
         uint32 srcHash = DAVA::HashValue_N(srcText, unsigned(strlen(srcText)));
 
-        bool doAdd = true;
-        for (std::vector<entry_t>::iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
+        entry_t& entry = Entry[key];
+        if (entry.saved)
         {
-            if ((e->uid == uid) && (e->api == api))
-            {
-                DAVA::SafeDelete(e->src);
-                e->src = src;
-                e->srcHash = srcHash;
-                doAdd = false;
-                break;
-            }
-        }
-
-        if (doAdd)
-        {
-            entry_t e;
-            e.uid = uid;
-            e.api = api;
-            e.srcHash = srcHash;
-            e.src = src;
-
-            Entry.push_back(e);
+            // record in cache file becomes outdated, new one will be appended on Save
+            ++ReplacedRecordCount;
         }
+        DAVA::SafeDelete(entry.src);
+        entry.src = src;
+        entry.srcHash = srcHash;
+        entry.dataOffset = 0;
+        entry.dataSize = 0;
+        entry.saved = false;
     }
     else
     {
@@ -2096,9 +2105,40 @@ void ShaderSourceCache::Clear()
 {
     LockGuard<Mutex> guard(shaderSourceEntryMutex);
 
-    for (std::vector<entry_t>::const_iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
-        delete e->src;
+    for (std::unordered_map<key_t, entry_t, key_hash_t>::const_iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
+        delete e->second.src;
     Entry.clear();
+
+    DAVA::SafeRelease(CacheFile);
+    CacheFileName.clear();
+    RecordCount = 0;
+    ReplacedRecordCount = 0;
+    RewriteRequired = false;
+}
+
+//------------------------------------------------------------------------------
+
+bool ShaderSourceCache::WriteRecord(DAVA::File* file, const key_t& key, const entry_t& entry)
+{
+    using namespace DAVA;
+
+    if (!WriteS0(file, key.uid.c_str()) || !WriteUI4(file, key.api) || !WriteUI4(file, entry.srcHash))
+        return false;
+
+    if (entry.src == nullptr)
+    {
+        // source wasn't requested since Load, its serialized data is copied as is
+        DVASSERT(CacheFile != nullptr);
+        return WriteUI4(file, entry.dataSize) && (file->Write(CacheFile->GetData() + entry.dataOffset, entry.dataSize) == entry.dataSize);
+    }
+
+    ScopedPtr<DynamicMemoryFile> data(DynamicMemoryFile::Create(File::CREATE | File::WRITE));
+    if (!entry.src->Save(Api(key.api), data))
+        return false;
+
+    const Vector<uint8>& bytes = data->GetDataVector();
+    const uint32 dataSize = static_cast<uint32>(bytes.size());
+    return WriteUI4(file, dataSize) && (file->Write(bytes.data(), dataSize) == dataSize);
 }
 
 //------------------------------------------------------------------------------
@@ -2107,14 +2147,63 @@ void ShaderSourceCache::Save(const char* fileName)
 {
     using namespace DAVA;
 
+    LockGuard<Mutex> guard(shaderSourceEntryMutex);
+
+    // File is rewritten if it's not the loaded one or if most of its records are outdated
+    bool appendToFile = !RewriteRequired && (CacheFileName == fileName) && (ReplacedRecordCount * 2 <= RecordCount) && FileSystem::Instance()->Exists(fileName);
+    if (!appendToFile)
+    {
+        Rewrite(fileName);
+        return;
+    }
+
+    uint32 newEntryCount = 0;
+    for (std::unordered_map<key_t, entry_t, key_hash_t>::const_iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
+    {
+        if (!e->second.saved)
+            ++newEntryCount;
+    }
+
+    if (newEntryCount == 0)
+        return;
+
+    ScopedPtr<File> file(File::Create(fileName, File::APPEND | File::WRITE));
+    if (file)
+    {
+        Logger::Info("appending cached-shaders (%u of %u): ", newEntryCount, uint32(Entry.size()));
+
+        for (std::unordered_map<key_t, entry_t, key_hash_t>::iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
+        {
+            if (e->second.saved)
+                continue;
+
+            if (!WriteRecord(file, e->first, e->second))
+            {
+                // file may end with incomplete record now
+                Logger::Warning("ShaderSource-Cache failed to append shaders, cache will be rewritten\n");
+                RewriteRequired = true;
+                return;
+            }
+
+            e->second.saved = true;
+            ++RecordCount;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+
+void ShaderSourceCache::Rewrite(const char* fileName)
+{
+    using namespace DAVA;
+
     static const FilePath cacheTempFile("~doc:/shader_source_cache_temp.bin");
 
     File* file = File::Create(cacheTempFile, File::WRITE | File::CREATE);
     if (file)
     {
-        Logger::Info("saving cached-shaders (%u): ", Entry.size());
+        Logger::Info("saving cached-shaders (%u): ", uint32(Entry.size()));
 
-        LockGuard<Mutex> guard(shaderSourceEntryMutex);
         bool success = true;
 
         SCOPE_EXIT
@@ -2124,6 +2213,14 @@ void ShaderSourceCache::Save(const char* fileName)
             if (success)
             {
                 FileSystem::Instance()->MoveFile(cacheTempFile, fileName, true);
+
+                for (std::unordered_map<key_t, entry_t, key_hash_t>::iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
+                    e->second.saved = true;
+
+                CacheFileName = fileName;
+                RecordCount = static_cast<uint32>(Entry.size());
+                ReplacedRecordCount = 0;
+                RewriteRequired = false;
             }
             else
             {
@@ -2134,13 +2231,9 @@ void ShaderSourceCache::Save(const char* fileName)
 #define WRITE_CHECK(exp) if (!exp) { success = false; return; }
 
         WRITE_CHECK(WriteUI4(file, FormatVersion));
-        WRITE_CHECK(WriteUI4(file, static_cast<uint32>(Entry.size())));
-        for (std::vector<entry_t>::const_iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
+        for (std::unordered_map<key_t, entry_t, key_hash_t>::const_iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
         {
-            WRITE_CHECK(WriteS0(file, e->uid.c_str()));
-            WRITE_CHECK(WriteUI4(file, e->api));
-            WRITE_CHECK(WriteUI4(file, e->srcHash));
-            WRITE_CHECK(e->src->Save(Api(e->api), file));
+            WRITE_CHECK(WriteRecord(file, e->first, e->second));
         }
         
 #undef WRITE_CHECK
@@ -2171,29 +2264,51 @@ void ShaderSourceCache::Load(const char* fileName)
         
 #define READ_CHECK(exp) if (!exp) { success = false; return; }
 
+        // Whole file is kept in memory, sources are deserialized from it on first request
+        Vector<uint8> data(static_cast<size_t>(file->GetSize()));
+        READ_CHECK((file->Read(data.data(), static_cast<uint32>(data.size())) == data.size()));
+
+        LockGuard<Mutex> guard(shaderSourceEntryMutex);
+
+        CacheFile = DynamicMemoryFile::Create(std::move(data), File::OPEN | File::READ, FilePath(fileName));
+
         uint32 formatVersion = 0;
-        READ_CHECK(ReadUI4(file, &formatVersion));
+        READ_CHECK(ReadUI4(CacheFile, &formatVersion));
 
         if (formatVersion == FormatVersion)
         {
-            LockGuard<Mutex> guard(shaderSourceEntryMutex);
+            const uint64 fileSize = CacheFile->GetSize();
+            while (CacheFile->GetPos() < fileSize)
+            {
+                std::string uid;
+                key_t key;
+                uint32 srcHash = 0;
+                uint32 dataSize = 0;
+                if (!ReadS0(CacheFile, &uid) || !ReadUI4(CacheFile, &key.api) || !ReadUI4(CacheFile, &srcHash) || !ReadUI4(CacheFile, &dataSize) || (CacheFile->GetPos() + dataSize > fileSize))
+                {
+                    // last append wasn't completed, records before it are valid
+                    Logger::Warning("ShaderSource-Cache has incomplete record, it will be rewritten\n");
+                    RewriteRequired = true;
+                    break;
+                }
+                key.uid = FastName(uid.c_str());
 
-            uint32 entryCount = 0;
-            READ_CHECK(ReadUI4(file, &entryCount));
-            Entry.resize(entryCount);
-            Logger::Info("loading cached-shaders (%u): ", Entry.size());
+                entry_t& entry = Entry[key];
+                if (entry.saved)
+                {
+                    ++ReplacedRecordCount;
+                }
+                entry.srcHash = srcHash;
+                entry.dataOffset = static_cast<uint32>(CacheFile->GetPos());
+                entry.dataSize = dataSize;
+                entry.saved = true;
+                ++RecordCount;
 
-            for (std::vector<entry_t>::iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
-            {
-                std::string str;
-                READ_CHECK(ReadS0(file, &str));
-                e->uid = FastName(str.c_str());
-                READ_CHECK(ReadUI4(file, &e->api));
-                READ_CHECK(ReadUI4(file, &e->srcHash));
-                e->src = new ShaderSource();
-
-                READ_CHECK(e->src->Load(Api(e->api), file));
+                READ_CHECK(CacheFile->Seek(dataSize, File::SEEK_FROM_CURRENT));
             }
+
+            CacheFileName = fileName;
+            Logger::Info("loading cached-shaders (%u): ", uint32(Entry.size()));
         }
         else
         {
@@ -5,6 +5,8 @@
 #include "Logger/Logger.h"
 #include "FileSystem/File.h"
 #include "rhi_Utils.h"
+#include "Concurrency/LockGuard.h"
+#include "Concurrency/Mutex.h"
 #include <atomic>
 
 using DAVA::uint32;
@@ -244,6 +246,7 @@ VertexLayout& VertexLayout::operator=(const VertexLayout& src)
 static const uint32 UniqueVertexLayoutCapacity = 1024;
 static std::atomic<uint32> UniqueVertexLayoutLastIdentifier(0);
 static VertexLayout UniqueVertexLayout[UniqueVertexLayoutCapacity] = {};
+static DAVA::Mutex UniqueVertexLayoutSync;
 
 //------------------------------------------------------------------------------
 
@@ -265,15 +268,26 @@ const VertexLayout* VertexLayout::Get(uint32 uid)
 
 uint32 VertexLayout::UniqueId(const VertexLayout& layout)
 {
-    for (uint32 i = 1, e = UniqueVertexLayoutLastIdentifier; i <= e; ++i)
+    // Layouts are never changed once published, so registered ones are found without lock
+    uint32 lastId = UniqueVertexLayoutLastIdentifier.load(std::memory_order_acquire);
+    for (uint32 i = 1; i <= lastId; ++i)
     {
         if (UniqueVertexLayout[i] == layout)
             return i;
     }
 
-    uint32 uid = ++UniqueVertexLayoutLastIdentifier;
+    // Polygon groups are loaded on worker threads, so new layouts may be added concurrently
+    DAVA::LockGuard<DAVA::Mutex> lock(UniqueVertexLayoutSync);
+    for (uint32 i = lastId + 1, e = UniqueVertexLayoutLastIdentifier.load(std::memory_order_relaxed); i <= e; ++i)
+    {
+        if (UniqueVertexLayout[i] == layout)
+            return i;
+    }
+
+    uint32 uid = UniqueVertexLayoutLastIdentifier.load(std::memory_order_relaxed) + 1;
     DVASSERT(uid < UniqueVertexLayoutCapacity);
     UniqueVertexLayout[uid] = layout;
+    UniqueVertexLayoutLastIdentifier.store(uid, std::memory_order_release);
     return uid;
 }
 
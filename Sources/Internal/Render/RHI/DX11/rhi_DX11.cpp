@@ -57,6 +57,7 @@ DX11Resources dx11;
 void dx11_InitCaps()
 {
     MutableDeviceCaps::Get().is32BitIndicesSupported = true;
+    MutableDeviceCaps::Get().isHalfFloatVertexSupported = true;
     MutableDeviceCaps::Get().isFramebufferFetchSupported = true;
     MutableDeviceCaps::Get().isVertexTextureUnitsSupported = (dx11.usedFeatureLevel >= D3D_FEATURE_LEVEL_10_0);
     MutableDeviceCaps::Get().isUpperLeftRTOrigin = true;
@@ -148,6 +148,18 @@ ID3D11InputLayout* PipelineStateDX11_t::CreateInputLayout(const VertexLayout& la
             }
         }
         break;
+        case VDT_HALF:
+        {
+            DVASSERT(layout.ElementDataCount(i) == 2 || layout.ElementDataCount(i) == 4);
+            elem[elemCount].Format = (layout.ElementDataCount(i) == 4) ? DXGI_FORMAT_R16G16B16A16_FLOAT : DXGI_FORMAT_R16G16_FLOAT;
+        }
+        break;
+        case VDT_INT16N:
+        {
+            DVASSERT(layout.ElementDataCount(i) == 2 || layout.ElementDataCount(i) == 4);
+            elem[elemCount].Format = (layout.ElementDataCount(i) == 4) ? DXGI_FORMAT_R16G16B16A16_SNORM : DXGI_FORMAT_R16G16_SNORM;
+        }
+        break;
         default:
             break;
         }
@@ -279,6 +291,18 @@ ID3D11InputLayout* PipelineStateDX11_t::CreateCompatibleInputLayout(const Vertex
                 }
             }
             break;
+            case VDT_HALF:
+            {
+                DVASSERT(vbLayout.ElementDataCount(vb_elem_i) == 2 || vbLayout.ElementDataCount(vb_elem_i) == 4);
+                elem[elemCount].Format = (vbLayout.ElementDataCount(vb_elem_i) == 4) ? DXGI_FORMAT_R16G16B16A16_FLOAT : DXGI_FORMAT_R16G16_FLOAT;
+            }
+            break;
+            case VDT_INT16N:
+            {
+                DVASSERT(vbLayout.ElementDataCount(vb_elem_i) == 2 || vbLayout.ElementDataCount(vb_elem_i) == 4);
+                elem[elemCount].Format = (vbLayout.ElementDataCount(vb_elem_i) == 4) ? DXGI_FORMAT_R16G16B16A16_SNORM : DXGI_FORMAT_R16G16_SNORM;
+            }
+            break;
             default:
                 break;
             }
@@ -430,6 +430,38 @@ void dx11_Texture_Update(Handle tex, const void* data, uint32 level, TextureFace
     dx11_Texture_Unmap(tex);
 }
 
+void dx11_Texture_UpdateRows(Handle tex, const void* data, uint32 level, uint32 firstRow, uint32 rowCount)
+{
+    TextureDX11_t* self = TextureDX11Pool::Get(tex);
+    TextureFormat fmt = self->descriptor.format;
+    Size2i sz = TextureExtents(Size2i(self->descriptor.width, self->descriptor.height), level);
+    uint32 stride = TextureStride(fmt, Size2i(self->descriptor.width, self->descriptor.height), level);
+    uint32 dataSize = stride * rowCount;
+
+    DVASSERT(!self->isMapped);
+    DVASSERT(self->arraySize == 1);
+    DVASSERT(firstRow + rowCount <= uint32(sz.dy));
+
+    void* swapped = nullptr;
+    if (fmt == TEXTURE_FORMAT_R8G8B8A8 || fmt == TEXTURE_FORMAT_R4G4B4A4 || fmt == TEXTURE_FORMAT_R5G5B5A1)
+    {
+        swapped = ::malloc(dataSize);
+        if (fmt == TEXTURE_FORMAT_R8G8B8A8)
+            _SwapRB8(const_cast<void*>(data), swapped, dataSize);
+        else if (fmt == TEXTURE_FORMAT_R4G4B4A4)
+            _SwapRB4(const_cast<void*>(data), swapped, dataSize);
+        else
+            _SwapRB5551(const_cast<void*>(data), swapped, dataSize);
+        data = swapped;
+    }
+
+    D3D11_BOX box = { 0, firstRow, 0, uint32(sz.dx), firstRow + rowCount, 1 };
+    DX11Command cmd(DX11Command::UPDATE_SUBRESOURCE, self->tex2d, level, &box, data, stride, 0);
+    ExecDX11(&cmd, 1);
+
+    ::free(swapped);
+}
+
 bool dx11_Texture_NeedRestore(Handle tex)
 {
     return false;
@@ -449,6 +481,7 @@ void SetupDispatch(Dispatch* dispatch)
     dispatch->impl_Texture_Map = &dx11_Texture_Map;
     dispatch->impl_Texture_Unmap = &dx11_Texture_Unmap;
     dispatch->impl_Texture_Update = &dx11_Texture_Update;
+    dispatch->impl_Texture_UpdateRows = &dx11_Texture_UpdateRows;
     dispatch->impl_Texture_NeedRestore = &dx11_Texture_NeedRestore;
 }
 
@@ -1433,6 +1433,54 @@ static void _DX9_ExecImmediateCommand(CommonImpl::ImmediateCommand* command)
         }
         break;
 
+        case DX9Command::UPDATE_TEXTURE_ROWS:
+        {
+            IDirect3DTexture9* tex = *((IDirect3DTexture9**)(arg[0]));
+
+            if (tex)
+            {
+                UINT lev = UINT(arg[1]);
+                uint8* src = (uint8*)(arg[2]);
+                LONG firstRow = LONG(arg[3]);
+                LONG rowCount = LONG(arg[4]);
+                unsigned stride = unsigned(arg[5]);
+                rhi::TextureFormat format = static_cast<rhi::TextureFormat>(arg[6]);
+                D3DSURFACE_DESC desc = {};
+                tex->GetLevelDesc(lev, &desc);
+                RECT rect = { 0, firstRow, LONG(desc.Width), firstRow + rowCount };
+                D3DLOCKED_RECT rc = {};
+                HRESULT hr = tex->LockRect(lev, &rc, &rect, 0);
+
+                if (SUCCEEDED(hr))
+                {
+                    uint8* dst = static_cast<uint8*>(rc.pBits);
+                    for (LONG r = 0; r != rowCount; ++r, src += stride, dst += rc.Pitch)
+                    {
+                        if (format == TEXTURE_FORMAT_R8G8B8A8)
+                            _SwapRB8(src, dst, stride);
+                        else if (format == TEXTURE_FORMAT_R4G4B4A4)
+                            _SwapRB4(src, dst, stride);
+                        else if (format == TEXTURE_FORMAT_R5G5B5A1)
+                            _SwapRB5551(src, dst, stride);
+                        else
+                            memcpy(dst, src, stride);
+                    }
+
+                    cmd->retval = tex->UnlockRect(lev);
+                }
+                else
+                {
+                    CHECK_HR(hr);
+                    cmd->retval = hr;
+                }
+            }
+            else
+            {
+                cmd->retval = E_FAIL;
+            }
+        }
+        break;
+
         case DX9Command::READ_TEXTURE_LEVEL:
         {
             IDirect3DTexture9* tex = *((IDirect3DTexture9**)(arg[0]));
@@ -247,6 +247,7 @@ void dx9_InitCaps(const AdapterInfo& adapterInfo)
     }
 
     MutableDeviceCaps::Get().is32BitIndicesSupported = true;
+    MutableDeviceCaps::Get().isHalfFloatVertexSupported = (caps.DeclTypes & D3DDTCAPS_FLOAT16_2) && (caps.DeclTypes & D3DDTCAPS_FLOAT16_4);
     MutableDeviceCaps::Get().isFramebufferFetchSupported = true;
     MutableDeviceCaps::Get().isVertexTextureUnitsSupported = (D3DSHADER_VERSION_MAJOR(caps.VertexShaderVersion) >= 3);
     MutableDeviceCaps::Get().isInstancingSupported = true;
@@ -170,6 +170,18 @@ IDirect3DVertexDeclaration9* VDeclDX9::Get(const VertexLayout& layout, bool forc
                 }
             }
             break;
+            case VDT_HALF:
+            {
+                DVASSERT(layout.ElementDataCount(i) == 2 || layout.ElementDataCount(i) == 4);
+                elem[elemCount].Type = (layout.ElementDataCount(i) == 4) ? D3DDECLTYPE_FLOAT16_4 : D3DDECLTYPE_FLOAT16_2;
+            }
+            break;
+            case VDT_INT16N:
+            {
+                DVASSERT(layout.ElementDataCount(i) == 2 || layout.ElementDataCount(i) == 4);
+                elem[elemCount].Type = (layout.ElementDataCount(i) == 4) ? D3DDECLTYPE_SHORT4N : D3DDECLTYPE_SHORT2N;
+            }
+            break;
             default:
                 break;
             }
@@ -442,6 +442,28 @@ dx9_Texture_Unmap(Handle tex)
 
 //------------------------------------------------------------------------------
 
+static void
+dx9_Texture_UpdateRows(Handle tex, const void* data, uint32 level, uint32 firstRow, uint32 rowCount)
+{
+    TextureDX9_t* self = TextureDX9Pool::Get(tex);
+    Size2i sz = Size2i(self->CreationDesc().width, self->CreationDesc().height);
+    uint32 stride = TextureStride(self->CreationDesc().format, sz, level);
+
+    DVASSERT(self->cubetex9 == nullptr);
+    DVASSERT(firstRow + rowCount <= uint32(TextureExtents(sz, level).dy));
+
+    IDirect3DTexture9** tex9 = (self->CreationDesc().isRenderTarget) ? &self->rt_tex9 : &self->tex9;
+    DX9Command cmd = { DX9Command::UPDATE_TEXTURE_ROWS, { uint64_t(tex9), level, uint64(data), firstRow, rowCount, stride, static_cast<uint64>(self->CreationDesc().format) } };
+    ExecDX9(&cmd, 1, false);
+
+    if (cmd.retval)
+    {
+        Logger::Error("Failed to update texture rows (0x%08X) : %s", cmd.retval, D3D9ErrorText(cmd.retval));
+    }
+}
+
+//------------------------------------------------------------------------------
+
 #define DX9_UPDATE_TEXTURE_USING_MAP 0
 
 static void
@@ -509,6 +531,7 @@ void SetupDispatch(Dispatch* dispatch)
     dispatch->impl_Texture_Map = &dx9_Texture_Map;
     dispatch->impl_Texture_Unmap = &dx9_Texture_Unmap;
     dispatch->impl_Texture_Update = &dx9_Texture_Update;
+    dispatch->impl_Texture_UpdateRows = &dx9_Texture_UpdateRows;
     dispatch->impl_Texture_NeedRestore = &dx9_Texture_NeedRestore;
 }
 
@@ -178,6 +178,7 @@ static void gles_check_GL_extensions()
         RG_Supported = strstr(ext, "EXT_texture_rg") != nullptr || strstr(ext, "ARB_texture_rg") != nullptr;
 
         MutableDeviceCaps::Get().is32BitIndicesSupported = strstr(ext, "GL_OES_element_index_uint") != nullptr;
+        MutableDeviceCaps::Get().isHalfFloatVertexSupported = strstr(ext, "GL_OES_vertex_half_float") != nullptr;
         MutableDeviceCaps::Get().isVertexTextureUnitsSupported = strstr(ext, "GL_EXT_shader_texture_lod") != nullptr;
         MutableDeviceCaps::Get().isFramebufferFetchSupported = strstr(ext, "GL_EXT_shader_framebuffer_fetch") != nullptr;
         MutableDeviceCaps::Get().isInstancingSupported =
@@ -256,6 +257,7 @@ static void gles_check_GL_extensions()
         else
         {
             MutableDeviceCaps::Get().is32BitIndicesSupported = true;
+            MutableDeviceCaps::Get().isHalfFloatVertexSupported = (majorVersion >= 3);
             MutableDeviceCaps::Get().isVertexTextureUnitsSupported = true;
             MutableDeviceCaps::Get().isFramebufferFetchSupported = false;
             MutableDeviceCaps::Get().isInstancingSupported |= (majorVersion > 3) && (minorVersion > 3);
@@ -70,13 +70,18 @@ VertexDeclGLES2
                 elem[elemCount].normalized = GL_FALSE;
             }
             break;
-            /*
-                                case VDT_HALF :
-                                {
-                                    elem[elemCount].type       = GL_HALF_FLOAT;
-                                    elem[elemCount].normalized = GL_FALSE;
-                                }   break;
-*/
+
+            case VDT_HALF:
+            {
+#if defined(__DAVAENGINE_IPHONE__) || defined(__DAVAENGINE_ANDROID__)
+                elem[elemCount].type = GL_HALF_FLOAT_OES; // half-float attributes are used only with GL_OES_vertex_half_float
+#else
+                elem[elemCount].type = GL_HALF_FLOAT;
+#endif
+                elem[elemCount].normalized = GL_FALSE;
+            }
+            break;
+
             case VDT_INT16N:
             {
                 elem[elemCount].type = GL_SHORT;
@@ -660,6 +660,37 @@ void gles2_Texture_Update(Handle tex, const void* data, uint32 level, TextureFac
 
 //------------------------------------------------------------------------------
 
+void gles2_Texture_UpdateRows(Handle tex, const void* data, uint32 level, uint32 firstRow, uint32 rowCount)
+{
+    TextureGLES2_t* self = TextureGLES2Pool::Get(tex);
+    Size2i sz = TextureExtents(Size2i(self->width, self->height), level);
+    GLint int_fmt;
+    GLint fmt;
+    GLenum type;
+    bool compressed;
+
+    DVASSERT(!self->isRenderBuffer);
+    DVASSERT(!self->isMapped);
+    DVASSERT(!self->isCubeMap);
+    DVASSERT(firstRow + rowCount <= uint32(sz.dy));
+
+    GetGLTextureFormat(self->format, &int_fmt, &fmt, &type, &compressed);
+    DVASSERT(!compressed);
+    DVASSERT(self->format != TEXTURE_FORMAT_R4G4B4A4 && self->format != TEXTURE_FORMAT_R5G5B5A1);
+
+    GLCommand cmd[] =
+    {
+      { GLCommand::SET_ACTIVE_TEXTURE, { GL_TEXTURE0 + 0 } },
+      { GLCommand::BIND_TEXTURE, { GL_TEXTURE_2D, uint64(&(self->uid)) } },
+      { GLCommand::TEX_SUBIMAGE2D, { GL_TEXTURE_2D, uint64(level), 0, uint64(firstRow), uint64(sz.dx), uint64(rowCount), uint64(fmt), type, reinterpret_cast<uint64>(data) } },
+      { GLCommand::RESTORE_TEXTURE0, {} }
+    };
+
+    ExecGL(cmd, countof(cmd));
+}
+
+//------------------------------------------------------------------------------
+
 bool gles2_Texture_NeedRestore(Handle tex)
 {
     TextureGLES2_t* self = TextureGLES2Pool::Get(tex);
@@ -821,6 +852,7 @@ void SetupDispatch(Dispatch* dispatch)
     dispatch->impl_Texture_Map = &gles2_Texture_Map;
     dispatch->impl_Texture_Unmap = &gles2_Texture_Unmap;
     dispatch->impl_Texture_Update = &gles2_Texture_Update;
+    dispatch->impl_Texture_UpdateRows = &gles2_Texture_UpdateRows;
     dispatch->impl_Texture_NeedRestore = &gles2_Texture_NeedRestore;
 }
 
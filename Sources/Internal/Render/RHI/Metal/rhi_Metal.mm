@@ -279,6 +279,7 @@ void metal_Initialize(const InitParam& param)
         CommandBufferMetal::Init(param.maxCommandBuffer);
 
     MutableDeviceCaps::Get().is32BitIndicesSupported = true;
+    MutableDeviceCaps::Get().isHalfFloatVertexSupported = true;
     MutableDeviceCaps::Get().isFramebufferFetchSupported = true;
     MutableDeviceCaps::Get().isVertexTextureUnitsSupported = true;
     MutableDeviceCaps::Get().isZeroBaseClipRange = true;
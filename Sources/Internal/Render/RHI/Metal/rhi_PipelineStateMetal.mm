@@ -794,6 +794,34 @@ metal_PipelineState_Create(const PipelineState::Descriptor& desc)
             }
             break;
 
+            case VDT_HALF:
+            {
+                switch (desc.vertexLayout.ElementDataCount(i))
+                {
+                case 2:
+                    fmt = MTLVertexFormatHalf2;
+                    break;
+                case 4:
+                    fmt = MTLVertexFormatHalf4;
+                    break;
+                }
+            }
+            break;
+
+            case VDT_INT16N:
+            {
+                switch (desc.vertexLayout.ElementDataCount(i))
+                {
+                case 2:
+                    fmt = MTLVertexFormatShort2Normalized;
+                    break;
+                case 4:
+                    fmt = MTLVertexFormatShort4Normalized;
+                    break;
+                }
+            }
+            break;
+
             default:
                 break;
             }
@@ -1022,11 +1050,16 @@ uint32 SetToRHI(Handle ps, uint32 layoutUID, const MTLPixelFormat* color_fmt, un
                     {
                         MTLVertexFormat fmt = MTLVertexFormatInvalid;
 
-                        switch (psm->layout.ElementDataType(i))
+                        // packed streams are fetched in vertex buffer format, shader gets them as floats
+                        bool packed = (layout->ElementDataType(j) == VDT_INT16N) || (layout->ElementDataType(j) == VDT_HALF);
+                        VertexDataType dataType = packed ? layout->ElementDataType(j) : psm->layout.ElementDataType(i);
+                        uint32 dataCount = packed ? layout->ElementDataCount(j) : psm->layout.ElementDataCount(i);
+
+                        switch (dataType)
                         {
                         case VDT_FLOAT:
                         {
-                            switch (psm->layout.ElementDataCount(i))
+                            switch (dataCount)
                             {
                             case 1:
                                 fmt = MTLVertexFormatFloat;
@@ -1046,7 +1079,7 @@ uint32 SetToRHI(Handle ps, uint32 layoutUID, const MTLPixelFormat* color_fmt, un
 
                         case VDT_HALF:
                         {
-                            switch (psm->layout.ElementDataCount(i))
+                            switch (dataCount)
                             {
                             case 1:
                                 //                                fmt = MTLVertexFormatHalf;
@@ -1067,7 +1100,7 @@ uint32 SetToRHI(Handle ps, uint32 layoutUID, const MTLPixelFormat* color_fmt, un
                         case VDT_UINT8:
                         case VDT_UINT8N:
                         {
-                            switch (psm->layout.ElementDataCount(i))
+                            switch (dataCount)
                             {
                             //                                    case 1 : fmt = MTLVertexFormatUCharNormalized; break;
                             case 2:
@@ -1083,6 +1116,20 @@ uint32 SetToRHI(Handle ps, uint32 layoutUID, const MTLPixelFormat* color_fmt, un
                         }
                         break;
 
+                        case VDT_INT16N:
+                        {
+                            switch (dataCount)
+                            {
+                            case 2:
+                                fmt = MTLVertexFormatShort2Normalized;
+                                break;
+                            case 4:
+                                fmt = MTLVertexFormatShort4Normalized;
+                                break;
+                            }
+                        }
+                        break;
+
                         default:
                             break;
                         }
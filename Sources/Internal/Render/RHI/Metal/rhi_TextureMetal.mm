@@ -623,6 +623,22 @@ void metal_Texture_Update(Handle tex, const void* data, uint32 level, TextureFac
 
 //------------------------------------------------------------------------------
 
+void metal_Texture_UpdateRows(Handle tex, const void* data, uint32 level, uint32 firstRow, uint32 rowCount)
+{
+    TextureMetal_t* self = TextureMetalPool::Get(tex);
+    Size2i ext = TextureExtents(Size2i(self->width, self->height), level);
+    uint32 stride = TextureStride(self->format, Size2i(self->width, self->height), level);
+
+    DVASSERT(!self->is_cubemap);
+    DVASSERT(self->format != TEXTURE_FORMAT_R4G4B4A4 && self->format != TEXTURE_FORMAT_R5G5B5A1);
+    DVASSERT(firstRow + rowCount <= uint32(ext.dy));
+
+    MTLRegion rgn = MTLRegionMake2D(0, firstRow, ext.dx, rowCount);
+    [self->uid replaceRegion:rgn mipmapLevel:level withBytes:data bytesPerRow:stride];
+}
+
+//------------------------------------------------------------------------------
+
 static bool
 metal_Texture_NeedRestore(Handle tex)
 {
@@ -647,6 +663,7 @@ void SetupDispatch(Dispatch* dispatch)
     dispatch->impl_Texture_Map = &metal_Texture_Map;
     dispatch->impl_Texture_Unmap = &metal_Texture_Unmap;
     dispatch->impl_Texture_Update = &metal_Texture_Update;
+    dispatch->impl_Texture_UpdateRows = &metal_Texture_UpdateRows;
     dispatch->impl_Texture_NeedRestore = &metal_Texture_NeedRestore;
 }
 
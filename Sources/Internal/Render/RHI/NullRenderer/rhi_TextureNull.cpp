@@ -59,6 +59,10 @@ void null_Texture_Update(Handle, const void*, uint32, TextureFace)
 {
 }
 
+void null_Texture_UpdateRows(Handle, const void*, uint32, uint32, uint32)
+{
+}
+
 bool null_Texture_NeedRestore(Handle)
 {
     return false;
@@ -80,6 +84,7 @@ void SetupDispatch(Dispatch* dispatch)
     dispatch->impl_Texture_Map = null_Texture_Map;
     dispatch->impl_Texture_Unmap = null_Texture_Unmap;
     dispatch->impl_Texture_Update = null_Texture_Update;
+    dispatch->impl_Texture_UpdateRows = null_Texture_UpdateRows;
     dispatch->impl_Texture_NeedRestore = null_Texture_NeedRestore;
 }
 }
@@ -76,6 +76,7 @@ struct RenderDeviceCaps
     char deviceDescription[128];
 
     bool is32BitIndicesSupported = false;
+    bool isHalfFloatVertexSupported = false;
     bool isVertexTextureUnitsSupported = false;
     bool isFramebufferFetchSupported = false;
     bool isUpperLeftRTOrigin = false;
@@ -251,6 +252,9 @@ void* MapTexture(HTexture tex, uint32 level = 0);
 void UnmapTexture(HTexture tex);
 
 void UpdateTexture(HTexture tex, const void* data, uint32 level, TextureFace face = TEXTURE_FACE_NONE);
+// Uploads full-width rows [firstRow, firstRow + rowCount) of a 2D uncompressed texture,
+// `data` points to the first of these rows.
+void UpdateTextureRows(HTexture tex, const void* data, uint32 level, uint32 firstRow, uint32 rowCount);
 
 bool NeedRestoreTexture(HTexture tex);
 
@@ -5,9 +5,12 @@
 #include "Base/BaseTypes.h"    
 #include "Base/FastName.h"
 
+#include <unordered_map>
+
 namespace DAVA
 {
 class File;
+class DynamicMemoryFile;
 }
 
 namespace sl
@@ -116,6 +119,13 @@ private:
     BlendState blending;
 };
 
+/*
+    Cache file is a header followed by records (uid, api, srcHash, size, serialized ShaderSource).
+    Records are only appended to file, record loaded later replaces earlier one with the same uid and api.
+    On Load file is kept in memory and sources are deserialized on first Get.
+    Save appends records added since last Load/Save, whole file is rewritten only
+    when it is another file or when it has too many replaced records.
+*/
 class
 ShaderSourceCache
 {
@@ -129,15 +139,45 @@ public:
 
 private:
     struct
-    entry_t
+    key_t
     {
         FastName uid;
         uint32 api;
+
+        bool operator==(const key_t& other) const
+        {
+            return uid == other.uid && api == other.api;
+        }
+    };
+
+    struct
+    key_hash_t
+    {
+        size_t operator()(const key_t& key) const
+        {
+            return std::hash<FastName>()(key.uid) ^ (size_t(key.api) * 0x9e3779b9);
+        }
+    };
+
+    struct
+    entry_t
+    {
         uint32 srcHash;
         ShaderSource* src = nullptr;
+        uint32 dataOffset = 0; // serialized source in cache file, used until `src` is loaded
+        uint32 dataSize = 0;
+        bool saved = false; // record of entry is written to cache file
     };
 
-    static std::vector<entry_t> Entry;
+    static bool WriteRecord(DAVA::File* file, const key_t& key, const entry_t& entry);
+    static void Rewrite(const char* fileName);
+
+    static std::unordered_map<key_t, entry_t, key_hash_t> Entry;
+    static DAVA::DynamicMemoryFile* CacheFile; // contents of loaded cache file
+    static std::string CacheFileName;
+    static uint32 RecordCount; // records in cache file, including replaced ones
+    static uint32 ReplacedRecordCount;
+    static bool RewriteRequired;
     static const uint32 FormatVersion;
 };
 
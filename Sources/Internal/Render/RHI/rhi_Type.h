@@ -257,7 +257,7 @@ public:
 private:
     enum
     {
-        MaxElemCount = 8,
+        MaxElemCount = 16,
         MaxStreamCount = 2
     };
 
@@ -13,6 +13,7 @@ FastName optionsNames[RenderOptions::OPTIONS_COUNT] =
   FastName("Draw Sprites"),
   FastName("Draw Shadow Volumes"),
   FastName("Draw Vegetation"),
+  FastName("Automatic Instancing"),
 
   FastName("Enable Fog"),
 
@@ -21,6 +21,7 @@ public:
         SPRITE_DRAW,
         SHADOWVOLUME_DRAW,
         VEGETATION_DRAW,
+        AUTO_INSTANCING,
 
         FOG_ENABLE,
 
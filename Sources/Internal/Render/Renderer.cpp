@@ -300,6 +300,10 @@ void RenderStats::Reset()
     batches2d = 0U;
     packets2d = 0U;
 
+    batches3d = 0U;
+    packets3d = 0U;
+    instancedPackets3d = 0U;
+
     visibleRenderObjects = 0U;
     occludedRenderObjects = 0U;
 
@@ -91,6 +91,10 @@ struct RenderStats
     uint32 batches2d = 0U;
     uint32 packets2d = 0U;
 
+    uint32 batches3d = 0U;
+    uint32 packets3d = 0U;
+    uint32 instancedPackets3d = 0U;
+
     uint32 visibleRenderObjects = 0U;
     uint32 occludedRenderObjects = 0U;
 
@@ -70,6 +70,12 @@ public:
         return requiredVertexFormat;
     }
 
+    //vertex program has per-instance vertex stream
+    bool HasInstanceStream() const
+    {
+        return instanceStream;
+    }
+
     const Vector<ConstBufferDescriptor>& GetConstBufferDescriptors() const
     {
         return constBuffers;
@@ -102,6 +108,7 @@ private:
     rhi::HPipelineState piplineState;
 
     uint32 requiredVertexFormat;
+    bool instanceStream = false;
 
     rhi::ShaderSamplerList fragmentSamplerList;
     rhi::ShaderSamplerList vertexSamplerList;
@@ -31,6 +31,16 @@ Map<FastName, ShaderSourceCode> shaderSourceCodes;
 Mutex shaderCacheMutex;
 bool loadingNotifyEnabled = false;
 bool initialized = false;
+
+bool HasInstanceStream(const rhi::VertexLayout& layout)
+{
+    for (uint32 i = 0, sz = layout.StreamCount(); i < sz; ++i)
+    {
+        if (layout.StreamFrequency(i) == rhi::VDF_PER_INSTANCE)
+            return true;
+    }
+    return false;
+}
 }
 
 void Initialize()
@@ -330,6 +340,7 @@ ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<F
     {
         res->UpdateConfigFromSource(const_cast<rhi::ShaderSource*>(vSource), const_cast<rhi::ShaderSource*>(fSource));
         res->requiredVertexFormat = GetVertexLayoutRequiredFormat(psDesc.vertexLayout);
+        res->instanceStream = HasInstanceStream(psDesc.vertexLayout);
     }
     else
     {
@@ -387,10 +398,12 @@ void ReloadShaders()
         {
             shader->UpdateConfigFromSource(&vSource, &fSource);
             shader->requiredVertexFormat = GetVertexLayoutRequiredFormat(psDesc.vertexLayout);
+            shader->instanceStream = HasInstanceStream(psDesc.vertexLayout);
         }
         else
         {
             shader->requiredVertexFormat = 0;
+            shader->instanceStream = false;
         }
     }
 }
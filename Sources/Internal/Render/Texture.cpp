@@ -27,9 +27,14 @@
 #include "Render/GPUFamilyDescriptor.h"
 #include "Math/MathHelpers.h"
 #include "Concurrency/LockGuard.h"
+#include "Concurrency/ManualResetEvent.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
 
 #define DAVA_DEBUG_TEXTURE_DISABLE_LOADING 0
 
+#include <atomic>
+
 namespace DAVA
 {
 
@@ -430,7 +435,17 @@ Texture* Texture::CreateFromImage(TextureDescriptor* descriptor, eGPUFamily gpu)
 
     Vector<Image*>* images = new Vector<Image*>();
 
-    bool loaded = texture->LoadImages(gpu, images);
+    bool loaded = TakePrefetchedImages(descriptor->pathname, gpu, texture->GetBaseMipMap(), images);
+    if (loaded)
+    {
+        texture->isPink = false;
+        texture->state = STATE_DATA_LOADED;
+    }
+    else
+    {
+        loaded = texture->LoadImages(gpu, images);
+    }
+
     if (!loaded)
     {
         SafeDelete(images);
@@ -456,28 +471,40 @@ Texture* Texture::CreateFromImage(TextureDescriptor* descriptor, eGPUFamily gpu)
 }
 
 bool Texture::LoadImages(eGPUFamily gpu, Vector<Image*>* images)
+{
+    if (!LoadImages(texDescriptor, gpu, GetBaseMipMap(), images))
+    {
+        return false;
+    }
+
+    isPink = false;
+    state = STATE_DATA_LOADED;
+
+    return true;
+}
+
+bool Texture::LoadImages(const TextureDescriptor* descriptor, eGPUFamily gpu, uint32 baseMipMap, Vector<Image*>* images)
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
 
     DVASSERT(gpu != GPU_INVALID);
 
-    if (!IsLoadAvailable(gpu))
+    if (!IsLoadAvailable(descriptor, gpu))
     {
         Logger::Error("[Texture::LoadImages] Load not available: invalid requested GPU family (%s)", GlobalEnumMap<eGPUFamily>::Instance()->ToString(gpu));
         return false;
     }
 
-    uint32 baseMipMap = GetBaseMipMap();
     ImageSystem::LoadingParams params;
     params.baseMipmap = baseMipMap;
     params.firstMipmapIndex = 0;
     params.minimalWidth = Texture::MINIMAL_WIDTH;
     params.minimalHeight = Texture::MINIMAL_HEIGHT;
 
-    if (texDescriptor->IsCubeMap() && (!GPUFamilyDescriptor::IsGPUForDevice(gpu)))
+    if (descriptor->IsCubeMap() && (!GPUFamilyDescriptor::IsGPUForDevice(gpu)))
     {
         Vector<FilePath> facePathes;
-        texDescriptor->GetFacePathnames(facePathes);
+        descriptor->GetFacePathnames(facePathes);
 
         PixelFormat imagesFormat = FORMAT_INVALID;
         for (uint32 i = 0; i < CUBE_FACE_COUNT; ++i)
@@ -515,7 +542,7 @@ bool Texture::LoadImages(eGPUFamily gpu, Vector<Image*>* images)
             }
             //end of cubemap formats validation
 
-            if (texDescriptor->GetGenerateMipMaps())
+            if (descriptor->GetGenerateMipMaps())
             {
                 Vector<Image*> mipmapsImages = faceImage[0]->CreateMipMapsImages();
                 images->insert(images->end(), mipmapsImages.begin(), mipmapsImages.end());
@@ -530,7 +557,7 @@ bool Texture::LoadImages(eGPUFamily gpu, Vector<Image*>* images)
     else
     {
         Vector<FilePath> singleMipFiles;
-        bool hasSingleMipFiles = texDescriptor->CreateSingleMipPathnamesForGPU(gpu, singleMipFiles);
+        bool hasSingleMipFiles = descriptor->CreateSingleMipPathnamesForGPU(gpu, singleMipFiles);
         if (hasSingleMipFiles)
         {
             uint32 singleMipFilesCount = static_cast<uint32>(singleMipFiles.size());
@@ -547,7 +574,7 @@ bool Texture::LoadImages(eGPUFamily gpu, Vector<Image*>* images)
             params.baseMipmap = Max(static_cast<int32>(baseMipMap) - static_cast<int32>(singleMipFilesCount), 0);
         }
 
-        FilePath multipleMipPathname = texDescriptor->CreateMultiMipPathnameForGPU(gpu);
+        FilePath multipleMipPathname = descriptor->CreateMultiMipPathnameForGPU(gpu);
         ImageSystem::Load(multipleMipPathname, *images, params);
 
         ImageSystem::EnsurePowerOf2Images(*images);
@@ -567,22 +594,19 @@ bool Texture::LoadImages(eGPUFamily gpu, Vector<Image*>* images)
         return false;
     }
 
-    if (images->size() == 1 && texDescriptor->GetGenerateMipMaps())
+    if (images->size() == 1 && descriptor->GetGenerateMipMaps())
     {
         Image* img = *images->begin();
-        *images = img->CreateMipMapsImages(texDescriptor->dataSettings.GetIsNormalMap());
+        *images = img->CreateMipMapsImages(descriptor->dataSettings.GetIsNormalMap());
         SafeRelease(img);
 
         if (images->empty())
         {
-            Logger::Error("[Texture::LoadImages] Can't create mipmaps for GPU (%s) for %s", GlobalEnumMap<eGPUFamily>::Instance()->ToString(gpu), texDescriptor->pathname.GetStringValue().c_str());
+            Logger::Error("[Texture::LoadImages] Can't create mipmaps for GPU (%s) for %s", GlobalEnumMap<eGPUFamily>::Instance()->ToString(gpu), descriptor->pathname.GetStringValue().c_str());
             return false;
         }
     }
 
-    isPink = false;
-    state = STATE_DATA_LOADED;
-
     return true;
 }
 
@@ -786,6 +810,181 @@ Texture* Texture::PureCreate(const FilePath& pathName, const FastName& group)
     return texture;
 }
 
+// Entry is owned by PrefetchedImages objects and worker jobs, map refers to it weakly.
+// So images decoded after all owners are gone are released with the last reference.
+struct Texture::PrefetchEntry
+{
+    enum eState : uint32
+    {
+        PENDING,
+        LOADING,
+        READY,
+        TAKEN
+    };
+
+    ~PrefetchEntry()
+    {
+        ReleaseImages(&images);
+    }
+
+    FilePath descriptorPathname;
+    FastName group;
+    std::atomic<uint32> state{ PENDING };
+    ManualResetEvent loaded{ false };
+    eGPUFamily gpu = GPU_INVALID;
+    uint32 baseMipMap = 0;
+    Vector<Image*> images;
+};
+
+class Texture::PrefetchedImages
+{
+public:
+    ~PrefetchedImages()
+    {
+        Vector<FilePath> paths;
+        paths.reserve(entries.size());
+        for (const std::shared_ptr<PrefetchEntry>& entry : entries)
+        {
+            paths.push_back(entry->descriptorPathname);
+        }
+        entries.clear();
+
+        // entries which are not owned by anybody else are gone now, entries which are being decoded go with their job
+        LockGuard<Mutex> guard(prefetchMutex);
+        for (const FilePath& path : paths)
+        {
+            auto found = prefetchedImages.find(path);
+            if (found != prefetchedImages.end() && found->second.expired())
+            {
+                prefetchedImages.erase(found);
+            }
+        }
+    }
+
+    Vector<std::shared_ptr<PrefetchEntry>> entries;
+};
+
+Map<FilePath, std::weak_ptr<Texture::PrefetchEntry>> Texture::prefetchedImages;
+Mutex Texture::prefetchMutex;
+
+std::shared_ptr<Texture::PrefetchedImages> Texture::PrefetchImages(const Vector<FilePath>& pathNames, const FastName& group)
+{
+    DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
+
+    std::shared_ptr<PrefetchedImages> result = std::make_shared<PrefetchedImages>();
+    if (!Renderer::GetOptions()->IsOptionEnabled(RenderOptions::TEXTURE_LOAD_ENABLED))
+        return result;
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (jobManager == nullptr)
+        return result;
+
+    Vector<std::shared_ptr<PrefetchEntry>> newEntries;
+    {
+        LockGuard<Mutex> guard(prefetchMutex);
+        for (const FilePath& pathName : pathNames)
+        {
+            if (pathName.IsEmpty() || (pathName.GetType() == FilePath::PATH_IN_MEMORY))
+                continue;
+
+            FilePath descriptorPathname = TextureDescriptor::GetDescriptorPathname(pathName);
+            auto found = prefetchedImages.find(descriptorPathname);
+            if (found != prefetchedImages.end())
+            {
+                // already prefetched by somebody else, keep it for this owner too
+                std::shared_ptr<PrefetchEntry> entry = found->second.lock();
+                if (entry)
+                {
+                    result->entries.push_back(entry);
+                    continue;
+                }
+            }
+
+            Texture* texture = Texture::Get(descriptorPathname);
+            if (texture != nullptr)
+            {
+                texture->Release();
+                continue;
+            }
+
+            std::shared_ptr<PrefetchEntry> entry = std::make_shared<PrefetchEntry>();
+            entry->descriptorPathname = descriptorPathname;
+            entry->group = group;
+            prefetchedImages[descriptorPathname] = entry;
+            result->entries.push_back(entry);
+            newEntries.push_back(entry);
+        }
+    }
+
+    // nobody waits for the whole batch, so each entry gets its own job; entries already taken are skipped
+    for (const std::shared_ptr<PrefetchEntry>& entry : newEntries)
+    {
+        std::weak_ptr<PrefetchEntry> weakEntry = entry;
+        jobManager->CreateWorkerJob([weakEntry]() {
+            std::shared_ptr<PrefetchEntry> entry = weakEntry.lock();
+            uint32 expected = PrefetchEntry::PENDING;
+            if (entry && entry->state.compare_exchange_strong(expected, PrefetchEntry::LOADING))
+            {
+                LoadPrefetchEntry(entry.get());
+                entry->state = PrefetchEntry::READY;
+                entry->loaded.Signal();
+            }
+        });
+    }
+    return result;
+}
+
+void Texture::LoadPrefetchEntry(PrefetchEntry* entry)
+{
+    DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
+
+    std::unique_ptr<TextureDescriptor> descriptor(TextureDescriptor::CreateFromFile(entry->descriptorPathname));
+    if (!descriptor)
+        return;
+
+    descriptor->SetQualityGroup(entry->group);
+    entry->baseMipMap = GetBaseMipMap(descriptor.get());
+    for (eGPUFamily gpu : gpuLoadingOrder)
+    {
+        eGPUFamily gpuForLoading = GetGPUForLoading(gpu, descriptor.get());
+        if (LoadImages(descriptor.get(), gpuForLoading, entry->baseMipMap, &entry->images))
+        {
+            entry->gpu = gpuForLoading;
+            break;
+        }
+    }
+}
+
+bool Texture::TakePrefetchedImages(const FilePath& descriptorPathname, eGPUFamily gpu, uint32 baseMipMap, Vector<Image*>* images)
+{
+    std::shared_ptr<PrefetchEntry> entry;
+    {
+        LockGuard<Mutex> guard(prefetchMutex);
+        auto found = prefetchedImages.find(descriptorPathname);
+        if (found == prefetchedImages.end())
+            return false;
+
+        entry = found->second.lock();
+        prefetchedImages.erase(found);
+        if (!entry)
+            return false;
+    }
+
+    // not started by workers yet, so load it usual way right now
+    uint32 expected = PrefetchEntry::PENDING;
+    if (entry->state.compare_exchange_strong(expected, PrefetchEntry::TAKEN))
+        return false;
+
+    // entry is removed from map, so nobody else takes it; wait until worker finishes decoding
+    entry->loaded.Wait();
+
+    if (entry->images.empty() || entry->gpu != gpu || entry->baseMipMap != baseMipMap)
+        return false;
+
+    images->swap(entry->images);
+    return true;
+}
+
 void Texture::ReloadFromData(PixelFormat format, uint8* data, uint32 _width, uint32 _height)
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
@@ -849,12 +1048,17 @@ void Texture::ReloadAs(eGPUFamily gpuFamily)
 
 bool Texture::IsLoadAvailable(const eGPUFamily gpuFamily) const
 {
-    if (texDescriptor->IsCompressedFile())
+    return IsLoadAvailable(texDescriptor, gpuFamily);
+}
+
+bool Texture::IsLoadAvailable(const TextureDescriptor* descriptor, const eGPUFamily gpuFamily)
+{
+    if (descriptor->IsCompressedFile())
     {
         return true;
     }
 
-    if (GPUFamilyDescriptor::IsGPUForDevice(gpuFamily) && texDescriptor->compression[gpuFamily].format == FORMAT_INVALID)
+    if (GPUFamilyDescriptor::IsGPUForDevice(gpuFamily) && descriptor->compression[gpuFamily].format == FORMAT_INVALID)
     {
         return false;
     }
@@ -1212,10 +1416,15 @@ void Texture::SetPixelization(bool value)
 }
 
 uint32 Texture::GetBaseMipMap() const
+{
+    return GetBaseMipMap(texDescriptor);
+}
+
+uint32 Texture::GetBaseMipMap(const TextureDescriptor* descriptor)
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
 
-    if (texDescriptor->GetQualityGroup().IsValid())
+    if (descriptor->GetQualityGroup().IsValid())
     {
         const TextureQuality* curTxQuality = QualitySettingsSystem::Instance()->GetTxQuality(QualitySettingsSystem::Instance()->GetCurTextureQuality());
         if (nullptr != curTxQuality)
@@ -114,6 +114,22 @@ public:
      */
     static Texture* PureCreate(const FilePath& pathName, const FastName& group = FastName());
 
+    /**
+        \brief Images decoded by PrefetchImages. Images which were not taken by CreateFromFile
+        are released with the last reference to this object.
+     */
+    class PrefetchedImages;
+
+    /**
+        \brief Decode images of given textures on JobManager workers.
+        Following CreateFromFile calls with the same group only create render resources from decoded images,
+        waiting for decoding which is already in progress. Must be called from the same thread as CreateFromFile.
+        \param[in] pathNames paths to textures or texture descriptors
+        \param[in] group quality group which textures will be created with
+        \return images which are kept for CreateFromFile while returned object is alive
+     */
+    static std::shared_ptr<PrefetchedImages> PrefetchImages(const Vector<FilePath>& pathNames, const FastName& group = FastName());
+
     static Texture* CreatePink(rhi::TextureType requestedType = rhi::TEXTURE_TYPE_2D, bool checkers = true);
 
     static Texture* CreateFBO(uint32 width, uint32 height, PixelFormat format, bool needDepth = false,
@@ -183,6 +199,7 @@ public:
     static void SetPixelization(bool value);
 
     uint32 GetBaseMipMap() const;
+    static uint32 GetBaseMipMap(const TextureDescriptor* descriptor);
 
     static rhi::HSamplerState CreateSamplerStateHandle(const rhi::SamplerState::Descriptor::Sampler& samplerState);
 
@@ -198,12 +215,13 @@ protected:
     static Texture* CreateFromImage(TextureDescriptor* descriptor, eGPUFamily gpu);
 
     bool LoadImages(eGPUFamily gpu, Vector<Image*>* images);
+    static bool LoadImages(const TextureDescriptor* descriptor, eGPUFamily gpu, uint32 baseMipMap, Vector<Image*>* images);
 
     void SetParamsFromImages(const Vector<Image*>* images);
 
     void FlushDataToRenderer(Vector<Image*>* images);
 
-    void ReleaseImages(Vector<Image*>* images);
+    static void ReleaseImages(Vector<Image*>* images);
 
     void MakePink(bool checkers = true);
 
@@ -211,6 +229,14 @@ protected:
     virtual ~Texture();
 
     bool IsLoadAvailable(const eGPUFamily gpuFamily) const;
+    static bool IsLoadAvailable(const TextureDescriptor* descriptor, const eGPUFamily gpuFamily);
+
+    struct PrefetchEntry;
+    static void LoadPrefetchEntry(PrefetchEntry* entry);
+    static bool TakePrefetchedImages(const FilePath& descriptorPathname, eGPUFamily gpu, uint32 baseMipMap, Vector<Image*>* images);
+
+    static Map<FilePath, std::weak_ptr<PrefetchEntry>> prefetchedImages;
+    static Mutex prefetchMutex;
 
 public: // properties for fast access
     rhi::HTexture handle;
@@ -190,13 +190,13 @@ void SpeedTreeConverter::ConvertLeafPGForAnimations(PolygonGroup* pg)
     DVASSERT((vertexFormat & oldLeafFormat) == oldLeafFormat); //old tree leaf vertex format
 
     PolygonGroup* pgCopy = new PolygonGroup();
-    pgCopy->AllocateData(vertexFormat, vxCount, indCount);
+    pgCopy->AllocateData(vertexFormat, vxCount, indCount, 0, pg->GetIndexFormat());
 
     Memcpy(pgCopy->meshData, pg->meshData, vxCount * pg->vertexStride);
-    Memcpy(pgCopy->indexArray, pg->indexArray, indCount * sizeof(int16));
+    Memcpy(pgCopy->GetIndexData(), pg->GetIndexData(), indCount * INDEX_FORMAT_SIZE[pg->GetIndexFormat()]);
 
     pg->ReleaseData();
-    pg->AllocateData(EVF_VERTEX | EVF_COLOR | EVF_TEXCOORD0 | EVF_PIVOT_DEPRECATED | EVF_FLEXIBILITY | EVF_ANGLE_SIN_COS, vxCount, indCount);
+    pg->AllocateData(EVF_VERTEX | EVF_COLOR | EVF_TEXCOORD0 | EVF_PIVOT_DEPRECATED | EVF_FLEXIBILITY | EVF_ANGLE_SIN_COS, vxCount, indCount, 0, pgCopy->GetIndexFormat());
 
     //copy indices
     for (int32 i = 0; i < indCount; ++i)
@@ -239,13 +239,13 @@ void SpeedTreeConverter::ConvertTrunkForAnimations(PolygonGroup* pg)
     DVASSERT((vertexFormat & oldTrunkFormat) == oldTrunkFormat); //old tree trunk vertex format
 
     PolygonGroup* pgCopy = new PolygonGroup();
-    pgCopy->AllocateData(vertexFormat, vxCount, indCount);
+    pgCopy->AllocateData(vertexFormat, vxCount, indCount, 0, pg->GetIndexFormat());
 
     Memcpy(pgCopy->meshData, pg->meshData, vxCount * pg->vertexStride);
-    Memcpy(pgCopy->indexArray, pg->indexArray, indCount * sizeof(int16));
+    Memcpy(pgCopy->GetIndexData(), pg->GetIndexData(), indCount * INDEX_FORMAT_SIZE[pg->GetIndexFormat()]);
 
     pg->ReleaseData();
-    pg->AllocateData(EVF_VERTEX | EVF_TEXCOORD0 | EVF_FLEXIBILITY, vxCount, indCount);
+    pg->AllocateData(EVF_VERTEX | EVF_TEXCOORD0 | EVF_FLEXIBILITY, vxCount, indCount, 0, pgCopy->GetIndexFormat());
 
     //copy indices
     for (int32 i = 0; i < indCount; ++i)
@@ -289,9 +289,9 @@ void SpeedTreeConverter::ConvertPolygonGroupsPivot3(Entity* scene)
         int32 vertexSize = GetVertexSize(vertexFormat);
 
         PolygonGroup* pg = new PolygonGroup();
-        pg->AllocateData(vertexFormat, vxCount, indCount);
+        pg->AllocateData(vertexFormat, vxCount, indCount, 0, dataSource->GetIndexFormat());
         memcpy(pg->meshData, dataSource->meshData, vertexSize * vxCount);
-        memcpy(pg->indexArray, dataSource->indexArray, indCount * sizeof(uint16));
+        memcpy(pg->GetIndexData(), dataSource->GetIndexData(), indCount * INDEX_FORMAT_SIZE[dataSource->GetIndexFormat()]);
 
         pgCopy[dataSource] = pg;
     }
@@ -307,9 +307,9 @@ void SpeedTreeConverter::ConvertPolygonGroupsPivot3(Entity* scene)
         int32 convertedFormat = (vertexFormat & ~EVF_PIVOT_DEPRECATED) | EVF_PIVOT4;
 
         pg->ReleaseGeometryData();
-        pg->AllocateData(convertedFormat, vxCount, indCount);
+        pg->AllocateData(convertedFormat, vxCount, indCount, 0, dataSource->GetIndexFormat());
 
-        Memcpy(pg->indexArray, dataSource->indexArray, indCount * sizeof(int16));
+        Memcpy(pg->GetIndexData(), dataSource->GetIndexData(), indCount * INDEX_FORMAT_SIZE[dataSource->GetIndexFormat()]);
 
         uint8* dst = pg->meshData;
         const uint8* src = dataSource->meshData;
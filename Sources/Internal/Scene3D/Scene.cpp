@@ -1,10 +1,13 @@
 #include "Scene3D/Scene.h"
 
+#include "Base/RefPtr.h"
 #include "Concurrency/Thread.h"
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
+#include "Engine/Engine.h"
 #include "Entity/ComponentUtils.h"
 #include "FileSystem/FileSystem.h"
+#include "Job/JobManager.h"
 #include "Render/3D/StaticMesh.h"
 #include "Render/Highlevel/Landscape.h"
 #include "Render/Highlevel/Light.h"
@@ -749,6 +752,14 @@ void Scene::Draw()
 
     if (particleEffectDebugDrawSystem != nullptr)
         particleEffectDebugDrawSystem->Draw();
+
+    // visible materials have requested their textures during first render
+    prefetchedTextureImages.clear();
+}
+
+void Scene::KeepPrefetchedTextureImages(Vector<std::shared_ptr<Texture::PrefetchedImages>> images)
+{
+    prefetchedTextureImages.insert(prefetchedTextureImages.end(), images.begin(), images.end());
 }
 
 void Scene::SceneDidLoaded()
@@ -832,6 +843,94 @@ SceneFileV2::eError Scene::LoadScene(const DAVA::FilePath& pathname)
     return ret;
 }
 
+namespace SceneDetails
+{
+// Loading on main thread is spread over frames, so it takes about this time per frame
+const uint32 LOAD_FRAME_BUDGET_MS = 10;
+
+void LoadSceneStep(RefPtr<Scene> scene, RefPtr<SceneFileV2> file, Function<void(float32)> onProgress, Function<void(SceneFileV2::eError)> onFinished)
+{
+    if (file->LoadSceneStep(LOAD_FRAME_BUDGET_MS))
+    {
+        if (file->GetError() == SceneFileV2::ERROR_NO_ERROR)
+        {
+            onProgress(1.0f);
+        }
+        onFinished(file->GetError());
+    }
+    else
+    {
+        onProgress(file->GetLoadProgress());
+        RunOnMainThreadAsync([scene, file, onProgress, onFinished]() {
+            LoadSceneStep(scene, file, onProgress, onFinished);
+        });
+    }
+}
+}
+
+void Scene::LoadAsync(const FilePath& pathname, const Function<void(float32)>& onProgress, const Function<void(SceneFileV2::eError)>& onFinished)
+{
+    RemoveAllChildren();
+    SetName(pathname.GetFilename().c_str());
+
+    if (!pathname.IsEqualToExtension(".sc2"))
+    {
+        onFinished(SceneFileV2::ERROR_FAILED_TO_CREATE_FILE);
+        return;
+    }
+
+    // share of reading file in total progress
+    const float32 readProgress = 0.3f;
+    RefPtr<Scene> scene = RefPtr<Scene>::ConstructWithRetain(this);
+    RefPtr<SceneFileV2> file(new SceneFileV2());
+    file->EnableDebugLog(false);
+
+    auto reportProgress = [onProgress, readProgress](float32 progress) {
+        if (onProgress)
+        {
+            onProgress(readProgress + (1.0f - readProgress) * progress);
+        }
+    };
+
+    auto beginLoading = [scene, file, pathname, reportProgress, onFinished](std::shared_ptr<Vector<uint8>> data, SceneFileV2::eError error) {
+        if (error == SceneFileV2::ERROR_NO_ERROR)
+        {
+            reportProgress(0.0f);
+            error = file->BeginLoadScene(pathname, scene.Get(), std::move(*data));
+        }
+
+        if (error == SceneFileV2::ERROR_NO_ERROR)
+        {
+            SceneDetails::LoadSceneStep(scene, file, reportProgress, onFinished);
+        }
+        else
+        {
+            onFinished(error);
+        }
+    };
+
+    auto readData = [pathname, beginLoading]() {
+        std::shared_ptr<Vector<uint8>> data = std::make_shared<Vector<uint8>>();
+        SceneFileV2::eError error = SceneFileV2::ReadSceneData(pathname, *data);
+        RunOnMainThreadAsync([beginLoading, data, error]() { beginLoading(data, error); });
+    };
+
+    if (onProgress)
+    {
+        onProgress(0.0f);
+    }
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (jobManager != nullptr)
+    {
+        jobManager->CreateWorkerJob(readData);
+    }
+    else
+    {
+        readData();
+    }
+}
+
 SceneFileV2::eError Scene::SaveScene(const DAVA::FilePath& pathname, bool saveForGame /*= false*/)
 {
     std::function<void(Entity*)> resolveId = [&](Entity* entity)
@@ -9,6 +9,7 @@
 #include "Render/Highlevel/Light.h"
 #include "Reflection/Reflection.h"
 #include "Render/RenderBase.h"
+#include "Render/Texture.h"
 #include "Scene3D/Entity.h"
 #include "Scene3D/SceneFile/SerializationContext.h"
 #include "Scene3D/SceneFile/VersionInfo.h"
@@ -232,8 +233,21 @@ public:
     ParticleEffectDebugDrawSystem* GetParticleEffectDebugDrawSystem() const;
 
     virtual SceneFileV2::eError LoadScene(const DAVA::FilePath& pathname);
+    /**
+        Load scene without blocking main thread while file is read. Geometry and textures are decoded
+        by JobManager workers, entities and render resources are created on main thread in steps spread over frames.
+        `onProgress` is called on main thread with values in [0, 1] and can be empty,
+        `onFinished` is called on main thread when loading is done. Scene is retained until then.
+    */
+    void LoadAsync(const FilePath& pathname, const Function<void(float32)>& onProgress, const Function<void(SceneFileV2::eError)>& onFinished);
     virtual SceneFileV2::eError SaveScene(const DAVA::FilePath& pathname, bool saveForGame = false);
 
+    /**
+        Keep texture images decoded during scene loading until scene is drawn first time.
+        Materials take them when they request their textures, images which were not requested are released.
+    */
+    void KeepPrefetchedTextureImages(Vector<std::shared_ptr<Texture::PrefetchedImages>> images);
+
     virtual void OptimizeBeforeExport();
 
     DAVA::NMaterial* GetGlobalMaterial() const;
@@ -271,6 +285,7 @@ protected:
     Vector<Camera*> cameras;
 
     NMaterial* sceneGlobalMaterial;
+    Vector<std::shared_ptr<Texture::PrefetchedImages>> prefetchedTextureImages;
 
     Camera* mainCamera;
     Camera* drawCamera;
@@ -10,9 +10,24 @@
 
 #include "Render/Material/NMaterialNames.h"
 #include "Render/Texture.h"
+#include "Render/3D/PolygonGroup.h"
+#include "FileSystem/DynamicMemoryFile.h"
+#include "FileSystem/KeyedArchive.h"
+#include "Job/ParallelFor.h"
 
 namespace DAVA
 {
+namespace SerializationContextDetails
+{
+struct PolygonGroupLoadTask
+{
+    PolygonGroup* group = nullptr;
+    SerializationContext::PolygonGroupLoadInfo info;
+    bool archiveLoaded = false;
+    bool decoded = false;
+};
+}
+
 SerializationContext::SerializationContext()
     : globalMaterialKey(0)
 {
@@ -77,17 +92,68 @@ void SerializationContext::AddRequestedPolygonGroupFormat(PolygonGroup* group, i
 
 bool SerializationContext::LoadPolygonGroupData(File* file)
 {
-    bool resultLoaded = true;
-    bool cutUnusedStreams = QualitySettingsSystem::Instance()->GetAllowCutUnusedVertexStreams();
+    using namespace SerializationContextDetails;
+
+    const bool cutUnusedStreams = QualitySettingsSystem::Instance()->GetAllowCutUnusedVertexStreams();
+    Vector<PolygonGroupLoadTask> tasks;
     for (Map<PolygonGroup *, PolygonGroupLoadInfo>::iterator it = loadedPolygonGroups.begin(), e = loadedPolygonGroups.end(); it != e; ++it)
     {
         if (it->second.onScene || !cutUnusedStreams)
         {
-            resultLoaded &= file->Seek(it->second.filePos, File::SEEK_FROM_START);
-            KeyedArchive* archive = new KeyedArchive();
-            resultLoaded &= archive->Load(file);
-            it->first->LoadPolygonData(archive, this, it->second.requestedFormat, cutUnusedStreams);
-            SafeRelease(archive);
+            PolygonGroupLoadTask task;
+            task.group = it->first;
+            task.info = it->second;
+            tasks.push_back(task);
+        }
+    }
+
+    if (tasks.empty())
+    {
+        return true;
+    }
+
+    // archives are parsed straight from memory, so workers don't share file position
+    const uint8* data = nullptr;
+    uint32 dataSize = 0;
+    Vector<uint8> fileData;
+    DynamicMemoryFile* memoryFile = dynamic_cast<DynamicMemoryFile*>(file);
+    if (memoryFile != nullptr)
+    {
+        data = memoryFile->GetData();
+        dataSize = static_cast<uint32>(memoryFile->GetSize());
+    }
+    else
+    {
+        fileData.resize(static_cast<size_t>(file->GetSize()));
+        if (!file->Seek(0, File::SEEK_FROM_START) || file->Read(fileData.data(), static_cast<uint32>(fileData.size())) != fileData.size())
+        {
+            return false;
+        }
+        data = fileData.data();
+        dataSize = static_cast<uint32>(fileData.size());
+    }
+
+    ParallelFor(static_cast<uint32>(tasks.size()), [&](uint32 i) {
+        PolygonGroupLoadTask& task = tasks[i];
+        if (task.info.filePos < dataSize)
+        {
+            ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+            task.archiveLoaded = archive->Load(data + task.info.filePos, dataSize - task.info.filePos);
+            if (task.archiveLoaded)
+            {
+                task.decoded = task.group->DecodePolygonData(archive, this, task.info.requestedFormat, cutUnusedStreams);
+            }
+        }
+    });
+
+    // render buffers are created on loading thread only
+    bool resultLoaded = true;
+    for (const PolygonGroupLoadTask& task : tasks)
+    {
+        resultLoaded &= task.archiveLoaded;
+        if (task.decoded)
+        {
+            task.group->BuildBuffers();
         }
     }
     return resultLoaded;
@@ -21,6 +21,7 @@
 #include "Logger/Logger.h"
 #include "Utils/StringFormat.h"
 #include "FileSystem/FileSystem.h"
+#include "FileSystem/DynamicMemoryFile.h"
 #include "Base/ObjectFactory.h"
 #include "Base/TemplateHelpers.h"
 #include "Render/Highlevel/Landscape.h"
@@ -39,6 +40,7 @@
 #include "Scene3D/Converters/SpeedTreeConverter.h"
 
 #include "Job/JobManager.h"
+#include "Time/SystemTimer.h"
 
 #include <functional>
 #include "Engine/EngineContext.h"
@@ -377,15 +379,180 @@ VersionInfo::SceneVersion SceneFileV2::LoadSceneVersion(const FilePath& filename
 }
 
 SceneFileV2::eError SceneFileV2::LoadScene(const FilePath& filename, Scene* scene)
+{
+    Vector<uint8> data;
+    const eError readError = ReadSceneData(filename, data);
+    if (readError != ERROR_NO_ERROR)
+    {
+        SetError(readError);
+        return GetError();
+    }
+
+    return LoadScene(filename, scene, std::move(data), nullptr);
+}
+
+SceneFileV2::eError SceneFileV2::ReadSceneData(const FilePath& filename, Vector<uint8>& data)
 {
     ScopedPtr<File> file(File::Create(filename, File::OPEN | File::READ));
     if (!file)
     {
         Logger::Error("SceneFileV2::LoadScene failed to open file: %s", filename.GetAbsolutePathname().c_str());
-        SetError(ERROR_FAILED_TO_CREATE_FILE);
+        return ERROR_FAILED_TO_CREATE_FILE;
+    }
+
+    data.resize(static_cast<size_t>(file->GetSize()));
+    const uint32 dataSize = static_cast<uint32>(data.size());
+    if (file->Read(data.data(), dataSize) != dataSize)
+    {
+        Logger::Error("SceneFileV2::LoadScene failed to read file: %s", filename.GetAbsolutePathname().c_str());
+        return ERROR_FILE_READ_ERROR;
+    }
+
+    return ERROR_NO_ERROR;
+}
+
+SceneFileV2::eError SceneFileV2::LoadScene(const FilePath& filename, Scene* scene, Vector<uint8>&& data, const Function<void(float32)>& onProgress)
+{
+    BeginLoadScene(filename, scene, std::move(data));
+    while (!LoadSceneStep(0))
+    {
+        if (onProgress)
+        {
+            onProgress(GetLoadProgress());
+        }
+    }
+
+    if (onProgress && GetError() == ERROR_NO_ERROR)
+    {
+        onProgress(1.0f);
+    }
+
+    return GetError();
+}
+
+SceneFileV2::eError SceneFileV2::BeginLoadScene(const FilePath& filename, Scene* scene, Vector<uint8>&& data)
+{
+    // whole file is in memory, so polygon groups can be parsed by workers in any order
+    loadState = LoadState();
+    loadState.filename = filename;
+    loadState.scene = scene;
+    loadState.file = RefPtr<File>(DynamicMemoryFile::Create(std::move(data), File::OPEN | File::READ, filename));
+
+    if (LoadSceneHeader(filename, scene, loadState.file.Get()) != ERROR_NO_ERROR)
+    {
+        FinishLoading();
         return GetError();
     }
 
+    loadState.stage = (header.version >= 2) ? LOAD_STAGE_DATA_NODES : LOAD_STAGE_HIERARCHY;
+    return GetError();
+}
+
+bool SceneFileV2::LoadSceneStep(uint32 timeBudgetMs)
+{
+    const int64 startMs = SystemTimer::GetMs();
+    while (loadState.stage != LOAD_STAGE_FINISHED)
+    {
+        const FilePath& filename = loadState.filename;
+        File* file = loadState.file.Get();
+        Scene* scene = loadState.scene;
+
+        switch (loadState.stage)
+        {
+        case LOAD_STAGE_DATA_NODES:
+            if (loadState.dataNodesLoaded < loadState.dataNodeCount)
+            {
+                if (!LoadDataNode(scene, nullptr, file))
+                {
+                    Logger::Error("SceneFileV2::LoadScene LoadDataNode failed in file: %s", filename.GetAbsolutePathname().c_str());
+                    SetError(ERROR_FILE_READ_ERROR);
+                }
+                ++loadState.dataNodesLoaded;
+            }
+            else if (LoadGlobalMaterial(filename, scene, file) == ERROR_NO_ERROR)
+            {
+                scene->children.reserve(header.nodeCount);
+                loadState.stage = LOAD_STAGE_HIERARCHY;
+            }
+            break;
+
+        case LOAD_STAGE_HIERARCHY:
+            if (loadState.entitiesLoaded < header.nodeCount)
+            {
+                if (!LoadHierarchy(0, scene, file, 1))
+                {
+                    Logger::Error("SceneFileV2::LoadScene LoadHierarchy failed in file: %s", filename.GetAbsolutePathname().c_str());
+                    SetError(ERROR_FILE_READ_ERROR);
+                }
+                ++loadState.entitiesLoaded;
+            }
+            else
+            {
+                loadState.stage = LOAD_STAGE_GEOMETRY;
+            }
+            break;
+
+        case LOAD_STAGE_GEOMETRY:
+            LoadSceneGeometry(filename, scene, file);
+            loadState.stage = LOAD_STAGE_FINISHED;
+            break;
+
+        default:
+            break;
+        }
+
+        if (GetError() != ERROR_NO_ERROR)
+        {
+            loadState.stage = LOAD_STAGE_FINISHED;
+        }
+
+        if (SystemTimer::GetMs() - startMs >= timeBudgetMs)
+        {
+            break;
+        }
+    }
+
+    if (loadState.stage == LOAD_STAGE_FINISHED)
+    {
+        FinishLoading();
+        return true;
+    }
+    return false;
+}
+
+float32 SceneFileV2::GetLoadProgress() const
+{
+    // rough shares of loading time: data nodes, entities, geometry
+    const float32 dataNodesShare = 0.2f;
+    const float32 entitiesShare = 0.4f;
+
+    switch (loadState.stage)
+    {
+    case LOAD_STAGE_DATA_NODES:
+        return dataNodesShare * loadState.dataNodesLoaded / Max(loadState.dataNodeCount, 1);
+    case LOAD_STAGE_HIERARCHY:
+        return dataNodesShare + entitiesShare * loadState.entitiesLoaded / Max(header.nodeCount, 1);
+    case LOAD_STAGE_GEOMETRY:
+        return dataNodesShare + entitiesShare;
+    default:
+        return 1.0f;
+    }
+}
+
+void SceneFileV2::FinishLoading()
+{
+    if (GetError() != ERROR_NO_ERROR)
+    {
+        prefetchedTextures.clear();
+    }
+
+    loadState.stage = LOAD_STAGE_FINISHED;
+    loadState.file = nullptr;
+    loadState.scene = nullptr;
+}
+
+SceneFileV2::eError SceneFileV2::LoadSceneHeader(const FilePath& filename, Scene* scene, File* file)
+{
     const bool headerValid = ReadHeader(header, file);
 
     if (!headerValid)
@@ -462,78 +629,69 @@ SceneFileV2::eError SceneFileV2::LoadScene(const FilePath& filename, Scene* scen
             SetError(ERROR_FILE_READ_ERROR);
             return GetError();
         }
+        loadState.dataNodeCount = dataNodeCount;
+    }
 
-        for (int k = 0; k < dataNodeCount; ++k)
+    return GetError();
+}
+
+SceneFileV2::eError SceneFileV2::LoadGlobalMaterial(const FilePath& filename, Scene* scene, File* file)
+{
+    NMaterial* globalMaterial = nullptr;
+
+    if (header.nodeCount > 0)
+    {
+        // try to load global material
+        uint32 filePos = static_cast<uint32>(file->GetPos());
+        ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+        const bool loaded = archive->Load(file);
+        if (!loaded)
         {
-            const bool nodeLoaded = LoadDataNode(scene, nullptr, file);
-            if (!nodeLoaded)
-            {
-                Logger::Error("SceneFileV2::LoadScene LoadDataNode failed in file: %s", filename.GetAbsolutePathname().c_str());
-                SetError(ERROR_FILE_READ_ERROR);
-                return GetError();
-            }
+            Logger::Error("SceneFileV2::LoadScene load KeyedArchive with global material failed in file: %s", filename.GetAbsolutePathname().c_str());
+            SetError(ERROR_FILE_READ_ERROR);
+            return GetError();
         }
 
-        NMaterial* globalMaterial = nullptr;
-
-        if (header.nodeCount > 0)
+        String name = archive->GetString("##name");
+        if (name == "GlobalMaterial")
         {
-            // try to load global material
-            uint32 filePos = static_cast<uint32>(file->GetPos());
-            ScopedPtr<KeyedArchive> archive(new KeyedArchive());
-            const bool loaded = archive->Load(file);
-            if (!loaded)
+            uint64 globalMaterialId = archive->GetUInt64("globalMaterialId");
+            globalMaterial = static_cast<NMaterial*>(serializationContext.GetDataBlock(globalMaterialId));
+            serializationContext.SetGlobalMaterialKey(globalMaterialId);
+            --header.nodeCount;
+        }
+        else
+        {
+            const bool res = file->Seek(filePos, File::SEEK_FROM_START);
+            if (!res)
             {
-                Logger::Error("SceneFileV2::LoadScene load KeyedArchive with global material failed in file: %s", filename.GetAbsolutePathname().c_str());
+                Logger::Error("SceneFileV2::LoadScene seek failed in file: %s", filename.GetAbsolutePathname().c_str());
                 SetError(ERROR_FILE_READ_ERROR);
                 return GetError();
             }
-
-            String name = archive->GetString("##name");
-            if (name == "GlobalMaterial")
-            {
-                uint64 globalMaterialId = archive->GetUInt64("globalMaterialId");
-                globalMaterial = static_cast<NMaterial*>(serializationContext.GetDataBlock(globalMaterialId));
-                serializationContext.SetGlobalMaterialKey(globalMaterialId);
-                --header.nodeCount;
-            }
-            else
-            {
-                const bool res = file->Seek(filePos, File::SEEK_FROM_START);
-                if (!res)
-                {
-                    Logger::Error("SceneFileV2::LoadScene seek failed in file: %s", filename.GetAbsolutePathname().c_str());
-                    SetError(ERROR_FILE_READ_ERROR);
-                    return GetError();
-                }
-            }
         }
+    }
 
-        serializationContext.ResolveMaterialBindings();
+    serializationContext.ResolveMaterialBindings();
 
-        ApplyFogQuality(globalMaterial);
-        scene->SetGlobalMaterial(globalMaterial);
-    }
+    ApplyFogQuality(globalMaterial);
+    scene->SetGlobalMaterial(globalMaterial);
+
+    PrefetchMaterialTextures();
 
     if (isDebugLogEnabled)
     {
         Logger::FrameworkDebug("+ load hierarchy");
     }
 
-    scene->children.reserve(header.nodeCount);
-    for (int ci = 0; ci < header.nodeCount; ++ci)
-    {
-        const bool loaded = LoadHierarchy(0, scene, file, 1);
-        if (!loaded)
-        {
-            Logger::Error("SceneFileV2::LoadScene LoadHierarchy failed in file: %s", filename.GetAbsolutePathname().c_str());
-            SetError(ERROR_FILE_READ_ERROR);
-            return GetError();
-        }
-    }
+    return GetError();
+}
 
+SceneFileV2::eError SceneFileV2::LoadSceneGeometry(const FilePath& filename, Scene* scene, File* file)
+{
     UpdatePolygonGroupRequestedFormatRecursively(scene);
     const bool contextLoaded = serializationContext.LoadPolygonGroupData(file);
+    PassPrefetchedTextures(scene);
     if (!contextLoaded)
     {
         Logger::Error("SceneFileV2::LoadScene LoadPolygonGroupData failed in file: %s", filename.GetAbsolutePathname().c_str());
@@ -556,6 +714,38 @@ SceneFileV2::eError SceneFileV2::LoadScene(const FilePath& filename, Scene* scen
     return GetError();
 }
 
+void SceneFileV2::PrefetchMaterialTextures()
+{
+    // textures are created lazily on first use, so decode images of all loaded materials
+    // on workers while hierarchy and geometry are loaded
+    Vector<NMaterial*> materials;
+    serializationContext.GetDataNodes(materials);
+
+    Map<FastName, Vector<FilePath>> pathsBySlot;
+    for (NMaterial* material : materials)
+    {
+        for (const auto& texture : material->GetLocalTextures())
+        {
+            if (texture.second->texture == nullptr)
+            {
+                pathsBySlot[texture.first].push_back(texture.second->path);
+            }
+        }
+    }
+
+    for (const auto& slotPaths : pathsBySlot)
+    {
+        prefetchedTextures.push_back(Texture::PrefetchImages(slotPaths.second, slotPaths.first));
+    }
+}
+
+void SceneFileV2::PassPrefetchedTextures(Scene* scene)
+{
+    // textures are still created on request, scene keeps decoded images until its first draw
+    scene->KeepPrefetchedTextureImages(std::move(prefetchedTextures));
+    prefetchedTextures.clear();
+}
+
 void SceneFileV2::ApplyFogQuality(NMaterial* globalMaterial)
 {
     QualitySettingsSystem* qss = QualitySettingsSystem::Instance();
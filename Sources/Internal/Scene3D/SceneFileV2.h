@@ -2,11 +2,14 @@
 #define __DAVAENGINE_SCENEFILEV2_H__
 
 #include "Base/BaseObject.h"
+#include "Base/RefPtr.h"
 #include "Base/BaseMath.h"
 #include "Render/3D/StaticMesh.h"
 #include "Render/3D/PolygonGroup.h"
+#include "Render/Texture.h"
 #include "Utils/Utils.h"
 #include "FileSystem/File.h"
+#include "Functional/Function.h"
 #include "Scene3D/SceneFile/SerializationContext.h"
 #include "Scene3D/SceneFile/VersionInfo.h"
 
@@ -125,6 +128,26 @@ public:
 
     eError SaveScene(const FilePath& filename, Scene* _scene, SceneFileV2::eFileType fileType = SceneFileV2::SceneFile);
     eError LoadScene(const FilePath& filename, Scene* _scene);
+    /**
+        Load scene from file contents read by ReadSceneData. Geometry and texture images are decoded
+        by JobManager workers, render resources and entities are created on calling thread.
+        `onProgress` is called with values in [0, 1] and can be empty.
+    */
+    eError LoadScene(const FilePath& filename, Scene* _scene, Vector<uint8>&& data, const Function<void(float32)>& onProgress);
+    /**
+        Start loading scene from file contents read by ReadSceneData, scene is loaded by following LoadSceneStep calls.
+        Header is read here, error is returned if it is invalid.
+    */
+    eError BeginLoadScene(const FilePath& filename, Scene* _scene, Vector<uint8>&& data);
+    /**
+        Load data nodes and top-level entities one by one until `timeBudgetMs` is spent, geometry is loaded in one step.
+        Return true when loading is finished, result is returned by GetError.
+    */
+    bool LoadSceneStep(uint32 timeBudgetMs);
+    /** Share of scene loaded by LoadSceneStep calls, in [0, 1] */
+    float32 GetLoadProgress() const;
+    /** Read whole scene file into memory, can be called from any thread */
+    static eError ReadSceneData(const FilePath& filename, Vector<uint8>& data);
     static VersionInfo::SceneVersion LoadSceneVersion(const FilePath& filename);
 
     void EnableDebugLog(bool _isDebugLogEnabled);
@@ -151,6 +174,32 @@ public:
     SceneArchive* LoadSceneArchive(const FilePath& filename); //purely load data
 
 private:
+    enum eLoadStage
+    {
+        LOAD_STAGE_DATA_NODES,
+        LOAD_STAGE_HIERARCHY,
+        LOAD_STAGE_GEOMETRY,
+        LOAD_STAGE_FINISHED
+    };
+
+    struct LoadState
+    {
+        FilePath filename;
+        Scene* scene = nullptr;
+        RefPtr<File> file;
+        eLoadStage stage = LOAD_STAGE_FINISHED;
+        int32 dataNodeCount = 0;
+        int32 dataNodesLoaded = 0;
+        int32 entitiesLoaded = 0;
+    };
+
+    eError LoadSceneHeader(const FilePath& filename, Scene* scene, File* file);
+    eError LoadGlobalMaterial(const FilePath& filename, Scene* scene, File* file);
+    eError LoadSceneGeometry(const FilePath& filename, Scene* scene, File* file);
+    void FinishLoading();
+    void PrefetchMaterialTextures();
+    void PassPrefetchedTextures(Scene* scene);
+
     static bool ReadHeader(Header& header, File* file);
     static bool ReadVersionTags(VersionInfo::SceneVersion& version, File* file);
     void AddToNodeMap(DataNode* node);
@@ -197,6 +246,8 @@ private:
     eError lastError;
 
     SerializationContext serializationContext;
+    Vector<std::shared_ptr<Texture::PrefetchedImages>> prefetchedTextures;
+    LoadState loadState;
 };
 
 }; // namespace DAVA
@@ -69,9 +69,32 @@ void SnapToLandscapeControllerSystem::Process(float32 timeElapsed)
         return;
 
     Landscape* landscape = FindLandscape(GetScene());
+    if (!landscape)
+        return;
+
+    // Moved cameras are placed on landscape by one batch query
+    snapEntities.clear();
+    snapPoints.clear();
     for (uint32 i = 0; i < size; ++i)
     {
-        SnapToLandscape(landscape, entities[i]);
+        Vector3 point;
+        if (GetPointToSnap(landscape, entities[i], false, point))
+        {
+            snapEntities.push_back(entities[i]);
+            snapPoints.push_back(point);
+        }
+    }
+
+    const uint32 snapCount = static_cast<uint32>(snapEntities.size());
+    if (0 == snapCount)
+        return;
+
+    placedPoints.resize(snapCount);
+    std::unique_ptr<bool[]> placed(new bool[snapCount]);
+    landscape->PlacePoints(snapPoints.data(), snapCount, placedPoints.data(), nullptr, placed.get());
+    for (uint32 i = 0; i < snapCount; ++i)
+    {
+        SetSnappedPosition(snapEntities[i], placedPoints[i], placed[i]);
     }
 }
 
@@ -89,6 +112,17 @@ void SnapToLandscapeControllerSystem::SnapToLandscape(Landscape* landscape, Enti
     if (!landscape)
         return;
 
+    Vector3 point;
+    if (GetPointToSnap(landscape, entity, forceSnap, point))
+    {
+        Vector3 pointOnLandscape;
+        bool placed = landscape->PlacePoint(point, pointOnLandscape);
+        SetSnappedPosition(entity, pointOnLandscape, placed);
+    }
+}
+
+bool SnapToLandscapeControllerSystem::GetPointToSnap(Landscape* landscape, Entity* entity, bool forceSnap, Vector3& point) const
+{
     SnapToLandscapeControllerComponent* snapController = GetSnapToLandscapeControllerComponent(entity);
     Camera* camera = GetCamera(entity);
     DVASSERT(snapController && camera);
@@ -96,13 +130,10 @@ void SnapToLandscapeControllerSystem::SnapToLandscape(Landscape* landscape, Enti
     if (camera && snapController)
     {
         const Vector3& pos = camera->GetPosition();
-        const Vector3& prevPos = positions[entity];
+        const Vector3& prevPos = positions.at(entity);
         if ((pos != prevPos) || forceSnap)
         {
-            const Vector3& direction = camera->GetDirection();
-
-            Vector3 placedPos = pos;
-            Vector3 pointOnLandscape = pos;
+            point = pos;
             if (pos != prevPos) //need check landscape edges only in case of position changing
             {
                 const AABBox3& landBox = landscape->GetBoundingBox();
@@ -110,22 +141,33 @@ void SnapToLandscapeControllerSystem::SnapToLandscape(Landscape* landscape, Enti
                 if ((pos.x > landBox.max.x || pos.x < landBox.min.x)
                     || (pos.y > landBox.max.y || pos.y < landBox.min.y))
                 {
-                    placedPos.x = Clamp(pos.x, landBox.min.x, landBox.max.x);
-                    placedPos.y = Clamp(pos.y, landBox.min.y, landBox.max.y);
+                    point.x = Clamp(pos.x, landBox.min.x, landBox.max.x);
+                    point.y = Clamp(pos.y, landBox.min.y, landBox.max.y);
                 }
             }
+            return true;
+        }
+    }
+    return false;
+}
 
-            bool placed = landscape->PlacePoint(placedPos, pointOnLandscape);
-            if (placed)
-            {
-                pointOnLandscape.z += snapController->GetHeightOnLandscape();
-            }
-
-            camera->SetPosition(pointOnLandscape);
-            camera->SetDirection(direction);
+void SnapToLandscapeControllerSystem::SetSnappedPosition(Entity* entity, const Vector3& pointOnLandscape, bool placed)
+{
+    SnapToLandscapeControllerComponent* snapController = GetSnapToLandscapeControllerComponent(entity);
+    Camera* camera = GetCamera(entity);
 
-            positions[entity] = pointOnLandscape;
-        }
+    // Camera keeps its position if it can't be placed on landscape
+    Vector3 position = camera->GetPosition();
+    if (placed)
+    {
+        position = pointOnLandscape;
+        position.z += snapController->GetHeightOnLandscape();
     }
+
+    const Vector3 direction = camera->GetDirection();
+    camera->SetPosition(position);
+    camera->SetDirection(direction);
+
+    positions[entity] = position;
 }
 };
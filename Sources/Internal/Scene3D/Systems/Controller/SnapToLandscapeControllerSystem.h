@@ -23,9 +23,16 @@ public:
 
 private:
     void SnapToLandscape(Landscape* landscape, Entity* entity, bool forceSnap = false);
+    /** Return true if camera of `entity` should be snapped, `point` is its position clamped by landscape bounds. */
+    bool GetPointToSnap(Landscape* landscape, Entity* entity, bool forceSnap, Vector3& point) const;
+    void SetSnappedPosition(Entity* entity, const Vector3& pointOnLandscape, bool placed);
 
     Vector<Entity*> entities;
     Map<Entity*, Vector3> positions;
+
+    Vector<Entity*> snapEntities; //!< cameras snapped in current frame
+    Vector<Vector3> snapPoints;
+    Vector<Vector3> placedPoints;
 };
 };
 
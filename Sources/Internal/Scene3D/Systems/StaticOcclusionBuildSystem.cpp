@@ -143,13 +143,20 @@ void StaticOcclusionBuildSystem::OnEntityChanged(Entity* entity)
     if (landscape)
     {
         //place on landscape
+        uint32 cellsCount = xSubdivisions * ySubdivisions;
+        Vector<Vector3> cellPoints(cellsCount);
         for (uint32 xs = 0; xs < xSubdivisions; ++xs)
             for (uint32 ys = 0; ys < ySubdivisions; ++ys)
-            {
-                Vector3 v = bbox.min + Vector3(boxSize.x * (xs + 0.5f), boxSize.y * (ys + 0.5f), 0);
-                if (landscape->PlacePoint(v, v))
-                    component->cellHeightOffset[xs + ys * xSubdivisions] = v.z - bbox.min.z;
-            }
+                cellPoints[xs + ys * xSubdivisions] = bbox.min + Vector3(boxSize.x * (xs + 0.5f), boxSize.y * (ys + 0.5f), 0);
+
+        Vector<Vector3> placedPoints(cellsCount);
+        std::unique_ptr<bool[]> placed(new bool[cellsCount]);
+        landscape->PlacePoints(cellPoints.data(), cellsCount, placedPoints.data(), nullptr, placed.get());
+        for (uint32 i = 0; i < cellsCount; ++i)
+        {
+            if (placed[i])
+                component->cellHeightOffset[i] = placedPoints[i].z - bbox.min.z;
+        }
     }
 }
 
@@ -3,7 +3,9 @@
 #include "FileSystem/FileSystem.h"
 #include "FileSystem/KeyedArchive.h"
 #include "Logger/Logger.h"
+#include "Reflection/ReflectedStructure.h"
 #include "Reflection/ReflectedTypeDB.h"
+#include "Reflection/Private/Wrappers/StructureWrapperClass.h"
 #include "Scripting/LuaException.h"
 #include "Utils/StringFormat.h"
 #include "Utils/UTF8Utils.h"
@@ -432,33 +434,338 @@ int32 Reflection__tostring(lua_State* L)
     return 1;
 }
 
+/******************************************************************************/
+
 /*
-Meta method for getting element from Reflection userdata object.
-Lua stack changes [-0, +1, v]
+Kinds of values which are pushed to Lua and set from Lua directly, without
+going through CanGet/Cast chains of AnyToLua and LuaToAny.
 */
-int32 Reflection__index(lua_State* L)
+enum eValueKind
 {
-    static const FastName VAL_KEY = FastName("_val");
-    static const FastName OBJ_KEY = FastName("_obj");
+    VALUE_OTHER,
+    VALUE_INT32,
+    VALUE_UINT32,
+    VALUE_FLOAT32,
+    VALUE_FLOAT64,
+    VALUE_BOOL,
+    VALUE_STRING,
+    VALUE_FASTNAME
+};
+
+eValueKind GetValueKind(const Type* type)
+{
+    if (type == Type::Instance<int32>())
+    {
+        return VALUE_INT32;
+    }
+    else if (type == Type::Instance<float32>())
+    {
+        return VALUE_FLOAT32;
+    }
+    else if (type == Type::Instance<bool>())
+    {
+        return VALUE_BOOL;
+    }
+    else if (type == Type::Instance<String>())
+    {
+        return VALUE_STRING;
+    }
+    else if (type == Type::Instance<FastName>())
+    {
+        return VALUE_FASTNAME;
+    }
+    else if (type == Type::Instance<uint32>())
+    {
+        return VALUE_UINT32;
+    }
+    else if (type == Type::Instance<float64>())
+    {
+        return VALUE_FLOAT64;
+    }
+    return VALUE_OTHER;
+}
 
-    Reflection* self = lua_checkdvreflection(L, 1);
+/*
+Push value of specified kind to top of the stack.
+Lua stack changes [-0, +1, -]
+*/
+void PushValueOfKind(lua_State* L, const Any& value, eValueKind kind)
+{
+    switch (kind)
+    {
+    case VALUE_INT32:
+        lua_pushinteger(L, value.Get<int32>());
+        break;
+    case VALUE_UINT32:
+        lua_pushinteger(L, value.Get<uint32>());
+        break;
+    case VALUE_FLOAT32:
+        lua_pushnumber(L, value.Get<float32>());
+        break;
+    case VALUE_FLOAT64:
+        lua_pushnumber(L, value.Get<float64>());
+        break;
+    case VALUE_BOOL:
+        lua_pushboolean(L, value.Get<bool>());
+        break;
+    case VALUE_STRING:
+    {
+        const String& str = value.Get<String>();
+        lua_pushlstring(L, str.c_str(), str.length());
+        break;
+    }
+    case VALUE_FASTNAME:
+        lua_pushstring(L, value.Get<FastName>().c_str()); // invalid FastName is pushed as nil
+        break;
+    default:
+        AnyToLua(L, value);
+        break;
+    }
+}
 
-    Any name;
-    int ltype = lua_type(L, 2);
-    switch (ltype)
+/*
+Set Lua variable with specified index to value of specified kind.
+Return false if Lua type doesn't match the kind, such value should be
+converted by LuaToAny.
+Lua stack changes [-0, +0, -]
+*/
+bool SetValueOfKind(lua_State* L, int32 index, eValueKind kind, const ValueWrapper* vw, const ReflectedObject& object)
+{
+    const int ltype = lua_type(L, index);
+    switch (kind)
     {
-    case LUA_TNUMBER:
-        name.Set(size_t(lua_tointeger(L, 2)) - 1); // -1 because in Lua first item in array has index 1
+    case VALUE_INT32:
+        if (ltype == LUA_TNUMBER)
+        {
+            vw->SetValueWithCast(object, Any(static_cast<int32>(lua_tointeger(L, index))));
+            return true;
+        }
         break;
-    case LUA_TSTRING:
-        //Logger::Debug("-----> Name: %s", lua_tostring(L, 2));
-        name.Set(FastName(lua_tostring(L, 2)));
+    case VALUE_UINT32:
+        if (ltype == LUA_TNUMBER)
+        {
+            vw->SetValueWithCast(object, Any(static_cast<uint32>(lua_tointeger(L, index))));
+            return true;
+        }
+        break;
+    case VALUE_FLOAT32:
+        if (ltype == LUA_TNUMBER)
+        {
+            vw->SetValueWithCast(object, Any(static_cast<float32>(lua_tonumber(L, index))));
+            return true;
+        }
+        break;
+    case VALUE_FLOAT64:
+        if (ltype == LUA_TNUMBER)
+        {
+            vw->SetValueWithCast(object, Any(static_cast<float64>(lua_tonumber(L, index))));
+            return true;
+        }
+        break;
+    case VALUE_BOOL:
+        if (ltype == LUA_TBOOLEAN)
+        {
+            vw->SetValueWithCast(object, Any(lua_toboolean(L, index) != 0));
+            return true;
+        }
+        break;
+    case VALUE_STRING:
+        if (ltype == LUA_TSTRING)
+        {
+            size_t length = 0;
+            const char* str = lua_tolstring(L, index, &length);
+            vw->SetValueWithCast(object, Any(String(str, length)));
+            return true;
+        }
+        break;
+    case VALUE_FASTNAME:
+        if (ltype == LUA_TSTRING)
+        {
+            vw->SetValueWithCast(object, Any(FastName(lua_tostring(L, index))));
+            return true;
+        }
         break;
     default:
-        return luaL_error(L, "Wrong key type \"%s\"!", lua_typename(L, ltype));
+        break;
+    }
+    return false;
+}
+
+/*
+Field or method of reflected class resolved by name.
+*/
+struct FieldAccessor
+{
+    enum eType
+    {
+        NOT_RESOLVED, // structure isn't a reflected class, access through Reflection
+        NOT_FOUND,
+        FIELD,
+        METHOD
+    };
+
+    eType type = NOT_RESOLVED;
+    eValueKind kind = VALUE_OTHER;
+    const ValueWrapper* valueWrapper = nullptr;
+    const ReflectedMeta* meta = nullptr;
+    const ReflectedStructure::Method* method = nullptr;
+};
+
+/*
+Cache of string keys and field accessors, one per Lua state. It is shared by
+Reflection __index and __newindex as their first upvalue.
+Lua strings are interned, so the same key always comes with the same string
+pointer. Cached key strings are referenced from anchor table (the second
+upvalue) and never collected, so their pointers can't be reused by other strings.
+*/
+struct AccessCache
+{
+    struct AccessorKey
+    {
+        const ReflectedType* type;
+        const char* key;
+
+        bool operator==(const AccessorKey& other) const
+        {
+            return type == other.type && key == other.key;
+        }
+    };
+
+    struct AccessorKeyHash
+    {
+        size_t operator()(const AccessorKey& k) const
+        {
+            return std::hash<const void*>()(k.type) ^ (std::hash<const void*>()(k.key) << 1);
+        }
+    };
+
+    // Limit for number of anchored keys, scripts building keys at runtime shouldn't grow cache infinitely
+    static const size_t maxKeysCount = 4096;
+
+    UnorderedMap<const char*, FastName> names;
+    UnorderedMap<AccessorKey, FieldAccessor, AccessorKeyHash> accessors;
+};
+
+// Access cache metatable type name
+static const char* AccessCacheTName = "ReflectionAccessCacheT";
+
+/*
+Meta method for destroying access cache.
+Lua stack changes [-0, +0, -]
+*/
+int32 AccessCache__gc(lua_State* L)
+{
+    AccessCache* cache = static_cast<AccessCache*>(lua_touserdata(L, 1));
+    cache->~AccessCache();
+    return 0;
+}
+
+/*
+Get string key with specified index as FastName. Known keys are found by
+string pointer, new keys are interned and anchored. Return false if key
+wasn't anchored and its pointer can't be used for accessors lookup.
+Lua stack changes [-0, +0, m]
+*/
+bool GetCachedKey(lua_State* L, AccessCache* cache, int32 index, const char*& key, FastName& name)
+{
+    key = lua_tostring(L, index);
+
+    auto found = cache->names.find(key);
+    if (found != cache->names.end())
+    {
+        name = found->second;
+        return true;
     }
 
-    if (name == VAL_KEY)
+    name = FastName(key);
+    if (cache->names.size() >= AccessCache::maxKeysCount)
+    {
+        return false;
+    }
+
+    lua_pushvalue(L, index);
+    lua_pushboolean(L, 1);
+    lua_rawset(L, lua_upvalueindex(2)); // anchor[key] = true
+    cache->names.emplace(key, name);
+    return true;
+}
+
+/*
+Find accessor for field or method with specified key in reflected type of object.
+Accessor is resolved once per type and key.
+Lua stack changes [-0, +0, -]
+*/
+const FieldAccessor& GetFieldAccessor(AccessCache* cache, const ReflectedObject& object, const char* key, const FastName& name)
+{
+    const AccessCache::AccessorKey accessorKey = { object.GetReflectedType(), key };
+    auto found = cache->accessors.find(accessorKey);
+    if (found != cache->accessors.end())
+    {
+        return found->second;
+    }
+
+    FieldAccessor& accessor = cache->accessors[accessorKey];
+
+    // Other structure wrappers (collections, pointers, etc.) are accessed through Reflection
+    const StructureWrapperClass* sw = dynamic_cast<const StructureWrapperClass*>(accessorKey.type->GetStrucutreWrapper());
+    if (sw != nullptr)
+    {
+        if (const ReflectedStructure::Field* field = sw->FindField(name))
+        {
+            accessor.type = FieldAccessor::FIELD;
+            accessor.valueWrapper = field->valueWrapper.get();
+            accessor.meta = field->meta.get();
+            accessor.kind = GetValueKind(accessor.valueWrapper->GetType(object));
+        }
+        else if (const ReflectedStructure::Method* method = sw->FindMethod(name))
+        {
+            accessor.type = FieldAccessor::METHOD;
+            accessor.method = method;
+        }
+        else
+        {
+            accessor.type = FieldAccessor::NOT_FOUND;
+        }
+    }
+    return accessor;
+}
+
+/*
+Push field reflection as reflection if it has fields or methods or push its value.
+Lua stack changes [-0, +1, -]
+*/
+void PushField(lua_State* L, const Reflection& refl)
+{
+    if (refl.HasFields() || refl.HasMethods())
+    {
+        lua_pushdvreflection(L, refl);
+    }
+    else
+    {
+        AnyToLua(L, refl.GetValue());
+    }
+}
+
+// Service keys for getting value and object of Reflection itself
+const FastName& GetValKey()
+{
+    static const FastName VAL_KEY = FastName("_val");
+    return VAL_KEY;
+}
+
+const FastName& GetObjKey()
+{
+    static const FastName OBJ_KEY = FastName("_obj");
+    return OBJ_KEY;
+}
+
+/*
+Get element with specified key from Reflection through generic Reflection API.
+Lua stack changes [-0, +1, v]
+*/
+int32 IndexReflection(lua_State* L, Reflection* self, const Any& name)
+{
+    if (name == GetValKey())
     {
         // If val is pointer push it as Any!!!
         // AnyToLua makes Reflection for pointers if cans
@@ -474,7 +781,7 @@ int32 Reflection__index(lua_State* L)
         return 1;
     }
 
-    if (name == OBJ_KEY)
+    if (name == GetObjKey())
     {
         const ReflectedObject& obj = self->GetValueObject();
         lua_pushdvany(L, Any(obj));
@@ -484,13 +791,7 @@ int32 Reflection__index(lua_State* L)
     Reflection refl = self->GetField(name);
     if (refl.IsValid())
     {
-        if (refl.HasFields() || refl.HasMethods())
-        {
-            lua_pushdvreflection(L, refl);
-            return 1;
-        }
-
-        AnyToLua(L, refl.GetValue());
+        PushField(L, refl);
         return 1;
     }
 
@@ -509,10 +810,11 @@ int32 Reflection__index(lua_State* L)
 }
 
 /*
-Meta method for setting value to Reflection userdata object.
-Lua stack changes [-0, +0, v]
+Meta method for getting element from Reflection userdata object.
+String keys of reflected classes go through cached field accessors.
+Lua stack changes [-0, +1, v]
 */
-int32 Reflection__newindex(lua_State* L)
+int32 Reflection__index(lua_State* L)
 {
     Reflection* self = lua_checkdvreflection(L, 1);
 
@@ -521,48 +823,141 @@ int32 Reflection__newindex(lua_State* L)
     switch (ltype)
     {
     case LUA_TNUMBER:
-        Logger::Debug("-----> Index: %s", lua_tointeger(L, 2) - 1);
         name.Set(size_t(lua_tointeger(L, 2)) - 1); // -1 because in Lua first item in array has index 1
         break;
     case LUA_TSTRING:
-        //Logger::Debug("-----> Name: %s", lua_tostring(L, 2));
-        name.Set(FastName(lua_tostring(L, 2)));
+    {
+        AccessCache* cache = static_cast<AccessCache*>(lua_touserdata(L, lua_upvalueindex(1)));
+        const char* key = nullptr;
+        FastName fieldName;
+        if (GetCachedKey(L, cache, 2, key, fieldName) && fieldName != GetValKey() && fieldName != GetObjKey() && self->IsValid())
+        {
+            const ReflectedObject object = self->GetValueObject();
+            if (object.GetReflectedType() != nullptr)
+            {
+                const FieldAccessor& accessor = GetFieldAccessor(cache, object, key, fieldName);
+                switch (accessor.type)
+                {
+                case FieldAccessor::FIELD:
+                    if (accessor.kind != VALUE_OTHER)
+                    {
+                        PushValueOfKind(L, accessor.valueWrapper->GetValue(object), accessor.kind);
+                    }
+                    else
+                    {
+                        PushField(L, Reflection(object, accessor.valueWrapper, nullptr, accessor.meta));
+                    }
+                    return 1;
+                case FieldAccessor::METHOD:
+                    lua_pushdvanyfn(L, accessor.method->fn.BindThis(object.GetVoidPtr()));
+                    return 1;
+                case FieldAccessor::NOT_FOUND:
+                    lua_pushnil(L);
+                    return 1;
+                default:
+                    break;
+                }
+            }
+        }
+        name.Set(fieldName);
         break;
+    }
     default:
         return luaL_error(L, "Wrong key type \"%s\"!", lua_typename(L, ltype));
     }
 
-    Reflection refl = self->GetField(name);
+    return IndexReflection(L, self, name);
+}
+
+/*
+Set value to field of Reflection.
+Lua stack changes [-0, +0, e]
+*/
+void SetReflectionField(lua_State* L, Reflection* self, const Any& name, const Reflection& refl)
+{
     Reflection* valRef = lua_todvreflection(L, 3);
 
-    try
+    if (refl.IsValid())
     {
-        if (refl.IsValid())
+        if (valRef && valRef->IsValid())
         {
-            if (valRef && valRef->IsValid())
-            {
-                const Any& value = valRef->GetValue();
-                refl.SetValueWithCast(value);
-            }
-            else
-            {
-                const Any& value = LuaToAny(L, 3, refl.GetValueType());
-                refl.SetValueWithCast(value);
-            }
+            const Any& value = valRef->GetValue();
+            refl.SetValueWithCast(value);
         }
-        else if (self->GetFieldsCaps().canAddField)
+        else
+        {
+            const Any& value = LuaToAny(L, 3, refl.GetValueType());
+            refl.SetValueWithCast(value);
+        }
+    }
+    else if (self->GetFieldsCaps().canAddField)
+    {
+        if (valRef && valRef->IsValid())
+        {
+            const Any& value = valRef->GetValue();
+            self->AddField(name, value);
+        }
+        else
+        {
+            const Any& value = LuaToAny(L, 3);
+            self->AddField(name, value);
+        }
+    }
+}
+
+/*
+Meta method for setting value to Reflection userdata object.
+String keys of reflected classes go through cached field accessors.
+Lua stack changes [-0, +0, v]
+*/
+int32 Reflection__newindex(lua_State* L)
+{
+    Reflection* self = lua_checkdvreflection(L, 1);
+
+    Any name;
+    const FieldAccessor* accessor = nullptr;
+    ReflectedObject object;
+
+    int ltype = lua_type(L, 2);
+    switch (ltype)
+    {
+    case LUA_TNUMBER:
+        name.Set(size_t(lua_tointeger(L, 2)) - 1); // -1 because in Lua first item in array has index 1
+        break;
+    case LUA_TSTRING:
+    {
+        AccessCache* cache = static_cast<AccessCache*>(lua_touserdata(L, lua_upvalueindex(1)));
+        const char* key = nullptr;
+        FastName fieldName;
+        if (GetCachedKey(L, cache, 2, key, fieldName) && self->IsValid())
         {
-            if (valRef && valRef->IsValid())
+            object = self->GetValueObject();
+            if (object.GetReflectedType() != nullptr)
             {
-                const Any& value = valRef->GetValue();
-                self->AddField(name, value);
+                accessor = &GetFieldAccessor(cache, object, key, fieldName);
             }
-            else
+        }
+        name.Set(fieldName);
+        break;
+    }
+    default:
+        return luaL_error(L, "Wrong key type \"%s\"!", lua_typename(L, ltype));
+    }
+
+    try
+    {
+        if (accessor == nullptr || accessor->type == FieldAccessor::NOT_RESOLVED)
+        {
+            SetReflectionField(L, self, name, self->GetField(name));
+        }
+        else if (accessor->type == FieldAccessor::FIELD)
+        {
+            if (!SetValueOfKind(L, 3, accessor->kind, accessor->valueWrapper, object))
             {
-                const Any& value = LuaToAny(L, 3);
-                self->AddField(name, value);
+                SetReflectionField(L, self, name, Reflection(object, accessor->valueWrapper, nullptr, accessor->meta));
             }
         }
+        // Methods and unknown keys can't be set, reflected classes can't add fields
     }
     catch (const std::exception& e)
     {
@@ -578,15 +973,29 @@ int32 Reflection__newindex(lua_State* L)
 
 void RegisterReflection(lua_State* L)
 {
-    static const luaL_reg Reflection_meta[] = {
-        { "__tostring", &Reflection__tostring },
-        { "__index", &Reflection__index },
-        { "__newindex", &Reflection__newindex },
-        { nullptr, nullptr }
-    };
+    luaL_newmetatable(L, AccessCacheTName);
+    lua_pushcfunction(L, &AccessCache__gc);
+    lua_setfield(L, -2, "__gc");
+    lua_pop(L, 1);
 
     luaL_newmetatable(L, ReflectionTName);
-    luaL_register(L, 0, Reflection_meta);
+    lua_pushcfunction(L, &Reflection__tostring);
+    lua_setfield(L, -2, "__tostring");
+
+    // __index and __newindex share access cache and its anchor table as upvalues
+    void* userdata = lua_newuserdata(L, sizeof(AccessCache));
+    DVASSERT(userdata, "Can't create AccessCache ptr");
+    new (userdata) AccessCache();
+    luaL_getmetatable(L, AccessCacheTName);
+    lua_setmetatable(L, -2);
+    lua_newtable(L);
+
+    lua_pushvalue(L, -2);
+    lua_pushvalue(L, -2);
+    lua_pushcclosure(L, &Reflection__index, 2);
+    lua_setfield(L, -4, "__index");
+    lua_pushcclosure(L, &Reflection__newindex, 2);
+    lua_setfield(L, -2, "__newindex");
     lua_pop(L, 1);
 }
 
@@ -824,10 +1233,15 @@ void AnyToLua(lua_State* L, const Any& value)
 #define IFPUSH(t, luaFn) if CANGET(t) { luaFn(L, value.Get<t>()); }
 #define IFPUSH_WITH_CAST(t, luaFn, luaType) if CANGET(t) { luaFn(L, static_cast<luaType>(value.Get<t>())); }
 
+    const eValueKind kind = value.IsEmpty() ? VALUE_OTHER : GetValueKind(value.GetType());
     if (value.IsEmpty())
     {
         lua_pushnil(L); // Push nil if any is empty
     }
+    else if (kind != VALUE_OTHER)
+    {
+        PushValueOfKind(L, value, kind); // Most common types are pushed without CanGet checks
+    }
     else IFPUSH(int8, lua_pushinteger)
     else IFPUSH(int16, lua_pushinteger)
     else IFPUSH(int32, lua_pushinteger)
@@ -10,6 +10,7 @@
 
 #include "UI/Formula/Private/FormulaExpression.h"
 #include "UI/Formula/Private/FormulaParser.h"
+#include "UI/Formula/Private/FormulaCompiler.h"
 #include "UI/Formula/Private/FormulaExecutor.h"
 #include "UI/Formula/Private/FormulaFormatter.h"
 
@@ -35,6 +36,15 @@ UIComponent* UIDataBinding::GetComponent() const
     return component;
 }
 
+bool UIDataBinding::IsReadRequired(const UIDataBindingDependenciesManager* dependenciesManager) const
+{
+    if (component->IsDirty())
+    {
+        return true;
+    }
+    return expression.get() && component->GetUpdateMode() != UIDataBindingComponent::MODE_WRITE && (parent->IsDirty() || dependenciesManager->IsDirty(dependencyId));
+}
+
 void UIDataBinding::ProcessReadFromModel(UIDataBindingDependenciesManager* dependenciesManager)
 {
     bool hasToResetError = false;
@@ -82,7 +92,7 @@ void UIDataBinding::ProcessReadFromModel(UIDataBindingDependenciesManager* depen
         FormulaParser parser(component->GetBindingExpression());
         try
         {
-            expression = parser.ParseExpression();
+            expression = FormulaCompiler().Compile(parser.ParseExpression());
         }
         catch (const FormulaException& error)
         {
@@ -18,6 +18,7 @@ public:
 
     UIComponent* GetComponent() const override;
 
+    bool IsReadRequired(const UIDataBindingDependenciesManager* dependenciesManager) const;
     void ProcessReadFromModel(UIDataBindingDependenciesManager* dependenciesManager);
     bool ProcessWriteToModel(UIDataBindingDependenciesManager* dependenciesManager);
 
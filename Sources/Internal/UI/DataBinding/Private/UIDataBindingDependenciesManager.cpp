@@ -2,6 +2,8 @@
 
 #include "Debug/DVAssert.h"
 
+#include <algorithm>
+
 namespace DAVA
 {
 UIDataBindingDependenciesManager::UIDataBindingDependenciesManager()
@@ -21,6 +23,22 @@ int32 UIDataBindingDependenciesManager::MakeDependency(int32 id, const Vector<vo
     }
     else
     {
+        // bindings usually depend on the same data after re-evaluation, don't rebuild maps in this case
+        auto it = bindingDependencies.find(id);
+        if (it != bindingDependencies.end() && it->second.size() <= data.size())
+        {
+            const Vector<void*>& current = it->second;
+            auto contains = [](const Vector<void*>& v, void* d) {
+                return std::find(v.begin(), v.end(), d) != v.end();
+            };
+            bool same = std::all_of(data.begin(), data.end(), [&](void* d) { return contains(current, d); }) &&
+            std::all_of(current.begin(), current.end(), [&](void* d) { return contains(data, d); });
+            if (same)
+            {
+                dirtyBindings[id] = false;
+                return id;
+            }
+        }
         ReleaseDepencency(id);
     }
 
@@ -34,47 +52,38 @@ void UIDataBindingDependenciesManager::AddDependencies(int32 id, const Vector<vo
     DVASSERT(id != UNKNOWN_DEPENDENCY);
     DVASSERT(dirtyBindings.find(id) != dirtyBindings.end());
 
+    Vector<void*>& bindingData = bindingDependencies[id];
     for (void* d : data)
     {
-        auto it = dirtyMap.find(d);
-        if (it == dirtyMap.end())
-        {
-            dirtyMap[d] = Vector<int>();
-            it = dirtyMap.find(d);
-        }
-
-        bool haveToAddId = std::find(it->second.begin(), it->second.end(), id) == it->second.end();
+        Vector<int32>& ids = dirtyMap[d];
+        bool haveToAddId = std::find(ids.begin(), ids.end(), id) == ids.end();
         if (haveToAddId)
         {
-            it->second.push_back(id);
+            ids.push_back(id);
+            bindingData.push_back(d);
         }
     }
 }
 
 void UIDataBindingDependenciesManager::ReleaseDepencency(int32 index)
 {
-    for (auto mapIt = dirtyMap.begin(); mapIt != dirtyMap.end();)
+    auto depsIt = bindingDependencies.find(index);
+    if (depsIt != bindingDependencies.end())
     {
-        Vector<int>& v = mapIt->second;
-        auto it = std::find(v.begin(), v.end(), index);
-        bool haveToErase = false;
-        if (it != v.end())
+        for (void* d : depsIt->second)
         {
-            v.erase(it);
-            if (v.empty())
+            auto mapIt = dirtyMap.find(d);
+            if (mapIt != dirtyMap.end())
             {
-                haveToErase = true;
+                Vector<int32>& v = mapIt->second;
+                v.erase(std::remove(v.begin(), v.end(), index), v.end());
+                if (v.empty())
+                {
+                    dirtyMap.erase(mapIt);
+                }
             }
         }
-
-        if (haveToErase)
-        {
-            mapIt = dirtyMap.erase(mapIt);
-        }
-        else
-        {
-            ++mapIt;
-        }
+        bindingDependencies.erase(depsIt);
     }
 
     auto it = dirtyBindings.find(index);
@@ -93,20 +102,37 @@ void UIDataBindingDependenciesManager::SetDirty(void* data)
         {
             dirtyBindings[id] = true;
         }
+        hasDirties = hasDirties || !it->second.empty();
     }
 }
 
 bool UIDataBindingDependenciesManager::IsDirty(int32 index) const
 {
+    if (!hasDirties)
+    {
+        return false;
+    }
+
     auto it = dirtyBindings.find(index);
     return it != dirtyBindings.end() && it->second;
 }
 
+bool UIDataBindingDependenciesManager::HasDirties() const
+{
+    return hasDirties;
+}
+
 void UIDataBindingDependenciesManager::ResetDirties()
 {
+    if (!hasDirties)
+    {
+        return;
+    }
+
     for (auto& it : dirtyBindings)
     {
         it.second = false;
     }
+    hasDirties = false;
 }
 }
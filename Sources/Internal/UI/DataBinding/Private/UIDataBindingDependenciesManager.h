@@ -18,11 +18,14 @@ public:
     void ReleaseDepencency(int32 index);
     void SetDirty(void* data);
     bool IsDirty(int32 index) const;
+    bool HasDirties() const;
     void ResetDirties();
 
 private:
     UnorderedMap<int32, bool> dirtyBindings;
     UnorderedMap<void*, Vector<int32>> dirtyMap;
+    UnorderedMap<int32, Vector<void*>> bindingDependencies; // unique data pointers of each binding
     int32 nextId = 0;
+    bool hasDirties = false;
 };
 }
@@ -114,39 +114,65 @@ void UIDataBindingSystem::UnregisterComponent(UIControl* control, UIComponent* c
 
 void UIDataBindingSystem::Process(float32 elapsedTime)
 {
+    statistics = Statistics();
+
     for (const std::shared_ptr<UIDataModel>& model : dataModels)
     {
         model->MarkAsUnprocessed();
     }
 
-    hasUnprocessedModels = true;
-
+    // Models are sorted by order, so parent models are processed before their children,
+    // there is no other dependency tracking between models. Models skip processing by themselves
+    // if nothing they depend on is dirty. Processing of lists and factories may add or remove
+    // models, in this case pass continues after current model or from first changed position
+    // if it is earlier.
     Vector<std::shared_ptr<UIDataModel>> processedModels;
-    while (hasUnprocessedModels)
+    bool modelsMayBeRemoved = false;
+    modelsChanged = false;
+    size_t i = 0;
+    while (i < dataModels.size())
     {
-        hasUnprocessedModels = false;
-        Vector<std::shared_ptr<UIDataModel>> copy = dataModels;
-        for (const std::shared_ptr<UIDataModel>& model : copy)
+        std::shared_ptr<UIDataModel> model = dataModels[i];
+        if (model->Process(dependenciesManager.get()))
+        {
+            processedModels.push_back(model);
+        }
+        DVASSERT(model->GetFormulaContext() != nullptr);
+        ++i;
+
+        if (modelsChanged)
         {
-            if (std::find(dataModels.begin(), dataModels.end(), model) != dataModels.end())
+            modelsChanged = false;
+            modelsMayBeRemoved = true;
+            if (i > dataModels.size() || dataModels[i - 1] != model)
             {
-                if (model->Process(dependenciesManager.get()))
-                {
-                    processedModels.push_back(model);
-                }
-                DVASSERT(model->GetFormulaContext() != nullptr);
+                // current model is shifted or removed
+                auto it = std::find(dataModels.begin(), dataModels.end(), model);
+                i = (it != dataModels.end()) ? static_cast<size_t>(it - dataModels.begin()) + 1 : firstChangedModel;
             }
+            i = std::min(i, firstChangedModel);
         }
     }
+    statistics.processedModels = static_cast<uint32>(processedModels.size());
 
     for (const std::shared_ptr<UIDataBinding>& binding : dataBindings)
     {
-        binding->ProcessReadFromModel(dependenciesManager.get());
+        if (binding->IsReadRequired(dependenciesManager.get()))
+        {
+            binding->ProcessReadFromModel(dependenciesManager.get());
+            statistics.evaluatedBindings++;
+        }
+        else
+        {
+            statistics.skippedBindings++;
+        }
     }
 
+    // processed models may be removed by lists, bindings or signal handlers
     for (const std::shared_ptr<UIDataModel>& model : processedModels)
     {
-        if (std::find(dataModels.begin(), dataModels.end(), model) != dataModels.end())
+        modelsMayBeRemoved = modelsMayBeRemoved || modelsChanged;
+        if (!modelsMayBeRemoved || std::find(dataModels.begin(), dataModels.end(), model) != dataModels.end())
         {
             onDataModelProcessed.Emit(model->GetComponent()->GetControl(), model->GetComponent());
         }
@@ -192,6 +218,11 @@ void UIDataBindingSystem::SetEditorMode(bool editorMode_)
     editorMode = editorMode_;
 }
 
+const UIDataBindingSystem::Statistics& UIDataBindingSystem::GetStatistics() const
+{
+    return statistics;
+}
+
 void UIDataBindingSystem::RegisterDataBinding(UIDataBindingComponent* component)
 {
     component->SetDirty(true);
@@ -265,21 +296,30 @@ void UIDataBindingSystem::TryToCreateDataModel(UIControl* control, UIComponent*
 
         if (!modelAlreadyCreated)
         {
-            dataModels.push_back(UIDataModel::Create(component, control->GetComponentIndex(component), editorMode));
-            UIDataModel* model = dataModels.back().get();
+            std::shared_ptr<UIDataModel> newModel = UIDataModel::Create(component, control->GetComponentIndex(component), editorMode);
+            UIDataModel* model = newModel.get();
             model->SetIssueDelegate(issueDelegate);
 
-            std::stable_sort(dataModels.begin(), dataModels.end(), [](const std::shared_ptr<UIDataModel>& m1, const std::shared_ptr<UIDataModel>& m2) {
-                return m1->GetOrder() < m2->GetOrder();
+            // insert after models with the same order, as if models were stable sorted
+            auto pos = std::upper_bound(dataModels.begin(), dataModels.end(), model->GetOrder(), [](int32 order, const std::shared_ptr<UIDataModel>& m) {
+                return order < m->GetOrder();
             });
+            const size_t index = static_cast<size_t>(pos - dataModels.begin());
+            dataModels.insert(pos, std::move(newModel));
 
             model->SetParent(FindParentModel(component));
             UpdateDependentModelsAndBindings(model->GetParent());
-            hasUnprocessedModels = true;
+            NotifyModelsChanged(index);
         }
     }
 }
 
+void UIDataBindingSystem::NotifyModelsChanged(size_t index)
+{
+    firstChangedModel = modelsChanged ? std::min(firstChangedModel, index) : index;
+    modelsChanged = true;
+}
+
 void UIDataBindingSystem::DeleteDataModel(UIComponent* component)
 {
     if (component == nullptr)
@@ -293,6 +333,7 @@ void UIDataBindingSystem::DeleteDataModel(UIComponent* component)
     if (it != dataModels.end())
     {
         std::shared_ptr<UIDataModel> model = *it;
+        NotifyModelsChanged(static_cast<size_t>(it - dataModels.begin()));
         dataModels.erase(it);
 
         model->GetParent()->SetDirty();
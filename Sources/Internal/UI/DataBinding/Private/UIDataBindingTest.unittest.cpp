@@ -203,6 +203,41 @@ DAVA_TESTCLASS (UIDataBindingTest)
         TEST_VERIFY(context->FindReflection("a").IsValid());
     }
 
+    DAVA_TEST (IncrementalProcessTest)
+    {
+        UIDataBindingComponent* bindComp = text->GetOrCreateComponent<UIDataBindingComponent>();
+        bindComp->SetUpdateMode(UIDataBindingComponent::MODE_READ);
+        bindComp->SetControlFieldName("UITextComponent.text");
+        bindComp->SetBindingExpression("a + b");
+
+        UIDataBindingSystem* sys = GetEngineContext()->uiControlSystem->GetSystem<UIDataBindingSystem>();
+        UIDataBindingPostProcessingSystem* postSys = GetEngineContext()->uiControlSystem->GetSystem<UIDataBindingPostProcessingSystem>();
+        sys->Process(0.0f);
+        postSys->Process(0.0f);
+
+        TEST_VERIFY(text->GetUtf8Text() == "357");
+        TEST_VERIFY(sys->GetStatistics().evaluatedBindings == 1);
+
+        // nothing changed
+        sys->Process(0.0f);
+        postSys->Process(0.0f);
+        TEST_VERIFY(sys->GetStatistics().processedModels == 0);
+        TEST_VERIFY(sys->GetStatistics().evaluatedBindings == 0);
+        TEST_VERIFY(sys->GetStatistics().skippedBindings == 1);
+
+        data.a = 1;
+        sys->SetDataDirty(&data);
+        sys->Process(0.0f);
+        postSys->Process(0.0f);
+        TEST_VERIFY(text->GetUtf8Text() == "235");
+        TEST_VERIFY(sys->GetStatistics().evaluatedBindings == 1);
+
+        data.a = 123;
+        sys->SetDataDirty(&data);
+        sys->Process(0.0f);
+        postSys->Process(0.0f);
+    }
+
     DAVA_TEST (BindingListTest)
     {
         UIDataListComponent* listComp = list->GetOrCreateComponent<UIDataListComponent>();
@@ -5,6 +5,7 @@
 
 #include "UI/Formula/Private/FormulaExpression.h"
 #include "UI/Formula/Private/FormulaParser.h"
+#include "UI/Formula/Private/FormulaCompiler.h"
 #include "UI/Formula/Private/FormulaExecutor.h"
 
 #include "UI/UIControl.h"
@@ -66,10 +67,10 @@ bool UIDataChildFactory::Process(UIDataBindingDependenciesManager* dependenciesM
             try
             {
                 FormulaParser packageParser(component->GetPackageExpression());
-                packageExpression = packageParser.ParseExpression();
+                packageExpression = FormulaCompiler().Compile(packageParser.ParseExpression());
 
                 FormulaParser controlParser(component->GetControlExpression());
-                controlExpression = controlParser.ParseExpression();
+                controlExpression = FormulaCompiler().Compile(controlParser.ParseExpression());
             }
             catch (const FormulaException& error)
             {
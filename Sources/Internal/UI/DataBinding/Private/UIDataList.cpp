@@ -9,6 +9,7 @@
 
 #include "UI/Formula/Private/FormulaExpression.h"
 #include "UI/Formula/Private/FormulaParser.h"
+#include "UI/Formula/Private/FormulaCompiler.h"
 #include "UI/Formula/Private/FormulaExecutor.h"
 #include "UI/Formula/FormulaContext.h"
 
@@ -164,7 +165,7 @@ bool UIDataList::Process(UIDataBindingDependenciesManager* dependenciesManager)
             try
             {
                 FormulaParser parser(component->GetDataContainer());
-                expression = parser.ParseExpression();
+                expression = FormulaCompiler().Compile(parser.ParseExpression());
             }
             catch (const FormulaException& error)
             {
@@ -5,6 +5,7 @@
 #include "UI/Formula/FormulaContext.h"
 #include "UI/Formula/Private/FormulaException.h"
 #include "UI/Formula/Private/FormulaParser.h"
+#include "UI/Formula/Private/FormulaCompiler.h"
 #include "UI/Formula/Private/FormulaExecutor.h"
 #include "UI/UIControl.h"
 
@@ -118,7 +119,7 @@ void UIDataSource::ReadDataFromExpression(UIDataBindingDependenciesManager* depe
 
         try
         {
-            expression = parser.ParseExpression();
+            expression = FormulaCompiler().Compile(parser.ParseExpression());
         }
         catch (const FormulaException& error)
         {
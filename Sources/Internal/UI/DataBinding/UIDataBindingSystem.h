@@ -25,6 +25,14 @@ class UIDataChildFactory;
 class UIDataBindingSystem : public UISystem
 {
 public:
+    /** Counters of the last `Process` call */
+    struct Statistics
+    {
+        uint32 processedModels = 0;
+        uint32 evaluatedBindings = 0;
+        uint32 skippedBindings = 0;
+    };
+
     UIDataBindingSystem();
     virtual ~UIDataBindingSystem();
 
@@ -43,6 +51,8 @@ public:
     void SetIssueDelegate(UIDataBindingIssueDelegate* issueDelegate);
     void SetEditorMode(bool editorMode);
 
+    const Statistics& GetStatistics() const;
+
     Signal<UIControl*, UIComponent*> onDataModelProcessed;
     Signal<UIControl*, UIComponent*> onValueWrittenToModel;
 
@@ -59,13 +69,16 @@ private:
     void TryToCreateDataModel(UIControl* control, UIComponent* component);
 
     void DeleteDataModel(UIComponent* component);
+    void NotifyModelsChanged(size_t index);
 
     UIDataModel* FindParentModel(UIComponent* control) const;
     UIDataModel* FindParentModel(UIControl* control) const;
 
     Vector<std::shared_ptr<UIDataModel>> dataModels;
     Vector<std::shared_ptr<UIDataBinding>> dataBindings;
-    bool hasUnprocessedModels = false;
+    bool modelsChanged = false;
+    size_t firstChangedModel = 0; // index of first model added or removed since modelsChanged was set
+    Statistics statistics;
 
     std::unique_ptr<UIDataBindingDependenciesManager> dependenciesManager;
 
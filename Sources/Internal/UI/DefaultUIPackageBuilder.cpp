@@ -130,8 +130,7 @@ bool DefaultUIPackageBuilder::ProcessImportedPackage(const String& packagePath,
         std::unique_ptr<DefaultUIPackageBuilder> builder = CreateBuilder(cache.Get());
         if (loader->LoadPackage(packagePath, builder.get()) && builder->GetPackage())
         {
-            importedPackage = builder->GetPackage();
-            cache->PutPackage(packagePath, importedPackage);
+            importedPackage = cache->PutPackage(packagePath, RefPtr<UIPackage>::ConstructWithRetain(builder->GetPackage()));
         }
     }
 
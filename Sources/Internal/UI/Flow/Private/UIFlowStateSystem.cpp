@@ -392,6 +392,22 @@ void UIFlowStateSystem::StartActivation(UIFlowStateComponent* state)
     links[state].status = StateLink::Initted;
 }
 
+bool UIFlowStateSystem::PreloadStateView(UIFlowStateComponent* state, const Function<void()>& onLoaded)
+{
+    if (IsStateLoaded(state))
+    {
+        return false;
+    }
+
+    UIFlowViewSystem* viewSys = GetScene()->GetSystem<UIFlowViewSystem>();
+    UIFlowViewComponent* viewComponent = state->GetControl()->GetComponent<UIFlowViewComponent>();
+    if (viewComponent && viewSys)
+    {
+        return viewSys->PreloadView(viewComponent, onLoaded);
+    }
+    return false;
+}
+
 void UIFlowStateSystem::ProcessActivation(UIFlowStateComponent* state)
 {
     if (IsStateLoaded(state))
@@ -440,9 +440,29 @@ void UIFlowTransitionTransaction::ApplyStepBackground(UIFlowStateSystem* system,
         case State::Load:
             if (activateIt != activateQueue.end())
             {
+                // View package is read and parsed by workers and built on main thread,
+                // so loading thread only clones view from it in next frames
+                if (!isViewPreloaded)
+                {
+                    isViewPreloaded = true;
+                    bool waitView = system->PreloadStateView(*activateIt, [=]() {
+                        if (autoNext)
+                        {
+                            GetEngineContext()->jobManager->CreateMainJob([=]() {
+                                ApplyStepBackground(system, true);
+                            });
+                        }
+                    });
+                    if (waitView)
+                    {
+                        return; // break loop until view package is loaded
+                    }
+                }
+
                 thread = StartThread([=]() {
                     system->ProcessActivation(*activateIt);
                     activateIt++;
+                    isViewPreloaded = false;
                     if (autoNext)
                     {
                         GetEngineContext()->jobManager->CreateMainJob([=]() {
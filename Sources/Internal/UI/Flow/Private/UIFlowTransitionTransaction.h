@@ -96,6 +96,7 @@ private:
 
     bool isBackgroundLoading = false;
     RefPtr<Thread> thread;
+    bool isViewPreloaded = false; //!< view of current loading state is requested from packages cache
 
     std::unique_ptr<UIFlowTransitionEffect> effect;
 
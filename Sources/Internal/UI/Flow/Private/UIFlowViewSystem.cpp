@@ -1,21 +1,28 @@
 #include "UI/Flow/UIFlowViewSystem.h"
+#include "Base/RefPtrUtils.h"
 #include "Base/TemplateHelpers.h"
+#include "Concurrency/LockGuard.h"
 #include "Engine/Engine.h"
 #include "Engine/EngineContext.h"
 #include "FileSystem/KeyedArchive.h"
 #include "Logger/Logger.h"
 #include "Reflection/ReflectedTypeDB.h"
 #include "UI/DataBinding/UIDataSourceComponent.h"
-#include "UI/DefaultUIPackageBuilder.h"
 #include "UI/Flow/UIFlowContext.h"
 #include "UI/Flow/UIFlowViewComponent.h"
 #include "UI/UIControl.h"
 #include "UI/UIControlSystem.h"
-#include "UI/UIPackageLoader.h"
+#include "UI/UIPackage.h"
+#include "UI/UIPackagesCache.h"
 #include "UI/UIScreen.h"
 
 namespace DAVA
 {
+UIFlowViewSystem::UIFlowViewSystem()
+    : packagesCache(MakeRef<UIPackagesCache>())
+{
+}
+
 UIFlowViewSystem::~UIFlowViewSystem() = default;
 
 void UIFlowViewSystem::RegisterControl(UIControl* control)
@@ -91,6 +98,38 @@ void UIFlowViewSystem::RemoveViewLink(UIFlowViewComponent* component)
 {
     auto it = std::remove_if(links.begin(), links.end(), [&](const ViewLink& l) { return l.component == component; });
     links.erase(it, links.end());
+
+    // Flow screen is unloaded, so cached view templates aren't needed anymore.
+    // Requests in progress and views being loaded keep old cache alive until they are finished.
+    if (links.empty())
+    {
+        RefPtr<UIPackagesCache> newCache = MakeRef<UIPackagesCache>();
+        LockGuard<Mutex> lock(packagesCacheMutex);
+        packagesCache.Swap(newCache);
+    }
+}
+
+RefPtr<UIPackagesCache> UIFlowViewSystem::GetPackagesCache() const
+{
+    LockGuard<Mutex> lock(packagesCacheMutex);
+    return packagesCache;
+}
+
+bool UIFlowViewSystem::PreloadView(UIFlowViewComponent* component, const Function<void()>& onLoaded)
+{
+    const FilePath& yamlPath = component->GetViewYaml();
+    if (!yamlPath.IsEmpty() && yamlPath.Exists())
+    {
+        RefPtr<UIPackagesCache> cache = GetPackagesCache();
+        if (!cache->GetPackage(yamlPath.GetFrameworkPath()))
+        {
+            cache->RequestPackage(yamlPath, [onLoaded](const RefPtr<UIPackage>&) {
+                onLoaded();
+            });
+            return true;
+        }
+    }
+    return false;
 }
 
 UIControl* UIFlowViewSystem::InitView(UIFlowViewComponent* component, UIFlowContext* context)
@@ -106,20 +145,8 @@ UIControl* UIFlowViewSystem::InitView(UIFlowViewComponent* component, UIFlowCont
         {
             if (yamlPath.Exists())
             {
-                DAVA::DefaultUIPackageBuilder pkgBuilder;
-                DAVA::UIPackageLoader().LoadPackage(yamlPath, &pkgBuilder);
-
-                UIControl* root = nullptr;
-                if (!controlName.empty())
-                {
-                    root = pkgBuilder.GetPackage()->GetControl(controlName);
-                }
-                else if (!pkgBuilder.GetPackage()->GetControls().empty())
-                {
-                    root = pkgBuilder.GetPackage()->GetControls().front().Get();
-                }
-
-                if (root != nullptr)
+                RefPtr<UIControl> root = GetPackagesCache()->CreateControl(yamlPath, controlName);
+                if (root.Valid())
                 {
                     if (!component->GetModelName().empty())
                     {
@@ -141,7 +168,7 @@ UIControl* UIFlowViewSystem::InitView(UIFlowViewComponent* component, UIFlowCont
 
                     // Update link
                     it->view = root;
-                    return root;
+                    return root.Get();
                 }
                 else
                 {
@@ -3,6 +3,7 @@
 #include "Base/FastName.h"
 #include "Base/UnordererMap.h"
 #include "Base/List.h"
+#include "Functional/Function.h"
 #include "UI/UISystem.h"
 
 namespace DAVA
@@ -119,6 +120,9 @@ private:
     /** First step of state activation.
         Includes context setup, controller initialization. */
     void StartActivation(UIFlowStateComponent* state);
+    /** Start loading of state view package by workers before second step of activation.
+        Return true if package isn't loaded yet, `onLoaded` is called on main thread when it is ready. */
+    bool PreloadStateView(UIFlowStateComponent* state, const Function<void()>& onLoaded);
     /** Second step of state activation.
         Includes loading view and loading resources from controller.
         Can be executed not in main thread. */
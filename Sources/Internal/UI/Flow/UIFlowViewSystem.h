@@ -2,6 +2,8 @@
 
 #include "Base/Vector.h"
 #include "Base/RefPtr.h"
+#include "Concurrency/Mutex.h"
+#include "Functional/Function.h"
 #include "UI/UISystem.h"
 
 namespace DAVA
@@ -9,6 +11,7 @@ namespace DAVA
 class UIFlowContext;
 class UIControl;
 class UIFlowViewComponent;
+class UIPackagesCache;
 
 /**
     Manage all UIFlowViewComponents and control screens.
@@ -16,6 +19,7 @@ class UIFlowViewComponent;
 class UIFlowViewSystem final : public UISystem
 {
 public:
+    UIFlowViewSystem();
     ~UIFlowViewSystem() override;
 
     /** Return pointer to UIFlowViewComponent by specified UIControl view. */
@@ -39,12 +43,20 @@ private:
         RefPtr<UIControl> view;
     };
     Vector<ViewLink> links;
+    RefPtr<UIPackagesCache> packagesCache; //!< loaded view packages, views are cloned from them; dropped when all views are unregistered
+    mutable Mutex packagesCacheMutex; //!< views are loaded by flow loading thread while cache can be dropped on main thread
+
+    /** Return current packages cache, returned reference keeps it alive while it is used. */
+    RefPtr<UIPackagesCache> GetPackagesCache() const;
 
     /** Add new link with specified UIFlowViewComponent to system. */
     void AddViewLink(UIFlowViewComponent* component);
     /** Remove link with specified UIFlowViewComponent to system. */
     void RemoveViewLink(UIFlowViewComponent* component);
 
+    /** Start loading of view package in background using information from UIFlowViewComponent.
+        Return true if package isn't loaded yet, `onLoaded` is called on main thread when it is ready. */
+    bool PreloadView(UIFlowViewComponent* component, const Function<void()>& onLoaded);
     /** Load new UIControl using information from UIFlowViewComponent. */
     UIControl* InitView(UIFlowViewComponent* component, UIFlowContext* context);
     /** Release UIControl linked with specified UIFlowViewComponent. */
@@ -63,6 +63,7 @@ public:
 
 private:
     std::shared_ptr<FormulaExpression> exp;
+    std::shared_ptr<FormulaExpression> compiledExp;
 
     String parsingError;
     String calculationError;
@@ -17,13 +17,27 @@ public:
     virtual ~FormulaContext();
 
     Reflection FindReflection(const String& name) const;
+    Reflection FindReflection(const FastName& name) const;
 
     virtual AnyFn FindFunction(const String& name, const Vector<const Type*>& types) const = 0;
     virtual Reflection FindReflectionLocal(const String& name) const = 0;
+
+    /**
+     Finds data by already interned name. Default implementation falls back to
+     lookup by string.
+     */
+    virtual Reflection FindReflectionLocal(const FastName& name) const;
     const std::shared_ptr<FormulaContext>& GetParent() const;
 
+    /**
+     Unique identifier of context instance. Data models create new context when their
+     data changes, so compiled expressions use it to check that cached data is still valid.
+     */
+    uint64 GetId() const;
+
 private:
     std::shared_ptr<FormulaContext> parent;
+    uint64 id = 0;
 };
 
 /**
@@ -39,6 +53,7 @@ public:
 
     AnyFn FindFunction(const String& name, const Vector<const Type*>& types) const override;
     Reflection FindReflectionLocal(const String& name) const override;
+    Reflection FindReflectionLocal(const FastName& name) const override;
 
     const Reflection& GetReflection() const;
 
@@ -61,6 +76,7 @@ public:
 
     AnyFn FindFunction(const String& name, const Vector<const Type*>& types) const override;
     Reflection FindReflectionLocal(const String& name) const override;
+    Reflection FindReflectionLocal(const FastName& name) const override;
 
     void RegisterFunction(const String& name, const AnyFn& fn);
 
@@ -1,5 +1,6 @@
 #include "UI/Formula/Formula.h"
 
+#include "UI/Formula/Private/FormulaCompiler.h"
 #include "UI/Formula/Private/FormulaParser.h"
 #include "UI/Formula/Private/FormulaExecutor.h"
 #include "UI/Formula/Private/FormulaFormatter.h"
@@ -22,6 +23,7 @@ bool Formula::Parse(const String& str)
     {
         FormulaParser parser(str);
         exp = parser.ParseExpression();
+        compiledExp = FormulaCompiler().Compile(exp);
         return true;
     }
     catch (const FormulaException& error)
@@ -34,6 +36,7 @@ bool Formula::Parse(const String& str)
 void Formula::Reset()
 {
     exp.reset();
+    compiledExp.reset();
     parsingError = "";
     calculationError = "";
 }
@@ -47,12 +50,12 @@ Any Formula::Calculate(const std::shared_ptr<FormulaContext>& context)
 {
     calculationError = "";
 
-    if (exp)
+    if (compiledExp)
     {
         try
         {
             FormulaExecutor executor(context);
-            return executor.Calculate(exp.get());
+            return executor.Calculate(compiledExp.get());
         }
         catch (const FormulaException& error)
         {
@@ -0,0 +1,166 @@
+#include "UI/Formula/Private/FormulaCompiler.h"
+
+#include "UI/Formula/FormulaContext.h"
+#include "UI/Formula/Private/FormulaData.h"
+#include "UI/Formula/Private/FormulaException.h"
+#include "UI/Formula/Private/FormulaExecutor.h"
+
+namespace DAVA
+{
+using std::make_shared;
+using std::shared_ptr;
+
+FormulaCompiler::FormulaCompiler()
+{
+}
+
+FormulaCompiler::~FormulaCompiler()
+{
+}
+
+shared_ptr<FormulaExpression> FormulaCompiler::Compile(const shared_ptr<FormulaExpression>& exp)
+{
+    if (!exp)
+    {
+        return exp;
+    }
+    return CompileImpl(exp.get());
+}
+
+void FormulaCompiler::Visit(FormulaValueExpression* exp)
+{
+    result = make_shared<FormulaValueExpression>(exp->GetValue(), exp->GetLineNumber(), exp->GetPositionInLine());
+}
+
+void FormulaCompiler::Visit(FormulaNegExpression* exp)
+{
+    shared_ptr<FormulaExpression> operand = CompileImpl(exp->GetExp());
+    shared_ptr<FormulaExpression> compiled = make_shared<FormulaNegExpression>(operand, exp->GetLineNumber(), exp->GetPositionInLine());
+    result = GetConstantValue(operand.get()) ? TryFold(compiled) : compiled;
+}
+
+void FormulaCompiler::Visit(FormulaNotExpression* exp)
+{
+    shared_ptr<FormulaExpression> operand = CompileImpl(exp->GetExp());
+    shared_ptr<FormulaExpression> compiled = make_shared<FormulaNotExpression>(operand, exp->GetLineNumber(), exp->GetPositionInLine());
+    result = GetConstantValue(operand.get()) ? TryFold(compiled) : compiled;
+}
+
+void FormulaCompiler::Visit(FormulaWhenExpression* exp)
+{
+    Vector<std::pair<shared_ptr<FormulaExpression>, shared_ptr<FormulaExpression>>> branches;
+    for (const auto& branch : exp->GetBranches())
+    {
+        shared_ptr<FormulaExpression> condition = CompileImpl(branch.first.get());
+        shared_ptr<FormulaExpression> value = CompileImpl(branch.second.get());
+
+        // Leading branches with constant conditions are resolved now, others keep their order
+        const Any* conditionValue = GetConstantValue(condition.get());
+        if (branches.empty() && conditionValue != nullptr && conditionValue->CanGet<bool>())
+        {
+            if (conditionValue->Get<bool>())
+            {
+                result = value;
+                return;
+            }
+            continue;
+        }
+
+        branches.emplace_back(condition, value);
+    }
+
+    shared_ptr<FormulaExpression> elseBranch = CompileImpl(exp->GetElseBranch());
+    if (branches.empty())
+    {
+        result = elseBranch;
+    }
+    else
+    {
+        result = make_shared<FormulaWhenExpression>(branches, elseBranch, exp->GetLineNumber(), exp->GetPositionInLine());
+    }
+}
+
+void FormulaCompiler::Visit(FormulaBinaryOperatorExpression* exp)
+{
+    shared_ptr<FormulaExpression> lhs = CompileImpl(exp->GetLhs());
+    shared_ptr<FormulaExpression> rhs = CompileImpl(exp->GetRhs());
+    shared_ptr<FormulaExpression> compiled = make_shared<FormulaBinaryOperatorExpression>(exp->GetOperator(), lhs, rhs, exp->GetLineNumber(), exp->GetPositionInLine());
+    result = (GetConstantValue(lhs.get()) && GetConstantValue(rhs.get())) ? TryFold(compiled) : compiled;
+}
+
+void FormulaCompiler::Visit(FormulaFunctionExpression* exp)
+{
+    // Functions come from context and are called on every calculation
+    Vector<shared_ptr<FormulaExpression>> params;
+    params.reserve(exp->GetParms().size());
+    for (const shared_ptr<FormulaExpression>& param : exp->GetParms())
+    {
+        params.push_back(CompileImpl(param.get()));
+    }
+    result = make_shared<FormulaFunctionExpression>(exp->GetName(), params, exp->GetLineNumber(), exp->GetPositionInLine());
+}
+
+void FormulaCompiler::Visit(FormulaFieldAccessExpression* exp)
+{
+    shared_ptr<FormulaExpression> data = exp->GetExp() ? CompileImpl(exp->GetExp()) : nullptr;
+    shared_ptr<FormulaFieldAccessExpression> compiled = make_shared<FormulaFieldAccessExpression>(data, exp->GetFieldName(), exp->GetLineNumber(), exp->GetPositionInLine());
+    if (!data)
+    {
+        // Data found in context chain stays the same until context is recreated
+        compiled->EnableReferenceCache();
+    }
+    result = compiled;
+}
+
+void FormulaCompiler::Visit(FormulaIndexExpression* exp)
+{
+    shared_ptr<FormulaExpression> data = CompileImpl(exp->GetExp());
+    shared_ptr<FormulaExpression> index = CompileImpl(exp->GetIndexExp());
+    result = make_shared<FormulaIndexExpression>(data, index, exp->GetLineNumber(), exp->GetPositionInLine());
+}
+
+shared_ptr<FormulaExpression> FormulaCompiler::CompileImpl(FormulaExpression* exp)
+{
+    result.reset();
+    exp->Accept(this);
+
+    shared_ptr<FormulaExpression> compiled = result;
+    result.reset();
+    return compiled;
+}
+
+shared_ptr<FormulaExpression> FormulaCompiler::TryFold(const shared_ptr<FormulaExpression>& exp) const
+{
+    try
+    {
+        // Constant expression doesn't access context
+        shared_ptr<FormulaContext> emptyContext;
+        FormulaExecutor executor(emptyContext);
+        Any value = executor.Calculate(exp.get());
+        return make_shared<FormulaValueExpression>(value, exp->GetLineNumber(), exp->GetPositionInLine());
+    }
+    catch (const FormulaException&)
+    {
+        return exp; // error will be reported on calculation
+    }
+}
+
+const Any* FormulaCompiler::GetConstantValue(FormulaExpression* exp)
+{
+    if (exp == nullptr || !exp->IsValue())
+    {
+        return nullptr;
+    }
+
+    // Data containers and nested expressions are resolved through context
+    const Any& value = static_cast<FormulaValueExpression*>(exp)->GetValue();
+    if (value.IsEmpty() ||
+        value.CanGet<shared_ptr<FormulaDataMap>>() ||
+        value.CanGet<shared_ptr<FormulaDataVector>>() ||
+        value.CanCast<shared_ptr<FormulaExpression>>())
+    {
+        return nullptr;
+    }
+    return &value;
+}
+}
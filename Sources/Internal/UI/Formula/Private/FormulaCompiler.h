@@ -0,0 +1,47 @@
+#pragma once
+
+#include "UI/Formula/Private/FormulaExpression.h"
+
+namespace DAVA
+{
+/**
+ \ingroup formula
+
+ Compiler prepares parsed expression for repeated calculation.
+
+ It returns a copy of expression where parts which don't depend on context
+ (operators over literals, `when` branches with constant conditions) are
+ calculated once and replaced by values. Field access nodes keep interned
+ field names, so they are not resolved by strings on every calculation, and
+ fields taken from context remember found data until context changes.
+ Parts which can't be calculated (e.g. with wrong operand types) are kept
+ as is and report errors on calculation like original expression does.
+
+ Original expression isn't changed and can be formatted as it was written.
+ */
+class FormulaCompiler : private FormulaExpressionVisitor
+{
+public:
+    FormulaCompiler();
+    ~FormulaCompiler() override;
+
+    std::shared_ptr<FormulaExpression> Compile(const std::shared_ptr<FormulaExpression>& exp);
+
+private:
+    void Visit(FormulaValueExpression* exp) override;
+    void Visit(FormulaNegExpression* exp) override;
+    void Visit(FormulaNotExpression* exp) override;
+    void Visit(FormulaWhenExpression* exp) override;
+    void Visit(FormulaBinaryOperatorExpression* exp) override;
+    void Visit(FormulaFunctionExpression* exp) override;
+    void Visit(FormulaFieldAccessExpression* exp) override;
+    void Visit(FormulaIndexExpression* exp) override;
+
+    std::shared_ptr<FormulaExpression> CompileImpl(FormulaExpression* exp);
+    std::shared_ptr<FormulaExpression> TryFold(const std::shared_ptr<FormulaExpression>& exp) const;
+
+    static const Any* GetConstantValue(FormulaExpression* exp);
+
+    std::shared_ptr<FormulaExpression> result;
+};
+}
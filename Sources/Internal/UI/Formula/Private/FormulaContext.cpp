@@ -1,6 +1,8 @@
 #include "UI/Formula/FormulaContext.h"
 #include "Reflection/ReflectedTypeDB.h"
 
+#include <atomic>
+
 namespace DAVA
 {
 using std::make_shared;
@@ -9,6 +11,8 @@ using std::shared_ptr;
 FormulaContext::FormulaContext(const std::shared_ptr<FormulaContext>& parent_)
     : parent(parent_)
 {
+    static std::atomic<uint64> nextId{ 1 };
+    id = nextId++;
 }
 
 FormulaContext::~FormulaContext()
@@ -20,6 +24,11 @@ const std::shared_ptr<FormulaContext>& FormulaContext::GetParent() const
     return parent;
 }
 
+uint64 FormulaContext::GetId() const
+{
+    return id;
+}
+
 Reflection FormulaContext::FindReflection(const String& name) const
 {
     Reflection res = FindReflectionLocal(name);
@@ -36,6 +45,27 @@ Reflection FormulaContext::FindReflection(const String& name) const
     return Reflection();
 }
 
+Reflection FormulaContext::FindReflection(const FastName& name) const
+{
+    Reflection res = FindReflectionLocal(name);
+    if (res.IsValid())
+    {
+        return res;
+    }
+
+    if (GetParent() != nullptr)
+    {
+        return GetParent()->FindReflection(name);
+    }
+
+    return Reflection();
+}
+
+Reflection FormulaContext::FindReflectionLocal(const FastName& name) const
+{
+    return FindReflectionLocal(String(name.c_str()));
+}
+
 FormulaReflectionContext::FormulaReflectionContext(const Reflection& ref_, const std::shared_ptr<FormulaContext>& parent_)
     : FormulaContext(parent_)
     , reflection(ref_)
@@ -68,6 +98,11 @@ Reflection FormulaReflectionContext::FindReflectionLocal(const String& name) con
     return reflection.GetField(name);
 }
 
+Reflection FormulaReflectionContext::FindReflectionLocal(const FastName& name) const
+{
+    return reflection.GetField(name);
+}
+
 const Reflection& FormulaReflectionContext::GetReflection() const
 {
     return reflection;
@@ -171,6 +206,11 @@ Reflection FormulaFunctionContext::FindReflectionLocal(const String& name) const
     return Reflection();
 }
 
+Reflection FormulaFunctionContext::FindReflectionLocal(const FastName& name) const
+{
+    return Reflection();
+}
+
 void FormulaFunctionContext::RegisterFunction(const String& name, const AnyFn& fn)
 {
     auto it = functions.find(name);
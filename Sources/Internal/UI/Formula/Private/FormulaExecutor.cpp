@@ -57,7 +57,11 @@ void FormulaExecutor::Visit(FormulaNegExpression* exp)
 {
     const Any& val = CalculateImpl(exp->GetExp());
 
-    if (val.CanGet<float32>())
+    if (val.GetType() == Type::Instance<int32>())
+    {
+        calculationResult = Any(-val.Get<int32>());
+    }
+    else if (val.CanGet<float32>())
     {
         calculationResult = Any(-val.Get<float32>());
     }
@@ -122,6 +126,22 @@ void FormulaExecutor::Visit(FormulaBinaryOperatorExpression* exp)
     Any l = CalculateImpl(exp->GetLhs());
     Any r = CalculateImpl(exp->GetRhs());
 
+    // Fast path for the most common operands, same result as checks below give
+    const Type* lType = l.GetType();
+    if (lType != nullptr && lType == r.GetType())
+    {
+        if (lType == Type::Instance<int32>())
+        {
+            calculationResult = CalculateIntValues<int32>(exp->GetOperator(), l.Get<int32>(), r.Get<int32>(), exp);
+            return;
+        }
+        else if (lType == Type::Instance<float32>())
+        {
+            calculationResult = CalculateNumberValues<float32>(exp->GetOperator(), l.Get<float32>(), r.Get<float32>());
+            return;
+        }
+    }
+
     if (l.CanGet<uint64>() && r.CanGet<uint64>())
     {
         calculationResult = CalculateIntAnyValues<uint64>(exp->GetOperator(), l, r, exp);
@@ -329,16 +349,24 @@ void FormulaExecutor::Visit(FormulaFieldAccessExpression* exp)
         Reflection data = GetDataReference(exp->GetExp());
         if (data.IsValid())
         {
-            dataReference = data.GetField(exp->GetFieldName());
+            dataReference = data.GetField(exp->GetFieldKey());
         }
         else
         {
             dataReference = Reflection();
         }
     }
+    else if (const Reflection* cached = exp->GetCachedReference(context->GetId()))
+    {
+        dataReference = *cached;
+    }
     else
     {
-        dataReference = context->FindReflection(exp->GetFieldName());
+        dataReference = context->FindReflection(exp->GetFieldKey());
+        if (dataReference.IsValid())
+        {
+            exp->SetCachedReference(context->GetId(), dataReference);
+        }
     }
 
     if (dataReference.IsValid())
@@ -454,7 +482,7 @@ const Reflection& FormulaExecutor::GetDataReferenceImpl(FormulaExpression* exp)
 }
 
 template <typename T>
-Any FormulaExecutor::CalculateNumberAnyValues(FormulaBinaryOperatorExpression::Operator op, Any anyLVal, Any anyRVal) const
+Any FormulaExecutor::CalculateNumberAnyValues(FormulaBinaryOperatorExpression::Operator op, const Any& anyLVal, const Any& anyRVal) const
 {
     T lVal = anyLVal.Cast<T>();
     T rVal = anyRVal.Cast<T>();
@@ -462,7 +490,7 @@ Any FormulaExecutor::CalculateNumberAnyValues(FormulaBinaryOperatorExpression::O
 }
 
 template <typename T>
-Any FormulaExecutor::CalculateIntAnyValues(FormulaBinaryOperatorExpression::Operator op, Any anyLVal, Any anyRVal, FormulaExpression* exp) const
+Any FormulaExecutor::CalculateIntAnyValues(FormulaBinaryOperatorExpression::Operator op, const Any& anyLVal, const Any& anyRVal, FormulaExpression* exp) const
 {
     T lVal = anyLVal.Cast<T>();
     T rVal = anyRVal.Cast<T>();
@@ -59,10 +59,10 @@ private:
     const Reflection& GetDataReferenceImpl(FormulaExpression* exp);
 
     template <typename T>
-    Any CalculateNumberAnyValues(FormulaBinaryOperatorExpression::Operator op, Any lVal, Any rVal) const;
+    Any CalculateNumberAnyValues(FormulaBinaryOperatorExpression::Operator op, const Any& lVal, const Any& rVal) const;
 
     template <typename T>
-    Any CalculateIntAnyValues(FormulaBinaryOperatorExpression::Operator op, Any lVal, Any rVal, FormulaExpression* exp) const;
+    Any CalculateIntAnyValues(FormulaBinaryOperatorExpression::Operator op, const Any& lVal, const Any& rVal, FormulaExpression* exp) const;
 
     template <typename T>
     Any CalculateIntValues(FormulaBinaryOperatorExpression::Operator op, T lVal, T rVal, FormulaExpression* exp) const;
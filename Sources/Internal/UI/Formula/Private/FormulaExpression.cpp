@@ -195,6 +195,7 @@ FormulaFieldAccessExpression::FormulaFieldAccessExpression(const std::shared_ptr
     : FormulaExpression(lineNumber_, positionInLine_)
     , exp(exp_)
     , fieldName(fieldName_)
+    , fieldKey(fieldName_)
 {
 }
 
@@ -213,6 +214,30 @@ const String& FormulaFieldAccessExpression::GetFieldName() const
     return fieldName;
 }
 
+const FastName& FormulaFieldAccessExpression::GetFieldKey() const
+{
+    return fieldKey;
+}
+
+void FormulaFieldAccessExpression::EnableReferenceCache()
+{
+    referenceCacheEnabled = true;
+}
+
+const Reflection* FormulaFieldAccessExpression::GetCachedReference(uint64 contextId) const
+{
+    return (referenceCacheEnabled && cachedContextId == contextId) ? &cachedReference : nullptr;
+}
+
+void FormulaFieldAccessExpression::SetCachedReference(uint64 contextId, const Reflection& reference)
+{
+    if (referenceCacheEnabled)
+    {
+        cachedContextId = contextId;
+        cachedReference = reference;
+    }
+}
+
 FormulaIndexExpression::FormulaIndexExpression(const std::shared_ptr<FormulaExpression>& exp_, const std::shared_ptr<FormulaExpression>& indexExp_, int32 lineNumber_, int32 positionInLine_)
     : FormulaExpression(lineNumber_, positionInLine_)
     , exp(exp_)
@@ -2,6 +2,8 @@
 
 #include "Base/BaseTypes.h"
 #include "Base/Any.h"
+#include "Base/FastName.h"
+#include "Reflection/Reflection.h"
 
 namespace DAVA
 {
@@ -207,9 +209,25 @@ public:
     FormulaExpression* GetExp() const;
     const String& GetFieldName() const;
 
+    /** Field name interned once, used as reflection key on every calculation. */
+    const FastName& GetFieldKey() const;
+
+    /**
+     Compiler enables cache of data found by field name which isn't accessed through other
+     expression. Cached data is used while calculation happens in context with the same id.
+     */
+    void EnableReferenceCache();
+    const Reflection* GetCachedReference(uint64 contextId) const;
+    void SetCachedReference(uint64 contextId, const Reflection& reference);
+
 private:
     std::shared_ptr<FormulaExpression> exp;
     String fieldName;
+    FastName fieldKey;
+
+    bool referenceCacheEnabled = false;
+    uint64 cachedContextId = 0;
+    Reflection cachedReference;
 };
 
 /**
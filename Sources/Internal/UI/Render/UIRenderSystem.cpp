@@ -277,9 +277,10 @@ void UIRenderSystem::RenderText(const UIControl* control, const UITextComponent*
     }
 
     Rect textBlockRect(geometricData.position, geometricData.size);
-    if (textBlock->GetFont() && textBlock->GetFont()->GetFontType() == Font::TYPE_DISTANCE)
+    Font* font = textBlock->GetFont();
+    if (font && (font->GetFontType() == Font::TYPE_DISTANCE || (font->GetFontType() == Font::TYPE_FT && TextBlock::IsGlyphAtlasEnabled())))
     {
-        // Correct rect and setup position and scale for distance fonts
+        // Correct rect and setup position and scale for fonts drawn by quads
         textBlockRect.dx *= geometricData.scale.dx;
         textBlockRect.dy *= geometricData.scale.dy;
         textBlock->SetScale(geometricData.scale);
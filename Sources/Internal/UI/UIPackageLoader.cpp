@@ -5,6 +5,7 @@
 #include "Engine/Engine.h"
 #include "FileSystem/FileSystem.h"
 #include "FileSystem/FilePath.h"
+#include "FileSystem/YamlBinary.h"
 #include "FileSystem/YamlEmitter.h"
 #include "FileSystem/YamlNode.h"
 #include "FileSystem/YamlParser.h"
@@ -77,12 +78,20 @@ UIPackageLoader::~UIPackageLoader()
 {
 }
 
-bool UIPackageLoader::LoadPackage(const FilePath& packagePath, AbstractUIPackageBuilder* builder)
+bool UIPackageLoader::ReadPackageYaml(const FilePath& packagePath, RefPtr<YamlNode>& rootNode)
 {
-    if (!loadingQueue.empty())
+    rootNode = nullptr;
+
+    // Prefer package precompiled at resource build time as it is loaded without yaml parsing,
+    // outdated one is skipped by YamlBinary
+    FilePath binaryPackagePath = YamlBinary::GetBinaryPath(packagePath);
+    if (FileSystem::Instance()->Exists(binaryPackagePath))
     {
-        DVASSERT(false);
-        loadingQueue.clear();
+        rootNode = YamlBinary::LoadFromFile(binaryPackagePath, packagePath);
+        if (rootNode)
+        {
+            return true;
+        }
     }
 
     if (!FileSystem::Instance()->Exists(packagePath))
@@ -92,7 +101,22 @@ bool UIPackageLoader::LoadPackage(const FilePath& packagePath, AbstractUIPackage
     if (!parser.Valid())
         return false;
 
-    YamlNode* rootNode = parser->GetRootNode();
+    rootNode = RefPtr<YamlNode>::ConstructWithRetain(parser->GetRootNode());
+    return true;
+}
+
+bool UIPackageLoader::LoadPackage(const FilePath& packagePath, AbstractUIPackageBuilder* builder)
+{
+    if (!loadingQueue.empty())
+    {
+        DVASSERT(false);
+        loadingQueue.clear();
+    }
+
+    RefPtr<YamlNode> rootNode;
+    if (!ReadPackageYaml(packagePath, rootNode))
+        return false;
+
     if (!rootNode) //empty yaml equal to empty UIPackage
     {
         builder->BeginPackage(packagePath, UIPackage::CURRENT_VERSION);
@@ -100,7 +124,7 @@ bool UIPackageLoader::LoadPackage(const FilePath& packagePath, AbstractUIPackage
         return true;
     }
 
-    return LoadPackage(rootNode, packagePath, builder);
+    return LoadPackage(rootNode.Get(), packagePath, builder);
 }
 
 bool UIPackageLoader::LoadPackage(const YamlNode* rootNode, const FilePath& packagePath, AbstractUIPackageBuilder* builder)
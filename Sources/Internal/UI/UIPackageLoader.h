@@ -34,6 +34,12 @@ public:
     virtual ~UIPackageLoader();
 
 public:
+    /**
+        Read package yaml or its precompiled binary version without building package, can be called from any thread.
+        Returns false if package can't be read, `rootNode` is empty for empty package.
+    */
+    static bool ReadPackageYaml(const FilePath& packagePath, RefPtr<YamlNode>& rootNode);
+
     virtual bool LoadPackage(const FilePath& packagePath, AbstractUIPackageBuilder* builder) override;
     virtual bool LoadPackage(const YamlNode* rootNode, const FilePath& packagePath, AbstractUIPackageBuilder* builder);
     virtual bool LoadControlByName(const FastName& name, AbstractUIPackageBuilder* builder) override;
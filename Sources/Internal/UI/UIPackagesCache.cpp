@@ -1,6 +1,15 @@
 #include "UIPackagesCache.h"
 
 #include "UIPackage.h"
+#include "Concurrency/LockGuard.h"
+#include "Engine/Engine.h"
+#include "FileSystem/FilePath.h"
+#include "FileSystem/YamlNode.h"
+#include "Job/JobManager.h"
+#include "Logger/Logger.h"
+#include "UI/DefaultUIPackageBuilder.h"
+#include "UI/UIControl.h"
+#include "UI/UIPackageLoader.h"
 
 namespace DAVA
 {
@@ -16,32 +25,220 @@ UIPackagesCache::UIPackagesCache(UIPackagesCache* _parent)
 
 UIPackagesCache::~UIPackagesCache()
 {
+    DVASSERT(requests.empty());
     parent = nullptr;
     packages.clear();
 }
 
-void UIPackagesCache::PutPackage(const String& path, const RefPtr<UIPackage>& package)
+RefPtr<UIPackage> UIPackagesCache::PutPackage(const String& path, const RefPtr<UIPackage>& package)
 {
+    // Package can be built by flow loading thread and main job at the same time, first one is kept
+    LockGuard<Mutex> lock(mutex);
     auto it = packages.find(path);
     if (it == packages.end())
     {
         packages[path] = package;
+        return package;
     }
-    else
-    {
-        DVASSERT(it->second == package);
-    }
+    return it->second;
 }
 
 RefPtr<UIPackage> UIPackagesCache::GetPackage(const String& path) const
 {
-    auto it = packages.find(path);
-    if (it != packages.end())
-        return it->second;
+    {
+        LockGuard<Mutex> lock(mutex);
+        auto it = packages.find(path);
+        if (it != packages.end())
+            return it->second;
+    }
 
     if (parent)
         return parent->GetPackage(path);
 
     return RefPtr<UIPackage>();
 }
+
+void UIPackagesCache::RequestPackage(const FilePath& packagePath, const PackageCallback& callback)
+{
+    const String path = packagePath.GetFrameworkPath();
+    RefPtr<UIPackage> package = GetPackage(path);
+    if (package)
+    {
+        if (callback)
+        {
+            callback(package);
+        }
+        return;
+    }
+
+    {
+        LockGuard<Mutex> lock(mutex);
+        auto it = requests.find(path);
+        if (it != requests.end())
+        {
+            if (callback)
+            {
+                it->second.push_back(callback);
+            }
+            return;
+        }
+
+        Vector<PackageCallback>& callbacks = requests[path];
+        if (callback)
+        {
+            callbacks.push_back(callback);
+        }
+    }
+
+    // Cache is kept alive until package is built
+    RefPtr<UIPackagesCache> self = RefPtr<UIPackagesCache>::ConstructWithRetain(this);
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    jobManager->CreateWorkerJob([self, path, jobManager]() {
+        std::shared_ptr<Vector<ParsedPackage>> parsedPackages = std::make_shared<Vector<ParsedPackage>>();
+        Set<String> visited;
+        self->ParsePackages(path, visited, *parsedPackages);
+
+        jobManager->CreateMainJob([self, path, parsedPackages]() {
+            self->BuildPackages(path, *parsedPackages);
+        });
+    });
+}
+
+bool UIPackagesCache::IsPackageRequested(const FilePath& packagePath) const
+{
+    LockGuard<Mutex> lock(mutex);
+    return requests.find(packagePath.GetFrameworkPath()) != requests.end();
+}
+
+RefPtr<UIControl> UIPackagesCache::CreateControl(const FilePath& packagePath, const String& controlName)
+{
+    const String path = packagePath.GetFrameworkPath();
+    RefPtr<UIPackage> package = GetPackage(path);
+    if (!package)
+    {
+        ParsedPackage parsedPackage;
+        parsedPackage.path = path;
+        parsedPackage.valid = UIPackageLoader::ReadPackageYaml(packagePath, parsedPackage.rootNode);
+        if (parsedPackage.valid)
+        {
+            package = BuildPackage(parsedPackage);
+        }
+
+        if (!package)
+        {
+            Logger::Error("[UIPackagesCache] Can't load package '%s'", path.c_str());
+            return RefPtr<UIControl>();
+        }
+        package = PutPackage(path, package);
+    }
+
+    UIControl* control = nullptr;
+    if (controlName.empty())
+    {
+        if (!package->GetControls().empty())
+        {
+            control = package->GetControls().front().Get();
+        }
+    }
+    else
+    {
+        control = package->GetControl(controlName);
+        if (control == nullptr)
+        {
+            control = package->GetPrototype(controlName);
+        }
+    }
+
+    if (control == nullptr)
+    {
+        return RefPtr<UIControl>();
+    }
+    return control->SafeClone();
+}
+
+void UIPackagesCache::ParsePackages(const String& path, Set<String>& visited, Vector<ParsedPackage>& parsedPackages) const
+{
+    if (!visited.insert(path).second || GetPackage(path))
+    {
+        return;
+    }
+
+    ParsedPackage parsedPackage;
+    parsedPackage.path = path;
+    parsedPackage.valid = UIPackageLoader::ReadPackageYaml(FilePath(path), parsedPackage.rootNode);
+
+    // Imported packages go first, so they are in cache when package is built
+    if (parsedPackage.rootNode)
+    {
+        const YamlNode* importedPackagesNode = parsedPackage.rootNode->Get("ImportedPackages");
+        if (importedPackagesNode != nullptr)
+        {
+            for (uint32 i = 0; i < importedPackagesNode->GetCount(); ++i)
+            {
+                ParsePackages(importedPackagesNode->Get(i)->AsString(), visited, parsedPackages);
+            }
+        }
+    }
+
+    parsedPackages.push_back(parsedPackage);
+}
+
+void UIPackagesCache::BuildPackages(const String& path, const Vector<ParsedPackage>& parsedPackages)
+{
+    for (const ParsedPackage& parsedPackage : parsedPackages)
+    {
+        if (parsedPackage.valid && !GetPackage(parsedPackage.path))
+        {
+            RefPtr<UIPackage> package = BuildPackage(parsedPackage);
+            if (package)
+            {
+                PutPackage(parsedPackage.path, package);
+            }
+        }
+    }
+
+    RefPtr<UIPackage> package = GetPackage(path);
+    if (!package)
+    {
+        Logger::Error("[UIPackagesCache] Can't load package '%s'", path.c_str());
+    }
+
+    Vector<PackageCallback> callbacks;
+    {
+        LockGuard<Mutex> lock(mutex);
+        auto it = requests.find(path);
+        if (it != requests.end())
+        {
+            callbacks.swap(it->second);
+            requests.erase(it);
+        }
+    }
+
+    for (const PackageCallback& callback : callbacks)
+    {
+        callback(package);
+    }
+}
+
+RefPtr<UIPackage> UIPackagesCache::BuildPackage(const ParsedPackage& parsedPackage)
+{
+    const FilePath packagePath(parsedPackage.path);
+    DefaultUIPackageBuilder builder(this);
+    bool loaded = true;
+    if (parsedPackage.rootNode)
+    {
+        loaded = UIPackageLoader().LoadPackage(parsedPackage.rootNode.Get(), packagePath, &builder);
+    }
+    else //empty yaml equal to empty UIPackage
+    {
+        builder.BeginPackage(packagePath, UIPackage::CURRENT_VERSION);
+        builder.EndPackage();
+    }
+
+    if (!loaded || builder.GetPackage() == nullptr)
+    {
+        return RefPtr<UIPackage>();
+    }
+    return RefPtr<UIPackage>::ConstructWithRetain(builder.GetPackage());
+}
 }
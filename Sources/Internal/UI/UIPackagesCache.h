@@ -2,26 +2,68 @@
 #define __DAVAENGINE_UI_PACKAGES_CACHE_H__
 
 #include "Base/BaseObject.h"
+#include "Concurrency/Mutex.h"
+#include "Functional/Function.h"
 
 namespace DAVA
 {
+class FilePath;
+class UIControl;
 class UIPackage;
+class YamlNode;
 
 class UIPackagesCache final
 : public BaseObject
 {
 public:
+    using PackageCallback = Function<void(const RefPtr<UIPackage>& package)>;
+
     UIPackagesCache(const RefPtr<UIPackagesCache>& _parent);
     UIPackagesCache(UIPackagesCache* _parent = nullptr);
 
-    void PutPackage(const String& name, const RefPtr<UIPackage>& package);
+    /**
+        Put package to cache and return cached one. Package can be built by several threads
+        at the same time, in this case the first put package is kept and returned.
+    */
+    RefPtr<UIPackage> PutPackage(const String& name, const RefPtr<UIPackage>& package);
     RefPtr<UIPackage> GetPackage(const String& name) const;
 
+    /**
+        Request package loading in background. Package and all its imported packages are read
+        and parsed by worker jobs, after that packages are built and cached on main thread and
+        `callback` is called with loaded package (or with empty one if package can't be loaded).
+        If package is already cached `callback` is called immediately on calling thread.
+        All methods of cache can be called from any thread.
+    */
+    void RequestPackage(const FilePath& packagePath, const PackageCallback& callback = PackageCallback());
+    /** Return true if package is requested and isn't built yet. */
+    bool IsPackageRequested(const FilePath& packagePath) const;
+
+    /**
+        Create copy of control or prototype with `controlName` from package with `packagePath`.
+        Package is loaded once and kept in cache as template, so next controls are just cloned from it.
+        If `controlName` is empty first control of package is used.
+    */
+    RefPtr<UIControl> CreateControl(const FilePath& packagePath, const String& controlName);
+
 private:
+    struct ParsedPackage
+    {
+        String path;
+        RefPtr<YamlNode> rootNode;
+        bool valid = false;
+    };
+
     ~UIPackagesCache() override;
 
+    void ParsePackages(const String& path, Set<String>& visited, Vector<ParsedPackage>& parsedPackages) const;
+    void BuildPackages(const String& path, const Vector<ParsedPackage>& parsedPackages);
+    RefPtr<UIPackage> BuildPackage(const ParsedPackage& parsedPackage);
+
     RefPtr<UIPackagesCache> parent;
     Map<String, RefPtr<UIPackage>> packages;
+    Map<String, Vector<PackageCallback>> requests;
+    mutable Mutex mutex;
 };
 };
 #endif // __DAVAENGINE_UI_PACKAGES_CACHE_H__
@@ -3,11 +3,46 @@
 #include "FileSystem/File.h"
 #include "FileSystem/FilePath.h"
 #include "FileSystem/Private/PackFormatSpec.h"
+#include "Debug/DVAssert.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
+#include "Job/ParallelFor.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CRC32_USE_PCLMUL
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define CRC32_PCLMUL_TARGET
+#else
+#include <cpuid.h>
+#define CRC32_PCLMUL_TARGET __attribute__((target("pclmul,sse4.1")))
+#endif
+#include <smmintrin.h>
+#include <wmmintrin.h>
+#endif
+
+#if defined(__aarch64__) && (defined(__DAVAENGINE_ANDROID__) || defined(__DAVAENGINE_IPHONE__) || defined(__DAVAENGINE_MACOS__) || defined(__DAVAENGINE_LINUX__))
+#define CRC32_USE_ARMV8
+#if defined(__ARM_FEATURE_CRC32)
+#define CRC32_ARMV8_TARGET
+#elif defined(__clang__)
+#define CRC32_ARMV8_TARGET __attribute__((target("crc")))
+#else
+#define CRC32_ARMV8_TARGET __attribute__((target("+crc")))
+#endif
+#include <arm_acle.h>
+#if defined(__DAVAENGINE_IPHONE__) || defined(__DAVAENGINE_MACOS__)
+#include <sys/sysctl.h>
+#else
+#include <sys/auxv.h>
+#endif
+#endif
 
 namespace DAVA
 {
 
-#define BUFSIZE 8192
+#define BUFSIZE 16384
 
 const uint32 crc32_tab[256] =
 {
@@ -77,18 +112,286 @@ const uint32 crc32_tab[256] =
   0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d
 };
 
-CRC32::CRC32()
+namespace CRC32Details
+{
+const uint32 POLYNOMIAL = 0xedb88320;
+// Below this size parallel calculation doesn't pay back job scheduling
+const size_t PARALLEL_CHUNK_SIZE = 1024 * 1024;
+
+uint32 UpdateTable(uint32 crc, const uint8* data, size_t size)
 {
-    crc32 = 0xffffffff;
+    for (size_t i = 0; i < size; ++i)
+    {
+        crc = (crc >> 8) ^ crc32_tab[(crc ^ data[i]) & 0xff];
+    }
+    return crc;
 }
 
-void CRC32::AddData(const void* dataPtr, size_t size)
+// Table k gives CRC of byte followed by k zero bytes
+struct SliceTables
+{
+    SliceTables()
+    {
+        for (uint32 i = 0; i < 256; ++i)
+        {
+            table[0][i] = crc32_tab[i];
+        }
+        for (uint32 k = 1; k < 16; ++k)
+        {
+            for (uint32 i = 0; i < 256; ++i)
+            {
+                table[k][i] = (table[k - 1][i] >> 8) ^ crc32_tab[table[k - 1][i] & 0xff];
+            }
+        }
+    }
+
+    uint32 table[16][256];
+};
+
+const SliceTables& GetSliceTables()
+{
+    static const SliceTables tables;
+    return tables;
+}
+
+inline uint32 Load32(const uint8* data)
+{
+    uint32 value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// Little-endian only, as every supported platform
+uint32 UpdateSliceBy16(uint32 crc, const uint8* data, size_t size)
 {
-    const char* data = reinterpret_cast<const char*>(dataPtr);
-    for (uint32 i = 0; i < size; i++)
+    const uint32(*t)[256] = GetSliceTables().table;
+    while (size >= 16)
     {
-        crc32 = (crc32 >> 8) ^ crc32_tab[(crc32 ^ data[i]) & 0xff];
+        const uint32 a = Load32(data) ^ crc;
+        const uint32 b = Load32(data + 4);
+        const uint32 c = Load32(data + 8);
+        const uint32 d = Load32(data + 12);
+        crc = t[15][a & 0xff] ^ t[14][(a >> 8) & 0xff] ^ t[13][(a >> 16) & 0xff] ^ t[12][a >> 24] ^
+        t[11][b & 0xff] ^ t[10][(b >> 8) & 0xff] ^ t[9][(b >> 16) & 0xff] ^ t[8][b >> 24] ^
+        t[7][c & 0xff] ^ t[6][(c >> 8) & 0xff] ^ t[5][(c >> 16) & 0xff] ^ t[4][c >> 24] ^
+        t[3][d & 0xff] ^ t[2][(d >> 8) & 0xff] ^ t[1][(d >> 16) & 0xff] ^ t[0][d >> 24];
+        data += 16;
+        size -= 16;
     }
+    return UpdateTable(crc, data, size);
+}
+
+#if defined(CRC32_USE_PCLMUL)
+bool IsPCLMULSupported()
+{
+    uint32 ecx = 0;
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    ecx = static_cast<uint32>(info[2]);
+#else
+    uint32 eax, ebx, edx;
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0)
+    {
+        return false;
+    }
+#endif
+    const uint32 pclmulBit = 1 << 1;
+    const uint32 sse41Bit = 1 << 19;
+    return (ecx & pclmulBit) != 0 && (ecx & sse41Bit) != 0;
+}
+
+// Folding of 64-byte blocks with carry-less multiplication and Barrett reduction,
+// see "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ Instruction" (Intel).
+// Constants are x^k mod P for reflected CRC32 polynomial.
+CRC32_PCLMUL_TARGET uint32 UpdatePCLMUL(uint32 crc, const uint8* data, size_t size)
+{
+    if (size < 64)
+    {
+        return UpdateSliceBy16(crc, data, size);
+    }
+
+    alignas(16) static const uint64 k1k2[2] = { 0x0154442bd4, 0x01c6e41596 };
+    alignas(16) static const uint64 k3k4[2] = { 0x01751997d0, 0x00ccaa009e };
+    alignas(16) static const uint64 k5k0[2] = { 0x0163cd6124, 0x0000000000 };
+    alignas(16) static const uint64 poly[2] = { 0x01db710641, 0x01f7011641 };
+
+    const __m128i* block = reinterpret_cast<const __m128i*>(data);
+    __m128i x1 = _mm_xor_si128(_mm_loadu_si128(block), _mm_cvtsi32_si128(static_cast<int32>(crc)));
+    __m128i x2 = _mm_loadu_si128(block + 1);
+    __m128i x3 = _mm_loadu_si128(block + 2);
+    __m128i x4 = _mm_loadu_si128(block + 3);
+    block += 4;
+    size -= 64;
+
+    __m128i k = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+    for (; size >= 64; size -= 64, block += 4)
+    {
+        const __m128i x5 = _mm_clmulepi64_si128(x1, k, 0x00);
+        const __m128i x6 = _mm_clmulepi64_si128(x2, k, 0x00);
+        const __m128i x7 = _mm_clmulepi64_si128(x3, k, 0x00);
+        const __m128i x8 = _mm_clmulepi64_si128(x4, k, 0x00);
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), x5), _mm_loadu_si128(block));
+        x2 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x2, k, 0x11), x6), _mm_loadu_si128(block + 1));
+        x3 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x3, k, 0x11), x7), _mm_loadu_si128(block + 2));
+        x4 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x4, k, 0x11), x8), _mm_loadu_si128(block + 3));
+    }
+
+    // Fold four 128-bit values into one, then remaining 16-byte blocks
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), _mm_clmulepi64_si128(x1, k, 0x00)), x2);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), _mm_clmulepi64_si128(x1, k, 0x00)), x3);
+    x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), _mm_clmulepi64_si128(x1, k, 0x00)), x4);
+    for (; size >= 16; size -= 16, ++block)
+    {
+        x1 = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x1, k, 0x11), _mm_clmulepi64_si128(x1, k, 0x00)), _mm_loadu_si128(block));
+    }
+
+    // Fold 128 bits to 64 bits
+    const __m128i mask32 = _mm_setr_epi32(~0, 0, ~0, 0);
+    x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x00), x2);
+
+    // Barrett reduction to 32 bits
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask32), k, 0x10);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask32), k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    crc = static_cast<uint32>(_mm_extract_epi32(x1, 1));
+
+    return UpdateSliceBy16(crc, reinterpret_cast<const uint8*>(block), size);
+}
+#endif // CRC32_USE_PCLMUL
+
+#if defined(CRC32_USE_ARMV8)
+bool IsARMV8Supported()
+{
+#if defined(__ARM_FEATURE_CRC32)
+    return true;
+#elif defined(__DAVAENGINE_IPHONE__) || defined(__DAVAENGINE_MACOS__)
+    int32 value = 0;
+    size_t valueSize = sizeof(value);
+    return sysctlbyname("hw.optional.armv8_crc32", &value, &valueSize, nullptr, 0) == 0 && value != 0;
+#else
+    const unsigned long hwcapCRC32 = 1 << 7; // HWCAP_CRC32
+    return (getauxval(AT_HWCAP) & hwcapCRC32) != 0;
+#endif
+}
+
+CRC32_ARMV8_TARGET uint32 UpdateARMV8(uint32 crc, const uint8* data, size_t size)
+{
+    for (; size >= 32; size -= 32, data += 32)
+    {
+        uint64 v[4];
+        std::memcpy(v, data, sizeof(v));
+        crc = __crc32d(crc, v[0]);
+        crc = __crc32d(crc, v[1]);
+        crc = __crc32d(crc, v[2]);
+        crc = __crc32d(crc, v[3]);
+    }
+    for (; size >= 8; size -= 8, data += 8)
+    {
+        uint64 v;
+        std::memcpy(&v, data, sizeof(v));
+        crc = __crc32d(crc, v);
+    }
+    for (; size > 0; --size, ++data)
+    {
+        crc = __crc32b(crc, *data);
+    }
+    return crc;
+}
+#endif // CRC32_USE_ARMV8
+
+uint32 Update(CRC32::Implementation implementation, uint32 crc, const void* dataPtr, size_t size)
+{
+    const uint8* data = static_cast<const uint8*>(dataPtr);
+    switch (implementation)
+    {
+    case CRC32::Implementation::TABLE:
+        return UpdateTable(crc, data, size);
+#if defined(CRC32_USE_PCLMUL)
+    case CRC32::Implementation::PCLMUL:
+        return UpdatePCLMUL(crc, data, size);
+#endif
+#if defined(CRC32_USE_ARMV8)
+    case CRC32::Implementation::ARMV8:
+        return UpdateARMV8(crc, data, size);
+#endif
+    default:
+        return UpdateSliceBy16(crc, data, size);
+    }
+}
+
+// Product of polynomials a and b modulo P, bit reflected
+uint32 MultiplyModP(uint32 a, uint32 b)
+{
+    uint32 m = 1u << 31;
+    uint32 p = 0;
+    for (;;)
+    {
+        if (a & m)
+        {
+            p ^= b;
+            if ((a & (m - 1)) == 0)
+            {
+                break;
+            }
+        }
+        m >>= 1;
+        b = (b & 1) ? (b >> 1) ^ POLYNOMIAL : b >> 1;
+    }
+    return p;
+}
+
+// x^(n * 2^k) modulo P
+uint32 PowerModP(uint64 n, uint32 k)
+{
+    struct PowersOfTwo
+    {
+        PowersOfTwo()
+        {
+            uint32 p = 1u << 30; // x^1
+            for (uint32 i = 0; i < 32; ++i)
+            {
+                powers[i] = p;
+                p = MultiplyModP(p, p);
+            }
+        }
+        uint32 powers[32];
+    };
+    static const PowersOfTwo table;
+
+    uint32 p = 1u << 31; // x^0
+    for (; n != 0; n >>= 1, ++k)
+    {
+        if (n & 1)
+        {
+            p = MultiplyModP(table.powers[k & 31], p);
+        }
+    }
+    return p;
+}
+}
+
+CRC32::CRC32()
+    : CRC32(GetBestImplementation())
+{
+}
+
+CRC32::CRC32(Implementation implementation_)
+    : crc32(0xffffffff)
+    , implementation(implementation_)
+{
+    DVASSERT(IsSupported(implementation));
+}
+
+void CRC32::AddData(const void* dataPtr, size_t size)
+{
+    crc32 = CRC32Details::Update(implementation, crc32, dataPtr, size);
 }
 
 uint32 CRC32::Done()
@@ -97,6 +400,53 @@ uint32 CRC32::Done()
     return crc32;
 }
 
+bool CRC32::IsSupported(Implementation implementation)
+{
+    switch (implementation)
+    {
+    case Implementation::TABLE:
+    case Implementation::SLICE_BY_16:
+        return true;
+    case Implementation::PCLMUL:
+#if defined(CRC32_USE_PCLMUL)
+    {
+        static const bool supported = CRC32Details::IsPCLMULSupported();
+        return supported;
+    }
+#else
+        return false;
+#endif
+    case Implementation::ARMV8:
+#if defined(CRC32_USE_ARMV8)
+    {
+        static const bool supported = CRC32Details::IsARMV8Supported();
+        return supported;
+    }
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+CRC32::Implementation CRC32::GetBestImplementation()
+{
+    if (IsSupported(Implementation::PCLMUL))
+    {
+        return Implementation::PCLMUL;
+    }
+    if (IsSupported(Implementation::ARMV8))
+    {
+        return Implementation::ARMV8;
+    }
+    return Implementation::SLICE_BY_16;
+}
+
+uint32 CRC32::Combine(uint32 crc1, uint32 crc2, uint64 size2)
+{
+    return CRC32Details::MultiplyModP(CRC32Details::PowerModP(size2, 3), crc1) ^ crc2;
+}
+
 uint32 CRC32::ForFile(const FilePath& pathName)
 {
     ScopedPtr<File> f(File::Create(pathName, File::OPEN | File::READ));
@@ -160,9 +510,42 @@ uint32 CRC32::ForDVPLFileContent(const FilePath& pathName)
 
 uint32 CRC32::ForBuffer(const void* data, size_t size)
 {
-    const char* ptrData = reinterpret_cast<const char*>(data);
     CRC32 crc;
-    crc.AddData(ptrData, size);
+    crc.AddData(data, size);
+    return crc.Done();
+}
+
+uint32 CRC32::ForBuffer(const void* data, size_t size, Implementation implementation)
+{
+    CRC32 crc(implementation);
+    crc.AddData(data, size);
     return crc.Done();
 }
-};
\ No newline at end of file
+
+uint32 CRC32::ForBufferParallel(const void* data, size_t size)
+{
+    using namespace CRC32Details;
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    const size_t chunkCount = (size + PARALLEL_CHUNK_SIZE - 1) / PARALLEL_CHUNK_SIZE;
+    if (jobManager == nullptr || jobManager->GetWorkersCount() == 0 || chunkCount < 2)
+    {
+        return ForBuffer(data, size);
+    }
+
+    const uint8* bytes = static_cast<const uint8*>(data);
+    Vector<uint32> chunkCRC(chunkCount);
+    ParallelFor(static_cast<uint32>(chunkCount), [bytes, size, &chunkCRC](uint32 chunk) {
+        const size_t offset = chunk * PARALLEL_CHUNK_SIZE;
+        chunkCRC[chunk] = ForBuffer(bytes + offset, std::min(PARALLEL_CHUNK_SIZE, size - offset));
+    });
+
+    uint32 crc = chunkCRC[0];
+    for (size_t chunk = 1; chunk < chunkCount; ++chunk)
+    {
+        const size_t chunkSize = std::min(PARALLEL_CHUNK_SIZE, size - chunk * PARALLEL_CHUNK_SIZE);
+        crc = Combine(crc, chunkCRC[chunk], chunkSize);
+    }
+    return crc;
+}
+};
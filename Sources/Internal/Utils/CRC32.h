@@ -8,7 +8,17 @@ class FilePath;
 class CRC32
 {
 public:
+    /** Ways to calculate CRC32, all of them give the same result */
+    enum class Implementation
+    {
+        TABLE, ///< Byte at a time table lookup, reference implementation
+        SLICE_BY_16, ///< 16 bytes at a time table lookup, available everywhere
+        PCLMUL, ///< x86 carry-less multiplication folding, selected at runtime
+        ARMV8, ///< ARMv8 CRC32 instructions, selected at runtime
+    };
+
     CRC32();
+    explicit CRC32(Implementation implementation);
     void AddData(const void* data, size_t size);
     uint32 Done();
 
@@ -21,6 +31,22 @@ public:
         return ForBuffer(c.data(), c.size());
     }
 
+    // Calculate the CRC32 for the in-memory buffer with specified implementation.
+    static uint32 ForBuffer(const void* data, size_t size, Implementation implementation);
+
+    // Calculate the CRC32 for the big in-memory buffer splitting it into chunks for JobManager worker threads.
+    // Can be called from any thread, calling thread takes part in calculation.
+    static uint32 ForBufferParallel(const void* data, size_t size);
+
+    // Calculate CRC32 of concatenation of two buffers from their CRC32 and size of second buffer.
+    static uint32 Combine(uint32 crc1, uint32 crc2, uint64 size2);
+
+    // Check if implementation can be used on current device.
+    static bool IsSupported(Implementation implementation);
+
+    // Fastest implementation supported by current device, used by default.
+    static Implementation GetBestImplementation();
+
     // Calculate CRC32 for the whole file.
     static uint32 ForFile(const FilePath& pathName);
 
@@ -29,5 +55,6 @@ public:
 
 private:
     uint32 crc32;
+    Implementation implementation;
 };
 }